@@ -19,6 +19,10 @@
 #include <limits>
 #include <algorithm>
 
+#if defined (ACE_HAS_CDR_SWAP_SIMD)
+# include /**/ <immintrin.h>
+#endif /* ACE_HAS_CDR_SWAP_SIMD */
+
 ACE_BEGIN_VERSIONED_NAMESPACE_DECL
 
 #if defined (NONNATIVE_LONGDOUBLE)
@@ -26,6 +30,158 @@ static const ACE_INT16 max_eleven_bit = 0x3ff;
 static const ACE_INT16 max_fifteen_bit = 0x3fff;
 #endif /* NONNATIVE_LONGDOUBLE */
 
+#if defined (ACE_HAS_CDR_SWAP_SIMD)
+
+//
+// Vector versions of the array swaps.  A byte shuffle reverses the
+// bytes of every element in a 16 (SSSE3) or 32 (AVX2) byte chunk at
+// once.  The instruction set is picked at run time, so the library
+// still runs on CPUs lacking these extensions.
+//
+
+namespace
+{
+  // Shuffle masks for 2, 4, 8 and 16 byte elements.  AVX2 shuffles
+  // within each 16 byte lane, so the pattern is repeated.
+  unsigned char const swap_masks[4][32] =
+    {
+      { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+        1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 },
+      { 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+        3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 },
+      { 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+        7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8 },
+      { 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+        15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0 }
+    };
+
+  // Below this size the scalar code is just as fast.
+  size_t const swap_simd_min_bytes = 32;
+
+  // Swap the leading multiple of 16 bytes; returns how many bytes
+  // were done.
+  __attribute__ ((target ("ssse3"))) size_t
+  swap_array_ssse3 (char const *orig,
+                    char *target,
+                    size_t bytes,
+                    unsigned char const *mask_bytes)
+  {
+    __m128i const mask =
+      _mm_loadu_si128 (reinterpret_cast<__m128i const *> (mask_bytes));
+    size_t const done = bytes & ~static_cast<size_t> (15);
+
+    for (size_t i = 0; i < done; i += 16)
+      {
+        __m128i const a =
+          _mm_loadu_si128 (reinterpret_cast<__m128i const *> (orig + i));
+        _mm_storeu_si128 (reinterpret_cast<__m128i *> (target + i),
+                          _mm_shuffle_epi8 (a, mask));
+      }
+
+    return done;
+  }
+
+  __attribute__ ((target ("avx2"))) size_t
+  swap_array_avx2 (char const *orig,
+                   char *target,
+                   size_t bytes,
+                   unsigned char const *mask_bytes)
+  {
+    __m256i const mask =
+      _mm256_loadu_si256 (reinterpret_cast<__m256i const *> (mask_bytes));
+    size_t i = 0;
+
+    // Two vectors per iteration keep both load ports busy.
+    for (; i + 64 <= bytes; i += 64)
+      {
+        __m256i const a =
+          _mm256_loadu_si256 (reinterpret_cast<__m256i const *> (orig + i));
+        __m256i const b =
+          _mm256_loadu_si256 (reinterpret_cast<__m256i const *> (orig + i + 32));
+        _mm256_storeu_si256 (reinterpret_cast<__m256i *> (target + i),
+                             _mm256_shuffle_epi8 (a, mask));
+        _mm256_storeu_si256 (reinterpret_cast<__m256i *> (target + i + 32),
+                             _mm256_shuffle_epi8 (b, mask));
+      }
+
+    if (i + 32 <= bytes)
+      {
+        __m256i const a =
+          _mm256_loadu_si256 (reinterpret_cast<__m256i const *> (orig + i));
+        _mm256_storeu_si256 (reinterpret_cast<__m256i *> (target + i),
+                             _mm256_shuffle_epi8 (a, mask));
+        i += 32;
+      }
+
+    if (i + 16 <= bytes)
+      {
+        __m128i const a =
+          _mm_loadu_si128 (reinterpret_cast<__m128i const *> (orig + i));
+        _mm_storeu_si128 (reinterpret_cast<__m128i *> (target + i),
+                          _mm_shuffle_epi8 (a,
+                                            _mm256_castsi256_si128 (mask)));
+        i += 16;
+      }
+
+    return i;
+  }
+
+  enum Swap_Simd_Level
+  {
+    SWAP_PORTABLE = 0,
+    SWAP_SSSE3,
+    SWAP_AVX2
+  };
+
+  int
+  swap_simd_probe (void)
+  {
+    __builtin_cpu_init ();
+    if (__builtin_cpu_supports ("avx2"))
+      return SWAP_AVX2;
+    if (__builtin_cpu_supports ("ssse3"))
+      return SWAP_SSSE3;
+    return SWAP_PORTABLE;
+  }
+
+  // Zero until the library's static initializers have run, so any
+  // swaps done before simply take the portable path.
+  int swap_simd_level = swap_simd_probe ();
+
+  // Swap the leading part of an array of @a n elements of 2 <<
+  // @a size_index bytes; returns how many elements were done.
+  inline size_t
+  swap_array_simd (char const *orig,
+                   char *target,
+                   size_t n,
+                   int size_index)
+  {
+    size_t const size = static_cast<size_t> (2) << size_index;
+    size_t const bytes = n * size;
+
+    if (bytes < swap_simd_min_bytes)
+      return 0;
+
+    switch (swap_simd_level)
+      {
+      case SWAP_AVX2:
+        return swap_array_avx2 (orig,
+                                target,
+                                bytes,
+                                swap_masks[size_index]) / size;
+      case SWAP_SSSE3:
+        return swap_array_ssse3 (orig,
+                                 target,
+                                 bytes,
+                                 swap_masks[size_index]) / size;
+      default:
+        return 0;
+      }
+  }
+}
+
+#endif /* ACE_HAS_CDR_SWAP_SIMD */
+
 //
 // See comments in CDR_Base.inl about optimization cases for swap_XX_array.
 //
@@ -35,6 +191,15 @@ ACE_CDR::swap_2_array (char const * orig, char* target, size_t n)
 {
   // ACE_ASSERT(n > 0); The caller checks that n > 0
 
+#if defined (ACE_HAS_CDR_SWAP_SIMD)
+  size_t const done = swap_array_simd (orig, target, n, 0);
+  if (done == n)
+    return;
+  orig += 2 * done;
+  target += 2 * done;
+  n -= done;
+#endif /* ACE_HAS_CDR_SWAP_SIMD */
+
   // We pretend that AMD64/GNU G++ systems have a Pentium CPU to
   // take advantage of the inline assembly implementation.
 
@@ -262,6 +427,15 @@ ACE_CDR::swap_4_array (char const * orig, char* target, size_t n)
 {
   // ACE_ASSERT (n > 0); The caller checks that n > 0
 
+#if defined (ACE_HAS_CDR_SWAP_SIMD)
+  size_t const done = swap_array_simd (orig, target, n, 1);
+  if (done == n)
+    return;
+  orig += 4 * done;
+  target += 4 * done;
+  n -= done;
+#endif /* ACE_HAS_CDR_SWAP_SIMD */
+
 #if ACE_SIZEOF_LONG == 8
   // Later, we read from *orig in 64 bit chunks,
   // so make sure we don't generate unaligned readings.
@@ -470,6 +644,15 @@ ACE_CDR::swap_8_array (char const * orig, char* target, size_t n)
 {
   // ACE_ASSERT(n > 0); The caller checks that n > 0
 
+#if defined (ACE_HAS_CDR_SWAP_SIMD)
+  size_t const done = swap_array_simd (orig, target, n, 2);
+  if (done == n)
+    return;
+  orig += 8 * done;
+  target += 8 * done;
+  n -= done;
+#endif /* ACE_HAS_CDR_SWAP_SIMD */
+
   char const * const end = orig + 8*n;
   while (orig < end)
     {
@@ -484,6 +667,15 @@ ACE_CDR::swap_16_array (char const * orig, char* target, size_t n)
 {
   // ACE_ASSERT(n > 0); The caller checks that n > 0
 
+#if defined (ACE_HAS_CDR_SWAP_SIMD)
+  size_t const done = swap_array_simd (orig, target, n, 3);
+  if (done == n)
+    return;
+  orig += 16 * done;
+  target += 16 * done;
+  n -= done;
+#endif /* ACE_HAS_CDR_SWAP_SIMD */
+
   char const * const end = orig + 16*n;
   while (orig < end)
     {
@@ -37,6 +37,10 @@ ACE_BEGIN_VERSIONED_NAMESPACE_DECL
 //   (none of the above)
 //   => shift/masks using 32bit words.
 //
+// In addition, with ACE_HAS_CDR_SWAP_SIMD (AMD64 + g++ 4.9 or clang)
+// the swap_XX_array routines do the bulk of long arrays with SSSE3
+// or AVX2 byte shuffles, depending on what the CPU supports.
+//
 // Some things you could find useful to know if you intend to mess
 // with this optimizations for swaps:
 //
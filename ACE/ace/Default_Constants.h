@@ -324,6 +324,16 @@
 #   define ACE_DEFAULT_TIMER_WHEEL_RESOLUTION 100
 # endif /* ACE_DEFAULT_TIMER_WHEEL_RESOLUTION */
 
+// Defaults for ACE Hierarchical Timer Wheel; the resolution is in
+// microseconds, the slab size in timer nodes.
+# if !defined (ACE_DEFAULT_TIMER_HIERARCHICAL_WHEEL_RESOLUTION)
+#   define ACE_DEFAULT_TIMER_HIERARCHICAL_WHEEL_RESOLUTION 1000
+# endif /* ACE_DEFAULT_TIMER_HIERARCHICAL_WHEEL_RESOLUTION */
+
+# if !defined (ACE_DEFAULT_TIMER_HIERARCHICAL_WHEEL_SLAB)
+#   define ACE_DEFAULT_TIMER_HIERARCHICAL_WHEEL_SLAB 1024
+# endif /* ACE_DEFAULT_TIMER_HIERARCHICAL_WHEEL_SLAB */
+
 // Default size for ACE Timer Hash table
 # if !defined (ACE_DEFAULT_TIMER_HASH_TABLE_SIZE)
 #   define ACE_DEFAULT_TIMER_HASH_TABLE_SIZE 1024
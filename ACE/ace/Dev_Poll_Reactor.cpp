@@ -663,6 +663,36 @@ ACE_Dev_Poll_Reactor::ACE_Dev_Poll_Reactor (size_t size,
                 ACE_TEXT ("failed inside ACE_Dev_Poll_Reactor::CTOR")));
 }
 
+ACE_Dev_Poll_Reactor::ACE_Dev_Poll_Reactor (Deferred_Open,
+                                            int mask_signals,
+                                            int s_queue)
+  : initialized_ (false)
+  , poll_fd_ (ACE_INVALID_HANDLE)
+#if defined (ACE_HAS_DEV_POLL)
+  , dp_fds_ (0)
+  , start_pfds_ (0)
+  , end_pfds_ (0)
+#endif  /* ACE_HAS_DEV_POLL */
+  , token_ (*this, s_queue)
+  , lock_adapter_ (token_)
+  , deactivated_ (0)
+  , timer_queue_ (0)
+  , delete_timer_queue_ (false)
+  , signal_handler_ (0)
+  , delete_signal_handler_ (false)
+  , notify_handler_ (0)
+  , delete_notify_handler_ (false)
+  , mask_signals_ (mask_signals)
+  , restart_ (0)
+{
+  ACE_TRACE ("ACE_Dev_Poll_Reactor::ACE_Dev_Poll_Reactor");
+
+#ifdef ACE_HAS_EVENT_POLL
+  ACE_OS::memset (&this->event_, 0, sizeof (this->event_));
+  this->event_.data.fd = ACE_INVALID_HANDLE;
+#endif /* ACE_HAS_EVENT_POLL */
+}
+
 ACE_Dev_Poll_Reactor::~ACE_Dev_Poll_Reactor (void)
 {
   ACE_TRACE ("ACE_Dev_Poll_Reactor::~ACE_Dev_Poll_Reactor");
@@ -686,11 +716,6 @@ ACE_Dev_Poll_Reactor::open (size_t size,
   if (this->initialized_)
     return -1;
 
-#ifdef ACE_HAS_EVENT_POLL
-  ACE_OS::memset (&this->event_, 0, sizeof (this->event_));
-  this->event_.data.fd = ACE_INVALID_HANDLE;
-#endif /* ACE_HAS_EVENT_POLL */
-
   this->restart_ = restart;
   this->signal_handler_ = sh;
   this->timer_queue_ = tq;
@@ -737,28 +762,9 @@ ACE_Dev_Poll_Reactor::open (size_t size,
         this->delete_notify_handler_ = true;
     }
 
-#if defined (ACE_HAS_EVENT_POLL)
-
-  // Initialize epoll:
-  this->poll_fd_ = ::epoll_create (size);
-  if (this->poll_fd_ == -1)
-    result = -1;
-
-#else
-
-  // Allocate the array before opening the device to avoid a potential
-  // resource leak if allocation fails.
-  ACE_NEW_RETURN (this->dp_fds_,
-                  pollfd[size],
-                  -1);
-
-  // Open the `/dev/poll' character device.
-  this->poll_fd_ = ACE_OS::open ("/dev/poll", O_RDWR);
-  if (this->poll_fd_ == ACE_INVALID_HANDLE)
+  if (result != -1 && this->open_poll_i (size) == -1)
     result = -1;
 
-#endif  /* ACE_HAS_EVENT_POLL */
-
   if (result != -1 && this->handler_rep_.open (size) == -1)
     result = -1;
 
@@ -830,26 +836,7 @@ ACE_Dev_Poll_Reactor::close (void)
 
   ACE_MT (ACE_GUARD_RETURN (ACE_Dev_Poll_Reactor_Token, mon, this->token_, -1));
 
-  int result = 0;
-
-  if (this->poll_fd_ != ACE_INVALID_HANDLE)
-    {
-      result = ACE_OS::close (this->poll_fd_);
-    }
-
-#if defined (ACE_HAS_EVENT_POLL)
-
-  ACE_OS::memset (&this->event_, 0, sizeof (this->event_));
-  this->event_.data.fd = ACE_INVALID_HANDLE;
-
-#else
-
-  delete [] this->dp_fds_;
-  this->dp_fds_ = 0;
-  this->start_pfds_ = 0;
-  this->end_pfds_ = 0;
-
-#endif  /* ACE_HAS_EVENT_POLL */
+  int const result = this->close_poll_i ();
 
   if (this->delete_signal_handler_)
     {
@@ -882,8 +869,6 @@ ACE_Dev_Poll_Reactor::close (void)
       this->delete_notify_handler_ = false;
     }
 
-  this->poll_fd_ = ACE_INVALID_HANDLE;
-
   this->initialized_ = false;
 
   return result;
@@ -922,11 +907,7 @@ ACE_Dev_Poll_Reactor::work_pending_i (ACE_Time_Value * max_wait_time)
   if (this->deactivated_)
     return 0;
 
-#if defined (ACE_HAS_EVENT_POLL)
-  if (this->event_.data.fd != ACE_INVALID_HANDLE)
-#else
-  if (this->start_pfds_ != this->end_pfds_)
-#endif /* ACE_HAS_EVENT_POLL */
+  if (this->io_event_ready_i ())
     return 1;  // We still have work_pending (). Do not poll for
                // additional events.
 
@@ -940,39 +921,7 @@ ACE_Dev_Poll_Reactor::work_pending_i (ACE_Time_Value * max_wait_time)
      || (this_timeout != 0 && max_wait_time != 0
          && *this_timeout != *max_wait_time) ? 1 : 0);
 
-  long const timeout =
-    (this_timeout == 0
-     ? -1 /* Infinity */
-     : static_cast<long> (this_timeout->msec ()));
-
-#if defined (ACE_HAS_EVENT_POLL)
-
-  // Wait for an event.
-  int const nfds = ::epoll_wait (this->poll_fd_,
-                                 &this->event_,
-                                 1,
-                                 static_cast<int> (timeout));
-
-#else
-
-  struct dvpoll dvp;
-
-  dvp.dp_fds = this->dp_fds_;
-  dvp.dp_nfds = this->handler_rep_.size ();
-  dvp.dp_timeout = timeout;  // Milliseconds
-
-  // Poll for events
-  int const nfds = ACE_OS::ioctl (this->poll_fd_, DP_POLL, &dvp);
-
-  // Retrieve the results from the pollfd array.
-  this->start_pfds_ = dvp.dp_fds;
-
-  // If nfds == 0 then end_pfds_ == start_pfds_ meaning that there is
-  // no work pending.  If nfds > 0 then there is work pending.
-  // Otherwise an error occurred.
-  if (nfds > -1)
-    this->end_pfds_ = this->start_pfds_ + nfds;
-#endif  /* ACE_HAS_EVENT_POLL */
+  int const nfds = this->poll_i (this_timeout);
 
   // If timers are pending, override any timeout from the poll.
   return (nfds == 0 && timers_pending != 0 ? 1 : nfds);
@@ -1263,97 +1212,112 @@ ACE_Dev_Poll_Reactor::dispatch_io_event (Token_Guard &guard)
 
       }     // End scope for ACE_GUARD holding repo lock
 
-      int status = 0;   // gets callback status, below.
+      return this->dispatch_io_handler (guard,
+                                        handle,
+                                        eh,
+                                        disp_mask,
+                                        callback,
+                                        reactor_resumes_eh);
+    }
 
-      // Dispatch notifies directly. The notify dispatcher locates a
-      // notification then releases the token prior to dispatching it.
-      // NOTE: If notify_handler_->dispatch_one() returns a fail condition
-      // it has not releases the guard. Else, it has.
-      if (eh == this->notify_handler_)
-        {
-          ACE_Notification_Buffer b;
-          status =
-            dynamic_cast<ACE_Dev_Poll_Reactor_Notify *>(notify_handler_)->dequeue_one (b);
-          if (status == -1)
-            return status;
-          guard.release_token ();
-          return notify_handler_->dispatch_notify (b);
-        }
+  return 0;
+}
+
+int
+ACE_Dev_Poll_Reactor::dispatch_io_handler (
+  Token_Guard &guard,
+  ACE_HANDLE handle,
+  ACE_Event_Handler *eh,
+  ACE_Reactor_Mask disp_mask,
+  int (ACE_Event_Handler::*callback)(ACE_HANDLE),
+  bool reactor_resumes_eh)
+{
+  Event_Tuple *info = 0;
+  int status = 0;   // gets callback status, below.
+
+  // Dispatch notifies directly. The notify dispatcher locates a
+  // notification then releases the token prior to dispatching it.
+  // NOTE: If notify_handler_->dispatch_one() returns a fail condition
+  // it has not releases the guard. Else, it has.
+  if (eh == this->notify_handler_)
+    {
+      ACE_Notification_Buffer b;
+      status =
+        dynamic_cast<ACE_Dev_Poll_Reactor_Notify *>(notify_handler_)->dequeue_one (b);
+      if (status == -1)
+        return status;
+      guard.release_token ();
+      return notify_handler_->dispatch_notify (b);
+    }
 
+  {
+    // Modify the reference count in an exception-safe way.
+    // Note that eh could be the notify handler. It's not strictly
+    // necessary to manage its refcount, but since we don't enable
+    // the counting policy, it won't do much. Management of the
+    // notified handlers themselves is done in the notify handler.
+    ACE_Dev_Poll_Handler_Guard eh_guard (eh);
+
+    // Release the reactor token before upcall.
+    guard.release_token ();
+
+    // Dispatch the detected event; will do the repeated upcalls
+    // if callback returns > 0, unless it's the notify handler (which
+    // returns the number of notfies dispatched, not an indication of
+    // re-callback requested). If anything other than the notify, come
+    // back with either 0 or < 0.
+    status = this->upcall (eh, callback, handle);
+
+    // If the callback returned 0, epoll-based needs to resume the
+    // suspended handler but dev/poll doesn't; reactor_resumes_eh is
+    // only ever set with epoll.
+    // In both epoll and dev/poll cases, if the callback returns <0,
+    // the token needs to be acquired and the handler checked and
+    // removed if it hasn't already been.
+    if (status == 0)
       {
-        // Modify the reference count in an exception-safe way.
-        // Note that eh could be the notify handler. It's not strictly
-        // necessary to manage its refcount, but since we don't enable
-        // the counting policy, it won't do much. Management of the
-        // notified handlers themselves is done in the notify handler.
-        ACE_Dev_Poll_Handler_Guard eh_guard (eh);
-
-        // Release the reactor token before upcall.
-        guard.release_token ();
-
-        // Dispatch the detected event; will do the repeated upcalls
-        // if callback returns > 0, unless it's the notify handler (which
-        // returns the number of notfies dispatched, not an indication of
-        // re-callback requested). If anything other than the notify, come
-        // back with either 0 or < 0.
-        status = this->upcall (eh, callback, handle);
-
-        // If the callback returned 0, epoll-based needs to resume the
-        // suspended handler but dev/poll doesn't.
-        // In both epoll and dev/poll cases, if the callback returns <0,
-        // the token needs to be acquired and the handler checked and
-        // removed if it hasn't already been.
-        if (status == 0)
+        // epoll-based effectively suspends handlers around the upcall.
+        // If the handler must be resumed, check to be sure it's the
+        // same handle/handler combination still.
+        if (reactor_resumes_eh)
           {
-#ifdef ACE_HAS_EVENT_POLL
+            ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, grd, this->repo_lock_, -1);
+            info = this->handler_rep_.find (handle);
+            if (info != 0 && info->event_handler == eh)
+              this->resume_handler_i (handle);
+          }
+        return 1;
+      }
+
+    // All state in the handler repository may have changed during the
+    // upcall. Thus, reacquire the repo lock and evaluate what's needed.
+    // If the upcalled handler is still the handler of record for handle,
+    // continue with checking whether or not to remove or resume the
+    // handler.
+    ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, grd, this->repo_lock_, 1);
+    info = this->handler_rep_.find (handle);
+    if (info != 0 && info->event_handler == eh)
+      {
+        if (status < 0)
+          {
+            this->remove_handler_i (handle, disp_mask, grd);
             // epoll-based effectively suspends handlers around the upcall.
             // If the handler must be resumed, check to be sure it's the
             // same handle/handler combination still.
             if (reactor_resumes_eh)
               {
-                ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, grd, this->repo_lock_, -1);
                 info = this->handler_rep_.find (handle);
                 if (info != 0 && info->event_handler == eh)
-                  this->resume_handler_i (handle);
-              }
-#endif /* ACE_HAS_EVENT_POLL */
-            return 1;
-          }
-
-        // All state in the handler repository may have changed during the
-        // upcall. Thus, reacquire the repo lock and evaluate what's needed.
-        // If the upcalled handler is still the handler of record for handle,
-        // continue with checking whether or not to remove or resume the
-        // handler.
-        ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, grd, this->repo_lock_, 1);
-        info = this->handler_rep_.find (handle);
-        if (info != 0 && info->event_handler == eh)
-          {
-            if (status < 0)
-              {
-                this->remove_handler_i (handle, disp_mask, grd);
-#ifdef ACE_HAS_EVENT_POLL
-                // epoll-based effectively suspends handlers around the upcall.
-                // If the handler must be resumed, check to be sure it's the
-                // same handle/handler combination still.
-                if (reactor_resumes_eh)
                   {
-                    info = this->handler_rep_.find (handle);
-                    if (info != 0 && info->event_handler == eh)
-                      {
-                        this->resume_handler_i (handle);
-                      }
+                    this->resume_handler_i (handle);
                   }
-#endif /* ACE_HAS_EVENT_POLL */
               }
           }
       }
-      // Scope close handles eh ref count decrement, if needed.
-
-      return 1;
-    }
+  }
+  // Scope close handles eh ref count decrement, if needed.
 
-  return 0;
+  return 1;
 }
 
 int
@@ -1440,31 +1404,14 @@ ACE_Dev_Poll_Reactor::register_handler_i (ACE_HANDLE handle,
      if (this->handler_rep_.bind (handle, event_handler, mask) != 0)
        return -1;
 
-#if defined (ACE_HAS_EVENT_POLL)
-
+     // Add file descriptor to the "interest set."
      Event_Tuple *info = this->handler_rep_.find (handle);
-
-     struct epoll_event epev;
-     ACE_OS::memset (&epev, 0, sizeof (epev));
-     static const int op = EPOLL_CTL_ADD;
-
-     epev.data.fd = handle;
-     epev.events  = this->reactor_mask_to_poll_event (mask);
-     // All but the notify handler get registered with oneshot to facilitate
-     // auto suspend before the upcall. See dispatch_io_event for more
-     // information.
-     if (event_handler != this->notify_handler_)
-       epev.events |= EPOLLONESHOT;
-
-     if (::epoll_ctl (this->poll_fd_, op, handle, &epev) == -1)
+     if (this->arm_i (handle, info) == -1)
        {
-         ACELIB_ERROR ((LM_ERROR, ACE_TEXT("%p\n"), ACE_TEXT("epoll_ctl")));
+         ACELIB_ERROR ((LM_ERROR, ACE_TEXT("%p\n"), ACE_TEXT("arm_i")));
          (void) this->handler_rep_.unbind (handle);
          return -1;
        }
-     info->controlled = true;
-
-#endif /* ACE_HAS_EVENT_POLL */
    }
  else
    {
@@ -1476,22 +1423,6 @@ ACE_Dev_Poll_Reactor::register_handler_i (ACE_HANDLE handle,
                          -1);
    }
 
-#ifdef  ACE_HAS_DEV_POLL
-
-  struct pollfd pfd;
-
-  pfd.fd      = handle;
-  pfd.events  = this->reactor_mask_to_poll_event (mask);
-  pfd.revents = 0;
-
-  // Add file descriptor to the "interest set."
-  if (ACE_OS::write (this->poll_fd_, &pfd, sizeof (pfd)) != sizeof (pfd))
-    {
-      (void) this->handler_rep_.unbind (handle);
-      return -1;
-    }
-#endif /*ACE_HAS_DEV_POLL*/
-
   // Note the fact that we've changed the state of the wait_set_,
   // which is used by the dispatching loop to determine whether it can
   // keep going or if it needs to reconsult select ().
@@ -1781,31 +1712,8 @@ ACE_Dev_Poll_Reactor::suspend_handler_i (ACE_HANDLE handle)
   // Note that the associated event handler is still in the handler
   // repository, but no events will be polled on the given handle thus
   // no event will be dispatched to the event handler.
-
-#if defined (ACE_HAS_EVENT_POLL)
-
-  struct epoll_event epev;
-  ACE_OS::memset (&epev, 0, sizeof (epev));
-  static const int op = EPOLL_CTL_DEL;
-
-  epev.events  = 0;
-  epev.data.fd = handle;
-
-  if (::epoll_ctl (this->poll_fd_, op, handle, &epev) == -1)
+  if (this->disarm_i (handle, info) == -1)
     return -1;
-  info->controlled = false;
-#else
-
-  struct pollfd pfd[1];
-
-  pfd[0].fd      = handle;
-  pfd[0].events  = POLLREMOVE;
-  pfd[0].revents = 0;
-
-  if (ACE_OS::write (this->poll_fd_, pfd, sizeof (pfd)) != sizeof (pfd))
-    return -1;
-
-#endif  /* ACE_HAS_EVENT_POLL */
 
   info->suspended = true;
 
@@ -1898,34 +1806,9 @@ ACE_Dev_Poll_Reactor::resume_handler_i (ACE_HANDLE handle)
   // Place the handle back in to the "interest set."
   //
   // Events for the given handle will once again be polled.
-
-#if defined (ACE_HAS_EVENT_POLL)
-
-  struct epoll_event epev;
-  ACE_OS::memset (&epev, 0, sizeof (epev));
-  int op = EPOLL_CTL_ADD;
-  if (info->controlled)
-    op = EPOLL_CTL_MOD;
-  epev.events  = this->reactor_mask_to_poll_event (mask) | EPOLLONESHOT;
-  epev.data.fd = handle;
-
-  if (::epoll_ctl (this->poll_fd_, op, handle, &epev) == -1)
-    return -1;
-  info->controlled = true;
-
-#else
-
-  struct pollfd pfd[1];
-
-  pfd[0].fd      = handle;
-  pfd[0].events  = this->reactor_mask_to_poll_event (mask);
-  pfd[0].revents = 0;
-
-  if (ACE_OS::write (this->poll_fd_, pfd, sizeof (pfd)) != sizeof (pfd))
+  if (this->arm_i (handle, info) == -1)
     return -1;
 
-#endif  /* ACE_HAS_EVENT_POLL */
-
   info->suspended = false;
 
   return 0;
@@ -2336,70 +2219,14 @@ ACE_Dev_Poll_Reactor::mask_ops_i (ACE_HANDLE handle,
   // cleared, we can un-control the fd now.
   if (!info->suspended || (info->controlled && new_mask == 0))
     {
-
-      short const events = this->reactor_mask_to_poll_event (new_mask);
-
-#if defined (sun)
-      // Apparently events cannot be updated on-the-fly on Solaris so
-      // remove the existing events, and then add the new ones.
-      struct pollfd pfd[2];
-
-      pfd[0].fd      = handle;
-      pfd[0].events  = POLLREMOVE;
-      pfd[0].revents = 0;
-      pfd[1].fd      = (events == POLLREMOVE ? ACE_INVALID_HANDLE : handle);
-      pfd[1].events  = events;
-      pfd[1].revents = 0;
-
-      // Change the events associated with the given file descriptor.
-      if (ACE_OS::write (this->poll_fd_,
-                         pfd,
-                         sizeof (pfd)) != sizeof (pfd))
-        return -1;
-#elif defined (ACE_HAS_EVENT_POLL)
-
-      struct epoll_event epev;
-      ACE_OS::memset (&epev, 0, sizeof (epev));
-      int op;
-
-      // ACE_Event_Handler::NULL_MASK ???
-      if (new_mask == 0)
+      if (new_mask == ACE_Event_Handler::NULL_MASK)
         {
-          op          = EPOLL_CTL_DEL;
-          epev.events = 0;
-        }
-      else
-        {
-          op          = EPOLL_CTL_MOD;
-          epev.events = events | EPOLLONESHOT;
-        }
-
-      epev.data.fd = handle;
-
-      if (::epoll_ctl (this->poll_fd_, op, handle, &epev) == -1)
-        {
-          // If a handle is closed, epoll removes it from the poll set
-          // automatically - we may not know about it yet. If that's the
-          // case, a mod operation will fail with ENOENT. Retry it as
-          // an add. If it's any other failure, just fail outright.
-          if (op != EPOLL_CTL_MOD || errno != ENOENT ||
-              ::epoll_ctl (this->poll_fd_, EPOLL_CTL_ADD, handle, &epev) == -1)
+          // No event.  Remove from interest set.
+          if (this->disarm_i (handle, info) == -1)
             return -1;
         }
-      info->controlled = (op != EPOLL_CTL_DEL);
-#else
-      pollfd pfd[1];
-
-      pfd[0].fd      = handle;
-      pfd[0].events  = events;
-      pfd[0].revents = 0;
-
-      // Change the events associated with the given file descriptor.
-      if (ACE_OS::write (this->poll_fd_,
-                         pfd,
-                         sizeof (pfd)) != sizeof (pfd))
+      else if (this->arm_i (handle, info) == -1)
         return -1;
-#endif /*ACE_HAS_EVENT_POLL  */
     }
 
   return old_mask;
@@ -2503,6 +2330,220 @@ ACE_Dev_Poll_Reactor::reactor_mask_to_poll_event (ACE_Reactor_Mask mask)
   return events;
 }
 
+int
+ACE_Dev_Poll_Reactor::open_poll_i (size_t size)
+{
+  ACE_TRACE ("ACE_Dev_Poll_Reactor::open_poll_i");
+
+#if defined (ACE_HAS_EVENT_POLL)
+
+  ACE_OS::memset (&this->event_, 0, sizeof (this->event_));
+  this->event_.data.fd = ACE_INVALID_HANDLE;
+
+  // Initialize epoll:
+  this->poll_fd_ = ::epoll_create (size);
+  if (this->poll_fd_ == -1)
+    return -1;
+
+#else
+
+  // Allocate the array before opening the device to avoid a potential
+  // resource leak if allocation fails.
+  ACE_NEW_RETURN (this->dp_fds_,
+                  pollfd[size],
+                  -1);
+
+  // Open the `/dev/poll' character device.
+  this->poll_fd_ = ACE_OS::open ("/dev/poll", O_RDWR);
+  if (this->poll_fd_ == ACE_INVALID_HANDLE)
+    return -1;
+
+#endif  /* ACE_HAS_EVENT_POLL */
+
+  return 0;
+}
+
+int
+ACE_Dev_Poll_Reactor::close_poll_i (void)
+{
+  ACE_TRACE ("ACE_Dev_Poll_Reactor::close_poll_i");
+
+  int result = 0;
+
+  if (this->poll_fd_ != ACE_INVALID_HANDLE)
+    {
+      result = ACE_OS::close (this->poll_fd_);
+      this->poll_fd_ = ACE_INVALID_HANDLE;
+    }
+
+#if defined (ACE_HAS_EVENT_POLL)
+
+  ACE_OS::memset (&this->event_, 0, sizeof (this->event_));
+  this->event_.data.fd = ACE_INVALID_HANDLE;
+
+#else
+
+  delete [] this->dp_fds_;
+  this->dp_fds_ = 0;
+  this->start_pfds_ = 0;
+  this->end_pfds_ = 0;
+
+#endif  /* ACE_HAS_EVENT_POLL */
+
+  return result;
+}
+
+bool
+ACE_Dev_Poll_Reactor::io_event_ready_i (void)
+{
+#if defined (ACE_HAS_EVENT_POLL)
+  return this->event_.data.fd != ACE_INVALID_HANDLE;
+#else
+  return this->start_pfds_ != this->end_pfds_;
+#endif /* ACE_HAS_EVENT_POLL */
+}
+
+int
+ACE_Dev_Poll_Reactor::poll_i (ACE_Time_Value *this_timeout)
+{
+  ACE_TRACE ("ACE_Dev_Poll_Reactor::poll_i");
+
+  long const timeout =
+    (this_timeout == 0
+     ? -1 /* Infinity */
+     : static_cast<long> (this_timeout->msec ()));
+
+#if defined (ACE_HAS_EVENT_POLL)
+
+  // Wait for an event.
+  int const nfds = ::epoll_wait (this->poll_fd_,
+                                 &this->event_,
+                                 1,
+                                 static_cast<int> (timeout));
+
+#else
+
+  struct dvpoll dvp;
+
+  dvp.dp_fds = this->dp_fds_;
+  dvp.dp_nfds = this->handler_rep_.size ();
+  dvp.dp_timeout = timeout;  // Milliseconds
+
+  // Poll for events
+  int const nfds = ACE_OS::ioctl (this->poll_fd_, DP_POLL, &dvp);
+
+  // Retrieve the results from the pollfd array.
+  this->start_pfds_ = dvp.dp_fds;
+
+  // If nfds == 0 then end_pfds_ == start_pfds_ meaning that there is
+  // no work pending.  If nfds > 0 then there is work pending.
+  // Otherwise an error occurred.
+  if (nfds > -1)
+    this->end_pfds_ = this->start_pfds_ + nfds;
+#endif  /* ACE_HAS_EVENT_POLL */
+
+  return nfds;
+}
+
+int
+ACE_Dev_Poll_Reactor::arm_i (ACE_HANDLE handle, Event_Tuple *info)
+{
+  ACE_TRACE ("ACE_Dev_Poll_Reactor::arm_i");
+
+#if defined (ACE_HAS_EVENT_POLL)
+
+  struct epoll_event epev;
+  ACE_OS::memset (&epev, 0, sizeof (epev));
+  int const op = info->controlled ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+
+  epev.data.fd = handle;
+  epev.events  = this->reactor_mask_to_poll_event (info->mask);
+  // All but the notify handler get registered with oneshot to facilitate
+  // auto suspend before the upcall. See dispatch_io_event for more
+  // information.
+  if (info->event_handler != this->notify_handler_)
+    epev.events |= EPOLLONESHOT;
+
+  if (::epoll_ctl (this->poll_fd_, op, handle, &epev) == -1)
+    {
+      // If a handle is closed, epoll removes it from the poll set
+      // automatically - we may not know about it yet. If that's the
+      // case, a mod operation will fail with ENOENT. Retry it as
+      // an add. If it's any other failure, just fail outright.
+      if (op != EPOLL_CTL_MOD || errno != ENOENT ||
+          ::epoll_ctl (this->poll_fd_, EPOLL_CTL_ADD, handle, &epev) == -1)
+        return -1;
+    }
+  info->controlled = true;
+
+#else
+
+  short const events = this->reactor_mask_to_poll_event (info->mask);
+
+# if defined (sun)
+  // Apparently events cannot be updated on-the-fly on Solaris so
+  // remove the existing events, and then add the new ones.
+  struct pollfd pfd[2];
+
+  pfd[0].fd      = handle;
+  pfd[0].events  = POLLREMOVE;
+  pfd[0].revents = 0;
+  pfd[1].fd      = handle;
+  pfd[1].events  = events;
+  pfd[1].revents = 0;
+# else
+  struct pollfd pfd[1];
+
+  pfd[0].fd      = handle;
+  pfd[0].events  = events;
+  pfd[0].revents = 0;
+# endif /* sun */
+
+  // Change the events associated with the given file descriptor.
+  if (ACE_OS::write (this->poll_fd_, pfd, sizeof (pfd)) != sizeof (pfd))
+    return -1;
+
+#endif  /* ACE_HAS_EVENT_POLL */
+
+  return 0;
+}
+
+int
+ACE_Dev_Poll_Reactor::disarm_i (ACE_HANDLE handle, Event_Tuple *info)
+{
+  ACE_TRACE ("ACE_Dev_Poll_Reactor::disarm_i");
+
+#if defined (ACE_HAS_EVENT_POLL)
+
+  struct epoll_event epev;
+  ACE_OS::memset (&epev, 0, sizeof (epev));
+  static const int op = EPOLL_CTL_DEL;
+
+  epev.events  = 0;
+  epev.data.fd = handle;
+
+  if (::epoll_ctl (this->poll_fd_, op, handle, &epev) == -1)
+    return -1;
+  info->controlled = false;
+
+#else
+
+  ACE_UNUSED_ARG (info);
+
+  struct pollfd pfd[1];
+
+  pfd[0].fd      = handle;
+  pfd[0].events  = POLLREMOVE;
+  pfd[0].revents = 0;
+
+  if (ACE_OS::write (this->poll_fd_, pfd, sizeof (pfd)) != sizeof (pfd))
+    return -1;
+
+#endif  /* ACE_HAS_EVENT_POLL */
+
+  return 0;
+}
+
 #if defined (ACE_MT_SAFE) && (ACE_MT_SAFE != 0)
 namespace {
   void polite_sleep_hook (void *) { }
@@ -254,6 +254,7 @@ typedef ACE_Reactor_Token_T<ACE_DEV_POLL_TOKEN> ACE_Dev_Poll_Reactor_Token;
 
 class ACE_Export ACE_Dev_Poll_Reactor : public ACE_Reactor_Impl
 {
+protected:
 
   /**
    * @struct Event_Tuple
@@ -293,6 +294,11 @@ class ACE_Export ACE_Dev_Poll_Reactor : public ACE_Reactor_Impl
     /// Flag to say whether or not this handle is registered with epoll.
     bool controlled;
 
+    /// Number of the current registration of this handle, for
+    /// demultiplexers that deliver events of earlier registrations
+    /// too.  Unused with `/dev/poll' and `/dev/epoll'.
+    ACE_UINT32 generation;
+
     ACE_ALLOC_HOOK_DECLARE;
   };
 
@@ -921,6 +927,20 @@ protected:
 
   class Token_Guard;
 
+  /// Tag for the constructor that leaves the reactor closed.
+  enum Deferred_Open { DEFERRED_OPEN };
+
+  /// Initialize the members of a derived reactor.
+  /**
+   * Unlike the public constructors this one does not open() the
+   * reactor, since open() sets up the demultiplexer through virtual
+   * functions that can't yet reach the derived reactor while this
+   * constructor runs.  The derived reactor calls open() itself.
+   */
+  ACE_Dev_Poll_Reactor (Deferred_Open,
+                        int mask_signals,
+                        int s_queue);
+
   /// Non-locking version of wait_pending().
   /**
    * Returns non-zero if there are I/O events "ready" for dispatching,
@@ -961,7 +981,20 @@ protected:
   /// Returns: 0 if no events ready (token still held),
   ///          1 if an event was expired (token released),
   ///         -1 on error (token still held).
-  int dispatch_io_event (Token_Guard &guard);
+  virtual int dispatch_io_event (Token_Guard &guard);
+
+  /// Dispatch an IO event on @a handle to @a eh, once
+  /// dispatch_io_event() has found it and picked the @a callback for
+  /// it.  If @a reactor_resumes_eh is true the handler was suspended
+  /// for the upcall and is resumed after it.  Returns as
+  /// dispatch_io_event() does; the token is released unless -1 is
+  /// returned.
+  int dispatch_io_handler (Token_Guard &guard,
+                           ACE_HANDLE handle,
+                           ACE_Event_Handler *eh,
+                           ACE_Reactor_Mask disp_mask,
+                           int (ACE_Event_Handler::*callback)(ACE_HANDLE),
+                           bool reactor_resumes_eh);
 
   /// Register the given event handler with the reactor.
   int register_handler_i (ACE_HANDLE handle,
@@ -1002,6 +1035,38 @@ protected:
   /// Convert a reactor mask to its corresponding poll() event mask.
   short reactor_mask_to_poll_event (ACE_Reactor_Mask mask);
 
+  /**
+   * @name Demultiplexer Operations
+   *
+   * The operations on the `/dev/poll' or `/dev/epoll' device.  A
+   * derived reactor overrides them to use another demultiplexer with
+   * the same dispatching semantics, see ACE_Uring_Reactor.
+   */
+  //@{
+
+  /// Open the demultiplexer for handles up to @a size.
+  virtual int open_poll_i (size_t size);
+
+  /// Close the demultiplexer.
+  virtual int close_poll_i (void);
+
+  /// Returns true if an event the last poll_i() returned has not been
+  /// dispatched yet.
+  virtual bool io_event_ready_i (void);
+
+  /// Wait for I/O events until @a timeout (forever if 0) expires.
+  /// Returns the number of events, 0 on timeout and -1 on error.
+  virtual int poll_i (ACE_Time_Value *timeout);
+
+  /// Poll @a handle for the events in the mask of @a info.  The
+  /// caller must hold the repo lock.
+  virtual int arm_i (ACE_HANDLE handle, Event_Tuple *info);
+
+  /// Stop polling @a handle.  The caller must hold the repo lock.
+  virtual int disarm_i (ACE_HANDLE handle, Event_Tuple *info);
+
+  //@}
+
 protected:
 
   /// Has the reactor been initialized.
@@ -11,7 +11,8 @@ ACE_Dev_Poll_Reactor::Event_Tuple::Event_Tuple (ACE_Event_Handler *eh,
   : event_handler (eh),
     mask (m),
     suspended (is_suspended),
-    controlled (is_controlled)
+    controlled (is_controlled),
+    generation (0)
 {
 }
 
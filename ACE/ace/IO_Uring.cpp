@@ -0,0 +1,278 @@
+#include "ace/IO_Uring.h"
+
+#if defined (ACE_HAS_IO_URING)
+
+#include "ace/Log_Category.h"
+#include "ace/Time_Value.h"
+#include "ace/OS_NS_errno.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_sys_mman.h"
+#include "ace/OS_NS_unistd.h"
+
+#include /**/ <sys/syscall.h>
+
+#if !defined (__ACE_INLINE__)
+#include "ace/IO_Uring.inl"
+#endif /* __ACE_INLINE__ */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_ALLOC_HOOK_DEFINE(ACE_IO_Uring)
+
+ACE_IO_Uring::ACE_IO_Uring (void)
+  : ring_fd_ (ACE_INVALID_HANDLE)
+  , features_ (0)
+  , sq_ring_ (MAP_FAILED)
+  , sq_ring_size_ (0)
+  , cq_ring_ (MAP_FAILED)
+  , cq_ring_size_ (0)
+  , sqes_ (0)
+  , sqes_size_ (0)
+  , sq_khead_ (0)
+  , sq_ktail_ (0)
+  , sq_mask_ (0)
+  , sq_entries_ (0)
+  , sq_array_ (0)
+  , sqe_tail_ (0)
+  , cq_khead_ (0)
+  , cq_ktail_ (0)
+  , cq_mask_ (0)
+  , cqes_ (0)
+{
+}
+
+ACE_IO_Uring::~ACE_IO_Uring (void)
+{
+  (void) this->close ();
+}
+
+int
+ACE_IO_Uring::open (unsigned int entries, unsigned int cq_entries)
+{
+  ACE_TRACE ("ACE_IO_Uring::open");
+
+  if (this->is_open ())
+    {
+      errno = EBUSY;
+      return -1;
+    }
+
+  struct io_uring_params params;
+  ACE_OS::memset (&params, 0, sizeof (params));
+
+  if (cq_entries > entries)
+    {
+      params.flags |= IORING_SETUP_CQSIZE;
+      params.cq_entries = cq_entries;
+    }
+
+  // The kernel clamps the sizes instead of failing when they are too
+  // large.
+  params.flags |= IORING_SETUP_CLAMP;
+
+  int const fd = static_cast<int> (::syscall (__NR_io_uring_setup,
+                                              entries,
+                                              &params));
+  if (fd == -1)
+    return -1;
+
+  this->ring_fd_ = fd;
+  this->features_ = params.features;
+
+  // Waiting with a timeout through io_uring_enter() is what lets the
+  // reactor and proactor avoid an extra timeout request per wait.
+  if (!this->has_feature (IORING_FEAT_EXT_ARG))
+    {
+      (void) this->close ();
+      errno = ENOTSUP;
+      return -1;
+    }
+
+  this->sq_ring_size_ =
+    params.sq_off.array + params.sq_entries * sizeof (unsigned int);
+  this->cq_ring_size_ =
+    params.cq_off.cqes + params.cq_entries * sizeof (struct io_uring_cqe);
+
+  bool const single_mmap = this->has_feature (IORING_FEAT_SINGLE_MMAP);
+  if (single_mmap && this->cq_ring_size_ > this->sq_ring_size_)
+    this->sq_ring_size_ = this->cq_ring_size_;
+
+  this->sq_ring_ = ACE_OS::mmap (0,
+                                 this->sq_ring_size_,
+                                 PROT_READ | PROT_WRITE,
+                                 MAP_SHARED | MAP_POPULATE,
+                                 this->ring_fd_,
+                                 IORING_OFF_SQ_RING);
+  if (this->sq_ring_ == MAP_FAILED)
+    {
+      (void) this->close ();
+      return -1;
+    }
+
+  if (single_mmap)
+    {
+      this->cq_ring_ = this->sq_ring_;
+      this->cq_ring_size_ = this->sq_ring_size_;
+    }
+  else
+    {
+      this->cq_ring_ = ACE_OS::mmap (0,
+                                     this->cq_ring_size_,
+                                     PROT_READ | PROT_WRITE,
+                                     MAP_SHARED | MAP_POPULATE,
+                                     this->ring_fd_,
+                                     IORING_OFF_CQ_RING);
+      if (this->cq_ring_ == MAP_FAILED)
+        {
+          (void) this->close ();
+          return -1;
+        }
+    }
+
+  this->sqes_size_ = params.sq_entries * sizeof (struct io_uring_sqe);
+  void *sqes = ACE_OS::mmap (0,
+                             this->sqes_size_,
+                             PROT_READ | PROT_WRITE,
+                             MAP_SHARED | MAP_POPULATE,
+                             this->ring_fd_,
+                             IORING_OFF_SQES);
+  if (sqes == MAP_FAILED)
+    {
+      (void) this->close ();
+      return -1;
+    }
+  this->sqes_ = static_cast<struct io_uring_sqe *> (sqes);
+
+  char *sq = static_cast<char *> (this->sq_ring_);
+  this->sq_khead_ = reinterpret_cast<unsigned int *> (sq + params.sq_off.head);
+  this->sq_ktail_ = reinterpret_cast<unsigned int *> (sq + params.sq_off.tail);
+  this->sq_mask_ =
+    *reinterpret_cast<unsigned int *> (sq + params.sq_off.ring_mask);
+  this->sq_entries_ =
+    *reinterpret_cast<unsigned int *> (sq + params.sq_off.ring_entries);
+  this->sq_array_ =
+    reinterpret_cast<unsigned int *> (sq + params.sq_off.array);
+  this->sqe_tail_ = *this->sq_ktail_;
+
+  // SQEs are always handed out in ring order, so the indirection
+  // array can be set up once as an identity mapping.
+  for (unsigned int i = 0; i < this->sq_entries_; ++i)
+    this->sq_array_[i] = i;
+
+  char *cq = static_cast<char *> (this->cq_ring_);
+  this->cq_khead_ = reinterpret_cast<unsigned int *> (cq + params.cq_off.head);
+  this->cq_ktail_ = reinterpret_cast<unsigned int *> (cq + params.cq_off.tail);
+  this->cq_mask_ =
+    *reinterpret_cast<unsigned int *> (cq + params.cq_off.ring_mask);
+  this->cqes_ =
+    reinterpret_cast<struct io_uring_cqe *> (cq + params.cq_off.cqes);
+
+  return 0;
+}
+
+int
+ACE_IO_Uring::close (void)
+{
+  ACE_TRACE ("ACE_IO_Uring::close");
+
+  if (this->sqes_ != 0)
+    {
+      (void) ACE_OS::munmap (this->sqes_, this->sqes_size_);
+      this->sqes_ = 0;
+    }
+
+  if (this->cq_ring_ != MAP_FAILED && this->cq_ring_ != this->sq_ring_)
+    (void) ACE_OS::munmap (this->cq_ring_, this->cq_ring_size_);
+  this->cq_ring_ = MAP_FAILED;
+
+  if (this->sq_ring_ != MAP_FAILED)
+    (void) ACE_OS::munmap (this->sq_ring_, this->sq_ring_size_);
+  this->sq_ring_ = MAP_FAILED;
+
+  this->sq_khead_ = 0;
+  this->sq_ktail_ = 0;
+  this->sq_array_ = 0;
+  this->sq_mask_ = 0;
+  this->sq_entries_ = 0;
+  this->sqe_tail_ = 0;
+  this->cq_khead_ = 0;
+  this->cq_ktail_ = 0;
+  this->cq_mask_ = 0;
+  this->cqes_ = 0;
+  this->features_ = 0;
+
+  int result = 0;
+  if (this->ring_fd_ != ACE_INVALID_HANDLE)
+    {
+      result = ACE_OS::close (this->ring_fd_);
+      this->ring_fd_ = ACE_INVALID_HANDLE;
+    }
+
+  return result;
+}
+
+int
+ACE_IO_Uring::enter (unsigned int to_submit,
+                     unsigned int min_complete,
+                     const ACE_Time_Value *timeout)
+{
+  unsigned int flags = 0;
+  if (min_complete > 0)
+    flags |= IORING_ENTER_GETEVENTS;
+
+  struct __kernel_timespec ts;
+  struct io_uring_getevents_arg arg;
+  const void *argp = 0;
+  size_t argsz = 0;
+
+  if (timeout != 0 && min_complete > 0)
+    {
+      ts.tv_sec = timeout->sec ();
+      ts.tv_nsec = timeout->usec () * 1000;
+
+      ACE_OS::memset (&arg, 0, sizeof (arg));
+      arg.ts = reinterpret_cast<ACE_UINT64> (&ts);
+
+      flags |= IORING_ENTER_EXT_ARG;
+      argp = &arg;
+      argsz = sizeof (arg);
+    }
+
+  return static_cast<int> (::syscall (__NR_io_uring_enter,
+                                      this->ring_fd_,
+                                      to_submit,
+                                      min_complete,
+                                      flags,
+                                      argp,
+                                      argsz));
+}
+
+int
+ACE_IO_Uring::submit (void)
+{
+  unsigned int const to_submit = this->flush ();
+  if (to_submit == 0)
+    return 0;
+
+  return this->enter (to_submit);
+}
+
+void
+ACE_IO_Uring::dump (void) const
+{
+#if defined (ACE_HAS_DUMP)
+  ACE_TRACE ("ACE_IO_Uring::dump");
+
+  ACELIB_DEBUG ((LM_DEBUG, ACE_BEGIN_DUMP, this));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_TEXT ("ring_fd_ = %d\n"), this->ring_fd_));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_TEXT ("features_ = 0x%x\n"), this->features_));
+  ACELIB_DEBUG ((LM_DEBUG,
+                 ACE_TEXT ("sq_entries_ = %u\n"),
+                 this->sq_entries_));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_END_DUMP));
+#endif /* ACE_HAS_DUMP */
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_HAS_IO_URING */
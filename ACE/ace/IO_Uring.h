@@ -0,0 +1,247 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    IO_Uring.h
+ *
+ *  Thin wrapper around a Linux @c io_uring submission/completion
+ *  queue pair.
+ */
+//=============================================================================
+
+#ifndef ACE_IO_URING_H
+#define ACE_IO_URING_H
+
+#include /**/ "ace/pre.h"
+
+#include /**/ "ace/ACE_export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#if defined (ACE_HAS_IO_URING)
+
+#include "ace/Basic_Types.h"
+#include "ace/Copy_Disabled.h"
+#include "ace/os_include/os_stddef.h"
+
+#include /**/ <linux/io_uring.h>
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+class ACE_Time_Value;
+
+/**
+ * @class ACE_IO_Uring
+ *
+ * @brief Owns one @c io_uring instance and its memory mapped rings.
+ *
+ * The kernel shares two ring buffers with the process: the submission
+ * queue (SQ), into which requests (SQEs) are placed, and the
+ * completion queue (CQ), from which results (CQEs) are reaped.  A
+ * single @c io_uring_enter() system call both hands any number of
+ * queued SQEs to the kernel and, optionally, waits for completions,
+ * which is what makes batching possible.
+ *
+ * This class performs no locking of its own.  The owner must
+ * serialize all SQ operations (get_sqe(), flush()) among themselves,
+ * and all CQ operations (peek_cqe(), cqe_seen()) among themselves.
+ * The enter() call itself may be made concurrently from several
+ * threads, e.g. one thread blocking for completions while another
+ * submits new requests.
+ *
+ * @note Requires a kernel supporting @c IORING_FEAT_EXT_ARG (Linux
+ *       5.11 or later); open() fails with @c ENOTSUP otherwise.
+ */
+class ACE_Export ACE_IO_Uring : private ACE_Copy_Disabled
+{
+public:
+
+  /// Constructor.  The ring is not usable before open() is called.
+  ACE_IO_Uring (void);
+
+  /// Destructor; calls close().
+  ~ACE_IO_Uring (void);
+
+  /**
+   * Create the ring and map it into the process.
+   *
+   * @param entries    Number of submission queue entries.  The kernel
+   *                   rounds this up to the next power of two.
+   * @param cq_entries Number of completion queue entries.  If 0, the
+   *                   kernel default (twice @a entries) is used.
+   *
+   * @return 0 on success, -1 on failure with errno set.
+   */
+  int open (unsigned int entries, unsigned int cq_entries = 0);
+
+  /// Unmap the rings and close the ring descriptor.  Requests still
+  /// in flight are cancelled by the kernel.
+  int close (void);
+
+  /// Returns true if open() succeeded and close() was not called yet.
+  bool is_open (void) const;
+
+  /// The @c io_uring file descriptor.
+  ACE_HANDLE handle (void) const;
+
+  /// Returns true if the kernel reported the @c IORING_FEAT_* bit(s)
+  /// @a feature when the ring was opened.
+  bool has_feature (ACE_UINT32 feature) const;
+
+  /// Number of submission queue entries.
+  unsigned int sq_entries (void) const;
+
+  /**
+   * @name Submission Queue Operations
+   */
+  //@{
+
+  /// Return the next free SQE, cleared to all zeros, or 0 if the
+  /// submission queue is full.  The entry is not visible to the
+  /// kernel until flush() is called.
+  struct io_uring_sqe *get_sqe (void);
+
+  /// Make all SQEs obtained through get_sqe() visible to the kernel.
+  /// Returns the number of published entries the kernel has not
+  /// consumed yet, including any left over by an earlier, partially
+  /// failed enter(); the caller hands them over through enter().
+  unsigned int flush (void);
+
+  /// Number of SQEs obtained through get_sqe() that were not yet
+  /// returned by flush().
+  unsigned int sq_pending (void) const;
+
+  /// Number of SQEs get_sqe() can hand out before the submission
+  /// queue is full.
+  unsigned int sq_space_left (void) const;
+
+  //@}
+
+  /**
+   * Issue the @c io_uring_enter() system call.
+   *
+   * @param to_submit    Number of flushed SQEs to submit.
+   * @param min_complete If non-zero, block until at least this many
+   *                     completions are available.
+   * @param timeout      If non-zero, the maximum (relative) time to
+   *                     wait for @a min_complete completions.
+   *
+   * @return The number of SQEs consumed, or -1 with errno set.  If the
+   *         wait timed out, errno is @c ETIME.
+   */
+  int enter (unsigned int to_submit,
+             unsigned int min_complete = 0,
+             const ACE_Time_Value *timeout = 0);
+
+  /// Flush all pending SQEs and submit them without waiting.
+  int submit (void);
+
+  /**
+   * @name Completion Queue Operations
+   */
+  //@{
+
+  /// Return the oldest unreaped CQE, or 0 if the completion queue is
+  /// empty.  Does not block.
+  struct io_uring_cqe *peek_cqe (void);
+
+  /// Mark the CQE returned by the last peek_cqe() call as consumed.
+  void cqe_seen (void);
+
+  /// Number of CQEs available for reaping.
+  unsigned int cq_ready (void) const;
+
+  //@}
+
+  /**
+   * @name Request Preparation Helpers
+   *
+   * Fill in an SQE obtained through get_sqe().
+   */
+  //@{
+
+  static void prep_poll_add (struct io_uring_sqe *sqe,
+                             ACE_HANDLE handle,
+                             ACE_UINT32 poll_mask,
+                             ACE_UINT64 user_data);
+
+  static void prep_poll_remove (struct io_uring_sqe *sqe,
+                                ACE_UINT64 target_user_data,
+                                ACE_UINT64 user_data);
+
+  static void prep_rw (struct io_uring_sqe *sqe,
+                       ACE_UINT8 opcode,
+                       ACE_HANDLE handle,
+                       const void *addr,
+                       ACE_UINT32 len,
+                       ACE_UINT64 offset,
+                       ACE_UINT64 user_data);
+
+  static void prep_cancel (struct io_uring_sqe *sqe,
+                           ACE_UINT64 target_user_data,
+                           ACE_UINT64 user_data);
+
+  //@}
+
+  /// Dump the state of an object.
+  void dump (void) const;
+
+  /// Declare the dynamic allocation hooks.
+  ACE_ALLOC_HOOK_DECLARE;
+
+private:
+
+  /// The ring descriptor returned by @c io_uring_setup().
+  ACE_HANDLE ring_fd_;
+
+  /// Features reported by the kernel.
+  ACE_UINT32 features_;
+
+  /// Base and length of the submission queue ring mapping.
+  void *sq_ring_;
+  size_t sq_ring_size_;
+
+  /// Base and length of the completion queue ring mapping.  Same as
+  /// the submission queue ring mapping if the kernel supports
+  /// @c IORING_FEAT_SINGLE_MMAP.
+  void *cq_ring_;
+  size_t cq_ring_size_;
+
+  /// The SQE array mapping.
+  struct io_uring_sqe *sqes_;
+  size_t sqes_size_;
+
+  /// @name Pointers into the submission queue ring.
+  //@{
+  unsigned int *sq_khead_;
+  unsigned int *sq_ktail_;
+  unsigned int sq_mask_;
+  unsigned int sq_entries_;
+  unsigned int *sq_array_;
+  //@}
+
+  /// Local tail, advanced by get_sqe() and published by flush().
+  unsigned int sqe_tail_;
+
+  /// @name Pointers into the completion queue ring.
+  //@{
+  unsigned int *cq_khead_;
+  unsigned int *cq_ktail_;
+  unsigned int cq_mask_;
+  struct io_uring_cqe *cqes_;
+  //@}
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#if defined (__ACE_INLINE__)
+#include "ace/IO_Uring.inl"
+#endif /* __ACE_INLINE__ */
+
+#endif /* ACE_HAS_IO_URING */
+
+#include /**/ "ace/post.h"
+
+#endif /* ACE_IO_URING_H */
@@ -0,0 +1,169 @@
+// -*- C++ -*-
+#include "ace/OS_NS_string.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_INLINE bool
+ACE_IO_Uring::is_open (void) const
+{
+  return this->ring_fd_ != ACE_INVALID_HANDLE;
+}
+
+ACE_INLINE ACE_HANDLE
+ACE_IO_Uring::handle (void) const
+{
+  return this->ring_fd_;
+}
+
+ACE_INLINE bool
+ACE_IO_Uring::has_feature (ACE_UINT32 feature) const
+{
+  return (this->features_ & feature) == feature;
+}
+
+ACE_INLINE unsigned int
+ACE_IO_Uring::sq_entries (void) const
+{
+  return this->sq_entries_;
+}
+
+ACE_INLINE struct io_uring_sqe *
+ACE_IO_Uring::get_sqe (void)
+{
+  // The kernel advances the head as it consumes entries, so it has to
+  // be loaded with acquire semantics.
+  unsigned int const head =
+    __atomic_load_n (this->sq_khead_, __ATOMIC_ACQUIRE);
+
+  if (this->sqe_tail_ - head >= this->sq_entries_)
+    return 0;
+
+  struct io_uring_sqe *sqe =
+    &this->sqes_[this->sqe_tail_ & this->sq_mask_];
+  ++this->sqe_tail_;
+
+  ACE_OS::memset (sqe, 0, sizeof (*sqe));
+  return sqe;
+}
+
+ACE_INLINE unsigned int
+ACE_IO_Uring::flush (void)
+{
+  // Only this side writes the tail, so a plain read is fine.  The
+  // store must be a release so the kernel sees completed SQEs.
+  if (*this->sq_ktail_ != this->sqe_tail_)
+    __atomic_store_n (this->sq_ktail_, this->sqe_tail_, __ATOMIC_RELEASE);
+
+  return this->sqe_tail_
+    - __atomic_load_n (this->sq_khead_, __ATOMIC_ACQUIRE);
+}
+
+ACE_INLINE unsigned int
+ACE_IO_Uring::sq_pending (void) const
+{
+  return this->sqe_tail_ - *this->sq_ktail_;
+}
+
+ACE_INLINE unsigned int
+ACE_IO_Uring::sq_space_left (void) const
+{
+  return this->sq_entries_ - (this->sqe_tail_
+                              - __atomic_load_n (this->sq_khead_,
+                                                 __ATOMIC_ACQUIRE));
+}
+
+ACE_INLINE struct io_uring_cqe *
+ACE_IO_Uring::peek_cqe (void)
+{
+  unsigned int const head = *this->cq_khead_;
+  unsigned int const tail =
+    __atomic_load_n (this->cq_ktail_, __ATOMIC_ACQUIRE);
+
+  if (head == tail)
+    return 0;
+
+  return &this->cqes_[head & this->cq_mask_];
+}
+
+ACE_INLINE void
+ACE_IO_Uring::cqe_seen (void)
+{
+  // Release the slot back to the kernel only once the entry has been
+  // completely read.
+  __atomic_store_n (this->cq_khead_,
+                    *this->cq_khead_ + 1,
+                    __ATOMIC_RELEASE);
+}
+
+ACE_INLINE unsigned int
+ACE_IO_Uring::cq_ready (void) const
+{
+  return __atomic_load_n (this->cq_ktail_, __ATOMIC_ACQUIRE)
+    - *this->cq_khead_;
+}
+
+ACE_INLINE void
+ACE_IO_Uring::prep_rw (struct io_uring_sqe *sqe,
+                       ACE_UINT8 opcode,
+                       ACE_HANDLE handle,
+                       const void *addr,
+                       ACE_UINT32 len,
+                       ACE_UINT64 offset,
+                       ACE_UINT64 user_data)
+{
+  sqe->opcode = opcode;
+  sqe->fd = handle;
+  sqe->off = offset;
+  sqe->addr = reinterpret_cast<ACE_UINT64> (addr);
+  sqe->len = len;
+  sqe->user_data = user_data;
+}
+
+ACE_INLINE void
+ACE_IO_Uring::prep_poll_add (struct io_uring_sqe *sqe,
+                             ACE_HANDLE handle,
+                             ACE_UINT32 poll_mask,
+                             ACE_UINT64 user_data)
+{
+  ACE_IO_Uring::prep_rw (sqe, IORING_OP_POLL_ADD, handle, 0, 0, 0, user_data);
+
+#if defined (ACE_BIG_ENDIAN)
+  // The 32 bit poll mask is stored as two swapped 16 bit halves so
+  // that the lower half lines up with the legacy 16 bit field.
+  poll_mask = ((poll_mask & 0x0000FFFF) << 16) | (poll_mask >> 16);
+#endif /* ACE_BIG_ENDIAN */
+
+  sqe->poll32_events = poll_mask;
+}
+
+ACE_INLINE void
+ACE_IO_Uring::prep_poll_remove (struct io_uring_sqe *sqe,
+                                ACE_UINT64 target_user_data,
+                                ACE_UINT64 user_data)
+{
+  ACE_IO_Uring::prep_rw (sqe,
+                         IORING_OP_POLL_REMOVE,
+                         -1,
+                         0,
+                         0,
+                         0,
+                         user_data);
+  sqe->addr = target_user_data;
+}
+
+ACE_INLINE void
+ACE_IO_Uring::prep_cancel (struct io_uring_sqe *sqe,
+                           ACE_UINT64 target_user_data,
+                           ACE_UINT64 user_data)
+{
+  ACE_IO_Uring::prep_rw (sqe,
+                         IORING_OP_ASYNC_CANCEL,
+                         -1,
+                         0,
+                         0,
+                         0,
+                         user_data);
+  sqe->addr = target_user_data;
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
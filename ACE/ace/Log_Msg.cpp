@@ -1047,6 +1047,59 @@ ACE_Log_Msg::log (const ACE_TCHAR *format_str,
   // errno!
   ACE_Errno_Guard guard (errno);
 
+  // Retrieve the flags in a local variable on the stack, it is
+  // accessed by multiple threads and within this operation we
+  // check it several times, so this way we only lock once.  The
+  // custom backend is read along with them.
+  u_long flags = 0;
+  ACE_Log_Msg_Backend *custom_backend = 0;
+  {
+    ACE_MT (ACE_GUARD_RETURN (ACE_Recursive_Thread_Mutex, ace_mon,
+                              *ACE_Log_Msg_Manager::get_lock (), -1));
+    flags = ACE_Log_Msg::flags_;
+    custom_backend = ACE_Log_Msg_Manager::custom_backend_;
+  }
+
+#if !defined (ACE_LACKS_VA_COPY)
+  // A custom backend that is the only destination of the message may
+  // record it without having it formatted, e.g., ACE_Log_Msg_Binary.
+  // Like log(ACE_Log_Record &), it is only called without the lock
+  // if it copes with concurrent calls.  Messages that carry a
+  // timestamp prefix or are logged from a %r callback are always
+  // formatted here.
+  if (custom_backend != 0
+      && (flags & (ACE_Log_Msg::STDERR
+                   | ACE_Log_Msg::LOGGER
+                   | ACE_Log_Msg::OSTREAM
+                   | ACE_Log_Msg::MSG_CALLBACK
+                   | ACE_Log_Msg::SILENT
+                   | ACE_Log_Msg::SYSLOG
+                   | ACE_Log_Msg::CUSTOM)) == ACE_Log_Msg::CUSTOM
+      && this->timestamp_ == 0
+      && ACE_Log_Msg::msg_off_ == 0
+      && custom_backend->concurrent ())
+    {
+      bool const tracing = this->tracing_enabled ();
+      this->stop_tracing ();
+
+      va_list args;
+      va_copy (args, argp);
+      ssize_t const result = custom_backend->log_unformatted (*this,
+                                                              log_priority,
+                                                              format_str,
+                                                              args);
+      va_end (args);
+
+      if (tracing)
+        this->start_tracing ();
+
+      if (result != -1 || errno != ENOTSUP)
+        return result;
+    }
+#else
+  ACE_UNUSED_ARG (custom_backend);
+#endif /* !ACE_LACKS_VA_COPY */
+
   ACE_Log_Record log_record (log_priority,
                              ACE_OS::gettimeofday (),
                              this->getpid ());
@@ -1071,11 +1124,6 @@ ACE_Log_Msg::log (const ACE_TCHAR *format_str,
   bool abort_prog = false;
   int exit_value = 0;
 
-  // Retrieve the flags in a local variable on the stack, it is
-  // accessed by multiple threads and within this operation we
-  // check it several times, so this way we only lock once
-  u_long flags = this->flags ();
-
   if (ACE_BIT_ENABLED (flags, ACE_Log_Msg::VERBOSE))
     {
       // Prepend the program name onto this message
@@ -2864,8 +2912,17 @@ ACE_Log_Msg::log (ACE_Log_Record &log_record,
 
   // Retrieve the flags in a local variable on the stack, it is
   // accessed by multiple threads and within this operation we
-  // check it several times, so this way we only lock once
-  u_long flags = this->flags ();
+  // check it several times, so this way we only lock once.  The
+  // custom backend is read along with them.
+  u_long flags = 0;
+  ACE_Log_Msg_Backend *custom_backend = 0;
+  {
+    ACE_MT (ACE_GUARD_RETURN (ACE_Recursive_Thread_Mutex, ace_mon,
+                              *ACE_Log_Msg_Manager::get_lock (), -1));
+    flags = ACE_Log_Msg::flags_;
+    if (ACE_BIT_ENABLED (flags, ACE_Log_Msg::CUSTOM))
+      custom_backend = ACE_Log_Msg_Manager::custom_backend_;
+  }
 
   // Format the message and print it to stderr and/or ship it off to
   // the log_client daemon, and/or print it to the ostream.  Of
@@ -2889,57 +2946,77 @@ ACE_Log_Msg::log (ACE_Log_Record &log_record,
           this->msg_callback ()->log (log_record);
         }
 
-      // Make sure that the lock is held during all this.
-      ACE_MT (ACE_GUARD_RETURN (ACE_Recursive_Thread_Mutex, ace_mon,
-                                *ACE_Log_Msg_Manager::get_lock (),
-                                -1));
+      // A custom backend that copes with concurrent calls, such as
+      // ACE_Log_Msg_Async, gets the record without the lock, so that
+      // threads logging only to it do not hold the lock while it
+      // works.
+      if (custom_backend != 0 && custom_backend->concurrent ())
+        {
+          result = custom_backend->log (log_record);
+          custom_backend = 0;
+        }
 
 #if !defined ACE_LACKS_STDERR || defined ACE_FACE_DEV
-      if (ACE_BIT_ENABLED (flags,
-                           ACE_Log_Msg::STDERR)
-          && !suppress_stderr) // This is taken care of by our caller.
-        log_record.print (ACE_Log_Msg::local_host_,
-                          flags,
-                          stderr);
+      bool const to_stderr =
+        ACE_BIT_ENABLED (flags, ACE_Log_Msg::STDERR)
+        && !suppress_stderr; // This is taken care of by our caller.
 #else
+      bool const to_stderr = false;
       ACE_UNUSED_ARG (suppress_stderr);
 #endif
 
-      if (ACE_BIT_ENABLED (flags, ACE_Log_Msg::CUSTOM) ||
-          ACE_BIT_ENABLED (flags, ACE_Log_Msg::SYSLOG) ||
-          ACE_BIT_ENABLED (flags, ACE_Log_Msg::LOGGER))
+      if (to_stderr
+          || custom_backend != 0
+          || ACE_BIT_ENABLED (flags, ACE_Log_Msg::SYSLOG)
+          || ACE_BIT_ENABLED (flags, ACE_Log_Msg::LOGGER)
+          || ACE_BIT_ENABLED (flags, ACE_Log_Msg::OSTREAM))
         {
-          // Be sure that there is a message_queue_, with multiple threads.
-          ACE_MT (ACE_Log_Msg_Manager::init_backend ());
-        }
+          // Make sure that the lock is held during all this.
+          ACE_MT (ACE_GUARD_RETURN (ACE_Recursive_Thread_Mutex, ace_mon,
+                                    *ACE_Log_Msg_Manager::get_lock (),
+                                    -1));
 
-      if (ACE_BIT_ENABLED (flags, ACE_Log_Msg::LOGGER) ||
-          ACE_BIT_ENABLED (flags, ACE_Log_Msg::SYSLOG))
-        {
-          result =
-            ACE_Log_Msg_Manager::log_backend_->log (log_record);
-        }
+#if !defined ACE_LACKS_STDERR || defined ACE_FACE_DEV
+          if (to_stderr)
+            log_record.print (ACE_Log_Msg::local_host_,
+                              flags,
+                              stderr);
+#endif
 
-      if (ACE_BIT_ENABLED (flags, ACE_Log_Msg::CUSTOM) &&
-          ACE_Log_Msg_Manager::custom_backend_ != 0)
-        {
-          result =
-            ACE_Log_Msg_Manager::custom_backend_->log (log_record);
-        }
+          if (custom_backend != 0 ||
+              ACE_BIT_ENABLED (flags, ACE_Log_Msg::SYSLOG) ||
+              ACE_BIT_ENABLED (flags, ACE_Log_Msg::LOGGER))
+            {
+              // Be sure that there is a message_queue_, with multiple threads.
+              ACE_MT (ACE_Log_Msg_Manager::init_backend ());
+            }
+
+          if (ACE_BIT_ENABLED (flags, ACE_Log_Msg::LOGGER) ||
+              ACE_BIT_ENABLED (flags, ACE_Log_Msg::SYSLOG))
+            {
+              result =
+                ACE_Log_Msg_Manager::log_backend_->log (log_record);
+            }
 
-      // This must come last, after the other two print operations
-      // (see the <ACE_Log_Record::print> method for details).
-      if (ACE_BIT_ENABLED (flags,
-                           ACE_Log_Msg::OSTREAM)
-          && this->msg_ostream () != 0)
-        log_record.print (ACE_Log_Msg::local_host_,
-                          flags,
+          if (custom_backend != 0)
+            {
+              result = custom_backend->log (log_record);
+            }
+
+          // This must come last, after the other two print operations
+          // (see the <ACE_Log_Record::print> method for details).
+          if (ACE_BIT_ENABLED (flags,
+                               ACE_Log_Msg::OSTREAM)
+              && this->msg_ostream () != 0)
+            log_record.print (ACE_Log_Msg::local_host_,
+                              flags,
 #if defined (ACE_LACKS_IOSTREAM_TOTALLY)
-                          static_cast<FILE *> (this->msg_ostream ())
+                              static_cast<FILE *> (this->msg_ostream ())
 #else  /* ! ACE_LACKS_IOSTREAM_TOTALLY */
-                          *this->msg_ostream ()
+                              *this->msg_ostream ()
 #endif /* ! ACE_LACKS_IOSTREAM_TOTALLY */
-                          );
+                              );
+        }
 
       if (tracing)
         this->start_tracing ();
@@ -0,0 +1,601 @@
+#include "ace/Log_Msg_Async.h"
+#include "ace/Log_Msg.h"
+#include "ace/Log_Record.h"
+#include "ace/Log_Category.h"
+#include "ace/Log_Msg_IPC.h"
+#include "ace/Log_Msg_UNIX_Syslog.h"
+#include "ace/Log_Msg_NT_Event_Log.h"
+#include "ace/Thread.h"
+#include "ace/Time_Value.h"
+#include "ace/OS_Memory.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_sys_time.h"
+#include "ace/OS_NS_unistd.h"
+
+// FUZZ: disable check_for_streams_include
+#include "ace/streams.h"
+
+#if defined (WIN32) && !defined (ACE_HAS_WINCE) && !defined (ACE_HAS_PHARLAP)
+#  define ACE_LOG_MSG_ASYNC_SYSLOG_BACKEND ACE_Log_Msg_NT_Event_Log
+#elif !defined (ACE_LACKS_UNIX_SYSLOG) && !defined (ACE_HAS_WINCE)
+#  define ACE_LOG_MSG_ASYNC_SYSLOG_BACKEND ACE_Log_Msg_UNIX_Syslog
+#endif /* WIN32 */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+#if defined (ACE_HAS_THREADS)
+
+/**
+ * Header of a record in a ring, followed by the nul terminated
+ * message.  Entries take a multiple of the size of the header, so a
+ * header always fits between an entry and the end of the ring.
+ */
+struct ACE_Log_Msg_Async_Entry
+{
+  /// Bytes taken in the ring, header included.
+  ACE_UINT32 size_;
+
+  /// Priority of the record, 0 for the padding that skips the end of
+  /// the ring.
+  ACE_UINT32 type_;
+
+  ACE_UINT32 pid_;
+  ACE_UINT32 usecs_;
+  ACE_UINT64 secs_;
+
+  /// Characters in the message, without the nul.
+  ACE_UINT32 length_;
+
+  /// Non-zero if the category of the record disables printing it.
+  ACE_UINT32 quiet_;
+};
+
+/**
+ * Ring of one thread.  The thread appends at <head_> and the drain
+ * thread consumes at <tail_>; both only grow, and are taken modulo
+ * the size of the ring.  Only the owning thread changes <head_> and
+ * only the drain thread changes <tail_>.  The read-modify-write
+ * operations of ACE_Atomic_Op are full memory barriers, so the drain
+ * thread sees an entry before the new <head_>, and the owning thread
+ * reuses space only after the entry in it was read.
+ */
+class ACE_Log_Msg_Async_Ring
+{
+public:
+  ACE_Log_Msg_Async_Ring (size_t size)
+    : buffer_ (0),
+      size_ (size),
+      head_ (0),
+      tail_ (0),
+      dropped_ (0),
+      orphaned_ (0),
+      reported_ (0),
+      next_ (0)
+  {
+    ACE_NEW (this->buffer_, char[size]);
+  }
+
+  ~ACE_Log_Msg_Async_Ring (void)
+  {
+    delete [] this->buffer_;
+  }
+
+  /// Read the value of @a counter, which the other side changes.
+  static unsigned long load (ACE_Atomic_Op<ACE_SYNCH_MUTEX, unsigned long> &counter)
+  {
+    return counter += 0;
+  }
+
+  ACE_Log_Msg_Async_Entry *entry (unsigned long position)
+  {
+    return reinterpret_cast<ACE_Log_Msg_Async_Entry *> (
+      this->buffer_ + (position & (this->size_ - 1)));
+  }
+
+  char *buffer_;
+  size_t size_;
+  ACE_Atomic_Op<ACE_SYNCH_MUTEX, unsigned long> head_;
+  ACE_Atomic_Op<ACE_SYNCH_MUTEX, unsigned long> tail_;
+
+  /// Records the owning thread could not append.
+  ACE_Atomic_Op<ACE_SYNCH_MUTEX, unsigned long> dropped_;
+
+  /// Set when the owning thread exits.
+  ACE_Atomic_Op<ACE_SYNCH_MUTEX, unsigned long> orphaned_;
+
+  /// Value of <dropped_> the drain thread last reported.
+  unsigned long reported_;
+
+  ACE_Log_Msg_Async_Ring *next_;
+};
+
+# if defined (ACE_HAS_THR_C_DEST)
+#   define LOCAL_EXTERN_PREFIX extern "C"
+# else
+#   define LOCAL_EXTERN_PREFIX
+# endif /* ACE_HAS_THR_C_DEST */
+
+/// Called when a thread that logged exits.  Its ring is released by
+/// the drain thread once it is empty.
+LOCAL_EXTERN_PREFIX
+void
+ACE_Log_Msg_Async_cleanup (void *ptr)
+{
+  if (ptr != 0)
+    ++static_cast<ACE_Log_Msg_Async_Ring *> (ptr)->orphaned_;
+}
+
+#endif /* ACE_HAS_THREADS */
+
+ACE_ALLOC_HOOK_DEFINE(ACE_Log_Msg_Async)
+
+ACE_Log_Msg_Async::ACE_Log_Msg_Async (size_t buffer_size)
+  : buffer_size_ (0),
+    flags_ (0),
+    ostream_ (0),
+    backend_ (0),
+    record_ (0),
+    verbose_msg_ (0),
+    released_dropped_ (0)
+#if defined (ACE_HAS_THREADS)
+  , key_created_ (false),
+    rings_ (0),
+    running_ (false),
+    thr_id_ (ACE_OS::NULL_thread),
+    thr_handle_ (ACE_OS::NULL_hthread)
+#endif /* ACE_HAS_THREADS */
+{
+  // The ring must hold the longest record, and its size must be a
+  // power of two.
+  size_t const smallest =
+    2 * (sizeof (ACE_TCHAR) * (ACE_Log_Record::MAXLOGMSGLEN + 1) + 64);
+  this->buffer_size_ = 1024;
+  while (this->buffer_size_ < buffer_size || this->buffer_size_ < smallest)
+    this->buffer_size_ <<= 1;
+
+  ACE_NEW (this->record_, ACE_Log_Record);
+  ACE_NEW (this->verbose_msg_,
+           ACE_TCHAR[ACE_Log_Record::MAXVERBOSELOGMSGLEN]);
+
+#if defined (ACE_HAS_THREADS)
+  if (ACE_Thread::keycreate (&this->key_,
+                             &ACE_Log_Msg_Async_cleanup) == 0)
+    this->key_created_ = true;
+#endif /* ACE_HAS_THREADS */
+}
+
+ACE_Log_Msg_Async::~ACE_Log_Msg_Async (void)
+{
+  (void) this->close ();
+
+#if defined (ACE_HAS_THREADS)
+  // Once the key is gone, exiting threads no longer touch their ring.
+  if (this->key_created_)
+    ACE_Thread::keyfree (this->key_);
+
+  while (this->rings_ != 0)
+    {
+      Ring *ring = this->rings_;
+      this->rings_ = ring->next_;
+      delete ring;
+    }
+#endif /* ACE_HAS_THREADS */
+
+  delete this->backend_;
+  delete this->record_;
+  delete [] this->verbose_msg_;
+}
+
+void
+ACE_Log_Msg_Async::destinations (u_long flags, ACE_OSTREAM_TYPE *ostream)
+{
+  ACE_GUARD (ACE_SYNCH_MUTEX, ace_mon, this->drain_lock_);
+
+  this->flags_ = flags & (ACE_Log_Msg::OSTREAM
+                          | ACE_Log_Msg::SYSLOG
+                          | ACE_Log_Msg::LOGGER);
+
+  if (ACE_BIT_ENABLED (this->flags_, ACE_Log_Msg::OSTREAM))
+    this->ostream_ = ostream != 0 ? ostream : ACE_DEFAULT_LOG_STREAM;
+  else
+    this->ostream_ = 0;
+
+  // A different backend may be needed; open() creates it.
+  if (this->backend_ != 0)
+    {
+      this->backend_->close ();
+      delete this->backend_;
+      this->backend_ = 0;
+    }
+}
+
+void
+ACE_Log_Msg_Async::msg_ostream (ACE_OSTREAM_TYPE *ostream)
+{
+  this->ostream_ = ostream;
+}
+
+unsigned long
+ACE_Log_Msg_Async::dropped (void)
+{
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->drain_lock_, 0);
+
+  unsigned long dropped = this->released_dropped_;
+#if defined (ACE_HAS_THREADS)
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_rings_mon, this->rings_lock_, 0);
+  for (Ring *ring = this->rings_; ring != 0; ring = ring->next_)
+    dropped += ring->dropped_.value ();
+#endif /* ACE_HAS_THREADS */
+  return dropped;
+}
+
+int
+ACE_Log_Msg_Async::acquire (void)
+{
+  return this->drain_lock_.acquire ();
+}
+
+int
+ACE_Log_Msg_Async::release (void)
+{
+  return this->drain_lock_.release ();
+}
+
+bool
+ACE_Log_Msg_Async::concurrent (void) const
+{
+  return true;
+}
+
+int
+ACE_Log_Msg_Async::open (const ACE_TCHAR *logger_key)
+{
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->drain_lock_, -1);
+
+  if (this->backend_ == 0)
+    {
+#if defined (ACE_LOG_MSG_ASYNC_SYSLOG_BACKEND)
+      if (ACE_BIT_ENABLED (this->flags_, ACE_Log_Msg::SYSLOG))
+        ACE_NEW_RETURN (this->backend_,
+                        ACE_LOG_MSG_ASYNC_SYSLOG_BACKEND,
+                        -1);
+      else
+#endif /* ACE_LOG_MSG_ASYNC_SYSLOG_BACKEND */
+      if (ACE_BIT_ENABLED (this->flags_, ACE_Log_Msg::LOGGER))
+        ACE_NEW_RETURN (this->backend_,
+                        ACE_Log_Msg_IPC,
+                        -1);
+    }
+
+  if (this->backend_ != 0)
+    {
+      // As in ACE_Log_Msg::open(), syslog can do without a key but
+      // the logging daemon cannot.
+      if (logger_key == 0
+          && ACE_BIT_DISABLED (this->flags_, ACE_Log_Msg::SYSLOG))
+        return -1;
+
+      if (this->backend_->open (logger_key) == -1)
+        return -1;
+    }
+
+#if defined (ACE_HAS_THREADS)
+  if (!this->running_)
+    {
+      if (!this->key_created_
+          || ACE_Thread::spawn (&ACE_Log_Msg_Async::drain_thread,
+                                this,
+                                THR_NEW_LWP | THR_JOINABLE,
+                                &this->thr_id_,
+                                &this->thr_handle_) == -1)
+        return -1;
+
+      this->running_ = true;
+    }
+#endif /* ACE_HAS_THREADS */
+
+  return 0;
+}
+
+int
+ACE_Log_Msg_Async::reset (void)
+{
+  // ACE_Log_Msg calls this with its lock held, so the drain thread,
+  // which can need that lock when it starts or exits, is not stopped
+  // here.
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->drain_lock_, -1);
+
+  this->drain ();
+
+  if (this->backend_ != 0)
+    return this->backend_->reset ();
+  return 0;
+}
+
+int
+ACE_Log_Msg_Async::close (void)
+{
+#if defined (ACE_HAS_THREADS)
+  bool stop = false;
+  {
+    ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->drain_lock_, -1);
+    stop = this->running_;
+    this->running_ = false;
+  }
+
+  if (stop)
+    {
+      this->wakeup_.signal ();
+
+      // close() is called by the drain thread itself if its
+      // ACE_Log_Msg instance is the last one to go.
+      if (!ACE_OS::thr_equal (ACE_OS::thr_self (), this->thr_id_))
+        ACE_Thread::join (this->thr_handle_);
+    }
+#endif /* ACE_HAS_THREADS */
+
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->drain_lock_, -1);
+
+  this->drain ();
+
+  if (this->backend_ != 0)
+    return this->backend_->close ();
+  return 0;
+}
+
+ssize_t
+ACE_Log_Msg_Async::log (ACE_Log_Record &log_record)
+{
+  bool const quiet =
+    log_record.category () != 0
+    && !log_record.category ()->log_priority_enabled (
+          ACE_Log_Priority (log_record.type ()));
+
+#if defined (ACE_HAS_THREADS)
+  Ring *ring = this->ring ();
+  if (ring == 0)
+    return -1;
+
+  size_t const length = log_record.msg_data_len () - 1;
+  size_t const unit = sizeof (ACE_Log_Msg_Async_Entry);
+  size_t const needed =
+    (unit + (length + 1) * sizeof (ACE_TCHAR) + unit - 1) / unit * unit;
+
+  unsigned long const head = ring->head_.value ();
+  size_t const used = head - Ring::load (ring->tail_);
+  size_t const to_end = ring->size_ - (head & (ring->size_ - 1));
+  size_t const padding = needed > to_end ? to_end : 0;
+
+  if (used + padding + needed > ring->size_)
+    {
+      ++ring->dropped_;
+      return -1;
+    }
+
+  if (padding != 0)
+    {
+      ACE_Log_Msg_Async_Entry *skip = ring->entry (head);
+      skip->size_ = static_cast<ACE_UINT32> (padding);
+      skip->type_ = 0;
+    }
+
+  ACE_Log_Msg_Async_Entry *entry = ring->entry (head + padding);
+  ACE_Time_Value const time_stamp = log_record.time_stamp ();
+  entry->size_ = static_cast<ACE_UINT32> (needed);
+  entry->type_ = log_record.type ();
+  entry->pid_ = static_cast<ACE_UINT32> (log_record.pid ());
+  entry->usecs_ = static_cast<ACE_UINT32> (time_stamp.usec ());
+  entry->secs_ = static_cast<ACE_UINT64> (time_stamp.sec ());
+  entry->length_ = static_cast<ACE_UINT32> (length);
+  entry->quiet_ = quiet;
+  ACE_OS::memcpy (entry + 1,
+                  log_record.msg_data (),
+                  (length + 1) * sizeof (ACE_TCHAR));
+
+  // Publish the record.
+  ring->head_ += padding + needed;
+
+  // Wake the drain thread when the ring gets half full, rather than
+  // for every record.
+  size_t const half = ring->size_ / 2;
+  if (used < half && used + padding + needed >= half)
+    this->wakeup_.signal ();
+
+  return static_cast<ssize_t> (length);
+#else
+  // Without threads the records are written right away.
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->drain_lock_, -1);
+  this->write (log_record, quiet);
+  return static_cast<ssize_t> (log_record.msg_data_len () - 1);
+#endif /* ACE_HAS_THREADS */
+}
+
+#if defined (ACE_HAS_THREADS)
+
+// Returns the ring of the calling thread, creating it on the first
+// call.
+
+ACE_Log_Msg_Async_Ring *
+ACE_Log_Msg_Async::ring (void)
+{
+  if (!this->key_created_)
+    return 0;
+
+  void *ptr = 0;
+  if (ACE_Thread::getspecific (this->key_, &ptr) == -1)
+    return 0;
+
+  if (ptr != 0)
+    return static_cast<Ring *> (ptr);
+
+  Ring *ring = 0;
+  ACE_NEW_RETURN (ring, Ring (this->buffer_size_), 0);
+  if (ring->buffer_ == 0)
+    {
+      delete ring;
+      return 0;
+    }
+
+  {
+    ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->rings_lock_, 0);
+    ring->next_ = this->rings_;
+    this->rings_ = ring;
+  }
+
+  if (ACE_Thread::setspecific (this->key_, ring) == -1)
+    {
+      // Leave it to the drain thread to release it.
+      ++ring->orphaned_;
+      return 0;
+    }
+
+  return ring;
+}
+
+ACE_THR_FUNC_RETURN
+ACE_Log_Msg_Async::drain_thread (void *arg)
+{
+  ACE_Log_Msg_Async *self = static_cast<ACE_Log_Msg_Async *> (arg);
+
+  for (;;)
+    {
+      ACE_Time_Value const interval (0,
+                                     ACE_DEFAULT_LOG_MSG_ASYNC_INTERVAL * 1000);
+      self->wakeup_.wait (&interval, 0);
+
+      ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, self->drain_lock_, 0);
+      self->drain ();
+      if (!self->running_)
+        break;
+    }
+
+  return 0;
+}
+
+#endif /* ACE_HAS_THREADS */
+
+// Write the records of all rings to the destinations and release the
+// rings of the threads that exited.  The caller holds <drain_lock_>.
+
+void
+ACE_Log_Msg_Async::drain (void)
+{
+#if defined (ACE_HAS_THREADS)
+  Ring *ring = 0;
+  {
+    ACE_GUARD (ACE_SYNCH_MUTEX, ace_mon, this->rings_lock_);
+    ring = this->rings_;
+  }
+
+  // Threads only ever add rings in front of the one read above, so
+  // the rest of the list can be walked without the lock.
+  Ring *prev = 0;
+  while (ring != 0)
+    {
+      // Once the thread has exited, its last record is in the ring.
+      bool const orphaned = Ring::load (ring->orphaned_) != 0;
+      unsigned long const head = Ring::load (ring->head_);
+      unsigned long tail = ring->tail_.value ();
+
+      while (tail != head)
+        {
+          ACE_Log_Msg_Async_Entry const *entry = ring->entry (tail);
+          ACE_UINT32 const size = entry->size_;
+
+          if (entry->type_ != 0)
+            {
+              this->record_->type (entry->type_);
+              this->record_->pid (static_cast<long> (entry->pid_));
+              this->record_->time_stamp (
+                ACE_Time_Value (static_cast<time_t> (entry->secs_),
+                                static_cast<suseconds_t> (entry->usecs_)));
+              this->record_->msg_data (
+                reinterpret_cast<const ACE_TCHAR *> (entry + 1));
+              this->write (*this->record_, entry->quiet_ != 0);
+            }
+
+          tail += size;
+          ring->tail_ += size;
+        }
+
+      unsigned long const dropped = ring->dropped_.value ();
+      if (dropped != ring->reported_)
+        {
+          ACE_TCHAR msg[64];
+          ACE_OS::snprintf (msg,
+                            sizeof msg / sizeof (ACE_TCHAR),
+                            ACE_TEXT ("ACE_Log_Msg_Async: %lu log records ")
+                            ACE_TEXT ("dropped\n"),
+                            dropped - ring->reported_);
+          ring->reported_ = dropped;
+
+          this->record_->type (LM_WARNING);
+          this->record_->pid (static_cast<long> (ACE_OS::getpid ()));
+          this->record_->time_stamp (ACE_OS::gettimeofday ());
+          this->record_->msg_data (msg);
+          this->write (*this->record_, false);
+        }
+
+      Ring *next = ring->next_;
+      if (orphaned)
+        {
+          {
+            ACE_GUARD (ACE_SYNCH_MUTEX, ace_mon, this->rings_lock_);
+            if (prev == 0)
+              this->rings_ = next;
+            else
+              prev->next_ = next;
+          }
+          this->released_dropped_ += dropped;
+          delete ring;
+        }
+      else
+        prev = ring;
+
+      ring = next;
+    }
+#endif /* ACE_HAS_THREADS */
+
+  if (this->ostream_ != 0)
+    {
+#if defined (ACE_LACKS_IOSTREAM_TOTALLY)
+      ACE_OS::fflush (this->ostream_);
+#else
+      this->ostream_->flush ();
+#endif /* ACE_LACKS_IOSTREAM_TOTALLY */
+    }
+}
+
+// Write @a log_record to the destinations; it is not printed if
+// @a quiet.  The stream is flushed by drain().
+
+void
+ACE_Log_Msg_Async::write (ACE_Log_Record &log_record, bool quiet)
+{
+  if (this->ostream_ != 0 && !quiet)
+    {
+      ACE_Log_Msg *log_msg = ACE_LOG_MSG;
+      if (log_record.format_msg (log_msg->local_host (),
+                             log_msg->flags (),
+                             this->verbose_msg_,
+                             ACE_Log_Record::MAXVERBOSELOGMSGLEN) == 0)
+        {
+#if defined (ACE_LACKS_IOSTREAM_TOTALLY)
+# if !defined (ACE_WIN32) && defined (ACE_USES_WCHAR)
+          ACE_OS::fprintf (this->ostream_, ACE_TEXT ("%ls"), this->verbose_msg_);
+# else
+          ACE_OS::fprintf (this->ostream_, ACE_TEXT ("%s"), this->verbose_msg_);
+# endif /* !ACE_WIN32 && ACE_USES_WCHAR */
+#else
+          // Since ostream expects only chars, we cannot pass wchar_t's
+          *this->ostream_ << ACE_TEXT_ALWAYS_CHAR (this->verbose_msg_);
+#endif /* ACE_LACKS_IOSTREAM_TOTALLY */
+        }
+    }
+
+  if (this->backend_ != 0)
+    this->backend_->log (log_record);
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
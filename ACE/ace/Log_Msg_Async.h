@@ -0,0 +1,188 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    Log_Msg_Async.h
+ *
+ *  Asynchronous ACE_Log_Msg backend.
+ */
+//=============================================================================
+
+#ifndef ACE_LOG_MSG_ASYNC_H
+#define ACE_LOG_MSG_ASYNC_H
+#include /**/ "ace/pre.h"
+
+#include "ace/Log_Msg_Backend.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "ace/iosfwd.h"
+#include "ace/Atomic_Op.h"
+#include "ace/Auto_Event.h"
+#include "ace/Synch_Traits.h"
+#include "ace/Thread_Mutex.h"
+#include "ace/OS_NS_Thread.h"
+
+#if !defined (ACE_DEFAULT_LOG_MSG_ASYNC_BUFFER_SIZE)
+#define ACE_DEFAULT_LOG_MSG_ASYNC_BUFFER_SIZE 65536 /* Bytes */
+#endif /* ACE_DEFAULT_LOG_MSG_ASYNC_BUFFER_SIZE */
+
+#if !defined (ACE_DEFAULT_LOG_MSG_ASYNC_INTERVAL)
+#define ACE_DEFAULT_LOG_MSG_ASYNC_INTERVAL 50 /* Milliseconds */
+#endif /* ACE_DEFAULT_LOG_MSG_ASYNC_INTERVAL */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+class ACE_Log_Record;
+class ACE_Log_Msg_Async_Ring;
+
+/**
+ * @class ACE_Log_Msg_Async
+ *
+ * @brief ACE_Log_Msg backend that takes log records off the logging
+ * threads and writes them from a thread of its own.
+ *
+ * Every thread that logs gets a ring buffer of its own the first time
+ * it does, and log() only copies the record into it; there is no lock
+ * and no system call on that path.  A drain thread empties the rings
+ * every ACE_DEFAULT_LOG_MSG_ASYNC_INTERVAL milliseconds, or as soon as
+ * a ring is half full, and writes the records to the destinations
+ * selected with destinations(): an output stream, syslog (the event
+ * log on Windows) or a remote logging daemon.  The VERBOSE and
+ * VERBOSE_LITE prefixes are formatted by the drain thread too.
+ *
+ * Memory is bounded by the buffer size times the number of threads
+ * that log.  When a ring is full the record is dropped and counted;
+ * the drain thread writes how many records a thread lost once there is
+ * room again, and dropped() returns the total.  The ring of a thread
+ * that exits is released once it has been drained.
+ *
+ * The backend is installed with ACE_Log_Msg::msg_backend() and the
+ * ACE_Log_Msg::CUSTOM flag, or by ACE_Logging_Strategy when given the
+ * ASYNC flag.  As concurrent() returns true, ACE_Log_Msg does not take
+ * its lock for records that only go to this backend.  close() must be
+ * called before the backend is destroyed, and no thread may log
+ * through the backend while it is destroyed.
+ */
+class ACE_Export ACE_Log_Msg_Async : public ACE_Log_Msg_Backend
+{
+public:
+  /// Constructor; @a buffer_size is the size of the ring of each
+  /// thread, in bytes.
+  ACE_Log_Msg_Async (size_t buffer_size = ACE_DEFAULT_LOG_MSG_ASYNC_BUFFER_SIZE);
+
+  /// Destructor
+  virtual ~ACE_Log_Msg_Async (void);
+
+  /**
+   * Select where the records go: any combination of
+   * ACE_Log_Msg::OSTREAM, ACE_Log_Msg::SYSLOG and ACE_Log_Msg::LOGGER.
+   * SYSLOG takes precedence over LOGGER, as in ACE_Log_Msg.  The
+   * stream is not owned by the backend; if it is 0,
+   * ACE_DEFAULT_LOG_STREAM is used.  Takes effect at the next open().
+   */
+  void destinations (u_long flags, ACE_OSTREAM_TYPE *ostream = 0);
+
+  /// Replace the output stream, e.g., after the log file was rotated.
+  /// Once the drain thread runs, the caller must hold the backend with
+  /// acquire().
+  void msg_ostream (ACE_OSTREAM_TYPE *ostream);
+
+  /// Number of records dropped so far because a ring was full.
+  unsigned long dropped (void);
+
+  /// Keep the drain thread from writing records, e.g., while the
+  /// output stream is replaced.
+  int acquire (void);
+
+  /// Let the drain thread write records again.
+  int release (void);
+
+  /// Open the SYSLOG or LOGGER destination with @a logger_key and
+  /// start the drain thread.
+  virtual int open (const ACE_TCHAR *logger_key);
+
+  /// Write the pending records and close the SYSLOG or LOGGER
+  /// destination.  The drain thread keeps running.
+  virtual int reset (void);
+
+  /// Stop the drain thread, then write the pending records and close
+  /// the destinations.
+  virtual int close (void);
+
+  /// Copy @a log_record into the ring of the calling thread.  Returns
+  /// -1 if it was dropped.
+  virtual ssize_t log (ACE_Log_Record &log_record);
+
+  /// Returns true; log() may be called by several threads at once.
+  virtual bool concurrent (void) const;
+
+  ACE_ALLOC_HOOK_DECLARE;
+
+private:
+  typedef ACE_Log_Msg_Async_Ring Ring;
+
+  // The following are documented in the .cpp file.
+  Ring *ring (void);
+  void drain (void);
+  void write (ACE_Log_Record &log_record, bool quiet);
+  static ACE_THR_FUNC_RETURN drain_thread (void *arg);
+
+  /// Size of the ring of each thread.
+  size_t buffer_size_;
+
+  /// Destinations selected by destinations().
+  u_long flags_;
+
+  /// Stream the records are printed to, 0 if none.
+  ACE_OSTREAM_TYPE *ostream_;
+
+  /// Backend that writes to syslog or to the logging daemon, 0 if
+  /// neither was selected.
+  ACE_Log_Msg_Backend *backend_;
+
+  /// Serializes the writers of the records: the drain thread,
+  /// reset(), close() and whoever called acquire().
+  ACE_SYNCH_MUTEX drain_lock_;
+
+  /// Record used to hand the ring entries to the destinations, and
+  /// buffer in which they are formatted.
+  ACE_Log_Record *record_;
+  ACE_TCHAR *verbose_msg_;
+
+  /// Records dropped by the rings that were released.
+  unsigned long released_dropped_;
+
+#if defined (ACE_HAS_THREADS)
+  /// Key of the ring of each thread.
+  ACE_thread_key_t key_;
+  bool key_created_;
+
+  /// Rings of all threads that logged, newest first.
+  Ring *rings_;
+
+  /// Protects <rings_> against threads adding their ring.
+  ACE_SYNCH_MUTEX rings_lock_;
+
+  /// Signaled when a ring fills up, and by close().
+  ACE_Auto_Event wakeup_;
+
+  /// True while the drain thread runs; protected by <drain_lock_>.
+  bool running_;
+
+  /// The drain thread.
+  ACE_thread_t thr_id_;
+  ACE_hthread_t thr_handle_;
+#endif /* ACE_HAS_THREADS */
+
+  // = Disallow these operations.
+  ACE_UNIMPLEMENTED_FUNC (ACE_Log_Msg_Async (const ACE_Log_Msg_Async &))
+  ACE_UNIMPLEMENTED_FUNC (void operator= (const ACE_Log_Msg_Async &))
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#include /**/ "ace/post.h"
+#endif /* ACE_LOG_MSG_ASYNC_H */
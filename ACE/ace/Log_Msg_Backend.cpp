@@ -1,4 +1,5 @@
 #include "ace/Log_Msg_Backend.h"
+#include "ace/OS_NS_errno.h"
 
 
 
@@ -9,4 +10,19 @@ ACE_Log_Msg_Backend::~ACE_Log_Msg_Backend (void)
 {
 }
 
+bool
+ACE_Log_Msg_Backend::concurrent (void) const
+{
+  return false;
+}
+
+ssize_t
+ACE_Log_Msg_Backend::log_unformatted (ACE_Log_Msg &,
+                                      ACE_Log_Priority,
+                                      const ACE_TCHAR *,
+                                      va_list)
+{
+  ACE_NOTSUP_RETURN (-1);
+}
+
 ACE_END_VERSIONED_NAMESPACE_DECL
@@ -20,9 +20,12 @@
 #endif /* ACE_LACKS_PRAGMA_ONCE */
 
 #include "ace/os_include/sys/os_types.h"
+#include "ace/os_include/os_stdarg.h"
+#include "ace/Log_Priority.h"
 
 ACE_BEGIN_VERSIONED_NAMESPACE_DECL
 
+class ACE_Log_Msg;
 class ACE_Log_Record;
 
 /**
@@ -78,6 +81,34 @@ public:
    *         processed, but can also be 0 to signify success.
    */
   virtual ssize_t log (ACE_Log_Record &log_record) = 0;
+
+  /**
+   * Tell whether log() may be called by several threads at once.  If
+   * so, ACE_Log_Msg calls it without holding its process-wide lock.
+   * The default implementation returns false.
+   */
+  virtual bool concurrent (void) const;
+
+  /**
+   * Process a message before ACE_Log_Msg formats it.  This is only
+   * called when the back end is the sole destination of the message
+   * and is concurrent(), by the thread that logs it and without the
+   * process-wide lock.
+   *
+   * @param log_msg   The ACE_Log_Msg of the calling thread; it holds
+   *                  the values of the %N, %l, %p and %m directives.
+   * @param priority  The priority of the message.
+   * @param format    The format string passed to ACE_Log_Msg::log().
+   * @param argp      The arguments of @a format.
+   *
+   * @retval -1 with errno set to ENOTSUP to have ACE_Log_Msg format the
+   *         message and pass it to log() instead, which is what the
+   *         default implementation does.  Otherwise as for log().
+   */
+  virtual ssize_t log_unformatted (ACE_Log_Msg &log_msg,
+                                   ACE_Log_Priority priority,
+                                   const ACE_TCHAR *format,
+                                   va_list argp);
 };
 
 ACE_END_VERSIONED_NAMESPACE_DECL
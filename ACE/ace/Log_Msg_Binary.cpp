@@ -0,0 +1,959 @@
+#include "ace/Log_Msg_Binary.h"
+#include "ace/Log_Msg.h"
+#include "ace/ACE.h"
+#include "ace/Guard_T.h"
+#include "ace/OS_NS_errno.h"
+#include "ace/OS_NS_fcntl.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_sys_time.h"
+#include "ace/OS_NS_Thread.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/Truncate.h"
+
+#if defined (ACE_HAS_TRACE)
+# include "ace/Trace.h"
+#endif /* ACE_HAS_TRACE */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace
+{
+  /// Written in the HEADER record to recognize the files.
+  const char ace_log_msg_binary_magic[] = "ACE_Log_Msg_Binary";
+
+  /// Size of the stack buffer in which a record is encoded; longer
+  /// records make the CDR stream allocate.
+  const size_t ace_log_msg_binary_buffer_size = 512;
+
+  /// Start a record: the byte order, a placeholder for the length of
+  /// the rest of the record, which is returned, and @a type.
+  char *
+  ace_log_msg_binary_start (ACE_OutputCDR &cdr, ACE_CDR::ULong type)
+  {
+    cdr << ACE_OutputCDR::from_boolean (ACE_CDR_BYTE_ORDER);
+    char *const length_pos = cdr.write_long_placeholder ();
+    cdr << type;
+    return length_pos;
+  }
+
+  /// Id of the calling thread, as ACE_Log_Msg prints it for %t.
+  ACE_UINT64
+  ace_log_msg_binary_thread_id (void)
+  {
+#if defined (ACE_WIN32)
+    return static_cast<unsigned> (ACE_OS::thr_self ());
+#elif defined (ACE_HAS_OPAQUE_PTHREAD_T)
+    return 0;
+#else
+    ACE_hthread_t t_id;
+    ACE_OS::thr_self (t_id);
+    return (unsigned long) t_id;
+#endif /* ACE_WIN32 */
+  }
+}
+
+// ************************************************************
+
+ACE_ALLOC_HOOK_DEFINE(ACE_Log_Msg_Binary)
+
+ACE_Log_Msg_Binary::ACE_Log_Msg_Binary (const ACE_TCHAR *file_name,
+                                        size_t buffer_size)
+  : file_name_ (ACE::strnew (file_name)),
+    handle_ (ACE_INVALID_HANDLE),
+    buffer_ (0),
+    buffer_size_ (buffer_size),
+    buffered_ (0),
+    last_id_ (0)
+{
+  ACE_NEW (this->buffer_, char[buffer_size]);
+}
+
+ACE_Log_Msg_Binary::~ACE_Log_Msg_Binary (void)
+{
+  this->close ();
+  delete [] this->buffer_;
+  delete [] this->file_name_;
+}
+
+int
+ACE_Log_Msg_Binary::open (const ACE_TCHAR *)
+{
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->lock_, -1);
+  return this->handle_ == ACE_INVALID_HANDLE ? this->open_i () : 0;
+}
+
+// Open the file and write the HEADER record.  The caller holds the
+// lock.
+
+int
+ACE_Log_Msg_Binary::open_i (void)
+{
+  if (this->file_name_ == 0 || this->buffer_ == 0)
+    return -1;
+
+  this->handle_ = ACE_OS::open (this->file_name_,
+                                O_WRONLY | O_CREAT | O_APPEND,
+                                ACE_DEFAULT_FILE_PERMS);
+  if (this->handle_ == ACE_INVALID_HANDLE)
+    return -1;
+
+  char host_name[MAXHOSTNAMELEN + 1];
+  if (ACE_OS::hostname (host_name, sizeof host_name) == -1)
+    ACE_OS::strcpy (host_name, "<unknown>");
+
+  const ACE_TCHAR *program_name = ACE_Log_Msg::program_name ();
+
+  ACE_OutputCDR cdr (ace_log_msg_binary_buffer_size);
+  char *const length_pos = ace_log_msg_binary_start (cdr, HEADER);
+  cdr.write_string (ace_log_msg_binary_magic);
+  cdr << VERSION;
+  cdr.write_string (program_name == 0
+                    ? "<unknown>"
+                    : ACE_TEXT_ALWAYS_CHAR (program_name));
+  cdr.write_string (host_name);
+
+  return this->write (cdr, length_pos, true) == -1 ? -1 : 0;
+}
+
+int
+ACE_Log_Msg_Binary::reset (void)
+{
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->lock_, -1);
+  return this->flush_i ();
+}
+
+int
+ACE_Log_Msg_Binary::close (void)
+{
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->lock_, -1);
+
+  // The ids start again after the HEADER record of the next open().
+  for (FORMAT_MAP::iterator i = this->formats_.begin ();
+       i != this->formats_.end ();
+       ++i)
+    delete [] (*i).int_id_.text_;
+  this->formats_.unbind_all ();
+  this->last_id_ = 0;
+
+  int result = this->flush_i ();
+  if (this->handle_ != ACE_INVALID_HANDLE)
+    {
+      if (ACE_OS::close (this->handle_) == -1)
+        result = -1;
+      this->handle_ = ACE_INVALID_HANDLE;
+    }
+  return result;
+}
+
+bool
+ACE_Log_Msg_Binary::concurrent (void) const
+{
+  return true;
+}
+
+ssize_t
+ACE_Log_Msg_Binary::log (ACE_Log_Record &log_record)
+{
+  char buffer[ace_log_msg_binary_buffer_size + ACE_Log_Record::MAXLOGMSGLEN];
+  ACE_OutputCDR cdr (buffer, sizeof buffer);
+  char *const length_pos = ace_log_msg_binary_start (cdr, RECORD);
+  if (!(cdr << log_record))
+    return -1;
+
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->lock_, -1);
+  return this->write (cdr,
+                      length_pos,
+                      log_record.type () >= LM_ERROR);
+}
+
+ssize_t
+ACE_Log_Msg_Binary::log_unformatted (ACE_Log_Msg &log_msg,
+                                     ACE_Log_Priority priority,
+                                     const ACE_TCHAR *format,
+                                     va_list argp)
+{
+  ACE_UINT64 now = 0;
+  ACE_OS::gettimeofday ().to_usec (now);
+
+  char buffer[ace_log_msg_binary_buffer_size];
+  ACE_OutputCDR cdr (buffer, sizeof buffer);
+  char *const length_pos = ace_log_msg_binary_start (cdr, MESSAGE);
+  char *const format_pos = cdr.write_long_placeholder ();
+  cdr << ACE_CDR::ULong (priority);
+  cdr << ACE_CDR::Long (log_msg.getpid ());
+  cdr << ACE_CDR::ULongLong (now);
+  cdr << ACE_CDR::ULongLong (ace_log_msg_binary_thread_id ());
+
+  // Store the arguments the way ACE_Log_Msg::log() takes them off
+  // <argp>, along with the values it would take from <log_msg>.
+  for (const ACE_TCHAR *f = format; *f != 0; ++f)
+    {
+      if (*f != '%')
+        continue;
+
+      if (f[1] == '%')
+        {
+          ++f;
+          continue;
+        }
+
+      bool const time_arg = f[1] == '#';
+      int wp = 0;
+      bool flags = true;
+
+      while (flags)
+        switch (*++f)
+          {
+          case '-': case '+': case '0': case ' ': case '#':
+          case '1': case '2': case '3': case '4': case '5':
+          case '6': case '7': case '8': case '9':
+          case '.': case 'h': case 'L':
+            break;
+          case '*':
+            wp = va_arg (argp, int);
+            cdr << ACE_CDR::Long (wp);
+            break;
+          default:
+            flags = false;
+            break;
+          }
+
+      switch (*f)
+        {
+        case '\0':
+          --f;
+          break;
+
+        case 'a': case 'r': case 'R': case '{': case '}':
+        case '?': case 'W': case 'Z':
+          ACE_NOTSUP_RETURN (-1);
+
+        case 'd': case 'i': case 'o': case 'u': case 'x': case 'X':
+        case 'c': case 'w': case 'z': case 'S':
+          cdr << ACE_CDR::Long (va_arg (argp, int));
+          break;
+
+        case 'A': case 'F': case 'f': case 'e': case 'E':
+        case 'g': case 'G':
+          cdr << ACE_CDR::Double (va_arg (argp, double));
+          break;
+
+        case 'Q':
+          cdr << ACE_CDR::ULongLong (va_arg (argp, ACE_UINT64));
+          break;
+        case 'q':
+          cdr << ACE_CDR::LongLong (va_arg (argp, ACE_INT64));
+          break;
+        case 'b':
+          cdr << ACE_CDR::LongLong (va_arg (argp, ssize_t));
+          break;
+        case 'B':
+          cdr << ACE_CDR::ULongLong (va_arg (argp, size_t));
+          break;
+        case ':':
+          cdr << ACE_CDR::LongLong (va_arg (argp, time_t));
+          break;
+        case '@':
+          cdr << ACE_CDR::ULongLong (reinterpret_cast<size_t> (va_arg (argp, void *)));
+          break;
+
+        case 's':
+        case 'p':
+          {
+            const ACE_TCHAR *str = va_arg (argp, ACE_TCHAR *);
+            cdr.write_string (str == 0 ? "(null)" : ACE_TEXT_ALWAYS_CHAR (str));
+            if (*f == 'p')
+              cdr << ACE_CDR::Long (ACE::map_errno (log_msg.errnum ()));
+            break;
+          }
+        case 'm':
+          cdr << ACE_CDR::Long (ACE::map_errno (log_msg.errnum ()));
+          break;
+        case 'C':
+          {
+            const char *str = va_arg (argp, char *);
+            cdr.write_string (str == 0 ? "(null)" : str);
+            break;
+          }
+
+        case 'N':
+          cdr.write_string (log_msg.file () == 0
+                            ? "<unknown file>"
+                            : log_msg.file ());
+          break;
+        case 'l':
+          cdr << ACE_CDR::Long (log_msg.linenum ());
+          break;
+
+        case 'I':
+        case '$':
+          if (wp == 0)
+#if defined (ACE_HAS_TRACE)
+            wp = ACE_Trace::get_nesting_indent ();
+#else
+            wp = 4;
+#endif /* ACE_HAS_TRACE */
+          cdr << ACE_CDR::Long (wp * log_msg.trace_depth ());
+          break;
+
+        case 'D':
+        case 'T':
+          if (time_arg)
+            {
+              const ACE_Time_Value *tv = va_arg (argp, ACE_Time_Value *);
+              cdr << ACE_CDR::LongLong (tv->sec ());
+              cdr << ACE_CDR::Long (tv->usec ());
+            }
+          break;
+
+        default:
+          // %n, %P, %t and %M come from the record itself; anything
+          // else is not a directive and is printed as is.
+          break;
+        }
+    }
+
+  if (!cdr.good_bit ())
+    return -1;
+
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->lock_, -1);
+
+  ACE_CDR::ULong const id = this->format_id (format);
+  if (id == 0)
+    return -1;
+  cdr.replace (static_cast<ACE_CDR::Long> (id), format_pos);
+
+  return this->write (cdr, length_pos, priority >= LM_ERROR);
+}
+
+// Return the id of <format>, writing a FORMAT record for it the first
+// time it is used.  Returns 0 on failure.  The caller holds the lock.
+
+ACE_CDR::ULong
+ACE_Log_Msg_Binary::format_id (const ACE_TCHAR *format)
+{
+  if (this->handle_ == ACE_INVALID_HANDLE && this->open_i () == -1)
+    return 0;
+
+  Format entry;
+  if (this->formats_.find (format, entry) == 0)
+    {
+      if (ACE_OS::strcmp (entry.text_, ACE_TEXT_ALWAYS_CHAR (format)) == 0)
+        return entry.id_;
+
+      // The address held another format, e.g., a buffer that was
+      // reused; the new one gets an id of its own.
+      delete [] entry.text_;
+      this->formats_.unbind (format);
+    }
+
+  entry.id_ = this->last_id_ + 1;
+  entry.text_ = ACE::strnew (ACE_TEXT_ALWAYS_CHAR (format));
+  if (entry.text_ == 0 || this->formats_.bind (format, entry) != 0)
+    {
+      delete [] entry.text_;
+      return 0;
+    }
+  this->last_id_ = entry.id_;
+
+  char buffer[ace_log_msg_binary_buffer_size];
+  ACE_OutputCDR cdr (buffer, sizeof buffer);
+  char *const length_pos = ace_log_msg_binary_start (cdr, FORMAT);
+  cdr << entry.id_;
+  cdr.write_string (entry.text_);
+
+  return this->write (cdr, length_pos, false) == -1 ? 0 : entry.id_;
+}
+
+// Fill in the length of the record in <cdr> and append it to the
+// file.  The caller holds the lock.
+
+ssize_t
+ACE_Log_Msg_Binary::write (ACE_OutputCDR &cdr, char *length_pos, bool flush)
+{
+  if (this->handle_ == ACE_INVALID_HANDLE && this->open_i () == -1)
+    return -1;
+
+  size_t const length = cdr.total_length ();
+  if (!cdr.good_bit ()
+      || !cdr.replace (ACE_Utils::truncate_cast<ACE_CDR::Long> (length - 8),
+                       length_pos))
+    return -1;
+
+  for (const ACE_Message_Block *i = cdr.begin (); i != 0; i = i->cont ())
+    {
+      if (this->buffered_ + i->length () > this->buffer_size_
+          && this->flush_i () == -1)
+        return -1;
+
+      if (i->length () > this->buffer_size_)
+        {
+          if (ACE::write_n (this->handle_, i->rd_ptr (), i->length ())
+              != static_cast<ssize_t> (i->length ()))
+            return -1;
+        }
+      else
+        {
+          ACE_OS::memcpy (this->buffer_ + this->buffered_,
+                          i->rd_ptr (),
+                          i->length ());
+          this->buffered_ += i->length ();
+        }
+    }
+
+  if (flush && this->flush_i () == -1)
+    return -1;
+
+  return static_cast<ssize_t> (length);
+}
+
+// Write the buffered records to the file.  The caller holds the lock.
+
+int
+ACE_Log_Msg_Binary::flush_i (void)
+{
+  if (this->buffered_ == 0)
+    return 0;
+
+  size_t const n = this->buffered_;
+  this->buffered_ = 0;
+  return ACE::write_n (this->handle_, this->buffer_, n)
+    == static_cast<ssize_t> (n) ? 0 : -1;
+}
+
+// ************************************************************
+
+namespace
+{
+  /// Appends to the buffer a message is rendered in, truncating the
+  /// message as ACE_Log_Msg does.
+  class ACE_Log_Msg_Binary_Writer
+  {
+  public:
+    ACE_Log_Msg_Binary_Writer (char *buffer, size_t size)
+      : bp_ (buffer), space_ (size - 1)
+    {
+      *this->bp_ = '\0';
+    }
+
+    void put (char c)
+    {
+      if (this->space_ > 0)
+        {
+          *this->bp_++ = c;
+          *this->bp_ = '\0';
+          --this->space_;
+        }
+    }
+
+    template <typename T>
+    void print (const char *format, T value)
+    {
+      int const len =
+        ACE_OS::snprintf (this->bp_, this->space_ + 1, format, value);
+      if (len > 0)
+        {
+          size_t const n = ACE_MIN (static_cast<size_t> (len), this->space_);
+          this->bp_ += n;
+          this->space_ -= n;
+        }
+    }
+
+    bool full (void) const
+    {
+      return this->space_ == 0;
+    }
+
+  private:
+    char *bp_;
+    size_t space_;
+  };
+
+  /// Character ACE_Log_Msg prints for %.1M.
+  char
+  ace_log_msg_binary_priority_char (ACE_CDR::ULong priority)
+  {
+    switch (priority)
+      {
+      case LM_SHUTDOWN: return 'S';
+      case LM_TRACE: return 'T';
+      case LM_DEBUG: return 'D';
+      case LM_INFO: return 'I';
+      case LM_NOTICE: return 'N';
+      case LM_WARNING: return 'W';
+      case LM_STARTUP: return 'U';
+      case LM_ERROR: return 'E';
+      case LM_CRITICAL: return 'C';
+      case LM_ALERT: return 'A';
+      case LM_EMERGENCY: return '!';
+      default: return '?';
+      }
+  }
+}
+
+ACE_Log_Msg_Binary_Reader::ACE_Log_Msg_Binary_Reader (void)
+  : file_ (0),
+    byte_order_ (ACE_CDR_BYTE_ORDER)
+{
+  this->msg_[0] = '\0';
+}
+
+ACE_Log_Msg_Binary_Reader::~ACE_Log_Msg_Binary_Reader (void)
+{
+  this->close ();
+}
+
+int
+ACE_Log_Msg_Binary_Reader::open (const ACE_TCHAR *file_name)
+{
+  this->close ();
+
+  this->file_ = ACE_OS::fopen (file_name, ACE_TEXT ("rb"));
+  if (this->file_ == 0)
+    return -1;
+
+  // The file must start with a HEADER record.
+  if (this->read_frame () != 1)
+    {
+      this->close ();
+      return -1;
+    }
+
+  ACE_InputCDR cdr (this->buffer_.rd_ptr (),
+                    this->buffer_.length (),
+                    this->byte_order_);
+  ACE_CDR::ULong type = 0;
+  if (!(cdr >> type)
+      || type != ACE_Log_Msg_Binary::HEADER
+      || this->read_header (cdr) == -1)
+    {
+      this->close ();
+      errno = EINVAL;
+      return -1;
+    }
+
+  return 0;
+}
+
+int
+ACE_Log_Msg_Binary_Reader::close (void)
+{
+  int result = 0;
+  if (this->file_ != 0)
+    {
+      result = ACE_OS::fclose (this->file_);
+      this->file_ = 0;
+    }
+  this->formats_.clear ();
+  return result;
+}
+
+const ACE_TCHAR *
+ACE_Log_Msg_Binary_Reader::program_name (void) const
+{
+  return this->program_name_.c_str ();
+}
+
+const ACE_TCHAR *
+ACE_Log_Msg_Binary_Reader::host_name (void) const
+{
+  return this->host_name_.c_str ();
+}
+
+int
+ACE_Log_Msg_Binary_Reader::read (ACE_Log_Record &log_record)
+{
+  for (;;)
+    {
+      int const result = this->read_frame ();
+      if (result != 1)
+        return result;
+
+      ACE_InputCDR cdr (this->buffer_.rd_ptr (),
+                        this->buffer_.length (),
+                        this->byte_order_);
+      ACE_CDR::ULong type = 0;
+      if (!(cdr >> type))
+        return -1;
+
+      switch (type)
+        {
+        case ACE_Log_Msg_Binary::HEADER:
+          if (this->read_header (cdr) == -1)
+            return -1;
+          break;
+        case ACE_Log_Msg_Binary::FORMAT:
+          if (this->read_format (cdr) == -1)
+            return -1;
+          break;
+        case ACE_Log_Msg_Binary::MESSAGE:
+          return this->read_message (cdr, log_record) == -1 ? -1 : 1;
+        case ACE_Log_Msg_Binary::RECORD:
+          return (cdr >> log_record) ? 1 : -1;
+        default:
+          // Written by a newer version; skip it.
+          break;
+        }
+    }
+}
+
+// Read the next record into <buffer_>, leaving out the byte order and
+// the length, which are stored first.  Returns 1 on success, 0 at the
+// end of the file and -1 if the record is truncated.
+
+int
+ACE_Log_Msg_Binary_Reader::read_frame (void)
+{
+  if (this->file_ == 0)
+    return -1;
+
+  // The byte order, padding and the length take 8 bytes.
+  this->buffer_.reset ();
+  if (ACE_CDR::grow (&this->buffer_, 8) == -1)
+    return -1;
+
+  size_t const n = ACE_OS::fread (this->buffer_.wr_ptr (), 1, 8, this->file_);
+  if (n == 0)
+    return 0;
+  if (n != 8)
+    return -1;
+
+  ACE_InputCDR header (this->buffer_.rd_ptr (), 8);
+  ACE_CDR::Boolean byte_order = 0;
+  if (!(header >> ACE_InputCDR::to_boolean (byte_order)))
+    return -1;
+  header.reset_byte_order (byte_order);
+  ACE_CDR::ULong length = 0;
+  if (!(header >> length))
+    return -1;
+
+  // The rest of the record is decoded with the alignment it was
+  // written with, which is relative to the start of the record.
+  this->buffer_.reset ();
+  if (ACE_CDR::grow (&this->buffer_, length + 8) == -1)
+    return -1;
+  this->buffer_.wr_ptr (8);
+  if (length != 0
+      && ACE_OS::fread (this->buffer_.wr_ptr (), 1, length, this->file_)
+         != length)
+    return -1;
+  this->buffer_.wr_ptr (length);
+  this->buffer_.rd_ptr (8);
+  this->byte_order_ = byte_order;
+  return 1;
+}
+
+// Read the body of a HEADER record; the format ids start again.
+
+int
+ACE_Log_Msg_Binary_Reader::read_header (ACE_InputCDR &cdr)
+{
+  ACE_CString magic;
+  ACE_CString program_name;
+  ACE_CString host_name;
+  ACE_CDR::ULong version = 0;
+
+  if (!(cdr >> magic)
+      || magic != ace_log_msg_binary_magic
+      || !(cdr >> version)
+      || version != ACE_Log_Msg_Binary::VERSION
+      || !(cdr >> program_name)
+      || !(cdr >> host_name))
+    return -1;
+
+  this->program_name_ = ACE_TEXT_CHAR_TO_TCHAR (program_name.c_str ());
+  this->host_name_ = ACE_TEXT_CHAR_TO_TCHAR (host_name.c_str ());
+  this->formats_.clear ();
+  return 0;
+}
+
+// Read the body of a FORMAT record.
+
+int
+ACE_Log_Msg_Binary_Reader::read_format (ACE_InputCDR &cdr)
+{
+  ACE_CDR::ULong id = 0;
+  ACE_CString format;
+  if (!(cdr >> id) || !(cdr >> format) || id == 0)
+    return -1;
+
+  if (id > this->formats_.size ())
+    this->formats_.resize (id, ACE_CString ());
+  this->formats_[id - 1] = format;
+  return 0;
+}
+
+// Read the body of a MESSAGE record and render the message into
+// <log_record>.
+
+int
+ACE_Log_Msg_Binary_Reader::read_message (ACE_InputCDR &cdr,
+                                         ACE_Log_Record &log_record)
+{
+  ACE_CDR::ULong id = 0;
+  ACE_CDR::ULong priority = 0;
+  ACE_CDR::Long pid = 0;
+  ACE_CDR::ULongLong usecs = 0;
+  ACE_CDR::ULongLong thread_id = 0;
+
+  if (!(cdr >> id) || !(cdr >> priority) || !(cdr >> pid)
+      || !(cdr >> usecs) || !(cdr >> thread_id)
+      || id == 0 || id > this->formats_.size ())
+    return -1;
+
+  ACE_Time_Value const time_stamp
+    (ACE_Utils::truncate_cast<time_t> (usecs / ACE_ONE_SECOND_IN_USECS),
+     static_cast<suseconds_t> (usecs % ACE_ONE_SECOND_IN_USECS));
+  log_record.type (static_cast<ACE_Log_Priority> (priority));
+  log_record.pid (pid);
+  log_record.time_stamp (time_stamp);
+
+  // The format strings and arguments are narrow; with wide characters
+  // the message is rendered in <buffer> and converted into <msg_>.
+#if defined (ACE_USES_WCHAR)
+  char buffer[ACE_Log_Record::MAXLOGMSGLEN + 1];
+#else
+  char *const buffer = this->msg_;
+#endif /* ACE_USES_WCHAR */
+  ACE_Log_Msg_Binary_Writer out (buffer, ACE_Log_Record::MAXLOGMSGLEN + 1);
+  const char *format_str = this->formats_[id - 1].c_str ();
+
+  // Follow ACE_Log_Msg::log(), taking the arguments from <cdr>.
+  while (*format_str != '\0' && !out.full ())
+    {
+      if (*format_str != '%')
+        {
+          out.put (*format_str++);
+          continue;
+        }
+
+      if (format_str[1] == '%')
+        {
+          out.put ('%');
+          format_str += 2;
+          continue;
+        }
+
+      const char *start_format = format_str;
+      char format[128];
+      char *fp = format;
+      *fp++ = *format_str++;
+
+      bool flags = true;
+      while (flags)
+        switch (*format_str)
+          {
+          case '-': case '+': case '0': case ' ': case '#':
+          case '1': case '2': case '3': case '4': case '5':
+          case '6': case '7': case '8': case '9':
+          case '.': case 'h':
+            if (fp < format + sizeof format - 8)
+              *fp++ = *format_str;
+            ++format_str;
+            break;
+          case 'L':
+            // ACE_Log_Msg turns it into 'l', but always takes an int.
+            ++format_str;
+            break;
+          case '*':
+            {
+              ACE_CDR::Long wp = 0;
+              if (!(cdr >> wp))
+                return -1;
+              char digits[16];
+              ACE_OS::snprintf (digits, sizeof digits, "%d", wp);
+              for (const char *d = digits;
+                   *d != '\0' && fp < format + sizeof format - 8;
+                   ++d)
+                *fp++ = *d;
+              ++format_str;
+              break;
+            }
+          default:
+            flags = false;
+            break;
+          }
+      *fp = '\0';
+
+      bool const time_arg = format[1] == '#';
+      ACE_CDR::Long l = 0;
+      ACE_CDR::LongLong ll = 0;
+      ACE_CDR::ULongLong ull = 0;
+      ACE_CDR::Double d = 0;
+      ACE_CString str;
+
+      switch (*format_str)
+        {
+        case '\0':
+          continue;
+
+        case 'd': case 'i': case 'o': case 'u': case 'x': case 'X':
+        case 'c':
+          if (!(cdr >> l))
+            return -1;
+          fp[0] = *format_str;
+          fp[1] = '\0';
+          out.print (format, static_cast<int> (l));
+          break;
+        case 'w':
+        case 'z':
+          if (!(cdr >> l))
+            return -1;
+          ACE_OS::strcpy (fp, "u");
+          out.print (format, static_cast<unsigned int> (l));
+          break;
+        case 'S':
+          if (!(cdr >> l))
+            return -1;
+          ACE_OS::strcpy (fp, "s");
+          out.print (format, ACE_OS::strsignal (l));
+          break;
+
+        case 'A': case 'F': case 'f': case 'e': case 'E':
+        case 'g': case 'G':
+          if (!(cdr >> d))
+            return -1;
+          fp[0] = *format_str == 'A' ? 'f' : *format_str;
+          fp[1] = '\0';
+          out.print (format, static_cast<double> (d));
+          break;
+
+        case 'Q':
+        case 'B':
+          if (!(cdr >> ull))
+            return -1;
+          ACE_OS::strcpy (fp, &ACE_UINT64_FORMAT_SPECIFIER_ASCII[1]);
+          out.print (format, static_cast<ACE_UINT64> (ull));
+          break;
+        case 'q':
+        case 'b':
+        case ':':
+          if (!(cdr >> ll))
+            return -1;
+          ACE_OS::strcpy (fp, &ACE_INT64_FORMAT_SPECIFIER_ASCII[1]);
+          out.print (format, static_cast<ACE_INT64> (ll));
+          break;
+        case '@':
+          if (!(cdr >> ull))
+            return -1;
+          ACE_OS::strcpy (fp, "p");
+          out.print (format,
+                     reinterpret_cast<void *> (static_cast<size_t> (ull)));
+          break;
+
+        case 's':
+        case 'C':
+        case 'N':
+          if (!(cdr >> str))
+            return -1;
+          ACE_OS::strcpy (fp, "s");
+          out.print (format, str.c_str ());
+          break;
+        case 'p':
+          if (!(cdr >> str))
+            return -1;
+          if (!(cdr >> l))
+            return -1;
+          // The width and precision apply to the string only.
+          ACE_OS::strcpy (fp, "s");
+          out.print (format, str.c_str ());
+          out.print (": %s", ACE_OS::strerror (l));
+          break;
+        case 'm':
+          if (!(cdr >> l))
+            return -1;
+          ACE_OS::strcpy (fp, "s");
+          out.print (format, ACE_OS::strerror (l));
+          break;
+
+        case 'l':
+          if (!(cdr >> l))
+            return -1;
+          ACE_OS::strcpy (fp, "d");
+          out.print (format, static_cast<int> (l));
+          break;
+        case 'n':
+          ACE_OS::strcpy (fp, "s");
+          out.print (format, ACE_TEXT_ALWAYS_CHAR (this->program_name_.c_str ()));
+          break;
+        case 'P':
+          ACE_OS::strcpy (fp, "d");
+          out.print (format, static_cast<int> (pid));
+          break;
+        case 't':
+          out.print (ACE_UINT64_FORMAT_SPECIFIER_ASCII,
+                     static_cast<ACE_UINT64> (thread_id));
+          break;
+
+        case 'M':
+          if (format[1] == '.' && format[2] == '1')
+            {
+              ACE_OS::strcpy (&format[1], "c");
+              out.print (format,
+                         static_cast<int> (ace_log_msg_binary_priority_char (priority)));
+            }
+          else
+            {
+              ACE_OS::strcpy (fp, "s");
+              out.print (format,
+                         ACE_TEXT_ALWAYS_CHAR (ACE_Log_Record::priority_name
+                                                 (static_cast<ACE_Log_Priority> (priority))));
+            }
+          break;
+
+        case '$':
+          out.put ('\n');
+          /* fallthrough */
+        case 'I':
+          if (!(cdr >> l))
+            return -1;
+          for (; l > 0; --l)
+            out.put (' ');
+          break;
+
+        case 'D':
+        case 'T':
+          {
+            ACE_Time_Value tv = time_stamp;
+            if (time_arg)
+              {
+                if (!(cdr >> ll) || !(cdr >> l))
+                  return -1;
+                tv.set (ACE_Utils::truncate_cast<time_t> (ll), l);
+              }
+            // As in ACE_Log_Msg, %T starts with the space that follows
+            // the date.
+            ACE_TCHAR day_and_time[27];
+            const ACE_TCHAR *s =
+              ACE::timestamp (tv,
+                              day_and_time,
+                              sizeof day_and_time / sizeof (ACE_TCHAR));
+            if (s != 0 && *format_str == 'D')
+              s = day_and_time;
+            ACE_OS::strcpy (fp, "s");
+            out.print (format, s == 0 ? "" : ACE_TEXT_ALWAYS_CHAR (s));
+            break;
+          }
+
+        default:
+          // Not a directive, print it as it was written.
+          while (start_format != format_str)
+            out.put (*start_format++);
+          out.put (*format_str);
+          break;
+        }
+
+      ++format_str;
+    }
+
+#if defined (ACE_USES_WCHAR)
+  ACE_OS::strsncpy (this->msg_,
+                    ACE_TEXT_CHAR_TO_TCHAR (buffer),
+                    ACE_Log_Record::MAXLOGMSGLEN + 1);
+#endif /* ACE_USES_WCHAR */
+
+  return log_record.msg_data (this->msg_);
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,240 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    Log_Msg_Binary.h
+ *
+ *  ACE_Log_Msg backend that writes messages in a binary format, and
+ *  the reader that turns them back into log records.
+ */
+//=============================================================================
+
+#ifndef ACE_LOG_MSG_BINARY_H
+#define ACE_LOG_MSG_BINARY_H
+#include /**/ "ace/pre.h"
+
+#include "ace/Log_Msg_Backend.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "ace/CDR_Stream.h"
+#include "ace/Hash_Map_Manager_T.h"
+#include "ace/Log_Record.h"
+#include "ace/Null_Mutex.h"
+#include "ace/SString.h"
+#include "ace/Synch_Traits.h"
+#include "ace/Thread_Mutex.h"
+#include "ace/Vector_T.h"
+
+#if !defined (ACE_DEFAULT_LOG_MSG_BINARY_BUFFER_SIZE)
+#define ACE_DEFAULT_LOG_MSG_BINARY_BUFFER_SIZE 65536 /* Bytes */
+#endif /* ACE_DEFAULT_LOG_MSG_BINARY_BUFFER_SIZE */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class ACE_Log_Msg_Binary
+ *
+ * @brief ACE_Log_Msg backend that stores messages without formatting
+ * them.
+ *
+ * Each message is written as the id of its format string, its
+ * arguments, its priority, timestamp, process and thread id, in CDR.
+ * A format string is written once, the first time it is used.  The
+ * text is only produced when the file is read back, with
+ * ACE_Log_Msg_Binary_Reader or the log_decoder application, so
+ * logging costs neither the formatting nor the disk space of the
+ * text.
+ *
+ * ACE_Log_Msg only hands unformatted messages to the backend when it
+ * is the only destination, i.e., when the CUSTOM flag is the only
+ * one set.  Messages with directives that have side effects (%a, %r,
+ * %R, %{ and %}) or that need the calling thread to be rendered
+ * (%?, %W, %Z), as well as the records of log_hexdump(), are
+ * formatted by ACE_Log_Msg and stored as text.
+ *
+ * The backend may be used by several threads at once.  It buffers
+ * the records and writes them when the buffer is full, when a message
+ * of priority LM_ERROR or above is logged, and on reset() and close().
+ *
+ * @note Records are framed like those sent to the logging daemon: a
+ * byte order flag and the length of the record, then the record,
+ * all in one CDR stream.
+ */
+class ACE_Export ACE_Log_Msg_Binary : public ACE_Log_Msg_Backend
+{
+public:
+  /// Types of the records in a binary log file.
+  enum
+  {
+    /// Written by open(): the magic string, the format version, the
+    /// program and host names.  Format ids start again after it.
+    HEADER = 1,
+    /// A format string and its id.
+    FORMAT = 2,
+    /// A message, stored as the id of its format and its arguments.
+    MESSAGE = 3,
+    /// An ACE_Log_Record that was already formatted.
+    RECORD = 4
+  };
+
+  /// Version of the format written in the HEADER record.
+  static const ACE_CDR::ULong VERSION = 1;
+
+  /// Constructor; the messages are appended to @a file_name, through
+  /// a buffer of @a buffer_size bytes.
+  ACE_Log_Msg_Binary (const ACE_TCHAR *file_name,
+                      size_t buffer_size = ACE_DEFAULT_LOG_MSG_BINARY_BUFFER_SIZE);
+
+  /// Destructor
+  virtual ~ACE_Log_Msg_Binary (void);
+
+  /// Open the file if it is not yet open; @a logger_key is ignored.
+  virtual int open (const ACE_TCHAR *logger_key);
+
+  /// Write the buffered records.
+  virtual int reset (void);
+
+  /// Write the buffered records and close the file.
+  virtual int close (void);
+
+  /// Store a record that ACE_Log_Msg already formatted.
+  virtual ssize_t log (ACE_Log_Record &log_record);
+
+  /// Store the format id and the arguments of a message.
+  virtual ssize_t log_unformatted (ACE_Log_Msg &log_msg,
+                                   ACE_Log_Priority priority,
+                                   const ACE_TCHAR *format,
+                                   va_list argp);
+
+  /// Returns true; the file is protected by a lock of its own.
+  virtual bool concurrent (void) const;
+
+  ACE_ALLOC_HOOK_DECLARE;
+
+private:
+  // The following are documented in the .cpp file.
+  int open_i (void);
+  ACE_CDR::ULong format_id (const ACE_TCHAR *format);
+  ssize_t write (ACE_OutputCDR &cdr, char *length_pos, bool flush);
+  int flush_i (void);
+
+  /// A format string written to the file, and its id.
+  struct Format
+  {
+    ACE_CDR::ULong id_;
+    char *text_;
+  };
+
+  /// The formats are looked up by address, which is much cheaper than
+  /// hashing them, and compared to make sure the address still holds
+  /// the same format.
+  typedef ACE_Hash_Map_Manager_Ex<const void *,
+                                  Format,
+                                  ACE_Hash<void *>,
+                                  ACE_Equal_To<const void *>,
+                                  ACE_Null_Mutex> FORMAT_MAP;
+
+  /// Name of the file.
+  ACE_TCHAR *file_name_;
+
+  /// The file, ACE_INVALID_HANDLE while the backend is closed.
+  ACE_HANDLE handle_;
+
+  /// Records not yet written to the file.
+  char *buffer_;
+  size_t buffer_size_;
+  size_t buffered_;
+
+  /// The format strings written since the file was opened.
+  FORMAT_MAP formats_;
+
+  /// Id of the last format string written.
+  ACE_CDR::ULong last_id_;
+
+  /// Serializes the writes to the file and protects <formats_>.
+  ACE_SYNCH_MUTEX lock_;
+
+  // = Disallow these operations.
+  ACE_UNIMPLEMENTED_FUNC (ACE_Log_Msg_Binary (const ACE_Log_Msg_Binary &))
+  ACE_UNIMPLEMENTED_FUNC (void operator= (const ACE_Log_Msg_Binary &))
+};
+
+/**
+ * @class ACE_Log_Msg_Binary_Reader
+ *
+ * @brief Read the files written by ACE_Log_Msg_Binary.
+ *
+ * Renders each message the way ACE_Log_Msg would have formatted it,
+ * into an ACE_Log_Record that can be printed with the usual verbosity
+ * flags.  The error messages of %p and %m are those of the platform
+ * the reader runs on.
+ */
+class ACE_Export ACE_Log_Msg_Binary_Reader
+{
+public:
+  /// Constructor
+  ACE_Log_Msg_Binary_Reader (void);
+
+  /// Destructor
+  ~ACE_Log_Msg_Binary_Reader (void);
+
+  /// Open @a file_name.  Returns -1 if it can't be opened or was not
+  /// written by ACE_Log_Msg_Binary.
+  int open (const ACE_TCHAR *file_name);
+
+  /// Close the file.
+  int close (void);
+
+  /**
+   * Read the next record into @a log_record.
+   *
+   * @retval 1 if a record was read.
+   * @retval 0 at the end of the file.
+   * @retval -1 if the file is corrupt.
+   */
+  int read (ACE_Log_Record &log_record);
+
+  /// Name of the program that wrote the records read last.
+  const ACE_TCHAR *program_name (void) const;
+
+  /// Name of the host on which they were written.
+  const ACE_TCHAR *host_name (void) const;
+
+private:
+  // The following are documented in the .cpp file.
+  int read_frame (void);
+  int read_header (ACE_InputCDR &cdr);
+  int read_format (ACE_InputCDR &cdr);
+  int read_message (ACE_InputCDR &cdr, ACE_Log_Record &log_record);
+
+  /// The file, 0 if not open.
+  FILE *file_;
+
+  /// Holds the record read last, aligned for CDR.
+  ACE_Message_Block buffer_;
+
+  /// Byte order of the record read last.
+  int byte_order_;
+
+  /// The format strings, indexed by their id.
+  ACE_Vector<ACE_CString> formats_;
+
+  /// From the last HEADER record.
+  ACE_TString program_name_;
+  ACE_TString host_name_;
+
+  /// Buffer in which the messages are rendered.
+  ACE_TCHAR msg_[ACE_Log_Record::MAXLOGMSGLEN + 1];
+
+  // = Disallow these operations.
+  ACE_UNIMPLEMENTED_FUNC (ACE_Log_Msg_Binary_Reader (const ACE_Log_Msg_Binary_Reader &))
+  ACE_UNIMPLEMENTED_FUNC (void operator= (const ACE_Log_Msg_Binary_Reader &))
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#include /**/ "ace/post.h"
+#endif /* ACE_LOG_MSG_BINARY_H */
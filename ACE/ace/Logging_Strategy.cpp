@@ -9,6 +9,7 @@
 
 #include "ace/Lib_Find.h"
 #include "ace/Log_Category.h"
+#include "ace/Log_Msg_Async.h"
 #include "ace/Reactor.h"
 #include "ace/OS_NS_string.h"
 #include "ace/OS_NS_stdio.h"
@@ -126,6 +127,8 @@ ACE_Logging_Strategy::tokenize (ACE_TCHAR *flag_string)
         ACE_SET_BITS (this->flags_, ACE_Log_Msg::SILENT);
       else if (ACE_OS::strcmp (flag, ACE_TEXT ("SYSLOG")) == 0)
         ACE_SET_BITS (this->flags_, ACE_Log_Msg::SYSLOG);
+      else if (ACE_OS::strcmp (flag, ACE_TEXT ("ASYNC")) == 0)
+        this->async_ = true;
     }
 }
 
@@ -147,14 +150,21 @@ ACE_Logging_Strategy::parse_args (int argc, ACE_TCHAR *argv[])
   this->max_file_number_ = 1;
   this->interval_ = ACE_DEFAULT_LOGFILE_POLL_INTERVAL;
   this->max_size_ = 0;
+  this->async_ = false;
+  this->async_buffer_size_ = ACE_DEFAULT_LOG_MSG_ASYNC_BUFFER_SIZE;
 
   ACE_Get_Opt get_opt (argc, argv,
-                       ACE_TEXT ("f:i:k:m:n:N:op:s:t:w"), 0);
+                       ACE_TEXT ("b:f:i:k:m:n:N:op:s:t:w"), 0);
 
   for (int c; (c = get_opt ()) != -1; )
     {
       switch (c)
         {
+        case 'b':
+          // Buffer size (in KB) of each thread with the ASYNC flag.
+          this->async_buffer_size_ =
+            ACE_OS::strtoul (get_opt.opt_arg (), 0, 10) << 10;
+          break;
         case 'f':
           temp = get_opt.opt_arg ();
           // Now tokenize the string to get all the flags
@@ -248,7 +258,10 @@ ACE_Logging_Strategy::ACE_Logging_Strategy (void)
     max_file_number_ (1), // 2 files by default (max file number + 1)
     interval_ (ACE_DEFAULT_LOGFILE_POLL_INTERVAL),
     max_size_ (0),
-    log_msg_ (ACE_Log_Msg::instance ())
+    log_msg_ (ACE_Log_Msg::instance ()),
+    async_ (false),
+    async_buffer_size_ (ACE_DEFAULT_LOG_MSG_ASYNC_BUFFER_SIZE),
+    async_backend_ (0)
 {
 #if defined (ACE_DEFAULT_LOGFILE)
   this->filename_ = ACE::strnew (ACE_DEFAULT_LOGFILE);
@@ -292,6 +305,9 @@ ACE_Logging_Strategy::~ACE_Logging_Strategy (void)
 int
 ACE_Logging_Strategy::fini (void)
 {
+  // Write what is still buffered while the log file is open.
+  this->close_async ();
+
 #if defined (ACE_HAS_ALLOC_HOOKS)
   ACE_Allocator::instance()->free(this->filename_);
 #else
@@ -342,6 +358,9 @@ ACE_Logging_Strategy::init (int argc, ACE_TCHAR *argv[])
   // the default behavior take effect.
   if (this->flags_ != 0)
     {
+      if (!this->async_)
+        this->close_async ();
+
       // Clear all flags
       this->log_msg_->clr_flags (ACE_Log_Msg::STDERR
                                  | ACE_Log_Msg::LOGGER
@@ -413,6 +432,10 @@ ACE_Logging_Strategy::init (int argc, ACE_TCHAR *argv[])
                 this->reactor (ACE_Reactor::instance ());
             }
         }
+      if (this->async_
+          && this->open_async (this->log_msg_->msg_ostream ()) == -1)
+        return -1;
+
       // Now set the flags for Log_Msg
       this->log_msg_->set_flags (this->flags_);
     }
@@ -438,6 +461,11 @@ ACE_Logging_Strategy::handle_timeout (const ACE_Time_Value &,
                            ACE_TEXT ("Cannot acquire lock!\n")),
                           -1);
 
+      // With the ASYNC flag the file is written by the drain thread of
+      // the backend, which does not take the ACE_Log_Msg lock.
+      if (this->async_backend_ != 0)
+        this->async_backend_->acquire ();
+
       // Close the current ostream.
 #if defined (ACE_LACKS_IOSTREAM_TOTALLY)
       FILE *output_file = (FILE *) this->log_msg_->msg_ostream ();
@@ -466,12 +494,16 @@ ACE_Logging_Strategy::handle_timeout (const ACE_Time_Value &,
                 return -1;
 
               this->log_msg_->msg_ostream (output_file);
+              if (this->async_backend_ != 0)
+                this->async_backend_->msg_ostream (output_file);
 #else
               output_file->open (ACE_TEXT_ALWAYS_CHAR (this->filename_),
                                  ios::out);
 #endif /* ACE_LACKS_IOSTREAM_TOTALLY */
 
               // Release the lock previously acquired.
+              if (this->async_backend_ != 0)
+                this->async_backend_->release ();
               this->log_msg_->release ();
               return 0;
             }
@@ -559,12 +591,16 @@ ACE_Logging_Strategy::handle_timeout (const ACE_Time_Value &,
         return -1;
 
       this->log_msg_->msg_ostream (output_file);
+      if (this->async_backend_ != 0)
+        this->async_backend_->msg_ostream (output_file);
 #else
       output_file->open (ACE_TEXT_ALWAYS_CHAR (this->filename_),
                          ios::out);
 #endif /* ACE_LACKS_IOSTREAM_TOTALLY */
 
       // Release the lock previously acquired.
+      if (this->async_backend_ != 0)
+        this->async_backend_->release ();
       this->log_msg_->release ();
     }
 
@@ -608,6 +644,56 @@ ACE_Logging_Strategy::reactor (void) const
   return ACE_Service_Object::reactor ();
 }
 
+int
+ACE_Logging_Strategy::open_async (ACE_OSTREAM_TYPE *output_file)
+{
+  u_long const destinations =
+    this->flags_ & (ACE_Log_Msg::OSTREAM
+                    | ACE_Log_Msg::SYSLOG
+                    | ACE_Log_Msg::LOGGER);
+
+  if (destinations == 0)
+    {
+      // Nothing to take over; stderr is always written directly.
+      this->close_async ();
+      return 0;
+    }
+
+  if (this->async_backend_ == 0)
+    ACE_NEW_RETURN (this->async_backend_,
+                    ACE_Log_Msg_Async (this->async_buffer_size_),
+                    -1);
+
+  this->async_backend_->destinations (destinations, output_file);
+  ACE_Log_Msg::msg_backend (this->async_backend_);
+
+  // ACE_Log_Msg::open() opens the backend, which then opens the
+  // destinations.
+  ACE_CLR_BITS (this->flags_, destinations);
+  ACE_SET_BITS (this->flags_, ACE_Log_Msg::CUSTOM);
+  return 0;
+}
+
+void
+ACE_Logging_Strategy::close_async (void)
+{
+  if (this->async_backend_ == 0)
+    return;
+
+  this->log_msg_->clr_flags (ACE_Log_Msg::CUSTOM);
+  if (ACE_Log_Msg::msg_backend () == this->async_backend_)
+    ACE_Log_Msg::msg_backend (0);
+
+  this->async_backend_->close ();
+  delete this->async_backend_;
+  this->async_backend_ = 0;
+
+  // Keep writing to the log file, if there is one.
+  this->log_msg_->set_flags (this->log_msg_->msg_ostream () != 0
+                             ? ACE_Log_Msg::OSTREAM
+                             : ACE_Log_Msg::STDERR);
+}
+
 void
 ACE_Logging_Strategy::log_msg (ACE_Log_Msg *log_msg)
 {
@@ -25,6 +25,8 @@
 
 ACE_BEGIN_VERSIONED_NAMESPACE_DECL
 
+class ACE_Log_Msg_Async;
+
 /**
  * @class ACE_Logging_Strategy
  *
@@ -59,6 +61,12 @@ ACE_BEGIN_VERSIONED_NAMESPACE_DECL
  * create a new log file, and don't rotate the others (fewer accesses
  * to disk)).
  *
+ * With the ASYNC flag, the records that go to the file, to syslog or
+ * to the logging daemon are handed to an ACE_Log_Msg_Async backend
+ * instead, which writes them from a thread of its own so that the
+ * threads that log do not wait for the output.  The -b option sets
+ * the size of the buffer of each logging thread.
+ *
  * By default, the @c ACE_Logging_Strategy uses the singleton reactor,
  * i.e., what's returned by @c ACE_Reactor::instance().  If you want
  * to set the reactor used by @c ACE_Logging_Strategy to something
@@ -116,8 +124,10 @@ public:
 
   /**
    * Parse arguments provided in svc.conf file.
+   * @arg '-b' Size (in Kbytes) of the buffer of each logging thread
+   *           with the ASYNC flag.
    * @arg '-f' Pass in the flags (such as OSTREAM, STDERR, LOGGER, VERBOSE,
-   *           SILENT, VERBOSE_LITE) used to control logging.
+   *           SILENT, VERBOSE_LITE, ASYNC) used to control logging.
    * @arg '-i' The interval (in seconds) at which the logfile size is sampled
    *           (default is 0, i.e., do not sample by default).
    * @arg '-k' Set the logging key.
@@ -151,6 +161,13 @@ protected:
   void priorities (ACE_TCHAR *priority_string,
                    ACE_Log_Msg::MASK_TYPE mask);
 
+  /// Hand the OSTREAM, SYSLOG and LOGGER output over to
+  /// <async_backend_>.
+  int open_async (ACE_OSTREAM_TYPE *output_file);
+
+  /// Remove <async_backend_> and log synchronously again.
+  void close_async (void);
+
   /// Current thread's priority mask set by @c priorities
   u_long thread_priority_mask_;
 
@@ -201,6 +218,17 @@ protected:
 
   /// ACE_Log_Msg instance to work with
   ACE_Log_Msg *log_msg_;
+
+  /// If true then the output is written by <async_backend_>.  Default
+  /// value is false.
+  bool async_;
+
+  /// Size (in bytes) of the buffer of each logging thread with
+  /// <async_>.  Default value is ACE_DEFAULT_LOG_MSG_ASYNC_BUFFER_SIZE.
+  size_t async_buffer_size_;
+
+  /// Backend installed for <async_>, 0 if none.
+  ACE_Log_Msg_Async *async_backend_;
 };
 
 ACE_END_VERSIONED_NAMESPACE_DECL
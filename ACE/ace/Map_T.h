@@ -14,6 +14,7 @@
 
 #include "ace/Map_Manager.h"
 #include "ace/Hash_Map_Manager_T.h"
+#include "ace/Open_Hash_Map_T.h"
 #include "ace/Active_Map_Manager.h"
 #include "ace/Pair_T.h"
 
@@ -1304,6 +1305,292 @@ private:
   ACE_UNIMPLEMENTED_FUNC (ACE_Hash_Map_Manager_Ex_Adapter (const ACE_Hash_Map_Manager_Ex_Adapter<KEY, VALUE, HASH_KEY, COMPARE_KEYS, KEY_GENERATOR> &))
 };
 
+/**
+ * @class ACE_Open_Hash_Map_Iterator_Adapter
+ *
+ * @brief Defines a iterator implementation for the Open_Hash_Map_Adapter.
+ *
+ * Implementation to be provided by ACE_Open_Hash_Map::iterator.
+ */
+template <class T, class KEY, class VALUE, class HASH_KEY, class COMPARE_KEYS>
+class ACE_Open_Hash_Map_Iterator_Adapter : public ACE_Iterator_Impl<T>
+{
+public:
+
+  // = Traits.
+  typedef typename ACE_Open_Hash_Map<KEY, VALUE, HASH_KEY, COMPARE_KEYS, ACE_Null_Mutex>::iterator
+          implementation;
+
+  /// Constructor.
+  ACE_Open_Hash_Map_Iterator_Adapter (const ACE_Open_Hash_Map_Iterator<KEY, VALUE, HASH_KEY, COMPARE_KEYS, ACE_Null_Mutex> &impl);
+
+  /// Destructor.
+  virtual ~ACE_Open_Hash_Map_Iterator_Adapter (void);
+
+  /// Clone.
+  virtual ACE_Iterator_Impl<T> *clone (void) const;
+
+  /// Comparison.
+  virtual int compare (const ACE_Iterator_Impl<T> &rhs) const;
+
+  /// Dereference.
+  virtual T dereference (void) const;
+
+  /// Advance.
+  virtual void plus_plus (void);
+
+  /// Reverse.
+  virtual void minus_minus (void);
+
+  /// Accessor to implementation object.
+  ACE_Open_Hash_Map_Iterator<KEY, VALUE, HASH_KEY, COMPARE_KEYS, ACE_Null_Mutex> &impl (void);
+
+protected:
+
+  /// All implementation details are forwarded to this class.
+  ACE_Open_Hash_Map_Iterator<KEY, VALUE, HASH_KEY, COMPARE_KEYS, ACE_Null_Mutex> implementation_;
+};
+
+/**
+ * @class ACE_Open_Hash_Map_Reverse_Iterator_Adapter
+ *
+ * @brief Defines a reverse iterator implementation for the Open_Hash_Map_Adapter.
+ *
+ * Implementation to be provided by ACE_Open_Hash_Map::reverse_iterator.
+ */
+template <class T, class KEY, class VALUE, class HASH_KEY, class COMPARE_KEYS>
+class ACE_Open_Hash_Map_Reverse_Iterator_Adapter : public ACE_Reverse_Iterator_Impl<T>
+{
+public:
+
+  // = Traits.
+  typedef typename ACE_Open_Hash_Map<KEY, VALUE, HASH_KEY, COMPARE_KEYS, ACE_Null_Mutex>::reverse_iterator
+          implementation;
+
+  /// Constructor.
+  ACE_Open_Hash_Map_Reverse_Iterator_Adapter (const ACE_Open_Hash_Map_Reverse_Iterator<KEY, VALUE, HASH_KEY, COMPARE_KEYS, ACE_Null_Mutex> &impl);
+
+  /// Destructor.
+  virtual ~ACE_Open_Hash_Map_Reverse_Iterator_Adapter (void);
+
+  /// Clone.
+  virtual ACE_Reverse_Iterator_Impl<T> *clone (void) const;
+
+  /// Comparison.
+  virtual int compare (const ACE_Reverse_Iterator_Impl<T> &rhs) const;
+
+  /// Dereference.
+  virtual T dereference (void) const;
+
+  /// Advance.
+  virtual void plus_plus (void);
+
+  /// Reverse.
+  virtual void minus_minus (void);
+
+  /// Accessor to implementation object.
+  ACE_Open_Hash_Map_Reverse_Iterator<KEY, VALUE, HASH_KEY, COMPARE_KEYS, ACE_Null_Mutex> &impl (void);
+
+protected:
+
+  /// All implementation details are forwarded to this class.
+  ACE_Open_Hash_Map_Reverse_Iterator<KEY, VALUE, HASH_KEY, COMPARE_KEYS, ACE_Null_Mutex> implementation_;
+};
+
+/**
+ * @class ACE_Open_Hash_Map_Adapter
+ *
+ * @brief Defines a map implementation.
+ *
+ * Implementation to be provided by ACE_Open_Hash_Map.
+ */
+template <class KEY, class VALUE, class HASH_KEY, class COMPARE_KEYS, class KEY_GENERATOR>
+class ACE_Open_Hash_Map_Adapter : public ACE_Map<KEY, VALUE>
+{
+public:
+
+  // = Traits.
+  typedef ACE_Open_Hash_Map_Iterator_Adapter<ACE_Reference_Pair<const KEY, VALUE>, KEY, VALUE, HASH_KEY, COMPARE_KEYS>
+          iterator_impl;
+  typedef ACE_Open_Hash_Map_Reverse_Iterator_Adapter<ACE_Reference_Pair<const KEY, VALUE>, KEY, VALUE, HASH_KEY, COMPARE_KEYS>
+          reverse_iterator_impl;
+  typedef ACE_Open_Hash_Map<KEY, VALUE, HASH_KEY, COMPARE_KEYS, ACE_Null_Mutex>
+          implementation;
+
+  // = Initialization and termination methods.
+  /// Initialize with the ACE_DEFAULT_MAP_SIZE.
+  ACE_Open_Hash_Map_Adapter (ACE_Allocator *alloc = 0);
+
+  /// Initialize with @a size entries.  The @a size parameter is ignored
+  /// by maps for which an initialize size does not make sense.
+  ACE_Open_Hash_Map_Adapter (size_t size,
+                             ACE_Allocator *alloc = 0);
+
+  /// Close down and release dynamically allocated resources.
+  virtual ~ACE_Open_Hash_Map_Adapter (void);
+
+  /// Initialize a Map with size @a length.
+  virtual int open (size_t length = ACE_DEFAULT_MAP_SIZE,
+                    ACE_Allocator *alloc = 0);
+
+  /// Close down a Map and release dynamically allocated resources.
+  virtual int close (void);
+
+  /**
+   * Add @a key / @a value pair to the map.  If @a key is already in the
+   * map then no changes are made and 1 is returned.  Returns 0 on a
+   * successful addition.  This function fails for maps that do not
+   * allow user specified keys. @a key is an "in" parameter.
+   */
+  virtual int bind (const KEY &key,
+                    const VALUE &value);
+
+  /**
+   * Add @a key / @a value pair to the map.  @a key is an "inout" parameter
+   * and maybe modified/extended by the map to add additional
+   * information.  To recover original key, call the <recover_key>
+   * method.
+   */
+  virtual int bind_modify_key (const VALUE &value,
+                               KEY &key);
+
+  /**
+   * Produce a key and return it through @a key which is an "out"
+   * parameter.  For maps that do not naturally produce keys, the map
+   * adapters will use the @c KEY_GENERATOR class to produce a key.
+   * However, the users are responsible for not jeopardizing this key
+   * production scheme by using user specified keys with keys produced
+   * by the key generator.
+   */
+  virtual int create_key (KEY &key);
+
+  /**
+   * Add @a value to the map, and the corresponding key produced by the
+   * Map is returned through @a key which is an "out" parameter.  For
+   * maps that do not naturally produce keys, the map adapters will
+   * use the @c KEY_GENERATOR class to produce a key.  However, the
+   * users are responsible for not jeopardizing this key production
+   * scheme by using user specified keys with keys produced by the key
+   * generator.
+   */
+  virtual int bind_create_key (const VALUE &value,
+                               KEY &key);
+
+  /**
+   * Add @a value to the map.  The user does not care about the
+   * corresponding key produced by the Map. For maps that do not
+   * naturally produce keys, the map adapters will use the
+   * @c KEY_GENERATOR class to produce a key.  However, the users are
+   * responsible for not jeopardizing this key production scheme by
+   * using user specified keys with keys produced by the key
+   * generator.
+   */
+  virtual int bind_create_key (const VALUE &value);
+
+  /// Recovers the original key potentially modified by the map during
+  /// bind_modify_key().
+  virtual int recover_key (const KEY &modified_key,
+                           KEY &original_key);
+
+  /**
+   * Reassociate @a key with @a value. The function fails if @a key is
+   * not in the map for maps that do not allow user specified keys.
+   * However, for maps that allow user specified keys, if the key is
+   * not in the map, a new @a key / @a value association is created.
+   */
+  virtual int rebind (const KEY &key,
+                      const VALUE &value);
+
+  /**
+   * Reassociate @a key with @a value, storing the old value into the
+   * "out" parameter @a old_value.  The function fails if @a key is not
+   * in the map for maps that do not allow user specified keys.
+   * However, for maps that allow user specified keys, if the key is
+   * not in the map, a new @a key / @a value association is created.
+   */
+  virtual int rebind (const KEY &key,
+                      const VALUE &value,
+                      VALUE &old_value);
+
+  /**
+   * Reassociate @a key with @a value, storing the old key and value
+   * into the "out" parameters @a old_key and @a old_value.  The
+   * function fails if @a key is not in the map for maps that do not
+   * allow user specified keys.  However, for maps that allow user
+   * specified keys, if the key is not in the map, a new @a key / @a value
+   * association is created.
+   */
+  virtual int rebind (const KEY &key,
+                      const VALUE &value,
+                      KEY &old_key,
+                      VALUE &old_value);
+
+  /**
+   * Associate @a key with @a value if and only if @a key is not in the
+   * map.  If @a key is already in the map, then the @a value parameter
+   * is overwritten with the existing value in the map. Returns 0 if a
+   * new @a key / @a value association is created.  Returns 1 if an
+   * attempt is made to bind an existing entry.  This function fails
+   * for maps that do not allow user specified keys.
+   */
+  virtual int trybind (const KEY &key,
+                       VALUE &value);
+
+  /// Locate @a value associated with @a key.
+  virtual int find (const KEY &key,
+                    VALUE &value);
+
+  /// Is @a key in the map?
+  virtual int find (const KEY &key);
+
+  /// Remove @a key from the map.
+  virtual int unbind (const KEY &key);
+
+  /// Remove @a key from the map, and return the @a value associated with
+  /// @a key.
+  virtual int unbind (const KEY &key,
+                      VALUE &value);
+
+  /// Return the current size of the map.
+  virtual size_t current_size (void) const;
+
+  /// Return the total size of the map.
+  virtual size_t total_size (void) const;
+
+  /// Dump the state of an object.
+  virtual void dump (void) const;
+
+  /// Accessor to implementation object.
+  ACE_Open_Hash_Map<KEY, VALUE, HASH_KEY, COMPARE_KEYS, ACE_Null_Mutex> &impl (void);
+
+  /// Accessor to key generator.
+  KEY_GENERATOR &key_generator (void);
+
+protected:
+
+  /// All implementation details are forwarded to this class.
+  ACE_Open_Hash_Map<KEY, VALUE, HASH_KEY, COMPARE_KEYS, ACE_Null_Mutex> implementation_;
+
+  /// Functor class used for generating key.
+  KEY_GENERATOR key_generator_;
+
+  // = STL styled iterator factory functions.
+
+  /// Return forward iterator.
+  virtual ACE_Iterator_Impl<ACE_Reference_Pair<const KEY, VALUE> > *begin_impl (void);
+  virtual ACE_Iterator_Impl<ACE_Reference_Pair<const KEY, VALUE> > *end_impl (void);
+
+  /// Return reverse iterator.
+  virtual ACE_Reverse_Iterator_Impl<ACE_Reference_Pair<const KEY, VALUE> > *rbegin_impl (void);
+  virtual ACE_Reverse_Iterator_Impl<ACE_Reference_Pair<const KEY, VALUE> > *rend_impl (void);
+
+private:
+
+  // = Disallow these operations.
+  ACE_UNIMPLEMENTED_FUNC (void operator= (const ACE_Open_Hash_Map_Adapter<KEY, VALUE, HASH_KEY, COMPARE_KEYS, KEY_GENERATOR> &))
+  ACE_UNIMPLEMENTED_FUNC (ACE_Open_Hash_Map_Adapter (const ACE_Open_Hash_Map_Adapter<KEY, VALUE, HASH_KEY, COMPARE_KEYS, KEY_GENERATOR> &))
+};
+
 /**
  * @class ACE_Map_Manager_Iterator_Adapter
  *
@@ -0,0 +1,389 @@
+
+//=============================================================================
+/**
+ *  @file    Open_Hash_Map_T.cpp
+ */
+//=============================================================================
+
+
+#ifndef ACE_OPEN_HASH_MAP_T_CPP
+#define ACE_OPEN_HASH_MAP_T_CPP
+
+#include "ace/Open_Hash_Map_T.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#if !defined (__ACE_INLINE__)
+# include "ace/Open_Hash_Map_T.inl"
+#endif /* __ACE_INLINE__ */
+
+#include "ace/Malloc_Base.h"
+#include "ace/os_include/os_errno.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_ALLOC_HOOK_DEFINE_Tc5(ACE_Open_Hash_Map)
+ACE_ALLOC_HOOK_DEFINE_Tc5(ACE_Open_Hash_Map_Iterator_Base)
+ACE_ALLOC_HOOK_DEFINE_Tc5(ACE_Open_Hash_Map_Iterator)
+ACE_ALLOC_HOOK_DEFINE_Tc5(ACE_Open_Hash_Map_Reverse_Iterator)
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> void
+ACE_Open_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::dump (void) const
+{
+#if defined (ACE_HAS_DUMP)
+  ACELIB_DEBUG ((LM_DEBUG, ACE_BEGIN_DUMP, this));
+  ACELIB_DEBUG ((LM_DEBUG,  ACE_TEXT ("capacity_ = %d\n"), this->capacity_));
+  ACELIB_DEBUG ((LM_DEBUG,  ACE_TEXT ("cur_size_ = %d\n"), this->cur_size_));
+  ACELIB_DEBUG ((LM_DEBUG,  ACE_TEXT ("growth_left_ = %d\n"), this->growth_left_));
+  this->allocator_->dump ();
+  this->lock_.dump ();
+  ACELIB_DEBUG ((LM_DEBUG, ACE_END_DUMP));
+#endif /* ACE_HAS_DUMP */
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_Open_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::open (size_t size,
+                                                                           ACE_Allocator *alloc)
+{
+  ACE_WRITE_GUARD_RETURN (ACE_LOCK, ace_mon, this->lock_, -1);
+
+  // Calling this->close_i () to ensure we release previous allocated
+  // memory before allocating new one.
+  this->close_i ();
+
+  if (alloc == 0)
+    alloc = ACE_Allocator::instance ();
+
+  this->allocator_ = alloc;
+
+  // The smallest table that holds size entries below its maximum
+  // load of 7/8.
+  size_t capacity = ACE_Open_Hash_Map_Group::WIDTH;
+  while (capacity - capacity / 8 < size)
+    capacity *= 2;
+
+  return this->resize (capacity);
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_Open_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::close_i (void)
+{
+  if (this->slots_ != 0)
+    {
+      this->unbind_all_i ();
+
+      this->allocator_->free (this->slots_);
+      this->slots_ = 0;
+      this->ctrl_ = 0;
+      this->capacity_ = 0;
+      this->growth_left_ = 0;
+    }
+
+  return 0;
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_Open_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::unbind_all_i (void)
+{
+  for (size_t i = 0; i < this->capacity_; ++i)
+    if (this->ctrl_[i] >= 0)
+      {
+        ACE_DES_NOFREE (&this->slots_[i], ENTRY);
+      }
+
+  if (this->ctrl_ != 0)
+    ACE_OS::memset (this->ctrl_,
+                    ACE_Open_Hash_Map_Group::EMPTY,
+                    this->capacity_ + ACE_Open_Hash_Map_Group::WIDTH - 1);
+
+  this->cur_size_ = 0;
+  this->growth_left_ = this->capacity_ - this->capacity_ / 8;
+
+  return 0;
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_Open_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::resize (size_t capacity)
+{
+  size_t const ctrl_size = capacity + ACE_Open_Hash_Map_Group::WIDTH - 1;
+  void *ptr = 0;
+
+  // The control bytes follow the slots in the same block.
+  ACE_ALLOCATOR_RETURN (ptr,
+                        this->allocator_->malloc (capacity * sizeof (ENTRY)
+                                                  + ctrl_size),
+                        -1);
+
+  ENTRY * const old_slots = this->slots_;
+  ACE_INT8 * const old_ctrl = this->ctrl_;
+  size_t const old_capacity = this->capacity_;
+
+  this->slots_ = static_cast<ENTRY *> (ptr);
+  this->ctrl_ = reinterpret_cast<ACE_INT8 *> (this->slots_ + capacity);
+  this->capacity_ = capacity;
+  this->growth_left_ = capacity - capacity / 8 - this->cur_size_;
+  ACE_OS::memset (this->ctrl_, ACE_Open_Hash_Map_Group::EMPTY, ctrl_size);
+
+  for (size_t i = 0; i < old_capacity; ++i)
+    if (old_ctrl[i] >= 0)
+      {
+        ACE_UINT64 const h = this->hash (old_slots[i].ext_id_);
+        size_t const index = this->find_first_non_full (h);
+
+        new (&this->slots_[index]) ENTRY (old_slots[i].ext_id_,
+                                          old_slots[i].int_id_);
+        this->set_ctrl (index, static_cast<ACE_INT8> (h & 0x7F));
+
+        ACE_DES_NOFREE (&old_slots[i], ENTRY);
+      }
+
+  if (old_slots != 0)
+    this->allocator_->free (old_slots);
+
+  return 0;
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> size_t
+ACE_Open_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::find_first_non_full (ACE_UINT64 hash) const
+{
+  size_t const mask = this->capacity_ - 1;
+  size_t pos = static_cast<size_t> (hash >> 7) & mask;
+
+  // Triangular probing by whole groups visits every group once, the
+  // capacity being a power of 2.
+  for (size_t step = ACE_Open_Hash_Map_Group::WIDTH; ; step += ACE_Open_Hash_Map_Group::WIDTH)
+    {
+      ACE_Open_Hash_Map_Group const group (this->ctrl_ + pos);
+      ACE_Open_Hash_Map_Group::mask_type const match =
+        group.match_empty_or_deleted ();
+
+      if (match != 0)
+        return (pos + ACE_Open_Hash_Map_Group::lowest (match)) & mask;
+
+      pos = (pos + step) & mask;
+    }
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_Open_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::find_index (const EXT_ID &ext_id,
+                                                                                 ACE_UINT64 hash,
+                                                                                 size_t &index)
+{
+  if (this->capacity_ != 0)
+    {
+      ACE_INT8 const h2 = static_cast<ACE_INT8> (hash & 0x7F);
+      size_t const mask = this->capacity_ - 1;
+      size_t pos = static_cast<size_t> (hash >> 7) & mask;
+
+      for (size_t step = ACE_Open_Hash_Map_Group::WIDTH; ; step += ACE_Open_Hash_Map_Group::WIDTH)
+        {
+          ACE_Open_Hash_Map_Group const group (this->ctrl_ + pos);
+
+          for (ACE_Open_Hash_Map_Group::mask_type match = group.match (h2);
+               match != 0;
+               match = ACE_Open_Hash_Map_Group::clear_lowest (match))
+            {
+              size_t const i =
+                (pos + ACE_Open_Hash_Map_Group::lowest (match)) & mask;
+
+              if (this->compare_keys_ (this->slots_[i].ext_id_, ext_id))
+                {
+                  index = i;
+                  return 0;
+                }
+            }
+
+          // The key would have been put in an empty slot of this
+          // group.
+          if (group.match_empty () != 0)
+            break;
+
+          pos = (pos + step) & mask;
+        }
+    }
+
+  errno = ENOENT;
+  return -1;
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_Open_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::find_or_prepare_insert (const EXT_ID &ext_id,
+                                                                                             size_t &index)
+{
+  ACE_UINT64 const hash = this->hash (ext_id);
+
+  if (this->find_index (ext_id, hash, index) == 0)
+    return 0;
+
+  index = this->capacity_ == 0 ? 0 : this->find_first_non_full (hash);
+
+  // A DELETED slot can be reused, an EMPTY one only while the load
+  // stays below 7/8.
+  if (this->capacity_ == 0
+      || (this->growth_left_ == 0
+          && this->ctrl_[index] != ACE_Open_Hash_Map_Group::DELETED))
+    {
+      size_t capacity = ACE_Open_Hash_Map_Group::WIDTH;
+      if (this->capacity_ != 0)
+        // Only drop the DELETED slots if the entries would still
+        // leave room for many new ones, else grow.
+        capacity = this->cur_size_ <= this->capacity_ / 32 * 25
+          ? this->capacity_
+          : this->capacity_ * 2;
+
+      if (this->resize (capacity) == -1)
+        return -1;
+
+      index = this->find_first_non_full (hash);
+    }
+
+  if (this->ctrl_[index] == ACE_Open_Hash_Map_Group::EMPTY)
+    --this->growth_left_;
+
+  this->set_ctrl (index, static_cast<ACE_INT8> (hash & 0x7F));
+  ++this->cur_size_;
+
+  return 1;
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_Open_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::bind_i (const EXT_ID &ext_id,
+                                                                             const INT_ID &int_id,
+                                                                             ENTRY *&entry)
+{
+  size_t index = 0;
+  int const result = this->find_or_prepare_insert (ext_id, index);
+
+  if (result == -1)
+    return -1;
+
+  if (result == 1)
+    new (&this->slots_[index]) ENTRY (ext_id, int_id);
+
+  entry = &this->slots_[index];
+  return result == 1 ? 0 : 1;
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_Open_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::trybind_i (const EXT_ID &ext_id,
+                                                                                INT_ID &int_id,
+                                                                                ENTRY *&entry)
+{
+  int const result = this->bind_i (ext_id, int_id, entry);
+
+  if (result == 1)
+    int_id = entry->int_id_;
+
+  return result;
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_Open_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::rebind_i (const EXT_ID &ext_id,
+                                                                               const INT_ID &int_id,
+                                                                               ENTRY *&entry)
+{
+  int const result = this->bind_i (ext_id, int_id, entry);
+
+  if (result == 1)
+    {
+      entry->ext_id_ = ext_id;
+      entry->int_id_ = int_id;
+    }
+
+  return result;
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_Open_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::rebind_i (const EXT_ID &ext_id,
+                                                                               const INT_ID &int_id,
+                                                                               INT_ID &old_int_id,
+                                                                               ENTRY *&entry)
+{
+  int const result = this->bind_i (ext_id, int_id, entry);
+
+  if (result == 1)
+    {
+      old_int_id = entry->int_id_;
+      entry->ext_id_ = ext_id;
+      entry->int_id_ = int_id;
+    }
+
+  return result;
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_Open_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::rebind_i (const EXT_ID &ext_id,
+                                                                               const INT_ID &int_id,
+                                                                               EXT_ID &old_ext_id,
+                                                                               INT_ID &old_int_id,
+                                                                               ENTRY *&entry)
+{
+  int const result = this->bind_i (ext_id, int_id, entry);
+
+  if (result == 1)
+    {
+      old_ext_id = entry->ext_id_;
+      old_int_id = entry->int_id_;
+      entry->ext_id_ = ext_id;
+      entry->int_id_ = int_id;
+    }
+
+  return result;
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_Open_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::unbind_i (ENTRY *entry)
+{
+  if (entry == 0
+      || this->index_of (entry) >= this->capacity_
+      || this->ctrl_[this->index_of (entry)] < 0)
+    {
+      errno = ENOENT;
+      return -1;
+    }
+
+  size_t const index = this->index_of (entry);
+
+  ACE_DES_NOFREE (entry, ENTRY);
+  --this->cur_size_;
+
+  // The slot can be EMPTY again if no probe ever went past it, which
+  // is the case when each group of WIDTH slots around it has an EMPTY
+  // one: a probe stops at the first group with an EMPTY slot.
+  size_t const mask = this->capacity_ - 1;
+  size_t const before = (index - ACE_Open_Hash_Map_Group::WIDTH) & mask;
+  ACE_Open_Hash_Map_Group::mask_type const empty_before =
+    ACE_Open_Hash_Map_Group (this->ctrl_ + before).match_empty ();
+  ACE_Open_Hash_Map_Group::mask_type const empty_after =
+    ACE_Open_Hash_Map_Group (this->ctrl_ + index).match_empty ();
+
+  if (ACE_Open_Hash_Map_Group::leading (empty_before)
+      + ACE_Open_Hash_Map_Group::trailing (empty_after)
+      < ACE_Open_Hash_Map_Group::WIDTH)
+    {
+      this->set_ctrl (index, ACE_Open_Hash_Map_Group::EMPTY);
+      ++this->growth_left_;
+    }
+  else
+    this->set_ctrl (index, ACE_Open_Hash_Map_Group::DELETED);
+
+  return 0;
+}
+
+// ------------------------------------------------------------
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> void
+ACE_Open_Hash_Map_Iterator_Base<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::dump_i (void) const
+{
+  ACE_TRACE ("ACE_Open_Hash_Map_Iterator_Base<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::dump_i");
+
+  ACELIB_DEBUG ((LM_DEBUG, ACE_BEGIN_DUMP, this));
+  ACELIB_DEBUG ((LM_DEBUG,  ACE_TEXT ("index_ = %d "), this->index_));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_END_DUMP));
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_OPEN_HASH_MAP_T_CPP */
@@ -0,0 +1,753 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    Open_Hash_Map_T.h
+ *
+ *  Open addressing hash map, with the interface of
+ *  ACE_Hash_Map_Manager_Ex.
+ */
+//=============================================================================
+
+#ifndef ACE_OPEN_HASH_MAP_T_H
+#define ACE_OPEN_HASH_MAP_T_H
+#include /**/ "ace/pre.h"
+
+#include /**/ "ace/config-all.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "ace/Default_Constants.h"
+#include "ace/Functor_T.h"
+#include "ace/Basic_Types.h"
+#include "ace/Log_Category.h"
+#include "ace/OS_NS_string.h"
+
+#if !defined (ACE_LACKS_OPEN_HASH_MAP_SIMD) \
+    && (defined (__SSE2__) || defined (_M_X64) \
+        || (defined (_M_IX86_FP) && _M_IX86_FP >= 2))
+  // The control bytes are probed 16 at a time with SSE2, which every
+  // x86-64 CPU has.
+# define ACE_HAS_OPEN_HASH_MAP_SSE2
+# include /**/ <emmintrin.h>
+#endif
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class ACE_Open_Hash_Map_Group
+ *
+ * @brief A group of control bytes of an ACE_Open_Hash_Map, probed at
+ * once.
+ *
+ * Each slot of the map has a control byte: EMPTY, DELETED, or the
+ * seven low bits of the hash of the key of a full slot.  A group
+ * compares WIDTH control bytes with one value at once, with SSE2 when
+ * available and otherwise with 64 bit arithmetic on 8 bytes.  The
+ * result is a mask with a bit for each matching byte.
+ */
+class ACE_Open_Hash_Map_Group
+{
+public:
+  enum
+  {
+    EMPTY = -128,
+    DELETED = -2
+  };
+
+#if defined (ACE_HAS_OPEN_HASH_MAP_SSE2)
+  enum { WIDTH = 16, SHIFT = 0 };
+  typedef ACE_UINT32 mask_type;
+#else
+  /// Each byte of the group has one bit, its high bit, in the mask.
+  enum { WIDTH = 8, SHIFT = 3 };
+  typedef ACE_UINT64 mask_type;
+#endif /* ACE_HAS_OPEN_HASH_MAP_SSE2 */
+
+  /// Load the WIDTH bytes at @a ctrl.
+  explicit ACE_Open_Hash_Map_Group (const ACE_INT8 *ctrl)
+  {
+#if defined (ACE_HAS_OPEN_HASH_MAP_SSE2)
+    this->ctrl_ = _mm_loadu_si128 (reinterpret_cast<const __m128i *> (ctrl));
+#elif defined (ACE_LITTLE_ENDIAN)
+    ACE_OS::memcpy (&this->ctrl_, ctrl, sizeof this->ctrl_);
+#else
+    this->ctrl_ = 0;
+    for (int i = 0; i < WIDTH; ++i)
+      this->ctrl_ |= static_cast<ACE_UINT64> (static_cast<ACE_UINT8> (ctrl[i])) << (8 * i);
+#endif /* ACE_HAS_OPEN_HASH_MAP_SSE2 */
+  }
+
+  /// The bytes equal to @a h2, the seven bits of a hash.
+  mask_type match (ACE_INT8 h2) const
+  {
+#if defined (ACE_HAS_OPEN_HASH_MAP_SSE2)
+    return static_cast<mask_type> (
+      _mm_movemask_epi8 (_mm_cmpeq_epi8 (this->ctrl_, _mm_set1_epi8 (h2))));
+#else
+    // May report a byte next to a match, which only costs a key
+    // comparison.
+    ACE_UINT64 const x =
+      this->ctrl_ ^ (lsbs () * static_cast<ACE_UINT8> (h2));
+    return (x - lsbs ()) & ~x & msbs ();
+#endif /* ACE_HAS_OPEN_HASH_MAP_SSE2 */
+  }
+
+  /// The EMPTY bytes.
+  mask_type match_empty (void) const
+  {
+#if defined (ACE_HAS_OPEN_HASH_MAP_SSE2)
+    return static_cast<mask_type> (
+      _mm_movemask_epi8 (_mm_cmpeq_epi8 (this->ctrl_,
+                                         _mm_set1_epi8 (static_cast<char> (EMPTY)))));
+#else
+    // Only EMPTY has the high bit set and bit 1 clear.
+    return this->ctrl_ & ~(this->ctrl_ << 6) & msbs ();
+#endif /* ACE_HAS_OPEN_HASH_MAP_SSE2 */
+  }
+
+  /// The EMPTY and DELETED bytes, which have their high bit set.
+  mask_type match_empty_or_deleted (void) const
+  {
+#if defined (ACE_HAS_OPEN_HASH_MAP_SSE2)
+    return static_cast<mask_type> (_mm_movemask_epi8 (this->ctrl_));
+#else
+    return this->ctrl_ & msbs ();
+#endif /* ACE_HAS_OPEN_HASH_MAP_SSE2 */
+  }
+
+  /// Index in the group of the lowest byte of @a mask, not 0.
+  static int lowest (mask_type mask)
+  {
+#if defined (__GNUC__)
+    return (sizeof (mask_type) == 8
+            ? __builtin_ctzll (mask)
+            : __builtin_ctz (static_cast<unsigned int> (mask))) >> SHIFT;
+#else
+    int n = 0;
+    while ((mask & 1) == 0)
+      {
+        mask >>= 1;
+        ++n;
+      }
+    return n >> SHIFT;
+#endif /* __GNUC__ */
+  }
+
+  /// Number of bytes below the lowest byte of @a mask, WIDTH if it is 0.
+  static int trailing (mask_type mask)
+  {
+    return mask == 0 ? static_cast<int> (WIDTH) : lowest (mask);
+  }
+
+  /// Number of bytes above the highest byte of @a mask, WIDTH if it
+  /// is 0.
+  static int leading (mask_type mask)
+  {
+    if (mask == 0)
+      return WIDTH;
+#if defined (ACE_HAS_OPEN_HASH_MAP_SSE2) && defined (__GNUC__)
+    return __builtin_clz (static_cast<unsigned int> (mask)) - 16;
+#elif defined (__GNUC__)
+    return __builtin_clzll (mask) >> SHIFT;
+#else
+    int n = 0;
+    for (mask_type top = static_cast<mask_type> (1) << (sizeof (mask_type) * 8 - 1);
+         (mask & top) == 0;
+         mask <<= 1)
+      ++n;
+    // The SSE2 mask only uses the low 16 bits.
+    return (n - static_cast<int> (sizeof (mask_type) * 8 - (WIDTH << SHIFT))) >> SHIFT;
+#endif /* ACE_HAS_OPEN_HASH_MAP_SSE2 && __GNUC__ */
+  }
+
+  /// @a mask without its lowest byte.
+  static mask_type clear_lowest (mask_type mask)
+  {
+    return mask & (mask - 1);
+  }
+
+private:
+#if !defined (ACE_HAS_OPEN_HASH_MAP_SSE2)
+  static ACE_UINT64 lsbs (void) { return ACE_UINT64_LITERAL (0x0101010101010101); }
+  static ACE_UINT64 msbs (void) { return ACE_UINT64_LITERAL (0x8080808080808080); }
+#endif /* ACE_HAS_OPEN_HASH_MAP_SSE2 */
+
+#if defined (ACE_HAS_OPEN_HASH_MAP_SSE2)
+  __m128i ctrl_;
+#else
+  ACE_UINT64 ctrl_;
+#endif /* ACE_HAS_OPEN_HASH_MAP_SSE2 */
+};
+
+/**
+ * @class ACE_Open_Hash_Map_Entry
+ *
+ * @brief An entry of an ACE_Open_Hash_Map, kept in its slot of the
+ * table.
+ */
+template <class EXT_ID, class INT_ID>
+class ACE_Open_Hash_Map_Entry
+{
+public:
+  /// Constructor.
+  ACE_Open_Hash_Map_Entry (const EXT_ID &ext_id,
+                           const INT_ID &int_id);
+
+  /// Key accessor.
+  EXT_ID& key (void);
+
+  /// Read-only key accessor.
+  const EXT_ID& key (void) const;
+
+  /// Item accessor.
+  INT_ID& item (void);
+
+  /// Read-only item accessor.
+  const INT_ID& item (void) const;
+
+  /// Key used to look up an entry.
+  EXT_ID ext_id_;
+
+  /// The contents of the entry itself.
+  INT_ID int_id_;
+};
+
+// Forward decl.
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK>
+class ACE_Open_Hash_Map_Iterator_Base;
+
+// Forward decl.
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK>
+class ACE_Open_Hash_Map_Iterator;
+
+// Forward decl.
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK>
+class ACE_Open_Hash_Map_Reverse_Iterator;
+
+// Forward decl.
+class ACE_Allocator;
+
+/**
+ * @class ACE_Open_Hash_Map
+ *
+ * @brief Define a map abstraction that efficiently associates
+ * @c EXT_ID type objects with @c INT_ID type objects, with open
+ * addressing.
+ *
+ * The entries are kept in the slots of one table instead of in a
+ * node each chained to the bucket of their hash, like in
+ * ACE_Hash_Map_Manager_Ex.  A separate array of control bytes holds,
+ * for every slot, seven bits of the hash of its key, or whether it
+ * is empty or deleted.  A lookup probes the control bytes a group of
+ * ACE_Open_Hash_Map_Group::WIDTH at a time and only compares the keys
+ * of the slots whose seven bits match, so it mostly touches one or two
+ * cache lines.
+ *
+ * The table grows, doubling its size, when more than 7/8 of its slots
+ * are used, so total_size() is not fixed by open().  Growing the table
+ * moves the entries: the ENTRY pointers and the iterators are only
+ * valid until the next bind, trybind or rebind that adds an entry.
+ * Unbinding does not move the other entries, so unbinding the entry an
+ * iterator was just advanced from is safe.
+ *
+ * Key hashing is achieved through the @c HASH_KEY object and key
+ * comparison through the @c COMPARE_KEYS object, as with
+ * ACE_Hash_Map_Manager_Ex, and the table is allocated with an
+ * ACE_Allocator.  ACE_Open_Hash_Map_Adapter adapts it to ACE_Map.
+ */
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK>
+class ACE_Open_Hash_Map
+{
+public:
+  friend class ACE_Open_Hash_Map_Iterator_Base<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>;
+  friend class ACE_Open_Hash_Map_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>;
+  friend class ACE_Open_Hash_Map_Reverse_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>;
+
+  typedef EXT_ID
+          KEY;
+  typedef INT_ID
+          VALUE;
+  typedef ACE_LOCK lock_type;
+  typedef ACE_Open_Hash_Map_Entry<EXT_ID, INT_ID>
+          ENTRY;
+
+  // = ACE-style iterator typedefs.
+  typedef ACE_Open_Hash_Map_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>
+          ITERATOR;
+  typedef ACE_Open_Hash_Map_Reverse_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>
+          REVERSE_ITERATOR;
+
+  // = STL-style iterator typedefs.
+  typedef ACE_Open_Hash_Map_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>
+          iterator;
+  typedef ACE_Open_Hash_Map_Reverse_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>
+          reverse_iterator;
+
+  // = STL-style typedefs/traits.
+  typedef EXT_ID                                  key_type;
+  typedef INT_ID                                  data_type;
+  typedef ACE_Open_Hash_Map_Entry<EXT_ID, INT_ID> value_type;
+  typedef value_type &                            reference;
+  typedef value_type const &                      const_reference;
+  typedef value_type *                            pointer;
+  typedef value_type const *                      const_pointer;
+  typedef ptrdiff_t                               difference_type;
+  typedef size_t                                  size_type;
+
+  // = Initialization and termination methods.
+
+  /// Initialize an ACE_Open_Hash_Map for ACE_DEFAULT_MAP_SIZE
+  /// entries.  If @a alloc is 0 it defaults to
+  /// ACE_Allocator::instance().
+  ACE_Open_Hash_Map (ACE_Allocator *alloc = 0);
+
+  /// Initialize an ACE_Open_Hash_Map for @a size entries.
+  ACE_Open_Hash_Map (size_t size,
+                     ACE_Allocator *alloc = 0);
+
+  /**
+   * Initialize an ACE_Open_Hash_Map with a table large enough for
+   * @a size entries before it grows.  If @a alloc is 0 it defaults to
+   * ACE_Allocator::instance().
+   * @return -1 on failure, 0 on success
+   */
+  int open (size_t size = ACE_DEFAULT_MAP_SIZE,
+            ACE_Allocator *alloc = 0);
+
+  /// Close down the ACE_Open_Hash_Map and release dynamically
+  /// allocated resources.
+  int close (void);
+
+  /// Removes all the entries in the ACE_Open_Hash_Map.
+  int unbind_all (void);
+
+  /// Cleanup the ACE_Open_Hash_Map.
+  ~ACE_Open_Hash_Map (void);
+
+  /**
+   * Associate @a ext_id with @a int_id.  If @a ext_id is already in the
+   * map then the map is not changed.
+   *
+   * @retval  0 if a new entry is bound successfully.
+   * @retval  1 if an attempt is made to bind an existing entry.
+   * @retval -1 if a failure occurs; check @c errno for more information.
+   */
+  int bind (const EXT_ID &ext_id,
+            const INT_ID &int_id);
+
+  /// Same as above, and also returns the internal ACE_Open_Hash_Map_Entry
+  /// in @a entry.
+  int bind (const EXT_ID &ext_id,
+            const INT_ID &int_id,
+            ENTRY *&entry);
+
+  /**
+   * Associate @a ext_id with @a int_id if and only if @a ext_id is not
+   * in the map.  If @a ext_id is already in the map then the @a int_id
+   * parameter is assigned the existing value in the map.  Returns 0 if
+   * a new entry is bound successfully, returns 1 if an attempt is made
+   * to bind an existing entry, and returns -1 if failures occur.
+   */
+  int trybind (const EXT_ID &ext_id,
+               INT_ID &int_id);
+
+  /// Same as above, and also returns the internal ACE_Open_Hash_Map_Entry
+  /// in @a entry.
+  int trybind (const EXT_ID &ext_id,
+               INT_ID &int_id,
+               ENTRY *&entry);
+
+  /**
+   * Reassociate @a ext_id with @a int_id.  If @a ext_id is not in the
+   * map then behaves just like bind.  Returns 0 if a new entry is bound
+   * successfully, returns 1 if an existing entry was rebound, and
+   * returns -1 if failures occur.
+   */
+  int rebind (const EXT_ID &ext_id,
+              const INT_ID &int_id);
+
+  /// Same as above, and also returns the internal ACE_Open_Hash_Map_Entry
+  /// in @a entry.
+  int rebind (const EXT_ID &ext_id,
+              const INT_ID &int_id,
+              ENTRY *&entry);
+
+  /// Same as above, and also returns the previous value of an existing
+  /// entry in @a old_int_id.
+  int rebind (const EXT_ID &ext_id,
+              const INT_ID &int_id,
+              INT_ID &old_int_id);
+
+  /// Same as above, and also returns the internal ACE_Open_Hash_Map_Entry
+  /// in @a entry.
+  int rebind (const EXT_ID &ext_id,
+              const INT_ID &int_id,
+              INT_ID &old_int_id,
+              ENTRY *&entry);
+
+  /// Same as above, and also returns the previous key of an existing
+  /// entry in @a old_ext_id.
+  int rebind (const EXT_ID &ext_id,
+              const INT_ID &int_id,
+              EXT_ID &old_ext_id,
+              INT_ID &old_int_id);
+
+  /// Same as above, and also returns the internal ACE_Open_Hash_Map_Entry
+  /// in @a entry.
+  int rebind (const EXT_ID &ext_id,
+              const INT_ID &int_id,
+              EXT_ID &old_ext_id,
+              INT_ID &old_int_id,
+              ENTRY *&entry);
+
+  /// Locate @a ext_id and pass out parameter via @a int_id.
+  /// Returns 0 if found, returns -1 if not found.
+  int find (const EXT_ID &ext_id,
+            INT_ID &int_id) const;
+
+  /// Returns 0 if the @a ext_id is in the mapping, otherwise -1.
+  int find (const EXT_ID &ext_id) const;
+
+  /// Locate @a ext_id and pass out parameter via @a entry.  If found,
+  /// return 0, returns -1 if not found.
+  int find (const EXT_ID &ext_id,
+            ENTRY *&entry) const;
+
+  /// Unbind (remove) the @a ext_id from the map.  Returns 0 if
+  /// successful, otherwise -1.
+  int unbind (const EXT_ID &ext_id);
+
+  /// Same as above, and also returns the value of the entry in
+  /// @a int_id.
+  int unbind (const EXT_ID &ext_id,
+              INT_ID &int_id);
+
+  /// Remove @a entry from the map.  Returns 0 if successful, otherwise
+  /// -1.
+  int unbind (ENTRY *entry);
+
+  /// Returns the current number of ACE_Open_Hash_Map_Entry objects in
+  /// the map.
+  size_t current_size (void) const;
+
+  /// Returns the number of slots of the table, which grows with the
+  /// number of entries.
+  size_t total_size (void) const;
+
+  /**
+   * Returns a reference to the underlying @c ACE_LOCK.  This makes it
+   * possible to acquire the lock explicitly, which can be useful in
+   * some cases if you instantiate the ACE_Atomic_Op with an
+   * ACE_Recursive_Mutex or ACE_Process_Mutex, or if you need to guard
+   * the state of an iterator.
+   * @note The right name would be lock, but HP/C++ will choke on that!
+   */
+  ACE_LOCK &mutex (void);
+
+  /// Dump the state of an object.
+  void dump (void) const;
+
+  // = STL styled iterator factory functions.
+
+  /// Return forward iterator.
+  iterator begin (void);
+  iterator end (void);
+
+  /// Return reverse iterator.
+  reverse_iterator rbegin (void);
+  reverse_iterator rend (void);
+
+  /// Declare the dynamic allocation hooks.
+  ACE_ALLOC_HOOK_DECLARE;
+
+protected:
+  // = The following methods do the actual work.
+
+  /// Returns the hash of @a ext_id, mixed so that its low seven bits and
+  /// the rest are spread over the table.
+  ACE_UINT64 hash (const EXT_ID &ext_id);
+
+  /// Performs bind.  Must be called with locks held.
+  int bind_i (const EXT_ID &ext_id,
+              const INT_ID &int_id,
+              ENTRY *&entry);
+
+  /// Performs trybind.  Must be called with locks held.
+  int trybind_i (const EXT_ID &ext_id,
+                 INT_ID &int_id,
+                 ENTRY *&entry);
+
+  /// Performs rebind.  Must be called with locks held.
+  int rebind_i (const EXT_ID &ext_id,
+                const INT_ID &int_id,
+                ENTRY *&entry);
+
+  /// Performs rebind.  Must be called with locks held.
+  int rebind_i (const EXT_ID &ext_id,
+                const INT_ID &int_id,
+                INT_ID &old_int_id,
+                ENTRY *&entry);
+
+  /// Performs rebind.  Must be called with locks held.
+  int rebind_i (const EXT_ID &ext_id,
+                const INT_ID &int_id,
+                EXT_ID &old_ext_id,
+                INT_ID &old_int_id,
+                ENTRY *&entry);
+
+  /// Performs find.  Must be called with locks held.
+  int find_i (const EXT_ID &ext_id,
+              ENTRY *&entry);
+
+  /// Performs unbind.  Must be called with locks held.
+  int unbind_i (ENTRY *entry);
+
+  /// Close down a Map.  Must be called with locks held.
+  int close_i (void);
+
+  /// Removes all the entries in the Map.  Must be called with locks
+  /// held.
+  int unbind_all_i (void);
+
+  /// Index of the slot of @a ext_id, whose mixed hash is @a hash.
+  /// Returns 0 if found, otherwise -1.
+  int find_index (const EXT_ID &ext_id,
+                  ACE_UINT64 hash,
+                  size_t &index);
+
+  /// Index of the slot of @a ext_id, or of the slot reserved for it
+  /// if it is not in the map, in which case the table may grow first
+  /// and the caller constructs the entry in the slot.  Returns 0 if
+  /// found, 1 if reserved, and -1 if the table cannot grow.
+  int find_or_prepare_insert (const EXT_ID &ext_id,
+                              size_t &index);
+
+  /// Index of the first EMPTY or DELETED slot on the probe sequence
+  /// of @a hash.
+  size_t find_first_non_full (ACE_UINT64 hash) const;
+
+  /// Set the control byte of slot @a index, and its copy after the
+  /// end of the table.
+  void set_ctrl (size_t index, ACE_INT8 value);
+
+  /// Allocate a table of @a capacity slots, a power of 2, and move
+  /// the entries to it.
+  int resize (size_t capacity);
+
+  /// Slot of @a entry.
+  size_t index_of (const ENTRY *entry) const;
+
+  /// Lock on the map.
+  ACE_LOCK lock_;
+
+  /// Function object used for hashing keys.
+  HASH_KEY hash_key_;
+
+  /// Function object used for comparing keys.
+  COMPARE_KEYS compare_keys_;
+
+private:
+  /// Allocator of the table.
+  ACE_Allocator *allocator_;
+
+  /// The slots, followed in the same allocation by the control bytes.
+  ENTRY *slots_;
+
+  /// The control bytes, capacity_ plus a copy of the first
+  /// ACE_Open_Hash_Map_Group::WIDTH - 1 ones, so that a group can be
+  /// loaded at any slot.
+  ACE_INT8 *ctrl_;
+
+  /// Number of slots, 0 or a power of 2.
+  size_t capacity_;
+
+  /// Number of entries.
+  size_t cur_size_;
+
+  /// Number of EMPTY slots that can still be used before the table
+  /// grows.
+  size_t growth_left_;
+
+  // = Disallow these operations.
+  ACE_UNIMPLEMENTED_FUNC (void operator= (const ACE_Open_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> &))
+  ACE_UNIMPLEMENTED_FUNC (ACE_Open_Hash_Map (const ACE_Open_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> &))
+};
+
+/**
+ * @class ACE_Open_Hash_Map_Iterator_Base
+ *
+ * @brief Base iterator for the ACE_Open_Hash_Map.
+ *
+ * This class factors out common code from its templatized
+ * subclasses.
+ */
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK>
+class ACE_Open_Hash_Map_Iterator_Base
+{
+public:
+  typedef ACE_Open_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>
+          container_type;
+  typedef ACE_Open_Hash_Map_Entry<EXT_ID, INT_ID>
+          ENTRY;
+
+  /// Iterator on slot @a index of @a mm, or the next full slot in
+  /// the direction of the iteration.
+  ACE_Open_Hash_Map_Iterator_Base (container_type &mm,
+                                   ssize_t index);
+
+  /// Pass back the @a next_entry that hasn't been seen in the Set.
+  /// Returns 0 when all items have been seen, else 1.
+  int next (ENTRY *&next_entry) const;
+
+  /// Returns 1 when all items have been seen, else 0.
+  int done (void) const;
+
+  /// Returns a reference to the interal element @c this is pointing to.
+  ENTRY& operator* (void) const;
+
+  /// Returns a pointer to the interal element @c this is pointing to.
+  ENTRY* operator-> (void) const;
+
+  /// Returns reference the Open_Hash_Map that is being iterated
+  /// over.
+  container_type& map (void);
+
+  /// Check if two iterators point to the same position
+  bool operator== (const ACE_Open_Hash_Map_Iterator_Base<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> &) const;
+  bool operator!= (const ACE_Open_Hash_Map_Iterator_Base<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> &) const;
+
+  /// Declare the dynamic allocation hooks.
+  ACE_ALLOC_HOOK_DECLARE;
+
+protected:
+  /// Move forward to the next full slot, or to the end of the table.
+  void forward_i (ssize_t from);
+
+  /// Move backward to the previous full slot, or to -1.
+  void reverse_i (ssize_t from);
+
+  /// Dump the state of an object.
+  void dump_i (void) const;
+
+  /// Map we are iterating over.
+  container_type *map_man_;
+
+  /// Slot of the current entry, -1 or the size of the table at either
+  /// end.
+  ssize_t index_;
+};
+
+/**
+ * @class ACE_Open_Hash_Map_Iterator
+ *
+ * @brief Forward iterator for the ACE_Open_Hash_Map.
+ *
+ * The slots are visited in the order of the table.  This class does
+ * not perform any internal locking of the ACE_Open_Hash_Map it is
+ * iterating upon since locking is inherently inefficient and/or
+ * error-prone within an STL-style iterator.  If you require
+ * locking, you can explicitly use an ACE_GUARD or ACE_READ_GUARD
+ * on the ACE_Open_Hash_Map's internal lock, which is accessible
+ * via its mutex() method.
+ */
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK>
+class ACE_Open_Hash_Map_Iterator
+  : public ACE_Open_Hash_Map_Iterator_Base<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>
+{
+public:
+  typedef typename ACE_Open_Hash_Map_Iterator_Base<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::container_type
+          container_type;
+
+  // = Initialization method.
+  ACE_Open_Hash_Map_Iterator (container_type &mm,
+                              bool tail = false);
+
+  /// Move forward by one element in the set.  Returns 0 when all the
+  /// items in the set have been seen, else 1.
+  int advance (void);
+
+  /// Dump the state of an object.
+  void dump (void) const;
+
+  /// Prefix advance.
+  ACE_Open_Hash_Map_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> &operator++ (void);
+
+  /// Postfix advance.
+  ACE_Open_Hash_Map_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> operator++ (int);
+
+  /// Prefix reverse.
+  ACE_Open_Hash_Map_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> &operator-- (void);
+
+  /// Postfix reverse.
+  ACE_Open_Hash_Map_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> operator-- (int);
+
+  /// Declare the dynamic allocation hooks.
+  ACE_ALLOC_HOOK_DECLARE;
+};
+
+/**
+ * @class ACE_Open_Hash_Map_Reverse_Iterator
+ *
+ * @brief Reverse iterator for the ACE_Open_Hash_Map.
+ *
+ * This class does not perform any internal locking of the
+ * ACE_Open_Hash_Map it is iterating upon since locking is
+ * inherently inefficient and/or error-prone within an STL-style
+ * iterator.  If you require locking, you can explicitly use an
+ * ACE_GUARD or ACE_READ_GUARD on the ACE_Open_Hash_Map's
+ * internal lock, which is accessible via its mutex() method.
+ */
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK>
+class ACE_Open_Hash_Map_Reverse_Iterator
+  : public ACE_Open_Hash_Map_Iterator_Base<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>
+{
+public:
+  typedef typename ACE_Open_Hash_Map_Iterator_Base<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::container_type
+          container_type;
+
+  // = Initialization method.
+  ACE_Open_Hash_Map_Reverse_Iterator (container_type &mm,
+                                      bool head = false);
+
+  /// Move forward by one element in the set.  Returns 0 when all the
+  /// items in the set have been seen, else 1.
+  int advance (void);
+
+  /// Dump the state of an object.
+  void dump (void) const;
+
+  /// Prefix reverse.
+  ACE_Open_Hash_Map_Reverse_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> &operator++ (void);
+
+  /// Postfix reverse.
+  ACE_Open_Hash_Map_Reverse_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> operator++ (int);
+
+  /// Prefix advance.
+  ACE_Open_Hash_Map_Reverse_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> &operator-- (void);
+
+  /// Postfix advance.
+  ACE_Open_Hash_Map_Reverse_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> operator-- (int);
+
+  /// Declare the dynamic allocation hooks.
+  ACE_ALLOC_HOOK_DECLARE;
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#if defined (__ACE_INLINE__)
+#  include "ace/Open_Hash_Map_T.inl"
+#endif /* __ACE_INLINE__ */
+
+#if defined (ACE_TEMPLATES_REQUIRE_SOURCE)
+#include "ace/Open_Hash_Map_T.cpp"
+#endif /* ACE_TEMPLATES_REQUIRE_SOURCE */
+
+#if defined (ACE_TEMPLATES_REQUIRE_PRAGMA)
+#pragma implementation ("Open_Hash_Map_T.cpp")
+#endif /* ACE_TEMPLATES_REQUIRE_PRAGMA */
+
+#include /**/ "ace/post.h"
+#endif /* ACE_OPEN_HASH_MAP_T_H */
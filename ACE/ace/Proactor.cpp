@@ -22,6 +22,7 @@
 #if defined (ACE_HAS_AIO_CALLS)
 #   include "ace/POSIX_Proactor.h"
 #   include "ace/POSIX_CB_Proactor.h"
+#   include "ace/Uring_Proactor.h"
 #else /* !ACE_HAS_AIO_CALLS */
 #   include "ace/WIN32_Proactor.h"
 #endif /* ACE_HAS_AIO_CALLS */
@@ -327,7 +328,18 @@ ACE_Proactor::ACE_Proactor (ACE_Proactor_Impl *implementation,
       ACE_NEW (implementation, ACE_POSIX_AIOCB_Proactor);
 #  elif defined (ACE_POSIX_SIG_PROACTOR)
       ACE_NEW (implementation, ACE_POSIX_SIG_Proactor);
-#  else /* Default order: CB, SIG, AIOCB */
+#  else /* Default order: URING, CB, SIG, AIOCB */
+#    if defined (ACE_HAS_IO_URING) && !defined (ACE_POSIX_CB_PROACTOR)
+      // The kernel may not support io_uring even if the headers do.
+      ACE_Uring_Proactor *uring_proactor = 0;
+      ACE_NEW (uring_proactor, ACE_Uring_Proactor);
+      if (uring_proactor->initialized ())
+        implementation = uring_proactor;
+      else
+        delete uring_proactor;
+
+      if (implementation == 0)
+#    endif /* ACE_HAS_IO_URING && !ACE_POSIX_CB_PROACTOR */
 #    if !defined(ACE_HAS_BROKEN_SIGEVENT_STRUCT)
       ACE_NEW (implementation, ACE_POSIX_CB_Proactor);
 #    else
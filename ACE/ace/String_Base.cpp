@@ -7,7 +7,7 @@
 #include "ace/Auto_Ptr.h"
 #include "ace/OS_NS_string.h"
 
-#include <algorithm>  // For std::swap<>
+#include <algorithm>  // For std::swap<> and std::swap_ranges<>
 
 #if !defined (__ACE_INLINE__)
 #include "ace/String_Base.inl"
@@ -97,6 +97,32 @@ ACE_String_Base<ACE_CHAR_T>::ACE_String_Base (const ACE_String_Base<ACE_CHAR_T>
   this->set (s.rep_, s.len_, true);
 }
 
+#if defined (ACE_HAS_CPP11)
+// Move constructor.
+
+template <class ACE_CHAR_T>
+ACE_String_Base<ACE_CHAR_T>::ACE_String_Base (ACE_String_Base<ACE_CHAR_T> &&s)
+  : allocator_ (s.allocator_),
+    len_ (s.len_),
+    buf_len_ (s.buf_len_),
+    rep_ (s.rep_),
+    release_ (s.release_)
+{
+  ACE_TRACE ("ACE_String_Base<ACE_CHAR_T>::ACE_String_Base");
+
+  // An inline buffer can't be taken over, only copied.
+  if (s.is_inline ())
+    {
+      ACE_OS::memcpy (this->inline_buf_,
+                      s.inline_buf_,
+                      sizeof (this->inline_buf_));
+      this->rep_ = this->inline_buf_;
+    }
+
+  s.reset_rep ();
+}
+#endif /* ACE_HAS_CPP11 */
+
 template <class ACE_CHAR_T>
 ACE_String_Base<ACE_CHAR_T>::ACE_String_Base (
   typename ACE_String_Base<ACE_CHAR_T>::size_type len,
@@ -118,8 +144,7 @@ ACE_String_Base<ACE_CHAR_T>::~ACE_String_Base (void)
 {
   ACE_TRACE ("ACE_String_Base<ACE_CHAR_T>::~ACE_String_Base");
 
-  if (this->buf_len_ != 0 && this->release_)
-      this->allocator_->free (this->rep_);
+  this->free_rep ();
 }
 
 // this method might benefit from a little restructuring.
@@ -132,12 +157,16 @@ ACE_String_Base<ACE_CHAR_T>::set (const ACE_CHAR_T *s,
   size_type new_buf_len = len + 1;
   if (s != 0 && len != 0 && release && this->buf_len_ < new_buf_len)
     {
-      ACE_CHAR_T *temp = 0;
-      ACE_ALLOCATOR (temp,
-                     (ACE_CHAR_T *) this->allocator_->malloc (new_buf_len * sizeof (ACE_CHAR_T)));
+      // Short strings go to the inline buffer, which can't be the
+      // current one since that would be big enough.
+      ACE_CHAR_T *temp = this->inline_buf_;
+      if (new_buf_len > INLINE_SIZE)
+        ACE_ALLOCATOR (temp,
+                       (ACE_CHAR_T *) this->allocator_->malloc (new_buf_len * sizeof (ACE_CHAR_T)));
+      else
+        new_buf_len = INLINE_SIZE;
 
-      if (this->buf_len_ != 0 && this->release_)
-        this->allocator_->free (this->rep_);
+      this->free_rep ();
 
       this->rep_ = temp;
       this->buf_len_ = new_buf_len;
@@ -151,19 +180,13 @@ ACE_String_Base<ACE_CHAR_T>::set (const ACE_CHAR_T *s,
       // Free memory if necessary and figure out future ownership
       if (!release || s == 0 || len == 0)
         {
-          if (this->buf_len_ != 0 && this->release_)
-            {
-              this->allocator_->free (this->rep_);
-              this->release_ = false;
-            }
+          this->free_rep ();
+          this->release_ = false;
         }
       // Populate data.
       if (s == 0 || len == 0)
         {
-          this->buf_len_ = 0;
-          this->len_ = 0;
-          this->rep_ = &ACE_String_Base<ACE_CHAR_T>::NULL_String_;
-          this->release_ = false;
+          this->reset_rep ();
         }
       else if (!release) // Note: No guarantee that rep_ is null terminated.
         {
@@ -222,21 +245,24 @@ ACE_String_Base<ACE_CHAR_T>::append (const ACE_CHAR_T* s,
     }
     else // case 2. Memory reallocation is needed
     {
-      const size_type new_buf_len =
+      size_type new_buf_len =
         ace_max(this->len_ + slen + 1, this->buf_len_ + this->buf_len_ / 2);
 
-      ACE_CHAR_T *t = 0;
+      // A string still short enough moves to the inline buffer.
+      ACE_CHAR_T *t = this->inline_buf_;
 
-      ACE_ALLOCATOR_RETURN (t,
-        (ACE_CHAR_T *) this->allocator_->malloc (new_buf_len * sizeof (ACE_CHAR_T)), *this);
+      if (new_buf_len > INLINE_SIZE)
+        ACE_ALLOCATOR_RETURN (t,
+          (ACE_CHAR_T *) this->allocator_->malloc (new_buf_len * sizeof (ACE_CHAR_T)), *this);
+      else
+        new_buf_len = INLINE_SIZE;
 
       // Copy memory from old string into new string.
       ACE_OS::memcpy (t, this->rep_, this->len_ * sizeof (ACE_CHAR_T));
 
       ACE_OS::memcpy (t + this->len_, s, slen * sizeof (ACE_CHAR_T));
 
-      if (this->buf_len_ != 0 && this->release_)
-        this->allocator_->free (this->rep_);
+      this->free_rep ();
 
       this->release_ = true;
       this->rep_ = t;
@@ -277,12 +303,19 @@ ACE_String_Base<ACE_CHAR_T>::fast_resize (size_t len)
   // Only reallocate if we don't have enough space...
   if (this->buf_len_ <= len)
     {
-      if (this->buf_len_ != 0 && this->release_)
-        this->allocator_->free (this->rep_);
+      this->free_rep ();
 
-      this->rep_ = static_cast<ACE_CHAR_T*>
-                     (this->allocator_->malloc ((len + 1) * sizeof (ACE_CHAR_T)));
-      this->buf_len_ = len + 1;
+      if (len < INLINE_SIZE)
+        {
+          this->rep_ = this->inline_buf_;
+          this->buf_len_ = INLINE_SIZE;
+        }
+      else
+        {
+          this->rep_ = static_cast<ACE_CHAR_T*>
+                         (this->allocator_->malloc ((len + 1) * sizeof (ACE_CHAR_T)));
+          this->buf_len_ = len + 1;
+        }
       this->release_ = true;
     }
   this->len_ = 0;
@@ -296,13 +329,8 @@ ACE_String_Base<ACE_CHAR_T>::clear (bool release)
   // This can't use set(), because that would free memory if release=false
   if (release)
   {
-    if (this->buf_len_ != 0 && this->release_)
-      this->allocator_->free (this->rep_);
-
-    this->rep_ = &ACE_String_Base<ACE_CHAR_T>::NULL_String_;
-    this->len_ = 0;
-    this->buf_len_ = 0;
-    this->release_ = false;
+    this->free_rep ();
+    this->reset_rep ();
   }
   else
     {
@@ -335,6 +363,37 @@ ACE_String_Base<ACE_CHAR_T>::operator= (const ACE_String_Base<ACE_CHAR_T> &s)
   return *this;
 }
 
+#if defined (ACE_HAS_CPP11)
+// Move assignment operator.
+template <class ACE_CHAR_T> ACE_String_Base<ACE_CHAR_T> &
+ACE_String_Base<ACE_CHAR_T>::operator= (ACE_String_Base<ACE_CHAR_T> &&s)
+{
+  ACE_TRACE ("ACE_String_Base<ACE_CHAR_T>::operator=");
+
+  if (this != &s)
+    {
+      // The buffer can only be taken over if our allocator can free
+      // it, and an inline one is copied anyway.
+      if (this->allocator_ == s.allocator_ && !s.is_inline ())
+        {
+          this->free_rep ();
+          this->len_ = s.len_;
+          this->buf_len_ = s.buf_len_;
+          this->rep_ = s.rep_;
+          this->release_ = s.release_;
+          s.reset_rep ();
+        }
+      else
+        {
+          this->set (s.rep_, s.len_, true);
+          s.clear (true);
+        }
+    }
+
+  return *this;
+}
+#endif /* ACE_HAS_CPP11 */
+
 template <class ACE_CHAR_T> void
 ACE_String_Base<ACE_CHAR_T>::set (const ACE_CHAR_T *s, bool release)
 {
@@ -469,11 +528,27 @@ ACE_String_Base<ACE_CHAR_T>::rfind (
 template <class ACE_CHAR_T> void
 ACE_String_Base<ACE_CHAR_T>::swap (ACE_String_Base<ACE_CHAR_T> & str)
 {
+  bool const this_inline = this->is_inline ();
+  bool const str_inline = str.is_inline ();
+
   std::swap (this->allocator_ , str.allocator_);
   std::swap (this->len_       , str.len_);
   std::swap (this->buf_len_   , str.buf_len_);
   std::swap (this->rep_       , str.rep_);
   std::swap (this->release_   , str.release_);
+
+  // Inline buffers stay with their objects, so swap their contents
+  // and point each string back at its own.
+  if (this_inline || str_inline)
+    {
+      std::swap_ranges (this->inline_buf_,
+                        this->inline_buf_ + INLINE_SIZE,
+                        str.inline_buf_);
+      if (str_inline)
+        this->rep_ = this->inline_buf_;
+      if (this_inline)
+        str.rep_ = str.inline_buf_;
+    }
 }
 
 // ----------------------------------------------
@@ -23,6 +23,15 @@
 #include "ace/String_Base_Const.h"
 #include <iterator>
 
+/// Number of bytes that an ACE_String_Base keeps inside the object for
+/// short strings, including the terminating '\0', before it allocates
+/// through its ACE_Allocator.  Wide strings hold fewer characters in
+/// the same space.  The buffer holds at least one character; setting
+/// it to 1 makes every non-empty string use the allocator.
+#if !defined (ACE_STRING_BASE_INLINE_SIZE)
+# define ACE_STRING_BASE_INLINE_SIZE 24
+#endif /* ACE_STRING_BASE_INLINE_SIZE */
+
 ACE_BEGIN_VERSIONED_NAMESPACE_DECL
 
 // Forward decl.
@@ -50,6 +59,11 @@ class ACE_String_Base_Const_Iterator;
  * CAUTION: in cases when ACE_String_Base is constructed from a
  * provided buffer with the release parameter set to false,
  * ACE_String_Base is not guaranteed to be '\0' terminated.
+ * @note Strings that fit in ACE_STRING_BASE_INLINE_SIZE bytes
+ * (counting the '\0') are kept in a buffer inside the object and do
+ * not use the allocator at all.  A pointer returned by fast_rep() or
+ * c_str() of such a string is therefore invalidated when the string
+ * is destroyed, swapped or moved from, not only when it is changed.
  *
  * \li Do not use a "@c -1" magic number to refer to the "no position"
  *     condition.  This was never the right thing to do.  The "@c npos"
@@ -135,6 +149,16 @@ public:
    */
   ACE_String_Base (const ACE_String_Base < ACE_CHAR_T > &s);
 
+#if defined (ACE_HAS_CPP11)
+  /**
+   *  Move constructor.  Takes over the buffer of @a s, or copies it
+   *  when it is held inline, and leaves @a s empty.
+   *
+   *  @param s Input ACE_String_Base string to move from
+   */
+  ACE_String_Base (ACE_String_Base < ACE_CHAR_T > &&s);
+#endif /* ACE_HAS_CPP11 */
+
   /**
    *  Constructor that copies @a c into dynamically allocated memory.
    *
@@ -200,6 +224,18 @@ public:
    */
   ACE_String_Base < ACE_CHAR_T > &operator = (const ACE_String_Base < ACE_CHAR_T > &s);
 
+#if defined (ACE_HAS_CPP11)
+  /**
+   *  Move assignment operator.  Takes over the buffer of @a s when
+   *  both strings use the same allocator, copies it otherwise, and
+   *  leaves @a s empty.
+   *
+   *  @param s Input ACE_String_Base string to move from.
+   *  @return Return this string.
+   */
+  ACE_String_Base < ACE_CHAR_T > &operator = (ACE_String_Base < ACE_CHAR_T > &&s);
+#endif /* ACE_HAS_CPP11 */
+
   /**
    *  Assignment alternative method (does not copy memory).
    *
@@ -558,6 +594,16 @@ public:
   ACE_ALLOC_HOOK_DECLARE;
 
 protected:
+  /// True if rep_ points at the inline buffer.
+  bool is_inline (void) const;
+
+  /// Free rep_ if this string allocated it.
+  void free_rep (void);
+
+  /// Leave the string empty, using the NULL_String_, without freeing
+  /// anything.
+  void reset_rep (void);
+
   /**
    *  Pointer to a memory allocator.
    */
@@ -580,10 +626,24 @@ protected:
   ACE_CHAR_T *rep_;
 
   /**
-   *  Flag that indicates if we own the memory
+   *  Flag that indicates if we own the memory.  It is also set when
+   *  rep_ points at inline_buf_, which is never freed.
    */
   bool release_;
 
+  /// Number of characters of inline_buf_.
+  enum
+  {
+    INLINE_SIZE = ACE_STRING_BASE_INLINE_SIZE < sizeof (ACE_CHAR_T)
+      ? 1
+      : ACE_STRING_BASE_INLINE_SIZE / sizeof (ACE_CHAR_T)
+  };
+
+  /**
+   *  Buffer for short strings, used instead of allocating one.
+   */
+  ACE_CHAR_T inline_buf_[INLINE_SIZE];
+
   /**
    *  Represents the "NULL" string to simplify the internal logic.
    */
@@ -14,6 +14,28 @@ ACE_String_Base<ACE_CHAR_T>::dump (void) const
 #endif /* ACE_HAS_DUMP */
 }
 
+template <class ACE_CHAR_T> ACE_INLINE bool
+ACE_String_Base<ACE_CHAR_T>::is_inline (void) const
+{
+  return this->rep_ == this->inline_buf_;
+}
+
+template <class ACE_CHAR_T> ACE_INLINE void
+ACE_String_Base<ACE_CHAR_T>::free_rep (void)
+{
+  if (this->buf_len_ != 0 && this->release_ && !this->is_inline ())
+    this->allocator_->free (this->rep_);
+}
+
+template <class ACE_CHAR_T> ACE_INLINE void
+ACE_String_Base<ACE_CHAR_T>::reset_rep (void)
+{
+  this->len_ = 0;
+  this->buf_len_ = 0;
+  this->rep_ = &ACE_String_Base<ACE_CHAR_T>::NULL_String_;
+  this->release_ = false;
+}
+
 // Assignment method (does not copy memory)
 template <class ACE_CHAR_T> ACE_INLINE ACE_String_Base<ACE_CHAR_T> &
 ACE_String_Base<ACE_CHAR_T>::assign_nocopy (const ACE_String_Base<ACE_CHAR_T> &s)
@@ -0,0 +1,496 @@
+#include "ace/Thread_Cached_Allocator.h"
+#include "ace/CDR_Base.h"
+#include "ace/Guard_T.h"
+#include "ace/Log_Category.h"
+#include "ace/Malloc.h"
+#include "ace/Thread.h"
+#include "ace/OS_Memory.h"
+#include "ace/OS_NS_string.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace
+{
+  /// Every block starts with the index of its size class, in a header
+  /// that keeps the rest of the block aligned.
+  size_t const ace_thread_cached_header =
+    ACE_MALLOC_ROUNDUP (sizeof (size_t), ACE_MALLOC_ALIGN);
+
+  /// Bounds on the number of blocks in a magazine.
+  size_t const ace_thread_cached_min_rounds = 2;
+  size_t const ace_thread_cached_max_rounds = 64;
+
+  /// Get a block of class @a c, with @a size bytes after the header,
+  /// from the system.
+  void *
+  ace_thread_cached_new_block (size_t c, size_t size)
+  {
+    void *block = ACE_OS::malloc (ace_thread_cached_header + size);
+    if (block != 0)
+      *static_cast<size_t *> (block) = c;
+    return block;
+  }
+}
+
+/// A stack of free blocks of one size class; the blocks point to
+/// their header.
+struct ACE_Thread_Cached_Allocator::Magazine
+{
+  Magazine *next_;
+  size_t rounds_;
+  void *blocks_[1];
+};
+
+/**
+ * The magazines of one thread: for each size class, the one it
+ * allocates from and frees to, and the previous one, which is either
+ * full or empty.
+ */
+class ACE_Thread_Cached_Allocator_Cache
+{
+public:
+  ACE_Thread_Cached_Allocator_Cache (ACE_Thread_Cached_Allocator *owner)
+    : owner_ (owner),
+      next_ (0)
+  {
+    for (size_t c = 0; c < ACE_Thread_Cached_Allocator::MAX_CLASSES; ++c)
+      {
+        this->loaded_[c] = 0;
+        this->previous_[c] = 0;
+      }
+  }
+
+  /// Give the magazines back to the owner, and delete this cache.
+  void release (void)
+  {
+    this->owner_->release (this);
+  }
+
+  ACE_Thread_Cached_Allocator *owner_;
+
+  ACE_Thread_Cached_Allocator::Magazine *
+    loaded_[ACE_Thread_Cached_Allocator::MAX_CLASSES];
+  ACE_Thread_Cached_Allocator::Magazine *
+    previous_[ACE_Thread_Cached_Allocator::MAX_CLASSES];
+
+  ACE_Thread_Cached_Allocator_Cache *next_;
+};
+
+#if defined (ACE_HAS_THREADS)
+
+# if defined (ACE_HAS_THR_C_DEST)
+#   define LOCAL_EXTERN_PREFIX extern "C"
+# else
+#   define LOCAL_EXTERN_PREFIX
+# endif /* ACE_HAS_THR_C_DEST */
+
+/// Called when a thread that used the allocator exits.
+LOCAL_EXTERN_PREFIX
+void
+ACE_Thread_Cached_Allocator_cleanup (void *ptr)
+{
+  if (ptr != 0)
+    static_cast<ACE_Thread_Cached_Allocator_Cache *> (ptr)->release ();
+}
+
+#endif /* ACE_HAS_THREADS */
+
+ACE_ALLOC_HOOK_DEFINE(ACE_Thread_Cached_Allocator)
+
+ACE_Thread_Cached_Allocator::ACE_Thread_Cached_Allocator (
+    size_t depot_magazines)
+  : n_classes_ (0),
+    depot_magazines_ (depot_magazines),
+    caches_ (0)
+#if defined (ACE_HAS_THREADS)
+  , key_created_ (false)
+#endif /* ACE_HAS_THREADS */
+{
+  // Small classes for the message and data blocks, then the sizes of
+  // the buffers ACE_CDR allocates while it doubles them.
+  for (size_t size = 32; size <= 256; size *= 2)
+    this->sizes_[this->n_classes_++] = size;
+
+  for (size_t size = ACE_CDR::DEFAULT_BUFSIZE;
+       size <= ACE_CDR::EXP_GROWTH_MAX && this->n_classes_ < MAX_CLASSES;
+       size *= 2)
+    if (size + ACE_CDR::MAX_ALIGNMENT > this->sizes_[this->n_classes_ - 1])
+      this->sizes_[this->n_classes_++] = size + ACE_CDR::MAX_ALIGNMENT;
+
+  for (size_t c = 0; c < this->n_classes_; ++c)
+    {
+      size_t rounds =
+        ACE_DEFAULT_THREAD_CACHED_ALLOCATOR_MAGAZINE / this->sizes_[c];
+      if (rounds < ace_thread_cached_min_rounds)
+        rounds = ace_thread_cached_min_rounds;
+      else if (rounds > ace_thread_cached_max_rounds)
+        rounds = ace_thread_cached_max_rounds;
+      this->rounds_[c] = rounds;
+
+      this->depots_[c].full_ = 0;
+      this->depots_[c].empty_ = 0;
+      this->depots_[c].n_full_ = 0;
+    }
+
+#if defined (ACE_HAS_THREADS)
+  if (ACE_Thread::keycreate (&this->key_,
+                             &ACE_Thread_Cached_Allocator_cleanup) == 0)
+    this->key_created_ = true;
+#endif /* ACE_HAS_THREADS */
+}
+
+ACE_Thread_Cached_Allocator::~ACE_Thread_Cached_Allocator (void)
+{
+#if defined (ACE_HAS_THREADS)
+  // Once the key is gone, exiting threads no longer touch their cache.
+  if (this->key_created_)
+    ACE_Thread::keyfree (this->key_);
+#endif /* ACE_HAS_THREADS */
+
+  {
+    // A thread that exited just before the key was freed may still be
+    // releasing its cache.
+    ACE_GUARD (ACE_SYNCH_MUTEX, ace_mon, this->caches_lock_);
+    while (this->caches_ != 0)
+      {
+        Cache *cache = this->caches_;
+        this->caches_ = cache->next_;
+        for (size_t c = 0; c < this->n_classes_; ++c)
+          {
+            this->free_magazine (cache->loaded_[c]);
+            this->free_magazine (cache->previous_[c]);
+          }
+        delete cache;
+      }
+  }
+
+  for (size_t c = 0; c < this->n_classes_; ++c)
+    {
+      Depot &depot = this->depots_[c];
+      ACE_GUARD (ACE_SYNCH_MUTEX, ace_mon, depot.lock_);
+      while (depot.full_ != 0)
+        {
+          Magazine *const magazine = depot.full_;
+          depot.full_ = magazine->next_;
+          this->free_magazine (magazine);
+        }
+      while (depot.empty_ != 0)
+        {
+          Magazine *const magazine = depot.empty_;
+          depot.empty_ = magazine->next_;
+          this->free_magazine (magazine);
+        }
+    }
+}
+
+void *
+ACE_Thread_Cached_Allocator::malloc (size_t nbytes)
+{
+  size_t c = 0;
+  while (c < this->n_classes_ && this->sizes_[c] < nbytes)
+    ++c;
+
+  void *block = 0;
+  if (c == this->n_classes_)
+    block = ace_thread_cached_new_block (MAX_CLASSES, nbytes);
+  else
+    {
+      Cache *const cache = this->cache ();
+      Magazine *const loaded = cache != 0 ? cache->loaded_[c] : 0;
+      if (loaded != 0 && loaded->rounds_ > 0)
+        block = loaded->blocks_[--loaded->rounds_];
+      else if (cache != 0)
+        block = this->refill (*cache, c);
+
+      if (block == 0)
+        block = ace_thread_cached_new_block (c, this->sizes_[c]);
+    }
+
+  if (block == 0)
+    {
+      errno = ENOMEM;
+      return 0;
+    }
+
+  return static_cast<char *> (block) + ace_thread_cached_header;
+}
+
+void *
+ACE_Thread_Cached_Allocator::calloc (size_t nbytes, char initial_value)
+{
+  void *ptr = this->malloc (nbytes);
+  if (ptr != 0)
+    ACE_OS::memset (ptr, initial_value, nbytes);
+  return ptr;
+}
+
+void *
+ACE_Thread_Cached_Allocator::calloc (size_t n_elem,
+                                     size_t elem_size,
+                                     char initial_value)
+{
+  return this->calloc (n_elem * elem_size, initial_value);
+}
+
+void
+ACE_Thread_Cached_Allocator::free (void *ptr)
+{
+  if (ptr == 0)
+    return;
+
+  void *const block = static_cast<char *> (ptr) - ace_thread_cached_header;
+  size_t const c = *static_cast<size_t *> (block);
+  Cache *const cache = c < this->n_classes_ ? this->cache () : 0;
+  if (cache == 0)
+    {
+      ACE_OS::free (block);
+      return;
+    }
+
+  Magazine *const loaded = cache->loaded_[c];
+  if (loaded != 0 && loaded->rounds_ < this->rounds_[c])
+    loaded->blocks_[loaded->rounds_++] = block;
+  else
+    this->spill (*cache, c, block);
+}
+
+// Returns the cache of the calling thread, creating it on the first
+// call.
+
+ACE_Thread_Cached_Allocator::Cache *
+ACE_Thread_Cached_Allocator::cache (void)
+{
+#if defined (ACE_HAS_THREADS)
+  if (!this->key_created_)
+    return 0;
+
+  void *ptr = 0;
+  if (ACE_Thread::getspecific (this->key_, &ptr) == -1)
+    return 0;
+
+  if (ptr != 0)
+    return static_cast<Cache *> (ptr);
+#else
+  if (this->caches_ != 0)
+    return this->caches_;
+#endif /* ACE_HAS_THREADS */
+
+  Cache *cache = 0;
+  ACE_NEW_RETURN (cache, Cache (this), 0);
+
+#if defined (ACE_HAS_THREADS)
+  if (ACE_Thread::setspecific (this->key_, cache) == -1)
+    {
+      delete cache;
+      return 0;
+    }
+#endif /* ACE_HAS_THREADS */
+
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->caches_lock_, cache);
+  cache->next_ = this->caches_;
+  this->caches_ = cache;
+  return cache;
+}
+
+// Returns the magazines of an exiting thread to the depots, and
+// deletes its cache.
+
+void
+ACE_Thread_Cached_Allocator::release (Cache *cache)
+{
+  {
+    ACE_GUARD (ACE_SYNCH_MUTEX, ace_mon, this->caches_lock_);
+    for (Cache **c = &this->caches_; *c != 0; c = &(*c)->next_)
+      if (*c == cache)
+        {
+          *c = cache->next_;
+          break;
+        }
+  }
+
+  for (size_t c = 0; c < this->n_classes_; ++c)
+    {
+      Depot &depot = this->depots_[c];
+      Magazine *magazines[] = { cache->loaded_[c], cache->previous_[c] };
+      for (size_t i = 0; i < 2; ++i)
+        {
+          Magazine *const magazine = magazines[i];
+          if (magazine == 0)
+            continue;
+
+          // Partly used magazines can't go to the depot.
+          bool const full = magazine->rounds_ == this->rounds_[c];
+          if (magazine->rounds_ == 0 || full)
+            {
+              ACE_GUARD (ACE_SYNCH_MUTEX, ace_mon, depot.lock_);
+              if (!full)
+                {
+                  magazine->next_ = depot.empty_;
+                  depot.empty_ = magazine;
+                  continue;
+                }
+              if (depot.n_full_ < this->depot_magazines_)
+                {
+                  magazine->next_ = depot.full_;
+                  depot.full_ = magazine;
+                  ++depot.n_full_;
+                  continue;
+                }
+            }
+          this->free_magazine (magazine);
+        }
+    }
+
+  delete cache;
+}
+
+// Called when both magazines of class <c> of <cache> are empty: takes a
+// full magazine from the depot and returns one of its blocks, or 0 if
+// there is none.
+
+void *
+ACE_Thread_Cached_Allocator::refill (Cache &cache, size_t c)
+{
+  Magazine *&loaded = cache.loaded_[c];
+  Magazine *&previous = cache.previous_[c];
+
+  if (previous != 0 && previous->rounds_ > 0)
+    {
+      Magazine *const full = previous;
+      previous = loaded;
+      loaded = full;
+      return loaded->blocks_[--loaded->rounds_];
+    }
+
+  Depot &depot = this->depots_[c];
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, depot.lock_, 0);
+  if (depot.full_ == 0)
+    return 0;
+
+  Magazine *const full = depot.full_;
+  depot.full_ = full->next_;
+  --depot.n_full_;
+
+  if (previous != 0)
+    {
+      previous->next_ = depot.empty_;
+      depot.empty_ = previous;
+    }
+  previous = loaded;
+  loaded = full;
+  return loaded->blocks_[--loaded->rounds_];
+}
+
+// Called when both magazines of class <c> of <cache> are full: moves
+// the previous one to the depot, loads an empty one and stores <block>
+// in it.
+
+void
+ACE_Thread_Cached_Allocator::spill (Cache &cache, size_t c, void *block)
+{
+  Magazine *&loaded = cache.loaded_[c];
+  Magazine *&previous = cache.previous_[c];
+
+  if (previous != 0 && previous->rounds_ < this->rounds_[c])
+    {
+      Magazine *const empty = previous;
+      previous = loaded;
+      loaded = empty;
+      loaded->blocks_[loaded->rounds_++] = block;
+      return;
+    }
+
+  Magazine *empty = 0;
+  Magazine *excess = 0;
+  {
+    Depot &depot = this->depots_[c];
+    ACE_GUARD (ACE_SYNCH_MUTEX, ace_mon, depot.lock_);
+    if (previous != 0)
+      {
+        if (depot.n_full_ < this->depot_magazines_)
+          {
+            previous->next_ = depot.full_;
+            depot.full_ = previous;
+            ++depot.n_full_;
+          }
+        else
+          excess = previous;
+      }
+    if (depot.empty_ != 0)
+      {
+        empty = depot.empty_;
+        depot.empty_ = empty->next_;
+      }
+  }
+
+  // The depot holds enough blocks already; give these back to the
+  // system and reuse the magazine.
+  if (excess != 0)
+    {
+      while (excess->rounds_ > 0)
+        ACE_OS::free (excess->blocks_[--excess->rounds_]);
+      if (empty == 0)
+        empty = excess;
+      else
+        this->free_magazine (excess);
+    }
+
+  if (empty == 0)
+    empty = this->new_magazine (c);
+
+  previous = loaded;
+  loaded = empty;
+  if (loaded == 0)
+    ACE_OS::free (block);
+  else
+    loaded->blocks_[loaded->rounds_++] = block;
+}
+
+// Returns a new, empty magazine for class <c>.
+
+ACE_Thread_Cached_Allocator::Magazine *
+ACE_Thread_Cached_Allocator::new_magazine (size_t c)
+{
+  void *ptr = ACE_OS::malloc (sizeof (Magazine)
+                              + (this->rounds_[c] - 1) * sizeof (void *));
+  if (ptr == 0)
+    return 0;
+
+  Magazine *const magazine = static_cast<Magazine *> (ptr);
+  magazine->next_ = 0;
+  magazine->rounds_ = 0;
+  return magazine;
+}
+
+// Gives <magazine> and the blocks it holds back to the system.
+
+void
+ACE_Thread_Cached_Allocator::free_magazine (Magazine *magazine)
+{
+  if (magazine == 0)
+    return;
+
+  while (magazine->rounds_ > 0)
+    ACE_OS::free (magazine->blocks_[--magazine->rounds_]);
+  ACE_OS::free (magazine);
+}
+
+void
+ACE_Thread_Cached_Allocator::dump (void) const
+{
+#if defined (ACE_HAS_DUMP)
+  ACE_TRACE ("ACE_Thread_Cached_Allocator::dump");
+
+  ACELIB_DEBUG ((LM_DEBUG, ACE_BEGIN_DUMP, this));
+  for (size_t c = 0; c < this->n_classes_; ++c)
+    ACELIB_DEBUG ((LM_DEBUG,
+                   ACE_TEXT ("\nsize = %B, rounds = %B, depot = %B"),
+                   this->sizes_[c],
+                   this->rounds_[c],
+                   this->depots_[c].n_full_));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_TEXT ("\n")));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_END_DUMP));
+#endif /* ACE_HAS_DUMP */
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,154 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    Thread_Cached_Allocator.h
+ *
+ *  Allocator that keeps a cache of free blocks per thread.
+ */
+//=============================================================================
+
+#ifndef ACE_THREAD_CACHED_ALLOCATOR_H
+#define ACE_THREAD_CACHED_ALLOCATOR_H
+#include /**/ "ace/pre.h"
+
+#include "ace/Malloc_Allocator.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "ace/Synch_Traits.h"
+#include "ace/Thread_Mutex.h"
+#include "ace/OS_NS_Thread.h"
+
+#if !defined (ACE_DEFAULT_THREAD_CACHED_ALLOCATOR_MAGAZINE)
+#define ACE_DEFAULT_THREAD_CACHED_ALLOCATOR_MAGAZINE 16384 /* Bytes */
+#endif /* ACE_DEFAULT_THREAD_CACHED_ALLOCATOR_MAGAZINE */
+
+#if !defined (ACE_DEFAULT_THREAD_CACHED_ALLOCATOR_DEPOT)
+#define ACE_DEFAULT_THREAD_CACHED_ALLOCATOR_DEPOT 16 /* Magazines */
+#endif /* ACE_DEFAULT_THREAD_CACHED_ALLOCATOR_DEPOT */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+class ACE_Thread_Cached_Allocator_Cache;
+
+/**
+ * @class ACE_Thread_Cached_Allocator
+ *
+ * @brief A size-based allocator that caches free blocks per thread.
+ *
+ * Requests are rounded up to a size class: a few small ones for
+ * ACE_Message_Block and ACE_Data_Block objects, and the sizes ACE_CDR
+ * grows its buffers to, from ACE_CDR::DEFAULT_BUFSIZE up to
+ * ACE_CDR::EXP_GROWTH_MAX.  Larger requests go straight to
+ * ACE_OS::malloc().
+ *
+ * The free blocks of each class are kept in magazines, small stacks of
+ * up to ACE_DEFAULT_THREAD_CACHED_ALLOCATOR_MAGAZINE bytes.  Every
+ * thread holds two magazines per class and allocates from and frees
+ * to them without any lock.  Only when both are empty, or both are
+ * full, does the thread exchange a magazine with the depot shared by
+ * all threads, under a lock per class, so the lock is taken once per
+ * magazine rather than once per block.  The depot keeps up to
+ * ACE_DEFAULT_THREAD_CACHED_ALLOCATOR_DEPOT full magazines per class;
+ * blocks beyond that are given back to the system.  A thread that
+ * exits returns its magazines to the depot.
+ *
+ * Blocks may be freed by a thread other than the one that allocated
+ * them.  The allocator is meant to be used for the ACE_Message_Block,
+ * ACE_Data_Block and buffer allocators of the message blocks that a
+ * multi-threaded server creates and releases for every message.
+ *
+ * @sa ACE_Dynamic_Cached_Allocator
+ */
+class ACE_Export ACE_Thread_Cached_Allocator : public ACE_New_Allocator
+{
+public:
+  /// Constructor; the depot keeps up to @a depot_magazines full
+  /// magazines per size class.
+  ACE_Thread_Cached_Allocator (
+    size_t depot_magazines = ACE_DEFAULT_THREAD_CACHED_ALLOCATOR_DEPOT);
+
+  /// Destructor; gives all the cached blocks back to the system.
+  virtual ~ACE_Thread_Cached_Allocator (void);
+
+  /// Get a block of at least @a nbytes bytes.
+  virtual void *malloc (size_t nbytes);
+
+  /// Get a block of at least @a nbytes bytes, set to @a initial_value.
+  virtual void *calloc (size_t nbytes, char initial_value = '\0');
+
+  /// Get a block for @a n_elem elements of @a elem_size bytes, set to
+  /// @a initial_value.
+  virtual void *calloc (size_t n_elem,
+                        size_t elem_size,
+                        char initial_value = '\0');
+
+  /// Return a block to the cache of the calling thread.
+  virtual void free (void *ptr);
+
+  /// Dump the state of the allocator.
+  virtual void dump (void) const;
+
+  ACE_ALLOC_HOOK_DECLARE;
+
+  /// Largest number of size classes.
+  enum { MAX_CLASSES = 16 };
+
+private:
+  friend class ACE_Thread_Cached_Allocator_Cache;
+  typedef ACE_Thread_Cached_Allocator_Cache Cache;
+  struct Magazine;
+
+  // The following are documented in the .cpp file.
+  Cache *cache (void);
+  void release (Cache *cache);
+  void *refill (Cache &cache, size_t c);
+  void spill (Cache &cache, size_t c, void *block);
+  Magazine *new_magazine (size_t c);
+  void free_magazine (Magazine *magazine);
+
+  /// The magazines shared by all threads for one size class.
+  struct Depot
+  {
+    ACE_SYNCH_MUTEX lock_;
+    Magazine *full_;
+    Magazine *empty_;
+    size_t n_full_;
+  };
+
+  /// Size of the blocks of each class, not counting their header.
+  size_t sizes_[MAX_CLASSES];
+
+  /// Number of blocks in a full magazine of each class.
+  size_t rounds_[MAX_CLASSES];
+
+  /// Number of size classes.
+  size_t n_classes_;
+
+  /// Largest number of full magazines kept in a depot.
+  size_t depot_magazines_;
+
+  Depot depots_[MAX_CLASSES];
+
+  /// The caches of the threads that use the allocator.
+  Cache *caches_;
+  ACE_SYNCH_MUTEX caches_lock_;
+
+#if defined (ACE_HAS_THREADS)
+  /// Holds the cache of each thread.
+  ACE_thread_key_t key_;
+  bool key_created_;
+#endif /* ACE_HAS_THREADS */
+
+  // = Disallow these operations.
+  ACE_UNIMPLEMENTED_FUNC (ACE_Thread_Cached_Allocator (const ACE_Thread_Cached_Allocator &))
+  ACE_UNIMPLEMENTED_FUNC (void operator= (const ACE_Thread_Cached_Allocator &))
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#include /**/ "ace/post.h"
+#endif /* ACE_THREAD_CACHED_ALLOCATOR_H */
@@ -0,0 +1,838 @@
+#ifndef ACE_TIMER_HIERARCHICAL_WHEEL_T_CPP
+#define ACE_TIMER_HIERARCHICAL_WHEEL_T_CPP
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "ace/Timer_Hierarchical_Wheel_T.h"
+#include "ace/Guard_T.h"
+#include "ace/Log_Category.h"
+#include "ace/Numeric_Limits.h"
+#include "ace/OS_NS_string.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+// Design/implementation notes for ACE_Timer_Hierarchical_Wheel_T.
+//
+// Timer values are converted to ticks, counted from the epoch of the
+// time policy.  The wheel is positioned at current_tick_, which is
+// never later than the tick of any scheduled timer; a timer scheduled
+// for an earlier tick is treated as if it were due at current_tick_.
+// Each byte of the 64 bit tick count has a level of 256 slots.  A
+// timer is kept at the level of the highest byte in which its tick
+// differs from current_tick_ (level 0 if only the lowest byte
+// differs), in the slot given by the value of that byte.  Hence the
+// slots of a level that come before the slot of current_tick_ are
+// always empty, and the earliest timer is in the first occupied
+// slot of the lowest occupied level.  The lists of the slots are not
+// sorted, so a timer is scheduled by appending it to its list.
+//
+// All the timers in a slot of level 0 are due in the same tick.  Once
+// the current time is past that tick they have all expired, and
+// dispatch_info_i() takes them off the slot in list order, without
+// looking for the earliest one; only the slot of the tick of the
+// current time is searched for the timers that are due.  Timers due
+// in the same tick are thus not dispatched in the order of their
+// timer values.  get_first(), earliest_time() and remove_first() do
+// search the slot, which costs O(k) for the k timers of that slot.
+//
+// The wheel is only moved forward, up to the current time or to the
+// earliest timer, whichever comes first.  Moving it from one tick to
+// a later one only changes the level of the timers in the slot that
+// the new tick selects at the highest level where the two ticks
+// differ; these are reinserted ("cascaded").  The levels below are
+// empty at that point, since their timers would have expired before
+// the new tick.
+//
+// Timer nodes are allocated in slabs.  The id of a timer is the index
+// of its node in the slabs, so cancel() finds it without a search.
+// The timer_id of a node that is not in use holds -(index + 1), and a
+// node taken off the wheel by remove_first() keeps its id but has no
+// <next> until it is rescheduled or freed.
+
+// Index of the lowest bit set in a non-zero word.
+inline u_int
+ACE_HWHEEL_LOWEST_BIT (ACE_UINT64 bits)
+{
+#if defined (__GNUC__)
+  return static_cast<u_int> (__builtin_ctzll (bits));
+#else
+  u_int n = 0;
+  while ((bits & 0xff) == 0)
+    {
+      bits >>= 8;
+      n += 8;
+    }
+  while ((bits & 1) == 0)
+    {
+      bits >>= 1;
+      ++n;
+    }
+  return n;
+#endif /* __GNUC__ */
+}
+
+// Slot of @a tick at @a level.
+inline u_int
+ACE_HWHEEL_SLOT (ACE_UINT64 tick, u_int level)
+{
+  return static_cast<u_int> ((tick >> (level * 8)) & 0xff);
+}
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY>
+ACE_Timer_Hierarchical_Wheel_Iterator_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::ACE_Timer_Hierarchical_Wheel_Iterator_T (Wheel& wheel)
+  : timer_wheel_ (wheel),
+    level_ (0),
+    slot_ (0),
+    current_node_ (0)
+{
+  this->first ();
+}
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY>
+ACE_Timer_Hierarchical_Wheel_Iterator_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::~ACE_Timer_Hierarchical_Wheel_Iterator_T (void)
+{
+}
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_Iterator_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::first (void)
+{
+  this->goto_next (0, 0);
+}
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_Iterator_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::next (void)
+{
+  if (this->current_node_ == 0)
+    return;
+
+  ACE_Timer_Node_T<TYPE>* n = this->current_node_->get_next ();
+  if (n != this->timer_wheel_.slots_[this->level_][this->slot_])
+    this->current_node_ = n;
+  else
+    this->goto_next (this->level_, this->slot_ + 1);
+}
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_Iterator_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::goto_next (u_int level, u_int slot)
+{
+  for (; level < Wheel::LEVELS; ++level, slot = 0)
+    {
+      int const next = this->timer_wheel_.next_slot (level, slot);
+      if (next >= 0)
+        {
+          this->level_ = level;
+          this->slot_ = static_cast<u_int> (next);
+          this->current_node_ = this->timer_wheel_.slots_[level][next];
+          return;
+        }
+    }
+
+  this->current_node_ = 0;
+}
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> bool
+ACE_Timer_Hierarchical_Wheel_Iterator_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::isdone (void) const
+{
+  return this->current_node_ == 0;
+}
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> ACE_Timer_Node_T<TYPE>*
+ACE_Timer_Hierarchical_Wheel_Iterator_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::item (void)
+{
+  return this->current_node_;
+}
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY>
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::ACE_Timer_Hierarchical_Wheel_T
+(u_int resolution,
+ size_t prealloc,
+ FUNCTOR* upcall_functor,
+ TIME_POLICY const & time_policy)
+  : Base_Timer_Queue (upcall_functor, 0, time_policy),
+    resolution_ (resolution == 0 ? 1 : resolution),
+    current_tick_ (0),
+    timer_count_ (0),
+    earliest_ (0),
+    slabs_ (0),
+    slab_count_ (0),
+    slab_max_ (0),
+    slab_size_ (prealloc > 0
+                ? prealloc
+                : ACE_DEFAULT_TIMER_HIERARCHICAL_WHEEL_SLAB),
+    free_head_ (0),
+    free_tail_ (0),
+    iterator_ (0)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::ACE_Timer_Hierarchical_Wheel_T");
+
+  ACE_OS::memset (this->slots_, 0, sizeof this->slots_);
+  ACE_OS::memset (this->occupied_, 0, sizeof this->occupied_);
+
+  if (prealloc > 0)
+    this->grow ();
+
+  ACE_NEW (iterator_, Iterator (*this));
+}
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY>
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::~ACE_Timer_Hierarchical_Wheel_T (void)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::~ACE_Timer_Hierarchical_Wheel_T");
+
+  this->close ();
+
+  delete this->iterator_;
+
+  for (size_t i = 0; i < this->slab_count_; ++i)
+    delete [] this->slabs_[i];
+  delete [] this->slabs_;
+}
+
+/// Convert @a time to a tick count; times that don't fit are
+/// clamped.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> ACE_UINT64
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::to_tick (const ACE_Time_Value& time) const
+{
+  if (time < ACE_Time_Value::zero)
+    return 0;
+
+  ACE_UINT64 const sec = static_cast<ACE_UINT64> (time.sec ());
+  if (sec >= ACE_UINT64_MAX / ACE_ONE_SECOND_IN_USECS)
+    return ACE_UINT64_MAX / this->resolution_;
+
+  return (sec * ACE_ONE_SECOND_IN_USECS + time.usec ()) / this->resolution_;
+}
+
+/// The tick at which the wheel holds @a n, i.e. the tick of its
+/// timer value or <current_tick_> if that is later.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> ACE_UINT64
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::node_tick (ACE_Timer_Node_T<TYPE>* n) const
+{
+  ACE_UINT64 const tick = this->to_tick (n->get_timer_value ());
+  return tick > this->current_tick_ ? tick : this->current_tick_;
+}
+
+/// The level at which a timer due at @a tick is kept.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> u_int
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::level_of (ACE_UINT64 tick) const
+{
+  u_int level = 0;
+  for (ACE_UINT64 diff = (tick ^ this->current_tick_) >> SLOT_BITS;
+       diff != 0;
+       diff >>= SLOT_BITS)
+    ++level;
+  return level;
+}
+
+/// Returns the first occupied slot of @a level at or after @a slot,
+/// or -1 if there is none.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> int
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::next_slot (u_int level, u_int slot) const
+{
+  for (u_int word = slot / 64; word < SLOTS / 64; ++word)
+    {
+      ACE_UINT64 bits = this->occupied_[level][word];
+      if (word == slot / 64)
+        bits &= ACE_UINT64_MAX << (slot % 64);
+      if (bits != 0)
+        return static_cast<int> (word * 64 + ACE_HWHEEL_LOWEST_BIT (bits));
+    }
+  return -1;
+}
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> bool
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::is_empty (void) const
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::is_empty");
+  return this->timer_count_ == 0;
+}
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> const ACE_Time_Value &
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::earliest_time (void) const
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::earliest_time");
+  return this->get_first_i ()->get_timer_value ();
+}
+
+/// Returns the first occupied slot of the wheel, at the lowest
+/// occupied level, in @a level and @a slot, or -1 if the wheel is
+/// empty.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> int
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::first_slot (u_int &level, u_int &slot) const
+{
+  int found = this->next_slot (0, ACE_HWHEEL_SLOT (this->current_tick_, 0));
+  level = 0;
+
+  while (found < 0 && ++level < LEVELS)
+    found = this->next_slot (level,
+                             ACE_HWHEEL_SLOT (this->current_tick_, level) + 1);
+
+  if (found < 0)
+    return -1;
+
+  slot = static_cast<u_int> (found);
+  return 0;
+}
+
+/// Find the earliest node, using the cached one if there is one.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> ACE_Timer_Node_T<TYPE>*
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::get_first_i (void) const
+{
+  if (this->earliest_ != 0 || this->timer_count_ == 0)
+    return this->earliest_;
+
+  u_int level = 0;
+  u_int slot = 0;
+  if (this->first_slot (level, slot) == -1)
+    return 0;
+
+  ACE_Timer_Node_T<TYPE>* const root = this->slots_[level][slot];
+  ACE_Timer_Node_T<TYPE>* first = root;
+  for (ACE_Timer_Node_T<TYPE>* n = root->get_next ();
+       n != root;
+       n = n->get_next ())
+    if (n->get_timer_value () < first->get_timer_value ())
+      first = n;
+
+  this->earliest_ = first;
+  return first;
+}
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> ACE_Timer_Node_T<TYPE>*
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::get_first (void)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::get_first");
+  return this->get_first_i ();
+}
+
+/// Find the node of a scheduled timer, or one that was removed by
+/// remove_first() and not freed yet.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> ACE_Timer_Node_T<TYPE>*
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::find_node (long timer_id) const
+{
+  if (timer_id < 0)
+    return 0;
+
+  size_t const index = static_cast<size_t> (timer_id);
+  size_t const slab = index / this->slab_size_;
+  if (slab >= this->slab_count_)
+    return 0;
+
+  ACE_Timer_Node_T<TYPE>* const n =
+    &this->slabs_[slab][index % this->slab_size_];
+  return n->get_timer_id () == timer_id ? n : 0;
+}
+
+/// Add @a n to the slot of its tick.  The caller accounts for the
+/// node in <timer_count_>.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::insert (ACE_Timer_Node_T<TYPE>* n)
+{
+  ACE_UINT64 const tick = this->node_tick (n);
+  u_int const level = this->level_of (tick);
+  u_int const slot = ACE_HWHEEL_SLOT (tick, level);
+  ACE_Timer_Node_T<TYPE>*& root = this->slots_[level][slot];
+
+  if (root == 0)
+    {
+      n->set_prev (n);
+      n->set_next (n);
+      root = n;
+      this->occupied_[level][slot / 64] |=
+        static_cast<ACE_UINT64> (1) << (slot % 64);
+    }
+  else
+    {
+      // Append to the tail.
+      ACE_Timer_Node_T<TYPE>* const tail = root->get_prev ();
+      n->set_prev (tail);
+      n->set_next (root);
+      tail->set_next (n);
+      root->set_prev (n);
+    }
+
+  if (this->earliest_ != 0
+      && n->get_timer_value () < this->earliest_->get_timer_value ())
+    this->earliest_ = n;
+}
+
+/// Take @a n off the wheel.  It keeps its timer id.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::unlink (ACE_Timer_Node_T<TYPE>* n)
+{
+  ACE_UINT64 const tick = this->node_tick (n);
+  u_int const level = this->level_of (tick);
+  u_int const slot = ACE_HWHEEL_SLOT (tick, level);
+  ACE_Timer_Node_T<TYPE>*& root = this->slots_[level][slot];
+
+  if (n->get_next () == n)
+    {
+      root = 0;
+      this->occupied_[level][slot / 64] &=
+        ~(static_cast<ACE_UINT64> (1) << (slot % 64));
+    }
+  else
+    {
+      n->get_prev ()->set_next (n->get_next ());
+      n->get_next ()->set_prev (n->get_prev ());
+      if (root == n)
+        root = n->get_next ();
+    }
+
+  n->set_prev (0);
+  n->set_next (0);
+  --this->timer_count_;
+
+  if (this->earliest_ == n)
+    this->earliest_ = 0;
+}
+
+/// Move the wheel forward to @a tick, which must not be later than
+/// the tick of any timer.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::advance (ACE_UINT64 tick)
+{
+  ACE_UINT64 diff = (this->current_tick_ ^ tick) >> SLOT_BITS;
+  this->current_tick_ = tick;
+
+  if (diff == 0)
+    return;
+
+  u_int level = 0;
+  for (; diff != 0; diff >>= SLOT_BITS)
+    ++level;
+
+  u_int const slot = ACE_HWHEEL_SLOT (tick, level);
+  ACE_Timer_Node_T<TYPE>* const root = this->slots_[level][slot];
+  if (root == 0)
+    return;
+
+  // Cascade the timers of the slot down to the lower levels.
+  this->slots_[level][slot] = 0;
+  this->occupied_[level][slot / 64] &=
+    ~(static_cast<ACE_UINT64> (1) << (slot % 64));
+  root->get_prev ()->set_next (0);
+
+  for (ACE_Timer_Node_T<TYPE>* n = root; n != 0; )
+    {
+      ACE_Timer_Node_T<TYPE>* const next = n->get_next ();
+      this->insert (n);
+      n = next;
+    }
+}
+
+/// Allocate a slab of nodes and add them to the free list.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> int
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::grow (void)
+{
+  size_t const first_id = this->slab_count_ * this->slab_size_;
+
+  // The timer ids must fit in a long.
+  if (first_id + this->slab_size_ - 1
+      > static_cast<size_t> (ACE_Numeric_Limits<long>::max ()))
+    return -1;
+
+  if (this->slab_count_ == this->slab_max_)
+    {
+      size_t const new_max = this->slab_max_ == 0 ? 16 : this->slab_max_ * 2;
+      ACE_Timer_Node_T<TYPE>** new_slabs = 0;
+      ACE_NEW_RETURN (new_slabs,
+                      ACE_Timer_Node_T<TYPE>*[new_max],
+                      -1);
+      if (this->slab_count_ > 0)
+        ACE_OS::memcpy (new_slabs,
+                        this->slabs_,
+                        this->slab_count_ * sizeof *new_slabs);
+      delete [] this->slabs_;
+      this->slabs_ = new_slabs;
+      this->slab_max_ = new_max;
+    }
+
+  ACE_Timer_Node_T<TYPE>* slab = 0;
+  ACE_NEW_RETURN (slab,
+                  ACE_Timer_Node_T<TYPE>[this->slab_size_],
+                  -1);
+  this->slabs_[this->slab_count_++] = slab;
+
+  for (size_t i = 0; i < this->slab_size_; ++i)
+    {
+      slab[i].set_timer_id (-static_cast<long> (first_id + i) - 1);
+      slab[i].set_next (i + 1 < this->slab_size_ ? &slab[i + 1] : 0);
+    }
+
+  if (this->free_tail_ == 0)
+    this->free_head_ = slab;
+  else
+    this->free_tail_->set_next (slab);
+  this->free_tail_ = &slab[this->slab_size_ - 1];
+
+  return 0;
+}
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> ACE_Timer_Node_T<TYPE> *
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::alloc_node (void)
+{
+  if (this->free_head_ == 0 && this->grow () == -1)
+    return 0;
+
+  ACE_Timer_Node_T<TYPE>* const n = this->free_head_;
+  this->free_head_ = n->get_next ();
+  if (this->free_head_ == 0)
+    this->free_tail_ = 0;
+
+  n->set_next (0);
+  n->set_timer_id (-n->get_timer_id () - 1);
+  return n;
+}
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::free_node (ACE_Timer_Node_T<TYPE> *n)
+{
+  // Append to the free list, so the timer id is reused as late as
+  // possible.
+  n->set_timer_id (-n->get_timer_id () - 1);
+  n->set_prev (0);
+  n->set_next (0);
+
+  if (this->free_tail_ == 0)
+    this->free_head_ = n;
+  else
+    this->free_tail_->set_next (n);
+  this->free_tail_ = n;
+}
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> long
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::schedule_i (const TYPE& type,
+                                                                        const void* act,
+                                                                        const ACE_Time_Value& future_time,
+                                                                        const ACE_Time_Value& interval)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::schedule_i");
+
+  ACE_Timer_Node_T<TYPE>* n = 0;
+  ACE_ALLOCATOR_RETURN (n,
+                        this->alloc_node (),
+                        -1);
+
+  if (this->timer_count_ == 0)
+    {
+      // Nothing holds the wheel back; move it to the current time so
+      // that the timers scheduled from now on start at the lowest
+      // levels.
+      ACE_UINT64 const now = this->to_tick (this->gettimeofday_static ());
+      ACE_UINT64 const tick = this->to_tick (future_time);
+      this->current_tick_ = tick < now ? tick : now;
+    }
+
+  long const timer_id = n->get_timer_id ();
+  n->set (type, act, future_time, interval, 0, 0, timer_id);
+
+  this->insert (n);
+  ++this->timer_count_;
+
+  return timer_id;
+}
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::reschedule (ACE_Timer_Node_T<TYPE>* n)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::reschedule");
+
+  this->insert (n);
+  ++this->timer_count_;
+}
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> int
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::dispatch_info_i (const ACE_Time_Value &cur_time,
+                                                                             ACE_Timer_Node_Dispatch_Info_T<TYPE> &info)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::dispatch_info_i");
+
+  u_int level = 0;
+  u_int slot = 0;
+  if (this->timer_count_ == 0 || this->first_slot (level, slot) == -1)
+    return 0;
+
+  // The tick of the first slot; on the upper levels that of its
+  // earliest timer.
+  ACE_UINT64 tick =
+    (this->current_tick_ & ~static_cast<ACE_UINT64> (SLOTS - 1)) | slot;
+  if (level != 0)
+    tick = this->node_tick (this->get_first_i ());
+
+  // Keep the wheel close to the current time even when no timer
+  // expires, so that new timers don't pile up on the upper levels.
+  ACE_UINT64 const now = this->to_tick (cur_time);
+  this->advance (now < tick ? (now > this->current_tick_ ? now : this->current_tick_)
+                            : tick);
+
+  // Timers scheduled for a time before <current_tick_> are kept at
+  // <current_tick_>, and may have expired even if <now> is earlier.
+  if (now < tick && tick != this->current_tick_)
+    return 0;
+
+  // The slot of <tick> is now on level 0.  If the current time is
+  // past that tick the whole slot has expired, else look for a timer
+  // of the slot that is due.
+  ACE_Timer_Node_T<TYPE>* const root =
+    this->slots_[0][ACE_HWHEEL_SLOT (tick, 0)];
+  ACE_Timer_Node_T<TYPE>* expired = root;
+  if (now <= tick)
+    while (expired->get_timer_value () > cur_time)
+      {
+        expired = expired->get_next ();
+        if (expired == root)
+          return 0;
+      }
+
+  this->unlink (expired);
+
+  // Get the dispatch info
+  expired->get_dispatch_info (info);
+
+  // Check if this is an interval timer.
+  if (expired->get_interval () > ACE_Time_Value::zero)
+    {
+      // Make sure that we skip past values that have already
+      // "expired".
+      this->recompute_next_abs_interval_time (expired, cur_time);
+
+      // Since this is an interval timer, we need to reschedule
+      // it.
+      this->reschedule (expired);
+    }
+  else
+    {
+      // Call the factory method to free up the node.
+      this->free_node (expired);
+    }
+
+  return 1;
+}
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> ACE_Timer_Node_T<TYPE>*
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::remove_first (void)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::remove_first");
+
+  ACE_Timer_Node_T<TYPE>* const first = this->get_first_i ();
+  if (first == 0)
+    return 0;
+
+  // Move the wheel up to the timer; the ones due right after it come
+  // down to the lowest level on the way.
+  this->advance (this->node_tick (first));
+  this->unlink (first);
+  return first;
+}
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> int
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::reset_interval (long timer_id,
+                                                                            const ACE_Time_Value &interval)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::reset_interval");
+  ACE_MT (ACE_GUARD_RETURN (ACE_LOCK, ace_mon, this->mutex_, -1));
+
+  ACE_Timer_Node_T<TYPE>* const n = this->find_node (timer_id);
+  if (n == 0 || n->get_next () == 0)
+    return -1;
+
+  // The interval will take effect the next time the timer expires.
+  n->set_interval (interval);
+  return 0;
+}
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> int
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::cancel (const TYPE& type,
+                                                                    int skip_close)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::cancel");
+  ACE_MT (ACE_GUARD_RETURN (ACE_LOCK, ace_mon, this->mutex_, -1));
+
+  int num_canceled = 0;
+
+  if (this->timer_count_ != 0)
+    {
+      this->earliest_ = 0;
+
+      for (u_int level = 0; level < LEVELS; ++level)
+        for (int slot = this->next_slot (level, 0);
+             slot >= 0;
+             slot = this->next_slot (level, slot + 1))
+          {
+            // Take the whole list off the slot and put back the nodes
+            // that stay; they go back to the same slot, in the same
+            // order.
+            ACE_Timer_Node_T<TYPE>* const root = this->slots_[level][slot];
+            this->slots_[level][slot] = 0;
+            this->occupied_[level][slot / 64] &=
+              ~(static_cast<ACE_UINT64> (1) << (slot % 64));
+            root->get_prev ()->set_next (0);
+
+            for (ACE_Timer_Node_T<TYPE>* n = root; n != 0; )
+              {
+                ACE_Timer_Node_T<TYPE>* const next = n->get_next ();
+                if (n->get_type () == type)
+                  {
+                    --this->timer_count_;
+                    ++num_canceled;
+                    this->free_node (n);
+                  }
+                else
+                  this->insert (n);
+                n = next;
+              }
+          }
+    }
+
+  // Call the close hooks.
+  int cookie = 0;
+
+  // cancel_type() called once per <type>.
+  this->upcall_functor ().cancel_type (*this,
+                                       type,
+                                       skip_close,
+                                       cookie);
+
+  for (int i = 0;
+       i < num_canceled;
+       ++i)
+    {
+      // cancel_timer() called once per <timer>.
+      this->upcall_functor ().cancel_timer (*this,
+                                            type,
+                                            skip_close,
+                                            cookie);
+    }
+
+  return num_canceled;
+}
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> int
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::cancel (long timer_id,
+                                                                    const void **act,
+                                                                    int skip_close)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::cancel");
+  ACE_MT (ACE_GUARD_RETURN (ACE_LOCK, ace_mon, this->mutex_, -1));
+
+  ACE_Timer_Node_T<TYPE>* const n = this->find_node (timer_id);
+
+  // A node without <next> is being dispatched.
+  if (n == 0 || n->get_next () == 0)
+    return 0;
+
+  this->unlink (n);
+
+  // Call the close hooks.
+  int cookie = 0;
+
+  // cancel_type() called once per <type>.
+  this->upcall_functor ().cancel_type (*this,
+                                       n->get_type (),
+                                       skip_close,
+                                       cookie);
+
+  // cancel_timer() called once per <timer>.
+  this->upcall_functor ().cancel_timer (*this,
+                                        n->get_type (),
+                                        skip_close,
+                                        cookie);
+
+  if (act != 0)
+    *act = n->get_act ();
+
+  this->free_node (n);
+  return 1;
+}
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> int
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::close (void)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::close");
+
+  this->earliest_ = 0;
+
+  // Remove any remaining nodes
+  for (u_int level = 0; level < LEVELS; ++level)
+    for (int slot = this->next_slot (level, 0);
+         slot >= 0;
+         slot = this->next_slot (level, slot + 1))
+      {
+        ACE_Timer_Node_T<TYPE>* const root = this->slots_[level][slot];
+        this->slots_[level][slot] = 0;
+        this->occupied_[level][slot / 64] &=
+          ~(static_cast<ACE_UINT64> (1) << (slot % 64));
+        root->get_prev ()->set_next (0);
+
+        for (ACE_Timer_Node_T<TYPE>* n = root; n != 0; )
+          {
+            ACE_Timer_Node_T<TYPE>* const next = n->get_next ();
+
+            // Grab the event_handler and act, then free the node
+            // before calling back to the handler, in case the
+            // handler cancels timers from handle_close().
+            TYPE eh = n->get_type ();
+            const void *act = n->get_act ();
+            --this->timer_count_;
+            this->free_node (n);
+            this->upcall_functor ().deletion (*this, eh, act);
+
+            n = next;
+          }
+      }
+
+  // leave the rest to the destructor
+  return 0;
+}
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> ACE_Timer_Queue_Iterator_T<TYPE>&
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::iter (void)
+{
+  this->iterator_->first ();
+  return *this->iterator_;
+}
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::dump (void) const
+{
+#if defined (ACE_HAS_DUMP)
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::dump");
+  ACELIB_DEBUG ((LM_DEBUG, ACE_BEGIN_DUMP, this));
+
+  ACELIB_DEBUG ((LM_DEBUG,
+    ACE_TEXT ("\nresolution_ = %Q"), this->resolution_));
+  ACELIB_DEBUG ((LM_DEBUG,
+    ACE_TEXT ("\ncurrent_tick_ = %Q"), this->current_tick_));
+  ACELIB_DEBUG ((LM_DEBUG,
+    ACE_TEXT ("\ntimer_count_ = %B"), this->timer_count_));
+  ACELIB_DEBUG ((LM_DEBUG,
+    ACE_TEXT ("\nslabs_ = %B of %B nodes"), this->slab_count_, this->slab_size_));
+  ACELIB_DEBUG ((LM_DEBUG,
+    ACE_TEXT ("\nwheel_ =\n")));
+
+  for (u_int level = 0; level < LEVELS; ++level)
+    for (int slot = this->next_slot (level, 0);
+         slot >= 0;
+         slot = this->next_slot (level, slot + 1))
+      {
+        ACELIB_DEBUG ((LM_DEBUG, ACE_TEXT ("%u.%d\n"), level, slot));
+        ACE_Timer_Node_T<TYPE>* const root = this->slots_[level][slot];
+        ACE_Timer_Node_T<TYPE>* n = root;
+        do
+          {
+            n->dump ();
+            n = n->get_next ();
+          }
+        while (n != root);
+      }
+
+  ACELIB_DEBUG ((LM_DEBUG, ACE_END_DUMP));
+#endif /* ACE_HAS_DUMP */
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_TIMER_HIERARCHICAL_WHEEL_T_CPP */
@@ -0,0 +1,292 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    Timer_Hierarchical_Wheel_T.h
+ *
+ *  Hierarchical timing wheel version of ACE_Timer_Queue.
+ */
+//=============================================================================
+
+#ifndef ACE_TIMER_HIERARCHICAL_WHEEL_T_H
+#define ACE_TIMER_HIERARCHICAL_WHEEL_T_H
+#include /**/ "ace/pre.h"
+
+#include "ace/Timer_Queue_T.h"
+#include "ace/Basic_Types.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+// Forward declaration
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY>
+class ACE_Timer_Hierarchical_Wheel_T;
+
+/**
+ * @class ACE_Timer_Hierarchical_Wheel_Iterator_T
+ *
+ * @brief Iterates over an ACE_Timer_Hierarchical_Wheel.
+ *
+ * This is a generic iterator that can be used to visit every
+ * node of a timer queue.  Be aware that it doesn't traverse
+ * in the order of timeout values.
+ */
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY = ACE_Default_Time_Policy>
+class ACE_Timer_Hierarchical_Wheel_Iterator_T
+  : public ACE_Timer_Queue_Iterator_T <TYPE>
+{
+public:
+  typedef ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY> Wheel;
+  typedef ACE_Timer_Node_T<TYPE> Node;
+
+  /// Constructor
+  ACE_Timer_Hierarchical_Wheel_Iterator_T (Wheel &);
+
+  /// Destructor
+  virtual ~ACE_Timer_Hierarchical_Wheel_Iterator_T (void);
+
+  /// Positions the iterator at the first node in the Timer Queue
+  virtual void first (void);
+
+  /// Positions the iterator at the next node in the Timer Queue
+  virtual void next (void);
+
+  /// Returns true when there are no more nodes in the sequence
+  virtual bool isdone (void) const;
+
+  /// Returns the node at the current position in the sequence
+  virtual ACE_Timer_Node_T<TYPE>* item (void);
+
+protected:
+  /// The wheel that we are iterating over.
+  Wheel& timer_wheel_;
+
+  /// Level and slot of the list that holds <current_node_>.
+  u_int level_;
+  u_int slot_;
+
+  /// Current position, 0 when done.
+  ACE_Timer_Node_T<TYPE>* current_node_;
+
+private:
+  /// Position the iterator on the first node of the first occupied
+  /// slot at or after @a level, @a slot.
+  void goto_next (u_int level, u_int slot);
+};
+
+/**
+ * @class ACE_Timer_Hierarchical_Wheel_T
+ *
+ * @brief Provides a hierarchical timing wheel version of
+ * ACE_Timer_Queue.
+ *
+ * Time is counted in ticks of a fixed resolution.  The wheel has
+ * eight levels of 256 slots, one level per byte of the tick count,
+ * in the style of the Linux kernel and Kafka timer wheels.  A timer
+ * is kept at the level of the highest byte in which its expiration
+ * tick differs from the current tick of the wheel, in the slot given
+ * by that byte.  Timers due in the current 256 ticks thus sit on the
+ * lowest level, and far-future timers sit on the upper levels until
+ * the wheel gets close enough to cascade them down.  The slots are
+ * not sorted.
+ *
+ * Scheduling and cancelling a timer are O(1); each timer is moved at
+ * most once per level before it expires, and finding the next slot
+ * to expire only looks at a bitmap of the occupied slots, so the
+ * cost does not depend on the number of timers or on how far in the
+ * future they are.  A slot of the lowest level is expired as a
+ * whole once the current time is past its tick, so timers due in
+ * the same tick are not dispatched in the order of their timer
+ * values.  No timer is dispatched before its timer value though; the
+ * resolution only decides how timers are spread over the slots.
+ * earliest_time(), get_first() and remove_first() search the first
+ * slot for its earliest timer, which is O(k) for the k timers due in
+ * that tick.
+ *
+ * Timer nodes are allocated in slabs, and the index of a node in the
+ * slabs is the id of its timer.  Freed nodes are reused in the order
+ * they were freed, to delay the reuse of a timer id as long as
+ * possible.
+ */
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY = ACE_Default_Time_Policy>
+class ACE_Timer_Hierarchical_Wheel_T
+  : public ACE_Timer_Queue_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>
+{
+public:
+  /// Type of iterator
+  typedef ACE_Timer_Hierarchical_Wheel_Iterator_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY> Iterator;
+  /// Iterator is a friend
+  friend class ACE_Timer_Hierarchical_Wheel_Iterator_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>;
+  typedef ACE_Timer_Node_T<TYPE> Node;
+  /// Type inherited from
+  typedef ACE_Timer_Queue_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY> Base_Timer_Queue;
+
+  /// Shape of the wheel.
+  enum
+  {
+    LEVELS = 8,
+    SLOT_BITS = 8,
+    SLOTS = 1 << SLOT_BITS
+  };
+
+  /**
+   * Constructor.
+   *
+   * @param resolution Length of a tick, in microseconds.
+   * @param prealloc Number of timer nodes allocated up front; this
+   * is also the size of the slabs in which more are allocated.  If 0,
+   * ACE_DEFAULT_TIMER_HIERARCHICAL_WHEEL_SLAB nodes are allocated
+   * whenever the queue needs more.
+   * @param upcall_functor If 0 the queue will create a default FUNCTOR.
+   */
+  ACE_Timer_Hierarchical_Wheel_T (
+    u_int resolution = ACE_DEFAULT_TIMER_HIERARCHICAL_WHEEL_RESOLUTION,
+    size_t prealloc = 0,
+    FUNCTOR *upcall_functor = 0,
+    TIME_POLICY const & time_policy = TIME_POLICY());
+
+  /// Destructor
+  virtual ~ACE_Timer_Hierarchical_Wheel_T (void);
+
+  /// True if queue is empty, else false.
+  virtual bool is_empty (void) const;
+
+  /// Returns the time of the earlier node in the wheel.
+  /// Must be called on a non-empty queue.
+  virtual const ACE_Time_Value& earliest_time (void) const;
+
+  /// Changes the interval of a timer (and can make it periodic or non
+  /// periodic by setting it to ACE_Time_Value::zero or not).
+  virtual int reset_interval (long timer_id,
+                              const ACE_Time_Value& interval);
+
+  /// Cancel all timer associated with @a type.  If @a dont_call_handle_close is
+  /// 0 then the <functor> will be invoked.  Returns number of timers
+  /// cancelled.
+  virtual int cancel (const TYPE& type,
+                      int dont_call_handle_close = 1);
+
+  /**
+   * Cancel the single timer that matches the @a timer_id value (which
+   * was returned from the <schedule> method).  If act is non-NULL
+   * then it will be set to point to the ``magic cookie'' argument
+   * passed in when the timer was registered.  If
+   * @a dont_call_handle_close is 0 then the <functor> will be
+   * invoked.  Returns 1 if cancellation succeeded and 0 if the
+   * @a timer_id wasn't found.
+   */
+  virtual int cancel (long timer_id,
+                      const void** act = 0,
+                      int dont_call_handle_close = 1);
+
+  /**
+   * Destroy timer queue. Cancels all timers.
+   */
+  virtual int close (void);
+
+  /// Returns a pointer to this <ACE_Timer_Queue_T>'s iterator.
+  virtual ACE_Timer_Queue_Iterator_T<TYPE> & iter (void);
+
+  /**
+   * Removes the earliest node from the queue and returns it.  The
+   * timer id is not reclaimed; the caller is responsible for calling
+   * either @c reschedule() or @c free_node() after this function
+   * returns.
+   */
+  virtual ACE_Timer_Node_T<TYPE>* remove_first (void);
+
+  /// Dump the state of an object.
+  virtual void dump (void) const;
+
+  /// Reads the earliest node from the queue and returns it.
+  virtual ACE_Timer_Node_T<TYPE>* get_first (void);
+
+protected:
+
+  /// Schedules a timer.
+  virtual long schedule_i (const TYPE& type,
+                           const void* act,
+                           const ACE_Time_Value& future_time,
+                           const ACE_Time_Value& interval);
+
+  /// Reschedule an "interval" timer.
+  virtual void reschedule (ACE_Timer_Node_T<TYPE> *);
+
+  /// Move the wheel up to @a current_time, then get the dispatch
+  /// information of the earliest timer if it has expired.
+  virtual int dispatch_info_i (const ACE_Time_Value &current_time,
+                               ACE_Timer_Node_Dispatch_Info_T<TYPE> &info);
+
+  /// Take a node from the slabs, allocating a new slab if needed.
+  virtual ACE_Timer_Node_T<TYPE> *alloc_node (void);
+
+  /// Return a node to the slabs and release its timer id.
+  virtual void free_node (ACE_Timer_Node_T<TYPE> *);
+
+private:
+  // The following are documented in the .cpp file.
+  ACE_UINT64 to_tick (const ACE_Time_Value& time) const;
+  ACE_UINT64 node_tick (ACE_Timer_Node_T<TYPE>* n) const;
+  u_int level_of (ACE_UINT64 tick) const;
+  int next_slot (u_int level, u_int slot) const;
+  int first_slot (u_int &level, u_int &slot) const;
+  ACE_Timer_Node_T<TYPE>* get_first_i (void) const;
+  ACE_Timer_Node_T<TYPE>* find_node (long timer_id) const;
+  void insert (ACE_Timer_Node_T<TYPE>* n);
+  void unlink (ACE_Timer_Node_T<TYPE>* n);
+  void advance (ACE_UINT64 tick);
+  int grow (void);
+
+  /// Heads of the circular lists of each slot; the tail of a list
+  /// is the <prev> of its head.
+  ACE_Timer_Node_T<TYPE>* slots_[LEVELS][SLOTS];
+
+  /// One bit for each non-empty slot.
+  ACE_UINT64 occupied_[LEVELS][SLOTS / 64];
+
+  /// Length of a tick, in microseconds.
+  ACE_UINT64 resolution_;
+
+  /// The tick the wheel is positioned at.  No timer expires before
+  /// it.
+  ACE_UINT64 current_tick_;
+
+  /// The total number of timers currently scheduled.
+  size_t timer_count_;
+
+  /// Cached earliest node, 0 if it has to be searched for.
+  mutable ACE_Timer_Node_T<TYPE>* earliest_;
+
+  /// Slabs of timer nodes.
+  ACE_Timer_Node_T<TYPE>** slabs_;
+
+  /// Number of slabs allocated and the size of <slabs_>.
+  size_t slab_count_;
+  size_t slab_max_;
+
+  /// Number of nodes in each slab.
+  size_t slab_size_;
+
+  /// Nodes that are not in use, linked through their <next>.
+  ACE_Timer_Node_T<TYPE>* free_head_;
+  ACE_Timer_Node_T<TYPE>* free_tail_;
+
+  /// Iterator used to expire timers.
+  Iterator* iterator_;
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#if defined (ACE_TEMPLATES_REQUIRE_SOURCE)
+#include "ace/Timer_Hierarchical_Wheel_T.cpp"
+#endif /* ACE_TEMPLATES_REQUIRE_SOURCE */
+
+#if defined (ACE_TEMPLATES_REQUIRE_PRAGMA)
+#pragma implementation ("Timer_Hierarchical_Wheel_T.cpp")
+#endif /* ACE_TEMPLATES_REQUIRE_PRAGMA */
+
+#include /**/ "ace/post.h"
+#endif /* ACE_TIMER_HIERARCHICAL_WHEEL_T_H */
@@ -0,0 +1,603 @@
+#include "ace/Uring_Proactor.h"
+
+#if defined (ACE_HAS_AIO_CALLS) && defined (ACE_HAS_IO_URING)
+
+#include "ace/Log_Category.h"
+#include "ace/Countdown_Time.h"
+#include "ace/Guard_T.h"
+#include "ace/OS_NS_errno.h"
+#include "ace/os_include/os_poll.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_ALLOC_HOOK_DEFINE(ACE_Uring_Proactor)
+
+namespace
+{
+  /// Tag of the no-op requests matching post_completion() calls.
+  ACE_UINT64 const POSTED_TAG = ~static_cast<ACE_UINT64> (0);
+
+  /// Set in the tag of the poll request a restarted operation waits
+  /// on.  Slot numbers never get close to it.
+  ACE_UINT64 const POLL_TAG_BIT = 0x80000000U;
+
+  ACE_UINT64 const SLOT_MASK = 0x7FFFFFFFU;
+
+  /// Largest length of a single read or write; longer requests
+  /// transfer less, as allowed for any stream operation.
+  size_t const MAX_XFER = 0x7FFFF000U;
+}
+
+ACE_Uring_Proactor::ACE_Uring_Proactor (size_t max_aio_operations)
+  : slots_ (0),
+    free_slots_ (0),
+    max_aio_operations_ (max_aio_operations),
+    num_free_slots_ (0),
+    generation_ (0),
+    waiters_ (0)
+{
+  ACE_TRACE ("ACE_Uring_Proactor::ACE_Uring_Proactor");
+
+  if (this->max_aio_operations_ == 0)
+    this->max_aio_operations_ = ACE_AIO_DEFAULT_SIZE;
+  if (this->max_aio_operations_ > SLOT_MASK - 1)
+    this->max_aio_operations_ = SLOT_MASK - 1;
+
+  // Completions of everything that may be in progress fit into the
+  // completion queue, together with a share of posted results.
+  // Should they ever overflow, the kernel keeps them until there is
+  // room again.
+  unsigned int const cq_entries =
+    static_cast<unsigned int> (2 * this->max_aio_operations_);
+
+  if (this->ring_.open (ACE_URING_PROACTOR_SQ_ENTRIES, cq_entries) == -1)
+    {
+      ACELIB_ERROR ((LM_ERROR,
+                     ACE_TEXT ("%N:%l:(%P|%t)::%p\n"),
+                     ACE_TEXT ("ACE_Uring_Proactor: io_uring setup")));
+      return;
+    }
+
+  ACE_NEW_NORETURN (this->slots_, Aio_Slot[this->max_aio_operations_]);
+  ACE_NEW_NORETURN (this->free_slots_, size_t[this->max_aio_operations_]);
+  if (this->slots_ == 0 || this->free_slots_ == 0)
+    {
+      delete [] this->slots_;
+      this->slots_ = 0;
+      delete [] this->free_slots_;
+      this->free_slots_ = 0;
+      this->ring_.close ();
+      return;
+    }
+
+  // Hand out the low slots first.
+  for (size_t i = 0; i < this->max_aio_operations_; ++i)
+    {
+      this->slots_[i].result_ = 0;
+      this->slots_[i].user_data_ = 0;
+      this->free_slots_[i] = this->max_aio_operations_ - 1 - i;
+    }
+  this->num_free_slots_ = this->max_aio_operations_;
+
+  // start pseudo-asynchronous accept task
+  // one per all future acceptors
+  this->get_asynch_pseudo_task ().start ();
+}
+
+ACE_Uring_Proactor::~ACE_Uring_Proactor (void)
+{
+  this->close ();
+}
+
+ACE_POSIX_Proactor::Proactor_Type
+ACE_Uring_Proactor::get_impl_type (void)
+{
+  return PROACTOR_URING;
+}
+
+bool
+ACE_Uring_Proactor::initialized (void) const
+{
+  return this->ring_.is_open ();
+}
+
+int
+ACE_Uring_Proactor::close (void)
+{
+  ACE_TRACE ("ACE_Uring_Proactor::close");
+
+  if (!this->ring_.is_open ())
+    return 0;
+
+  // stop asynch accept task
+  this->get_asynch_pseudo_task ().stop ();
+
+  this->cancel_all_i ();
+
+  ACE_POSIX_Asynch_Result *result = 0;
+  while (this->result_queue_.dequeue_head (result) == 0)
+    delete result;
+
+  this->ring_.close ();
+
+  delete [] this->slots_;
+  this->slots_ = 0;
+  delete [] this->free_slots_;
+  this->free_slots_ = 0;
+  this->num_free_slots_ = 0;
+
+  return 0;
+}
+
+void
+ACE_Uring_Proactor::cancel_all_i (void)
+{
+  {
+    ACE_MT (ACE_GUARD (ACE_SYNCH_MUTEX, ace_mon, this->mutex_));
+
+    for (size_t i = 0; i < this->max_aio_operations_; ++i)
+      if (this->slots_[i].result_ != 0)
+        this->cancel_slot_i (i);
+
+    this->ring_.submit ();
+  }
+
+  // The kernel may still be using the buffers of the cancelled
+  // operations, so wait for them to come back before returning.
+  // Their handlers are not called any more.
+  ACE_Time_Value const wait_time (0, 100000);
+  int timeouts = 0;
+
+  while (this->num_free_slots_ < this->max_aio_operations_ && timeouts < 50)
+    {
+      ACE_POSIX_Asynch_Result *result = 0;
+      size_t bytes_transferred = 0;
+      u_long error = 0;
+
+      if (this->reap_completion (result, bytes_transferred, error) > 0)
+        {
+          delete result;
+          continue;
+        }
+
+      unsigned int to_submit = 0;
+      {
+        ACE_MT (ACE_GUARD (ACE_SYNCH_MUTEX, ace_mon, this->mutex_));
+        to_submit = this->ring_.flush ();
+      }
+
+      if (this->ring_.enter (to_submit, 1, &wait_time) == -1
+          && errno == ETIME)
+        ++timeouts;
+    }
+
+  size_t const num_pending =
+    this->max_aio_operations_ - this->num_free_slots_;
+
+  if (num_pending > 0)
+    ACELIB_ERROR ((LM_ERROR,
+                   ACE_TEXT ("%N:%l:(%P | %t)::\n")
+                   ACE_TEXT ("ACE_Uring_Proactor::close")
+                   ACE_TEXT (" number pending AIO=%B\n"),
+                   num_pending));
+}
+
+int
+ACE_Uring_Proactor::handle_events (ACE_Time_Value &wait_time)
+{
+  // <wait_time> is decremented with the amount of time spent waiting.
+  return this->handle_events_i (&wait_time);
+}
+
+int
+ACE_Uring_Proactor::handle_events (void)
+{
+  return this->handle_events_i (0);
+}
+
+int
+ACE_Uring_Proactor::handle_events_i (ACE_Time_Value *max_wait_time)
+{
+  ACE_Countdown_Time countdown (max_wait_time);
+
+  for (;;)
+    {
+      // Dispatch what is ready now, but no more than that; completions
+      // arriving meanwhile are left to the other threads.
+      ACE_POSIX_Asynch_Result *result = 0;
+      size_t bytes_transferred = 0;
+      u_long error = 0;
+
+      int ready = this->reap_completion (result, bytes_transferred, error);
+      if (ready > 0)
+        {
+          for (;;)
+            {
+              this->application_specific_code (result,
+                                               bytes_transferred,
+                                               0, // No completion key.
+                                               error);
+              if (--ready == 0
+                  || this->reap_completion (result,
+                                            bytes_transferred,
+                                            error) == 0)
+                break;
+            }
+          return 1;
+        }
+
+      unsigned int to_submit = 0;
+      {
+        ACE_MT (ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->mutex_, -1));
+
+        if (!this->ring_.is_open ())
+          {
+            errno = ESHUTDOWN;
+            return -1;
+          }
+
+        // Requests started by others from now on are submitted by
+        // them, the ones queued so far go in with the wait.
+        to_submit = this->ring_.flush ();
+        ++this->waiters_;
+      }
+
+      int const result_enter =
+        this->ring_.enter (to_submit, 1, max_wait_time);
+      int const error_enter = errno;
+
+      {
+        ACE_MT (ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->mutex_, -1));
+        --this->waiters_;
+      }
+
+      countdown.update ();
+
+      if (result_enter == -1)
+        switch (error_enter)
+          {
+          case ETIME:
+            // A completion may still have slipped in.
+            if (this->ring_.cq_ready () == 0)
+              return 0;
+            break;
+
+          case EINTR:
+            return 0;
+
+          case EAGAIN:
+          case EBUSY:
+            // Out of resources for new requests; make room by reaping.
+            break;
+
+          default:
+            errno = error_enter;
+            ACELIB_ERROR_RETURN ((LM_ERROR,
+                                  ACE_TEXT ("%N:%l:(%P|%t)::%p\n"),
+                                  ACE_TEXT ("handle_events: io_uring_enter")),
+                                 -1);
+          }
+    }
+}
+
+int
+ACE_Uring_Proactor::reap_completion (ACE_POSIX_Asynch_Result *&result,
+                                     size_t &bytes_transferred,
+                                     u_long &error)
+{
+  ACE_MT (ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->mutex_, 0));
+
+  if (!this->ring_.is_open ())
+    return 0;
+
+  for (struct io_uring_cqe *cqe = 0;
+       (cqe = this->ring_.peek_cqe ()) != 0;
+       )
+    {
+      int const ready = static_cast<int> (this->ring_.cq_ready ());
+      ACE_UINT64 const user_data = cqe->user_data;
+      ACE_INT32 const res = cqe->res;
+      this->ring_.cqe_seen ();
+
+      if (user_data == POSTED_TAG)
+        {
+          if (this->result_queue_.dequeue_head (result) != 0)
+            continue;
+
+          bytes_transferred = result->bytes_transferred ();
+          error = result->error ();
+          return ready;
+        }
+
+      // Cancellations and the polls of restarted operations are of no
+      // interest; the operations they refer to complete on their own.
+      if (user_data == 0 || (user_data & POLL_TAG_BIT) != 0)
+        continue;
+
+      size_t const slot = static_cast<size_t> (user_data & SLOT_MASK) - 1;
+      if (slot >= this->max_aio_operations_
+          || this->slots_[slot].user_data_ != user_data)
+        continue;
+
+      if (res == -EAGAIN && this->restart_i (slot) == 0)
+        continue;
+
+      result = this->slots_[slot].result_;
+      this->slots_[slot].result_ = 0;
+      this->slots_[slot].user_data_ = 0;
+      this->free_slots_[this->num_free_slots_++] = slot;
+
+      if (res < 0)
+        {
+          bytes_transferred = 0;
+          error = static_cast<u_long> (-res);
+        }
+      else
+        {
+          bytes_transferred = static_cast<size_t> (res);
+          error = 0;
+        }
+
+      result->set_bytes_transferred (bytes_transferred);
+      result->set_error (error);
+      return ready;
+    }
+
+  return 0;
+}
+
+struct io_uring_sqe *
+ACE_Uring_Proactor::get_sqe_i (void)
+{
+  struct io_uring_sqe *sqe = this->ring_.get_sqe ();
+
+  if (sqe == 0 && this->ring_.submit () >= 0)
+    sqe = this->ring_.get_sqe ();
+
+  if (sqe == 0)
+    errno = EAGAIN;
+
+  return sqe;
+}
+
+void
+ACE_Uring_Proactor::submit_i (void)
+{
+  // Without a waiting thread the requests are submitted together with
+  // the next wait, which saves a system call per request.
+  if (this->waiters_ > 0 && this->ring_.submit () == -1)
+    ACELIB_ERROR ((LM_ERROR,
+                   ACE_TEXT ("%N:%l:(%P|%t)::%p\n"),
+                   ACE_TEXT ("ACE_Uring_Proactor: io_uring_enter")));
+}
+
+int
+ACE_Uring_Proactor::restart_i (size_t slot)
+{
+  // The poll and the operation must be submitted together for the
+  // link between them to hold.
+  if (this->ring_.sq_space_left () < 2
+      && (this->ring_.submit () == -1 || this->ring_.sq_space_left () < 2))
+    return -1;
+
+  ACE_POSIX_Asynch_Result *result = this->slots_[slot].result_;
+  ACE_UINT64 const user_data = this->slots_[slot].user_data_;
+
+  struct io_uring_sqe *sqe = this->ring_.get_sqe ();
+  ACE_IO_Uring::prep_poll_add (sqe,
+                               result->aio_fildes,
+                               result->aio_lio_opcode == LIO_READ
+                                 ? POLLIN
+                                 : POLLOUT,
+                               user_data | POLL_TAG_BIT);
+  sqe->flags |= IOSQE_IO_LINK;
+#if defined (IORING_FEAT_CQE_SKIP)
+  if (this->ring_.has_feature (IORING_FEAT_CQE_SKIP))
+    sqe->flags |= IOSQE_CQE_SKIP_SUCCESS;
+#endif /* IORING_FEAT_CQE_SKIP */
+
+  sqe = this->ring_.get_sqe ();
+  ACE_IO_Uring::prep_rw (sqe,
+                         result->aio_lio_opcode == LIO_READ
+                           ? IORING_OP_READ
+                           : IORING_OP_WRITE,
+                         result->aio_fildes,
+                         const_cast<void *> (result->aio_buf),
+                         static_cast<ACE_UINT32> (result->aio_nbytes),
+                         result->aio_offset,
+                         user_data);
+
+  this->submit_i ();
+  return 0;
+}
+
+int
+ACE_Uring_Proactor::post_completion (ACE_POSIX_Asynch_Result *result)
+{
+  ACE_MT (ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->mutex_, -1));
+
+  if (result == 0 || !this->ring_.is_open ())
+    return -1;
+
+  struct io_uring_sqe *sqe = this->get_sqe_i ();
+  if (sqe == 0)
+    ACELIB_ERROR_RETURN ((LM_ERROR,
+                          ACE_TEXT ("%N:%l:ACE_Uring_Proactor::post_completion:")
+                          ACE_TEXT (" submission queue full\n")),
+                         -1);
+
+  if (this->result_queue_.enqueue_tail (result) == -1)
+    {
+      // The entry can't be given back; turn it into a request whose
+      // completion is ignored.
+      ACE_IO_Uring::prep_rw (sqe, IORING_OP_NOP, -1, 0, 0, 0, 0);
+      ACELIB_ERROR_RETURN ((LM_ERROR,
+                            ACE_TEXT ("%N:%l:ACE_Uring_Proactor::post_completion")
+                            ACE_TEXT (" failed\n")),
+                           -1);
+    }
+
+  ACE_IO_Uring::prep_rw (sqe, IORING_OP_NOP, -1, 0, 0, 0, POSTED_TAG);
+  this->submit_i ();
+  return 0;
+}
+
+int
+ACE_Uring_Proactor::start_aio (ACE_POSIX_Asynch_Result *result,
+                               ACE_POSIX_Proactor::Opcode op)
+{
+  ACE_TRACE ("ACE_Uring_Proactor::start_aio");
+
+  ACE_MT (ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->mutex_, -1));
+
+  if (!this->ring_.is_open ())
+    {
+      errno = ESHUTDOWN;
+      return -1;
+    }
+
+  int ret_val = this->num_free_slots_ == 0 ? -1 : 0;
+
+  if (result == 0) // Just check the status of the list
+    return ret_val;
+
+  ACE_UINT8 opcode = IORING_OP_NOP;
+
+  // Save operation code in the aiocb
+  switch (op)
+    {
+    case ACE_POSIX_Proactor::ACE_OPCODE_READ:
+      result->aio_lio_opcode = LIO_READ;
+      opcode = IORING_OP_READ;
+      break;
+
+    case ACE_POSIX_Proactor::ACE_OPCODE_WRITE:
+      result->aio_lio_opcode = LIO_WRITE;
+      opcode = IORING_OP_WRITE;
+      break;
+
+    default:
+      ACELIB_ERROR_RETURN ((LM_ERROR,
+                            ACE_TEXT ("%N:%l:(%P|%t)::")
+                            ACE_TEXT ("start_aio: Invalid op code %d\n"),
+                            op),
+                           -1);
+    }
+
+  if (ret_val != 0)   // No free slot
+    {
+      errno = EAGAIN;
+      return -1;
+    }
+
+  if (result->aio_nbytes > MAX_XFER)
+    result->aio_nbytes = MAX_XFER;
+
+  struct io_uring_sqe *sqe = this->get_sqe_i ();
+  if (sqe == 0)
+    return -1;
+
+  size_t const slot = this->free_slots_[--this->num_free_slots_];
+
+  if (++this->generation_ == 0)
+    ++this->generation_;
+
+  ACE_UINT64 const user_data =
+    (static_cast<ACE_UINT64> (this->generation_) << 32) | (slot + 1);
+
+  this->slots_[slot].result_ = result;
+  this->slots_[slot].user_data_ = user_data;
+
+  ACE_IO_Uring::prep_rw (sqe,
+                         opcode,
+                         result->aio_fildes,
+                         const_cast<void *> (result->aio_buf),
+                         static_cast<ACE_UINT32> (result->aio_nbytes),
+                         result->aio_offset,
+                         user_data);
+
+  this->submit_i ();
+  return 0;
+}
+
+int
+ACE_Uring_Proactor::cancel_aio (ACE_HANDLE handle)
+{
+  ACE_TRACE ("ACE_Uring_Proactor::cancel_aio");
+
+  int num_total = 0;
+  int num_cancelled = 0;
+
+  {
+    ACE_MT (ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->mutex_, -1));
+
+    if (!this->ring_.is_open ())
+      return 1;
+
+    for (size_t i = 0; i < this->max_aio_operations_; ++i)
+      {
+        if (this->slots_[i].result_ == 0 // Skip empty slot
+            || this->slots_[i].result_->aio_fildes != handle)  // Not ours
+          continue;
+
+        ++num_total;
+
+        if (this->cancel_slot_i (i) == 0)
+          ++num_cancelled;
+      }
+
+    // Cancellation is not worth deferring.
+    if (num_cancelled > 0)
+      this->ring_.submit ();
+  } // release mutex_
+
+  if (num_total == 0)
+    return 1;  // ALLDONE
+
+  if (num_cancelled == num_total)
+    return 0;  // CANCELLED
+
+  return 2; // NOT CANCELLED
+}
+
+int
+ACE_Uring_Proactor::cancel_slot_i (size_t slot)
+{
+  // A restarted operation may still be waiting on its poll;
+  // cancelling that fails the operation linked to it.  Only one of
+  // the two requests exists at any time, the cancellation of the
+  // other one simply fails.
+  if (this->ring_.sq_space_left () < 2
+      && (this->ring_.submit () == -1 || this->ring_.sq_space_left () < 2))
+    return -1;
+
+  ACE_UINT64 const user_data = this->slots_[slot].user_data_;
+
+  ACE_IO_Uring::prep_cancel (this->ring_.get_sqe (), user_data, 0);
+  ACE_IO_Uring::prep_cancel (this->ring_.get_sqe (),
+                             user_data | POLL_TAG_BIT,
+                             0);
+  return 0;
+}
+
+void
+ACE_Uring_Proactor::dump (void) const
+{
+#if defined (ACE_HAS_DUMP)
+  ACE_TRACE ("ACE_Uring_Proactor::dump");
+
+  ACELIB_DEBUG ((LM_DEBUG, ACE_BEGIN_DUMP, this));
+  ACELIB_DEBUG ((LM_DEBUG,
+                 ACE_TEXT ("max_aio_operations_ = %B\n"),
+                 this->max_aio_operations_));
+  ACELIB_DEBUG ((LM_DEBUG,
+                 ACE_TEXT ("num_free_slots_ = %B\n"),
+                 this->num_free_slots_));
+  this->ring_.dump ();
+  ACELIB_DEBUG ((LM_DEBUG, ACE_END_DUMP));
+#endif /* ACE_HAS_DUMP */
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_HAS_AIO_CALLS && ACE_HAS_IO_URING */
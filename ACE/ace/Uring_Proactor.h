@@ -0,0 +1,205 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    Uring_Proactor.h
+ *
+ *  Proactor implementation driven by a Linux io_uring instance.
+ */
+//=============================================================================
+
+#ifndef ACE_URING_PROACTOR_H
+#define ACE_URING_PROACTOR_H
+
+#include /**/ "ace/pre.h"
+
+#include /**/ "ace/config-all.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#if defined (ACE_HAS_AIO_CALLS) && defined (ACE_HAS_IO_URING)
+
+#include "ace/POSIX_Proactor.h"
+#include "ace/IO_Uring.h"
+#include "ace/Thread_Mutex.h"
+#include "ace/Unbounded_Queue.h"
+
+/// Number of submission queue entries of the proactor ring.  Requests
+/// started while the queue is full are submitted early, so this only
+/// limits how many are batched into a single system call.
+#if !defined (ACE_URING_PROACTOR_SQ_ENTRIES)
+# define ACE_URING_PROACTOR_SQ_ENTRIES 256
+#endif /* !ACE_URING_PROACTOR_SQ_ENTRIES */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class ACE_Uring_Proactor
+ *
+ * @brief Proactor implementation that uses io_uring to perform the
+ * asynchronous operations.
+ *
+ * Reads and writes started through the ACE_POSIX_Asynch_* operation
+ * classes are handed to the kernel as io_uring requests instead of
+ * going through the POSIX <aio_> calls.  This gives truly
+ * asynchronous I/O for sockets, pipes and files alike without the
+ * helper threads the C library uses to emulate <aio_> on Linux.
+ *
+ * Accept and connect keep using the pseudo-asynchronous task shared
+ * by all POSIX Proactors.  Their results, as well as timers and any
+ * other post_completion() calls, are delivered through the same
+ * completion queue as the I/O results by a no-op request, so all
+ * completions are dispatched by the threads running the event loop.
+ *
+ * Any number of threads may run the event loop.  Requests started
+ * while a thread waits for completions are submitted right away,
+ * otherwise they are batched and submitted when the next thread
+ * starts waiting.
+ *
+ * @note The ring needs the IORING_FEAT_EXT_ARG feature, that is a
+ * Linux 5.11 or newer kernel.  ACE_Proactor falls back to the POSIX
+ * implementations when the ring can't be set up; use initialized()
+ * to check when creating this class directly.
+ */
+class ACE_Export ACE_Uring_Proactor : public ACE_POSIX_Proactor
+{
+public:
+  /// Constructor defines max number asynchronous operations that can
+  /// be started at the same time.
+  ACE_Uring_Proactor (size_t max_aio_operations = ACE_AIO_DEFAULT_SIZE);
+
+  /// Destructor.
+  virtual ~ACE_Uring_Proactor (void);
+
+  virtual Proactor_Type get_impl_type (void);
+
+  /// Returns true if the ring was set up successfully.
+  bool initialized (void) const;
+
+  /// Close down the Proactor.
+  virtual int close (void);
+
+  /**
+   * Dispatch a single set of events.  If @a wait_time elapses before
+   * any events occur, return 0.  Return 1 on success i.e., when a
+   * completion is dispatched, non-zero (-1) on errors and errno is
+   * set accordingly.
+   */
+  virtual int handle_events (ACE_Time_Value &wait_time);
+
+  /**
+   * Block indefinitely until at least one event is dispatched.
+   * Dispatch a single set of events.  Return 1 on success i.e., when a
+   * completion is dispatched, non-zero (-1) on errors and errno is
+   * set accordingly.
+   */
+  virtual int handle_events (void);
+
+  /// Post a result to the completion queue of the Proactor.
+  virtual int post_completion (ACE_POSIX_Asynch_Result *result);
+
+  /// Start a read or write described by the <aiocb> part of
+  /// @a result.
+  virtual int start_aio (ACE_POSIX_Asynch_Result *result,
+                         ACE_POSIX_Proactor::Opcode op);
+
+  /**
+   * Cancel all operations started on @a handle.  Returns 0 if
+   * cancellation was requested for all of them, 1 if there were no
+   * operations in progress and 2 if some could not be cancelled.
+   * The cancelled operations complete with ECANCELED.
+   */
+  virtual int cancel_aio (ACE_HANDLE handle);
+
+  /// Dump the state of an object.
+  void dump (void) const;
+
+  /// Declare the dynamic allocation hooks.
+  ACE_ALLOC_HOOK_DECLARE;
+
+protected:
+  /**
+   * Dispatch the completions that are ready, waiting at most
+   * @a max_wait_time for one to arrive (0 means wait indefinitely).
+   * Returns 1 if at least one completion was dispatched, 0 on
+   * timeout and -1 on errors.
+   */
+  int handle_events_i (ACE_Time_Value *max_wait_time);
+
+  /// Take the next completion off the ring and set the arguments.
+  /// Returns the number of completions that were ready, including
+  /// this one, or 0 if there was none.
+  int reap_completion (ACE_POSIX_Asynch_Result *&result,
+                       size_t &bytes_transferred,
+                       u_long &error);
+
+  /// Get a free submission queue entry, submitting the ones already
+  /// queued if necessary.  Must be called with <mutex_> held.
+  struct io_uring_sqe *get_sqe_i (void);
+
+  /// Submit queued requests if a thread is waiting for completions.
+  /// Must be called with <mutex_> held.
+  void submit_i (void);
+
+  /// Restart the operation in @a slot once its handle becomes ready.
+  /// Used when a handle in non-blocking mode made it fail with
+  /// EAGAIN.  Must be called with <mutex_> held.
+  int restart_i (size_t slot);
+
+  /// Request cancellation of the operation in @a slot.  Must be
+  /// called with <mutex_> held.
+  int cancel_slot_i (size_t slot);
+
+  /// Cancel all operations in progress and wait for the ring to give
+  /// their buffers back.
+  void cancel_all_i (void);
+
+  /// Slot of an operation in progress.
+  struct Aio_Slot
+  {
+    ACE_POSIX_Asynch_Result *result_;
+
+    /// Request tag; identifies the operation in the ring so a stale
+    /// cancellation never hits a later use of the slot.
+    ACE_UINT64 user_data_;
+  };
+
+  /// The io_uring instance.
+  ACE_IO_Uring ring_;
+
+  /// Protects the submission queue, the slots and <result_queue_>.
+  /// The completion queue is only read while holding it as well.
+  ACE_SYNCH_MUTEX mutex_;
+
+  /// Operations in progress, indexed by the low half of their tag.
+  Aio_Slot *slots_;
+
+  /// Stack of the unused slot indices.
+  size_t *free_slots_;
+
+  /// Number of entries in <slots_>.
+  size_t max_aio_operations_;
+
+  /// Number of entries on <free_slots_>.
+  size_t num_free_slots_;
+
+  /// Upper half of the next request tag.
+  ACE_UINT32 generation_;
+
+  /// Results passed to post_completion(); each of them is matched by
+  /// a no-op request in the ring.
+  ACE_Unbounded_Queue<ACE_POSIX_Asynch_Result *> result_queue_;
+
+  /// Number of threads blocked waiting for completions.
+  int waiters_;
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_HAS_AIO_CALLS && ACE_HAS_IO_URING */
+
+#include /**/ "ace/post.h"
+
+#endif /* ACE_URING_PROACTOR_H */
@@ -0,0 +1,400 @@
+#include "ace/OS_NS_errno.h"
+#include "ace/Uring_Reactor.h"
+
+#if defined (ACE_HAS_IO_URING)
+
+#if !defined (__ACE_INLINE__)
+# include "ace/Uring_Reactor.inl"
+#endif /* __ACE_INLINE__ */
+
+#include "ace/ACE.h"
+#include "ace/Guard_T.h"
+#include "ace/Log_Category.h"
+#include "ace/Min_Max.h"
+#include "ace/os_include/os_poll.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_ALLOC_HOOK_DEFINE(ACE_Uring_Reactor)
+
+ACE_Uring_Reactor::ACE_Uring_Reactor (ACE_Sig_Handler *sh,
+                                      ACE_Timer_Queue *tq,
+                                      int disable_notify_pipe,
+                                      ACE_Reactor_Notify *notify,
+                                      int mask_signals,
+                                      int s_queue)
+  : ACE_Dev_Poll_Reactor (DEFERRED_OPEN, mask_signals, s_queue)
+  , ring_ ()
+  , ring_lock_ ()
+  , waiting_ (false)
+{
+  ACE_TRACE ("ACE_Uring_Reactor::ACE_Uring_Reactor");
+
+  if (this->open (ACE::max_handles (),
+                  0,
+                  sh,
+                  tq,
+                  disable_notify_pipe,
+                  notify) == -1)
+    ACELIB_ERROR ((LM_ERROR,
+                ACE_TEXT ("%p\n"),
+                ACE_TEXT ("ACE_Uring_Reactor::open ")
+                ACE_TEXT ("failed inside ")
+                ACE_TEXT ("ACE_Uring_Reactor::CTOR")));
+}
+
+ACE_Uring_Reactor::ACE_Uring_Reactor (size_t size,
+                                      bool rs,
+                                      ACE_Sig_Handler *sh,
+                                      ACE_Timer_Queue *tq,
+                                      int disable_notify_pipe,
+                                      ACE_Reactor_Notify *notify,
+                                      int mask_signals,
+                                      int s_queue)
+  : ACE_Dev_Poll_Reactor (DEFERRED_OPEN, mask_signals, s_queue)
+  , ring_ ()
+  , ring_lock_ ()
+  , waiting_ (false)
+{
+  if (this->open (size,
+                  rs,
+                  sh,
+                  tq,
+                  disable_notify_pipe,
+                  notify) == -1)
+    ACELIB_ERROR ((LM_ERROR,
+                ACE_TEXT ("%p\n"),
+                ACE_TEXT ("ACE_Uring_Reactor::open ")
+                ACE_TEXT ("failed inside ACE_Uring_Reactor::CTOR")));
+}
+
+ACE_Uring_Reactor::~ACE_Uring_Reactor (void)
+{
+  ACE_TRACE ("ACE_Uring_Reactor::~ACE_Uring_Reactor");
+
+  // The ACE_Dev_Poll_Reactor destructor can't reach close_poll_i()
+  // anymore, so close down while the ring is still around.
+  (void) this->close ();
+}
+
+int
+ACE_Uring_Reactor::dispatch_io_event (Token_Guard &guard)
+{
+
+  // Dispatch a ready event.
+
+  // Define bits to check for while dispatching.
+  const ACE_UINT32 out_event = POLLOUT;
+  const ACE_UINT32 exc_event = POLLPRI;
+  const ACE_UINT32 in_event  = POLLIN;
+  const ACE_UINT32 err_event = POLLHUP | POLLERR | POLLNVAL;
+
+  // Only the token holder reaps completions, so the completion queue
+  // needs no further locking. Completions of poll removals and of poll
+  // requests that were cancelled or replaced after they completed are
+  // dropped until one belonging to the current request of a registered
+  // handle turns up.
+  for (struct io_uring_cqe *cqe = this->ring_.peek_cqe ();
+       cqe != 0;
+       cqe = this->ring_.peek_cqe ())
+    {
+      ACE_UINT64 const user_data = cqe->user_data;
+      // A poll request completes with the ready events or, if it could
+      // not be set up (e.g. the handle is not open), with -errno.
+      ACE_UINT32 revents =
+        cqe->res < 0 ? POLLERR : static_cast<ACE_UINT32> (cqe->res);
+      this->ring_.cqe_seen ();
+
+      if (user_data == 0)
+        continue;
+
+      const ACE_HANDLE handle = static_cast<ACE_HANDLE> (user_data >> 32);
+      ACE_UINT32 const generation = static_cast<ACE_UINT32> (user_data);
+
+      // Going to access handler repo, so lock it. If the lock is
+      // unobtainable, something is very wrong so bail out.
+      Event_Tuple *info = 0;
+      ACE_Reactor_Mask disp_mask = 0;
+      ACE_Event_Handler *eh = 0;
+      int (ACE_Event_Handler::*callback)(ACE_HANDLE) = 0;
+      bool reactor_resumes_eh = false;
+      {
+        ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, grd, this->repo_lock_, -1);
+        info = this->handler_rep_.find (handle);
+
+        // The handler may have been removed, suspended, or had its mask
+        // changed since the request completed. Each of those withdraws
+        // the request, so the completion is stale. This also keeps a
+        // suspended handler from being dispatched on top of another
+        // callback; see Bugzilla 4129.
+        if (info == 0
+            || !info->controlled
+            || info->generation != generation)
+          continue;
+
+        // Poll requests are oneshot; this one is used up.
+        info->controlled = false;
+
+        // Figure out what to do first in order to make it easier to manage
+        // the bit twiddling before releasing the token for dispatch.
+        // Note that if there's an error (such as the handle was closed
+        // without being removed from the reactor) the POLLHUP, POLLERR
+        // and/or POLLNVAL bits will be set in revents.
+        eh = info->event_handler;
+        if (ACE_BIT_ENABLED (revents, out_event))
+          {
+            disp_mask = ACE_Event_Handler::WRITE_MASK;
+            callback = &ACE_Event_Handler::handle_output;
+          }
+        else if (ACE_BIT_ENABLED (revents, exc_event))
+          {
+            disp_mask = ACE_Event_Handler::EXCEPT_MASK;
+            callback = &ACE_Event_Handler::handle_exception;
+          }
+        else if (ACE_BIT_ENABLED (revents, in_event))
+          {
+            disp_mask = ACE_Event_Handler::READ_MASK;
+            callback = &ACE_Event_Handler::handle_input;
+          }
+        else if (ACE_BIT_ENABLED (revents, err_event))
+          {
+            this->remove_handler_i (handle,
+                                    ACE_Event_Handler::ALL_EVENTS_MASK,
+                                    grd,
+                                    info->event_handler);
+            return 1;
+          }
+        else
+          {
+            ACELIB_ERROR ((LM_ERROR,
+                           ACE_TEXT ("(%t) dispatch_io h %d unknown events 0x%x\n"),
+                           handle, revents));
+            this->arm_i (handle, info);
+            continue;
+          }
+
+        // Since the poll request is gone, the handle is effectively
+        // suspended; any other event pending on it is reported again
+        // once it's resumed.
+        // The hitch to this is that the notify handler is never
+        // suspended/resumed. This avoids endless notify loops caused by
+        // the notify handler requiring a resumption which requires the
+        // token, which requires a notify, etc. described in Bugzilla
+        // 3714. So, re-arm the notify handler right away; the request
+        // goes to the kernel with the next wait.
+        if (eh != this->notify_handler_)
+          {
+            info->suspended = true;
+
+            reactor_resumes_eh =
+              eh->resume_handler () ==
+              ACE_Event_Handler::ACE_REACTOR_RESUMES_HANDLER;
+          }
+        else
+          this->arm_i (handle, info);
+
+      }     // End scope for ACE_GUARD holding repo lock
+
+      return this->dispatch_io_handler (guard,
+                                        handle,
+                                        eh,
+                                        disp_mask,
+                                        callback,
+                                        reactor_resumes_eh);
+    }
+
+  return 0;
+}
+
+void
+ACE_Uring_Reactor::dump (void) const
+{
+#if defined (ACE_HAS_DUMP)
+  ACE_TRACE ("ACE_Uring_Reactor::dump");
+
+  ACE_Dev_Poll_Reactor::dump ();
+
+  ACELIB_DEBUG ((LM_DEBUG, ACE_BEGIN_DUMP, this));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_TEXT ("ring_ = %d"), this->ring_.handle ()));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_END_DUMP));
+#endif /* ACE_HAS_DUMP */
+}
+
+int
+ACE_Uring_Reactor::open_poll_i (size_t size)
+{
+  ACE_TRACE ("ACE_Uring_Reactor::open_poll_i");
+
+  // Initialize io_uring.  Every registered handle has at most one
+  // poll request in flight, and re-arming requests are queued until
+  // the next wait, so the submission queue does not need to be as
+  // large as the handler repository.  The completion queue should be
+  // able to hold one completion per handle; should it overflow
+  // anyway the kernel keeps the excess completions until there is
+  // room again.
+  size_t const sq_size =
+    ACE_MIN (size, static_cast<size_t> (ACE_URING_REACTOR_SQ_ENTRIES));
+  size_t const cq_size =
+    ACE_MIN (size, static_cast<size_t> (ACE_URING_REACTOR_CQ_ENTRIES));
+
+  return this->ring_.open (static_cast<unsigned int> (sq_size),
+                           static_cast<unsigned int> (cq_size));
+}
+
+int
+ACE_Uring_Reactor::close_poll_i (void)
+{
+  ACE_TRACE ("ACE_Uring_Reactor::close_poll_i");
+
+  if (!this->ring_.is_open ())
+    return 0;
+
+  return this->ring_.close ();
+}
+
+bool
+ACE_Uring_Reactor::io_event_ready_i (void)
+{
+  return this->ring_.cq_ready () > 0;
+}
+
+int
+ACE_Uring_Reactor::poll_i (ACE_Time_Value *this_timeout)
+{
+  ACE_TRACE ("ACE_Uring_Reactor::poll_i");
+
+  // Hand all poll requests queued since the last wait to the kernel
+  // and wait for an event in the same system call.  While this thread
+  // is blocked, threads changing registrations submit their requests
+  // themselves; see submit_i().
+  unsigned int to_submit = 0;
+  {
+    ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, grd, this->ring_lock_, -1);
+    to_submit = this->ring_.flush ();
+    this->waiting_ = true;
+  }
+
+  int const result = this->ring_.enter (to_submit, 1, this_timeout);
+  int const error = errno;
+
+  {
+    ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, grd, this->ring_lock_, -1);
+    this->waiting_ = false;
+  }
+
+  // A successful return only says how many requests were submitted,
+  // and an interrupted wait may still have submitted some.  The
+  // completion queue tells whether there is anything to dispatch.
+  if (this->ring_.cq_ready () > 0)
+    return 1;
+
+  if (result == -1 && error != ETIME)
+    {
+      errno = error;
+      return -1;
+    }
+
+  return 0;
+}
+
+int
+ACE_Uring_Reactor::arm_i (ACE_HANDLE handle, Event_Tuple *info)
+{
+  ACE_TRACE ("ACE_Uring_Reactor::arm_i");
+
+  // A poll request can't be modified in place, so cancel the
+  // outstanding one first.  Both requests reach the kernel in the
+  // same submission.
+  if (this->disarm_i (handle, info) == -1)
+    return -1;
+
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, grd, this->ring_lock_, -1);
+
+  struct io_uring_sqe *sqe = this->get_sqe_i ();
+  if (sqe == 0)
+    return -1;
+
+  // A new generation sets the request apart from any earlier one for
+  // the same handle. Generation 0 is reserved; see poll_user_data().
+  if (++info->generation == 0)
+    ++info->generation;
+
+  // The epoll event bits used by reactor_mask_to_poll_event() are
+  // those of poll(), which io_uring poll requests take.
+  ACE_IO_Uring::prep_poll_add (sqe,
+                               handle,
+                               static_cast<ACE_UINT32> (
+                                 this->reactor_mask_to_poll_event (info->mask)),
+                               poll_user_data (handle, info->generation));
+  info->controlled = true;
+
+  return this->submit_i ();
+}
+
+int
+ACE_Uring_Reactor::disarm_i (ACE_HANDLE handle, Event_Tuple *info)
+{
+  ACE_TRACE ("ACE_Uring_Reactor::disarm_i");
+
+  if (!info->controlled)
+    return 0;
+
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, grd, this->ring_lock_, -1);
+
+  struct io_uring_sqe *sqe = this->get_sqe_i ();
+  if (sqe == 0)
+    return -1;
+
+  ACE_IO_Uring::prep_poll_remove (sqe,
+                                  poll_user_data (handle, info->generation),
+                                  0);
+
+  // The removal itself is of no interest, so don't have it complete
+  // unless it fails (which it does if the request completed already).
+#if defined (IORING_FEAT_CQE_SKIP)
+  if (this->ring_.has_feature (IORING_FEAT_CQE_SKIP))
+    sqe->flags |= IOSQE_CQE_SKIP_SUCCESS;
+#endif /* IORING_FEAT_CQE_SKIP */
+
+  // The request may complete before the removal takes effect. Moving
+  // on to the next generation marks such a completion as stale.
+  if (++info->generation == 0)
+    ++info->generation;
+  info->controlled = false;
+
+  return this->submit_i ();
+}
+
+struct io_uring_sqe *
+ACE_Uring_Reactor::get_sqe_i (void)
+{
+  struct io_uring_sqe *sqe = this->ring_.get_sqe ();
+  if (sqe == 0)
+    {
+      // The submission queue is full; hand its content to the kernel
+      // to make room.
+      if (this->ring_.submit () == -1)
+        return 0;
+
+      sqe = this->ring_.get_sqe ();
+    }
+
+  return sqe;
+}
+
+int
+ACE_Uring_Reactor::submit_i (void)
+{
+  // If no thread is blocked in the kernel, the leader will submit the
+  // request along with all others queued until then when it next
+  // waits. Otherwise the request must go to the kernel now, or it
+  // would not take effect before that wait ends.
+  if (!this->waiting_)
+    return 0;
+
+  return this->ring_.submit () == -1 ? -1 : 0;
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif  /* ACE_HAS_IO_URING */
@@ -0,0 +1,203 @@
+// -*- C++ -*-
+
+// =========================================================================
+/**
+ *  @file    Uring_Reactor.h
+ *
+ *  Linux @c io_uring based Reactor implementation.
+ */
+// =========================================================================
+
+
+#ifndef ACE_URING_REACTOR_H
+#define ACE_URING_REACTOR_H
+
+#include /**/ "ace/pre.h"
+
+#include /**/ "ace/ACE_export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#if defined (ACE_HAS_IO_URING)
+
+#if !defined (ACE_HAS_EVENT_POLL) && !defined (ACE_HAS_DEV_POLL)
+#  error ACE_HAS_IO_URING requires ACE_HAS_EVENT_POLL or ACE_HAS_DEV_POLL.
+#endif  /* !ACE_HAS_EVENT_POLL && !ACE_HAS_DEV_POLL */
+
+#include "ace/Dev_Poll_Reactor.h"
+#include "ace/IO_Uring.h"
+
+#if !defined (ACE_URING_REACTOR_SQ_ENTRIES)
+// Maximum number of registration changes queued up before they are
+// handed to the kernel.
+# define ACE_URING_REACTOR_SQ_ENTRIES 1024
+#endif /* ACE_URING_REACTOR_SQ_ENTRIES */
+
+#if !defined (ACE_URING_REACTOR_CQ_ENTRIES)
+// Maximum number of ready events delivered by one wait.
+# define ACE_URING_REACTOR_CQ_ENTRIES 16384
+#endif /* ACE_URING_REACTOR_CQ_ENTRIES */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class ACE_Uring_Reactor
+ *
+ * @brief A Linux @c io_uring based Reactor implementation.
+ *
+ * The ACE_Uring_Reactor demultiplexes events with @c io_uring poll
+ * requests.  Everything else, i.e. the handler repository, the
+ * notification handler, the token, timers, suspension and the
+ * dispatching, is that of the ACE_Dev_Poll_Reactor, whose
+ * demultiplexer operations it overrides.  Its dispatching semantics
+ * are those of the epoll flavor of the ACE_Dev_Poll_Reactor: any
+ * number of threads may run the event loop, exactly one event is
+ * dispatched per handle_events() call, and a handler is implicitly
+ * suspended while its upcall runs.
+ *
+ * What it saves over epoll is system calls:
+ *
+ * - One @c io_uring_enter() call delivers every ready event into the
+ *   completion queue.  Subsequent iterations of the event loop, in
+ *   this or any other thread, simply reap the next completion from
+ *   shared memory without entering the kernel.
+ * - Registration changes made by the thread(s) running the event loop,
+ *   most notably re-arming a handler after its upcall, are only queued
+ *   in the submission queue.  They are handed to the kernel as part of
+ *   the next wait, i.e. re-arming costs no extra system call.  Changes
+ *   made while another thread is blocked in the kernel are submitted
+ *   immediately so that thread sees them.
+ * - The timeout for the nearest timer is passed to the same
+ *   @c io_uring_enter() call that submits and waits.
+ *
+ * Each registered handle has at most one oneshot @c IORING_OP_POLL_ADD
+ * request outstanding, which corresponds to the @c EPOLLONESHOT
+ * registration used by the ACE_Dev_Poll_Reactor.  Handler level
+ * multishot @c accept/recv requests are deliberately not used: the
+ * ACE_Event_Handler contract is readiness based, i.e. the handler
+ * itself performs the I/O.
+ *
+ * @note Requires Linux 5.11 or later.  open() fails with @c ENOTSUP on
+ *       older kernels, and with @c EPERM or @c ENOSYS where
+ *       @c io_uring is disabled, e.g. by a seccomp policy.
+ *
+ * @note Unlike the ACE_Dev_Poll_Reactor, timeouts are not rounded to
+ *       milliseconds.
+ */
+class ACE_Export ACE_Uring_Reactor : public ACE_Dev_Poll_Reactor
+{
+public:
+
+  /// Initialize @c ACE_Uring_Reactor with the default size.
+  /**
+   * The default size for the @c ACE_Uring_Reactor is the maximum
+   * number of open file descriptors for the process.
+   */
+  ACE_Uring_Reactor (ACE_Sig_Handler * = 0,
+                     ACE_Timer_Queue * = 0,
+                     int disable_notify_pipe = 0,
+                     ACE_Reactor_Notify *notify = 0,
+                     int mask_signals = 1,
+                     int s_queue = ACE_DEV_POLL_TOKEN::FIFO);
+
+  /// Initialize ACE_Uring_Reactor with size @a size.
+  /**
+   * @note See ACE_Dev_Poll_Reactor for the meaning of @a size.
+   */
+  ACE_Uring_Reactor (size_t size,
+                     bool restart = false,
+                     ACE_Sig_Handler * = 0,
+                     ACE_Timer_Queue * = 0,
+                     int disable_notify_pipe = 0,
+                     ACE_Reactor_Notify *notify = 0,
+                     int mask_signals = 1,
+                     int s_queue = ACE_DEV_POLL_TOKEN::FIFO);
+
+  /// Close down and release all resources.
+  virtual ~ACE_Uring_Reactor (void);
+
+  /// Dump the state of an object.
+  virtual void dump (void) const;
+
+  /// Declare the dynamic allocation hooks.
+  ACE_ALLOC_HOOK_DECLARE;
+
+protected:
+
+  /// Reap completions until one for the current poll request of a
+  /// registered handle turns up, and dispatch it.
+  virtual int dispatch_io_event (Token_Guard &guard);
+
+  /**
+   * @name Demultiplexer Operations
+   *
+   * The ACE_Dev_Poll_Reactor demultiplexer operations, on top of
+   * @c io_uring.
+   */
+  //@{
+
+  /// Set up the @c io_uring instance.
+  virtual int open_poll_i (size_t size);
+
+  /// Tear down the @c io_uring instance.
+  virtual int close_poll_i (void);
+
+  /// Returns true if the completion queue holds completions.
+  virtual bool io_event_ready_i (void);
+
+  /// Submit the queued poll requests and wait for a completion in
+  /// the same system call.
+  virtual int poll_i (ACE_Time_Value *timeout);
+
+  /// Queue a poll request for @a handle with the mask of @a info,
+  /// cancelling the outstanding one, if any.
+  virtual int arm_i (ACE_HANDLE handle, Event_Tuple *info);
+
+  /// Queue the cancellation of the outstanding poll request of
+  /// @a handle, if any.
+  virtual int disarm_i (ACE_HANDLE handle, Event_Tuple *info);
+
+  //@}
+
+  /// Obtain a free submission queue entry, submitting queued entries
+  /// first if the queue is full.  The caller must hold the ring lock.
+  struct io_uring_sqe *get_sqe_i (void);
+
+  /// Submit queued requests right away if a thread is currently
+  /// blocked waiting for completions, else leave them queued for the
+  /// next wait.  The caller must hold the ring lock.
+  int submit_i (void);
+
+  /// Build the user data identifying the poll request for @a handle.
+  static ACE_UINT64 poll_user_data (ACE_HANDLE handle, ACE_UINT32 generation);
+
+protected:
+
+  /// The @c io_uring instance used to demultiplex events.
+  ACE_IO_Uring ring_;
+
+  /// Lock serializing access to the submission queue of @c ring_.
+  /**
+   * The completion queue is only accessed by the thread holding the
+   * reactor token, so it needs no extra lock.
+   */
+  ACE_SYNCH_MUTEX ring_lock_;
+
+  /// True while a thread is blocked in the kernel waiting for
+  /// completions.  Protected by @c ring_lock_.
+  bool waiting_;
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#if defined (__ACE_INLINE__)
+# include "ace/Uring_Reactor.inl"
+#endif /* __ACE_INLINE__ */
+
+#endif  /* ACE_HAS_IO_URING */
+
+#include /**/ "ace/post.h"
+
+#endif  /* ACE_URING_REACTOR_H */
@@ -0,0 +1,13 @@
+// -*- C++ -*-
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_INLINE ACE_UINT64
+ACE_Uring_Reactor::poll_user_data (ACE_HANDLE handle, ACE_UINT32 generation)
+{
+  // Generation 0 is never used for a poll request, so user data 0 is
+  // free to tag requests whose completions are of no interest.
+  return (static_cast<ACE_UINT64> (handle) << 32) | generation;
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
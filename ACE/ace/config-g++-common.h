@@ -38,6 +38,12 @@
 # if __cplusplus > 201103L
 #  define ACE_HAS_CPP14
 # endif
+# if __cplusplus > 201402L
+#  define ACE_HAS_CPP17
+# endif
+# if __cplusplus > 201703L
+#  define ACE_HAS_CPP20
+# endif
 #endif
 
 #if (defined (i386) || defined (__i386__)) && !defined (ACE_SIZEOF_LONG_DOUBLE)
@@ -57,6 +63,15 @@
 # define ACE_HAS_INTEL_ASSEMBLY
 #endif
 
+#if (defined (__amd64__) || defined (__x86_64__)) \
+    && (defined (__clang__) \
+        || (__GNUC__ > 4) || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9)) \
+    && !defined (ACE_LACKS_CDR_SWAP_SIMD) && !defined (ACE_HAS_CDR_SWAP_SIMD)
+  // Byte swapping of CDR arrays uses SSSE3/AVX2 code selected at run
+  // time, compiled through the target function attribute.
+# define ACE_HAS_CDR_SWAP_SIMD
+#endif
+
 #if !defined (ACE_HAS_GCC_CONSTRUCTOR_ATTRIBUTE)
 #define ACE_HAS_GCC_CONSTRUCTOR_ATTRIBUTE 1
 #endif
@@ -377,6 +377,12 @@
 # endif
 #endif
 
+#if !defined (ACE_HAS_IO_URING) && !defined (ACE_LACKS_IO_URING)
+# if (LINUX_VERSION_CODE >= KERNEL_VERSION (5,11,0))
+#  define ACE_HAS_IO_URING
+# endif
+#endif
+
 #if (LINUX_VERSION_CODE >= KERNEL_VERSION(2,5,8))
 # define ACE_HAS_SCHED_GETAFFINITY 1
 # define ACE_HAS_SCHED_SETAFFINITY 1
@@ -0,0 +1,85 @@
+//=============================================================================
+/**
+ *  @file    log_decoder.cpp
+ *
+ *  Prints the messages stored in the files written by
+ *  ACE_Log_Msg_Binary, in the text format of ACE_Log_Msg.
+ */
+//=============================================================================
+
+#include "ace/Get_Opt.h"
+#include "ace/Log_Msg.h"
+#include "ace/Log_Msg_Binary.h"
+#include "ace/Log_Record.h"
+#include "ace/OS_NS_stdio.h"
+
+static void
+usage (const ACE_TCHAR *program)
+{
+  ACE_ERROR ((LM_ERROR,
+              ACE_TEXT ("usage: %s [-v | -l] file...\n")
+              ACE_TEXT ("  -v  print the timestamp, host, pid and ")
+              ACE_TEXT ("priority of each message\n")
+              ACE_TEXT ("  -l  print the timestamp and priority of ")
+              ACE_TEXT ("each message\n"),
+              program));
+}
+
+static int
+decode (const ACE_TCHAR *file_name, u_long verbose_flag)
+{
+  ACE_Log_Msg_Binary_Reader reader;
+  if (reader.open (file_name) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("%p\n"),
+                       file_name),
+                      -1);
+
+  ACE_Log_Record record;
+  int result = 0;
+  while ((result = reader.read (record)) == 1)
+    record.print (reader.host_name (), verbose_flag, stdout);
+
+  reader.close ();
+
+  if (result == -1)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("%s: corrupt record\n"),
+                       file_name),
+                      -1);
+  return 0;
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  u_long verbose_flag = 0;
+
+  ACE_Get_Opt get_opt (argc, argv, ACE_TEXT ("vl"));
+  for (int c; (c = get_opt ()) != -1; )
+    switch (c)
+      {
+      case 'v':
+        verbose_flag = ACE_Log_Msg::VERBOSE;
+        break;
+      case 'l':
+        verbose_flag = ACE_Log_Msg::VERBOSE_LITE;
+        break;
+      default:
+        usage (argv[0]);
+        return 1;
+      }
+
+  if (get_opt.opt_ind () >= argc)
+    {
+      usage (argv[0]);
+      return 1;
+    }
+
+  int status = 0;
+  for (int i = get_opt.opt_ind (); i < argc; ++i)
+    if (decode (argv[i], verbose_flag) == -1)
+      status = 1;
+
+  return status;
+}
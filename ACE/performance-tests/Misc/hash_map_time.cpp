@@ -0,0 +1,220 @@
+// This program compares ACE_Hash_Map_Manager_Ex with ACE_Open_Hash_Map,
+// both sized for the number of keys, with integer and string keys.
+// For each map it reports the average time to bind a key, to find a
+// key that is in the map and one that is not, and to unbind a key.
+// The keys are looked up in another order than they were bound in, so
+// that the lookups do not walk the memory in order.
+
+#include "ace/Log_Msg.h"
+#include "ace/Get_Opt.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/Hash_Map_Manager_T.h"
+#include "ace/Open_Hash_Map_T.h"
+#include "ace/Null_Mutex.h"
+#include "ace/SString.h"
+#include "ace/OS_Memory.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_stdlib.h"
+
+static const size_t DEFAULT_KEYS = 1000000;
+
+typedef ACE_Hash_Map_Manager_Ex<ACE_UINT32,
+                                ACE_UINT32,
+                                ACE_Hash<ACE_UINT32>,
+                                ACE_Equal_To<ACE_UINT32>,
+                                ACE_Null_Mutex> Chained_Int_Map;
+
+typedef ACE_Open_Hash_Map<ACE_UINT32,
+                          ACE_UINT32,
+                          ACE_Hash<ACE_UINT32>,
+                          ACE_Equal_To<ACE_UINT32>,
+                          ACE_Null_Mutex> Open_Int_Map;
+
+typedef ACE_Hash_Map_Manager_Ex<ACE_CString,
+                                ACE_UINT32,
+                                ACE_Hash<ACE_CString>,
+                                ACE_Equal_To<ACE_CString>,
+                                ACE_Null_Mutex> Chained_String_Map;
+
+typedef ACE_Open_Hash_Map<ACE_CString,
+                          ACE_UINT32,
+                          ACE_Hash<ACE_CString>,
+                          ACE_Equal_To<ACE_CString>,
+                          ACE_Null_Mutex> Open_String_Map;
+
+/// Small linear congruential generator, so every map sees the same
+/// keys.
+static ACE_UINT32
+next_random (ACE_UINT32 &seed)
+{
+  seed = seed * 1103515245 + 12345;
+  return seed >> 8;
+}
+
+static double
+nsecs_per_op (ACE_hrtime_t usecs, size_t ops)
+{
+  return ops == 0 ? 0.0 : static_cast<double> (usecs) * 1000.0 / ops;
+}
+
+/// Odd keys are bound, even keys are missing.
+static void
+make_keys (ACE_UINT32 *keys, size_t count)
+{
+  ACE_UINT32 seed = 42;
+  for (size_t i = 0; i < count; ++i)
+    keys[i] = (next_random (seed) << 1) | 1;
+}
+
+static void
+make_keys (ACE_CString *keys, size_t count)
+{
+  ACE_UINT32 seed = 42;
+  char buf[32];
+  for (size_t i = 0; i < count; ++i)
+    {
+      ACE_OS::sprintf (buf, "object-%u-%u", next_random (seed), 1u);
+      keys[i] = buf;
+    }
+}
+
+static ACE_UINT32
+missing_key (const ACE_UINT32 &key)
+{
+  return key - 1;
+}
+
+static ACE_CString
+missing_key (const ACE_CString &key)
+{
+  ACE_CString missing (key);
+  missing[missing.length () - 1] = '0';
+  return missing;
+}
+
+template <class MAP, class KEY>
+static void
+run (const ACE_TCHAR *name, const KEY *keys, size_t count)
+{
+  MAP map (count);
+
+  // The lookups visit the keys with a stride, and the missing keys are
+  // made in advance so that only the lookups are timed.
+  size_t const stride = 7919;
+  KEY *missing = 0;
+  ACE_NEW (missing, KEY[count]);
+  for (size_t i = 0; i < count; ++i)
+    missing[i] = missing_key (keys[i]);
+
+  ACE_High_Res_Timer timer;
+  ACE_hrtime_t bind_usecs = 0;
+  ACE_hrtime_t hit_usecs = 0;
+  ACE_hrtime_t miss_usecs = 0;
+  ACE_hrtime_t unbind_usecs = 0;
+  size_t bound = 0;
+  size_t hits = 0;
+  size_t misses = 0;
+
+  timer.start ();
+  for (size_t i = 0; i < count; ++i)
+    if (map.bind (keys[i], static_cast<ACE_UINT32> (i)) == 0)
+      ++bound;
+  timer.stop ();
+  timer.elapsed_microseconds (bind_usecs);
+
+  timer.reset ();
+  timer.start ();
+  for (size_t i = 0, k = 0; i < count; ++i, k = (k + stride) % count)
+    {
+      ACE_UINT32 value = 0;
+      if (map.find (keys[k], value) == 0)
+        ++hits;
+    }
+  timer.stop ();
+  timer.elapsed_microseconds (hit_usecs);
+
+  timer.reset ();
+  timer.start ();
+  for (size_t i = 0, k = 0; i < count; ++i, k = (k + stride) % count)
+    {
+      ACE_UINT32 value = 0;
+      if (map.find (missing[k], value) != 0)
+        ++misses;
+    }
+  timer.stop ();
+  timer.elapsed_microseconds (miss_usecs);
+
+  timer.reset ();
+  timer.start ();
+  for (size_t i = 0, k = 0; i < count; ++i, k = (k + stride) % count)
+    map.unbind (keys[k]);
+  timer.stop ();
+  timer.elapsed_microseconds (unbind_usecs);
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("%-32s bind %7.1f ns  find %7.1f ns  ")
+              ACE_TEXT ("miss %7.1f ns  unbind %7.1f ns  (%B/%B/%B)\n"),
+              name,
+              nsecs_per_op (bind_usecs, count),
+              nsecs_per_op (hit_usecs, count),
+              nsecs_per_op (miss_usecs, count),
+              nsecs_per_op (unbind_usecs, count),
+              bound,
+              hits,
+              misses));
+
+  delete [] missing;
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opt (argc, argv, ACE_TEXT ("n:"));
+
+  size_t count = DEFAULT_KEYS;
+  int c;
+
+  while ((c = get_opt ()) != -1)
+    switch (c)
+      {
+      case 'n':
+        count = ACE_OS::strtoul (get_opt.opt_arg (), 0, 10);
+        break;
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage: hash_map_time [-n keys]\n"),
+                          -1);
+      }
+
+  if (count == 0)
+    ACE_ERROR_RETURN ((LM_ERROR, "Invalid key count\n"), -1);
+
+  ACE_DEBUG ((LM_DEBUG,
+              "%B keys, %d control bytes probed at a time\n",
+              count,
+              static_cast<int> (ACE_Open_Hash_Map_Group::WIDTH)));
+
+  ACE_UINT32 *int_keys = 0;
+  ACE_NEW_RETURN (int_keys, ACE_UINT32[count], -1);
+  make_keys (int_keys, count);
+
+  run<Chained_Int_Map> (ACE_TEXT ("ACE_Hash_Map_Manager_Ex<int>"),
+                        int_keys, count);
+  run<Open_Int_Map> (ACE_TEXT ("ACE_Open_Hash_Map<int>"),
+                     int_keys, count);
+
+  delete [] int_keys;
+
+  ACE_CString *string_keys = 0;
+  ACE_NEW_RETURN (string_keys, ACE_CString[count], -1);
+  make_keys (string_keys, count);
+
+  run<Chained_String_Map> (ACE_TEXT ("ACE_Hash_Map_Manager_Ex<string>"),
+                           string_keys, count);
+  run<Open_String_Map> (ACE_TEXT ("ACE_Open_Hash_Map<string>"),
+                        string_keys, count);
+
+  delete [] string_keys;
+
+  return 0;
+}
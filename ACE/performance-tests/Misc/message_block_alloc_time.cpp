@@ -0,0 +1,175 @@
+// This program compares allocators used for the message blocks of a
+// multi-threaded server.  Every thread repeatedly creates a message
+// block the way TAO's CDR streams do, taking the ACE_Message_Block,
+// the ACE_Data_Block and the buffer from the allocator, grows it once
+// like a CDR stream marshaling a large request, and releases it.  With
+// -x the blocks are released by the next thread instead, like a
+// message read by the reactor thread and handled by a worker.  For
+// each allocator it reports the average time for one message.
+
+#include "ace/Log_Msg.h"
+#include "ace/Atomic_Op.h"
+#include "ace/Barrier.h"
+#include "ace/CDR_Base.h"
+#include "ace/Get_Opt.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/Local_Memory_Pool.h"
+#include "ace/Malloc_T.h"
+#include "ace/Message_Block.h"
+#include "ace/Thread_Cached_Allocator.h"
+#include "ace/Thread_Manager.h"
+#include "ace/Thread_Mutex.h"
+#include "ace/OS_NS_stdlib.h"
+
+static const size_t MAX_THREADS = 64;
+static const size_t BATCH = 64;
+
+static size_t n_threads = 4;
+static size_t iterations = 200000;
+static bool exchange = false;
+
+/// What the threads share while one allocator is measured.
+struct Run
+{
+  Run (ACE_Allocator *allocator)
+    : allocator_ (allocator),
+      barrier_ (n_threads)
+  {
+  }
+
+  ACE_Allocator *allocator_;
+  ACE_Barrier barrier_;
+
+  /// The blocks each thread hands to the next one with -x.
+  ACE_Message_Block *batches_[MAX_THREADS][BATCH];
+};
+
+// Create message <i>; one message in eight outgrows its first buffer.
+static ACE_Message_Block *
+create (ACE_Allocator *allocator, size_t i)
+{
+  ACE_Message_Block *mb = 0;
+  ACE_NEW_MALLOC_RETURN (mb,
+                         static_cast<ACE_Message_Block *> (
+                           allocator->malloc (sizeof (ACE_Message_Block))),
+                         ACE_Message_Block (ACE_CDR::DEFAULT_BUFSIZE
+                                              + ACE_CDR::MAX_ALIGNMENT,
+                                            ACE_Message_Block::MB_DATA,
+                                            0,
+                                            0,
+                                            allocator,
+                                            0,
+                                            ACE_DEFAULT_MESSAGE_BLOCK_PRIORITY,
+                                            ACE_Time_Value::zero,
+                                            ACE_Time_Value::max_time,
+                                            allocator,
+                                            allocator),
+                         0);
+  mb->wr_ptr (64);
+
+  if ((i & 7) == 0)
+    mb->size (2 * ACE_CDR::DEFAULT_BUFSIZE + ACE_CDR::MAX_ALIGNMENT);
+
+  return mb;
+}
+
+static ACE_THR_FUNC_RETURN
+worker (void *arg)
+{
+  Run &run = *static_cast<Run *> (arg);
+
+  static ACE_Atomic_Op<ACE_Thread_Mutex, long> next_index;
+  size_t const self = static_cast<size_t> (next_index++) % n_threads;
+  size_t const previous = (self + n_threads - 1) % n_threads;
+
+  if (!exchange)
+    {
+      for (size_t i = 0; i < iterations; ++i)
+        create (run.allocator_, i)->release ();
+      return 0;
+    }
+
+  for (size_t i = 0; i < iterations; i += BATCH)
+    {
+      for (size_t b = 0; b < BATCH; ++b)
+        run.batches_[self][b] = create (run.allocator_, b);
+      run.barrier_.wait ();
+      for (size_t b = 0; b < BATCH; ++b)
+        run.batches_[previous][b]->release ();
+      run.barrier_.wait ();
+    }
+
+  return 0;
+}
+
+static void
+measure (ACE_Allocator *allocator, const ACE_TCHAR *name)
+{
+  Run *run = 0;
+  ACE_NEW (run, Run (allocator));
+
+  ACE_High_Res_Timer timer;
+  timer.start ();
+  ACE_Thread_Manager::instance ()->spawn_n (n_threads, worker, run);
+  ACE_Thread_Manager::instance ()->wait ();
+  timer.stop ();
+
+  ACE_hrtime_t usecs = 0;
+  timer.elapsed_microseconds (usecs);
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("%-36s %8.1f ns/message\n"),
+              name,
+              static_cast<double> (usecs) * 1000.0
+                / static_cast<double> (n_threads * iterations)));
+
+  delete run;
+  delete allocator;
+}
+
+typedef ACE_Allocator_Adapter<ACE_Malloc<ACE_LOCAL_MEMORY_POOL,
+                                         ACE_Thread_Mutex> > LOCAL_MEMORY_POOL;
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opt (argc, argv, ACE_TEXT ("t:n:x"));
+  int c;
+
+  while ((c = get_opt ()) != -1)
+    switch (c)
+      {
+      case 't':
+        n_threads = ACE_OS::strtoul (get_opt.opt_arg (), 0, 10);
+        break;
+      case 'n':
+        iterations = ACE_OS::strtoul (get_opt.opt_arg (), 0, 10);
+        break;
+      case 'x':
+        exchange = true;
+        break;
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage: message_block_alloc_time [-t threads]"
+                           " [-n messages per thread] [-x]\n"),
+                          -1);
+      }
+
+  if (n_threads == 0 || n_threads > MAX_THREADS)
+    ACE_ERROR_RETURN ((LM_ERROR, "Invalid thread count\n"), -1);
+
+  ACE_DEBUG ((LM_DEBUG,
+              "%B threads, %B messages each%s\n",
+              n_threads,
+              iterations,
+              exchange ? ", released by another thread" : ""));
+
+  measure (new ACE_New_Allocator,
+           ACE_TEXT ("ACE_New_Allocator"));
+  measure (new LOCAL_MEMORY_POOL,
+           ACE_TEXT ("ACE_Malloc<ACE_LOCAL_MEMORY_POOL>"));
+  measure (new ACE_Thread_Cached_Allocator,
+           ACE_TEXT ("ACE_Thread_Cached_Allocator"));
+
+  return 0;
+}
@@ -0,0 +1,189 @@
+// This program measures how often ACE_CString goes to its allocator
+// for the strings ACE and TAO handle most: dotted addresses, host and
+// port pairs, hex object ids built a character at a time, and copies
+// of them.  Long corbaloc URLs are measured too, for comparison.  For
+// each operation it reports the allocations and the average time per
+// string.  Strings shorter than ACE_STRING_BASE_INLINE_SIZE are kept
+// inside the object; build with ACE_STRING_BASE_INLINE_SIZE defined
+// to 1 to see how every string allocated before.
+
+#include "ace/Log_Msg.h"
+#include "ace/Get_Opt.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/Malloc_Allocator.h"
+#include "ace/SString.h"
+#include "ace/OS_Memory.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_stdlib.h"
+
+static const size_t DEFAULT_STRINGS = 1000000;
+static const size_t TEXT_SIZE = 64;
+
+/// Counts the buffers the strings take from it.
+class Counting_Allocator : public ACE_New_Allocator
+{
+public:
+  Counting_Allocator (void) : mallocs_ (0) {}
+
+  virtual void *malloc (size_t nbytes)
+  {
+    ++this->mallocs_;
+    return ACE_New_Allocator::malloc (nbytes);
+  }
+
+  size_t mallocs_;
+};
+
+/// Small linear congruential generator, so every run sees the same
+/// strings.
+static ACE_UINT32
+next_random (ACE_UINT32 &seed)
+{
+  seed = seed * 1103515245 + 12345;
+  return seed >> 8;
+}
+
+static double
+nsecs_per_op (ACE_hrtime_t usecs, size_t ops)
+{
+  return ops == 0 ? 0.0 : static_cast<double> (usecs) * 1000.0 / ops;
+}
+
+static void
+report (const char *name,
+        Counting_Allocator &allocator,
+        ACE_hrtime_t usecs,
+        size_t count)
+{
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("%-14C %9B allocations  %5.2f per string  %7.1f ns\n"),
+              name,
+              allocator.mallocs_,
+              static_cast<double> (allocator.mallocs_) / count,
+              nsecs_per_op (usecs, count)));
+  allocator.mallocs_ = 0;
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opt (argc, argv, ACE_TEXT ("n:"));
+
+  size_t count = DEFAULT_STRINGS;
+  int c;
+
+  while ((c = get_opt ()) != -1)
+    switch (c)
+      {
+      case 'n':
+        count = ACE_OS::strtoul (get_opt.opt_arg (), 0, 10);
+        break;
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage: string_alloc_time [-n strings]\n"),
+                          -1);
+      }
+
+  if (count == 0)
+    ACE_ERROR_RETURN ((LM_ERROR, "Invalid string count\n"), -1);
+
+  ACE_DEBUG ((LM_DEBUG,
+              "%B strings, up to %d characters kept inline\n",
+              count,
+              ACE_STRING_BASE_INLINE_SIZE - 1));
+
+  // The texts are made in advance so that only the strings are timed.
+  char (*hosts)[TEXT_SIZE] = 0;
+  char (*ports)[TEXT_SIZE] = 0;
+  char (*urls)[TEXT_SIZE] = 0;
+  ACE_NEW_RETURN (hosts, char[count][TEXT_SIZE], -1);
+  ACE_NEW_RETURN (ports, char[count][TEXT_SIZE], -1);
+  ACE_NEW_RETURN (urls, char[count][TEXT_SIZE], -1);
+
+  ACE_UINT32 seed = 42;
+  for (size_t i = 0; i < count; ++i)
+    {
+      ACE_UINT32 const r = next_random (seed);
+      ACE_OS::sprintf (hosts[i], "10.%u.%u.%u",
+                       r & 0xff, (r >> 8) & 0xff, (r >> 16) & 0xff);
+      ACE_OS::sprintf (ports[i], "%u", 1024 + r % 60000);
+      ACE_OS::sprintf (urls[i], "corbaloc:iiop:%s:%s/NameService",
+                       hosts[i], ports[i]);
+    }
+
+  Counting_Allocator allocator;
+  ACE_High_Res_Timer timer;
+  ACE_hrtime_t usecs = 0;
+  size_t total = 0;
+
+  timer.start ();
+  for (size_t i = 0; i < count; ++i)
+    {
+      ACE_CString host (hosts[i], &allocator);
+      total += host.length ();
+    }
+  timer.stop ();
+  timer.elapsed_microseconds (usecs);
+  report ("construct", allocator, usecs, count);
+
+  ACE_CString host (hosts[0], &allocator);
+  allocator.mallocs_ = 0;
+  timer.reset ();
+  timer.start ();
+  for (size_t i = 0; i < count; ++i)
+    {
+      host = hosts[i];
+      ACE_CString copy (host);
+      total += copy.length ();
+    }
+  timer.stop ();
+  timer.elapsed_microseconds (usecs);
+  report ("assign+copy", allocator, usecs, count);
+
+  timer.reset ();
+  timer.start ();
+  for (size_t i = 0; i < count; ++i)
+    {
+      ACE_CString address (hosts[i], &allocator);
+      address += ':';
+      address += ports[i];
+      total += address.length ();
+    }
+  timer.stop ();
+  timer.elapsed_microseconds (usecs);
+  report ("host:port", allocator, usecs, count);
+
+  static const char digits[] = "0123456789abcdef";
+  timer.reset ();
+  timer.start ();
+  for (size_t i = 0; i < count; ++i)
+    {
+      ACE_CString id (&allocator);
+      for (size_t d = 0; d < 16; ++d)
+        id += digits[(i >> (d % 8 * 4)) & 0xf];
+      total += id.length ();
+    }
+  timer.stop ();
+  timer.elapsed_microseconds (usecs);
+  report ("hex id", allocator, usecs, count);
+
+  timer.reset ();
+  timer.start ();
+  for (size_t i = 0; i < count; ++i)
+    {
+      ACE_CString url (urls[i], &allocator);
+      ACE_CString copy (url);
+      total += copy.length ();
+    }
+  timer.stop ();
+  timer.elapsed_microseconds (usecs);
+  report ("long url+copy", allocator, usecs, count);
+
+  ACE_DEBUG ((LM_DEBUG, "%B characters\n", total));
+
+  delete [] hosts;
+  delete [] ports;
+  delete [] urls;
+
+  return 0;
+}
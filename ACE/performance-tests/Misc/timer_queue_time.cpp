@@ -0,0 +1,195 @@
+// This program compares the timer queue implementations with a load
+// like the per-connection idle and retry timers of a busy server: a
+// large number of timers spread over an hour, most of which are
+// cancelled and scheduled again before they expire.  For each queue
+// it reports the average time to schedule a timer and to cancel and
+// reschedule one ("churn"), and the time spent in expire() while the
+// hour goes by.
+
+#include "ace/Log_Msg.h"
+#include "ace/Get_Opt.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/Event_Handler.h"
+#include "ace/Recursive_Thread_Mutex.h"
+#include "ace/Timer_Heap.h"
+#include "ace/Timer_Wheel.h"
+#include "ace/Timer_Hash.h"
+#include "ace/Timer_List.h"
+#include "ace/Timer_Hierarchical_Wheel.h"
+#include "ace/OS_Memory.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_sys_time.h"
+
+static const size_t DEFAULT_TIMERS = 100000;
+static const ACE_UINT32 SPAN_MSECS = 3600 * 1000;
+static const ACE_UINT32 STEP_MSECS = 10;
+
+/// Counts the timeouts.
+class Handler : public ACE_Event_Handler
+{
+public:
+  Handler (void) : count_ (0) {}
+
+  virtual int handle_timeout (const ACE_Time_Value &, const void *)
+  {
+    ++this->count_;
+    return 0;
+  }
+
+  size_t count_;
+};
+
+/// Small linear congruential generator, so every queue sees the same
+/// sequence of timers.
+static ACE_UINT32
+next_random (ACE_UINT32 &seed)
+{
+  seed = seed * 1103515245 + 12345;
+  return seed >> 8;
+}
+
+static ACE_Time_Value
+after (const ACE_Time_Value &start, ACE_UINT32 msecs)
+{
+  ACE_Time_Value offset;
+  offset.msec (static_cast<long> (msecs));
+  return start + offset;
+}
+
+static double
+nsecs_per_op (ACE_hrtime_t usecs, size_t ops)
+{
+  return ops == 0 ? 0.0 : static_cast<double> (usecs) * 1000.0 / ops;
+}
+
+static void
+run (ACE_Timer_Queue *queue,
+     const ACE_TCHAR *name,
+     size_t timers,
+     size_t churn)
+{
+  Handler handler;
+  long *ids = 0;
+  ACE_NEW (ids, long[timers]);
+
+  ACE_Time_Value const start = ACE_OS::gettimeofday ();
+  ACE_UINT32 seed = 42;
+
+  ACE_High_Res_Timer timer;
+  ACE_hrtime_t schedule_usecs = 0;
+  ACE_hrtime_t churn_usecs = 0;
+  ACE_hrtime_t expire_usecs = 0;
+
+  timer.start ();
+  for (size_t i = 0; i < timers; ++i)
+    ids[i] = queue->schedule (&handler,
+                              0,
+                              after (start, next_random (seed) % SPAN_MSECS));
+  timer.stop ();
+  timer.elapsed_microseconds (schedule_usecs);
+
+  // Connections that see traffic push their idle timer back.
+  timer.reset ();
+  timer.start ();
+  for (size_t i = 0; i < churn; ++i)
+    {
+      size_t const victim = next_random (seed) % timers;
+      queue->cancel (ids[victim]);
+
+      ids[victim] = queue->schedule (&handler,
+                                     0,
+                                     after (start, next_random (seed) % SPAN_MSECS));
+    }
+  timer.stop ();
+  timer.elapsed_microseconds (churn_usecs);
+
+  // Let the hour go by, like a reactor waking up every few
+  // milliseconds.
+  timer.reset ();
+  timer.start ();
+  for (ACE_UINT32 msecs = 0; msecs <= SPAN_MSECS; msecs += STEP_MSECS)
+    queue->expire (after (start, msecs));
+  timer.stop ();
+  timer.elapsed_microseconds (expire_usecs);
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("%-44s schedule %8.1f ns  churn %8.1f ns  ")
+              ACE_TEXT ("expire %8.1f ms  (%B expired)\n"),
+              name,
+              nsecs_per_op (schedule_usecs, timers),
+              nsecs_per_op (churn_usecs, churn),
+              static_cast<double> (expire_usecs) / 1000.0,
+              handler.count_));
+
+  delete [] ids;
+  delete queue;
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opt (argc, argv, ACE_TEXT ("n:c:lh"));
+
+  size_t timers = DEFAULT_TIMERS;
+  size_t churn = 0;
+  bool list = false;
+  bool hash = false;
+  int c;
+
+  while ((c = get_opt ()) != -1)
+    switch (c)
+      {
+      case 'n':
+        timers = ACE_OS::strtoul (get_opt.opt_arg (), 0, 10);
+        break;
+      case 'c':
+        churn = ACE_OS::strtoul (get_opt.opt_arg (), 0, 10);
+        break;
+      case 'l':
+        // Scheduling is O(n) in ACE_Timer_List, so it is only run on
+        // request.
+        list = true;
+        break;
+      case 'h':
+        // ACE_Timer_Hash does not cope with timer counts this large
+        // yet, so it is only run on request as well.
+        hash = true;
+        break;
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage: timer_queue_time [-n timers]"
+                           " [-c cancel/reschedule count] [-l] [-h]\n"),
+                          -1);
+      }
+
+  if (timers == 0)
+    ACE_ERROR_RETURN ((LM_ERROR, "Invalid timer count\n"), -1);
+
+  if (churn == 0)
+    churn = timers;
+
+  ACE_DEBUG ((LM_DEBUG,
+              "%B timers over %u seconds, %B cancel/reschedule\n",
+              timers,
+              SPAN_MSECS / 1000,
+              churn));
+
+  run (new ACE_Timer_Heap (timers, true),
+       ACE_TEXT ("ACE_Timer_Heap (preallocated)"), timers, churn);
+  run (new ACE_Timer_Wheel (ACE_DEFAULT_TIMER_WHEEL_SIZE,
+                            ACE_DEFAULT_TIMER_WHEEL_RESOLUTION,
+                            timers),
+       ACE_TEXT ("ACE_Timer_Wheel (preallocated)"), timers, churn);
+  if (hash)
+    run (new ACE_Timer_Hash,
+         ACE_TEXT ("ACE_Timer_Hash"), timers, churn);
+  if (list)
+    run (new ACE_Timer_List,
+         ACE_TEXT ("ACE_Timer_List"), timers, churn);
+  run (new ACE_Timer_Hierarchical_Wheel (ACE_DEFAULT_TIMER_HIERARCHICAL_WHEEL_RESOLUTION,
+                                         timers),
+       ACE_TEXT ("ACE_Timer_Hierarchical_Wheel (preallocated)"),
+       timers, churn);
+
+  return 0;
+}
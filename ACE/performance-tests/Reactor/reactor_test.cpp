@@ -0,0 +1,293 @@
+//=============================================================================
+/**
+ *  @file   reactor_test.cpp
+ *
+ * Measures the event dispatching throughput of the thread-pool
+ * reactors.  A number of connected socket pairs play ping-pong, every
+ * message being one read event and one handler upcall.  Additional
+ * idle connections can be registered to show how the cost per event
+ * depends on the number of handles the reactor watches.
+ */
+//=============================================================================
+
+#include "ace/Reactor.h"
+#include "ace/Select_Reactor.h"
+#include "ace/TP_Reactor.h"
+#include "ace/Dev_Poll_Reactor.h"
+#include "ace/Uring_Reactor.h"
+#include "ace/Atomic_Op.h"
+#include "ace/Auto_Ptr.h"
+#include "ace/Pipe.h"
+#include "ace/ACE.h"
+#include "ace/Get_Opt.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/Thread_Manager.h"
+#include "ace/OS_main.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_unistd.h"
+
+static const int MAXMSGSZ = 1024;
+
+static int active_count = 16;
+static int idle_count = 0;
+static int iterations = 10000;
+static int msgsz = 32;
+static int thread_count = 4;
+static const ACE_TCHAR *reactor_type = ACE_TEXT ("tp");
+
+static ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> active_left (0);
+
+static void
+usage (void)
+{
+  ACE_ERROR ((LM_ERROR,
+              "reactor_test\n"
+              "  [-r select|tp|dev_poll|uring]  (Reactor to use)\n"
+              "  [-c active connections]\n"
+              "  [-a additional idle connections]\n"
+              "  [-i round trips per connection]\n"
+              "  [-m message size]\n"
+              "  [-t number of threads]\n"));
+}
+
+// ****************************************************************
+
+/**
+ * One end of a connection; echoes every message it receives until the
+ * requested number of round trips has been made.
+ */
+class Ping_Pong : public ACE_Event_Handler
+{
+public:
+  Ping_Pong (ACE_Reactor *reactor, ACE_HANDLE handle, int rounds);
+
+  // = Override <ACE_Event_Handler> methods.
+  virtual ACE_HANDLE get_handle (void) const;
+  virtual int handle_input (ACE_HANDLE);
+
+  /// Send the first message.
+  int start (void);
+
+private:
+  ACE_HANDLE handle_;
+
+  /// Round trips left to make; 0 makes this end passive.
+  int rounds_;
+
+  char buf_[MAXMSGSZ];
+};
+
+Ping_Pong::Ping_Pong (ACE_Reactor *reactor, ACE_HANDLE handle, int rounds)
+  : ACE_Event_Handler (reactor),
+    handle_ (handle),
+    rounds_ (rounds)
+{
+  ACE_OS::memset (this->buf_, 'x', sizeof this->buf_);
+}
+
+ACE_HANDLE
+Ping_Pong::get_handle (void) const
+{
+  return this->handle_;
+}
+
+int
+Ping_Pong::start (void)
+{
+  return ACE::send_n (this->handle_, this->buf_, msgsz) == msgsz ? 0 : -1;
+}
+
+int
+Ping_Pong::handle_input (ACE_HANDLE)
+{
+  if (ACE::recv_n (this->handle_, this->buf_, msgsz) != msgsz)
+    ACE_ERROR_RETURN ((LM_ERROR, "%p\n", "recv_n"), -1);
+
+  if (this->rounds_ > 0 && --this->rounds_ == 0)
+    {
+      // This connection is done.
+      if (--active_left == 0)
+        this->reactor ()->end_reactor_event_loop ();
+      return 0;
+    }
+
+  if (ACE::send_n (this->handle_, this->buf_, msgsz) != msgsz)
+    ACE_ERROR_RETURN ((LM_ERROR, "%p\n", "send_n"), -1);
+
+  return 0;
+}
+
+// ****************************************************************
+
+static ACE_THR_FUNC_RETURN
+event_loop (void *arg)
+{
+  ACE_Reactor *reactor = static_cast<ACE_Reactor *> (arg);
+
+  reactor->owner (ACE_OS::thr_self ());
+  reactor->run_reactor_event_loop ();
+
+  return 0;
+}
+
+static ACE_Reactor_Impl *
+make_reactor (size_t size)
+{
+  ACE_Reactor_Impl *impl = 0;
+
+  if (ACE_OS::strcmp (reactor_type, ACE_TEXT ("select")) == 0)
+    {
+      ACE_NEW_RETURN (impl, ACE_Select_Reactor (size), 0);
+      thread_count = 1;
+    }
+  else if (ACE_OS::strcmp (reactor_type, ACE_TEXT ("tp")) == 0)
+    ACE_NEW_RETURN (impl, ACE_TP_Reactor (size), 0);
+#if defined (ACE_HAS_EVENT_POLL) || defined (ACE_HAS_DEV_POLL)
+  else if (ACE_OS::strcmp (reactor_type, ACE_TEXT ("dev_poll")) == 0)
+    ACE_NEW_RETURN (impl, ACE_Dev_Poll_Reactor (size), 0);
+#endif /* ACE_HAS_EVENT_POLL || ACE_HAS_DEV_POLL */
+#if defined (ACE_HAS_IO_URING)
+  else if (ACE_OS::strcmp (reactor_type, ACE_TEXT ("uring")) == 0)
+    ACE_NEW_RETURN (impl, ACE_Uring_Reactor (size), 0);
+#endif /* ACE_HAS_IO_URING */
+  else
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       "Reactor type <%s> is not supported\n",
+                       reactor_type),
+                      0);
+
+  return impl;
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opt (argc, argv, ACE_TEXT ("r:c:a:i:m:t:"));
+  int c;
+
+  while ((c = get_opt ()) != -1)
+    {
+      switch ((char) c)
+        {
+        case 'r':
+          reactor_type = get_opt.opt_arg ();
+          break;
+
+        case 'c':
+          active_count = ACE_OS::atoi (get_opt.opt_arg ());
+          break;
+
+        case 'a':
+          idle_count = ACE_OS::atoi (get_opt.opt_arg ());
+          break;
+
+        case 'i':
+          iterations = ACE_OS::atoi (get_opt.opt_arg ());
+          break;
+
+        case 'm':
+          msgsz = ACE_OS::atoi (get_opt.opt_arg ());
+          break;
+
+        case 't':
+          thread_count = ACE_OS::atoi (get_opt.opt_arg ());
+          break;
+
+        default:
+          usage ();
+          return 1;
+        }
+    }
+
+  if (active_count < 1 || idle_count < 0 || iterations < 1
+      || msgsz < 1 || msgsz > MAXMSGSZ || thread_count < 1)
+    {
+      usage ();
+      return 1;
+    }
+
+  int const pair_count = active_count + idle_count;
+
+  ACE_Reactor_Impl *impl = make_reactor (2 * pair_count + 16);
+  if (impl == 0)
+    return 1;
+
+  ACE_Reactor reactor (impl, 1);
+  if (!impl->initialized ())
+    ACE_ERROR_RETURN ((LM_ERROR, "%p\n", "reactor open"), 1);
+
+  ACE_Pipe *pipes = 0;
+  ACE_NEW_RETURN (pipes, ACE_Pipe[pair_count], 1);
+  ACE_Auto_Array_Ptr<ACE_Pipe> pipes_guard (pipes);
+
+  Ping_Pong **handlers = 0;
+  ACE_NEW_RETURN (handlers, Ping_Pong *[2 * pair_count], 1);
+  ACE_Auto_Array_Ptr<Ping_Pong *> handlers_guard (handlers);
+
+  for (int i = 0; i < pair_count; ++i)
+    {
+      if (pipes[i].open () != 0)
+        ACE_ERROR_RETURN ((LM_ERROR, "%p\n", "pipe"), 1);
+
+      ACE_NEW_RETURN (handlers[2 * i],
+                      Ping_Pong (&reactor,
+                                 pipes[i].read_handle (),
+                                 i < active_count ? iterations : 0),
+                      1);
+      ACE_NEW_RETURN (handlers[2 * i + 1],
+                      Ping_Pong (&reactor, pipes[i].write_handle (), 0),
+                      1);
+
+      for (int j = 2 * i; j <= 2 * i + 1; ++j)
+        if (reactor.register_handler (handlers[j],
+                                      ACE_Event_Handler::READ_MASK) == -1)
+          ACE_ERROR_RETURN ((LM_ERROR, "%p\n", "register_handler"), 1);
+    }
+
+  active_left = active_count;
+
+  ACE_High_Res_Timer timer;
+  timer.start ();
+
+  for (int i = 0; i < active_count; ++i)
+    if (handlers[2 * i]->start () != 0)
+      ACE_ERROR_RETURN ((LM_ERROR, "%p\n", "start"), 1);
+
+  if (ACE_Thread_Manager::instance ()->spawn_n (thread_count,
+                                                event_loop,
+                                                &reactor) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, "%p\n", "spawn_n"), 1);
+
+  ACE_Thread_Manager::instance ()->wait ();
+  timer.stop ();
+
+  ACE_hrtime_t usecs;
+  timer.elapsed_microseconds (usecs);
+
+  // Each round trip is two upcalls.
+  double const events = 2.0 * active_count * iterations;
+  double const secs = static_cast<double> (usecs) / 1000000.0;
+
+  ACE_DEBUG ((LM_DEBUG,
+              "reactor = %s, threads = %d, active = %d, idle = %d\n"
+              "%.0f events in %.3f seconds: %.0f events/sec, "
+              "%.2f usec/event\n",
+              reactor_type,
+              thread_count,
+              active_count,
+              idle_count,
+              events,
+              secs,
+              secs > 0 ? events / secs : 0.0,
+              events > 0 ? static_cast<double> (usecs) / events : 0.0));
+
+  for (int i = 0; i < 2 * pair_count; ++i)
+    {
+      reactor.remove_handler (handlers[i],
+                              ACE_Event_Handler::ALL_EVENTS_MASK
+                              | ACE_Event_Handler::DONT_CALL);
+      delete handlers[i];
+    }
+
+  return 0;
+}
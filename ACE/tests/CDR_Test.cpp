@@ -763,6 +763,79 @@ CDR_Test_Types::test_get_placeholder (ACE_InputCDR &cdr) const
 }
 
 
+// Compare the array swaps against the element swaps for all lengths
+// up to a few vectors and all source/target misalignments.
+static int
+swap_arrays (void)
+{
+  static size_t const max_elements = 80;
+  static size_t const buffer_size = 16 * max_elements + 16;
+
+  char orig[buffer_size];
+  char target[buffer_size];
+  char expected[buffer_size];
+
+  for (size_t i = 0; i < buffer_size; ++i)
+    orig[i] = static_cast<char> (i * 7 + 1);
+
+  for (size_t size = 2; size <= 16; size *= 2)
+    for (size_t n = 1; n <= max_elements; ++n)
+      for (size_t orig_off = 0; orig_off < 16; orig_off += 2)
+        for (size_t target_off = 0; target_off < 16; target_off += 2)
+          {
+            char const *src = orig + orig_off;
+            ACE_OS::memset (target, 0, buffer_size);
+            ACE_OS::memset (expected, 0, buffer_size);
+
+            for (size_t e = 0; e < n; ++e)
+              switch (size)
+                {
+                case 2:
+                  ACE_CDR::swap_2 (src + 2 * e, expected + target_off + 2 * e);
+                  break;
+                case 4:
+                  ACE_CDR::swap_4 (src + 4 * e, expected + target_off + 4 * e);
+                  break;
+                case 8:
+                  ACE_CDR::swap_8 (src + 8 * e, expected + target_off + 8 * e);
+                  break;
+                default:
+                  ACE_CDR::swap_16 (src + 16 * e,
+                                    expected + target_off + 16 * e);
+                  break;
+                }
+
+            switch (size)
+              {
+              case 2:
+                ACE_CDR::swap_2_array (src, target + target_off, n);
+                break;
+              case 4:
+                ACE_CDR::swap_4_array (src, target + target_off, n);
+                break;
+              case 8:
+                ACE_CDR::swap_8_array (src, target + target_off, n);
+                break;
+              default:
+                ACE_CDR::swap_16_array (src, target + target_off, n);
+                break;
+              }
+
+            // Also catches writes past the end of the array.
+            if (ACE_OS::memcmp (target, expected, buffer_size) != 0)
+              ACE_ERROR_RETURN ((LM_ERROR,
+                                 ACE_TEXT ("swap_%B_array of %B elements ")
+                                 ACE_TEXT ("(offsets %B/%B) differs\n"),
+                                 size,
+                                 n,
+                                 orig_off,
+                                 target_off),
+                                1);
+          }
+
+  return 0;
+}
+
 int
 run_main (int argc, ACE_TCHAR *argv[])
 {
@@ -947,7 +1020,14 @@ run_main (int argc, ACE_TCHAR *argv[])
     return 1;
 
   ACE_DEBUG ((LM_DEBUG,
-              ACE_TEXT ("Placeholder/Replace - no errors\n\n")));
+              ACE_TEXT ("Placeholder/Replace - no errors\n\n")
+              ACE_TEXT ("Testing array swaps\n\n")));
+
+  if (swap_arrays () != 0)
+    return 1;
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("Array swaps - no errors\n\n")));
 
   ACE_END_TEST;
   return 0;
@@ -0,0 +1,164 @@
+//=============================================================================
+/**
+ *  @file    Log_Msg_Async_Test.cpp
+ *
+ *   This program tests ACE_Log_Msg_Async: several threads log through
+ *   it at once, and every record must either be written by the drain
+ *   thread, in the order in which its thread logged it, or be counted
+ *   as dropped.
+ */
+//=============================================================================
+
+
+#include "test_config.h"
+
+#include "ace/Log_Msg.h"
+#include "ace/Log_Msg_Async.h"
+#include "ace/Thread_Manager.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_stdio.h"
+
+#if !defined (ACE_LACKS_IOSTREAM_TOTALLY)
+
+#include <sstream>
+
+static const int n_threads = 4;
+static const int n_records = 2000;
+
+static ACE_THR_FUNC_RETURN
+worker (void *arg)
+{
+  int const id = static_cast<int> (reinterpret_cast<size_t> (arg));
+
+  for (int i = 0; i < n_records; ++i)
+    ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("Async record %d %d\n"), id, i));
+
+  return 0;
+}
+
+// Check what the drain thread wrote: the records of each thread must
+// come in order, and none may appear twice.  Returns the number of
+// records found, or -1 if they were out of order.
+static int
+check_output (const std::string &output)
+{
+  int next[n_threads];
+  for (int t = 0; t < n_threads; ++t)
+    next[t] = 0;
+
+  int found = 0;
+  const char *marker = "Async record ";
+  for (const char *p = ACE_OS::strstr (output.c_str (), marker);
+       p != 0;
+       p = ACE_OS::strstr (p + 1, marker))
+    {
+      int id = -1;
+      int seq = -1;
+      if (::sscanf (p + ACE_OS::strlen (marker), "%d %d", &id, &seq) != 2
+          || id < 0 || id >= n_threads)
+        {
+          ACE_ERROR ((LM_ERROR, ACE_TEXT ("Garbled record\n")));
+          return -1;
+        }
+      if (seq < next[id])
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("Thread %d: record %d after record %d\n"),
+                      id, seq, next[id] - 1));
+          return -1;
+        }
+      next[id] = seq + 1;
+      ++found;
+    }
+
+  return found;
+}
+
+#endif /* !ACE_LACKS_IOSTREAM_TOTALLY */
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Log_Msg_Async_Test"));
+
+  int status = 0;
+
+#if !defined (ACE_LACKS_IOSTREAM_TOTALLY)
+  std::ostringstream output;
+  ACE_Log_Msg_Async async;
+  async.destinations (ACE_Log_Msg::OSTREAM, &output);
+
+  ACE_Log_Msg_Backend *old_b = ACE_Log_Msg::msg_backend (&async);
+
+  // Reopen to get the backend established; the records still go to
+  // the test log as well.
+  u_long const flags = ACE_LOG_MSG->flags ();
+  if (-1 == ACE_LOG_MSG->open (ACE_TEXT ("Log_Msg_Async_Test"),
+                               flags | ACE_Log_Msg::CUSTOM))
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("Reopening log")));
+      ++status;
+    }
+
+# if defined (ACE_HAS_THREADS)
+  for (int t = 0; t < n_threads; ++t)
+    if (ACE_Thread_Manager::instance ()->spawn
+          (worker, reinterpret_cast<void *> (static_cast<size_t> (t))) == -1)
+      ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("spawn")), 1);
+
+  ACE_Thread_Manager::instance ()->wait ();
+  int const expected = n_threads * n_records;
+# else
+  worker (0);
+  int const expected = n_records;
+# endif /* ACE_HAS_THREADS */
+
+  // Take the backend out before closing it, so nothing logs through it
+  // any more.
+  ACE_LOG_MSG->clr_flags (ACE_Log_Msg::CUSTOM);
+  ACE_Log_Msg::msg_backend (old_b);
+
+  if (async.close () == -1)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("close")));
+      ++status;
+    }
+
+  int const written = check_output (output.str ());
+  unsigned long const dropped = async.dropped ();
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("%d records written, %Q dropped\n"),
+              written,
+              static_cast<ACE_UINT64> (dropped)));
+
+  if (written <= 0)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("No records written\n")));
+      ++status;
+    }
+  else if (written + dropped != static_cast<unsigned long> (expected))
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("Expected %d records, got %d written ")
+                  ACE_TEXT ("and %Q dropped\n"),
+                  expected,
+                  written,
+                  static_cast<ACE_UINT64> (dropped)));
+      ++status;
+    }
+
+  if (dropped > 0
+      && ACE_OS::strstr (output.str ().c_str (), "records dropped") == 0)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("Drops were not reported\n")));
+      ++status;
+    }
+#else
+  ACE_DEBUG ((LM_INFO,
+              ACE_TEXT ("This test requires iostreams\n")));
+#endif /* !ACE_LACKS_IOSTREAM_TOTALLY */
+
+  ACE_END_TEST;
+  return status;
+}
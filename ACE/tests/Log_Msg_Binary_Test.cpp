@@ -0,0 +1,205 @@
+//=============================================================================
+/**
+ *  @file    Log_Msg_Binary_Test.cpp
+ *
+ *   This program tests ACE_Log_Msg_Binary and ACE_Log_Msg_Binary_Reader:
+ *   the same messages are logged once through a backend that keeps the
+ *   text ACE_Log_Msg formats and once through ACE_Log_Msg_Binary, and
+ *   the messages read back from the binary file must match the text.
+ */
+//=============================================================================
+
+
+#include "test_config.h"
+
+#include "ace/Log_Msg.h"
+#include "ace/Log_Msg_Binary.h"
+#include "ace/Log_Record.h"
+#include "ace/SString.h"
+#include "ace/Vector_T.h"
+#include "ace/OS_NS_errno.h"
+#include "ace/OS_NS_signal.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_unistd.h"
+
+/// Keeps the text of the records ACE_Log_Msg formatted.
+class Text_Backend : public ACE_Log_Msg_Backend
+{
+public:
+  //FUZZ: disable check_for_lack_ACE_OS
+  ///FUZZ: enable check_for_lack_ACE_OS
+  virtual int open (const ACE_TCHAR *) { return 0; }
+
+  virtual int reset (void) { return 0; }
+
+  //FUZZ: disable check_for_lack_ACE_OS
+  ///FUZZ: enable check_for_lack_ACE_OS
+  virtual int close (void) { return 0; }
+
+  virtual ssize_t log (ACE_Log_Record &log_record)
+  {
+    this->types_.push_back (log_record.type ());
+    this->messages_.push_back (ACE_TString (log_record.msg_data ()));
+    return 0;
+  }
+
+  ACE_Vector<u_long> types_;
+  ACE_Vector<ACE_TString> messages_;
+};
+
+static void
+log_messages (void)
+{
+  ACE_Time_Value const when (1000000000, 123456);
+  const void *const ptr = &when;
+
+  ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("plain text\n")));
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("ints %d|%5d|%-5i|%05u|%x|%X|%o|%c|%%\n"),
+              -42, 42, 7, 3u, 255, 255, 8, 'z'));
+  ACE_DEBUG ((LM_INFO,
+              ACE_TEXT ("64 bits %Q %q %B %b %:\n"),
+              ACE_UINT64_MAX,
+              ACE_INT64 (-5),
+              size_t (12345),
+              ssize_t (-12345),
+              time_t (1234567890)));
+  ACE_DEBUG ((LM_NOTICE,
+              ACE_TEXT ("doubles %f %.2f %e %10.3g %A\n"),
+              3.25, 2.0 / 3, 1e10, 0.000125, 1.5));
+  ACE_DEBUG ((LM_WARNING,
+              ACE_TEXT ("strings [%s] [%-8s] [%8C] [%s]\n"),
+              ACE_TEXT ("tchar"),
+              ACE_TEXT ("left"),
+              "narrow",
+              static_cast<ACE_TCHAR *> (0)));
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("width from args [%*d] [%.*s]\n"),
+              6, 42, 3, ACE_TEXT ("truncated")));
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("context %N:%l %n %P %t %M %.1M %@ %S\n"),
+              ptr,
+              SIGINT));
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("times %#T %#D\n"),
+              &when,
+              &when));
+  ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("%Iindented%$next line\n")));
+  errno = ENOENT;
+  ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p, %m\n"), ACE_TEXT ("open")));
+  // Formatted by ACE_Log_Msg, and stored as text.
+  ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("wide %W\n"), ACE_TEXT_WIDE ("string")));
+  ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("plain text\n")));
+}
+
+// Log the messages to @a backend only, without the verbose prefixes.
+static void
+log_messages_to (ACE_Log_Msg_Backend *backend)
+{
+  ACE_Log_Msg_Backend *old_b = ACE_Log_Msg::msg_backend (backend);
+  u_long const flags = ACE_LOG_MSG->flags ();
+  ACE_LOG_MSG->clr_flags (flags);
+  ACE_LOG_MSG->set_flags (ACE_Log_Msg::CUSTOM);
+
+  log_messages ();
+
+  ACE_LOG_MSG->clr_flags (ACE_Log_Msg::CUSTOM);
+  ACE_LOG_MSG->set_flags (flags);
+  ACE_Log_Msg::msg_backend (old_b);
+}
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Log_Msg_Binary_Test"));
+
+  int status = 0;
+
+  ACE_TCHAR file_name[MAXPATHLEN];
+  ACE_OS::snprintf (file_name,
+                    MAXPATHLEN,
+                    ACE_TEXT ("%s%s"),
+                    ACE_LOG_DIRECTORY,
+                    ACE_TEXT ("Log_Msg_Binary_Test.bin"));
+  ACE_OS::unlink (file_name);
+
+  Text_Backend text;
+  log_messages_to (&text);
+
+  ACE_Log_Msg_Binary binary (file_name);
+  log_messages_to (&binary);
+  binary.close ();
+
+  ACE_Log_Msg_Binary_Reader reader;
+  if (reader.open (file_name) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("%p\n"),
+                       file_name),
+                      1);
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("Written by %s on %s\n"),
+              reader.program_name (),
+              reader.host_name ()));
+
+  size_t text_size = 0;
+  size_t count = 0;
+  ACE_Log_Record record;
+  int result = 0;
+  while ((result = reader.read (record)) == 1)
+    {
+      if (count >= text.messages_.size ())
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("Unexpected record: %s"),
+                      record.msg_data ()));
+          ++status;
+          break;
+        }
+
+      const ACE_TString &expected = text.messages_[count];
+      text_size += expected.length ();
+      if (expected != record.msg_data ()
+          || text.types_[count] != record.type ()
+          || record.pid () != ACE_OS::getpid ())
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("Record %B differs:\n%s%s"),
+                      count,
+                      expected.c_str (),
+                      record.msg_data ()));
+          ++status;
+        }
+      ++count;
+    }
+
+  if (result == -1)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("Error reading %s\n"), file_name));
+      ++status;
+    }
+
+  if (count != text.messages_.size ())
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("Read %B records, expected %B\n"),
+                  count,
+                  text.messages_.size ()));
+      ++status;
+    }
+
+  ACE_stat info;
+  if (ACE_OS::stat (file_name, &info) == 0)
+    ACE_DEBUG ((LM_DEBUG,
+                ACE_TEXT ("%B records: %B bytes of text, %B bytes in %s\n"),
+                count,
+                text_size,
+                static_cast<size_t> (info.st_size),
+                file_name));
+
+  reader.close ();
+  ACE_OS::unlink (file_name);
+
+  ACE_END_TEST;
+  return status;
+}
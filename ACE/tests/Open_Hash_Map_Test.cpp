@@ -0,0 +1,410 @@
+//=============================================================================
+/**
+ *  @file    Open_Hash_Map_Test.cpp
+ *
+ *   This program tests ACE_Open_Hash_Map: binding, finding, rebinding
+ *   and unbinding entries while the table grows and fills with
+ *   deleted slots, iterating both ways, keys whose hashes collide,
+ *   and the ACE_Map interface of ACE_Open_Hash_Map_Adapter.
+ */
+//=============================================================================
+
+
+#include "test_config.h"
+
+#include "ace/Open_Hash_Map_T.h"
+#include "ace/Map_T.h"
+#include "ace/Null_Mutex.h"
+#include "ace/SString.h"
+#include "ace/OS_NS_stdio.h"
+
+typedef ACE_Open_Hash_Map<int,
+                          int,
+                          ACE_Hash<int>,
+                          ACE_Equal_To<int>,
+                          ACE_Null_Mutex> INT_MAP;
+
+typedef ACE_Open_Hash_Map<ACE_CString,
+                          int,
+                          ACE_Hash<ACE_CString>,
+                          ACE_Equal_To<ACE_CString>,
+                          ACE_Null_Mutex> STRING_MAP;
+
+// A hash that puts every key in the same probe sequence.
+class Colliding_Hash
+{
+public:
+  unsigned long operator () (int key) const
+  {
+    return static_cast<unsigned long> (key % 3);
+  }
+};
+
+typedef ACE_Open_Hash_Map<int,
+                          int,
+                          Colliding_Hash,
+                          ACE_Equal_To<int>,
+                          ACE_Null_Mutex> COLLIDING_MAP;
+
+typedef ACE_Open_Hash_Map_Adapter<int,
+                                  int,
+                                  ACE_Hash<int>,
+                                  ACE_Equal_To<int>,
+                                  ACE_Incremental_Key_Generator<int> > MAP_ADAPTER;
+
+static const int n_keys = 20000;
+
+// Every key in [0, n) bound to key * 2 and nothing else.
+template <class MAP>
+static int
+check_contents (MAP &map, int n, int step)
+{
+  int status = 0;
+
+  for (int k = 0; k < n; ++k)
+    {
+      int value = -1;
+      int const result = map.find (k, value);
+      if (k % step == 0)
+        {
+          if (result != 0 || value != k * 2)
+            {
+              ACE_ERROR ((LM_ERROR,
+                          ACE_TEXT ("key %d not found\n"),
+                          k));
+              status = 1;
+            }
+        }
+      else if (result != -1)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("unbound key %d found\n"),
+                      k));
+          status = 1;
+        }
+    }
+
+  if (map.find (n) != -1 || map.find (-1) != -1)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("missing key found\n")));
+      status = 1;
+    }
+
+  return status;
+}
+
+static int
+test_int_keys (void)
+{
+  int status = 0;
+
+  // A small table, which has to grow many times.
+  INT_MAP map (4);
+
+  for (int k = 0; k < n_keys; ++k)
+    if (map.bind (k, k * 2) != 0)
+      {
+        ACE_ERROR ((LM_ERROR, ACE_TEXT ("bind %d failed\n"), k));
+        status = 1;
+      }
+
+  if (map.current_size () != static_cast<size_t> (n_keys)
+      || map.total_size () < map.current_size ())
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("bad size %B of %B\n"),
+                  map.current_size (),
+                  map.total_size ()));
+      status = 1;
+    }
+
+  status |= check_contents (map, n_keys, 1);
+
+  // bind and trybind do not change an existing entry.
+  int value = 7;
+  if (map.bind (10, 0) != 1
+      || map.trybind (10, value) != 1
+      || value != 20)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("existing entry changed\n")));
+      status = 1;
+    }
+
+  // rebind changes it and returns the old value.
+  int old_key = 0;
+  int old_value = 0;
+  if (map.rebind (10, 100, old_key, old_value) != 1
+      || old_key != 10
+      || old_value != 20
+      || map.find (10, value) != 0
+      || value != 100
+      || map.rebind (10, 20, old_value) != 1
+      || old_value != 100
+      || map.rebind (n_keys, 0) != 0
+      || map.unbind (n_keys, value) != 0
+      || value != 0)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("rebind failed\n")));
+      status = 1;
+    }
+
+  // Unbind the odd keys.
+  for (int k = 1; k < n_keys; k += 2)
+    if (map.unbind (k) != 0)
+      {
+        ACE_ERROR ((LM_ERROR, ACE_TEXT ("unbind %d failed\n"), k));
+        status = 1;
+      }
+
+  if (map.unbind (1) != -1
+      || map.current_size () != static_cast<size_t> (n_keys / 2))
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("unbound key unbound again\n")));
+      status = 1;
+    }
+
+  status |= check_contents (map, n_keys, 2);
+
+  // Binding and unbinding keys for long reuses the deleted slots
+  // instead of growing the table.
+  size_t const total_size = map.total_size ();
+  for (int round = 0; round < 20; ++round)
+    {
+      for (int k = n_keys; k < n_keys + n_keys / 4; ++k)
+        map.bind (k + round * n_keys, 0);
+      for (int k = n_keys; k < n_keys + n_keys / 4; ++k)
+        map.unbind (k + round * n_keys);
+    }
+
+  if (map.total_size () != total_size)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("table grew from %B to %B slots\n"),
+                  total_size,
+                  map.total_size ()));
+      status = 1;
+    }
+
+  status |= check_contents (map, n_keys, 2);
+
+  if (map.unbind_all () != 0
+      || map.current_size () != 0
+      || map.find (0) != -1
+      || map.begin () != map.end ())
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("unbind_all failed\n")));
+      status = 1;
+    }
+
+  return status;
+}
+
+static int
+test_iteration (void)
+{
+  int status = 0;
+  INT_MAP map;
+
+  int const n = 1000;
+  for (int k = 0; k < n; ++k)
+    map.bind (k, k * 2);
+
+  // Both ways visit every entry once.
+  long sum = 0;
+  int count = 0;
+  for (INT_MAP::iterator i = map.begin (); i != map.end (); ++i)
+    {
+      sum += (*i).ext_id_;
+      ++count;
+      if (i->int_id_ != i->ext_id_ * 2)
+        status = 1;
+    }
+
+  long reverse_sum = 0;
+  int reverse_count = 0;
+  for (INT_MAP::reverse_iterator i = map.rbegin (); i != map.rend (); ++i)
+    {
+      reverse_sum += i->key ();
+      ++reverse_count;
+    }
+
+  long const expected = static_cast<long> (n) * (n - 1) / 2;
+  if (sum != expected || reverse_sum != expected
+      || count != n || reverse_count != n)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("iteration saw %d and %d entries\n"),
+                  count,
+                  reverse_count));
+      status = 1;
+    }
+
+  // The ACE-style iteration.
+  INT_MAP::ENTRY *entry = 0;
+  count = 0;
+  for (INT_MAP::ITERATOR i (map); i.next (entry) != 0; i.advance ())
+    ++count;
+
+  // Going back from the end reaches the first entry.
+  INT_MAP::iterator last = map.end ();
+  --last;
+  INT_MAP::reverse_iterator first = map.rbegin ();
+  if (count != n || last->ext_id_ != first->ext_id_)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("ACE-style iteration failed\n")));
+      status = 1;
+    }
+
+  // The entries can be unbound while iterating.
+  for (INT_MAP::iterator i = map.begin (); i != map.end (); )
+    {
+      INT_MAP::ENTRY *current = &*i;
+      ++i;
+      if (current->ext_id_ % 3 == 0)
+        map.unbind (current);
+    }
+
+  count = 0;
+  for (INT_MAP::iterator i = map.begin (); i != map.end (); ++i)
+    {
+      if (i->ext_id_ % 3 == 0)
+        status = 1;
+      ++count;
+    }
+
+  if (count != n - (n + 2) / 3
+      || map.current_size () != static_cast<size_t> (count))
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%d entries left after unbinding\n"),
+                  count));
+      status = 1;
+    }
+
+  return status;
+}
+
+static int
+test_collisions (void)
+{
+  int status = 0;
+  COLLIDING_MAP map (16);
+
+  int const n = 500;
+  for (int k = 0; k < n; ++k)
+    map.bind (k, k * 2);
+
+  status |= check_contents (map, n, 1);
+
+  for (int k = 0; k < n; k += 2)
+    map.unbind (k);
+  for (int k = 0; k < n; k += 2)
+    map.bind (k, k * 2);
+
+  status |= check_contents (map, n, 1);
+
+  if (status != 0)
+    ACE_ERROR ((LM_ERROR, ACE_TEXT ("colliding keys failed\n")));
+
+  return status;
+}
+
+static int
+test_string_keys (void)
+{
+  int status = 0;
+  STRING_MAP map;
+
+  int const n = 5000;
+  char buf[32];
+  for (int k = 0; k < n; ++k)
+    {
+      ACE_OS::sprintf (buf, "key %d", k);
+      map.bind (ACE_CString (buf), k);
+    }
+
+  for (int k = 0; k < n; ++k)
+    {
+      ACE_OS::sprintf (buf, "key %d", k);
+      int value = -1;
+      if (map.find (ACE_CString (buf), value) != 0 || value != k)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("string key %C not found\n"),
+                      buf));
+          status = 1;
+        }
+    }
+
+  if (map.find (ACE_CString ("key")) != -1)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("missing string key found\n")));
+      status = 1;
+    }
+
+  return status;
+}
+
+static int
+test_adapter (void)
+{
+  int status = 0;
+  MAP_ADAPTER adapter;
+  ACE_Map<int, int> &map = adapter;
+
+  int key = 0;
+  for (int k = 0; k < 100; ++k)
+    if (map.bind_create_key (k * 2, key) != 0)
+      status = 1;
+
+  int value = 0;
+  if (map.current_size () != 100
+      || map.find (key, value) != 0
+      || value != 198
+      || map.rebind (key, 0) != 1
+      || map.unbind (key) != 0
+      || map.find (key) != -1)
+    status = 1;
+
+  int count = 0;
+  for (ACE_Map<int, int>::iterator i = map.begin (); i != map.end (); ++i)
+    {
+      if ((*i).second () != (*i).first () * 2 - 2)
+        status = 1;
+      ++count;
+    }
+
+  for (ACE_Map<int, int>::reverse_iterator i = map.rbegin ();
+       i != map.rend ();
+       ++i)
+    --count;
+
+  if (count != 0)
+    status = 1;
+
+  if (status != 0)
+    ACE_ERROR ((LM_ERROR, ACE_TEXT ("adapter failed\n")));
+
+  return status;
+}
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Open_Hash_Map_Test"));
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("Probing %d control bytes at a time\n"),
+              static_cast<int> (ACE_Open_Hash_Map_Group::WIDTH)));
+
+  int status = 0;
+
+  status |= test_int_keys ();
+  status |= test_iteration ();
+  status |= test_collisions ();
+  status |= test_string_keys ();
+  status |= test_adapter ();
+
+  ACE_END_TEST;
+  return status;
+}
@@ -51,6 +51,7 @@
 #  include "ace/POSIX_Proactor.h"
 #  include "ace/POSIX_CB_Proactor.h"
 #  include "ace/SUN_Proactor.h"
+#  include "ace/Uring_Proactor.h"
 
 #endif /* ACE_WIN32 */
 
@@ -58,7 +59,7 @@
 
 
 // Proactor Type (UNIX only, Win32 ignored)
-typedef enum { DEFAULT = 0, AIOCB, SIG, SUN, CB } ProactorType;
+typedef enum { DEFAULT = 0, AIOCB, SIG, SUN, CB, URING } ProactorType;
 static ProactorType proactor_type = DEFAULT;
 
 // POSIX : > 0 max number aio operations  proactor,
@@ -261,6 +262,27 @@ MyTask::create_proactor (ProactorType type_proactor, size_t max_op)
       break;
 #  endif /* !ACE_HAS_BROKEN_SIGEVENT_STRUCT */
 
+#  if defined (ACE_HAS_IO_URING)
+    case URING:
+      {
+        ACE_Uring_Proactor *uring_impl = 0;
+        ACE_NEW_RETURN (uring_impl,
+                        ACE_Uring_Proactor (max_op),
+                        -1);
+        if (!uring_impl->initialized ())
+          {
+            delete uring_impl;
+            ACE_ERROR_RETURN ((LM_ERROR,
+                               ACE_TEXT ("(%t) io_uring is not available\n")),
+                              -1);
+          }
+        proactor_impl = uring_impl;
+      }
+      ACE_DEBUG ((LM_DEBUG,
+                  ACE_TEXT ("(%t) Create Proactor Type = URING\n")));
+      break;
+#  endif /* ACE_HAS_IO_URING */
+
     default:
       ACE_DEBUG ((LM_DEBUG,
                   ACE_TEXT ("(%t) Create Proactor Type = DEFAULT\n")));
@@ -1726,6 +1748,7 @@ print_usage (int /* argc */, ACE_TCHAR *argv[])
       ACE_TEXT ("\n    i SIG")
       ACE_TEXT ("\n    c CB")
       ACE_TEXT ("\n    s SUN")
+      ACE_TEXT ("\n    u URING")
       ACE_TEXT ("\n    d default")
       ACE_TEXT ("\n-d <duplex mode 1-on/0-off>")
       ACE_TEXT ("\n-h <host> for Client mode")
@@ -1774,6 +1797,11 @@ set_proactor_type (const ACE_TCHAR *ptype)
        proactor_type = CB;
        return 1;
 #endif /* !ACE_HAS_BROKEN_SIGEVENT_STRUCT */
+#if defined (ACE_HAS_IO_URING)
+    case 'U':
+      proactor_type = URING;
+      return 1;
+#endif /* ACE_HAS_IO_URING */
     default:
       break;
     }
@@ -4,8 +4,9 @@
  *  @file    SString_Test.cpp
  *
  *    This is a simple test that illustrates the use of ACE_CString
- *    and ACE_WString. No command line arguments are needed to run
- *    the test.
+ *    and ACE_WString, including strings short enough to be kept
+ *    inline without using the allocator. No command line arguments
+ *    are needed to run the test.
  *
  *  @author Prashant Jain <pjain@cs.wustl.edu>
  */
@@ -16,6 +17,7 @@
 #include "ace/OS_NS_string.h"
 #include "ace/Auto_Ptr.h"
 #include "ace/SString.h"
+#include "ace/Malloc_Allocator.h"
 
 
 
@@ -154,6 +156,156 @@ int testConstIterator()
   return 0;
 }
 
+// Counts the buffers a string gets from and gives back to it.
+class Counting_Allocator : public ACE_New_Allocator
+{
+public:
+  Counting_Allocator (void) : mallocs_ (0), frees_ (0) {}
+
+  virtual void *malloc (size_t nbytes)
+  {
+    ++this->mallocs_;
+    return ACE_New_Allocator::malloc (nbytes);
+  }
+
+  virtual void free (void *ptr)
+  {
+    ++this->frees_;
+    ACE_New_Allocator::free (ptr);
+  }
+
+  int mallocs_;
+  int frees_;
+};
+
+static int testSmallStrings()
+{
+  int err = 0;
+  Counting_Allocator alloc;
+  const char *const short_text = "short";
+  const char *const long_text =
+    "a string that is much too long to be kept inline";
+
+  // The allocations are only checked when the inline buffer is big
+  // enough for the short strings used here.
+  bool const check_mallocs = ACE_STRING_BASE_INLINE_SIZE > 16;
+
+  {
+    // Short strings, their copies and swaps don't allocate.
+    ACE_CString s1 (short_text, &alloc);
+    ACE_CString s2 (s1);
+    ACE_CString s3 ('x', &alloc);
+    s3 += "yz";
+    s2.swap (s3);
+    if ((check_mallocs && alloc.mallocs_ != 0)
+        || s1 != short_text
+        || s2 != "xyz"
+        || s3 != short_text
+        || s2.c_str ()[3] != '\0')
+      {
+        ACE_ERROR ((LM_ERROR, ACE_TEXT ("short strings allocated %d times\n"),
+                    alloc.mallocs_));
+        ++err;
+      }
+
+    // Growing past the inline buffer allocates once, and swapping
+    // with a short string moves the characters, not the buffers.
+    ACE_CString s4 (long_text, 1, &alloc);
+    s4 += long_text + 1;
+    s4.swap (s1);
+    s4 += '!';
+    if ((check_mallocs && alloc.mallocs_ != 1)
+        || s1 != long_text
+        || s4 != "short!")
+      {
+        ACE_ERROR ((LM_ERROR, ACE_TEXT ("long string allocated %d times\n"),
+                    alloc.mallocs_));
+        ++err;
+      }
+
+    // fast_clear keeps the inline buffer and set() with release ==
+    // false still uses the given buffer.
+    s4.fast_clear ();
+    s4 += "again";
+    ACE_CString s5 (short_text, 2, &alloc, false);
+    if (s4 != "again"
+        || s5.fast_rep () != short_text
+        || s5.length () != 2)
+      {
+        ACE_ERROR ((LM_ERROR, ACE_TEXT ("short buffer reuse failed\n")));
+        ++err;
+      }
+  }
+
+  if (alloc.mallocs_ != alloc.frees_)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("%d buffers allocated, %d freed\n"),
+                  alloc.mallocs_, alloc.frees_));
+      ++err;
+    }
+
+#if defined (ACE_HAS_CPP11)
+  {
+    // Moving takes over a long string's buffer and copies a short one.
+    int const mallocs = alloc.mallocs_;
+    ACE_CString long_string (long_text, &alloc);
+    ACE_CString short_string (short_text, &alloc);
+    const char *const buffer = long_string.fast_rep ();
+
+    ACE_CString moved_long (std::move (long_string));
+    ACE_CString moved_short (std::move (short_string));
+    if (moved_long.fast_rep () != buffer
+        || moved_long != long_text
+        || moved_short != short_text
+        || !long_string.empty ()
+        || !short_string.empty ())
+      {
+        ACE_ERROR ((LM_ERROR, ACE_TEXT ("move construction failed\n")));
+        ++err;
+      }
+
+    short_string = std::move (moved_long);
+    long_string = std::move (moved_short);
+    if (short_string.fast_rep () != buffer
+        || short_string != long_text
+        || long_string != short_text
+        || !moved_long.empty ()
+        || (check_mallocs && alloc.mallocs_ != mallocs + 1))
+      {
+        ACE_ERROR ((LM_ERROR, ACE_TEXT ("move assignment failed\n")));
+        ++err;
+      }
+  }
+
+  if (alloc.mallocs_ != alloc.frees_)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("moved buffer leaked or freed twice\n")));
+      ++err;
+    }
+#endif /* ACE_HAS_CPP11 */
+
+#ifdef ACE_HAS_WCHAR
+  {
+    // The inline buffer is sized in bytes, so it holds fewer wide
+    // characters.  Only check the allocations when it holds at least
+    // the 6 ACE_WSTRING_TYPE characters of "wide!" and its '\0'.
+    bool const check_wide_mallocs =
+      ACE_STRING_BASE_INLINE_SIZE >= 6 * sizeof (ACE_WSTRING_TYPE);
+    ACE_WString w1 (L"wide", &alloc);
+    ACE_WString w2 (w1);
+    w2 += L"!";
+    if (w2 != ACE_WString (L"wide!")
+        || (check_wide_mallocs && alloc.mallocs_ != alloc.frees_))
+      {
+        ACE_ERROR ((LM_ERROR, ACE_TEXT ("short wide string allocated\n")));
+        ++err;
+      }
+  }
+#endif /* ACE_HAS_WCHAR */
+
+  return err;
+}
+
 
 int
 run_main (int, ACE_TCHAR *[])
@@ -430,6 +582,7 @@ run_main (int, ACE_TCHAR *[])
   int err = testConcatenation ();
   err += testIterator ();
   err += testConstIterator ();
+  err += testSmallStrings ();
 
   ACE_END_TEST;
   return err;
@@ -0,0 +1,232 @@
+//=============================================================================
+/**
+ *  @file    Thread_Cached_Allocator_Test.cpp
+ *
+ *   This program tests ACE_Thread_Cached_Allocator: blocks of every
+ *   size class and beyond must be usable, aligned and kept intact
+ *   while they are cached, and several threads must be able to
+ *   allocate blocks that other threads free, including the blocks
+ *   of ACE_Message_Block's allocator triple.
+ */
+//=============================================================================
+
+
+#include "test_config.h"
+
+#include "ace/Thread_Cached_Allocator.h"
+#include "ace/Atomic_Op.h"
+#include "ace/Barrier.h"
+#include "ace/CDR_Stream.h"
+#include "ace/Message_Block.h"
+#include "ace/Thread_Manager.h"
+#include "ace/OS_NS_string.h"
+
+static const size_t n_threads = 4;
+static const size_t n_blocks = 500;
+static const int n_rounds = 20;
+
+static const size_t sizes[] =
+  {
+    0, 1, 8, 32, 33, 100, 256, 512, 520, 1000, 1032, 4096,
+    ACE_CDR::EXP_GROWTH_MAX + ACE_CDR::MAX_ALIGNMENT,
+    ACE_CDR::EXP_GROWTH_MAX + ACE_CDR::MAX_ALIGNMENT + 1,
+    200000
+  };
+static const size_t n_sizes = sizeof (sizes) / sizeof (sizes[0]);
+
+// Fill a block of <size> bytes with a pattern that depends on <seed>.
+static void
+fill (void *ptr, size_t size, size_t seed)
+{
+  char *const p = static_cast<char *> (ptr);
+  for (size_t i = 0; i < size; ++i)
+    p[i] = static_cast<char> (seed + i);
+}
+
+// Check the pattern written by fill().
+static bool
+check (const void *ptr, size_t size, size_t seed)
+{
+  const char *const p = static_cast<const char *> (ptr);
+  for (size_t i = 0; i < size; ++i)
+    if (p[i] != static_cast<char> (seed + i))
+      return false;
+  return true;
+}
+
+// Allocate blocks of all sizes, several times, from one thread.
+static int
+test_sizes (ACE_Allocator &allocator)
+{
+  int status = 0;
+  void *blocks[n_sizes * 100];
+
+  for (int round = 0; round < 3; ++round)
+    {
+      for (size_t i = 0; i < n_sizes * 100; ++i)
+        {
+          size_t const size = sizes[i % n_sizes];
+          blocks[i] = allocator.malloc (size);
+          if (blocks[i] == 0)
+            {
+              ACE_ERROR ((LM_ERROR,
+                          ACE_TEXT ("Failed to allocate %B bytes\n"),
+                          size));
+              return 1;
+            }
+          if (reinterpret_cast<size_t> (blocks[i])
+              % ACE_CDR::MAX_ALIGNMENT != 0)
+            {
+              ACE_ERROR ((LM_ERROR,
+                          ACE_TEXT ("Block of %B bytes not aligned\n"),
+                          size));
+              ++status;
+            }
+          fill (blocks[i], size, i);
+        }
+
+      for (size_t i = 0; i < n_sizes * 100; ++i)
+        {
+          if (!check (blocks[i], sizes[i % n_sizes], i))
+            {
+              ACE_ERROR ((LM_ERROR,
+                          ACE_TEXT ("Block %B of %B bytes overwritten\n"),
+                          i,
+                          sizes[i % n_sizes]));
+              ++status;
+            }
+          allocator.free (blocks[i]);
+        }
+    }
+
+  char *const zeroed =
+    static_cast<char *> (allocator.calloc (10, 100, 'x'));
+  for (size_t i = 0; zeroed != 0 && i < 1000; ++i)
+    if (zeroed[i] != 'x')
+      {
+        ACE_ERROR ((LM_ERROR, ACE_TEXT ("calloc() did not set the block\n")));
+        ++status;
+        break;
+      }
+  allocator.free (zeroed);
+  allocator.free (0);
+
+  return status;
+}
+
+/// State shared by the worker threads.
+struct Shared
+{
+  Shared (void) : barrier_ (n_threads), next_index_ (0), errors_ (0) {}
+
+  ACE_Thread_Cached_Allocator allocator_;
+  ACE_Barrier barrier_;
+  void *blocks_[n_threads][n_blocks];
+  ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> next_index_;
+  ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> errors_;
+};
+
+// Every round, each thread allocates blocks and message blocks, then
+// frees the blocks allocated by its neighbour.
+static ACE_THR_FUNC_RETURN
+worker (void *arg)
+{
+  Shared &shared = *static_cast<Shared *> (arg);
+  size_t const self = static_cast<size_t> (shared.next_index_++);
+  size_t const neighbour = (self + 1) % n_threads;
+
+  for (int round = 0; round < n_rounds; ++round)
+    {
+      for (size_t i = 0; i < n_blocks; ++i)
+        {
+          size_t const size = sizes[(i + round) % n_sizes];
+          void *const ptr = shared.allocator_.malloc (size);
+          if (ptr != 0)
+            fill (ptr, size, self + i);
+          shared.blocks_[self][i] = ptr;
+
+          // Like TAO's CDR streams, take the message block, its data
+          // block and its buffer from the allocator.
+          ACE_Message_Block *mb = 0;
+          ACE_NEW_MALLOC_RETURN (mb,
+                                 static_cast<ACE_Message_Block *> (
+                                   shared.allocator_.malloc (sizeof (ACE_Message_Block))),
+                                 ACE_Message_Block (ACE_CDR::DEFAULT_BUFSIZE,
+                                                    ACE_Message_Block::MB_DATA,
+                                                    0,
+                                                    0,
+                                                    &shared.allocator_,
+                                                    0,
+                                                    ACE_DEFAULT_MESSAGE_BLOCK_PRIORITY,
+                                                    ACE_Time_Value::zero,
+                                                    ACE_Time_Value::max_time,
+                                                    &shared.allocator_,
+                                                    &shared.allocator_),
+                                 0);
+          mb->copy ("data", 5);
+          mb->release ();
+        }
+
+      shared.barrier_.wait ();
+
+      for (size_t i = 0; i < n_blocks; ++i)
+        {
+          void *const ptr = shared.blocks_[neighbour][i];
+          size_t const size = sizes[(i + round) % n_sizes];
+          if (ptr == 0 || !check (ptr, size, neighbour + i))
+            ++shared.errors_;
+          shared.allocator_.free (ptr);
+        }
+
+      shared.barrier_.wait ();
+    }
+
+  return 0;
+}
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Thread_Cached_Allocator_Test"));
+
+  int status = 0;
+
+  {
+    ACE_Thread_Cached_Allocator allocator;
+    status += test_sizes (allocator);
+  }
+
+  {
+    // A depot that keeps nothing gives every spilled block back.
+    ACE_Thread_Cached_Allocator allocator (0);
+    status += test_sizes (allocator);
+  }
+
+#if defined (ACE_HAS_THREADS)
+  Shared *shared = 0;
+  ACE_NEW_RETURN (shared, Shared, 1);
+
+  if (ACE_Thread_Manager::instance ()->spawn_n (n_threads, worker, shared)
+      == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("spawn_n")), 1);
+
+  ACE_Thread_Manager::instance ()->wait ();
+
+  if (shared->errors_.value () != 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%d blocks were overwritten\n"),
+                  static_cast<int> (shared->errors_.value ())));
+      ++status;
+    }
+
+  // The threads have exited and returned their magazines; the blocks
+  // are reused from the depot.
+  status += test_sizes (shared->allocator_);
+
+  delete shared;
+#endif /* ACE_HAS_THREADS */
+
+  ACE_END_TEST;
+  return status;
+}
@@ -3,9 +3,10 @@
 /**
  *  @file    Timer_Queue_Test.cpp
  *
- *    This is a simple test of <ACE_Timer_Queue> and four of its
+ *    This is a simple test of <ACE_Timer_Queue> and five of its
  *    subclasses (<ACE_Timer_List>, <ACE_Timer_Heap>,
- *    <ACE_Timer_Wheel>, and <ACE_Timer_Hash>).  The test sets up a
+ *    <ACE_Timer_Wheel>, <ACE_Timer_Hierarchical_Wheel>, and
+ *    <ACE_Timer_Hash>).  The test sets up a
  *    bunch of timers and then adds them to a timer queue. The
  *    functionality of the timer queue is then tested. No command
  *    line arguments are needed to run the test.
@@ -24,6 +25,7 @@
 #include "ace/Timer_Heap.h"
 #include "ace/Timer_Wheel.h"
 #include "ace/Timer_Hash.h"
+#include "ace/Timer_Hierarchical_Wheel.h"
 #include "ace/Timer_Queue.h"
 #include "ace/Time_Policy.h"
 #include "ace/Recursive_Thread_Mutex.h"
@@ -657,6 +659,21 @@ run_main (int argc, ACE_TCHAR *argv[])
                                      ACE_TEXT ("ACE_Timer_Wheel (preallocated)"),
                                      tq_stack),
                   -1);
+  // Timer_Hierarchical_Wheel without preallocated memory.
+  ACE_NEW_RETURN (tq_stack,
+                  Timer_Queue_Stack (new ACE_Timer_Hierarchical_Wheel,
+                                     ACE_TEXT ("ACE_Timer_Hierarchical_Wheel (non-preallocated)"),
+                                     tq_stack),
+                  -1);
+
+  // Timer_Hierarchical_Wheel with preallocated memory.
+  ACE_NEW_RETURN (tq_stack,
+                  Timer_Queue_Stack (new ACE_Timer_Hierarchical_Wheel (ACE_DEFAULT_TIMER_HIERARCHICAL_WHEEL_RESOLUTION,
+                                                                       max_iterations),
+                                     ACE_TEXT ("ACE_Timer_Hierarchical_Wheel (preallocated)"),
+                                     tq_stack),
+                  -1);
+
   // Timer_Heap without preallocated memory.
   ACE_NEW_RETURN (tq_stack,
                   Timer_Queue_Stack (new ACE_Timer_Heap,
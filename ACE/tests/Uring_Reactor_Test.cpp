@@ -0,0 +1,435 @@
+//=============================================================================
+/**
+ *  @file    Uring_Reactor_Test.cpp
+ *
+ *  This test verifies that the ACE_Uring_Reactor is functioning
+ *  properly.  It checks the dispatch order of timers and I/O events,
+ *  suspension and resumption of handlers, mask changes, notifications,
+ *  and finally runs the event loop in several threads at once to make
+ *  sure a handler is never dispatched concurrently and that no event
+ *  is lost when registration changes are batched.
+ *
+ *  If the running kernel does not support @c io_uring (or it has been
+ *  disabled), the test only reports that.
+ */
+//=============================================================================
+
+#include "test_config.h"
+
+#if defined (ACE_HAS_IO_URING)
+
+#include "ace/ACE.h"
+#include "ace/Atomic_Op.h"
+#include "ace/Pipe.h"
+#include "ace/Reactor.h"
+#include "ace/Thread_Manager.h"
+#include "ace/Uring_Reactor.h"
+#include "ace/OS_NS_string.h"
+
+static const char *message = "Hello there! Hope you get this message";
+
+// ----------------------------------------------------
+
+/**
+ * Checks the dispatch order (timeout, output, input) and that
+ * suspended handlers are not dispatched.
+ */
+class Order_Handler : public ACE_Event_Handler
+{
+public:
+
+  Order_Handler (ACE_Reactor &reactor);
+
+  ~Order_Handler (void);
+
+  virtual int handle_timeout (const ACE_Time_Value &tv, const void *arg);
+
+  virtual int handle_input (ACE_HANDLE fd);
+
+  virtual int handle_output (ACE_HANDLE fd);
+
+  virtual ACE_HANDLE get_handle (void) const;
+
+  ACE_Pipe pipe_;
+
+  int dispatch_order_;
+
+  bool ok_;
+};
+
+Order_Handler::Order_Handler (ACE_Reactor &reactor)
+  : ACE_Event_Handler (&reactor),
+    dispatch_order_ (1),
+    ok_ (false)
+{
+  if (0 != this->pipe_.open ())
+    ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("pipe")));
+  else if (0 != this->reactor ()->register_handler
+                  (this->pipe_.read_handle (),
+                   this,
+                   ACE_Event_Handler::READ_MASK
+                   | ACE_Event_Handler::WRITE_MASK))
+    ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("register")));
+  else
+    this->ok_ = true;
+}
+
+Order_Handler::~Order_Handler (void)
+{
+  this->pipe_.close ();
+}
+
+ACE_HANDLE
+Order_Handler::get_handle (void) const
+{
+  return this->pipe_.read_handle ();
+}
+
+int
+Order_Handler::handle_timeout (const ACE_Time_Value &, const void *)
+{
+  int const me = this->dispatch_order_++;
+  if (me != 1)
+    ACE_ERROR ((LM_ERROR,
+                ACE_TEXT ("handle_timeout should be #1; it's %d\n"),
+                me));
+  return 0;
+}
+
+int
+Order_Handler::handle_output (ACE_HANDLE)
+{
+  int const me = this->dispatch_order_++;
+  if (me != 2)
+    ACE_ERROR ((LM_ERROR,
+                ACE_TEXT ("handle_output should be #2; it's %d\n"),
+                me));
+
+  // Don't want to continually see writeable; only verify its relative
+  // order.  This replaces the outstanding poll request.
+  this->reactor ()->mask_ops (this->pipe_.read_handle (),
+                              ACE_Event_Handler::WRITE_MASK,
+                              ACE_Reactor::CLR_MASK);
+  return 0;
+}
+
+int
+Order_Handler::handle_input (ACE_HANDLE fd)
+{
+  int const me = this->dispatch_order_++;
+  if (me != 3)
+    ACE_ERROR ((LM_ERROR,
+                ACE_TEXT ("handle_input should be #3; it's %d\n"),
+                me));
+
+  char buffer[BUFSIZ];
+  ssize_t const result = ACE::recv (fd, buffer, sizeof buffer - 1);
+  if (result != ssize_t (ACE_OS::strlen (message)))
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("Order_Handler recv'd %b bytes; expected %B\n"),
+                  result, ACE_OS::strlen (message)));
+      return -1;
+    }
+
+  buffer[result] = '\0';
+  if (ACE_OS::strcmp (buffer, message) != 0)
+    ACE_ERROR ((LM_ERROR,
+                ACE_TEXT ("Order_Handler text mismatch; received \"%C\"\n"),
+                buffer));
+
+  this->reactor ()->end_reactor_event_loop ();
+  return 0;
+}
+
+static int
+test_dispatch_order (ACE_Reactor &reactor)
+{
+  Order_Handler handler (reactor);
+  if (!handler.ok_)
+    return 1;
+
+  int errors = 0;
+
+  ssize_t const result = ACE::send_n (handler.pipe_.write_handle (),
+                                      message,
+                                      ACE_OS::strlen (message));
+  if (result != ssize_t (ACE_OS::strlen (message)))
+    ++errors;
+
+  if (-1 == reactor.schedule_timer (&handler, 0, ACE_Time_Value::zero))
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("schedule_timer")));
+      ++errors;
+    }
+
+  // Suspend the handlers - only the timer should be dispatched.
+  ACE_Time_Value tv (1);
+  reactor.suspend_handlers ();
+  reactor.run_reactor_event_loop (tv);
+
+  if (handler.dispatch_order_ != 2)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("Suspended: incorrect number fired %d\n"),
+                  handler.dispatch_order_));
+      ++errors;
+    }
+
+  handler.dispatch_order_ = 1;
+  if (-1 == reactor.schedule_timer (&handler, 0, ACE_Time_Value::zero))
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("schedule_timer")));
+      ++errors;
+    }
+
+  // Resume the handlers - the pending events must be reported again.
+  reactor.resume_handlers ();
+  tv.set (5, 0);
+  reactor.reset_reactor_event_loop ();
+  reactor.run_reactor_event_loop (tv);
+
+  if (0 != reactor.remove_handler (handler.pipe_.read_handle (),
+                                   ACE_Event_Handler::ALL_EVENTS_MASK
+                                   | ACE_Event_Handler::DONT_CALL))
+    ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("remove_handler")));
+
+  if (handler.dispatch_order_ != 4)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("Resumed: incorrect number fired %d\n"),
+                  handler.dispatch_order_));
+      ++errors;
+    }
+
+  reactor.reset_reactor_event_loop ();
+  return errors;
+}
+
+// ----------------------------------------------------
+
+/// Counts notifications, ending the event loop after the last one.
+class Notify_Handler : public ACE_Event_Handler
+{
+public:
+
+  Notify_Handler (int expected)
+    : expected_ (expected), count_ (0)
+  {
+  }
+
+  virtual int handle_exception (ACE_HANDLE)
+  {
+    if (++this->count_ == this->expected_)
+      this->reactor ()->end_reactor_event_loop ();
+    return 0;
+  }
+
+  int const expected_;
+  int count_;
+};
+
+static ACE_THR_FUNC_RETURN
+notifier (void *arg)
+{
+  Notify_Handler *handler = static_cast<Notify_Handler *> (arg);
+
+  // Give the event loop a chance to block in the kernel first.
+  ACE_OS::sleep (ACE_Time_Value (0, 100000));
+
+  for (int i = 0; i < handler->expected_; ++i)
+    if (handler->reactor ()->notify (handler) == -1)
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("(%t) %p\n"), ACE_TEXT ("notify")));
+
+  return 0;
+}
+
+static int
+test_notify (ACE_Reactor &reactor)
+{
+  Notify_Handler handler (100);
+  handler.reactor (&reactor);
+
+  if (ACE_Thread_Manager::instance ()->spawn (notifier, &handler) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("spawn")), 1);
+
+  ACE_Time_Value tv (10);
+  reactor.run_reactor_event_loop (tv);
+  ACE_Thread_Manager::instance ()->wait ();
+  reactor.reset_reactor_event_loop ();
+
+  if (handler.count_ != handler.expected_)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("Received %d notifications; expected %d\n"),
+                       handler.count_,
+                       handler.expected_),
+                      1);
+  return 0;
+}
+
+// ----------------------------------------------------
+
+static const int pipe_count = 32;
+static const int message_count = 200;
+static const int thread_count = 4;
+
+static ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> bytes_left (0);
+static ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> overlaps (0);
+
+/**
+ * Reads whatever is available.  The reactor must never dispatch the
+ * same handler in more than one thread at a time.
+ */
+class Reader : public ACE_Event_Handler
+{
+public:
+
+  Reader (void) : in_upcall_ (0) {}
+
+  virtual int handle_input (ACE_HANDLE fd)
+  {
+    if (++this->in_upcall_ != 1)
+      ++overlaps;
+
+    char buffer[BUFSIZ];
+    ssize_t const n = ACE_OS::read (fd, buffer, sizeof buffer);
+
+    --this->in_upcall_;
+
+    if (n <= 0)
+      return -1;
+
+    if ((bytes_left -= n) == 0)
+      this->reactor ()->end_reactor_event_loop ();
+    return 0;
+  }
+
+  ACE_Pipe pipe_;
+
+  ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> in_upcall_;
+};
+
+static ACE_THR_FUNC_RETURN
+event_loop (void *arg)
+{
+  ACE_Reactor *reactor = static_cast<ACE_Reactor *> (arg);
+
+  ACE_Time_Value tv (30);
+  reactor->owner (ACE_OS::thr_self ());
+  reactor->run_reactor_event_loop (tv);
+  return 0;
+}
+
+static int
+test_threads (ACE_Reactor &reactor)
+{
+  Reader readers[pipe_count];
+  int errors = 0;
+
+  for (int i = 0; i < pipe_count; ++i)
+    {
+      readers[i].reactor (&reactor);
+      if (readers[i].pipe_.open () != 0
+          || reactor.register_handler (readers[i].pipe_.read_handle (),
+                                       &readers[i],
+                                       ACE_Event_Handler::READ_MASK) != 0)
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("%p\n"),
+                           ACE_TEXT ("reader setup")),
+                          1);
+    }
+
+  size_t const len = ACE_OS::strlen (message);
+  bytes_left = static_cast<long> (pipe_count * message_count * len);
+
+  if (ACE_Thread_Manager::instance ()->spawn_n (thread_count,
+                                                event_loop,
+                                                &reactor) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("spawn_n")), 1);
+
+  for (int m = 0; m < message_count; ++m)
+    for (int i = 0; i < pipe_count; ++i)
+      if (ACE::send_n (readers[i].pipe_.write_handle (), message, len)
+          != ssize_t (len))
+        {
+          ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("send_n")));
+          ++errors;
+        }
+
+  ACE_Thread_Manager::instance ()->wait ();
+
+  if (bytes_left.value () != 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%d bytes were not received\n"),
+                  bytes_left.value ()));
+      ++errors;
+    }
+
+  if (overlaps.value () != 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%d concurrent upcalls for the same handler\n"),
+                  overlaps.value ()));
+      ++errors;
+    }
+
+  for (int i = 0; i < pipe_count; ++i)
+    {
+      reactor.remove_handler (readers[i].pipe_.read_handle (),
+                              ACE_Event_Handler::ALL_EVENTS_MASK
+                              | ACE_Event_Handler::DONT_CALL);
+      readers[i].pipe_.close ();
+    }
+
+  return errors;
+}
+
+// ----------------------------------------------------
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Uring_Reactor_Test"));
+
+  ACE_Uring_Reactor uring_reactor;
+  if (!uring_reactor.initialized ())
+    {
+      ACE_ERROR ((LM_INFO,
+                  ACE_TEXT ("%p; io_uring is not usable, skipping test\n"),
+                  ACE_TEXT ("ACE_Uring_Reactor::open")));
+      ACE_END_TEST;
+      return 0;
+    }
+
+  ACE_Reactor reactor (&uring_reactor);
+  int errors = 0;
+
+  ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("Testing dispatch order\n")));
+  errors += test_dispatch_order (reactor);
+
+  ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("Testing notifications\n")));
+  errors += test_notify (reactor);
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("Testing %d event loop threads\n"),
+              thread_count));
+  errors += test_threads (reactor);
+
+  ACE_END_TEST;
+  return errors;
+}
+
+#else
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Uring_Reactor_Test"));
+  ACE_ERROR ((LM_INFO,
+              ACE_TEXT ("io_uring is not supported on this platform\n")));
+  ACE_END_TEST;
+  return 0;
+}
+
+#endif  /* ACE_HAS_IO_URING */
@@ -2556,6 +2556,13 @@ TAO_CodeGen::gen_stub_hdr_includes (void)
                                   "tao/Messaging/Messaging.h");
     }
 
+  // The co_ stubs return an awaitable.
+  if (be_global->ami_coroutines ())
+    {
+      this->gen_standard_include (this->client_header_,
+                                  "tao/Messaging/AMI_Awaitable.h");
+    }
+
   // Include the AMI4CCM library entry point, if AMI4CCM is enabled.
   if (be_global->ami4ccm_call_back ())
     {
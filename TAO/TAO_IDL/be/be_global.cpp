@@ -110,6 +110,7 @@ BE_GlobalData::BE_GlobalData (void)
     opt_tc_ (false),
     ami4ccm_call_back_ (false),
     ami_call_back_ (false),
+    ami_coroutines_ (false),
     gen_amh_classes_ (false),
     gen_tie_classes_ (false),
     gen_smart_proxies_ (false),
@@ -1856,6 +1857,18 @@ BE_GlobalData::ami_call_back (void) const
   return this->ami_call_back_;
 }
 
+void
+BE_GlobalData::ami_coroutines (bool val)
+{
+  this->ami_coroutines_ = val;
+}
+
+bool
+BE_GlobalData::ami_coroutines (void) const
+{
+  return this->ami_coroutines_;
+}
+
 void
 BE_GlobalData::gen_amh_classes (bool val)
 {
@@ -3168,7 +3181,13 @@ BE_GlobalData::parse_args (long &i, char **av)
         break;
       case 'G':
         // Enable generation of ...
-        if (av[i][2] == 'C')
+        if (av[i][2] == 'C' && av[i][3] == 'o')
+          {
+            // AMI with Call back, and the co_ stubs on top.
+            be_global->ami_call_back (true);
+            be_global->ami_coroutines (true);
+          }
+        else if (av[i][2] == 'C')
           {
             // AMI with Call back.
             be_global->ami_call_back (true);
@@ -565,6 +565,11 @@ be_util::usage (void)
       LM_DEBUG,
       ACE_TEXT (" -GC \t\t\tGenerate the AMI classes\n")
     ));
+  ACE_DEBUG ((
+      LM_DEBUG,
+      ACE_TEXT (" -GCo \t\t\tGenerate the AMI classes and the co_ stubs")
+      ACE_TEXT (" for C++20 coroutines\n")
+    ));
   ACE_DEBUG ((
       LM_DEBUG,
       ACE_TEXT (" -GH \t\t\tGenerate the AMH classes\n")
@@ -397,6 +397,13 @@ be_visitor_interface::visit_operation (be_operation *node)
         ctx.state (TAO_CodeGen::TAO_OPERATION_CH);
         be_visitor_operation_ch visitor (&ctx);
         status = node->accept (&visitor);
+
+        if (status == 0 && be_global->ami_coroutines ())
+          {
+            be_visitor_operation_ami_co_ch co_visitor (&ctx);
+            status = node->accept (&co_visitor);
+          }
+
         break;
       }
     case TAO_CodeGen::TAO_ROOT_CS:
@@ -411,6 +418,12 @@ be_visitor_interface::visit_operation (be_operation *node)
         {
           be_visitor_operation_cs visitor (&ctx);
           status = node->accept (&visitor);
+
+          if (status == 0 && be_global->ami_coroutines ())
+            {
+              be_visitor_operation_ami_co_cs co_visitor (&ctx);
+              status = node->accept (&co_visitor);
+            }
         }
 
       break;
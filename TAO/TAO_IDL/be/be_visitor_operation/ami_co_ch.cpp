@@ -0,0 +1,79 @@
+//=============================================================================
+/**
+ *  @file    ami_co_ch.cpp
+ *
+ *  Visitor generating the declaration of the co_ stub of an
+ *  operation in the client header.
+ */
+//=============================================================================
+
+#include "operation.h"
+
+be_visitor_operation_ami_co_ch::be_visitor_operation_ami_co_ch (
+    be_visitor_context *ctx)
+  : be_visitor_operation (ctx)
+{
+}
+
+be_visitor_operation_ami_co_ch::~be_visitor_operation_ami_co_ch (void)
+{
+}
+
+int
+be_visitor_operation_ami_co_ch::visit_operation (be_operation *node)
+{
+  if (!this->has_ami_co_stub (node))
+    {
+      return 0;
+    }
+
+  be_type *bt = be_type::narrow_from_decl (node->return_type ());
+
+  if (bt == 0)
+    {
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         ACE_TEXT ("be_visitor_operation_ami_co_ch::")
+                         ACE_TEXT ("visit_operation - ")
+                         ACE_TEXT ("Bad return type\n")),
+                        -1);
+    }
+
+  TAO_OutStream *os = this->ctx_->stream ();
+  this->ctx_->node (node);
+
+  // The awaitable gives what the synchronous stub returns.
+  *os << "\n\n#if TAO_HAS_AMI_COROUTINES == 1" << be_nl
+      << "::TAO::AMI_Awaitable< ";
+
+  be_visitor_context ctx (*this->ctx_);
+  be_visitor_operation_rettype or_visitor (&ctx);
+
+  if (bt->accept (&or_visitor) == -1)
+    {
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         "(%N:%l) be_visitor_operation_ami_co_ch::"
+                         "visit_operation - "
+                         "codegen for return type failed\n"),
+                        -1);
+    }
+
+  *os << "> co_" << node->local_name ();
+
+  // Same arguments as the synchronous stub.
+  ctx = *this->ctx_;
+  ctx.state (TAO_CodeGen::TAO_OPERATION_ARGLIST_CH);
+  be_visitor_operation_arglist oa_visitor (&ctx);
+
+  if (node->accept (&oa_visitor) == -1)
+    {
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         "(%N:%l) be_visitor_operation_ami_co_ch::"
+                         "visit_operation - "
+                         "codegen for argument list failed\n"),
+                        -1);
+    }
+
+  *os << "\n#endif /* TAO_HAS_AMI_COROUTINES == 1 */";
+
+  return 0;
+}
@@ -0,0 +1,282 @@
+//=============================================================================
+/**
+ *  @file    ami_co_cs.cpp
+ *
+ *  Visitor generating the co_ stub of an operation in the client
+ *  stubs.
+ */
+//=============================================================================
+
+#include "operation.h"
+
+be_visitor_operation_ami_co_cs::be_visitor_operation_ami_co_cs (
+    be_visitor_context *ctx)
+  : be_visitor_operation (ctx)
+{
+}
+
+be_visitor_operation_ami_co_cs::~be_visitor_operation_ami_co_cs (void)
+{
+}
+
+int
+be_visitor_operation_ami_co_cs::visit_operation (be_operation *node)
+{
+  if (!this->has_ami_co_stub (node))
+    {
+      return 0;
+    }
+
+  be_interface *intf =
+    be_interface::narrow_from_scope (node->defined_in ());
+
+  be_type *bt = be_type::narrow_from_decl (node->return_type ());
+
+  if (bt == 0)
+    {
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         ACE_TEXT ("be_visitor_operation_ami_co_cs::")
+                         ACE_TEXT ("visit_operation - ")
+                         ACE_TEXT ("Bad return type\n")),
+                        -1);
+    }
+
+  TAO_OutStream *os = this->ctx_->stream ();
+  this->ctx_->node (node);
+
+  *os << be_nl_2 << "#if TAO_HAS_AMI_COROUTINES == 1"
+      << be_nl_2 << "// TAO_IDL - Generated from" << be_nl
+      << "// " << __FILE__ << ":" << __LINE__ << be_nl_2;
+
+  *os << "::TAO::AMI_Awaitable< ";
+
+  be_visitor_context ctx (*this->ctx_);
+  be_visitor_operation_rettype or_visitor (&ctx);
+
+  if (bt->accept (&or_visitor) == -1)
+    {
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         "(%N:%l) be_visitor_operation_ami_co_cs::"
+                         "visit_operation - "
+                         "codegen for return type failed\n"),
+                        -1);
+    }
+
+  *os << ">" << be_nl
+      << intf->name () << "::co_" << node->local_name ();
+
+  ctx = *this->ctx_;
+  be_visitor_operation_arglist al_visitor (&ctx);
+
+  if (node->accept (&al_visitor) == -1)
+    {
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         "(%N:%l) be_visitor_operation_ami_co_cs::"
+                         "visit_operation - "
+                         "codegen for argument list failed\n"),
+                        -1);
+    }
+
+  *os << be_nl << "{" << be_idt_nl
+      << "if (!this->is_evaluated ())" << be_idt_nl
+      << "{" << be_idt_nl
+      << "::CORBA::Object::tao_object_initialize (this);"
+      << be_uidt_nl
+      << "}" << be_uidt_nl << be_nl;
+
+  // The reply holds the helpers for the return value and the inout
+  // and out arguments, as it outlives this call.
+  *os << "typedef ::TAO::AMI_Awaitable_Reply_T<" << be_idt << be_idt_nl;
+
+  this->gen_arg_template_param_name (node, bt, os);
+
+  AST_Argument *arg = 0;
+
+  for (UTL_ScopeActiveIterator i (node, UTL_Scope::IK_decls);
+       !i.is_done ();
+       i.next ())
+    {
+      arg = AST_Argument::narrow_from_decl (i.item ());
+
+      if (arg->direction () == AST_Argument::dir_IN)
+        {
+          continue;
+        }
+
+      *os << "," << be_nl
+          << "TAO::Arg_Traits< ";
+
+      this->gen_arg_template_param_name (arg, arg->field_type (), os);
+
+      *os << ">::"
+          << (arg->direction () == AST_Argument::dir_INOUT ? "inout" : "out")
+          << "_arg_val";
+    }
+
+  *os << be_uidt_nl
+      << "> _tao_reply_type;" << be_uidt_nl << be_nl
+      << "_tao_reply_type *_tao_reply = 0;" << be_nl
+      << "ACE_NEW_THROW_EX (" << be_idt << be_idt_nl
+      << "_tao_reply," << be_nl
+      << "_tao_reply_type (";
+
+  bool first = true;
+
+  for (UTL_ScopeActiveIterator i (node, UTL_Scope::IK_decls);
+       !i.is_done ();
+       i.next ())
+    {
+      arg = AST_Argument::narrow_from_decl (i.item ());
+
+      if (arg->direction () == AST_Argument::dir_IN)
+        {
+          continue;
+        }
+
+      *os << (first ? "" : ", ") << arg->local_name ();
+      first = false;
+    }
+
+  *os << ")," << be_nl
+      << "::CORBA::NO_MEMORY ());" << be_uidt << be_uidt_nl << be_nl;
+
+  *os << "::TAO::AMI_Awaitable< ";
+
+  ctx = *this->ctx_;
+
+  if (bt->accept (&or_visitor) == -1)
+    {
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         "(%N:%l) be_visitor_operation_ami_co_cs::"
+                         "visit_operation - "
+                         "codegen for return type failed\n"),
+                        -1);
+    }
+
+  *os << "> _tao_awaitable (_tao_reply);";
+
+  // The in arguments are only needed while the request is sent.
+  first = true;
+
+  for (UTL_ScopeActiveIterator i (node, UTL_Scope::IK_decls);
+       !i.is_done ();
+       i.next ())
+    {
+      arg = AST_Argument::narrow_from_decl (i.item ());
+
+      if (arg->direction () != AST_Argument::dir_IN)
+        {
+          continue;
+        }
+
+      if (first)
+        {
+          *os << be_nl;
+          first = false;
+        }
+
+      *os << be_nl
+          << "TAO::Arg_Traits< ";
+
+      this->gen_arg_template_param_name (arg, arg->field_type (), os);
+
+      *os << ">::in_arg_val _tao_" << arg->local_name () << " ("
+          << arg->local_name () << ");";
+    }
+
+  *os << be_nl_2
+      << "TAO::Argument *_the_tao_operation_signature [] =" << be_idt_nl
+      << "{" << be_idt_nl
+      << "_tao_reply->arg (0)";
+
+  ACE_CDR::ULong reply_arg = 0;
+
+  for (UTL_ScopeActiveIterator i (node, UTL_Scope::IK_decls);
+       !i.is_done ();
+       i.next ())
+    {
+      arg = AST_Argument::narrow_from_decl (i.item ());
+
+      *os << "," << be_nl;
+
+      if (arg->direction () == AST_Argument::dir_IN)
+        {
+          *os << "&_tao_" << arg->local_name ();
+        }
+      else
+        {
+          *os << "_tao_reply->arg (" << ++reply_arg << ")";
+        }
+    }
+
+  *os << be_uidt_nl
+      << "};" << be_uidt;
+
+  // The user exceptions come with the reply.
+  if (node->exceptions ())
+    {
+      if (this->gen_pre_stub_info (node) == -1)
+        {
+          ACE_ERROR_RETURN ((LM_ERROR,
+                             "(%N:%l) be_visitor_operation_ami_co_cs::"
+                             "visit_operation - "
+                             "codegen for exceptiondata failed\n"),
+                            -1);
+        }
+
+      *os << be_nl_2
+          << "_tao_reply->exceptions (" << be_idt << be_idt_nl
+          << "_tao_" << node->flat_name () << "_exceptiondata," << be_nl
+          << node->exceptions ()->length () << be_uidt_nl
+          << ");" << be_uidt;
+    }
+
+  ACE_CString opname (node->original_local_name ()->get_string ());
+
+  /// Some compilers can't resolve the stream operator overload.
+  const char *lname = opname.c_str ();
+  ACE_CString::size_type len = opname.length ();
+
+  *os << be_nl_2
+      << "TAO::Asynch_Invocation_Adapter _tao_call (" << be_idt << be_idt_nl
+      << "this," << be_nl
+      << "_the_tao_operation_signature," << be_nl
+      << node->argument_count () + 1 << "," << be_nl
+      << "\"" << lname << "\"," << be_nl
+      << len << "," << be_nl;
+
+  *os << "TAO::TAO_CO_NONE";
+
+  if (be_global->gen_direct_collocation ())
+    {
+      *os << " | TAO::TAO_CO_DIRECT_STRATEGY";
+    }
+
+  if (be_global->gen_thru_poa_collocation ())
+    {
+      *os << " | TAO::TAO_CO_THRU_POA_STRATEGY";
+    }
+
+  if (!node->has_in_arguments ())
+    {
+      *os << "," << be_nl
+          << "TAO::TAO_ASYNCHRONOUS_CALLBACK_INVOCATION," << be_nl
+          << "false";
+    }
+
+  *os << be_uidt_nl
+      << ");" << be_uidt;
+
+  *os << be_nl_2
+      << "_tao_call.invoke (" << be_idt << be_idt_nl
+      << "_tao_reply," << be_nl
+      << "&::TAO::AMI_Awaitable_Reply_Base::reply_stub" << be_uidt_nl
+      << ");" << be_uidt_nl << be_nl
+      << "return _tao_awaitable;";
+
+  *os << be_uidt_nl
+      << "}" << be_nl_2
+      << "#endif /* TAO_HAS_AMI_COROUTINES == 1 */";
+
+  return 0;
+}
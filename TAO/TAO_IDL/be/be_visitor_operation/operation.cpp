@@ -579,3 +579,22 @@ be_visitor_operation::gen_arg_template_param_name (AST_Decl *scope,
       *os << "_tag";
     }
 }
+
+bool
+be_visitor_operation::has_ami_co_stub (be_operation *node)
+{
+  be_interface *intf =
+    be_interface::narrow_from_scope (node->defined_in ());
+
+  // Only the twoway operations of remote interfaces get one, not
+  // those of the reply handlers or the implied sendc_ ones.
+  return intf != 0
+         && intf->node_type () == AST_Decl::NT_interface
+         && !intf->is_local ()
+         && !intf->is_abstract ()
+         && !intf->is_ami_rh ()
+         && node->flags () != AST_Operation::OP_oneway
+         && !node->is_sendc_ami ()
+         && !node->is_excep_ami ()
+         && !node->has_native ();
+}
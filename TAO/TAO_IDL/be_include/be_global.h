@@ -741,6 +741,13 @@ public:
   /// Return the flag.
   bool ami_call_back (void) const;
 
+  /// To enable or disable the co_ stubs returning an awaitable for
+  /// C++20 coroutines, next to the AMI call back ones.
+  void ami_coroutines (bool value);
+
+  /// Return the flag.
+  bool ami_coroutines (void) const;
+
   /// To enable or disable AMH in the generated code.
   void gen_amh_classes (bool value);
 
@@ -1157,6 +1164,9 @@ private:
    */
   bool ami_call_back_;
 
+  /// Flag for generating the co_ stubs for coroutines.
+  bool ami_coroutines_;
+
   /// Flag for generating AMH classes.
   bool gen_amh_classes_;
 
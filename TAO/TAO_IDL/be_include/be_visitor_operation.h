@@ -48,6 +48,8 @@
 // AMI
 #include "be_visitor_operation/ami_cs.h"
 #include "be_visitor_operation/ami_handler_reply_stub_operation_cs.h"
+#include "be_visitor_operation/ami_co_ch.h"
+#include "be_visitor_operation/ami_co_cs.h"
 
 // AMH
 #include "be_visitor_operation/amh_sh.h"
@@ -0,0 +1,39 @@
+//=============================================================================
+/**
+ *  @file    ami_co_ch.h
+ *
+ *  Visitor for generating the declaration of the co_ stub of an
+ *  operation in the client header
+ */
+//=============================================================================
+
+
+#ifndef _BE_VISITOR_OPERATION_AMI_CO_CH_H_
+#define _BE_VISITOR_OPERATION_AMI_CO_CH_H_
+
+// ************************************************************
+// Operation visitor for the co_ stubs in the client header
+// ************************************************************
+
+/**
+ * @class be_visitor_operation_ami_co_ch
+ *
+ * @brief be_visitor_operation_ami_co_ch
+ *
+ * This is a concrete visitor to declare the co_ stub of an operation,
+ * which returns an awaitable for C++20 coroutines.
+ */
+class be_visitor_operation_ami_co_ch : public be_visitor_operation
+{
+public:
+  /// constructor
+  be_visitor_operation_ami_co_ch (be_visitor_context *ctx);
+
+  /// destructor
+  ~be_visitor_operation_ami_co_ch (void);
+
+  /// visit operation.
+  virtual int visit_operation (be_operation *node);
+};
+
+#endif /* _BE_VISITOR_OPERATION_AMI_CO_CH_H_ */
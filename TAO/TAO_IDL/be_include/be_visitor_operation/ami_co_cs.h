@@ -0,0 +1,40 @@
+//=============================================================================
+/**
+ *  @file    ami_co_cs.h
+ *
+ *  Visitor for generating the co_ stub of an operation in the client
+ *  stubs
+ */
+//=============================================================================
+
+
+#ifndef _BE_VISITOR_OPERATION_AMI_CO_CS_H_
+#define _BE_VISITOR_OPERATION_AMI_CO_CS_H_
+
+// ************************************************************
+// Operation visitor for the co_ stubs in the client stubs
+// ************************************************************
+
+/**
+ * @class be_visitor_operation_ami_co_cs
+ *
+ * @brief be_visitor_operation_ami_co_cs
+ *
+ * This is a concrete visitor to generate the co_ stub of an
+ * operation.  It makes an asynchronous invocation, with a local reply
+ * object as the reply handler, and returns the awaitable for it.
+ */
+class be_visitor_operation_ami_co_cs : public be_visitor_operation
+{
+public:
+  /// constructor
+  be_visitor_operation_ami_co_cs (be_visitor_context *ctx);
+
+  /// destructor
+  ~be_visitor_operation_ami_co_cs (void);
+
+  /// visit operation.
+  virtual int visit_operation (be_operation *node);
+};
+
+#endif /* _BE_VISITOR_OPERATION_AMI_CO_CS_H_ */
@@ -82,6 +82,9 @@ public:
   void gen_arg_template_param_name (AST_Decl *scope,
                                     AST_Type *bt,
                                     TAO_OutStream *os);
+
+  /// Does the operation get a co_ stub, returning an awaitable?
+  bool has_ami_co_stub (be_operation *node);
 };
 
 #endif /* _BE_VISITOR_OPERATION_OPERATION_H_ */
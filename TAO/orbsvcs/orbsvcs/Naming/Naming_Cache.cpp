@@ -0,0 +1,308 @@
+#include "orbsvcs/Naming/Naming_Cache.h"
+#include "tao/debug.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_sys_time.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+TAO_Naming_Cache_Listener::TAO_Naming_Cache_Listener (TAO_Naming_Cache *cache)
+  : cache_ (cache)
+{
+}
+
+void
+TAO_Naming_Cache_Listener::binding_changed (const char *id, const char *kind)
+{
+  ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, this->lock_);
+  if (this->cache_ != 0)
+    this->cache_->invalidate (id, kind);
+}
+
+void
+TAO_Naming_Cache_Listener::detach (void)
+{
+  ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, this->lock_);
+  this->cache_ = 0;
+}
+
+TAO_Naming_Cache::TAO_Naming_Cache (CosNaming::NamingContext_ptr context,
+                                    const ACE_Time_Value &ttl,
+                                    size_t max_entries)
+  : context_ (CosNaming::NamingContext::_duplicate (context)),
+    ttl_ (ttl),
+    max_entries_ (max_entries),
+    generation_ (0),
+    hits_ (0),
+    subscription_ (0),
+    listener_ (0)
+{
+}
+
+TAO_Naming_Cache::~TAO_Naming_Cache (void)
+{
+  this->unsubscribe ();
+}
+
+int
+TAO_Naming_Cache::subscribe (CORBA::ORB_ptr orb)
+{
+  try
+    {
+      CORBA::Object_var obj =
+        orb->resolve_initial_references ("NameServiceCache");
+      NamingCache::Invalidator_var invalidator =
+        NamingCache::Invalidator::_narrow (obj.in ());
+
+      obj = orb->resolve_initial_references ("RootPOA");
+      PortableServer::POA_var poa =
+        PortableServer::POA::_narrow (obj.in ());
+
+      if (CORBA::is_nil (invalidator.in ()) || CORBA::is_nil (poa.in ()))
+        return -1;
+
+      PortableServer::POAManager_var manager = poa->the_POAManager ();
+      manager->activate ();
+
+      return this->subscribe (invalidator.in (), poa.in ());
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      if (TAO_debug_level > 0)
+        ex._tao_print_exception ("TAO_Naming_Cache::subscribe");
+    }
+
+  return -1;
+}
+
+int
+TAO_Naming_Cache::subscribe (NamingCache::Invalidator_ptr invalidator,
+                             PortableServer::POA_ptr poa)
+{
+  this->unsubscribe ();
+
+  TAO_Naming_Cache_Listener *listener = 0;
+  ACE_NEW_RETURN (listener,
+                  TAO_Naming_Cache_Listener (this),
+                  -1);
+  PortableServer::ServantBase_var owner (listener);
+
+  try
+    {
+      PortableServer::ObjectId_var id = poa->activate_object (listener);
+
+      try
+        {
+          CORBA::Object_var obj = poa->id_to_reference (id.in ());
+          NamingCache::Listener_var ref =
+            NamingCache::Listener::_narrow (obj.in ());
+
+          // The names resolved before the subscription may have changed.
+          this->invalidate_all ();
+
+          this->subscription_ = invalidator->subscribe (ref.in ());
+        }
+      catch (const CORBA::Exception&)
+        {
+          poa->deactivate_object (id.in ());
+          throw;
+        }
+
+      this->invalidator_ = NamingCache::Invalidator::_duplicate (invalidator);
+      this->poa_ = PortableServer::POA::_duplicate (poa);
+      this->listener_id_ = id._retn ();
+      this->listener_ = listener;
+      // The POA keeps the listener.
+      listener->_add_ref ();
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      listener->detach ();
+      if (TAO_debug_level > 0)
+        ex._tao_print_exception ("TAO_Naming_Cache::subscribe");
+      return -1;
+    }
+
+  return 0;
+}
+
+void
+TAO_Naming_Cache::unsubscribe (void)
+{
+  if (this->listener_ == 0)
+    return;
+
+  this->listener_->detach ();
+
+  try
+    {
+      this->invalidator_->unsubscribe (this->subscription_);
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      // The Naming Service drops the listener once it cannot reach it.
+      if (TAO_debug_level > 0)
+        ex._tao_print_exception ("TAO_Naming_Cache::unsubscribe");
+    }
+
+  try
+    {
+      this->poa_->deactivate_object (this->listener_id_.in ());
+    }
+  catch (const CORBA::Exception&)
+    {
+      // The POA may already be destroyed.
+    }
+
+  this->listener_->_remove_ref ();
+  this->listener_ = 0;
+  this->invalidator_ = NamingCache::Invalidator::_nil ();
+  this->poa_ = PortableServer::POA::_nil ();
+}
+
+bool
+TAO_Naming_Cache::subscribed (void) const
+{
+  return this->listener_ != 0;
+}
+
+void
+TAO_Naming_Cache::make_key (const CosNaming::Name &n, ACE_CString &key)
+{
+  // Escape the separators as a stringified name does, so that two
+  // names never have the same key.
+  for (CORBA::ULong i = 0; i < n.length (); ++i)
+    {
+      for (int k = 0; k < 2; ++k)
+        {
+          for (const char *c = (k == 0 ? n[i].id.in () : n[i].kind.in ());
+               *c != '\0';
+               ++c)
+            {
+              if (*c == '.' || *c == '\\' || *c == '/')
+                key += '\\';
+              key += *c;
+            }
+          key += (k == 0 ? '.' : '/');
+        }
+    }
+}
+
+CORBA::Object_ptr
+TAO_Naming_Cache::resolve (const CosNaming::Name &n)
+{
+  ACE_CString key;
+  make_key (n, key);
+
+  unsigned long generation = 0;
+  {
+    ACE_GUARD_THROW_EX (TAO_SYNCH_MUTEX, ace_mon, this->lock_,
+                        CORBA::INTERNAL ());
+
+    Entries::ENTRY *entry = 0;
+    if (this->entries_.find (key, entry) == 0)
+      {
+        if (this->ttl_ == ACE_Time_Value::zero
+            || ACE_OS::gettimeofday () < entry->int_id_.expiration_)
+          {
+            ++this->hits_;
+            return CORBA::Object::_duplicate (entry->int_id_.object_.in ());
+          }
+        this->entries_.unbind (entry);
+      }
+    generation = this->generation_;
+  }
+
+  CORBA::Object_var obj = this->context_->resolve (n);
+
+  ACE_GUARD_THROW_EX (TAO_SYNCH_MUTEX, ace_mon, this->lock_,
+                      CORBA::INTERNAL ());
+
+  if (generation == this->generation_)
+    {
+      ACE_Time_Value const now = ACE_OS::gettimeofday ();
+      if (this->entries_.current_size () >= this->max_entries_)
+        this->purge (now);
+
+      Entry entry;
+      entry.object_ = CORBA::Object::_duplicate (obj.in ());
+      entry.name_ = n;
+      entry.expiration_ = now + this->ttl_;
+      this->entries_.rebind (key, entry);
+    }
+
+  return obj._retn ();
+}
+
+void
+TAO_Naming_Cache::purge (const ACE_Time_Value &now)
+{
+  if (this->ttl_ != ACE_Time_Value::zero)
+    {
+      for (Entries::iterator i = this->entries_.begin ();
+           i != this->entries_.end ();
+           )
+        {
+          Entries::ENTRY &entry = *i;
+          ++i;
+          if (!(now < entry.int_id_.expiration_))
+            this->entries_.unbind (&entry);
+        }
+    }
+
+  if (this->entries_.current_size () >= this->max_entries_)
+    this->entries_.unbind_all ();
+}
+
+void
+TAO_Naming_Cache::invalidate (const char *id, const char *kind)
+{
+  ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, this->lock_);
+
+  ++this->generation_;
+
+  for (Entries::iterator i = this->entries_.begin ();
+       i != this->entries_.end ();
+       )
+    {
+      Entries::ENTRY &entry = *i;
+      ++i;
+
+      // Only the bindings of its components decide what a name
+      // resolves to.
+      const CosNaming::Name &n = entry.int_id_.name_;
+      for (CORBA::ULong c = 0; c < n.length (); ++c)
+        {
+          if (ACE_OS::strcmp (n[c].id.in (), id) == 0
+              && ACE_OS::strcmp (n[c].kind.in (), kind) == 0)
+            {
+              this->entries_.unbind (&entry);
+              break;
+            }
+        }
+    }
+}
+
+void
+TAO_Naming_Cache::invalidate_all (void)
+{
+  ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, this->lock_);
+
+  ++this->generation_;
+  this->entries_.unbind_all ();
+}
+
+size_t
+TAO_Naming_Cache::current_size (void)
+{
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, this->lock_, 0);
+  return this->entries_.current_size ();
+}
+
+unsigned long
+TAO_Naming_Cache::hits (void)
+{
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, this->lock_, 0);
+  return this->hits_;
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
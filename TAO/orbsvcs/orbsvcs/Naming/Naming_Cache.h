@@ -0,0 +1,162 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    Naming_Cache.h
+ *
+ *  A cache of the names a Naming Service client resolves.
+ */
+//=============================================================================
+
+#ifndef TAO_NAMING_CACHE_H
+#define TAO_NAMING_CACHE_H
+#include /**/ "ace/pre.h"
+
+#include "orbsvcs/CosNamingC.h"
+#include "orbsvcs/NamingCacheS.h"
+#include "orbsvcs/Naming/naming_export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "tao/PortableServer/PortableServer.h"
+#include "ace/Hash_Map_Manager_T.h"
+#include "ace/Null_Mutex.h"
+#include "ace/SString.h"
+#include "ace/Time_Value.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+class TAO_Naming_Cache;
+
+/**
+ * @class TAO_Naming_Cache_Listener
+ *
+ * @brief The NamingCache::Listener of a TAO_Naming_Cache.
+ */
+class TAO_Naming_Export TAO_Naming_Cache_Listener
+  : public virtual POA_NamingCache::Listener
+{
+public:
+  TAO_Naming_Cache_Listener (TAO_Naming_Cache *cache);
+
+  /// Invalidate the names of the cache that contain the component.
+  virtual void binding_changed (const char *id, const char *kind);
+
+  /// Stop forwarding the changes to the cache, which is going away.
+  void detach (void);
+
+private:
+  TAO_SYNCH_MUTEX lock_;
+  TAO_Naming_Cache *cache_;
+};
+
+/**
+ * @class TAO_Naming_Cache
+ *
+ * @brief Resolves names through a naming context and keeps the
+ * objects they resolved to.
+ *
+ * A name is resolved remotely the first time, and then from the cache
+ * until its entry expires, after the time to live of the cache.  Once
+ * subscribed to the NamingCache::Invalidator of the Naming Service,
+ * the cache is also told when a binding changes: the names that
+ * contain the component of the binding are removed from the cache at
+ * once.  The ORB of the client must then be run, or perform work, for
+ * the changes to be received.
+ *
+ * A NotFound or other exception of resolve () is never cached.
+ */
+class TAO_Naming_Export TAO_Naming_Cache
+{
+public:
+  /**
+   * @param context The naming context the names are resolved in.
+   * @param ttl How long a name is kept.  ACE_Time_Value::zero keeps
+   *        the names until they are invalidated.
+   * @param max_entries Number of names above which the expired names
+   *        are removed, and then all the names if none expired.
+   */
+  TAO_Naming_Cache (CosNaming::NamingContext_ptr context,
+                    const ACE_Time_Value &ttl,
+                    size_t max_entries = 1024);
+
+  /// Unsubscribes from the Invalidator.
+  ~TAO_Naming_Cache (void);
+
+  /**
+   * Subscribe to the Invalidator found with
+   * resolve_initial_references ("NameServiceCache"), activating the
+   * listener in the RootPOA of @a orb.  Returns -1 if there is no
+   * Invalidator or it cannot be reached; the names then only expire.
+   */
+  int subscribe (CORBA::ORB_ptr orb);
+
+  /// Subscribe to @a invalidator, activating the listener in @a poa.
+  int subscribe (NamingCache::Invalidator_ptr invalidator,
+                 PortableServer::POA_ptr poa);
+
+  /// Stop being told of the changes of the bindings.
+  void unsubscribe (void);
+
+  /// Is the cache told of the changes of the bindings?
+  bool subscribed (void) const;
+
+  /// Same as CosNaming::NamingContext::resolve ().
+  CORBA::Object_ptr resolve (const CosNaming::Name &n);
+
+  /// Remove the names that contain the component @a id, @a kind.
+  void invalidate (const char *id, const char *kind);
+
+  /// Remove all the names.
+  void invalidate_all (void);
+
+  /// Number of names in the cache.
+  size_t current_size (void);
+
+  /// Number of resolve () calls answered from the cache.
+  unsigned long hits (void);
+
+private:
+  struct Entry
+  {
+    CORBA::Object_var object_;
+    CosNaming::Name name_;
+    ACE_Time_Value expiration_;
+  };
+
+  typedef ACE_Hash_Map_Manager_Ex<ACE_CString,
+                                  Entry,
+                                  ACE_Hash<ACE_CString>,
+                                  ACE_Equal_To<ACE_CString>,
+                                  ACE_Null_Mutex> Entries;
+
+  /// The key of @a n in the map.
+  static void make_key (const CosNaming::Name &n, ACE_CString &key);
+
+  /// Make room for a new entry.  Called with the lock held.
+  void purge (const ACE_Time_Value &now);
+
+  CosNaming::NamingContext_var context_;
+  ACE_Time_Value ttl_;
+  size_t max_entries_;
+
+  TAO_SYNCH_MUTEX lock_;
+  Entries entries_;
+  /// Changed by each invalidation, so that a name resolved while it is
+  /// invalidated is not added to the cache.
+  unsigned long generation_;
+  unsigned long hits_;
+
+  NamingCache::Invalidator_var invalidator_;
+  CORBA::ULong subscription_;
+  PortableServer::POA_var poa_;
+  PortableServer::ObjectId_var listener_id_;
+  TAO_Naming_Cache_Listener *listener_;
+};
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#include /**/ "ace/post.h"
+#endif /* TAO_NAMING_CACHE_H */
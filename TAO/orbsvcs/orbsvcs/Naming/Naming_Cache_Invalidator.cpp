@@ -0,0 +1,82 @@
+#include "orbsvcs/Naming/Naming_Cache_Invalidator.h"
+#include "tao/debug.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+TAO_Naming_Cache_Invalidator::TAO_Naming_Cache_Invalidator (void)
+  : next_id_ (0)
+{
+}
+
+TAO_Naming_Cache_Invalidator::~TAO_Naming_Cache_Invalidator (void)
+{
+}
+
+CORBA::ULong
+TAO_Naming_Cache_Invalidator::subscribe (NamingCache::Listener_ptr l)
+{
+  if (CORBA::is_nil (l))
+    throw CORBA::BAD_PARAM ();
+
+  ACE_GUARD_THROW_EX (TAO_SYNCH_MUTEX, ace_mon, this->lock_,
+                      CORBA::INTERNAL ());
+
+  Subscriber subscriber;
+  subscriber.id_ = ++this->next_id_;
+  subscriber.listener_ = NamingCache::Listener::_duplicate (l);
+  this->subscribers_.push_back (subscriber);
+
+  return subscriber.id_;
+}
+
+void
+TAO_Naming_Cache_Invalidator::unsubscribe (CORBA::ULong id)
+{
+  ACE_GUARD_THROW_EX (TAO_SYNCH_MUTEX, ace_mon, this->lock_,
+                      CORBA::INTERNAL ());
+
+  size_t const size = this->subscribers_.size ();
+  for (size_t i = 0; i != size; ++i)
+    {
+      if (this->subscribers_[i].id_ == id)
+        {
+          // The order of the listeners does not matter.
+          this->subscribers_[i] = this->subscribers_[size - 1];
+          this->subscribers_.pop_back ();
+          return;
+        }
+    }
+}
+
+void
+TAO_Naming_Cache_Invalidator::binding_changed (const char *id,
+                                               const char *kind)
+{
+  ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, this->lock_);
+  if (this->subscribers_.size () == 0)
+    return;
+
+  Subscribers subscribers;
+  for (size_t i = 0; i != this->subscribers_.size (); ++i)
+    subscribers.push_back (this->subscribers_[i]);
+  ace_mon.release ();
+
+  // The listeners are called without the lock, which would otherwise
+  // serialize the changes on the slowest listener.
+  for (size_t i = 0; i != subscribers.size (); ++i)
+    {
+      try
+        {
+          subscribers[i].listener_->binding_changed (id, kind);
+        }
+      catch (const CORBA::Exception& ex)
+        {
+          if (TAO_debug_level > 0)
+            ex._tao_print_exception (
+              "TAO_Naming_Cache_Invalidator::binding_changed");
+          this->unsubscribe (subscribers[i].id_);
+        }
+    }
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
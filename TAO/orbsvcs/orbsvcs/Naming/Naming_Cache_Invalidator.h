@@ -0,0 +1,71 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file   Naming_Cache_Invalidator.h
+ *
+ *  The NamingCache::Invalidator of the Naming Service.
+ */
+//=============================================================================
+
+#ifndef TAO_NAMING_CACHE_INVALIDATOR_H
+#define TAO_NAMING_CACHE_INVALIDATOR_H
+#include /**/ "ace/pre.h"
+
+#include "orbsvcs/NamingCacheS.h"
+#include "orbsvcs/Naming/naming_serv_export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "ace/Vector_T.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class TAO_Naming_Cache_Invalidator
+ *
+ * @brief Tells the clients that cache names (see TAO_Naming_Cache)
+ * when a binding changes.
+ *
+ * TAO_Naming_Context calls binding_changed () after each bind, rebind
+ * or unbind of a simple name, which sends the name to each listener
+ * with a oneway call.  A listener that cannot be reached is dropped.
+ * The changes made by the other servers, in redundant mode or in
+ * federated contexts, are not seen: the clients only learn of them
+ * once the names expire.
+ */
+class TAO_Naming_Serv_Export TAO_Naming_Cache_Invalidator
+  : public virtual POA_NamingCache::Invalidator
+{
+public:
+  TAO_Naming_Cache_Invalidator (void);
+
+  virtual ~TAO_Naming_Cache_Invalidator (void);
+
+  virtual CORBA::ULong subscribe (NamingCache::Listener_ptr l);
+
+  virtual void unsubscribe (CORBA::ULong id);
+
+  /// Tell the listeners that the binding of @a id, @a kind changed.
+  void binding_changed (const char *id, const char *kind);
+
+private:
+  struct Subscriber
+  {
+    CORBA::ULong id_;
+    NamingCache::Listener_var listener_;
+  };
+
+  typedef ACE_Vector<Subscriber> Subscribers;
+
+  TAO_SYNCH_MUTEX lock_;
+  Subscribers subscribers_;
+  CORBA::ULong next_id_;
+};
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#include /**/ "ace/post.h"
+#endif /* TAO_NAMING_CACHE_INVALIDATOR_H */
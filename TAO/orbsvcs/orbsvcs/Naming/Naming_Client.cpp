@@ -1,6 +1,8 @@
 #include "orbsvcs/Naming/Naming_Client.h"
+#include "orbsvcs/Naming/Naming_Cache.h"
 #include "orbsvcs/CosNamingC.h"
 #include "orbsvcs/Log_Macros.h"
+#include "tao/debug.h"
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -31,6 +33,7 @@ TAO_Naming_Client::init (CORBA::ORB_ptr orb, ACE_Time_Value *timeout)
                           -1);
       this->naming_context_ =
         CosNaming::NamingContext::_narrow (naming_obj.in ());
+      this->orb_ = CORBA::ORB::_duplicate (orb);
     }
   catch (const CORBA::Exception& ex)
     {
@@ -41,14 +44,52 @@ TAO_Naming_Client::init (CORBA::ORB_ptr orb, ACE_Time_Value *timeout)
   return 0;
 }
 
+int
+TAO_Naming_Client::enable_cache (const ACE_Time_Value &ttl, size_t max_entries)
+{
+  if (CORBA::is_nil (this->naming_context_.in ()))
+    return -1;
+
+  delete this->cache_;
+  this->cache_ = 0;
+  ACE_NEW_RETURN (this->cache_,
+                  TAO_Naming_Cache (this->naming_context_.in (),
+                                    ttl,
+                                    max_entries),
+                  -1);
+
+  if (this->cache_->subscribe (this->orb_.in ()) != 0
+      && TAO_debug_level > 0)
+    ORBSVCS_DEBUG ((LM_DEBUG,
+                    " (%P|%t) TAO_Naming_Client: no NameServiceCache, "
+                    "the cached names only expire\n"));
+
+  return 0;
+}
+
+CORBA::Object_ptr
+TAO_Naming_Client::resolve (const CosNaming::Name &n)
+{
+  if (this->cache_ != 0)
+    return this->cache_->resolve (n);
+
+  return this->naming_context_->resolve (n);
+}
+
+TAO_Naming_Cache *
+TAO_Naming_Client::cache (void) const
+{
+  return this->cache_;
+}
+
 TAO_Naming_Client::TAO_Naming_Client (void)
+  : cache_ (0)
 {
-  // Do nothing
 }
 
 TAO_Naming_Client::~TAO_Naming_Client (void)
 {
-  // Do nothing
+  delete this->cache_;
 }
 
 TAO_END_VERSIONED_NAMESPACE_DECL
@@ -20,9 +20,12 @@
 #include "tao/ORB.h"
 #include "orbsvcs/CosNamingC.h"
 #include "orbsvcs/Naming/naming_export.h"
+#include "ace/Time_Value.h"
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
+class TAO_Naming_Cache;
+
 /**
  * @class TAO_Naming_Client
  *
@@ -34,6 +37,10 @@ TAO_BEGIN_VERSIONED_NAMESPACE_DECL
  * <resolve>, etc. can be directly called on a
  * <TAO_Naming_Client> object, and will be forwarded to the root
  * Naming Context.
+ *
+ * Once enable_cache () is called, resolve () keeps the objects the
+ * names resolve to in a TAO_Naming_Cache, so that the names that are
+ * resolved again do not need a remote call.
  */
 class TAO_Naming_Export TAO_Naming_Client
 {
@@ -63,9 +70,35 @@ public:
    */
   CosNaming::NamingContext_ptr get_context (void) const;
 
+  /**
+   * Cache the names resolved with resolve () for @a ttl, or until the
+   * Naming Service tells that their bindings changed, see
+   * TAO_Naming_Cache.  The Invalidator of the Naming Service is found
+   * with resolve_initial_references ("NameServiceCache"); if it is not
+   * found, the names only expire.  Returns -1 if init () did not
+   * succeed.
+   */
+  int enable_cache (const ACE_Time_Value &ttl, size_t max_entries = 1024);
+
+  /// Resolve @a n in the root Naming Context, through the cache if it
+  /// is enabled.
+  CORBA::Object_ptr resolve (const CosNaming::Name &n);
+
+  /// The cache, or 0 if it is not enabled.
+  TAO_Naming_Cache *cache (void) const;
+
 protected:
   /// Reference to the root Naming Context.
   CosNaming::NamingContext_var naming_context_;
+
+  CORBA::ORB_var orb_;
+
+  TAO_Naming_Cache *cache_;
+
+private:
+  // The client owns its cache.
+  TAO_Naming_Client (const TAO_Naming_Client &);
+  TAO_Naming_Client &operator= (const TAO_Naming_Client &);
 };
 
 TAO_END_VERSIONED_NAMESPACE_DECL
@@ -9,6 +9,8 @@
 
 
 #include "orbsvcs/Naming/Naming_Context_Interface.h"
+#include "orbsvcs/Naming/Naming_Cache_Invalidator.h"
+#include "orbsvcs/Naming/nsconf.h"
 #include "ace/ACE.h"
 #include "ace/OS_NS_string.h"
 #include "ace/OS_NS_ctype.h"
@@ -16,7 +18,8 @@
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
 TAO_Naming_Context::TAO_Naming_Context (TAO_Naming_Context_Impl *impl)
-  : impl_ (impl)
+  : cache_invalidator_resolved_ (false),
+    impl_ (impl)
 {
 }
 
@@ -31,16 +34,58 @@ TAO_Naming_Context::_default_POA (/*env*/)
   return impl_->_default_POA ();
 }
 
+TAO_Naming_Cache_Invalidator *
+TAO_Naming_Context::cache_invalidator (void)
+{
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, this->cache_invalidator_lock_, 0);
+
+  if (!this->cache_invalidator_resolved_)
+    {
+      this->cache_invalidator_resolved_ = true;
+
+#if !defined (CORBA_E_MICRO)
+      try
+        {
+          PortableServer::POA_var poa = this->_default_POA ();
+          PortableServer::ObjectId_var id =
+            PortableServer::string_to_ObjectId (TAO_NAMING_CACHE_INVALIDATOR);
+          this->cache_invalidator_ = poa->id_to_servant (id.in ());
+        }
+      catch (const CORBA::Exception&)
+        {
+          // This context does not belong to a Naming server with an
+          // invalidator.
+        }
+#endif /* CORBA_E_MICRO */
+    }
+
+  return dynamic_cast<TAO_Naming_Cache_Invalidator *> (
+    this->cache_invalidator_.in ());
+}
+
+void
+TAO_Naming_Context::binding_changed (const CosNaming::Name &n)
+{
+  if (n.length () != 1)
+    return;
+
+  TAO_Naming_Cache_Invalidator *invalidator = this->cache_invalidator ();
+  if (invalidator != 0)
+    invalidator->binding_changed (n[0].id.in (), n[0].kind.in ());
+}
+
 void
 TAO_Naming_Context::bind (const CosNaming::Name &n, CORBA::Object_ptr obj)
 {
   impl_->bind (n, obj);
+  this->binding_changed (n);
 }
 
 void
 TAO_Naming_Context::rebind (const CosNaming::Name &n, CORBA::Object_ptr obj)
 {
   impl_->rebind (n, obj);
+  this->binding_changed (n);
 }
 
 void
@@ -48,6 +93,7 @@ TAO_Naming_Context::bind_context (const CosNaming::Name &n,
                                   CosNaming::NamingContext_ptr nc)
 {
   impl_->bind_context (n, nc);
+  this->binding_changed (n);
 }
 
 void
@@ -55,6 +101,7 @@ TAO_Naming_Context::rebind_context (const CosNaming::Name &n,
                                     CosNaming::NamingContext_ptr nc)
 {
   impl_->rebind_context (n, nc);
+  this->binding_changed (n);
 }
 
 CORBA::Object_ptr
@@ -67,6 +114,7 @@ void
 TAO_Naming_Context::unbind (const CosNaming::Name &n)
 {
   impl_->unbind (n);
+  this->binding_changed (n);
 }
 
 CosNaming::NamingContext_ptr
@@ -78,7 +126,9 @@ TAO_Naming_Context::new_context (void)
 CosNaming::NamingContext_ptr
 TAO_Naming_Context::bind_new_context (const CosNaming::Name &n)
 {
-  return impl_->bind_new_context (n);
+  CosNaming::NamingContext_var nc = impl_->bind_new_context (n);
+  this->binding_changed (n);
+  return nc._retn ();
 }
 
 void
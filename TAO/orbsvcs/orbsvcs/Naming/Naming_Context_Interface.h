@@ -21,6 +21,7 @@
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
 class TAO_Naming_Context_Impl;
+class TAO_Naming_Cache_Invalidator;
 
 // This is to remove "inherits via dominance" warnings from MSVC.
 #if defined (_MSC_VER)
@@ -186,6 +187,21 @@ public:
 
 private:
 
+  /// Tell the cache invalidator, if any, that the binding of @a n
+  /// changed.  Only simple names are told: the change of a compound
+  /// name is told by the context that holds its last component.
+  void binding_changed (const CosNaming::Name &n);
+
+  /// The invalidator of the Naming server of this context, or 0 if
+  /// it has none.  The server activates it in the poa of its
+  /// contexts, where it is looked up the first time a binding of
+  /// this context changes.
+  TAO_Naming_Cache_Invalidator *cache_invalidator (void);
+
+  TAO_SYNCH_MUTEX cache_invalidator_lock_;
+  PortableServer::ServantBase_var cache_invalidator_;
+  bool cache_invalidator_resolved_;
+
   enum Hint
     {
       HINT_ID,
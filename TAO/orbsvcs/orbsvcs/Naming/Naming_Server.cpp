@@ -9,6 +9,7 @@
 #endif
 
 #include "orbsvcs/Naming/Transient_Naming_Context.h"
+#include "orbsvcs/Naming/Naming_Cache_Invalidator.h"
 #include "orbsvcs/Naming/Persistent_Naming_Context_Factory.h"
 #include "orbsvcs/Naming/Storable_Naming_Context_Factory.h"
 
@@ -18,6 +19,7 @@
 #include "orbsvcs/Naming/Storable_Naming_Context_Activator.h"
 
 #include "tao/Storable_FlatFileStream.h"
+#include "tao/Storable_MappedFileStream.h"
 
 #endif /* CORBA_E_MICRO */
 
@@ -51,6 +53,7 @@ TAO_Naming_Server::TAO_Naming_Server (void)
     persistence_file_name_ (0),
     base_address_ (TAO_NAMING_BASE_ADDR),
     use_storable_context_ (0),
+    use_mapped_store_ (0),
     use_servant_activator_ (false),
     servant_activator_ (0),
 #endif /* CORBA_E_MICRO */
@@ -83,6 +86,7 @@ TAO_Naming_Server::TAO_Naming_Server (CORBA::ORB_ptr orb,
     persistence_file_name_ (0),
     base_address_ (TAO_NAMING_BASE_ADDR),
     use_storable_context_ (use_storable_context),
+    use_mapped_store_ (0),
     use_servant_activator_ (false),
     servant_activator_ (0),
 #endif /* CORBA_E_MICRO */
@@ -173,7 +177,7 @@ TAO_Naming_Server::parse_args (int argc,
                                ACE_TCHAR *argv[])
 {
 #if (TAO_HAS_MINIMUM_POA == 0) && !defined (CORBA_E_COMPACT)
-  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("b:do:p:s:f:m:u:r:z:"));
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("b:do:p:s:f:m:u:l:r:z:"));
 #else
   ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("b:do:p:s:f:m:z:"));
 #endif /* TAO_HAS_MINIMUM_POA */
@@ -196,6 +200,7 @@ TAO_Naming_Server::parse_args (int argc,
   // Make sure only one persistence option is specified
   int f_opt_used = 0;
   int u_opt_used = 0;
+  int l_opt_used = 0;
   int r_opt_used = 0;
 
   while ((c = get_opts ()) != -1)
@@ -249,6 +254,12 @@ TAO_Naming_Server::parse_args (int argc,
         this->persistence_file_name_ = get_opts.opt_arg ();
         u_opt_used = 1;
         break;
+      case 'l':
+        this->use_storable_context_ = 1;
+        this->use_mapped_store_ = 1;
+        this->persistence_file_name_ = get_opts.opt_arg ();
+        l_opt_used = 1;
+        break;
 #endif /* TAO_HAS_MINIMUM_POA == 0 */
 #endif /* !CORBA_E_MICRO */
       case 'z':
@@ -264,6 +275,7 @@ TAO_Naming_Server::parse_args (int argc,
 #endif /* CORBA_E_MICRO */
 #if (TAO_HAS_MINIMUM_POA == 0) && !defined (CORBA_E_MICRO)
           ACE_TEXT ("-u <storable_persistence_directory (not used with -f)> ")
+          ACE_TEXT ("-l <mapped_store_directory (not used with -f or -u)> ")
           ACE_TEXT ("-r <redundant_persistence_directory> ");
 #else
           ACE_TEXT ("");
@@ -285,7 +297,7 @@ TAO_Naming_Server::parse_args (int argc,
                           -1);
       }
 
-  if (f_opt_used + u_opt_used + r_opt_used > 1)
+  if (f_opt_used + u_opt_used + l_opt_used + r_opt_used > 1)
     ORBSVCS_ERROR_RETURN ((LM_ERROR,
                        ACE_TEXT ("Only one persistence option can be passed")
                        ACE_TEXT ("\n")),
@@ -484,7 +496,10 @@ TAO_Naming_Server::init_new_naming (CORBA::ORB_ptr orb,
           // command line for now.
           TAO::Storable_Factory* pf = 0;
           ACE_CString directory (ACE_TEXT_ALWAYS_CHAR (persistence_location));
-          ACE_NEW_RETURN (pf, TAO::Storable_FlatFileFactory (directory), -1);
+          if (this->use_mapped_store_)
+            ACE_NEW_RETURN (pf, TAO::Storable_MappedFileFactory (directory), -1);
+          else
+            ACE_NEW_RETURN (pf, TAO::Storable_FlatFileFactory (directory), -1);
           auto_ptr<TAO::Storable_Factory> persFactory(pf);
 
           // Use an auto_ptr to ensure that we clean up the factory in the case
@@ -623,6 +638,24 @@ TAO_Naming_Server::init_new_naming (CORBA::ORB_ptr orb,
       this->naming_service_ior_=
         orb->object_to_string (this->naming_context_.in ());
 
+#if !defined (CORBA_E_MICRO)
+      // Activate the invalidator that tells the clients that cache
+      // names when the bindings change.  The contexts of this server
+      // find it in their poa.
+      TAO_Naming_Cache_Invalidator *invalidator = 0;
+      ACE_NEW_RETURN (invalidator, TAO_Naming_Cache_Invalidator, -1);
+      PortableServer::ServantBase_var owner (invalidator);
+
+      PortableServer::ObjectId_var invalidator_id =
+        PortableServer::string_to_ObjectId (TAO_NAMING_CACHE_INVALIDATOR);
+      poa->activate_object_with_id (invalidator_id.in (), invalidator);
+      CORBA::Object_var invalidator_obj =
+        poa->id_to_reference (invalidator_id.in ());
+
+      orb->register_initial_reference ("NameServiceCache",
+                                       invalidator_obj.in ());
+#endif /* CORBA_E_MICRO */
+
       CORBA::Object_var table_object =
         orb->resolve_initial_references ("IORTable");
 
@@ -637,6 +670,11 @@ TAO_Naming_Server::init_new_naming (CORBA::ORB_ptr orb,
           CORBA::String_var ior =
             orb->object_to_string (this->naming_context_.in ());
           adapter->bind ("NameService", ior.in ());
+
+#if !defined (CORBA_E_MICRO)
+          ior = orb->object_to_string (invalidator_obj.in ());
+          adapter->bind ("NameServiceCache", ior.in ());
+#endif /* CORBA_E_MICRO */
         }
 
 #if defined (ACE_HAS_IP_MULTICAST)
@@ -841,11 +879,15 @@ TAO_Naming_Server::fini (void)
       else
         {
           adapter->unbind ("NameService");
+#if !defined (CORBA_E_MICRO)
+          adapter->unbind ("NameServiceCache");
+#endif /* CORBA_E_MICRO */
         }
 
 #if !defined (CORBA_E_MICRO)
       CORBA::Object_var svc =
         this->orb_->unregister_initial_reference ("NameService");
+      svc = this->orb_->unregister_initial_reference ("NameServiceCache");
 #endif /* CORBA_E_MICRO */
 
     }
@@ -229,6 +229,10 @@ protected:
   /// If not zero use flat file persistence
   int use_storable_context_;
 
+  /// If not zero the storable contexts are kept in a
+  /// TAO::Storable_MappedFileStore rather than in flat files.
+  int use_mapped_store_;
+
   /**
    * If not zero use servant activator that uses flat file persistence.
    */
@@ -250,6 +250,26 @@ void TAO_Storable_Naming_Context::Write (TAO::Storable_Base& wrtr)
 
 }
 
+void TAO_Storable_Naming_Context::Write_change (TAO::Storable_Base& wrtr,
+                                                const char *id,
+                                                const char *kind)
+{
+  ACE_TRACE("Write_change");
+  TAO_Storable_Naming_Context_ReaderWriter rw(wrtr);
+  rw.write_change(*this, id, kind);
+}
+
+bool
+TAO_Storable_Naming_Context::journal_change (void)
+{
+  if (redundant_ || !this->factory_->append_supported ())
+    return false;
+
+  size_t const size =
+    this->storable_context_ == 0 ? 0 : this->storable_context_->current_size ();
+  return this->journal_length_ <= size + 16;
+}
+
 // Helpers function to load a new context into the binding_map
 int
 TAO_Storable_Naming_Context::load_map (TAO::Storable_Base& storable)
@@ -263,9 +283,11 @@ TAO_Storable_Naming_Context::
 File_Open_Lock_and_Check::File_Open_Lock_and_Check
 (TAO_Storable_Naming_Context * context,
  Method_Type method_type,
- bool force_load)
+ bool force_load,
+ bool append)
 : TAO::Storable_File_Guard (TAO_Storable_Naming_Context::redundant_),
-  context_(context)
+  context_(context),
+  append_(append)
 {
   try
     {
@@ -375,6 +397,12 @@ File_Open_Lock_and_Check::create_stream (const char * mode)
   ACE_CString file_name = context_->context_name_;
 
   // Create the stream
+  if (this->append_)
+    {
+      ACE_CString append_mode (mode);
+      append_mode += "a";
+      return context_->factory_->create_stream(file_name, append_mode.c_str ());
+    }
   return context_->factory_->create_stream(file_name, mode);
 }
 
@@ -399,7 +427,8 @@ TAO_Storable_Naming_Context::TAO_Storable_Naming_Context (
     hash_table_size_ (hash_table_size),
     last_changed_ (0),
     last_check_ (0),
-    write_occurred_ (0)
+    write_occurred_ (0),
+    journal_length_ (0)
 {
   ACE_TRACE("TAO_Storable_Naming_Context");
   // Create a temporary stream simply to check if a readable
@@ -643,7 +672,8 @@ TAO_Storable_Naming_Context::rebind (const CosNaming::Name& n,
       ACE_WRITE_GUARD_THROW_EX (ACE_SYNCH_RW_MUTEX, ace_mon,
                                 this->lock_,
                                 CORBA::INTERNAL ());
-      File_Open_Lock_and_Check flck (this, SFG::MUTATOR);
+      bool const journal = this->journal_change ();
+      File_Open_Lock_and_Check flck (this, SFG::MUTATOR, true, journal);
       if (this->destroyed_)
         throw CORBA::OBJECT_NOT_EXIST ();
 
@@ -660,7 +690,10 @@ TAO_Storable_Naming_Context::rebind (const CosNaming::Name& n,
           CosNaming::NamingContext::not_object,
           n);
 
-      this->Write (flck.peer());
+      if (journal)
+        this->Write_change (flck.peer (), n[0].id, n[0].kind);
+      else
+        this->Write (flck.peer ());
     }
 }
 
@@ -686,7 +719,8 @@ TAO_Storable_Naming_Context::bind_context (const CosNaming::Name &n,
       ACE_WRITE_GUARD_THROW_EX (ACE_SYNCH_RW_MUTEX, ace_mon,
                                 this->lock_,
                                 CORBA::INTERNAL ());
-      File_Open_Lock_and_Check flck (this, SFG::MUTATOR);
+      bool const journal = this->journal_change ();
+      File_Open_Lock_and_Check flck (this, SFG::MUTATOR, true, journal);
       if (this->destroyed_)
         throw CORBA::OBJECT_NOT_EXIST ();
 
@@ -701,7 +735,10 @@ TAO_Storable_Naming_Context::bind_context (const CosNaming::Name &n,
       else if (result == -1)
         throw CORBA::INTERNAL ();
 
-      this->Write(flck.peer());
+      if (journal)
+        this->Write_change (flck.peer (), n[0].id, n[0].kind);
+      else
+        this->Write (flck.peer ());
     }
 }
 
@@ -727,7 +764,8 @@ TAO_Storable_Naming_Context::rebind_context (const CosNaming::Name &n,
                                 this->lock_,
                                 CORBA::INTERNAL ());
 
-      File_Open_Lock_and_Check flck (this, SFG::MUTATOR);
+      bool const journal = this->journal_change ();
+      File_Open_Lock_and_Check flck (this, SFG::MUTATOR, true, journal);
       if (this->destroyed_)
         throw CORBA::OBJECT_NOT_EXIST ();
 
@@ -742,7 +780,10 @@ TAO_Storable_Naming_Context::rebind_context (const CosNaming::Name &n,
           CosNaming::NamingContext::not_context,
           n);
 
-      this->Write(flck.peer());
+      if (journal)
+        this->Write_change (flck.peer (), n[0].id, n[0].kind);
+      else
+        this->Write (flck.peer ());
     }
 }
 
@@ -798,7 +839,8 @@ TAO_Storable_Naming_Context::unbind (const CosNaming::Name& n)
                                 this->lock_,
                                 CORBA::INTERNAL ());
 
-      File_Open_Lock_and_Check flck (this, SFG::MUTATOR);
+      bool const journal = this->journal_change ();
+      File_Open_Lock_and_Check flck (this, SFG::MUTATOR, true, journal);
       if (this->destroyed_)
         throw CORBA::OBJECT_NOT_EXIST ();
 
@@ -808,7 +850,10 @@ TAO_Storable_Naming_Context::unbind (const CosNaming::Name& n)
           CosNaming::NamingContext::missing_node,
           n);
 
-      this->Write(flck.peer());
+      if (journal)
+        this->Write_change (flck.peer (), n[0].id, n[0].kind);
+      else
+        this->Write (flck.peer ());
     }
 }
 
@@ -830,7 +875,8 @@ TAO_Storable_Naming_Context::bind (const CosNaming::Name& n,
       ACE_WRITE_GUARD_THROW_EX (ACE_SYNCH_RW_MUTEX, ace_mon,
                                 this->lock_,
                                 CORBA::INTERNAL ());
-      File_Open_Lock_and_Check flck(this, SFG::MUTATOR);
+      bool const journal = this->journal_change ();
+      File_Open_Lock_and_Check flck (this, SFG::MUTATOR, true, journal);
       if (this->destroyed_)
         throw CORBA::OBJECT_NOT_EXIST ();
 
@@ -843,7 +889,10 @@ TAO_Storable_Naming_Context::bind (const CosNaming::Name& n,
       else if (result == -1)
         throw CORBA::INTERNAL ();
 
-      this->Write (flck.peer());
+      if (journal)
+        this->Write_change (flck.peer (), n[0].id, n[0].kind);
+      else
+        this->Write (flck.peer ());
     }
 }
 
@@ -445,9 +445,12 @@ public TAO::Storable_File_Guard
 public:
 
   /// Constructor
+  /// With @a append, the stream is opened to append the changes of
+  /// the context (see Write_change).
   File_Open_Lock_and_Check (TAO_Storable_Naming_Context * context,
                             Method_Type method_type,
-                            bool loadnow = true);
+                            bool loadnow = true,
+                            bool append = false);
 
   ~File_Open_Lock_and_Check ();
 
@@ -481,6 +484,8 @@ private:
 
   TAO_Storable_Naming_Context * context_;
 
+  bool append_;
+
 }; // end of embedded class File_Open_Lock_and_Check
 
   friend class File_Open_Lock_and_Check;
@@ -490,8 +495,24 @@ private:
 
   void Write(TAO::Storable_Base& wrtr);
 
+  /// Append the change of binding @a id, @a kind to the stream of the
+  /// context, instead of writing all its bindings.
+  void Write_change(TAO::Storable_Base& wrtr, const char *id, const char *kind);
+
+  /**
+   * Should a change be appended to the stream rather than the whole
+   * context written?  Only if the factory supports appending and the
+   * context is not redundant.  Once as many changes were appended as
+   * the context has bindings, the context is written again, which
+   * keeps the cost of a change, and of reading the context, bounded.
+   */
+  bool journal_change (void);
+
   /// Is set by the Write operation.  Used to determine
   int write_occurred_;
+
+  /// Number of changes appended since the context was last written.
+  size_t journal_length_;
 };
 
 TAO_END_VERSIONED_NAMESPACE_DECL
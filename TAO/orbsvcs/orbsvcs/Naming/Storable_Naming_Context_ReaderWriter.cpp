@@ -34,6 +34,8 @@ TAO_Storable_Naming_Context_ReaderWriter::write (TAO_Storable_Naming_Context & c
       header.size (0);
       header.destroyed (0);
       this->write_header (header);
+      stream_.flush();
+      context.journal_length_ = 0;
       return;
     }
 
@@ -43,7 +45,12 @@ TAO_Storable_Naming_Context_ReaderWriter::write (TAO_Storable_Naming_Context & c
   this->write_header(header);
 
   if (0u == header.size ())
-    return;
+    {
+      stream_.flush();
+      context.journal_length_ = 0;
+      context.write_occurred_ = 1;
+      return;
+    }
 
   ACE_Hash_Map_Iterator<TAO_Storable_ExtId,TAO_Storable_IntId,
                         ACE_Null_Mutex> it = context.storable_context_->map().begin();
@@ -55,76 +62,113 @@ TAO_Storable_Naming_Context_ReaderWriter::write (TAO_Storable_Naming_Context & c
   while (!(it == itend))
     {
       TAO_NS_Persistence_Record record;
+      this->make_record (context, (*it).ext_id_, (*it).int_id_, record);
+      write_record (record);
+      it.advance();
+    }
+
+  stream_.flush();
+  context.journal_length_ = 0;
+  context.write_occurred_ = 1;
+}
 
-      ACE_CString name;
-      CosNaming::BindingType bt = (*it).int_id_.type_;
-      if (bt ==  CosNaming::ncontext)
+void
+TAO_Storable_Naming_Context_ReaderWriter::make_record (TAO_Storable_Naming_Context & context,
+                                                       TAO_Storable_ExtId & ext_id,
+                                                       const TAO_Storable_IntId & int_id,
+                                                       TAO_NS_Persistence_Record & record)
+{
+  ACE_CString name;
+  CosNaming::BindingType bt = int_id.type_;
+  if (bt ==  CosNaming::ncontext)
+    {
+      CORBA::Object_var
+        obj = context.orb_->string_to_object (int_id.ref_.in ());
+      if (obj->_is_collocated ())
         {
-        CORBA::Object_var
-          obj = context.orb_->string_to_object ((*it).int_id_.ref_.in ());
-        if (obj->_is_collocated ())
-          {
-            // This is a local (i.e. non federated context) we therefore
-            // store only the ObjectID (persistence filename) for the object.
-
-            // The driving force behind storing ObjectIDs rather than IORs for
-            // local contexts is to provide for a redundant naming service.
-            // That is, a naming service that runs simultaneously on multiple
-            // machines sharing a file system. It allows multiple redundant
-            // copies to be started and stopped independently.
-            // The original target platform was Tru64 Clusters where there was
-            // a cluster address. In that scenario, clients may get different
-            // servers on each request, hence the requirement to keep
-            // synchronized to the disk. It also works on non-cluster system
-            // where the client picks one of the redundant servers and uses it,
-            // while other systems can pick different servers. (However in this
-            // scenario, if a server fails and a client must pick a new server,
-            // that client may not use any saved context IORs, instead starting
-            // from the root to resolve names. So this latter mode is not quite
-            // transparent to clients.) [Rich Seibel (seibel_r) of ociweb.com]
-
-            PortableServer::ObjectId_var
-              oid = context.poa_->reference_to_id (obj.in ());
-            CORBA::String_var
-              nm = PortableServer::ObjectId_to_string (oid.in ());
-            const char
-              *newname = nm.in ();
-            name.set (newname); // The local ObjectID (persistance filename)
-            record.type (TAO_NS_Persistence_Record::LOCAL_NCONTEXT);
-          }
-        else
-          {
-            // Since this is a foreign (federated) context, we can not store
-            // the objectID (because it isn't in our storage), if we did, when
-            // we restore, we would end up either not finding a permanent
-            // record (and thus ending up incorrectly assuming the context was
-            // destroyed) or loading another context altogether (just because
-            // the contexts shares its objectID filename which is very likely).
-            // [Simon Massey  (sma) of prismtech.com]
-
-            name.set ((*it).int_id_.ref_.in ()); // The federated context IOR
-            record.type (TAO_NS_Persistence_Record::REMOTE_NCONTEXT);
-          }
-      }
-    else // if (bt == CosNaming::nobject) // shouldn't be any other, can there?
-      {
-        name.set ((*it).int_id_.ref_.in ()); // The non-context object IOR
-        record.type (TAO_NS_Persistence_Record::OBJREF);
-      }
-    record.ref(name);
-
-    const char *myid = (*it).ext_id_.id();
-    ACE_CString id(myid);
-    record.id(id);
-
-    const char *mykind = (*it).ext_id_.kind();
-    ACE_CString kind(mykind);
-    record.kind(kind);
-
-    write_record (record);
-    it.advance();
-  }
+          // This is a local (i.e. non federated context) we therefore
+          // store only the ObjectID (persistence filename) for the object.
+
+          // The driving force behind storing ObjectIDs rather than IORs for
+          // local contexts is to provide for a redundant naming service.
+          // That is, a naming service that runs simultaneously on multiple
+          // machines sharing a file system. It allows multiple redundant
+          // copies to be started and stopped independently.
+          // The original target platform was Tru64 Clusters where there was
+          // a cluster address. In that scenario, clients may get different
+          // servers on each request, hence the requirement to keep
+          // synchronized to the disk. It also works on non-cluster system
+          // where the client picks one of the redundant servers and uses it,
+          // while other systems can pick different servers. (However in this
+          // scenario, if a server fails and a client must pick a new server,
+          // that client may not use any saved context IORs, instead starting
+          // from the root to resolve names. So this latter mode is not quite
+          // transparent to clients.) [Rich Seibel (seibel_r) of ociweb.com]
+
+          PortableServer::ObjectId_var
+            oid = context.poa_->reference_to_id (obj.in ());
+          CORBA::String_var
+            nm = PortableServer::ObjectId_to_string (oid.in ());
+          const char
+            *newname = nm.in ();
+          name.set (newname); // The local ObjectID (persistance filename)
+          record.type (TAO_NS_Persistence_Record::LOCAL_NCONTEXT);
+        }
+      else
+        {
+          // Since this is a foreign (federated) context, we can not store
+          // the objectID (because it isn't in our storage), if we did, when
+          // we restore, we would end up either not finding a permanent
+          // record (and thus ending up incorrectly assuming the context was
+          // destroyed) or loading another context altogether (just because
+          // the contexts shares its objectID filename which is very likely).
+          // [Simon Massey  (sma) of prismtech.com]
+
+          name.set (int_id.ref_.in ()); // The federated context IOR
+          record.type (TAO_NS_Persistence_Record::REMOTE_NCONTEXT);
+        }
+    }
+  else // if (bt == CosNaming::nobject) // shouldn't be any other, can there?
+    {
+      name.set (int_id.ref_.in ()); // The non-context object IOR
+      record.type (TAO_NS_Persistence_Record::OBJREF);
+    }
+  record.ref(name);
+
+  const char *myid = ext_id.id();
+  ACE_CString id(myid);
+  record.id(id);
+
+  const char *mykind = ext_id.kind();
+  ACE_CString kind(mykind);
+  record.kind(kind);
+}
+
+void
+TAO_Storable_Naming_Context_ReaderWriter::write_change (TAO_Storable_Naming_Context & context,
+                                                        const char * id,
+                                                        const char * kind)
+{
+  TAO_NS_Persistence_Record record;
+
+  TAO_Storable_ExtId ext_id (id, kind);
+  TAO_Storable_IntId int_id;
+  if (context.storable_context_->map ().find (ext_id, int_id) == 0)
+    {
+      this->make_record (context, ext_id, int_id, record);
+    }
+  else
+    {
+      // The binding was removed.
+      record.type (TAO_NS_Persistence_Record::UNDEFINED);
+      record.id (id);
+      record.kind (kind);
+    }
 
+  write_record (record);
+  stream_.flush();
+
+  ++context.journal_length_;
   context.write_occurred_ = 1;
 }
 
@@ -154,32 +198,37 @@ TAO_Storable_Naming_Context_ReaderWriter::read (TAO_Storable_Naming_Context & co
   for (unsigned int i= 0u; i<header.size(); ++i)
     {
       this->read_record(record);
+      this->bind_record (context, *bindings_map, record);
+    }
 
-      if (TAO_NS_Persistence_Record::LOCAL_NCONTEXT == record.type ())
+  // The changes appended since the map was written, each a binding
+  // with its new value or UNDEFINED if it was removed.
+  context.journal_length_ = 0;
+  if (context.factory_->append_supported ())
+    {
+      try
         {
-          PortableServer::ObjectId_var
-            id = PortableServer::string_to_ObjectId (record.ref ().c_str ());
-          const char
-            *intf = context.interface_->_interface_repository_id ();
-          CORBA::Object_var
-            objref = context.poa_->create_reference_with_id (id.in (), intf);
-          bindings_map->bind ( record.id ().c_str (),
-                               record.kind ().c_str (),
-                               objref.in (),
-                               CosNaming::ncontext );
+          for (;;)
+            {
+              this->read_record (record);
+              bindings_map->unbind (record.id ().c_str (),
+                                    record.kind ().c_str ());
+              if (TAO_NS_Persistence_Record::UNDEFINED != record.type ())
+                this->bind_record (context, *bindings_map, record);
+              ++context.journal_length_;
+            }
         }
-      else
+      catch (TAO::Storable_Read_Exception &ex)
         {
-          CORBA::Object_var
-            objref = context.orb_->string_to_object (record.ref ().c_str ());
-          bindings_map->bind ( record.id ().c_str (),
-                               record.kind ().c_str (),
-                               objref.in (),
-                               ((TAO_NS_Persistence_Record::REMOTE_NCONTEXT == record.type ())
-                                ? CosNaming::ncontext    // REMOTE_NCONTEXT
-                                : CosNaming::nobject )); // OBJREF
+          if (ex.get_state () != TAO::Storable_Base::eofbit)
+            {
+              delete bindings_map;
+              throw;
+            }
+          stream_.clear ();
         }
     }
+
   context.storable_context_ = bindings_map;
   context.context_ = context.storable_context_;
   if (stream_.good ())
@@ -188,13 +237,43 @@ TAO_Storable_Naming_Context_ReaderWriter::read (TAO_Storable_Naming_Context & co
     return -1;
 }
 
+void
+TAO_Storable_Naming_Context_ReaderWriter::bind_record (TAO_Storable_Naming_Context & context,
+                                                       TAO_Storable_Bindings_Map & bindings_map,
+                                                       const TAO_NS_Persistence_Record & record)
+{
+  if (TAO_NS_Persistence_Record::LOCAL_NCONTEXT == record.type ())
+    {
+      PortableServer::ObjectId_var
+        id = PortableServer::string_to_ObjectId (record.ref ().c_str ());
+      const char
+        *intf = context.interface_->_interface_repository_id ();
+      CORBA::Object_var
+        objref = context.poa_->create_reference_with_id (id.in (), intf);
+      bindings_map.bind ( record.id ().c_str (),
+                          record.kind ().c_str (),
+                          objref.in (),
+                          CosNaming::ncontext );
+    }
+  else
+    {
+      CORBA::Object_var
+        objref = context.orb_->string_to_object (record.ref ().c_str ());
+      bindings_map.bind ( record.id ().c_str (),
+                          record.kind ().c_str (),
+                          objref.in (),
+                          ((TAO_NS_Persistence_Record::REMOTE_NCONTEXT == record.type ())
+                           ? CosNaming::ncontext    // REMOTE_NCONTEXT
+                           : CosNaming::nobject )); // OBJREF
+    }
+}
+
 void
 TAO_Storable_Naming_Context_ReaderWriter::write_header (const TAO_NS_Persistence_Header & header)
 {
   stream_.rewind();
   stream_ << header.size();
   stream_ << header.destroyed();
-  stream_.flush();
 }
 void
 TAO_Storable_Naming_Context_ReaderWriter::read_header (TAO_NS_Persistence_Header & header)
@@ -220,8 +299,6 @@ TAO_Storable_Naming_Context_ReaderWriter::write_record (const TAO_NS_Persistence
   stream_ << record.id();
   stream_ << record.kind();
   stream_ << record.ref();
-
-  stream_.flush();
 }
 
 void
@@ -29,6 +29,9 @@ namespace TAO
 }
 
 class TAO_Storable_Naming_Context;
+class TAO_Storable_Bindings_Map;
+class TAO_Storable_ExtId;
+class TAO_Storable_IntId;
 class TAO_NS_Persistence_Record;
 class TAO_NS_Persistence_Header;
 class TAO_NS_Persistence_Global;
@@ -43,6 +46,14 @@ public:
 
   void write (TAO_Storable_Naming_Context & context);
 
+  /// Append the binding of @a id and @a kind in @a context, or its
+  /// removal if it is no longer bound, to what write () wrote.  Only
+  /// for a stream opened to append, see
+  /// TAO::Storable_Factory::append_supported ().
+  void write_change (TAO_Storable_Naming_Context & context,
+                     const char * id,
+                     const char * kind);
+
   void write_global (const TAO_NS_Persistence_Global & global);
   void read_global (TAO_NS_Persistence_Global & global);
 
@@ -54,6 +65,17 @@ private:
   void write_record (const TAO_NS_Persistence_Record & record);
   void read_record (TAO_NS_Persistence_Record & record);
 
+  /// Fill in @a record with a binding of @a context.
+  void make_record (TAO_Storable_Naming_Context & context,
+                    TAO_Storable_ExtId & ext_id,
+                    const TAO_Storable_IntId & int_id,
+                    TAO_NS_Persistence_Record & record);
+
+  /// Add the binding of @a record to @a bindings_map.
+  void bind_record (TAO_Storable_Naming_Context & context,
+                    TAO_Storable_Bindings_Map & bindings_map,
+                    const TAO_NS_Persistence_Record & record);
+
   TAO::Storable_Base &stream_;
 };
 
@@ -31,6 +31,12 @@
 #  define TAO_ROOT_NAMING_CONTEXT "NameService"
 #endif /* ! TAO_ROOT_NAMING_CONTEXT */
 
+// Poa id of the NamingCache::Invalidator in a Naming server, in the
+// poa of its naming contexts.
+#if !defined (TAO_NAMING_CACHE_INVALIDATOR)
+#  define TAO_NAMING_CACHE_INVALIDATOR "NameServiceCache"
+#endif /* ! TAO_NAMING_CACHE_INVALIDATOR */
+
 // The name under which the index of naming contexts is stored in
 // persistent naming service.
 #if !defined (TAO_NAMING_CONTEXT_INDEX)
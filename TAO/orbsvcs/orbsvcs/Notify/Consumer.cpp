@@ -19,6 +19,7 @@
 
 #include "ace/Bound_Ptr.h"
 #include "ace/Unbounded_Queue.h"
+#include "ace/Truncate.h"
 
 #ifndef DEBUG_LEVEL
 # define DEBUG_LEVEL TAO_debug_level
@@ -34,6 +35,9 @@ TAO_Notify_Consumer::TAO_Notify_Consumer (TAO_Notify_ProxySupplier* proxy)
 , have_not_yet_verified_publish_ (true)
 , pacing_ (proxy->qos_properties_.pacing_interval ())
 , max_batch_size_ (CosNotification::MaximumBatchSize, 0)
+, adaptive_batching_ (TAO_Notify_PROPERTIES::instance ()->adaptive_batching ())
+, batch_target_ (1)
+, dispatching_ (false)
 , timer_id_ (-1)
 , timer_ (0)
 {
@@ -482,17 +486,39 @@ TAO_Notify_Consumer::dispatch_pending (void)
 
   // dispatch events until: 1) the queue is empty; 2) the proxy shuts down, or 3) the dispatch fails
   ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, *this->proxy_lock ());
-  bool ok = true;
-  while (ok
-         && !this->proxy_supplier ()->has_shutdown ()
-         && !this->pending_events().is_empty ())
+
+  if (this->adaptive_batching_)
+    {
+      // Another thread is dispatching, it will batch our events.
+      if (this->dispatching_)
+        return;
+
+      this->dispatching_ = true;
+    }
+
+  try
     {
-      if (! dispatch_from_queue ( this->pending_events(), ace_mon))
+      bool ok = true;
+      while (ok
+             && !this->proxy_supplier ()->has_shutdown ()
+             && !this->pending_events().is_empty ())
         {
-          this->schedule_timer (true);
-          ok = false;
+          if (! dispatch_from_queue ( this->pending_events(), ace_mon))
+            {
+              this->schedule_timer (true);
+              ok = false;
+            }
         }
     }
+  catch (...)
+    {
+      if (!ace_mon.locked ())
+        ace_mon.acquire ();
+      this->dispatching_ = false;
+      throw;
+    }
+
+  this->dispatching_ = false;
 }
 
 
@@ -588,8 +614,230 @@ TAO_Notify_Consumer::dispatch_from_queue (
   return result;
 }
 
+// FUZZ: disable check_for_ACE_Guard
+bool
+TAO_Notify_Consumer::dispatch_batch_from_queue (Request_Queue& requests, ACE_Guard <TAO_SYNCH_MUTEX> & ace_mon)
+// FUZZ: enable check_for_ACE_Guard
+{
+  bool result = true;
+  if (DEBUG_LEVEL > 0)
+  {
+    ORBSVCS_DEBUG ( (LM_DEBUG,
+      ACE_TEXT ("(%P|%t) Consumer %d dispatch queued requests as a batch. queue size:%u\n"),
+      static_cast<int> (this->proxy ()->id ()),
+      requests.size ()));
+  }
+
+  CORBA::ULong queue_size = ACE_Utils::truncate_cast<CORBA::ULong> (requests.size ());
+  CORBA::Long max_batch_size = queue_size;
+  if (this->max_batch_size_.is_valid () && this->max_batch_size_.value () > 0)
+  {
+    max_batch_size = this->max_batch_size_.value ();
+  }
+  CORBA::Long batch_size = queue_size;
+  if (batch_size > max_batch_size)
+  {
+    batch_size = max_batch_size;
+  }
+  if (batch_size > 0)
+  {
+    CosNotification::EventBatch batch (batch_size);
+    batch.length (batch_size);
+
+    Request_Queue completed;
+
+    CORBA::Long pos = 0;
+    TAO_Notify_Method_Request_Event_Queueable * request = 0;
+    while (pos < batch_size && requests.dequeue_head (request) == 0)
+    {
+      if (DEBUG_LEVEL > 0)
+      {
+        ORBSVCS_DEBUG ( (LM_DEBUG,
+          ACE_TEXT ("(%P|%t) Batch Dispatch Method_Request_Dispatch @%@\n"),
+          request));
+      }
+
+      const TAO_Notify_Event * ev = request->event ();
+      ev->convert (batch [pos]);
+      ++pos;
+
+      // note enqueue at head, use queue as stack.
+      completed.enqueue_head (request);
+    }
+    batch.length (pos);
+    ACE_ASSERT (pos > 0);
+
+    ace_mon.release ();
+    bool from_timeout = false;
+    TAO_Notify_Consumer::DispatchStatus status =
+      this->dispatch_batch (batch);
+    ace_mon.acquire ();
+    switch (status)
+    {
+    case DISPATCH_SUCCESS:
+      {
+        TAO_Notify_Method_Request_Event_Queueable * request = 0;
+        while (completed.dequeue_head (request) == 0)
+        {
+          request->complete ();
+          request->release ();
+        }
+        if (this->adaptive_batching_)
+        {
+          this->adapt_batch_target (requests.size ());
+        }
+        result = true;
+        break;
+      }
+    case DISPATCH_FAIL_TIMEOUT:
+      from_timeout = true;
+      // Fall through
+    case DISPATCH_FAIL:
+      {
+        TAO_Notify_Method_Request_Event_Queueable * request = 0;
+        while (completed.dequeue_head (request) == 0)
+        {
+          if (request->should_retry ())
+          {
+            if (DEBUG_LEVEL > 0)
+              ORBSVCS_DEBUG ((LM_DEBUG, ACE_TEXT ("(%P|%t) Consumer %d: Will retry %d\n"),
+                          static_cast <int> (this->proxy ()->id ()),
+                          request->sequence ()));
+            requests.enqueue_head (request);
+            result = false;
+          }
+          else
+          {
+            if (DEBUG_LEVEL > 0)
+              ORBSVCS_DEBUG ((LM_DEBUG, ACE_TEXT ("(%P|%t) Consumer %d: Discarding %d\n"),
+                          static_cast<int> (this->proxy ()->id ()),
+                          request->sequence ()));
+            request->complete ();
+            request->release ();
+          }
+        }
+        while (requests.dequeue_head (request) == 0)
+        {
+          if (request->should_retry ())
+          {
+            if (DEBUG_LEVEL > 0)
+              ORBSVCS_DEBUG ((LM_DEBUG, ACE_TEXT ("(%P|%t) Consumer %d: Will retry %d\n"),
+                          static_cast<int> (this->proxy ()->id ()),
+                          request->sequence ()));
+            requests.enqueue_head (request);
+            result = false;
+          }
+          else
+          {
+            if (DEBUG_LEVEL > 0)
+              ORBSVCS_DEBUG ((LM_DEBUG, ACE_TEXT ("(%P|%t) Consumer %d: Discarding %d\n"),
+                          static_cast<int> (this->proxy ()->id ()),
+                          request->sequence ()));
+            request->complete ();
+            request->release ();
+          }
+        }
+        ace_mon.release();
+        try
+        {
+          this->proxy_supplier ()->destroy (from_timeout);
+        }
+        catch (const CORBA::Exception&)
+        {
+          // todo is there something meaningful we can do here?
+          ;
+        }
+        ace_mon.acquire();
+        break;
+      }
+    case DISPATCH_RETRY:
+    case DISPATCH_DISCARD:
+      {
+        TAO_Notify_Method_Request_Event_Queueable *  request = 0;
+        while (completed.dequeue_head (request) == 0)
+        {
+          if (request->should_retry ())
+          {
+            if (DEBUG_LEVEL > 0)
+              ORBSVCS_DEBUG ((LM_DEBUG, ACE_TEXT ("(%P|%t) Consumer %d: Will retry %d\n"),
+                          static_cast<int> (this->proxy ()->id ()),
+                          request->sequence ()));
+            requests.enqueue_head (request);
+            result = false;
+          }
+          else
+          {
+            if (DEBUG_LEVEL > 0)
+              ORBSVCS_DEBUG ((LM_DEBUG, ACE_TEXT ("(%P|%t) Consumer %d: Discarding %d\n"),
+                          static_cast<int> (this->proxy ()->id ()),
+                          request->sequence ()));
+            request->complete ();
+            request->release ();
+          }
+        }
+        break;
+      }
+    default:
+      {
+        result = false;
+        break;
+      }
+    }
+  }
+  return result;
+}
+
+void
+TAO_Notify_Consumer::adapt_batch_target (size_t backlog)
+{
+  CORBA::Long limit = ACE_INT32_MAX / 2;
+  if (this->max_batch_size_.is_valid () && this->max_batch_size_.value () > 0)
+  {
+    limit = this->max_batch_size_.value ();
+  }
+
+  if (backlog >= static_cast<size_t> (this->batch_target_))
+  {
+    // The consumer falls behind, send larger batches.
+    this->batch_target_ = (this->batch_target_ < limit / 2)
+      ? this->batch_target_ * 2
+      : limit;
+  }
+  else if (backlog == 0 && this->batch_target_ > 1)
+  {
+    // The consumer caught up, keep the latency low.
+    this->batch_target_ /= 2;
+  }
+
+  if (DEBUG_LEVEL > 5)
+    ORBSVCS_DEBUG ((LM_DEBUG,
+                ACE_TEXT ("Consumer %d: backlog %u, batch target %d\n"),
+                static_cast<int> (this->proxy ()->id ()),
+                static_cast<unsigned int> (backlog),
+                this->batch_target_));
+}
+
+bool
+TAO_Notify_Consumer::enqueue_batch (TAO_Notify_Method_Request_Event * request)
+{
+  this->enqueue_request (request);
+
+  size_t const mbs = this->adaptive_batching_
+    ? static_cast<size_t> (this->batch_target_)
+    : static_cast<size_t> (this->max_batch_size_.value ());
+
+  if (this->pending_events().size() >= mbs || this->pacing_.is_valid () == 0)
+  {
+    this->dispatch_pending ();
+  }
+  else
+  {
+    schedule_timer (false);
+  }
+  return true;
+}
+
 /// @todo: rather than is_error, use pacing interval so it will be configurable
-/// @todo: find some way to use batch buffering stratgy for sequence consumers.
 void
 TAO_Notify_Consumer::schedule_timer (bool is_error)
 {
@@ -150,6 +150,29 @@ protected:
 
   void enqueue_request(TAO_Notify_Method_Request_Event * request);
 
+  /**
+   * \brief Queue a request for a consumer that receives EventBatches.
+   *
+   * The pending events are dispatched once MaximumBatchSize of them
+   * are pending, or when the PacingInterval expires.  With adaptive
+   * batching, the number of pending events dispatched without
+   * waiting for the PacingInterval follows the backlog instead.
+   * \return true, the request is always queued.
+   */
+  bool enqueue_batch (TAO_Notify_Method_Request_Event * request);
+
+// FUZZ: disable check_for_ACE_Guard
+  /// Dispatch up to MaximumBatchSize of the @a requests as one
+  /// EventBatch.  See dispatch_from_queue().
+  bool dispatch_batch_from_queue (
+    Request_Queue & requests,
+    ACE_Guard <TAO_SYNCH_MUTEX> & ace_mon);
+// FUZZ: enable check_for_ACE_Guard
+
+  /// Update batch_target_ after a batch was dispatched,
+  /// with @a backlog requests left in the queue.
+  void adapt_batch_target (size_t backlog);
+
   /// Add request to a queue if necessary.
   /// Overridden by sequence consumer to "always" put incoming events into the queue.
   /// @returns true the request has been enqueued; false the request should be handled now.
@@ -194,6 +217,19 @@ protected:
   /// Max. batch size.
   TAO_Notify_Property_Long max_batch_size_;
 
+  /// True if the batches adapt to the backlog of the consumer.
+  bool adaptive_batching_;
+
+  /// With adaptive batching, the number of pending events that are
+  /// dispatched without waiting for the pacing interval.  It doubles
+  /// while events are left pending after a batch, up to
+  /// MaximumBatchSize, and halves when the consumer catches up.
+  CORBA::Long batch_target_;
+
+  /// With adaptive batching, set while a thread dispatches the pending
+  /// events; the events queued meanwhile are left for it to batch.
+  bool dispatching_;
+
   /// Timer Id.
   long timer_id_;
 
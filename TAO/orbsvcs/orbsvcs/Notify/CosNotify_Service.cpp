@@ -135,6 +135,16 @@ TAO_CosNotify_Service::init (int argc, ACE_TCHAR *argv[])
         arg_shifter.consume_arg ();
         TAO_Notify_PROPERTIES::instance()->allow_reconnect (true);
       }
+      else if (arg_shifter.cur_arg_strncasecmp (ACE_TEXT("-StructuredBatching")) == 0)
+      {
+        arg_shifter.consume_arg ();
+        properties->structured_batching (true);
+      }
+      else if (arg_shifter.cur_arg_strncasecmp (ACE_TEXT("-AdaptiveBatching")) == 0)
+      {
+        arg_shifter.consume_arg ();
+        properties->adaptive_batching (true);
+      }
       else if (arg_shifter.cur_arg_strncasecmp (ACE_TEXT("-DefaultConsumerAdminFilterOp")) == 0)
       {
         current_arg = arg_shifter.get_the_parameter
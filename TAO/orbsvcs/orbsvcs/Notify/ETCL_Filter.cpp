@@ -4,6 +4,7 @@
 #include "tao/debug.h"
 #include "orbsvcs/Notify/Notify_Constraint_Visitors.h"
 #include "orbsvcs/Notify/Topology_Saver.h"
+#include "orbsvcs/Notify/Subscription_Index.h"
 
 #ifndef DEBUG_LEVEL
 # define DEBUG_LEVEL TAO_debug_level
@@ -100,7 +101,9 @@ TAO_Notify_ETCL_Filter::TAO_Notify_ETCL_Filter (PortableServer::POA_ptr poa,
   :constraint_expr_ids_ (0),
    poa_ (PortableServer::POA::_duplicate (poa)),
    id_ (id),
-   grammar_ (constraint_grammar)
+   grammar_ (constraint_grammar),
+   index_ (0),
+   slot_ (0)
 {
 }
 
@@ -109,6 +112,7 @@ TAO_Notify_ETCL_Filter::~TAO_Notify_ETCL_Filter ()
 {
   try
     {
+      this->subscription_index (0);
       this->destroy();
     }
   catch (const CORBA::Exception&)
@@ -243,8 +247,14 @@ TAO_Notify_ETCL_Filter::add_constraints (
         }
     }
 
+  // The filter is unguarded until all the constraints are added.
+  if (this->index_ != 0)
+    this->index_->unguard (this->slot_);
+
   this->add_constraints_i (infoseq.in ());
 
+  this->update_index_i ();
+
   return infoseq._retn ();
 }
 
@@ -291,6 +301,9 @@ TAO_Notify_ETCL_Filter::modify_constraints (
         }
     }
 
+  if (this->index_ != 0)
+    this->index_->unguard (this->slot_);
+
   // Now add the new entries.
   // Keep a list of ids generated in this session.
   try
@@ -327,6 +340,8 @@ TAO_Notify_ETCL_Filter::modify_constraints (
       delete constr_saved[index];
     }
 
+  this->update_index_i ();
+
   this->self_change ();
 }
 
@@ -410,6 +425,7 @@ TAO_Notify_ETCL_Filter::remove_all_constraints (void)
                       CORBA::INTERNAL ());
 
   this->remove_all_constraints_i ();
+  this->update_index_i ();
 }
 
 void
@@ -430,6 +446,51 @@ TAO_Notify_ETCL_Filter::remove_all_constraints_i (void)
   this->constraint_expr_list_.unbind_all ();
 }
 
+void
+TAO_Notify_ETCL_Filter::update_index_i (void)
+{
+  if (this->index_ == 0)
+    return;
+
+  // The filter can only match the events that satisfy one of the
+  // predicates of its constraints, if they all have predicates.
+  TAO_Notify_Constraint_Program::Predicates predicates;
+
+  CONSTRAINT_EXPR_LIST::ITERATOR iter (this->constraint_expr_list_);
+  CONSTRAINT_EXPR_LIST::ENTRY *entry = 0;
+
+  for (; iter.next (entry) != 0; iter.advance ())
+    {
+      if (!entry->int_id_->interpreter.predicates (predicates))
+        {
+          this->index_->unguard (this->slot_);
+          return;
+        }
+    }
+
+  this->index_->guard (this->slot_, predicates);
+}
+
+void
+TAO_Notify_ETCL_Filter::subscription_index (
+  TAO_Notify_Subscription_Index *index)
+{
+  ACE_GUARD_THROW_EX (TAO_SYNCH_MUTEX, ace_mon, this->lock_,
+                      CORBA::INTERNAL ());
+
+  if (this->index_ != 0)
+    this->index_->remove (this->slot_);
+
+  this->index_ = 0;
+
+  if (index != 0)
+    {
+      this->slot_ = index->add (this->id_);
+      this->index_ = index;
+      this->update_index_i ();
+    }
+}
+
 void
 TAO_Notify_ETCL_Filter::destroy (void)
 {
@@ -439,6 +500,7 @@ TAO_Notify_ETCL_Filter::destroy (void)
   if (!CORBA::is_nil (this->poa_.in()))
     {
       this->remove_all_constraints_i ();
+      this->update_index_i ();
 
       PortableServer::ObjectId_var refTemp = this->poa_->servant_to_id (this);
       this->poa_->deactivate_object (refTemp.in ());
@@ -463,19 +525,13 @@ TAO_Notify_ETCL_Filter::match_structured (
   CONSTRAINT_EXPR_LIST::ITERATOR iter (this->constraint_expr_list_);
   CONSTRAINT_EXPR_LIST::ENTRY *entry;
 
-  TAO_Notify_Constraint_Visitor visitor;
-
-  if (visitor.bind_structured_event (filterable_data) != 0)
-    {
-      // Maybe throw some kind of exception here, or lower down,
-      return 0;
-    }
+  TAO_Notify_Constraint_Context context (filterable_data);
 
   for (; iter.done () == 0; iter.advance ())
     {
       if (iter.next (entry) != 0)
         {
-          if (entry->int_id_->interpreter.evaluate (visitor) == 1)
+          if (entry->int_id_->interpreter.evaluate (context) == 1)
             {
               return 1;
             }
@@ -589,6 +645,11 @@ TAO_Notify_ETCL_Filter::load_child (const ACE_CString &type,
                     ACE_TEXT ("(%P|%t) reload filter %d constraint %d\n"),
                     static_cast<int> (this->id_), static_cast<int> (id)));
 
+      // The reloaded constraints are built without the filter, which
+      // then stays unguarded.
+      if (this->index_ != 0)
+        this->index_->unguard (this->slot_);
+
       TAO_Notify_Constraint_Expr* expr
         = this->add_constraint_i (id);
       expr->load_attrs (attrs);
@@ -31,6 +31,7 @@
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
 class TAO_Notify_ETCL_Filter;
+class TAO_Notify_Subscription_Index;
 
 class TAO_Notify_Constraint_Expr : public TAO_Notify::Topology_Object
 {
@@ -91,6 +92,10 @@ public:
   TAO_Notify::Topology_Object* load_child (const ACE_CString &type,
     CORBA::Long id, const TAO_Notify::NVPList& attrs);
 
+  /// Keep the predicates of the constraints in @a index, in a slot
+  /// given to the filter, and leave the previous index, if any.
+  void subscription_index (TAO_Notify_Subscription_Index *index);
+
 protected:
   virtual char * constraint_grammar (void);
 
@@ -133,6 +138,9 @@ private:
 
   void remove_all_constraints_i (void);
 
+  /// Set the predicates of the filter in the index.
+  void update_index_i (void);
+
   /// Lock to serialize access to data members.
   TAO_SYNCH_MUTEX lock_;
 
@@ -152,6 +160,10 @@ private:
   TAO_Notify_Object::ID id_;
 
   ACE_CString grammar_;
+
+  /// The index of the filter and its slot there.
+  TAO_Notify_Subscription_Index *index_;
+  CORBA::ULong slot_;
 };
 
 TAO_END_VERSIONED_NAMESPACE_DECL
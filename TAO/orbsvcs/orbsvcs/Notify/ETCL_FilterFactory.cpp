@@ -105,6 +105,9 @@ TAO_Notify_ETCL_FilterFactory::create_filter (
                                             constraint_grammar,
                                             id),
                     CORBA::NO_MEMORY ());
+
+  filter->subscription_index (&this->index_);
+
   // Scope the guard
   {
     ACE_GUARD_REACTION (TAO_SYNCH_MUTEX, ace_mon, this->mtx_, throw CORBA::INTERNAL ());
@@ -274,6 +277,12 @@ TAO_Notify_ETCL_FilterFactory::get_filter (CosNotifyFilter::FilterID id)
   return this->find_filter( (TAO_Notify_Object::ID) id);
 }
 
+TAO_Notify_Subscription_Index *
+TAO_Notify_ETCL_FilterFactory::subscription_index (void)
+{
+  return &this->index_;
+}
+
 CosNotifyFilter::Filter_ptr
 TAO_Notify_ETCL_FilterFactory::find_filter (const TAO_Notify_Object::ID& id)
 {
@@ -21,6 +21,7 @@
 #include "orbsvcs/Notify/FilterFactory.h"
 #include "orbsvcs/Notify/ID_Factory.h"
 #include "orbsvcs/Notify/ETCL_Filter.h"
+#include "orbsvcs/Notify/Subscription_Index.h"
 #include "orbsvcs/Notify/Topology_Saver.h"
 
 
@@ -80,6 +81,8 @@ public:
   virtual CosNotifyFilter::FilterID get_filterid (CosNotifyFilter::Filter_ptr filter);
   virtual CosNotifyFilter::Filter_ptr get_filter (CosNotifyFilter::FilterID id);
 
+  virtual TAO_Notify_Subscription_Index *subscription_index (void);
+
 
 protected:
 
@@ -107,6 +110,9 @@ protected:
   FILTERMAP filters_;
   TAO_SYNCH_MUTEX mtx_;
 
+  /// The index of the filters.
+  TAO_Notify_Subscription_Index index_;
+
 };
 
 TAO_END_VERSIONED_NAMESPACE_DECL
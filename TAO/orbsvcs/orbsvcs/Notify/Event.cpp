@@ -37,6 +37,12 @@ TAO_Notify_Event::release (void)
   delete this;
 }
 
+const CosNotification::StructuredEvent*
+TAO_Notify_Event::structured_event (void) const
+{
+  return 0;
+}
+
 void
 TAO_Notify_Event::translate (const CORBA::Any& any, CosNotification::StructuredEvent& notification)
 {
@@ -64,6 +64,10 @@ public:
   /// Returns true if the filter matches.
   virtual CORBA::Boolean do_match (CosNotifyFilter::Filter_ptr filter) const = 0;
 
+  /// The event filters are evaluated on, if it is a structured event,
+  /// or 0.
+  virtual const CosNotification::StructuredEvent* structured_event (void) const;
+
   /// Convert to CosNotification::Structured type
   virtual void convert (CosNotification::StructuredEvent& notification) const = 0;
 
@@ -41,8 +41,10 @@ TAO_Notify_FilterAdmin::add_filter (CosNotifyFilter::Filter_ptr new_filter)
 
   if (this->filter_list_.bind (new_id, new_filter_var) == -1)
       throw CORBA::INTERNAL ();
-  else
-    return new_id;
+
+  this->add_slot (new_id, new_filter);
+
+  return new_id;
 }
 
 void
@@ -53,6 +55,8 @@ TAO_Notify_FilterAdmin::remove_filter (CosNotifyFilter::FilterID filter_id)
 
   if (this->filter_list_.unbind (filter_id) == -1)
     throw CosNotifyFilter::FilterNotFound ();
+
+  this->slot_list_.unbind (filter_id);
 }
 
 CosNotifyFilter::Filter_ptr
@@ -110,6 +114,7 @@ TAO_Notify_FilterAdmin::remove_all_filters (void)
                       CORBA::INTERNAL ());
 
   this->filter_list_.unbind_all ();
+  this->slot_list_.unbind_all ();
 }
 
 void
@@ -168,11 +173,68 @@ TAO_Notify_FilterAdmin::load_child (const ACE_CString &type, CORBA::Long id,
       this->filter_ids_.set_last_used(id);
       if (this->filter_list_.bind (id, filter) != 0)
         throw CORBA::INTERNAL ();
+
+      this->add_slot (id, filter.in ());
     }
   }
   return this;
 }
 
+void
+TAO_Notify_FilterAdmin::add_slot (CosNotifyFilter::FilterID id,
+                                  CosNotifyFilter::Filter_ptr filter)
+{
+  if (this->ec_.get () == 0)
+    return;
+
+  TAO_Notify_FilterFactory* factory = ec_->default_filter_factory_servant ();
+  TAO_Notify_Subscription_Index* index =
+    factory == 0 ? 0 : factory->subscription_index ();
+
+  if (index == 0)
+    return;
+
+  // Only the filters of the factory of the channel have a slot; the
+  // others always are evaluated.
+  try
+    {
+      TAO_Notify_Object::ID const mapid = factory->get_filter_id (filter);
+
+      CORBA::ULong slot = 0;
+      if (index->find (mapid, slot) == 0)
+        this->slot_list_.bind (id, slot);
+    }
+  catch (const CORBA::Exception&)
+    {
+    }
+}
+
+CORBA::Boolean
+TAO_Notify_FilterAdmin::may_match (
+  const TAO_Notify_Subscription_Index::Candidates &candidates)
+{
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, this->lock_, 1);
+
+  // If no filter is active, match is successfull.
+  if (this->filter_list_.current_size () == 0)
+    return 1;
+
+  // A filter without a slot may match.
+  if (this->slot_list_.current_size () != this->filter_list_.current_size ())
+    return 1;
+
+  SLOT_LIST::ITERATOR iter (this->slot_list_);
+  SLOT_LIST::ENTRY *entry = 0;
+
+  for (; iter.next (entry); iter.advance ())
+    {
+      if (candidates.contains (entry->int_id_))
+        return 1;
+    }
+
+  return 0;
+}
+
 void
 TAO_Notify_FilterAdmin::release (void)
 {
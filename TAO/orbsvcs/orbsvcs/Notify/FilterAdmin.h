@@ -23,6 +23,7 @@
 #include "orbsvcs/Notify/notify_serv_export.h"
 #include "orbsvcs/Notify/Topology_Object.h"
 #include "orbsvcs/Notify/EventChannel.h"
+#include "orbsvcs/Notify/Subscription_Index.h"
 
 class TAO_Notify_EventChannel;
 
@@ -52,6 +53,12 @@ class TAO_Notify_Serv_Export TAO_Notify_FilterAdmin
   /// See if any of the filters match.
   CORBA::Boolean match (const TAO_Notify_Event* event);
 
+  /// Returns false if none of the filters can match an event that is
+  /// not in @a candidates, the filters that the subscription index of
+  /// the channel found for it; match() must then fail for the event.
+  CORBA::Boolean may_match (
+    const TAO_Notify_Subscription_Index::Candidates &candidates);
+
   virtual CosNotifyFilter::FilterID add_filter (CosNotifyFilter::Filter_ptr new_filter);
 
   virtual void remove_filter (CosNotifyFilter::FilterID filter);
@@ -74,14 +81,24 @@ class TAO_Notify_Serv_Export TAO_Notify_FilterAdmin
  private:
   typedef ACE_Hash_Map_Manager <CosNotifyFilter::FilterID, CosNotifyFilter::Filter_var, ACE_SYNCH_NULL_MUTEX> FILTER_LIST;
 
+  typedef ACE_Hash_Map_Manager <CosNotifyFilter::FilterID, CORBA::ULong, ACE_SYNCH_NULL_MUTEX> SLOT_LIST;
+
   virtual void release (void);
 
+  /// Find the slot of @a filter in the subscription index, and keep it
+  /// in slot_list_.
+  void add_slot (CosNotifyFilter::FilterID id,
+                 CosNotifyFilter::Filter_ptr filter);
+
   /// Mutex to serialize access to data members.
   TAO_SYNCH_MUTEX lock_;
 
   /// List of filters
   FILTER_LIST filter_list_;
 
+  /// The slots in the subscription index of the filters that have one.
+  SLOT_LIST slot_list_;
+
   /// Id generator for proxy suppliers
   TAO_Notify_ID_Factory filter_ids_;
 
@@ -23,6 +23,8 @@
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
+class TAO_Notify_Subscription_Index;
+
 /**
  * @class TAO_Notify_FilterFactory
  *
@@ -41,6 +43,13 @@ public:
 
   virtual TAO_Notify_Object::ID get_filter_id (CosNotifyFilter::Filter_ptr filter) = 0;
   virtual CosNotifyFilter::Filter_ptr get_filter (const TAO_Notify_Object::ID& id) = 0;
+
+  /// The index of the filters created by the factory, or 0 if the
+  /// factory does not keep one.
+  virtual TAO_Notify_Subscription_Index *subscription_index (void)
+  {
+    return 0;
+  }
 };
 
 TAO_END_VERSIONED_NAMESPACE_DECL
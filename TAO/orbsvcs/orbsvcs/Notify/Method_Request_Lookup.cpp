@@ -11,6 +11,8 @@
 #include "orbsvcs/Notify/EventChannelFactory.h"
 #include "orbsvcs/Notify/Event_Manager.h"
 #include "orbsvcs/Notify/Factory.h"
+#include "orbsvcs/Notify/EventChannel.h"
+#include "orbsvcs/Notify/FilterFactory.h"
 
 #include "orbsvcs/ESF/ESF_Proxy_Collection.h"
 
@@ -24,6 +26,7 @@ TAO_Notify_Method_Request_Lookup::TAO_Notify_Method_Request_Lookup (
       TAO_Notify_ProxyConsumer * proxy)
   : TAO_Notify_Method_Request_Event (event)
   , proxy_consumer_ (proxy)
+  , candidates_ (0)
 {
 }
 
@@ -32,6 +35,7 @@ TAO_Notify_Method_Request_Lookup::TAO_Notify_Method_Request_Lookup (
       TAO_Notify_ProxyConsumer * proxy)
   : TAO_Notify_Method_Request_Event (delivery)
   , proxy_consumer_ (proxy)
+  , candidates_ (0)
 {
 }
 
@@ -43,6 +47,18 @@ void
 TAO_Notify_Method_Request_Lookup::work (
   TAO_Notify_ProxySupplier* proxy_supplier)
 {
+  // Do not dispatch the event to a proxy whose filters cannot match
+  // it; they would only be evaluated to drop it.
+  if (this->candidates_ != 0)
+    {
+      TAO_Notify_Admin& parent = proxy_supplier->consumer_admin ();
+
+      if (!proxy_supplier->may_pass_filters (*this->candidates_,
+                                             parent.filter_admin (),
+                                             parent.filter_operator ()))
+        return;
+    }
+
   if (delivery_request_.get () == 0)
   {
     TAO_Notify_Method_Request_Dispatch_No_Copy request (*this, proxy_supplier, true);
@@ -81,6 +97,24 @@ int TAO_Notify_Method_Request_Lookup::execute_i (void)
 
   TAO_Notify_ProxySupplier_Collection* consumers = 0;
 
+  // Look the event up in the subscription index, if the filters of the
+  // channel have one.
+  TAO_Notify_Subscription_Index::Candidates candidates;
+  this->candidates_ = 0;
+
+  TAO_Notify_FilterFactory* factory =
+    parent.event_channel ()->default_filter_factory_servant ();
+  TAO_Notify_Subscription_Index* index =
+    factory == 0 ? 0 : factory->subscription_index ();
+  const CosNotification::StructuredEvent* notification =
+    this->event_->structured_event ();
+
+  if (index != 0 && notification != 0 && !index->empty ())
+    {
+      index->candidates (*notification, candidates);
+      this->candidates_ = &candidates;
+    }
+
   if (entry != 0)
   {
     consumers = entry->collection ();
@@ -100,6 +134,7 @@ int TAO_Notify_Method_Request_Lookup::execute_i (void)
     {
       consumers->for_each (this);
     }
+  this->candidates_ = 0;
   this->complete ();
   return 0;
 }
@@ -21,6 +21,7 @@
 #include "orbsvcs/Notify/ProxyConsumer.h"
 #include "orbsvcs/Notify/Consumer_Map.h"
 #include "orbsvcs/Notify/Delivery_Request.h"
+#include "orbsvcs/Notify/Subscription_Index.h"
 
 #include "orbsvcs/ESF/ESF_Worker.h"
 
@@ -69,6 +70,10 @@ protected:
 
   /// The Proxy
   TAO_Notify_ProxyConsumer* proxy_consumer_;
+
+  /// The filters the event may match, while it is looked up, if the
+  /// channel has a subscription index.
+  const TAO_Notify_Subscription_Index::Candidates* candidates_;
 };
 
 /***************************************************************/
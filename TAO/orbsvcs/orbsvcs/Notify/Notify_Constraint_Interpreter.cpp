@@ -30,9 +30,12 @@ TAO_Notify_Constraint_Interpreter::build_tree (
       // root_ is set in this base class call.
       if (ETCL_Interpreter::build_tree (constraints) != 0)
         {
+          this->program_.compile (0);
           throw CosNotifyFilter::InvalidConstraint ();
         }
     }
+
+  this->program_.compile (this->root_);
 }
 
 void
@@ -113,4 +116,17 @@ TAO_Notify_Constraint_Interpreter::evaluate (TAO_Notify_Constraint_Visitor &eval
   return evaluator.evaluate_constraint (this->root_);
 }
 
+CORBA::Boolean
+TAO_Notify_Constraint_Interpreter::evaluate (TAO_Notify_Constraint_Context &context)
+{
+  return this->program_.evaluate (context);
+}
+
+bool
+TAO_Notify_Constraint_Interpreter::predicates (
+  TAO_Notify_Constraint_Program::Predicates &predicates) const
+{
+  return this->program_.predicates (predicates);
+}
+
 TAO_END_VERSIONED_NAMESPACE_DECL
@@ -22,6 +22,7 @@
 #include "tao/ETCL/TAO_ETCL_Constraint.h"
 
 #include "orbsvcs/CosNotifyFilterC.h"
+#include "orbsvcs/Notify/Notify_Constraint_Program.h"
 #include "orbsvcs/Notify/notify_serv_export.h"
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
@@ -55,8 +56,20 @@ public:
   /// the evaluator.
   CORBA::Boolean evaluate (TAO_Notify_Constraint_Visitor &evaluator);
 
+  /// Returns true if the event of @a context satisfies the constraint,
+  /// using the program compiled from the expression tree.
+  CORBA::Boolean evaluate (TAO_Notify_Constraint_Context &context);
+
+  /// Append the predicates of the constraint to @a predicates.
+  /// Returns false if it has none; see
+  /// TAO_Notify_Constraint_Program::predicates().
+  bool predicates (TAO_Notify_Constraint_Program::Predicates &predicates) const;
+
 private:
   void build_tree (const char* constraints);
+
+  /// The expression tree compiled by build_tree().
+  TAO_Notify_Constraint_Program program_;
 };
 
 TAO_END_VERSIONED_NAMESPACE_DECL
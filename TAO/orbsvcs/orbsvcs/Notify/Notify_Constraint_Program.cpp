@@ -0,0 +1,1158 @@
+#include "orbsvcs/Notify/Notify_Constraint_Program.h"
+#include "orbsvcs/Notify/Notify_Constraint_Visitors.h"
+
+#include "ace/ETCL/ETCL_Constraint_Visitor.h"
+#include "ace/ETCL/ETCL_y.h"
+#include "ace/OS_NS_string.h"
+
+#include <new>
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace
+{
+  /// Replace the operand in @a slot of the operand stack.  The slots
+  /// are reconstructed rather than assigned, since assigning an Any
+  /// value over a string does not release the string.
+  inline void
+  replace (TAO_ETCL_Literal_Constraint &slot,
+           const TAO_ETCL_Literal_Constraint &value)
+  {
+    slot.~TAO_ETCL_Literal_Constraint ();
+    new (&slot) TAO_ETCL_Literal_Constraint (value);
+  }
+
+  template <typename T>
+  inline void
+  replace (TAO_ETCL_Literal_Constraint &slot, T value)
+  {
+    slot.~TAO_ETCL_Literal_Constraint ();
+    new (&slot) TAO_ETCL_Literal_Constraint (value);
+  }
+
+  /// The fields of CosNotification::StructuredEvent that a component
+  /// name can refer to, as in TAO_Notify_Constraint_Visitor.
+  enum Event_Field
+    {
+      FILTERABLE_DATA,
+      HEADER,
+      FIXED_HEADER,
+      EVENT_TYPE,
+      DOMAIN_NAME,
+      TYPE_NAME,
+      EVENT_NAME,
+      VARIABLE_HEADER,
+      REMAINDER_OF_BODY,
+      EMPTY
+    };
+
+  /// The types of the literals, which ETCL_Constraint keeps to
+  /// itself.
+  struct Literal_Types : public ETCL_Constraint
+  {
+    static TAO_Notify_Constraint_Program::Literal_Class
+    literal_class (Literal_Type type)
+    {
+      switch (type)
+        {
+        case ACE_ETCL_STRING:
+          return TAO_Notify_Constraint_Program::STRING_LITERAL;
+        case ACE_ETCL_DOUBLE:
+          return TAO_Notify_Constraint_Program::DOUBLE_LITERAL;
+        case ACE_ETCL_UNSIGNED:
+          return TAO_Notify_Constraint_Program::UNSIGNED_LITERAL;
+        case ACE_ETCL_SIGNED:
+        case ACE_ETCL_INTEGER:
+          return TAO_Notify_Constraint_Program::SIGNED_LITERAL;
+        case ACE_ETCL_BOOLEAN:
+          return TAO_Notify_Constraint_Program::BOOLEAN_LITERAL;
+        default:
+          return TAO_Notify_Constraint_Program::OTHER_LITERAL;
+        }
+    }
+  };
+
+  Event_Field
+  event_field (const char *name)
+  {
+    static const struct
+    {
+      const char *name_;
+      Event_Field field_;
+    } fields[] =
+      {
+        { "filterable_data", FILTERABLE_DATA },
+        { "header", HEADER },
+        { "remainder_of_body", REMAINDER_OF_BODY },
+        { "fixed_header", FIXED_HEADER },
+        { "variable_header", VARIABLE_HEADER },
+        { "event_name", EVENT_NAME },
+        { "event_type", EVENT_TYPE },
+        { "domain_name", DOMAIN_NAME },
+        { "type_name", TYPE_NAME }
+      };
+
+    for (size_t i = 0; i < sizeof (fields) / sizeof (fields[0]); ++i)
+      {
+        if (ACE_OS::strcmp (name, fields[i].name_) == 0)
+          {
+            return fields[i].field_;
+          }
+      }
+
+    return EMPTY;
+  }
+}
+
+/**
+ * @class TAO_Notify_Constraint_Program::Compiler
+ *
+ * @brief Emits the instructions for an expression tree.
+ *
+ * Each visit method emits the instructions that leave the value of
+ * the visited node on the operand stack, so it always succeeds; a node
+ * that cannot be compiled is evaluated by a VISIT instruction.
+ */
+class TAO_Notify_Constraint_Program::Compiler
+  : public ETCL_Constraint_Visitor
+{
+public:
+  explicit Compiler (TAO_Notify_Constraint_Program &program);
+
+  virtual int visit_literal (ETCL_Literal_Constraint *);
+  virtual int visit_identifier (ETCL_Identifier *);
+  virtual int visit_union_value (ETCL_Union_Value *);
+  virtual int visit_union_pos (ETCL_Union_Pos *);
+  virtual int visit_component_pos (ETCL_Component_Pos *);
+  virtual int visit_component_assoc (ETCL_Component_Assoc *);
+  virtual int visit_component_array (ETCL_Component_Array *);
+  virtual int visit_special (ETCL_Special *);
+  virtual int visit_component (ETCL_Component *);
+  virtual int visit_dot (ETCL_Dot *);
+  virtual int visit_eval (ETCL_Eval *);
+  virtual int visit_default (ETCL_Default *);
+  virtual int visit_exist (ETCL_Exist *);
+  virtual int visit_unary_expr (ETCL_Unary_Expr *);
+  virtual int visit_binary_expr (ETCL_Binary_Expr *);
+  virtual int visit_preference (ETCL_Preference *);
+
+private:
+  /// Let the visitor evaluate @a node.
+  int visit (ETCL_Constraint *node);
+
+  /// Emit the instruction pushing the event value that the component
+  /// @a comp refers to, within the event field @a field.  Returns -1,
+  /// without emitting anything, if the component does not simply
+  /// designate an event value.
+  int compile_path (ETCL_Constraint *comp, Event_Field field);
+
+  /// Emit the instruction pushing a named event value.
+  int push_value (Opcode op, const char *name);
+
+  TAO_Notify_Constraint_Program &program_;
+
+  /// The kind of value pushed by the last successful compile_path():
+  /// EMPTY for a component that is not a field of the event.
+  Event_Field leaf_;
+};
+
+TAO_Notify_Constraint_Program::Compiler::Compiler (
+    TAO_Notify_Constraint_Program &program)
+  : program_ (program),
+    leaf_ (EMPTY)
+{
+}
+
+int
+TAO_Notify_Constraint_Program::Compiler::visit (ETCL_Constraint *node)
+{
+  this->program_.nodes_.push_back (node);
+  this->program_.emit (VISIT,
+                       static_cast<CORBA::ULong> (
+                         this->program_.nodes_.size () - 1));
+  return 0;
+}
+
+int
+TAO_Notify_Constraint_Program::Compiler::push_value (Opcode op,
+                                                     const char *name)
+{
+  this->program_.names_.push_back (ACE_CString (name));
+  this->program_.emit (op,
+                       static_cast<CORBA::ULong> (
+                         this->program_.names_.size () - 1));
+  return 0;
+}
+
+int
+TAO_Notify_Constraint_Program::Compiler::compile_path (ETCL_Constraint *comp,
+                                                       Event_Field field)
+{
+  if (comp == 0)
+    {
+      return -1;
+    }
+
+  ETCL_Dot *dot = dynamic_cast<ETCL_Dot *> (comp);
+
+  if (dot != 0)
+    {
+      return this->compile_path (dot->component (), field);
+    }
+
+  ETCL_Identifier *ident = dynamic_cast<ETCL_Identifier *> (comp);
+
+  if (ident != 0)
+    {
+      this->leaf_ = FILTERABLE_DATA;
+      return this->push_value (PUSH_FILTERABLE_DATA, ident->value ());
+    }
+
+  ETCL_Component_Assoc *assoc = dynamic_cast<ETCL_Component_Assoc *> (comp);
+
+  if (assoc != 0)
+    {
+      // Only the sequence members of CosNotification::StructuredEvent
+      // can be treated as associative arrays.
+      if (assoc->component () != 0)
+        {
+          return -1;
+        }
+
+      this->leaf_ = field;
+
+      switch (field)
+        {
+        case FILTERABLE_DATA:
+          return this->push_value (PUSH_FILTERABLE_DATA,
+                                   assoc->identifier ()->value ());
+        case VARIABLE_HEADER:
+          return this->push_value (PUSH_VARIABLE_HEADER,
+                                   assoc->identifier ()->value ());
+        default:
+          return -1;
+        }
+    }
+
+  ETCL_Component *component = dynamic_cast<ETCL_Component *> (comp);
+
+  if (component == 0)
+    {
+      return -1;
+    }
+
+  const char *name = component->identifier ()->value ();
+  ETCL_Constraint *nested = component->component ();
+  Event_Field const component_field = event_field (name);
+
+  if (component_field == EMPTY)
+    {
+      // A name that is not a field of the structured event refers to
+      // a value in the filterable data.  Anything nested in the value
+      // is found by the visitor.
+      if (nested != 0)
+        {
+          return -1;
+        }
+
+      this->leaf_ = EMPTY;
+      return this->push_value (PUSH_FILTERABLE_DATA, name);
+    }
+
+  if (nested != 0)
+    {
+      return this->compile_path (nested, component_field);
+    }
+
+  // The leaves of the CosNotification::StructuredEvent "tree".
+  this->leaf_ = component_field;
+
+  switch (component_field)
+    {
+    case DOMAIN_NAME:
+      this->program_.emit (PUSH_DOMAIN_NAME);
+      return 0;
+    case TYPE_NAME:
+      this->program_.emit (PUSH_TYPE_NAME);
+      return 0;
+    case EVENT_NAME:
+      this->program_.emit (PUSH_EVENT_NAME);
+      return 0;
+    case REMAINDER_OF_BODY:
+      this->program_.emit (PUSH_REMAINDER_OF_BODY);
+      return 0;
+    default:
+      return -1;
+    }
+}
+
+int
+TAO_Notify_Constraint_Program::Compiler::visit_literal (
+    ETCL_Literal_Constraint *literal)
+{
+  this->program_.literals_.push_back (TAO_ETCL_Literal_Constraint (literal));
+  this->program_.emit (PUSH_LITERAL,
+                       static_cast<CORBA::ULong> (
+                         this->program_.literals_.size () - 1));
+  return 0;
+}
+
+int
+TAO_Notify_Constraint_Program::Compiler::visit_identifier (
+    ETCL_Identifier *ident)
+{
+  return this->push_value (PUSH_FILTERABLE_DATA, ident->value ());
+}
+
+int
+TAO_Notify_Constraint_Program::Compiler::visit_union_value (
+    ETCL_Union_Value *union_value)
+{
+  return this->visit (union_value);
+}
+
+int
+TAO_Notify_Constraint_Program::Compiler::visit_union_pos (
+    ETCL_Union_Pos *union_pos)
+{
+  return this->visit (union_pos);
+}
+
+int
+TAO_Notify_Constraint_Program::Compiler::visit_component_pos (
+    ETCL_Component_Pos *pos)
+{
+  return this->visit (pos);
+}
+
+int
+TAO_Notify_Constraint_Program::Compiler::visit_component_assoc (
+    ETCL_Component_Assoc *assoc)
+{
+  return this->visit (assoc);
+}
+
+int
+TAO_Notify_Constraint_Program::Compiler::visit_component_array (
+    ETCL_Component_Array *array)
+{
+  return this->visit (array);
+}
+
+int
+TAO_Notify_Constraint_Program::Compiler::visit_special (ETCL_Special *special)
+{
+  return this->visit (special);
+}
+
+int
+TAO_Notify_Constraint_Program::Compiler::visit_component (
+    ETCL_Component *component)
+{
+  if (this->compile_path (component, EMPTY) != 0)
+    {
+      return this->visit (component);
+    }
+
+  return 0;
+}
+
+int
+TAO_Notify_Constraint_Program::Compiler::visit_dot (ETCL_Dot *dot)
+{
+  if (this->compile_path (dot, EMPTY) != 0)
+    {
+      return this->visit (dot);
+    }
+
+  return 0;
+}
+
+int
+TAO_Notify_Constraint_Program::Compiler::visit_eval (ETCL_Eval *eval)
+{
+  if (this->compile_path (eval->component (), EMPTY) != 0)
+    {
+      return this->visit (eval);
+    }
+
+  return 0;
+}
+
+int
+TAO_Notify_Constraint_Program::Compiler::visit_default (ETCL_Default *def)
+{
+  return this->visit (def);
+}
+
+int
+TAO_Notify_Constraint_Program::Compiler::visit_exist (ETCL_Exist *exist)
+{
+  // The instructions pushing an event value fail if the value does
+  // not exist.  Like the visitor, only the values of the filterable
+  // data and variable header, and the names of the fixed header can be
+  // tested.
+  if (this->compile_path (exist->component (), EMPTY) != 0)
+    {
+      return this->visit (exist);
+    }
+
+  switch (this->leaf_)
+    {
+    case FILTERABLE_DATA:
+    case VARIABLE_HEADER:
+    case DOMAIN_NAME:
+    case TYPE_NAME:
+    case EVENT_NAME:
+      this->program_.emit (EXIST);
+      return 0;
+    default:
+      this->program_.code_.pop_back ();
+      --this->program_.depth_;
+      return this->visit (exist);
+    }
+}
+
+int
+TAO_Notify_Constraint_Program::Compiler::visit_unary_expr (
+    ETCL_Unary_Expr *unary_expr)
+{
+  switch (unary_expr->type ())
+    {
+    case ETCL_NOT:
+      unary_expr->subexpr ()->accept (this);
+      this->program_.emit (NOT);
+      return 0;
+    case ETCL_MINUS:
+      {
+        // The grammar only has positive numeric literals; negative
+        // ones are negated once, while compiling.
+        ETCL_Literal_Constraint *literal =
+          dynamic_cast<ETCL_Literal_Constraint *> (unary_expr->subexpr ());
+
+        if (literal != 0)
+          {
+            TAO_ETCL_Literal_Constraint value (literal);
+            this->program_.literals_.push_back (-value);
+            this->program_.emit (PUSH_LITERAL,
+                                 static_cast<CORBA::ULong> (
+                                   this->program_.literals_.size () - 1));
+            return 0;
+          }
+
+        unary_expr->subexpr ()->accept (this);
+        this->program_.emit (NEGATE);
+        return 0;
+      }
+    case ETCL_PLUS:
+      // The leading '+' is just syntactic sugar.
+      return unary_expr->subexpr ()->accept (this);
+    default:
+      return this->visit (unary_expr);
+    }
+}
+
+int
+TAO_Notify_Constraint_Program::Compiler::visit_binary_expr (
+    ETCL_Binary_Expr *binary_expr)
+{
+  Opcode op = TO_BOOLEAN;
+
+  switch (binary_expr->type ())
+    {
+    case ETCL_OR:
+    case ETCL_AND:
+      {
+        // Short-circuiting operators: the right operand is only
+        // evaluated if the left one does not decide the result.
+        binary_expr->lhs ()->accept (this);
+        CORBA::ULong const jump =
+          this->program_.emit (binary_expr->type () == ETCL_OR
+                               ? OR_ELSE
+                               : AND_THEN);
+        binary_expr->rhs ()->accept (this);
+        this->program_.emit (TO_BOOLEAN);
+        this->program_.code_[jump].arg_ =
+          static_cast<CORBA::ULong> (this->program_.code_.size ());
+        return 0;
+      }
+    case ETCL_LT:
+      op = LT;
+      break;
+    case ETCL_LE:
+      op = LE;
+      break;
+    case ETCL_GT:
+      op = GT;
+      break;
+    case ETCL_GE:
+      op = GE;
+      break;
+    case ETCL_EQ:
+      op = EQ;
+      break;
+    case ETCL_NE:
+      op = NE;
+      break;
+    case ETCL_PLUS:
+      op = ADD;
+      break;
+    case ETCL_MINUS:
+      op = SUBTRACT;
+      break;
+    case ETCL_MULT:
+      op = MULTIPLY;
+      break;
+    case ETCL_DIV:
+      op = DIVIDE;
+      break;
+    case ETCL_TWIDDLE:
+      op = TWIDDLE;
+      break;
+    default:
+      // "in" looks inside a component with DynAny.
+      return this->visit (binary_expr);
+    }
+
+  binary_expr->lhs ()->accept (this);
+  binary_expr->rhs ()->accept (this);
+  this->program_.emit (op);
+  return 0;
+}
+
+int
+TAO_Notify_Constraint_Program::Compiler::visit_preference (
+    ETCL_Preference *pref)
+{
+  return this->visit (pref);
+}
+
+/******************************************************************/
+
+TAO_Notify_Constraint_Context::TAO_Notify_Constraint_Context (
+    const CosNotification::StructuredEvent &event)
+  : event_ (event),
+    stack_ (),
+    visitor_ (0),
+    visitor_failed_ (false)
+{
+}
+
+TAO_Notify_Constraint_Context::~TAO_Notify_Constraint_Context (void)
+{
+  delete this->visitor_;
+}
+
+const CORBA::Any *
+TAO_Notify_Constraint_Context::find (
+    const CosNotification::PropertySeq &properties,
+    const char *name)
+{
+  CORBA::ULong const length = properties.length ();
+
+  for (CORBA::ULong i = 0; i < length; ++i)
+    {
+      if (ACE_OS::strcmp (properties[i].name.in (), name) == 0)
+        {
+          return &properties[i].value;
+        }
+    }
+
+  return 0;
+}
+
+TAO_Notify_Constraint_Visitor *
+TAO_Notify_Constraint_Context::visitor (void)
+{
+  if (this->visitor_ == 0 && !this->visitor_failed_)
+    {
+      ACE_NEW_RETURN (this->visitor_,
+                      TAO_Notify_Constraint_Visitor,
+                      0);
+
+      if (this->visitor_->bind_structured_event (this->event_) != 0)
+        {
+          delete this->visitor_;
+          this->visitor_ = 0;
+          this->visitor_failed_ = true;
+        }
+    }
+
+  return this->visitor_;
+}
+
+/******************************************************************/
+
+TAO_Notify_Constraint_Program::TAO_Notify_Constraint_Program (void)
+  : depth_ (0),
+    max_depth_ (0),
+    has_predicates_ (false)
+{
+}
+
+TAO_Notify_Constraint_Program::~TAO_Notify_Constraint_Program (void)
+{
+}
+
+size_t
+TAO_Notify_Constraint_Program::size (void) const
+{
+  return this->code_.size ();
+}
+
+CORBA::ULong
+TAO_Notify_Constraint_Program::emit (Opcode op, CORBA::ULong arg)
+{
+  Instruction const instruction = { op, arg };
+  this->code_.push_back (instruction);
+
+  switch (op)
+    {
+    case PUSH_LITERAL:
+    case PUSH_DOMAIN_NAME:
+    case PUSH_TYPE_NAME:
+    case PUSH_EVENT_NAME:
+    case PUSH_REMAINDER_OF_BODY:
+    case PUSH_FILTERABLE_DATA:
+    case PUSH_VARIABLE_HEADER:
+    case VISIT:
+      if (++this->depth_ > this->max_depth_)
+        {
+          this->max_depth_ = this->depth_;
+        }
+      break;
+    case LT:
+    case LE:
+    case GT:
+    case GE:
+    case EQ:
+    case NE:
+    case ADD:
+    case SUBTRACT:
+    case MULTIPLY:
+    case DIVIDE:
+    case TWIDDLE:
+    case OR_ELSE:
+    case AND_THEN:
+      // The jumps leave their operand on the stack, but then the
+      // instructions of the right operand are skipped.
+      --this->depth_;
+      break;
+    default:
+      break;
+    }
+
+  return static_cast<CORBA::ULong> (this->code_.size () - 1);
+}
+
+void
+TAO_Notify_Constraint_Program::compile (ETCL_Constraint *root)
+{
+  this->code_.clear ();
+  this->literals_.clear ();
+  this->names_.clear ();
+  this->nodes_.clear ();
+  this->depth_ = 0;
+  this->max_depth_ = 0;
+  this->predicates_.clear ();
+
+  if (root == 0)
+    {
+      // Never matches.
+      this->has_predicates_ = true;
+      return;
+    }
+
+  Compiler compiler (*this);
+  root->accept (&compiler);
+
+  this->has_predicates_ =
+    TAO_Notify_Constraint_Program::find_predicates (root, this->predicates_);
+
+  if (!this->has_predicates_)
+    {
+      this->predicates_.clear ();
+    }
+}
+
+bool
+TAO_Notify_Constraint_Program::predicates (Predicates &predicates) const
+{
+  if (!this->has_predicates_)
+    {
+      return false;
+    }
+
+  for (size_t i = 0; i < this->predicates_.size (); ++i)
+    {
+      predicates.push_back (this->predicates_[i]);
+    }
+
+  return true;
+}
+
+bool
+TAO_Notify_Constraint_Program::find_predicates (ETCL_Constraint *node,
+                                                Predicates &result)
+{
+  Predicate predicate;
+  ETCL_Binary_Expr *binary_expr = dynamic_cast<ETCL_Binary_Expr *> (node);
+
+  if (binary_expr == 0)
+    {
+      switch (TAO_Notify_Constraint_Program::operand (node, predicate))
+        {
+        case 0:
+          {
+            // A value is only true if it is the boolean TRUE.
+            predicate.comparison_ = EQUAL;
+            predicate.reversed_ = false;
+            replace (predicate.literal_, true);
+            result.push_back (predicate);
+            return true;
+          }
+        case 1:
+          // A literal that is true always matches; any other literal
+          // never does, which no predicate describes.
+          return !static_cast<CORBA::Boolean> (predicate.literal_);
+        default:
+          return false;
+        }
+    }
+
+  switch (binary_expr->type ())
+    {
+    case ETCL_OR:
+      {
+        // Either side may be satisfied.
+        Predicates lhs;
+        Predicates rhs;
+
+        if (!TAO_Notify_Constraint_Program::find_predicates (
+              binary_expr->lhs (), lhs)
+            || !TAO_Notify_Constraint_Program::find_predicates (
+                 binary_expr->rhs (), rhs))
+          {
+            return false;
+          }
+
+        for (size_t i = 0; i < lhs.size (); ++i)
+          {
+            result.push_back (lhs[i]);
+          }
+
+        for (size_t i = 0; i < rhs.size (); ++i)
+          {
+            result.push_back (rhs[i]);
+          }
+
+        return true;
+      }
+    case ETCL_AND:
+      {
+        // Both sides must be satisfied, so the predicates of either
+        // one will do.  Equalities are looked up faster than ranges,
+        // and fewer predicates select fewer events.
+        Predicates lhs;
+        Predicates rhs;
+        bool const has_lhs =
+          TAO_Notify_Constraint_Program::find_predicates (
+            binary_expr->lhs (), lhs);
+        bool const has_rhs =
+          TAO_Notify_Constraint_Program::find_predicates (
+            binary_expr->rhs (), rhs);
+
+        if (!has_lhs && !has_rhs)
+          {
+            return false;
+          }
+
+        bool use_lhs = has_lhs;
+
+        if (has_lhs && has_rhs)
+          {
+            size_t lhs_ranges = 0;
+            size_t rhs_ranges = 0;
+
+            for (size_t i = 0; i < lhs.size (); ++i)
+              {
+                lhs_ranges += (lhs[i].comparison_ != EQUAL);
+              }
+
+            for (size_t i = 0; i < rhs.size (); ++i)
+              {
+                rhs_ranges += (rhs[i].comparison_ != EQUAL);
+              }
+
+            if ((lhs_ranges == 0) != (rhs_ranges == 0))
+              {
+                use_lhs = lhs_ranges == 0;
+              }
+            else
+              {
+                use_lhs = lhs.size () <= rhs.size ();
+              }
+          }
+
+        const Predicates &predicates = use_lhs ? lhs : rhs;
+
+        for (size_t i = 0; i < predicates.size (); ++i)
+          {
+            result.push_back (predicates[i]);
+          }
+
+        return true;
+      }
+    case ETCL_EQ:
+      predicate.comparison_ = EQUAL;
+      break;
+    case ETCL_LT:
+      predicate.comparison_ = LESS;
+      break;
+    case ETCL_LE:
+      predicate.comparison_ = LESS_EQUAL;
+      break;
+    case ETCL_GT:
+      predicate.comparison_ = GREATER;
+      break;
+    case ETCL_GE:
+      predicate.comparison_ = GREATER_EQUAL;
+      break;
+    default:
+      return false;
+    }
+
+  // One side must be the event value and the other the literal.
+  int const lhs = TAO_Notify_Constraint_Program::operand (binary_expr->lhs (),
+                                                          predicate);
+  int const rhs = TAO_Notify_Constraint_Program::operand (binary_expr->rhs (),
+                                                          predicate);
+
+  if (lhs == -1 || rhs == -1 || lhs == rhs)
+    {
+      return false;
+    }
+
+  predicate.reversed_ = (lhs == 1);
+
+  switch (TAO_Notify_Constraint_Program::literal_class (predicate.literal_))
+    {
+    case STRING_LITERAL:
+    case BOOLEAN_LITERAL:
+      // Only the numbers are ordered.
+      if (predicate.comparison_ != EQUAL)
+        {
+          return false;
+        }
+      break;
+    case DOUBLE_LITERAL:
+    case UNSIGNED_LITERAL:
+    case SIGNED_LITERAL:
+      break;
+    default:
+      return false;
+    }
+
+  result.push_back (predicate);
+  return true;
+}
+
+int
+TAO_Notify_Constraint_Program::operand (ETCL_Constraint *node,
+                                        Predicate &predicate)
+{
+  if (node == 0)
+    {
+      return -1;
+    }
+
+  TAO_Notify_Constraint_Program program;
+  Compiler compiler (program);
+  node->accept (&compiler);
+
+  if (program.code_.size () != 1)
+    {
+      return -1;
+    }
+
+  const Instruction &instruction = program.code_[0];
+
+  switch (instruction.op_)
+    {
+    case PUSH_LITERAL:
+      replace (predicate.literal_, program.literals_[instruction.arg_]);
+      return 1;
+    case PUSH_DOMAIN_NAME:
+      predicate.value_ = DOMAIN_NAME_VALUE;
+      return 0;
+    case PUSH_TYPE_NAME:
+      predicate.value_ = TYPE_NAME_VALUE;
+      return 0;
+    case PUSH_EVENT_NAME:
+      predicate.value_ = EVENT_NAME_VALUE;
+      return 0;
+    case PUSH_FILTERABLE_DATA:
+      predicate.value_ = FILTERABLE_DATA_VALUE;
+      predicate.name_ = program.names_[instruction.arg_];
+      return 0;
+    case PUSH_VARIABLE_HEADER:
+      predicate.value_ = VARIABLE_HEADER_VALUE;
+      predicate.name_ = program.names_[instruction.arg_];
+      return 0;
+    default:
+      return -1;
+    }
+}
+
+TAO_Notify_Constraint_Program::Literal_Class
+TAO_Notify_Constraint_Program::literal_class (
+    const ETCL_Literal_Constraint &literal)
+{
+  return Literal_Types::literal_class (literal.expr_type ());
+}
+
+bool
+TAO_Notify_Constraint_Program::value (
+    const CosNotification::StructuredEvent &event,
+    Value kind,
+    const char *name,
+    TAO_ETCL_Literal_Constraint &result)
+{
+  switch (kind)
+    {
+    case DOMAIN_NAME_VALUE:
+      replace (result, event.header.fixed_header.event_type.domain_name.in ());
+      return true;
+    case TYPE_NAME_VALUE:
+      replace (result, event.header.fixed_header.event_type.type_name.in ());
+      return true;
+    case EVENT_NAME_VALUE:
+      replace (result, event.header.fixed_header.event_name.in ());
+      return true;
+    case FILTERABLE_DATA_VALUE:
+    case VARIABLE_HEADER_VALUE:
+      {
+        const CORBA::Any *any =
+          TAO_Notify_Constraint_Context::find (
+            kind == FILTERABLE_DATA_VALUE
+            ? event.filterable_data
+            : event.header.variable_header,
+            name);
+
+        if (any == 0 || any->impl () == 0)
+          {
+            return false;
+          }
+
+        CORBA::Any copy (*any);
+        replace (result, &copy);
+        return true;
+      }
+    }
+
+  return false;
+}
+
+bool
+TAO_Notify_Constraint_Program::satisfies (
+    const Predicate &predicate,
+    const TAO_ETCL_Literal_Constraint &value)
+{
+  // The operators of the literals are not const.
+  TAO_ETCL_Literal_Constraint lhs (predicate.reversed_
+                                   ? predicate.literal_
+                                   : value);
+  TAO_ETCL_Literal_Constraint rhs (predicate.reversed_
+                                   ? value
+                                   : predicate.literal_);
+
+  switch (predicate.comparison_)
+    {
+    case EQUAL:
+      return lhs == rhs;
+    case LESS:
+      return lhs < rhs;
+    case LESS_EQUAL:
+      return lhs <= rhs;
+    case GREATER:
+      return lhs > rhs;
+    case GREATER_EQUAL:
+      return lhs >= rhs;
+    }
+
+  return false;
+}
+
+CORBA::Boolean
+TAO_Notify_Constraint_Program::evaluate (
+    TAO_Notify_Constraint_Context &context) const
+{
+  size_t const count = this->code_.size ();
+
+  if (count == 0)
+    {
+      return false;
+    }
+
+  if (context.stack_.size () < this->max_depth_)
+    {
+      context.stack_.size (this->max_depth_);
+    }
+
+  ACE_Array_Base<TAO_ETCL_Literal_Constraint> &stack = context.stack_;
+  const CosNotification::StructuredEvent &event = context.event_;
+  size_t top = 0;
+  size_t pc = 0;
+
+  while (pc < count)
+    {
+      const Instruction &instruction = this->code_[pc++];
+
+      switch (instruction.op_)
+        {
+        case PUSH_LITERAL:
+          replace (stack[top++], this->literals_[instruction.arg_]);
+          break;
+        case PUSH_DOMAIN_NAME:
+          replace (stack[top++],
+                   event.header.fixed_header.event_type.domain_name.in ());
+          break;
+        case PUSH_TYPE_NAME:
+          replace (stack[top++],
+                   event.header.fixed_header.event_type.type_name.in ());
+          break;
+        case PUSH_EVENT_NAME:
+          replace (stack[top++], event.header.fixed_header.event_name.in ());
+          break;
+        case PUSH_REMAINDER_OF_BODY:
+          {
+            // Extracting from an Any may replace its implementation, so
+            // the event is left alone.
+            CORBA::Any body (event.remainder_of_body);
+            replace (stack[top++], &body);
+          }
+          break;
+        case PUSH_FILTERABLE_DATA:
+        case PUSH_VARIABLE_HEADER:
+          {
+            const CORBA::Any *value =
+              TAO_Notify_Constraint_Context::find (
+                instruction.op_ == PUSH_FILTERABLE_DATA
+                ? event.filterable_data
+                : event.header.variable_header,
+                this->names_[instruction.arg_].c_str ());
+
+            if (value == 0 || value->impl () == 0)
+              {
+                return false;
+              }
+
+            CORBA::Any any (*value);
+            replace (stack[top++], &any);
+          }
+          break;
+        case VISIT:
+          {
+            TAO_Notify_Constraint_Visitor *visitor = context.visitor ();
+            TAO_ETCL_Literal_Constraint result;
+
+            if (visitor == 0
+                || visitor->evaluate_value (this->nodes_[instruction.arg_],
+                                            result) != 0)
+              {
+                return false;
+              }
+
+            replace (stack[top++], result);
+          }
+          break;
+        case EXIST:
+          replace (stack[top - 1], true);
+          break;
+        case NOT:
+          replace (stack[top - 1],
+                   ! static_cast<CORBA::Boolean> (stack[top - 1]));
+          break;
+        case NEGATE:
+          replace (stack[top - 1], -stack[top - 1]);
+          break;
+        case LT:
+          --top;
+          replace (stack[top - 1], stack[top - 1] < stack[top]);
+          break;
+        case LE:
+          --top;
+          replace (stack[top - 1], stack[top - 1] <= stack[top]);
+          break;
+        case GT:
+          --top;
+          replace (stack[top - 1], stack[top - 1] > stack[top]);
+          break;
+        case GE:
+          --top;
+          replace (stack[top - 1], stack[top - 1] >= stack[top]);
+          break;
+        case EQ:
+          --top;
+          replace (stack[top - 1], stack[top - 1] == stack[top]);
+          break;
+        case NE:
+          --top;
+          replace (stack[top - 1], stack[top - 1] != stack[top]);
+          break;
+        case ADD:
+          --top;
+          replace (stack[top - 1], stack[top - 1] + stack[top]);
+          break;
+        case SUBTRACT:
+          --top;
+          replace (stack[top - 1], stack[top - 1] - stack[top]);
+          break;
+        case MULTIPLY:
+          --top;
+          replace (stack[top - 1], stack[top - 1] * stack[top]);
+          break;
+        case DIVIDE:
+          --top;
+          replace (stack[top - 1], stack[top - 1] / stack[top]);
+          break;
+        case TWIDDLE:
+          {
+            // Determine if the left operand is a substring of the right;
+            // an operand that is not a string is a substring of nothing.
+            --top;
+            const char *left = stack[top - 1];
+            const char *right = stack[top];
+            replace (stack[top - 1],
+                     left != 0 && right != 0
+                     && ACE_OS::strstr (right, left) != 0);
+          }
+          break;
+        case OR_ELSE:
+        case AND_THEN:
+          {
+            CORBA::Boolean const value =
+              static_cast<CORBA::Boolean> (stack[top - 1]);
+
+            if (value == (instruction.op_ == OR_ELSE))
+              {
+                replace (stack[top - 1], value);
+                pc = instruction.arg_;
+              }
+            else
+              {
+                --top;
+              }
+          }
+          break;
+        case TO_BOOLEAN:
+          replace (stack[top - 1],
+                   static_cast<CORBA::Boolean> (stack[top - 1]));
+          break;
+        }
+    }
+
+  return top == 1 && static_cast<CORBA::Boolean> (stack[0]);
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
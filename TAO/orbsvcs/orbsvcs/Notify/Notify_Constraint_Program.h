@@ -0,0 +1,308 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file   Notify_Constraint_Program.h
+ */
+//=============================================================================
+
+#ifndef TAO_NOTIFY_CONSTRAINT_PROGRAM_H
+#define TAO_NOTIFY_CONSTRAINT_PROGRAM_H
+
+#include /**/ "ace/pre.h"
+
+#include "ace/Array_Base.h"
+#include "ace/Vector_T.h"
+#include "ace/SString.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "tao/ETCL/TAO_ETCL_Constraint.h"
+
+#include "orbsvcs/CosNotificationC.h"
+
+#include "orbsvcs/Notify/notify_serv_export.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+class TAO_Notify_Constraint_Visitor;
+
+/**
+ * @class TAO_Notify_Constraint_Context
+ *
+ * @brief The event that the constraints of a filter are evaluated on.
+ *
+ * The values of the event are read straight from the event when a
+ * TAO_Notify_Constraint_Program needs them.  The same context is used
+ * for all the constraints of the filter; it also keeps the operand
+ * stack of the programs, and the visitor that evaluates the parts of
+ * a constraint that were not compiled, which is only created when
+ * such a part is evaluated.
+ */
+class TAO_Notify_Serv_Export TAO_Notify_Constraint_Context
+{
+public:
+  /// Constructor.  The event must outlive the context.
+  explicit TAO_Notify_Constraint_Context (
+    const CosNotification::StructuredEvent &event);
+
+  /// Destructor.
+  ~TAO_Notify_Constraint_Context (void);
+
+private:
+  friend class TAO_Notify_Constraint_Program;
+
+  /// Returns the value of the first property called @a name in
+  /// @a properties, or 0 if there is none.
+  static const CORBA::Any *find (const CosNotification::PropertySeq &properties,
+                                 const char *name);
+
+  /// Returns the visitor bound to the event, or 0 if it cannot be
+  /// bound.
+  TAO_Notify_Constraint_Visitor *visitor (void);
+
+  /// The event.
+  const CosNotification::StructuredEvent &event_;
+
+  /// The operand stack of the programs.
+  ACE_Array_Base<TAO_ETCL_Literal_Constraint> stack_;
+
+  /// The visitor, if it was created.
+  TAO_Notify_Constraint_Visitor *visitor_;
+
+  /// Set if the visitor could not be bound to the event.
+  bool visitor_failed_;
+};
+
+/**
+ * @class TAO_Notify_Constraint_Program
+ *
+ * @brief A constraint compiled from its ETCL expression tree.
+ *
+ * Evaluating the expression tree of a constraint with the
+ * TAO_Notify_Constraint_Visitor walks the tree with a virtual call per
+ * node, allocates a queue node for every intermediate value, and needs
+ * the filterable_data and variable_header of the event copied into
+ * hash maps first.  With many filters per channel this dominates the
+ * cost of delivering an event.
+ *
+ * The program is the tree flattened once, when the constraint is
+ * added, into a sequence of instructions for a small stack machine.
+ * The references to the fields of the structured event, like
+ * $domain_name, $.header.fixed_header.event_name, $name or
+ * $.filterable_data(name), are resolved while compiling and read from
+ * the event directly; "and" and "or" become conditional jumps.  The
+ * parts of the tree that the program does not handle (positional,
+ * union and array components, "in", "default" and the special
+ * components) are evaluated by the visitor, so the result is the one
+ * of the expression tree.
+ *
+ * The comparisons of event values with literals that an event must
+ * satisfy for the constraint to match are also collected while
+ * compiling; see TAO_Notify_Subscription_Index.
+ */
+class TAO_Notify_Serv_Export TAO_Notify_Constraint_Program
+{
+public:
+  /// Constructor.
+  TAO_Notify_Constraint_Program (void);
+
+  /// Destructor.
+  ~TAO_Notify_Constraint_Program (void);
+
+  /// Compile the expression tree rooted at @a root, which must outlive
+  /// the program.  A null @a root gives a program that never matches.
+  void compile (ETCL_Constraint *root);
+
+  /// Returns true if the event of @a context satisfies the constraint.
+  /// If an error occurs during the evaluation, the constraint is not
+  /// satisfied.
+  CORBA::Boolean evaluate (TAO_Notify_Constraint_Context &context) const;
+
+  /// Number of instructions of the program.
+  size_t size (void) const;
+
+  /// The event values that a predicate can test.
+  enum Value
+    {
+      DOMAIN_NAME_VALUE,
+      TYPE_NAME_VALUE,
+      EVENT_NAME_VALUE,
+      FILTERABLE_DATA_VALUE,
+      VARIABLE_HEADER_VALUE
+    };
+
+  /// The comparisons that a predicate can make.
+  enum Comparison
+    {
+      EQUAL,
+      LESS,
+      LESS_EQUAL,
+      GREATER,
+      GREATER_EQUAL
+    };
+
+  /**
+   * @struct Predicate
+   *
+   * @brief The comparison of an event value with a literal.
+   */
+  struct Predicate
+  {
+    /// The event value, and its name for the values of the
+    /// filterable data and the variable header.
+    Value value_;
+    ACE_CString name_;
+
+    /// The predicate is "value comparison literal", or "literal
+    /// comparison value" if reversed_ is set.
+    Comparison comparison_;
+    bool reversed_;
+
+    /// The literal, which is a string, a number or a boolean.
+    TAO_ETCL_Literal_Constraint literal_;
+  };
+
+  typedef ACE_Vector<Predicate, 2> Predicates;
+
+  /// The types of the literals that a predicate compares with, in the
+  /// order in which the ETCL widens them to compare two values.  The
+  /// signed and integer types compare the same way.
+  enum Literal_Class
+    {
+      STRING_LITERAL,
+      DOUBLE_LITERAL,
+      UNSIGNED_LITERAL,
+      SIGNED_LITERAL,
+      BOOLEAN_LITERAL,
+      OTHER_LITERAL
+    };
+
+  /// Returns the class of @a literal.
+  static Literal_Class literal_class (const ETCL_Literal_Constraint &literal);
+
+  /**
+   * Append to @a predicates the predicates of the constraint: an
+   * event can only satisfy the constraint if it satisfies one of them.
+   * Returns false, without appending anything, if the constraint has
+   * no such predicates, for instance because it tests an event value
+   * with "~" or "!=", or only under "not".  A program that never
+   * matches has an empty set of predicates.
+   */
+  bool predicates (Predicates &predicates) const;
+
+  /// Get the event value @a kind, called @a name if it is in the
+  /// filterable data or the variable header.  Returns false if the
+  /// event does not have it, in which case no predicate on the value
+  /// can be satisfied.
+  static bool value (const CosNotification::StructuredEvent &event,
+                     Value kind,
+                     const char *name,
+                     TAO_ETCL_Literal_Constraint &result);
+
+  /// Returns true if the event value @a value satisfies @a predicate.
+  static bool satisfies (const Predicate &predicate,
+                         const TAO_ETCL_Literal_Constraint &value);
+
+private:
+  class Compiler;
+  friend class Compiler;
+
+  /// The instructions of the stack machine.
+  enum Opcode
+    {
+      /// Push literals_[arg].
+      PUSH_LITERAL,
+
+      /// Push a string field of the fixed header.
+      PUSH_DOMAIN_NAME,
+      PUSH_TYPE_NAME,
+      PUSH_EVENT_NAME,
+
+      /// Push the remainder_of_body of the event.
+      PUSH_REMAINDER_OF_BODY,
+
+      /// Push the value called names_[arg] in the filterable_data or
+      /// the variable_header of the event; fails if there is none.
+      PUSH_FILTERABLE_DATA,
+      PUSH_VARIABLE_HEADER,
+
+      /// Evaluate nodes_[arg] with the visitor and push the result.
+      VISIT,
+
+      /// Replace the operand by true (the "exist" operator: the
+      /// instructions for the operand fail if it does not exist).
+      EXIST,
+
+      /// Unary operators.
+      NOT,
+      NEGATE,
+
+      /// Binary operators, replacing the two operands by the result.
+      LT,
+      LE,
+      GT,
+      GE,
+      EQ,
+      NE,
+      ADD,
+      SUBTRACT,
+      MULTIPLY,
+      DIVIDE,
+      TWIDDLE,
+
+      /// Pop the operand; if it is true (OR_ELSE) or false (AND_THEN)
+      /// push it back as a boolean and jump to code_[arg].
+      OR_ELSE,
+      AND_THEN,
+
+      /// Replace the operand by its boolean value.
+      TO_BOOLEAN
+    };
+
+  struct Instruction
+  {
+    Opcode op_;
+    CORBA::ULong arg_;
+  };
+
+  /// Append an instruction and keep track of the stack depth.
+  CORBA::ULong emit (Opcode op, CORBA::ULong arg = 0);
+
+  /// Find the predicates of the expression tree rooted at @a node.
+  /// Returns false if it has none.
+  static bool find_predicates (ETCL_Constraint *node, Predicates &result);
+
+  /// Compile @a node, and if it is an event value that a predicate can
+  /// test, or a literal, set the corresponding members of
+  /// @a predicate.  Returns 0 for an event value, 1 for a literal and
+  /// -1 otherwise.
+  static int operand (ETCL_Constraint *node, Predicate &predicate);
+
+  /// The instructions.
+  ACE_Vector<Instruction, 16> code_;
+
+  /// The literals of the constraint.
+  ACE_Vector<TAO_ETCL_Literal_Constraint, 4> literals_;
+
+  /// The names of the event values the constraint refers to.
+  ACE_Vector<ACE_CString, 4> names_;
+
+  /// The parts of the expression tree evaluated by the visitor.
+  ACE_Vector<ETCL_Constraint *, 2> nodes_;
+
+  /// Current and maximum depth of the operand stack.
+  size_t depth_;
+  size_t max_depth_;
+
+  /// The predicates of the constraint, if it has_predicates_.
+  Predicates predicates_;
+  bool has_predicates_;
+};
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#include /**/ "ace/post.h"
+#endif /* TAO_NOTIFY_CONSTRAINT_PROGRAM_H */
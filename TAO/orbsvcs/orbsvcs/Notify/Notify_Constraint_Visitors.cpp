@@ -135,6 +135,23 @@ TAO_Notify_Constraint_Visitor::evaluate_constraint (ETCL_Constraint* root)
   return result;
 }
 
+int
+TAO_Notify_Constraint_Visitor::evaluate_value (
+    ETCL_Constraint *root,
+    TAO_ETCL_Literal_Constraint &result)
+{
+  this->queue_.reset ();
+
+  if (root != 0
+      && root->accept (this) == 0
+      && this->queue_.dequeue_head (result) == 0)
+    {
+      return 0;
+    }
+
+  return -1;
+}
+
 int
 TAO_Notify_Constraint_Visitor::visit_literal (
     ETCL_Literal_Constraint *literal
@@ -1100,9 +1117,12 @@ TAO_Notify_Constraint_Visitor::visit_twiddle (ETCL_Binary_Expr *binary)
         {
           TAO_ETCL_Literal_Constraint right;
           this->queue_.dequeue_head (right);
+          // An operand that is not a string is a substring of nothing.
+          const char *left_string = left;
+          const char *right_string = right;
           CORBA::Boolean result =
-            (ACE_OS::strstr ((const char *) right,
-                             (const char *) left) != 0);
+            left_string != 0 && right_string != 0
+            && ACE_OS::strstr (right_string, left_string) != 0;
           this->queue_.enqueue_head (TAO_ETCL_Literal_Constraint (result));
           return_value = 0;
         }
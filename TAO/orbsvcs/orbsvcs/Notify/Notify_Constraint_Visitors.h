@@ -52,6 +52,14 @@ public:
    */
   CORBA::Boolean evaluate_constraint (ETCL_Constraint *root);
 
+  /**
+   * Evaluates the expression tree rooted at @a root, which need not
+   * be boolean, and stores its value in @a result.  Returns -1 if an
+   * error occurs during the traversal.
+   */
+  int evaluate_value (ETCL_Constraint *root,
+                      TAO_ETCL_Literal_Constraint &result);
+
   // The overridden methods.
   virtual int visit_literal (ETCL_Literal_Constraint *);
   virtual int visit_identifier (ETCL_Identifier *);
@@ -18,6 +18,8 @@ TAO_Notify_Properties::TAO_Notify_Properties (void)
   , allow_reconnect_ (false)
   , validate_client_ (false)
   , separate_dispatching_orb_ (false)
+  , structured_batching_ (false)
+  , adaptive_batching_ (false)
   , updates_ (1)
   , defaultConsumerAdminFilterOp_ (CosNotifyChannelAdmin::OR_OP)
   , defaultSupplierAdminFilterOp_ (CosNotifyChannelAdmin::OR_OP)
@@ -82,6 +82,15 @@ public:
   bool separate_dispatching_orb (void);
   void separate_dispatching_orb (bool b);
 
+  // Push batches of structured events to the structured push consumers
+  // that are also sequence push consumers.
+  bool structured_batching (void);
+  void structured_batching (bool b);
+
+  // Adapt the size of the batches pushed to consumers to their backlog.
+  bool adaptive_batching (void);
+  void adaptive_batching (bool b);
+
   // The QoS Property that must be applied to each newly created Event Channel
   const CosNotification::QoSProperties& default_event_channel_qos_properties (void);
 
@@ -146,6 +155,12 @@ protected:
   /// True is separate dispatching orb
   bool separate_dispatching_orb_;
 
+  /// True if structured events are batched for sequence consumers.
+  bool structured_batching_;
+
+  /// True if the batches follow the backlog of the consumers.
+  bool adaptive_batching_;
+
   /// True if updates are enabled (default).
   CORBA::Boolean updates_;
 
@@ -134,6 +134,30 @@ TAO_Notify_Properties::separate_dispatching_orb (bool b)
   this->separate_dispatching_orb_ = b;
 }
 
+ACE_INLINE bool
+TAO_Notify_Properties::structured_batching (void)
+{
+  return this->structured_batching_;
+}
+
+ACE_INLINE void
+TAO_Notify_Properties::structured_batching (bool b)
+{
+  this->structured_batching_ = b;
+}
+
+ACE_INLINE bool
+TAO_Notify_Properties::adaptive_batching (void)
+{
+  return this->adaptive_batching_;
+}
+
+ACE_INLINE void
+TAO_Notify_Properties::adaptive_batching (bool b)
+{
+  this->adaptive_batching_ = b;
+}
+
 ACE_INLINE CORBA::Boolean
 TAO_Notify_Properties::updates (void)
 {
@@ -68,6 +68,14 @@ public:
       TAO_Notify_FilterAdmin& parent_filter_admin,
       CosNotifyChannelAdmin::InterFilterGroupOperator filter_operator);
 
+  /// Returns false if an event whose candidate filters are
+  /// @a candidates cannot pass the admin and proxy filters, in which
+  /// case check_filters() would fail for it.
+  CORBA::Boolean may_pass_filters (
+      const TAO_Notify_Subscription_Index::Candidates &candidates,
+      TAO_Notify_FilterAdmin& parent_filter_admin,
+      CosNotifyChannelAdmin::InterFilterGroupOperator filter_operator);
+
   /// Inform this proxy that the following types are being advertised.
   void types_changed (const TAO_Notify_EventTypeSeq& added,
                       const TAO_Notify_EventTypeSeq& removed);
@@ -30,4 +30,23 @@ TAO_Notify_Proxy::check_filters (const TAO_Notify_Event* event
   return val;
 }
 
+ACE_INLINE CORBA::Boolean
+TAO_Notify_Proxy::may_pass_filters (
+  const TAO_Notify_Subscription_Index::Candidates &candidates
+  , TAO_Notify_FilterAdmin& parent_filter_admin
+  , CosNotifyChannelAdmin::InterFilterGroupOperator filter_operator)
+{
+  CORBA::Boolean const parent_val =
+    parent_filter_admin.may_match (candidates);
+
+  if (filter_operator == CosNotifyChannelAdmin::AND_OP)
+    {
+      return parent_val && this->filter_admin_.may_match (candidates);
+    }
+  else
+    {
+      return parent_val || this->filter_admin_.may_match (candidates);
+    }
+}
+
 TAO_END_VERSIONED_NAMESPACE_DECL
@@ -40,9 +40,9 @@ class Persistent_Callback;
 /**
  * \brief Manage interaction between Routing_Slip and persistent storage.
  *
- * todo: to complete the strategization of event persistent storage this
- * should become an interface that is implemented differently by different
- * strategies.  For now it interacts with Standard_Event_Persistence.
+ * This implementation interacts with Standard_Event_Persistence.  The
+ * methods used by Routing_Slip are virtual so that other strategies
+ * (see WAL_Event_Persistence) can provide their own managers.
  */
 class TAO_Notify_Serv_Export Routing_Slip_Persistence_Manager
 {
@@ -60,13 +60,13 @@ public:
   Routing_Slip_Persistence_Manager(Standard_Event_Persistence_Factory* factory);
 
   /// The destructor.
-  ~Routing_Slip_Persistence_Manager();
+  virtual ~Routing_Slip_Persistence_Manager();
 
   /// Set up callbacks
-  void set_callback(Persistent_Callback* callback);
+  virtual void set_callback(Persistent_Callback* callback);
 
   /// Store an event + routing slip.
-  bool store(const ACE_Message_Block& event,
+  virtual bool store(const ACE_Message_Block& event,
     const ACE_Message_Block& routing_slip);
 
   /// \brief Update the routing slip.
@@ -74,11 +74,11 @@ public:
   /// We must always overwrite the first block
   /// last, and it may not chance.  Other blocks should be freed and
   /// reallocated.
-  bool update(const ACE_Message_Block& routing_slip);
+  virtual bool update(const ACE_Message_Block& routing_slip);
 
   /// \brief Remove our associated event and routing slip from the
   /// Persistent_File_Allocator.
-  bool remove();
+  virtual bool remove();
 
   /////////////////////////////////////////
   // Methods to be used during reload only.
@@ -89,14 +89,15 @@ public:
   /// Caller owns the resulting message blocks and is responsible
   /// for deleting them.
   /// Reload the event and routing_slip from the Persistent_File_Allocator.
-  bool reload(ACE_Message_Block*& event, ACE_Message_Block*&routing_slip);
+  virtual bool reload(ACE_Message_Block*& event,
+    ACE_Message_Block*& routing_slip);
 
   /// \brief Get next RSPM during reload.
   ///
   /// After using the data from the reload method, call this
   /// method to get the next RSPM.  It returns a null pointer
   /// when all persistent events have been reloaded.
-  Routing_Slip_Persistence_Manager * load_next ();
+  virtual Routing_Slip_Persistence_Manager * load_next ();
 
   /////////////////////////
   // Implementation methods.
@@ -116,6 +117,11 @@ public:
   /// \brief During cleanup for shut down, release all chained RSPMs.
   void release_all ();
 
+protected:
+  /// Constructor for the managers of other strategies, which do not
+  /// use a Standard_Event_Persistence_Factory.
+  Routing_Slip_Persistence_Manager();
+
 private:
   /**
    * \brief private: Storage for header information of all persistent block.
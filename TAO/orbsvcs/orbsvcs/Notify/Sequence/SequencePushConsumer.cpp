@@ -97,167 +97,7 @@ bool
 TAO_Notify_SequencePushConsumer::dispatch_from_queue (Request_Queue& requests, ACE_Guard <TAO_SYNCH_MUTEX> & ace_mon)
 // FUZZ: enable check_for_ACE_Guard
 {
-  bool result = true;
-  if (DEBUG_LEVEL > 0)
-  {
-    ORBSVCS_DEBUG ( (LM_DEBUG,
-      ACE_TEXT ("(%P|%t) SequencePushConsumer dispatch queued requests. queue size:%u\n"),
-      requests.size ()));
-  }
-
-  CORBA::ULong queue_size = ACE_Utils::truncate_cast<CORBA::ULong> (requests.size ());
-  CORBA::Long max_batch_size = queue_size;
-  if (this->max_batch_size_.is_valid () )
-  {
-    max_batch_size = this->max_batch_size_.value ();
-  }
-  CORBA::Long batch_size = queue_size;
-  if (batch_size > max_batch_size)
-  {
-    batch_size = max_batch_size;
-  }
-  if (batch_size > 0)
-  {
-    CosNotification::EventBatch batch (batch_size);
-    batch.length (batch_size);
-
-    Request_Queue completed;
-
-    CORBA::Long pos = 0;
-    TAO_Notify_Method_Request_Event_Queueable * request = 0;
-    while (pos < batch_size && requests.dequeue_head (request) == 0)
-    {
-      if (DEBUG_LEVEL > 0)
-      {
-        ORBSVCS_DEBUG ( (LM_DEBUG,
-          ACE_TEXT ("(%P|%t) Sequence Dispatch Method_Request_Dispatch @%@\n"),
-          request));
-      }
-
-      const TAO_Notify_Event * ev = request->event ();
-      ev->convert (batch [pos]);
-      ++pos;
-
-      // note enqueue at head, use queue as stack.
-      completed.enqueue_head (request);
-    }
-    batch.length (pos);
-    ACE_ASSERT (pos > 0);
-
-    ace_mon.release ();
-    bool from_timeout = false;
-    TAO_Notify_Consumer::DispatchStatus status =
-      this->dispatch_batch (batch);
-    ace_mon.acquire ();
-    switch (status)
-    {
-    case DISPATCH_SUCCESS:
-      {
-        TAO_Notify_Method_Request_Event_Queueable * request = 0;
-        while (completed.dequeue_head (request) == 0)
-        {
-          request->complete ();
-          request->release ();
-        }
-        result = true;
-        break;
-      }
-    case DISPATCH_FAIL_TIMEOUT:
-      from_timeout = true;
-      // Fall through
-    case DISPATCH_FAIL:
-      {
-        TAO_Notify_Method_Request_Event_Queueable * request = 0;
-        while (completed.dequeue_head (request) == 0)
-        {
-          if (request->should_retry ())
-          {
-            if (DEBUG_LEVEL > 0)
-              ORBSVCS_DEBUG ((LM_DEBUG, ACE_TEXT ("(%P|%t) Consumer %d: Will retry %d\n"),
-                          static_cast <int> (this->proxy ()->id ()),
-                          request->sequence ()));
-            requests.enqueue_head (request);
-            result = false;
-          }
-          else
-          {
-            if (DEBUG_LEVEL > 0)
-              ORBSVCS_DEBUG ((LM_DEBUG, ACE_TEXT ("(%P|%t) Consumer %d: Discarding %d\n"),
-                          static_cast<int> (this->proxy ()->id ()),
-                          request->sequence ()));
-            request->complete ();
-            request->release ();
-          }
-        }
-        while (requests.dequeue_head (request) == 0)
-        {
-          if (request->should_retry ())
-          {
-            if (DEBUG_LEVEL > 0)
-              ORBSVCS_DEBUG ((LM_DEBUG, ACE_TEXT ("(%P|%t) Consumer %d: Will retry %d\n"),
-                          static_cast<int> (this->proxy ()->id ()),
-                          request->sequence ()));
-            requests.enqueue_head (request);
-            result = false;
-          }
-          else
-          {
-            if (DEBUG_LEVEL > 0)
-              ORBSVCS_DEBUG ((LM_DEBUG, ACE_TEXT ("(%P|%t) Consumer %d: Discarding %d\n"),
-                          static_cast<int> (this->proxy ()->id ()),
-                          request->sequence ()));
-            request->complete ();
-            request->release ();
-          }
-        }
-        ace_mon.release();
-        try
-        {
-          this->proxy_supplier ()->destroy (from_timeout);
-        }
-        catch (const CORBA::Exception&)
-        {
-          // todo is there something meaningful we can do here?
-          ;
-        }
-        ace_mon.acquire();
-        break;
-      }
-    case DISPATCH_RETRY:
-    case DISPATCH_DISCARD:
-      {
-        TAO_Notify_Method_Request_Event_Queueable *  request = 0;
-        while (completed.dequeue_head (request) == 0)
-        {
-          if (request->should_retry ())
-          {
-            if (DEBUG_LEVEL > 0)
-              ORBSVCS_DEBUG ((LM_DEBUG, ACE_TEXT ("(%P|%t) Consumer %d: Will retry %d\n"),
-                          static_cast<int> (this->proxy ()->id ()),
-                          request->sequence ()));
-            requests.enqueue_head (request);
-            result = false;
-          }
-          else
-          {
-            if (DEBUG_LEVEL > 0)
-              ORBSVCS_DEBUG ((LM_DEBUG, ACE_TEXT ("(%P|%t) Consumer %d: Discarding %d\n"),
-                          static_cast<int> (this->proxy ()->id ()),
-                          request->sequence ()));
-            request->complete ();
-            request->release ();
-          }
-        }
-        break;
-      }
-    default:
-      {
-        result = false;
-        break;
-      }
-    }
-  }
-  return result;
+  return this->dispatch_batch_from_queue (requests, ace_mon);
 }
 
 bool
@@ -266,19 +106,7 @@ TAO_Notify_SequencePushConsumer::enqueue_if_necessary (
 {
   if (DEBUG_LEVEL > 0)
     ORBSVCS_DEBUG ( (LM_DEBUG, "SequencePushConsumer enqueing event.\n"));
-  this->enqueue_request (request);
-
-  size_t mbs = static_cast<size_t>(this->max_batch_size_.value());
-
-  if (this->pending_events().size() >= mbs || this->pacing_.is_valid () == 0)
-  {
-    this->dispatch_pending ();
-  }
-  else
-  {
-    schedule_timer (false);
-  }
-  return true;
+  return this->enqueue_batch (request);
 }
 
 
@@ -72,6 +72,12 @@ TAO_Notify_StructuredEvent_No_Copy::do_match (CosNotifyFilter::Filter_ptr filter
   return filter->match_structured (*this->notification_);
 }
 
+const CosNotification::StructuredEvent*
+TAO_Notify_StructuredEvent_No_Copy::structured_event (void) const
+{
+  return this->notification_;
+}
+
 void
 TAO_Notify_StructuredEvent_No_Copy::convert (CosNotification::StructuredEvent& notification) const
 {
@@ -42,6 +42,8 @@ public:
 
   CORBA::Boolean do_match (CosNotifyFilter::Filter_ptr filter) const;
 
+  virtual const CosNotification::StructuredEvent* structured_event (void) const;
+
   /// Convert to CosNotification::Structured type
   virtual void convert (CosNotification::StructuredEvent& notification) const;
 
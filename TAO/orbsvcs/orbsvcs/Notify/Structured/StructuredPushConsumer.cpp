@@ -70,6 +70,50 @@ TAO_Notify_StructuredPushConsumer::init (CosNotifyComm::StructuredPushConsumer_p
           // _narrow failed
         }
     }
+
+  // With -StructuredBatching, the events are pushed in batches to the
+  // consumers that also accept them.
+  if (TAO_Notify_PROPERTIES::instance()->structured_batching ()
+      && !CORBA::is_nil (this->push_consumer_.in ()))
+    {
+      try
+        {
+          if (this->push_consumer_->_is_a (
+                "IDL:omg.org/CosNotifyComm/SequencePushConsumer:1.0"))
+            {
+              this->sequence_consumer_ =
+                CosNotifyComm::SequencePushConsumer::_unchecked_narrow (
+                  this->push_consumer_.in ());
+            }
+        }
+      catch (const CORBA::Exception&)
+        {
+          // Push the events one by one.
+        }
+    }
+}
+
+bool
+TAO_Notify_StructuredPushConsumer::enqueue_if_necessary (
+  TAO_Notify_Method_Request_Event * request)
+{
+  if (CORBA::is_nil (this->sequence_consumer_.in ()))
+    return TAO_Notify_Consumer::enqueue_if_necessary (request);
+
+  return this->enqueue_batch (request);
+}
+
+// FUZZ: disable check_for_ACE_Guard
+bool
+TAO_Notify_StructuredPushConsumer::dispatch_from_queue (
+  Request_Queue & requests,
+  ACE_Guard <TAO_SYNCH_MUTEX> & ace_mon)
+// FUZZ: enable check_for_ACE_Guard
+{
+  if (CORBA::is_nil (this->sequence_consumer_.in ()))
+    return TAO_Notify_Consumer::dispatch_from_queue (requests, ace_mon);
+
+  return this->dispatch_batch_from_queue (requests, ace_mon);
 }
 
 void
@@ -146,9 +190,16 @@ TAO_Notify_StructuredPushConsumer::push (const CosNotification::StructuredEvent&
 void
 TAO_Notify_StructuredPushConsumer::push (const CosNotification::EventBatch& event)
 {
-  ACE_ASSERT(false);
-  ACE_UNUSED_ARG (event);
-  // TODO exception?
+  if (CORBA::is_nil (this->sequence_consumer_.in ()))
+    {
+      ACE_ASSERT(false);
+      // TODO exception?
+      return;
+    }
+
+  last_ping_ = ACE_OS::gettimeofday ();
+
+  this->sequence_consumer_->push_structured_events (event);
 }
 
 void
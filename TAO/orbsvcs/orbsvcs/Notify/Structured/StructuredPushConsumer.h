@@ -64,9 +64,23 @@ protected:
 
   virtual CORBA::Object_ptr get_consumer (void);
 
+  /// Queue the events to push them in batches, if the consumer is also
+  /// a sequence push consumer.
+  virtual bool enqueue_if_necessary (
+    TAO_Notify_Method_Request_Event * request);
+
+// FUZZ: disable check_for_ACE_Guard
+  virtual bool dispatch_from_queue (
+    Request_Queue & requests,
+    ACE_Guard <TAO_SYNCH_MUTEX> & ace_mon);
+// FUZZ: enable check_for_ACE_Guard
+
   /// The Consumer
   CosNotifyComm::StructuredPushConsumer_var push_consumer_;
 
+  /// The Consumer, if the events are pushed to it in batches.
+  CosNotifyComm::SequencePushConsumer_var sequence_consumer_;
+
 private:
   /// Release
   virtual void release (void);
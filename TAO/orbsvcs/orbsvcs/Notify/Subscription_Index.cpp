@@ -0,0 +1,568 @@
+#include "orbsvcs/Notify/Subscription_Index.h"
+
+#include "ace/Guard_T.h"
+#include "ace/OS_NS_string.h"
+
+#include <algorithm>
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace
+{
+  /// Orders the numeric bounds.
+  struct Value_Less
+  {
+    template <typename Bound>
+    bool operator() (const Bound &lhs, const Bound &rhs) const
+    {
+      return lhs.value_ < rhs.value_;
+    }
+
+    template <typename Bound>
+    bool operator() (const Bound &lhs, CORBA::Double rhs) const
+    {
+      return lhs.value_ < rhs;
+    }
+
+    template <typename Bound>
+    bool operator() (CORBA::Double lhs, const Bound &rhs) const
+    {
+      return lhs < rhs.value_;
+    }
+  };
+
+  /// Orders the string literals.
+  struct String_Less
+  {
+    template <typename Bound>
+    bool operator() (const Bound &lhs, const Bound &rhs) const
+    {
+      return ACE_OS::strcmp (lhs.string_, rhs.string_) < 0;
+    }
+
+    template <typename Bound>
+    bool operator() (const Bound &lhs, const char *rhs) const
+    {
+      return ACE_OS::strcmp (lhs.string_, rhs) < 0;
+    }
+
+    template <typename Bound>
+    bool operator() (const char *lhs, const Bound &rhs) const
+    {
+      return ACE_OS::strcmp (lhs, rhs.string_) < 0;
+    }
+  };
+}
+
+TAO_Notify_Subscription_Index::Candidates::Candidates (void)
+  : all_ (true)
+{
+}
+
+bool
+TAO_Notify_Subscription_Index::Candidates::contains (CORBA::ULong slot) const
+{
+  size_t const word = slot / 32;
+
+  return this->all_
+    || (word < this->bits_.size ()
+        && (this->bits_[word] & (1u << (slot % 32))) != 0);
+}
+
+void
+TAO_Notify_Subscription_Index::Candidates::insert (CORBA::ULong slot)
+{
+  size_t const word = slot / 32;
+
+  if (word >= this->bits_.size ())
+    {
+      this->bits_.resize (word + 1, 0);
+    }
+
+  this->bits_[word] |= (1u << (slot % 32));
+}
+
+/******************************************************************/
+
+TAO_Notify_Subscription_Index::TAO_Notify_Subscription_Index (void)
+  : guarded_ (0),
+    dirty_ (false)
+{
+  this->unguarded_.all_ = false;
+}
+
+TAO_Notify_Subscription_Index::~TAO_Notify_Subscription_Index (void)
+{
+  this->clear ();
+
+  for (size_t i = 0; i < this->slots_.size (); ++i)
+    {
+      delete this->slots_[i];
+    }
+}
+
+CORBA::ULong
+TAO_Notify_Subscription_Index::add (TAO_Notify_Object::ID id)
+{
+  Slot *slot = 0;
+  ACE_NEW_THROW_EX (slot,
+                    Slot,
+                    CORBA::NO_MEMORY ());
+  slot->id_ = id;
+  slot->guarded_ = false;
+
+  ACE_WRITE_GUARD_RETURN (TAO_SYNCH_RW_MUTEX, guard, this->lock_, 0);
+
+  this->dirty_ = true;
+
+  for (size_t i = 0; i < this->slots_.size (); ++i)
+    {
+      if (this->slots_[i] == 0)
+        {
+          this->slots_[i] = slot;
+          return static_cast<CORBA::ULong> (i);
+        }
+    }
+
+  this->slots_.push_back (slot);
+  return static_cast<CORBA::ULong> (this->slots_.size () - 1);
+}
+
+void
+TAO_Notify_Subscription_Index::remove (CORBA::ULong slot)
+{
+  ACE_WRITE_GUARD (TAO_SYNCH_RW_MUTEX, guard, this->lock_);
+
+  if (slot >= this->slots_.size () || this->slots_[slot] == 0)
+    {
+      return;
+    }
+
+  if (this->slots_[slot]->guarded_)
+    {
+      --this->guarded_;
+    }
+
+  delete this->slots_[slot];
+  this->slots_[slot] = 0;
+  this->dirty_ = true;
+}
+
+int
+TAO_Notify_Subscription_Index::find (TAO_Notify_Object::ID id,
+                                     CORBA::ULong &slot)
+{
+  ACE_READ_GUARD_RETURN (TAO_SYNCH_RW_MUTEX, guard, this->lock_, -1);
+
+  for (size_t i = 0; i < this->slots_.size (); ++i)
+    {
+      if (this->slots_[i] != 0 && this->slots_[i]->id_ == id)
+        {
+          slot = static_cast<CORBA::ULong> (i);
+          return 0;
+        }
+    }
+
+  return -1;
+}
+
+void
+TAO_Notify_Subscription_Index::guard (CORBA::ULong slot,
+                                      const Predicates &predicates)
+{
+  for (size_t i = 0; i < predicates.size (); ++i)
+    {
+      if (!TAO_Notify_Subscription_Index::indexable (predicates[i]))
+        {
+          this->unguard (slot);
+          return;
+        }
+    }
+
+  ACE_WRITE_GUARD (TAO_SYNCH_RW_MUTEX, guard, this->lock_);
+
+  if (slot >= this->slots_.size () || this->slots_[slot] == 0)
+    {
+      return;
+    }
+
+  Slot &filter = *this->slots_[slot];
+
+  filter.predicates_.clear ();
+
+  for (size_t i = 0; i < predicates.size (); ++i)
+    {
+      filter.predicates_.push_back (predicates[i]);
+    }
+
+  if (!filter.guarded_)
+    {
+      filter.guarded_ = true;
+      ++this->guarded_;
+    }
+
+  this->dirty_ = true;
+}
+
+void
+TAO_Notify_Subscription_Index::unguard (CORBA::ULong slot)
+{
+  ACE_WRITE_GUARD (TAO_SYNCH_RW_MUTEX, guard, this->lock_);
+
+  if (slot >= this->slots_.size ()
+      || this->slots_[slot] == 0
+      || !this->slots_[slot]->guarded_)
+    {
+      return;
+    }
+
+  this->slots_[slot]->guarded_ = false;
+  this->slots_[slot]->predicates_.clear ();
+  --this->guarded_;
+  this->dirty_ = true;
+}
+
+bool
+TAO_Notify_Subscription_Index::empty (void)
+{
+  ACE_READ_GUARD_RETURN (TAO_SYNCH_RW_MUTEX, guard, this->lock_, true);
+
+  return this->guarded_ == 0;
+}
+
+void
+TAO_Notify_Subscription_Index::candidates (
+    const CosNotification::StructuredEvent &event,
+    Candidates &candidates)
+{
+  // If a lock cannot be taken, the candidates are left alone: all the
+  // filters are candidates.
+  {
+    ACE_READ_GUARD (TAO_SYNCH_RW_MUTEX, guard, this->lock_);
+
+    if (!this->dirty_)
+      {
+        this->candidates_i (event, candidates);
+        return;
+      }
+  }
+
+  ACE_WRITE_GUARD (TAO_SYNCH_RW_MUTEX, guard, this->lock_);
+
+  if (this->dirty_ && this->rebuild () != 0)
+    {
+      return;
+    }
+
+  this->candidates_i (event, candidates);
+}
+
+bool
+TAO_Notify_Subscription_Index::indexable (const Predicate &predicate)
+{
+  switch (Program::literal_class (predicate.literal_))
+    {
+    case Program::STRING_LITERAL:
+    case Program::BOOLEAN_LITERAL:
+      // Only the equalities are sorted.
+      return predicate.comparison_ == Program::EQUAL;
+    case Program::DOUBLE_LITERAL:
+    case Program::UNSIGNED_LITERAL:
+    case Program::SIGNED_LITERAL:
+      return true;
+    default:
+      return false;
+    }
+}
+
+void
+TAO_Notify_Subscription_Index::clear (void)
+{
+  for (size_t i = 0; i < this->groups_.size (); ++i)
+    {
+      delete this->groups_[i];
+    }
+
+  this->groups_.clear ();
+}
+
+int
+TAO_Notify_Subscription_Index::rebuild (void)
+{
+  this->clear ();
+  this->unguarded_.bits_.clear ();
+
+  for (size_t i = 0; i < this->slots_.size (); ++i)
+    {
+      const Slot *filter = this->slots_[i];
+      CORBA::ULong const slot = static_cast<CORBA::ULong> (i);
+
+      if (filter == 0)
+        {
+          continue;
+        }
+
+      if (!filter->guarded_)
+        {
+          this->unguarded_.insert (slot);
+          continue;
+        }
+
+      for (size_t p = 0; p < filter->predicates_.size (); ++p)
+        {
+          const Predicate &predicate = filter->predicates_[p];
+          Group *group = 0;
+
+          for (size_t g = 0; group == 0 && g < this->groups_.size (); ++g)
+            {
+              if (this->groups_[g]->value_ == predicate.value_
+                  && this->groups_[g]->name_ == predicate.name_)
+                {
+                  group = this->groups_[g];
+                }
+            }
+
+          if (group == 0)
+            {
+              ACE_NEW_RETURN (group, Group, -1);
+              group->value_ = predicate.value_;
+              group->name_ = predicate.name_;
+              this->groups_.push_back (group);
+            }
+
+          int const literal_class =
+            Program::literal_class (predicate.literal_);
+
+          Entry const entry = { &predicate, slot };
+          group->entries_[literal_class].push_back (entry);
+
+          // The bounds are sorted by the comparison of the event value
+          // with them.
+          int comparison = predicate.comparison_;
+
+          if (predicate.reversed_)
+            {
+              switch (predicate.comparison_)
+                {
+                case Program::LESS:
+                  comparison = Program::GREATER;
+                  break;
+                case Program::LESS_EQUAL:
+                  comparison = Program::GREATER_EQUAL;
+                  break;
+                case Program::GREATER:
+                  comparison = Program::LESS;
+                  break;
+                case Program::GREATER_EQUAL:
+                  comparison = Program::LESS_EQUAL;
+                  break;
+                default:
+                  break;
+                }
+            }
+
+          Bound bound = { 0.0, 0, slot };
+
+          switch (literal_class)
+            {
+            case Program::STRING_LITERAL:
+              bound.string_ = static_cast<const char *> (predicate.literal_);
+              break;
+            case Program::DOUBLE_LITERAL:
+              bound.value_ = static_cast<CORBA::Double> (predicate.literal_);
+              break;
+            case Program::UNSIGNED_LITERAL:
+              bound.value_ = static_cast<CORBA::ULong> (predicate.literal_);
+              break;
+            case Program::SIGNED_LITERAL:
+              bound.value_ = static_cast<CORBA::Long> (predicate.literal_);
+              break;
+            case Program::BOOLEAN_LITERAL:
+              bound.value_ =
+                static_cast<CORBA::Boolean> (predicate.literal_) ? 1.0 : 0.0;
+              break;
+            }
+
+          group->bounds_[literal_class][comparison].push_back (bound);
+        }
+    }
+
+  for (size_t g = 0; g < this->groups_.size (); ++g)
+    {
+      Group &group = *this->groups_[g];
+
+      for (int c = 0; c < LITERAL_CLASSES; ++c)
+        {
+          for (int comparison = 0; comparison < COMPARISONS; ++comparison)
+            {
+              Bounds &bounds = group.bounds_[c][comparison];
+              Bound *begin = bounds.begin ();
+
+              if (c == Program::STRING_LITERAL)
+                {
+                  std::sort (begin, begin + bounds.size (), String_Less ());
+                }
+              else
+                {
+                  std::sort (begin, begin + bounds.size (), Value_Less ());
+                }
+            }
+        }
+    }
+
+  this->dirty_ = false;
+  return 0;
+}
+
+void
+TAO_Notify_Subscription_Index::insert (const Bound *first,
+                                       const Bound *last,
+                                       Candidates &candidates)
+{
+  for (; first != last; ++first)
+    {
+      candidates.insert (first->slot_);
+    }
+}
+
+void
+TAO_Notify_Subscription_Index::insert (
+    const Entries &entries,
+    const TAO_ETCL_Literal_Constraint &value,
+    Candidates &candidates)
+{
+  for (size_t i = 0; i < entries.size (); ++i)
+    {
+      if (Program::satisfies (*entries[i].predicate_, value))
+        {
+          candidates.insert (entries[i].slot_);
+        }
+    }
+}
+
+void
+TAO_Notify_Subscription_Index::candidates_i (
+    const CosNotification::StructuredEvent &event,
+    Candidates &candidates) const
+{
+  candidates = this->unguarded_;
+
+  TAO_ETCL_Literal_Constraint value;
+
+  for (size_t g = 0; g < this->groups_.size (); ++g)
+    {
+      const Group &group = *this->groups_[g];
+
+      // No predicate on a value that the event does not have can be
+      // satisfied.
+      if (!Program::value (event,
+                           group.value_,
+                           group.name_.c_str (),
+                           value))
+        {
+          continue;
+        }
+
+      int const value_class = Program::literal_class (value);
+
+      CORBA::Double const number =
+        value_class == Program::OTHER_LITERAL
+        ? 0.0
+        : static_cast<CORBA::Double> (value);
+      bool const nan =
+        value_class == Program::DOUBLE_LITERAL && number != number;
+
+      for (int c = 0; c < LITERAL_CLASSES; ++c)
+        {
+          if (value_class == Program::OTHER_LITERAL
+              || nan
+              || c < value_class)
+            {
+              // The literals would be converted to the type of the
+              // value, or the value is not compared like a literal:
+              // compare them one by one, like the constraint does.
+              TAO_Notify_Subscription_Index::insert (group.entries_[c],
+                                                     value,
+                                                     candidates);
+              continue;
+            }
+
+          // The value is converted to the type of the literals.
+          const Bounds *bounds = group.bounds_[c];
+
+          if (c == Program::STRING_LITERAL)
+            {
+              const Bounds &sorted = bounds[Program::EQUAL];
+              const Bound *begin = sorted.begin ();
+              const Bound *end = begin + sorted.size ();
+              const char *string = value;
+              std::pair<const Bound *, const Bound *> const range =
+                std::equal_range (begin, end, string, String_Less ());
+
+              TAO_Notify_Subscription_Index::insert (range.first,
+                                                     range.second,
+                                                     candidates);
+              continue;
+            }
+
+          CORBA::Double key = 0.0;
+
+          switch (c)
+            {
+            case Program::DOUBLE_LITERAL:
+              key = number;
+              break;
+            case Program::UNSIGNED_LITERAL:
+              key = static_cast<CORBA::ULong> (value);
+              break;
+            case Program::SIGNED_LITERAL:
+              key = static_cast<CORBA::Long> (value);
+              break;
+            case Program::BOOLEAN_LITERAL:
+              key = static_cast<CORBA::Boolean> (value) ? 1.0 : 0.0;
+              break;
+            }
+
+          for (int comparison = 0; comparison < COMPARISONS; ++comparison)
+            {
+              const Bounds &sorted = bounds[comparison];
+
+              if (sorted.size () == 0)
+                {
+                  continue;
+                }
+
+              const Bound *begin = sorted.begin ();
+              const Bound *end = begin + sorted.size ();
+
+              switch (comparison)
+                {
+                case Program::EQUAL:
+                  {
+                    std::pair<const Bound *, const Bound *> const range =
+                      std::equal_range (begin, end, key, Value_Less ());
+                    begin = range.first;
+                    end = range.second;
+                  }
+                  break;
+                case Program::LESS:
+                  begin = std::upper_bound (begin, end, key, Value_Less ());
+                  break;
+                case Program::LESS_EQUAL:
+                  begin = std::lower_bound (begin, end, key, Value_Less ());
+                  break;
+                case Program::GREATER:
+                  end = std::lower_bound (begin, end, key, Value_Less ());
+                  break;
+                case Program::GREATER_EQUAL:
+                  end = std::upper_bound (begin, end, key, Value_Less ());
+                  break;
+                }
+
+              TAO_Notify_Subscription_Index::insert (begin, end, candidates);
+            }
+        }
+    }
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,213 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file   Subscription_Index.h
+ */
+//=============================================================================
+
+#ifndef TAO_NOTIFY_SUBSCRIPTION_INDEX_H
+#define TAO_NOTIFY_SUBSCRIPTION_INDEX_H
+
+#include /**/ "ace/pre.h"
+
+#include "orbsvcs/Notify/notify_serv_export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "orbsvcs/Notify/Notify_Constraint_Program.h"
+#include "orbsvcs/Notify/Object.h"
+
+#include "tao/orbconf.h"
+
+#include "ace/RW_Thread_Mutex.h"
+#include "ace/Vector_T.h"
+#include "ace/Basic_Types.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class TAO_Notify_Subscription_Index
+ *
+ * @brief Finds the filters of an event channel that an event may match.
+ *
+ * An event is checked against the filters of every proxy supplier
+ * and consumer admin it could be delivered to.  With many consumers,
+ * most of these filters compare a few event values ($domain_name,
+ * $type_name, or values of the filterable data and the variable
+ * header) with literals, and each one only matches a small part of
+ * the events.
+ *
+ * The index keeps, in a "slot" for each filter, the predicates of the
+ * constraints of the filter (see
+ * TAO_Notify_Constraint_Program::predicates()).  They are grouped by
+ * the event value they test, with the equalities sorted by literal
+ * and the ranges sorted by bound, so that one lookup of an event
+ * gives the filters it may match, the "candidates".  A filter that is
+ * not a candidate cannot match the event and does not need to be
+ * evaluated; the candidates still are.  A filter that the index
+ * cannot describe is "unguarded", and always is a candidate.
+ */
+class TAO_Notify_Serv_Export TAO_Notify_Subscription_Index
+{
+public:
+  /**
+   * @class Candidates
+   *
+   * @brief The slots of the filters that an event may match.
+   */
+  class Candidates
+  {
+  public:
+    /// Constructor.
+    Candidates (void);
+
+    /// Returns true if the filter in @a slot may match the event.
+    bool contains (CORBA::ULong slot) const;
+
+  private:
+    friend class TAO_Notify_Subscription_Index;
+
+    /// Add @a slot.
+    void insert (CORBA::ULong slot);
+
+    /// Set until the event is looked up: all the filters are
+    /// candidates.
+    bool all_;
+
+    ACE_Vector<ACE_UINT32> bits_;
+  };
+
+  /// Constructor.
+  TAO_Notify_Subscription_Index (void);
+
+  /// Destructor.
+  ~TAO_Notify_Subscription_Index (void);
+
+  /// Give a slot to the filter @a id.  The filter is unguarded.
+  CORBA::ULong add (TAO_Notify_Object::ID id);
+
+  /// Free the slot of a filter.
+  void remove (CORBA::ULong slot);
+
+  /// Find the slot of the filter @a id.  Returns -1 if it has none.
+  int find (TAO_Notify_Object::ID id, CORBA::ULong &slot);
+
+  /// The filter in @a slot can only match the events that satisfy one
+  /// of @a predicates; it matches none if there are none.
+  void guard (CORBA::ULong slot,
+              const TAO_Notify_Constraint_Program::Predicates &predicates);
+
+  /// The filter in @a slot may match any event.
+  void unguard (CORBA::ULong slot);
+
+  /// Returns true if no filter is guarded: then all the filters are
+  /// candidates, and there is no need to look events up.
+  bool empty (void);
+
+  /// Get the filters that @a event may match.
+  void candidates (const CosNotification::StructuredEvent &event,
+                   Candidates &candidates);
+
+private:
+  typedef TAO_Notify_Constraint_Program Program;
+  typedef Program::Predicate Predicate;
+  typedef Program::Predicates Predicates;
+
+  /// A filter.
+  struct Slot
+  {
+    TAO_Notify_Object::ID id_;
+    bool guarded_;
+    Predicates predicates_;
+  };
+
+  enum
+    {
+      LITERAL_CLASSES = Program::OTHER_LITERAL,
+      COMPARISONS = Program::GREATER_EQUAL + 1
+    };
+
+  /// A predicate of the filter in slot_.
+  struct Entry
+  {
+    const Predicate *predicate_;
+    CORBA::ULong slot_;
+  };
+
+  /// A literal of an equality or a bound of a range, converted to a
+  /// double (which holds the signed and unsigned values exactly), or
+  /// the string of an equality.
+  struct Bound
+  {
+    CORBA::Double value_;
+    const char *string_;
+    CORBA::ULong slot_;
+  };
+
+  typedef ACE_Vector<Entry, 4> Entries;
+  typedef ACE_Vector<Bound, 4> Bounds;
+
+  /// The predicates on one event value.
+  struct Group
+  {
+    Program::Value value_;
+    ACE_CString name_;
+
+    /// The predicates, by class of literal.
+    Entries entries_[LITERAL_CLASSES];
+
+    /// The literals of the equalities and the bounds of the ranges, by
+    /// class of literal and by comparison of the event value with the
+    /// bound.
+    Bounds bounds_[LITERAL_CLASSES][COMPARISONS];
+  };
+
+  /// Returns true if the index can look @a predicate up.
+  static bool indexable (const Predicate &predicate);
+
+  /// Rebuild the groups from the slots.  Returns -1 on failure.
+  int rebuild (void);
+
+  /// Look the event up, with the groups up to date.
+  void candidates_i (const CosNotification::StructuredEvent &event,
+                     Candidates &candidates) const;
+
+  /// Add the slots of the bounds in [@a first, @a last).
+  static void insert (const Bound *first,
+                      const Bound *last,
+                      Candidates &candidates);
+
+  /// Add the slots of the @a entries that @a value satisfies.
+  static void insert (const Entries &entries,
+                      const TAO_ETCL_Literal_Constraint &value,
+                      Candidates &candidates);
+
+  /// Delete the groups.
+  void clear (void);
+
+  /// Lock to serialize access to data members.
+  TAO_SYNCH_RW_MUTEX lock_;
+
+  /// The filters, by slot; the free slots are 0.
+  ACE_Vector<Slot *> slots_;
+
+  /// Number of guarded filters.
+  size_t guarded_;
+
+  /// Set when a slot changed since the groups were built.
+  bool dirty_;
+
+  /// The unguarded filters.
+  Candidates unguarded_;
+
+  /// The groups of predicates.
+  ACE_Vector<Group *> groups_;
+};
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#include /**/ "ace/post.h"
+#endif /* TAO_NOTIFY_SUBSCRIPTION_INDEX_H */
@@ -0,0 +1,979 @@
+#include "orbsvcs/Log_Macros.h"
+#include "orbsvcs/Notify/WAL_Event_Persistence.h"
+#include "orbsvcs/Notify/Persistent_File_Allocator.h"
+#include "tao/debug.h"
+#include "ace/ACE.h"
+#include "ace/OS_NS_fcntl.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_strings.h"
+#include "ace/OS_NS_sys_stat.h"
+#include "ace/OS_NS_sys_time.h"
+#include "ace/OS_NS_unistd.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace TAO_Notify
+{
+
+// The log starts with a signature and a version number (1.0).
+static const char WAL_SIGNATURE[] = { 'T', 'N', 'W', 'A', 'L', 0, 1, 0 };
+static const size_t WAL_SIGNATURE_SIZE = sizeof (WAL_SIGNATURE);
+
+// A record is a header followed by the event and the routing slip.
+// The header holds the type (1 byte), the serial number (8 bytes),
+// the sizes of the event and of the routing slip (4 bytes each), and
+// the CRC-32 of the rest of the record (4 bytes), in network order.
+static const size_t RECORD_HEADER_SIZE = 21;
+static const size_t RECORD_CRC_OFFSET = 17;
+
+// Seconds the writer thread waits before it writes a group again after
+// a failed write.
+static const time_t WAL_RETRY_DELAY = 1;
+
+static void
+put_uint32 (char * data, ACE_UINT32 value)
+{
+  data[0] = static_cast<char> ((value >> 24) & 0xff);
+  data[1] = static_cast<char> ((value >> 16) & 0xff);
+  data[2] = static_cast<char> ((value >> 8) & 0xff);
+  data[3] = static_cast<char> (value & 0xff);
+}
+
+static ACE_UINT32
+get_uint32 (const char * data)
+{
+  const unsigned char * p = reinterpret_cast<const unsigned char *> (data);
+  return (ACE_UINT32 (p[0]) << 24) | (ACE_UINT32 (p[1]) << 16)
+    | (ACE_UINT32 (p[2]) << 8) | ACE_UINT32 (p[3]);
+}
+
+static ACE_UINT32
+record_crc (const char * header, const char * event, size_t event_size,
+  const char * routing_slip, size_t routing_slip_size)
+{
+  ACE_UINT32 crc = ACE::crc32 (header, RECORD_CRC_OFFSET);
+  crc = ACE::crc32 (event, event_size, crc);
+  return ACE::crc32 (routing_slip, routing_slip_size, crc);
+}
+
+// Sync the directory of @a filename, which makes a rename to it durable.
+static bool
+sync_directory (const ACE_TString & filename)
+{
+#if defined (ACE_WIN32)
+  ACE_UNUSED_ARG (filename);
+  return true;
+#else
+  ACE_TString::size_type const slash =
+    filename.rfind (ACE_DIRECTORY_SEPARATOR_CHAR);
+  ACE_TString const directory = slash == ACE_TString::npos
+    ? ACE_TString (ACE_TEXT ("."))
+    : (slash == 0 ? filename.substring (0, 1) : filename.substring (0, slash));
+  ACE_HANDLE const handle = ACE_OS::open (directory.c_str (), O_RDONLY);
+  if (handle == ACE_INVALID_HANDLE)
+  {
+    return false;
+  }
+  bool const result = ACE_OS::fsync (handle) == 0;
+  ACE_OS::close (handle);
+  return result;
+#endif /* ACE_WIN32 */
+}
+
+WAL_Routing_Slip_Persistence_Manager::WAL_Routing_Slip_Persistence_Manager (
+  WAL_Event_Persistence_Factory * factory)
+  : factory_ (factory)
+  , serial_number_ (0)
+  , removed_ (false)
+  , callback_ (0)
+  , event_mb_ (0)
+  , routing_slip_mb_ (0)
+{
+}
+
+WAL_Routing_Slip_Persistence_Manager::~WAL_Routing_Slip_Persistence_Manager ()
+{
+  delete this->event_mb_;
+  this->event_mb_ = 0;
+  delete this->routing_slip_mb_;
+  this->routing_slip_mb_ = 0;
+}
+
+void
+WAL_Routing_Slip_Persistence_Manager::set_callback (Persistent_Callback * callback)
+{
+  ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, this->lock_);
+  this->callback_ = callback;
+}
+
+bool
+WAL_Routing_Slip_Persistence_Manager::store (const ACE_Message_Block & event,
+  const ACE_Message_Block & routing_slip)
+{
+  bool result = false;
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, this->lock_, result);
+  if (!this->removed_ && this->serial_number_ == 0)
+  {
+    this->serial_number_ = this->factory_->allocate_serial_number ();
+    result = this->factory_->append (
+      WAL_Event_Persistence_Factory::RT_Store,
+      this->serial_number_,
+      &event,
+      &routing_slip,
+      this->callback_);
+  }
+  return result;
+}
+
+bool
+WAL_Routing_Slip_Persistence_Manager::update (const ACE_Message_Block & routing_slip)
+{
+  bool result = false;
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, this->lock_, result);
+  // If we have not stored the event yet, fail
+  if (!this->removed_ && this->serial_number_ != 0)
+  {
+    result = this->factory_->append (
+      WAL_Event_Persistence_Factory::RT_Update,
+      this->serial_number_,
+      0,
+      &routing_slip,
+      this->callback_);
+  }
+  return result;
+}
+
+bool
+WAL_Routing_Slip_Persistence_Manager::remove ()
+{
+  bool result = false;
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, this->lock_, result);
+  if (!this->removed_ && this->serial_number_ != 0)
+  {
+    this->removed_ = true;
+    result = this->factory_->append (
+      WAL_Event_Persistence_Factory::RT_Remove,
+      this->serial_number_,
+      0,
+      0,
+      this->callback_);
+  }
+  return result;
+}
+
+bool
+WAL_Routing_Slip_Persistence_Manager::reload (
+  ACE_Message_Block *& event,
+  ACE_Message_Block *& routing_slip)
+{
+  bool result = false;
+  if (this->event_mb_ != 0 && this->routing_slip_mb_ != 0)
+  {
+    event = this->event_mb_;
+    this->event_mb_ = 0;
+    routing_slip = this->routing_slip_mb_;
+    this->routing_slip_mb_ = 0;
+    result = true;
+  }
+  else
+  {
+    event = 0;
+    routing_slip = 0;
+  }
+  return result;
+}
+
+Routing_Slip_Persistence_Manager *
+WAL_Routing_Slip_Persistence_Manager::load_next ()
+{
+  return this->factory_->next_reload_manager ();
+}
+
+WAL_Event_Persistence_Factory::WAL_Event_Persistence_Factory ()
+  : handle_ (ACE_INVALID_HANDLE)
+  , checkpoint_size_ (0)
+  , log_size_ (0)
+  , checkpoint_threshold_ (0)
+  , serial_number_ (0)
+  , wake_up_thread_ (queue_lock_)
+  , queue_head_ (0)
+  , queue_tail_ (0)
+  , terminate_thread_ (false)
+  , thread_active_ (false)
+{
+}
+
+WAL_Event_Persistence_Factory::~WAL_Event_Persistence_Factory ()
+{
+  if (TAO_debug_level > 0)
+  {
+    ORBSVCS_DEBUG ((LM_DEBUG,
+      ACE_TEXT ("(%P|%t) WAL_Event_Persistence_Factory::~WAL_Event_Persistence_Factory\n")
+    ));
+  }
+  this->shutdown_thread ();
+  Routing_Slip_Persistence_Manager * rspm = 0;
+  while (this->reload_queue_.dequeue_head (rspm) == 0)
+  {
+    delete rspm;
+  }
+  if (this->handle_ != ACE_INVALID_HANDLE)
+  {
+    ACE_OS::close (this->handle_);
+    this->handle_ = ACE_INVALID_HANDLE;
+  }
+}
+
+bool
+WAL_Event_Persistence_Factory::open (const ACE_TCHAR * filename,
+  ACE_UINT64 checkpoint_size,
+  const ACE_Time_Value & commit_delay)
+{
+  this->filename_ = filename;
+  this->checkpoint_size_ = checkpoint_size;
+  this->commit_delay_ = commit_delay;
+
+  this->handle_ = ACE_OS::open (filename,
+    O_CREAT | O_RDWR | O_BINARY,
+    ACE_DEFAULT_FILE_PERMS);
+  if (this->handle_ == ACE_INVALID_HANDLE)
+  {
+    ORBSVCS_ERROR ((LM_ERROR,
+      ACE_TEXT ("(%P|%t) WAL_Event_Persistence: Cannot open %s: %m\n"),
+      filename
+      ));
+    return false;
+  }
+
+  Live_Map live;
+  ACE_OFF_T end = 0;
+  if (!this->replay (this->handle_, live, end, this->serial_number_))
+  {
+    ORBSVCS_ERROR ((LM_ERROR,
+      ACE_TEXT ("(%P|%t) WAL_Event_Persistence: %s is not an event log.\n"),
+      filename
+      ));
+    release (live);
+    ACE_OS::close (this->handle_);
+    this->handle_ = ACE_INVALID_HANDLE;
+    return false;
+  }
+
+  if (end == 0)
+  {
+    if (ACE::write_n (this->handle_, WAL_SIGNATURE, WAL_SIGNATURE_SIZE)
+          != static_cast<ssize_t> (WAL_SIGNATURE_SIZE)
+        || ACE_OS::fsync (this->handle_) != 0)
+    {
+      ORBSVCS_ERROR ((LM_ERROR,
+        ACE_TEXT ("(%P|%t) WAL_Event_Persistence: Cannot write %s: %m\n"),
+        filename
+        ));
+      ACE_OS::close (this->handle_);
+      this->handle_ = ACE_INVALID_HANDLE;
+      return false;
+    }
+    end = WAL_SIGNATURE_SIZE;
+  }
+  else if (end < ACE_OS::filesize (this->handle_))
+  {
+    // Discard the record that a crash left incomplete.
+    ORBSVCS_DEBUG ((LM_DEBUG,
+      ACE_TEXT ("(%P|%t) WAL_Event_Persistence: Discarding the end of %s after offset %q\n"),
+      filename,
+      static_cast<ACE_INT64> (end)
+      ));
+    ACE_OS::ftruncate (this->handle_, end);
+  }
+  ACE_OS::lseek (this->handle_, end, SEEK_SET);
+  this->log_size_ = static_cast<ACE_UINT64> (end);
+  this->checkpoint_threshold_ =
+    ACE_MAX (this->checkpoint_size_, 2 * this->log_size_);
+
+  // The events still in the log are reloaded in the order they were
+  // stored.
+  Live_Map::ITERATOR iter (live);
+  for (Live_Map::ENTRY * entry = 0; iter.next (entry) != 0; iter.advance ())
+  {
+    WAL_Routing_Slip_Persistence_Manager * rspm = 0;
+    ACE_NEW_NORETURN (rspm, WAL_Routing_Slip_Persistence_Manager (this));
+    if (rspm != 0)
+    {
+      rspm->serial_number_ = entry->key ();
+      rspm->event_mb_ = entry->item ().event;
+      rspm->routing_slip_mb_ = entry->item ().routing_slip;
+      entry->item ().event = 0;
+      entry->item ().routing_slip = 0;
+      this->reload_queue_.enqueue_tail (rspm);
+    }
+  }
+  release (live);
+
+  if (TAO_debug_level > 0)
+  {
+    ORBSVCS_DEBUG ((LM_DEBUG,
+      ACE_TEXT ("(%P|%t) WAL_Event_Persistence: Reloading %B events from %s\n"),
+      this->reload_queue_.size (),
+      filename
+      ));
+  }
+
+  this->thread_active_ = true;
+  if (this->thread_manager_.spawn (this->thr_func, this) == -1)
+  {
+    this->thread_active_ = false;
+    return false;
+  }
+  return true;
+}
+
+Routing_Slip_Persistence_Manager *
+WAL_Event_Persistence_Factory::create_routing_slip_persistence_manager (
+  Persistent_Callback * callback)
+{
+  WAL_Routing_Slip_Persistence_Manager * rspm = 0;
+  ACE_NEW_RETURN (rspm, WAL_Routing_Slip_Persistence_Manager (this), rspm);
+  rspm->set_callback (callback);
+  return rspm;
+}
+
+Routing_Slip_Persistence_Manager *
+WAL_Event_Persistence_Factory::first_reload_manager ()
+{
+  return this->next_reload_manager ();
+}
+
+Routing_Slip_Persistence_Manager *
+WAL_Event_Persistence_Factory::next_reload_manager ()
+{
+  Routing_Slip_Persistence_Manager * result = 0;
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, this->lock_, result);
+  if (this->reload_queue_.dequeue_head (result) != 0)
+  {
+    result = 0;
+  }
+  return result;
+}
+
+ACE_UINT64
+WAL_Event_Persistence_Factory::allocate_serial_number ()
+{
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, this->lock_, 0);
+  return ++this->serial_number_;
+}
+
+bool
+WAL_Event_Persistence_Factory::append (Record_Type type,
+  ACE_UINT64 serial_number,
+  const ACE_Message_Block * event,
+  const ACE_Message_Block * routing_slip,
+  Persistent_Callback * callback)
+{
+  ACE_Message_Block * record =
+    make_record (type, serial_number, event, routing_slip);
+  if (record == 0)
+  {
+    return false;
+  }
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, this->queue_lock_, false);
+  if (!this->thread_active_)
+  {
+    record->release ();
+    return false;
+  }
+  if (this->queue_tail_ != 0)
+  {
+    this->queue_tail_->cont (record);
+  }
+  else
+  {
+    this->queue_head_ = record;
+  }
+  this->queue_tail_ = record;
+  if (callback != 0)
+  {
+    this->callbacks_.enqueue_tail (callback);
+  }
+  this->wake_up_thread_.signal ();
+  return true;
+}
+
+ACE_Message_Block *
+WAL_Event_Persistence_Factory::make_record (Record_Type type,
+  ACE_UINT64 serial_number,
+  const ACE_Message_Block * event,
+  const ACE_Message_Block * routing_slip)
+{
+  size_t const event_size = event != 0 ? event->total_length () : 0;
+  size_t const routing_slip_size =
+    routing_slip != 0 ? routing_slip->total_length () : 0;
+
+  ACE_Message_Block * record = 0;
+  ACE_NEW_RETURN (record,
+    ACE_Message_Block (RECORD_HEADER_SIZE + event_size + routing_slip_size),
+    0);
+
+  char * header = record->wr_ptr ();
+  header[0] = static_cast<char> (type);
+  put_uint32 (header + 1, static_cast<ACE_UINT32> (serial_number >> 32));
+  put_uint32 (header + 5, static_cast<ACE_UINT32> (serial_number & 0xffffffff));
+  put_uint32 (header + 9, static_cast<ACE_UINT32> (event_size));
+  put_uint32 (header + 13, static_cast<ACE_UINT32> (routing_slip_size));
+  record->wr_ptr (RECORD_HEADER_SIZE);
+
+  for (const ACE_Message_Block * mb = event; mb != 0; mb = mb->cont ())
+  {
+    record->copy (mb->rd_ptr (), mb->length ());
+  }
+  for (const ACE_Message_Block * mb = routing_slip; mb != 0; mb = mb->cont ())
+  {
+    record->copy (mb->rd_ptr (), mb->length ());
+  }
+
+  const char * payload = header + RECORD_HEADER_SIZE;
+  put_uint32 (header + RECORD_CRC_OFFSET,
+    record_crc (header, payload, event_size,
+      payload + event_size, routing_slip_size));
+  return record;
+}
+
+bool
+WAL_Event_Persistence_Factory::replay (ACE_HANDLE handle,
+  Live_Map & live,
+  ACE_OFF_T & end,
+  ACE_UINT64 & last_serial_number)
+{
+  /**
+   * NOTE: the log is only replayed while opening it and by the writer
+   *       thread, so there is no need to guard anything.
+   */
+  end = 0;
+  last_serial_number = 0;
+  ACE_OFF_T const file_size = ACE_OS::filesize (handle);
+  if (file_size <= 0)
+  {
+    return file_size == 0;
+  }
+
+  ACE_OS::lseek (handle, 0, SEEK_SET);
+  char signature[WAL_SIGNATURE_SIZE];
+  size_t bytes = 0;
+  ACE::read_n (handle, signature, WAL_SIGNATURE_SIZE, &bytes);
+  if (bytes != WAL_SIGNATURE_SIZE
+      || ACE_OS::memcmp (signature, WAL_SIGNATURE, WAL_SIGNATURE_SIZE) != 0)
+  {
+    return false;
+  }
+  end = WAL_SIGNATURE_SIZE;
+
+  for (;;)
+  {
+    char header[RECORD_HEADER_SIZE];
+    ACE::read_n (handle, header, RECORD_HEADER_SIZE, &bytes);
+    if (bytes != RECORD_HEADER_SIZE)
+    {
+      break;
+    }
+    ACE_UINT64 const serial_number =
+      (ACE_UINT64 (get_uint32 (header + 1)) << 32) | get_uint32 (header + 5);
+    size_t const event_size = get_uint32 (header + 9);
+    size_t const routing_slip_size = get_uint32 (header + 13);
+    if (header[0] < RT_Store || header[0] > RT_Remove
+        || static_cast<ACE_UINT64> (event_size) + routing_slip_size
+             > static_cast<ACE_UINT64> (file_size - end - RECORD_HEADER_SIZE))
+    {
+      break;
+    }
+
+    // Message blocks of at least one byte, so that they are allocated
+    // even for an empty payload.
+    ACE_Message_Block * event = 0;
+    ACE_Message_Block * routing_slip = 0;
+    ACE_NEW_NORETURN (event, ACE_Message_Block (event_size + 1));
+    ACE_NEW_NORETURN (routing_slip, ACE_Message_Block (routing_slip_size + 1));
+    bool valid = event != 0 && routing_slip != 0;
+    if (valid)
+    {
+      ACE::read_n (handle, event->wr_ptr (), event_size, &bytes);
+      valid = bytes == event_size;
+    }
+    if (valid)
+    {
+      event->wr_ptr (event_size);
+      ACE::read_n (handle, routing_slip->wr_ptr (), routing_slip_size, &bytes);
+      valid = bytes == routing_slip_size;
+    }
+    if (valid)
+    {
+      routing_slip->wr_ptr (routing_slip_size);
+      valid = get_uint32 (header + RECORD_CRC_OFFSET) ==
+        record_crc (header, event->rd_ptr (), event_size,
+          routing_slip->rd_ptr (), routing_slip_size);
+    }
+    if (!valid)
+    {
+      delete event;
+      delete routing_slip;
+      break;
+    }
+    end += static_cast<ACE_OFF_T> (
+      RECORD_HEADER_SIZE + event_size + routing_slip_size);
+
+    if (serial_number > last_serial_number)
+    {
+      last_serial_number = serial_number;
+    }
+
+    Live_Map::ENTRY * entry = 0;
+    bool const found = live.find (serial_number, entry) == 0;
+    switch (header[0])
+    {
+      case RT_Store:
+      {
+        if (found)
+        {
+          delete entry->item ().event;
+          delete entry->item ().routing_slip;
+          entry->item ().event = event;
+          entry->item ().routing_slip = routing_slip;
+        }
+        else
+        {
+          Live_Record record = { event, routing_slip };
+          if (live.bind (serial_number, record) != 0)
+          {
+            delete event;
+            delete routing_slip;
+          }
+        }
+        break;
+      }
+      case RT_Update:
+      {
+        if (found)
+        {
+          delete entry->item ().routing_slip;
+          entry->item ().routing_slip = routing_slip;
+          routing_slip = 0;
+        }
+        delete event;
+        delete routing_slip;
+        break;
+      }
+      default:
+      {
+        if (found)
+        {
+          delete entry->item ().event;
+          delete entry->item ().routing_slip;
+          live.unbind (serial_number);
+        }
+        delete event;
+        delete routing_slip;
+        break;
+      }
+    }
+  }
+  return true;
+}
+
+bool
+WAL_Event_Persistence_Factory::write_checkpoint (ACE_HANDLE handle,
+  const Live_Map & live)
+{
+  bool result =
+    ACE::write_n (handle, WAL_SIGNATURE, WAL_SIGNATURE_SIZE)
+      == static_cast<ssize_t> (WAL_SIGNATURE_SIZE);
+  Live_Map::ITERATOR iter (live);
+  for (Live_Map::ENTRY * entry = 0;
+       result && iter.next (entry) != 0;
+       iter.advance ())
+  {
+    ACE_Message_Block * record = make_record (RT_Store,
+      entry->key (),
+      entry->item ().event,
+      entry->item ().routing_slip);
+    result = record != 0
+      && ACE::write_n (handle, record->rd_ptr (), record->length ())
+           == static_cast<ssize_t> (record->length ());
+    if (record != 0)
+    {
+      record->release ();
+    }
+  }
+  return result && ACE_OS::fsync (handle) == 0;
+}
+
+bool
+WAL_Event_Persistence_Factory::checkpoint ()
+{
+  ACE_TString new_filename (this->filename_);
+  new_filename += ACE_TEXT (".new");
+
+  bool result = false;
+  Live_Map live;
+  ACE_OFF_T end = 0;
+  ACE_UINT64 last_serial_number = 0;
+  if (this->replay (this->handle_, live, end, last_serial_number))
+  {
+    ACE_HANDLE handle = ACE_OS::open (new_filename.c_str (),
+      O_CREAT | O_TRUNC | O_RDWR | O_BINARY,
+      ACE_DEFAULT_FILE_PERMS);
+    if (handle != ACE_INVALID_HANDLE)
+    {
+      result = this->write_checkpoint (handle, live);
+      ACE_OS::close (handle);
+      if (result)
+      {
+        // The rename is atomic: a crash leaves either the old log or the
+        // checkpoint, which hold the same events.  The directory is
+        // synced before records are appended to the checkpoint, which a
+        // crash must not revert to the old log.
+        ACE_OS::close (this->handle_);
+        result = ACE_OS::rename (new_filename.c_str (),
+          this->filename_.c_str ()) == 0
+          && sync_directory (this->filename_);
+        this->handle_ = ACE_OS::open (this->filename_.c_str (),
+          O_RDWR | O_BINARY);
+      }
+      else
+      {
+        ACE_OS::unlink (new_filename.c_str ());
+      }
+    }
+  }
+  release (live);
+
+  if (this->handle_ == ACE_INVALID_HANDLE)
+  {
+    ORBSVCS_ERROR ((LM_ERROR,
+      ACE_TEXT ("(%P|%t) WAL_Event_Persistence: Cannot reopen %s: %m\n"),
+      this->filename_.c_str ()
+      ));
+    return false;
+  }
+  ACE_OFF_T const size = ACE_OS::lseek (this->handle_, 0, SEEK_END);
+  this->log_size_ = static_cast<ACE_UINT64> (size);
+  this->checkpoint_threshold_ =
+    ACE_MAX (this->checkpoint_size_, 2 * this->log_size_);
+  if (!result)
+  {
+    ORBSVCS_ERROR ((LM_ERROR,
+      ACE_TEXT ("(%P|%t) WAL_Event_Persistence: Checkpoint of %s failed: %m\n"),
+      this->filename_.c_str ()
+      ));
+  }
+  else if (TAO_debug_level > 0)
+  {
+    ORBSVCS_DEBUG ((LM_DEBUG,
+      ACE_TEXT ("(%P|%t) WAL_Event_Persistence: Checkpoint of %s: %B events, %Q bytes\n"),
+      this->filename_.c_str (),
+      live.current_size (),
+      this->log_size_
+      ));
+  }
+  return result;
+}
+
+void
+WAL_Event_Persistence_Factory::release (Live_Map & live)
+{
+  Live_Map::ITERATOR iter (live);
+  for (Live_Map::ENTRY * entry = 0; iter.next (entry) != 0; iter.advance ())
+  {
+    delete entry->item ().event;
+    delete entry->item ().routing_slip;
+    entry->item ().event = 0;
+    entry->item ().routing_slip = 0;
+  }
+}
+
+ACE_THR_FUNC_RETURN
+WAL_Event_Persistence_Factory::thr_func (void * arg)
+{
+  WAL_Event_Persistence_Factory * factory =
+    static_cast<WAL_Event_Persistence_Factory *> (arg);
+  factory->run ();
+  return 0;
+}
+
+void
+WAL_Event_Persistence_Factory::shutdown_thread ()
+{
+  if (this->thread_active_)
+  {
+    {
+      ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, this->queue_lock_);
+      this->terminate_thread_ = true;
+      this->wake_up_thread_.signal ();
+    }
+    this->thread_manager_.close ();
+    ACE_ASSERT (!this->thread_active_);
+  }
+}
+
+bool
+WAL_Event_Persistence_Factory::write_group (ACE_Message_Block * group)
+{
+  size_t const group_size = group->total_length ();
+  size_t written = 0;
+  if (ACE::write_n (this->handle_, group, &written) != -1
+      && written == group_size
+      && ACE_OS::fsync (this->handle_) == 0)
+  {
+    this->log_size_ += group_size;
+    return true;
+  }
+
+  ORBSVCS_ERROR ((LM_ERROR,
+    ACE_TEXT ("(%P|%t) WAL_Event_Persistence: Write to %s failed: %m\n"),
+    this->filename_.c_str ()
+    ));
+  // Cut off what was written of the group, so that the log still ends
+  // with the last record known to be on disk.
+  ACE_OFF_T const end = static_cast<ACE_OFF_T> (this->log_size_);
+  ACE_OS::ftruncate (this->handle_, end);
+  ACE_OS::lseek (this->handle_, end, SEEK_SET);
+  return false;
+}
+
+bool
+WAL_Event_Persistence_Factory::requeue (ACE_Message_Block * group,
+  ACE_Unbounded_Queue<Persistent_Callback *> & callbacks)
+{
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, this->queue_lock_, false);
+  if (this->terminate_thread_)
+  {
+    group->release ();
+    ACE_Message_Block * rest = this->queue_head_;
+    this->queue_head_ = 0;
+    this->queue_tail_ = 0;
+    if (rest != 0)
+    {
+      rest->release ();
+    }
+    this->callbacks_.reset ();
+    this->terminate_thread_ = false;
+    this->thread_active_ = false;
+    return false;
+  }
+
+  ACE_Message_Block * tail = group;
+  while (tail->cont () != 0)
+  {
+    tail = tail->cont ();
+  }
+  tail->cont (this->queue_head_);
+  if (this->queue_tail_ == 0)
+  {
+    this->queue_tail_ = tail;
+  }
+  this->queue_head_ = group;
+
+  Persistent_Callback * callback = 0;
+  while (this->callbacks_.dequeue_head (callback) == 0)
+  {
+    callbacks.enqueue_tail (callback);
+  }
+  this->callbacks_ = callbacks;
+
+  // Wait before the next attempt, unless the factory is shut down.
+  ACE_Time_Value const deadline =
+    ACE_OS::gettimeofday () + ACE_Time_Value (WAL_RETRY_DELAY);
+  while (!this->terminate_thread_
+         && this->wake_up_thread_.wait (&deadline) == 0)
+  {
+  }
+  return true;
+}
+
+void
+WAL_Event_Persistence_Factory::run ()
+{
+  // The pending records are written before the thread terminates.
+  for (;;)
+  {
+    ACE_Message_Block * group = 0;
+    ACE_Unbounded_Queue<Persistent_Callback *> callbacks;
+    {
+      ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, this->queue_lock_);
+      while (this->queue_head_ == 0 && !this->terminate_thread_)
+      {
+        this->wake_up_thread_.wait ();
+      }
+      if (this->queue_head_ == 0)
+      {
+        this->terminate_thread_ = false;
+        this->thread_active_ = false;
+        break;
+      }
+      if (this->commit_delay_ != ACE_Time_Value::zero)
+      {
+        // Give the records of other events a chance to join the group.
+        ACE_Time_Value const deadline =
+          ACE_OS::gettimeofday () + this->commit_delay_;
+        while (!this->terminate_thread_
+               && this->wake_up_thread_.wait (&deadline) == 0)
+        {
+        }
+      }
+      group = this->queue_head_;
+      this->queue_head_ = 0;
+      this->queue_tail_ = 0;
+      callbacks = this->callbacks_;
+      this->callbacks_.reset ();
+    }
+
+    if (!this->write_group (group))
+    {
+      // Nothing of the group is in the log, so its callbacks are not
+      // called: the group goes back to the head of the queue and is
+      // written again after a while, with the records queued since.
+      if (!this->requeue (group, callbacks))
+      {
+        ORBSVCS_ERROR ((LM_ERROR,
+          ACE_TEXT ("(%P|%t) WAL_Event_Persistence: Discarding the events not written to %s\n"),
+          this->filename_.c_str ()
+          ));
+        break;
+      }
+      continue;
+    }
+    group->release ();
+
+    Persistent_Callback * callback = 0;
+    while (callbacks.dequeue_head (callback) == 0)
+    {
+      callback->persist_complete ();
+    }
+
+    if (this->log_size_ >= this->checkpoint_threshold_)
+    {
+      this->checkpoint ();
+    }
+  }
+}
+
+WAL_Event_Persistence::WAL_Event_Persistence ()
+  : filename_ (ACE_TEXT ("__PERSISTENT_EVENT__.WAL"))
+  , checkpoint_size_ (64 * 1024 * 1024)
+  , factory_ (0)
+{
+}
+
+WAL_Event_Persistence::~WAL_Event_Persistence ()
+{
+}
+
+// get the current factory, creating it if necessary
+Event_Persistence_Factory *
+WAL_Event_Persistence::get_factory ()
+{
+  if (this->factory_ == 0)
+  {
+    ACE_NEW_NORETURN (
+      this->factory_,
+      WAL_Event_Persistence_Factory ()
+      );
+    if (this->factory_ != 0)
+    {
+      if (!this->factory_->open (this->filename_.c_str (),
+            this->checkpoint_size_,
+            this->commit_delay_))
+      {
+        delete this->factory_;
+        this->factory_ = 0;
+      }
+    }
+  }
+  return this->factory_;
+}
+
+// release the current factory so a new one can be created
+void
+WAL_Event_Persistence::reset ()
+{
+  delete this->factory_;
+  this->factory_ = 0;
+}
+
+int
+WAL_Event_Persistence::init (int argc, ACE_TCHAR *argv[])
+{
+  int result = 0;
+  bool verbose = false;
+  for (int narg = 0; narg < argc; ++narg)
+  {
+    ACE_TCHAR * av = argv[narg];
+    if (ACE_OS::strcasecmp (av, ACE_TEXT ("-v")) == 0)
+    {
+      verbose = true;
+      ORBSVCS_DEBUG ((LM_DEBUG,
+        ACE_TEXT ("(%P|%t) WAL_Event_Persistence: -verbose\n")
+        ));
+    }
+    else if (ACE_OS::strcasecmp (av, ACE_TEXT ("-file_path")) == 0 && narg + 1 < argc)
+    {
+      this->filename_ = argv[narg + 1];
+      if (TAO_debug_level > 0 || verbose)
+      {
+        ORBSVCS_DEBUG ((LM_DEBUG,
+          ACE_TEXT ("(%P|%t) WAL_Event_Persistence: Setting -file_path: %s\n"),
+          this->filename_.c_str ()
+        ));
+      }
+      narg += 1;
+    }
+    else if (ACE_OS::strcasecmp (av, ACE_TEXT ("-checkpoint_size")) == 0 && narg + 1 < argc)
+    {
+      this->checkpoint_size_ = ACE_OS::strtoull (argv[narg + 1], 0, 10);
+      if (TAO_debug_level > 0 || verbose)
+      {
+        ORBSVCS_DEBUG ((LM_DEBUG,
+          ACE_TEXT ("(%P|%t) WAL_Event_Persistence: Setting -checkpoint_size: %Q\n"),
+          this->checkpoint_size_
+        ));
+      }
+      narg += 1;
+    }
+    else if (ACE_OS::strcasecmp (av, ACE_TEXT ("-commit_delay")) == 0 && narg + 1 < argc)
+    {
+      this->commit_delay_.set (0, ACE_OS::atoi (argv[narg + 1]));
+      if (TAO_debug_level > 0 || verbose)
+      {
+        ORBSVCS_DEBUG ((LM_DEBUG,
+          ACE_TEXT ("(%P|%t) WAL_Event_Persistence: Setting -commit_delay: %d\n"),
+          ACE_OS::atoi (argv[narg + 1])
+        ));
+      }
+      narg += 1;
+    }
+    else
+    {
+      ORBSVCS_ERROR ((LM_ERROR,
+        ACE_TEXT ("(%P|%t) Unknown parameter to WAL Event Persistence: %s\n"),
+        argv[narg]
+        ));
+      result = -1;
+    }
+  }
+  return result;
+}
+
+int
+WAL_Event_Persistence::fini ()
+{
+  delete this->factory_;
+  this->factory_ = 0;
+  return 0;
+}
+
+} // End TAO_Notify_Namespace
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+ACE_FACTORY_NAMESPACE_DEFINE (TAO_Notify_Serv,
+                              TAO_Notify_WAL_Event_Persistence,
+                              TAO_Notify::WAL_Event_Persistence)
@@ -0,0 +1,273 @@
+/* -*- C++ -*- */
+
+//=============================================================================
+/**
+ *  @file    WAL_Event_Persistence.h
+ *
+ *  An Event_Persistence_Strategy that appends the changes of the
+ *  routing slips to a write-ahead log.
+ */
+//=============================================================================
+
+#ifndef WAL_EVENT_PERSISTENCE_H
+#define WAL_EVENT_PERSISTENCE_H
+#include /**/ "ace/pre.h"
+
+#include "orbsvcs/Notify/notify_serv_export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+#pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "orbsvcs/Notify/Event_Persistence_Strategy.h"
+#include "orbsvcs/Notify/Event_Persistence_Factory.h"
+#include "orbsvcs/Notify/Routing_Slip_Persistence_Manager.h"
+#include "tao/orbconf.h"
+#include "ace/Thread_Manager.h"
+#include "ace/Condition_Thread_Mutex.h"
+#include "ace/Containers_T.h"
+#include "ace/RB_Tree.h"
+#include "ace/Null_Mutex.h"
+#include "ace/Time_Value.h"
+#include "ace/SString.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace TAO_Notify
+{
+  class WAL_Event_Persistence_Factory;
+
+  /// \brief The Routing_Slip_Persistence_Manager of WAL_Event_Persistence.
+  ///
+  /// Each change of the routing slip is a record appended to the log of
+  /// the factory.  The callback is called when the record is on disk.
+  class TAO_Notify_Serv_Export WAL_Routing_Slip_Persistence_Manager :
+    public Routing_Slip_Persistence_Manager
+  {
+  public:
+    /// Constructor.
+    WAL_Routing_Slip_Persistence_Manager (WAL_Event_Persistence_Factory * factory);
+
+    /// Destructor.
+    virtual ~WAL_Routing_Slip_Persistence_Manager ();
+
+    ////////////////////////////////////////////////////////
+    // Override Routing_Slip_Persistence_Manager methods.
+    virtual void set_callback (Persistent_Callback * callback);
+
+    virtual bool store (const ACE_Message_Block & event,
+      const ACE_Message_Block & routing_slip);
+
+    virtual bool update (const ACE_Message_Block & routing_slip);
+
+    virtual bool remove ();
+
+    virtual bool reload (ACE_Message_Block *& event,
+      ACE_Message_Block *& routing_slip);
+
+    virtual Routing_Slip_Persistence_Manager * load_next ();
+
+  private:
+    friend class WAL_Event_Persistence_Factory;
+
+    TAO_SYNCH_MUTEX lock_;
+    WAL_Event_Persistence_Factory * factory_;
+    /// Identifies the records of this routing slip in the log; zero
+    /// until the event is stored.
+    ACE_UINT64 serial_number_;
+    bool removed_;
+    Persistent_Callback * callback_;
+
+    /// The data recovered from the log, until reload () is called.
+    ACE_Message_Block * event_mb_;
+    ACE_Message_Block * routing_slip_mb_;
+  };
+
+  /**
+   * \brief Event_Persistence_Factory of the write-ahead log strategy.
+   *
+   * The log is a file of records: an event with its routing slip when
+   * it is stored, a new routing slip when it is updated, and the removal
+   * of the event.  The managers queue their records, and a writer thread
+   * appends everything that is queued with a single write and makes it
+   * durable with a single sync: while it waits for the disk, the records
+   * of the other events accumulate for the next sync (group commit).
+   * The callbacks of the records are called after the sync.
+   *
+   * Once the log grows past the checkpoint size, the writer thread
+   * rewrites it with one record per event still in the log (checkpoint)
+   * into a new file, which then replaces the log.
+   *
+   * When the log is opened, it is read once (replay) to rebuild the
+   * events to reload.  A truncated or corrupt record at the end, left by
+   * a crash during a write, ends the log; it is discarded.
+   */
+  class TAO_Notify_Serv_Export WAL_Event_Persistence_Factory :
+    public Event_Persistence_Factory
+  {
+  public:
+    /// The types of the records in the log.
+    enum Record_Type
+    {
+      RT_Store = 1,
+      RT_Update = 2,
+      RT_Remove = 3
+    };
+
+    /// Constructor
+    WAL_Event_Persistence_Factory ();
+    /// Destructor
+    virtual ~WAL_Event_Persistence_Factory ();
+
+    /// Open the log, replay it, and start the writer thread.
+    /// /param filename the fully qualified path/name of the log.
+    /// /param checkpoint_size the size in bytes of the log above which it
+    ///        is checkpointed.
+    /// /param commit_delay how long the writer thread waits for more
+    ///        records before it writes a group.
+    bool open (const ACE_TCHAR * filename,
+      ACE_UINT64 checkpoint_size,
+      const ACE_Time_Value & commit_delay);
+
+    //////////////////////////////////////////////////////
+    // Implement Event_Persistence_Factory virtual methods.
+    virtual Routing_Slip_Persistence_Manager *
+      create_routing_slip_persistence_manager (Persistent_Callback * callback);
+
+    virtual Routing_Slip_Persistence_Manager * first_reload_manager ();
+
+    /// The next event to reload, or 0 when all were reloaded.
+    /// Intended for use only by WAL_Routing_Slip_Persistence_Manager.
+    Routing_Slip_Persistence_Manager * next_reload_manager ();
+
+    /// Allocate the serial number of a new event.
+    /// Intended for use only by WAL_Routing_Slip_Persistence_Manager.
+    ACE_UINT64 allocate_serial_number ();
+
+    /// Queue a record for the writer thread.  @a event is only written
+    /// for RT_Store, and @a routing_slip for RT_Store and RT_Update.
+    /// Intended for use only by WAL_Routing_Slip_Persistence_Manager.
+    bool append (Record_Type type,
+      ACE_UINT64 serial_number,
+      const ACE_Message_Block * event,
+      const ACE_Message_Block * routing_slip,
+      Persistent_Callback * callback);
+
+  private:
+    /// An event in the log, during a replay.
+    struct Live_Record
+    {
+      ACE_Message_Block * event;
+      ACE_Message_Block * routing_slip;
+    };
+
+    typedef ACE_RB_Tree<ACE_UINT64,
+                        Live_Record,
+                        ACE_Less_Than<ACE_UINT64>,
+                        ACE_Null_Mutex> Live_Map;
+
+    /// Read the records of @a handle into @a live, set @a end to the
+    /// offset after the last valid record and @a last_serial_number to
+    /// the highest serial number in the log.
+    bool replay (ACE_HANDLE handle,
+      Live_Map & live,
+      ACE_OFF_T & end,
+      ACE_UINT64 & last_serial_number);
+
+    /// Write a new log with a record for each event of @a live into
+    /// @a handle.
+    bool write_checkpoint (ACE_HANDLE handle, const Live_Map & live);
+
+    /// Replace the log by a checkpoint.
+    bool checkpoint ();
+
+    /// Delete the message blocks of @a live.
+    static void release (Live_Map & live);
+
+    /// Build a record.
+    static ACE_Message_Block * make_record (Record_Type type,
+      ACE_UINT64 serial_number,
+      const ACE_Message_Block * event,
+      const ACE_Message_Block * routing_slip);
+
+    /// Append @a group to the log and sync it.  If that fails, truncate
+    /// the log back to its last complete record.
+    bool write_group (ACE_Message_Block * group);
+
+    /// Put back a group that could not be written, with its
+    /// @a callbacks, at the head of the queue and wait before the next
+    /// attempt.  Discard everything queued if the thread is shut down.
+    bool requeue (ACE_Message_Block * group,
+      ACE_Unbounded_Queue<Persistent_Callback *> & callbacks);
+
+    static ACE_THR_FUNC_RETURN thr_func (void * arg);
+    /// Write the pending records and stop the writer thread.
+    void shutdown_thread ();
+    /// The writer thread.
+    void run ();
+
+  private:
+    ACE_TString filename_;
+    ACE_HANDLE handle_;
+    ACE_UINT64 checkpoint_size_;
+    ACE_Time_Value commit_delay_;
+
+    /// Size of the log, maintained by the writer thread.
+    ACE_UINT64 log_size_;
+    /// Size above which the log is checkpointed; at least twice the size
+    /// of the last checkpoint, so that a log made mostly of events still
+    /// pending is not rewritten over and over.
+    ACE_UINT64 checkpoint_threshold_;
+
+    TAO_SYNCH_MUTEX lock_;
+    ACE_UINT64 serial_number_;
+    ACE_Unbounded_Queue<Routing_Slip_Persistence_Manager *> reload_queue_;
+
+    ACE_Thread_Manager thread_manager_;
+    TAO_SYNCH_MUTEX queue_lock_;
+    ACE_SYNCH_CONDITION wake_up_thread_;
+    /// The records to write, chained through their cont () pointers.
+    ACE_Message_Block * queue_head_;
+    ACE_Message_Block * queue_tail_;
+    ACE_Unbounded_Queue<Persistent_Callback *> callbacks_;
+    bool terminate_thread_;
+    bool thread_active_;
+  };
+
+  /// \brief A write-ahead log implementation of the
+  /// Event_Persistence_Strategy interface.
+  class TAO_Notify_Serv_Export WAL_Event_Persistence :
+    public Event_Persistence_Strategy
+  {
+  public :
+    /// Constructor.
+    WAL_Event_Persistence ();
+    /// Destructor.
+    virtual ~WAL_Event_Persistence ();
+    /////////////////////////////////////////////
+    // Override Event_Persistent_Strategy methods
+    // Parse arguments and initialize.
+    virtual int init (int argc, ACE_TCHAR *argv[]);
+    // Prepare for shutdown
+    virtual int fini ();
+
+    // get the current factory, creating it if necessary
+    virtual Event_Persistence_Factory * get_factory ();
+
+  private:
+    // release the current factory so a new one can be created
+    virtual void reset ();
+
+    ACE_TString filename_;          // set via -file_path
+    ACE_UINT64 checkpoint_size_;    // set via -checkpoint_size
+    ACE_Time_Value commit_delay_;   // set via -commit_delay
+    WAL_Event_Persistence_Factory * factory_;
+  };
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+ACE_FACTORY_DECLARE (TAO_Notify_Serv, TAO_Notify_WAL_Event_Persistence)
+
+#include /**/ "ace/post.h"
+#endif /* WAL_EVENT_PERSISTENCE_H */
@@ -0,0 +1,153 @@
+// Checks the cache of TAO_Naming_Client::resolve (), see README.
+
+#include "orbsvcs/Naming/Naming_Client.h"
+#include "orbsvcs/Naming/Naming_Cache.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/OS_NS_sys_time.h"
+
+namespace
+{
+  // Resolve @a n until it resolves to @a expected, running the ORB
+  // for the invalidations, for up to @a timeout.
+  bool
+  wait_for (CORBA::ORB_ptr orb,
+            TAO_Naming_Cache &cache,
+            const CosNaming::Name &n,
+            CORBA::Object_ptr expected,
+            const ACE_Time_Value &timeout)
+  {
+    ACE_Time_Value const deadline = ACE_OS::gettimeofday () + timeout;
+    for (;;)
+      {
+        CORBA::Object_var obj = cache.resolve (n);
+        if (obj->_is_equivalent (expected))
+          return true;
+        if (deadline < ACE_OS::gettimeofday ())
+          return false;
+
+        ACE_Time_Value tv (0, 100000);
+        orb->perform_work (tv);
+      }
+  }
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  int status = 0;
+
+  try
+    {
+      CORBA::ORB_var orb = CORBA::ORB_init (argc, argv);
+
+      TAO_Naming_Client naming_client;
+      if (naming_client.init (orb.in ()) != 0)
+        {
+          ACE_ERROR ((LM_ERROR, "ERROR: cannot find the Naming Service\n"));
+          return 1;
+        }
+      CosNaming::NamingContext_var root = naming_client.get_context ();
+
+      // Two objects to bind, and a context to bind them in.
+      CosNaming::NamingContext_var first = root->new_context ();
+      CosNaming::NamingContext_var second = root->new_context ();
+
+      CosNaming::Name name (2);
+      name.length (2);
+      name[0].id = CORBA::string_dup ("naming_cache");
+      name[1].id = CORBA::string_dup ("object");
+      CosNaming::Name context_name (1);
+      context_name.length (1);
+      context_name[0].id = CORBA::string_dup ("naming_cache");
+
+      CosNaming::NamingContext_var context =
+        root->bind_new_context (context_name);
+      root->bind (name, first.in ());
+
+      // Cached names, invalidated by the Naming Service.
+      if (naming_client.enable_cache (ACE_Time_Value (3600)) != 0
+          || naming_client.cache () == 0
+          || !naming_client.cache ()->subscribed ())
+        {
+          ACE_ERROR ((LM_ERROR, "ERROR: the cache is not subscribed\n"));
+          return 1;
+        }
+      TAO_Naming_Cache &cache = *naming_client.cache ();
+
+      CORBA::Object_var obj = naming_client.resolve (name);
+      obj = naming_client.resolve (name);
+      if (!obj->_is_equivalent (first.in ()) || cache.hits () != 1)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      "ERROR: the name was not resolved from the cache "
+                      "(%lu hits)\n",
+                      cache.hits ()));
+          status = 1;
+        }
+
+      root->rebind (name, second.in ());
+      if (!wait_for (orb.in (), cache, name, second.in (), ACE_Time_Value (10)))
+        {
+          ACE_ERROR ((LM_ERROR,
+                      "ERROR: the cache was not told of the rebind\n"));
+          status = 1;
+        }
+
+      // The unbind of a context invalidates the names through it.
+      root->unbind (context_name);
+      ACE_Time_Value const deadline =
+        ACE_OS::gettimeofday () + ACE_Time_Value (10);
+      while (cache.current_size () != 0
+             && ACE_OS::gettimeofday () < deadline)
+        {
+          ACE_Time_Value tv (0, 100000);
+          orb->perform_work (tv);
+        }
+      if (cache.current_size () != 0)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      "ERROR: the cache was not told of the unbind\n"));
+          status = 1;
+        }
+      cache.unsubscribe ();
+      root->bind_context (context_name, context.in ());
+      root->rebind (name, first.in ());
+
+      // Cached names that only expire.
+      {
+        TAO_Naming_Cache expiring (root.in (), ACE_Time_Value (1));
+        obj = expiring.resolve (name);
+        root->rebind (name, second.in ());
+        obj = expiring.resolve (name);
+        if (!obj->_is_equivalent (first.in ()))
+          {
+            ACE_ERROR ((LM_ERROR,
+                        "ERROR: the name expired too early\n"));
+            status = 1;
+          }
+        ACE_OS::sleep (ACE_Time_Value (1, 500000));
+        obj = expiring.resolve (name);
+        if (!obj->_is_equivalent (second.in ()))
+          {
+            ACE_ERROR ((LM_ERROR,
+                        "ERROR: the name did not expire\n"));
+            status = 1;
+          }
+      }
+
+      root->unbind (name);
+      root->unbind (context_name);
+      context->destroy ();
+      first->destroy ();
+      second->destroy ();
+
+      orb->destroy ();
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("ERROR: exception caught:");
+      return 1;
+    }
+
+  return status;
+}
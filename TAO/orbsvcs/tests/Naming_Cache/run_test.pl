@@ -0,0 +1,51 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+    & eval 'exec perl -S $0 $argv:q'
+    if 0;
+
+# -*- perl -*-
+
+# Runs the Naming Service and a client that caches the names it
+# resolves, see README.
+
+use lib "$ENV{ACE_ROOT}/bin";
+use PerlACE::TestTarget;
+
+$status = 0;
+
+my $test = PerlACE::TestTarget::create_target (1) || die "Create target 1 failed\n";
+
+$hostname = $test->HostName ();
+$ns_orb_port = 12000 + $test->RandomPort ();
+$ns_endpoint = "iiop://$hostname:$ns_orb_port";
+
+$iorfile = "ns.ior";
+my $test_iorfile = $test->LocalFile ($iorfile);
+$test->DeleteFile ($iorfile);
+
+$NS = $test->CreateProcess ("../../Naming_Service/tao_cosnaming",
+                            "-ORBEndpoint $ns_endpoint -o $test_iorfile");
+$CL = $test->CreateProcess ("client",
+                            "-ORBInitRef NameService=file://$test_iorfile " .
+                            "-ORBInitRef NameServiceCache=corbaloc:iiop:$hostname:$ns_orb_port/NameServiceCache");
+
+$NS->Spawn ();
+
+if ($test->WaitForFileTimed ($iorfile,
+                             $test->ProcessStartWaitInterval ()) == -1) {
+    print STDERR "ERROR: cannot find file <$test_iorfile>\n";
+    $NS->Kill (); $NS->TimedWait (1);
+    exit 1;
+}
+
+$client_status = $CL->SpawnWaitKill ($test->ProcessStartWaitInterval () + 45);
+
+if ($client_status != 0) {
+    print STDERR "ERROR: client returned $client_status\n";
+    $status = 1;
+}
+
+$NS->Kill (); $NS->TimedWait (1);
+
+$test->DeleteFile ($iorfile);
+
+exit $status;
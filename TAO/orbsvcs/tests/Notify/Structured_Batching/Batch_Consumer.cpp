@@ -0,0 +1,146 @@
+#include "Batch_Consumer.h"
+#include "ace/Log_Msg.h"
+
+Batch_Consumer::Batch_Consumer (void)
+  : sent_ (0),
+    received_ (0),
+    fanout_ (0),
+    limit_ (0),
+    depth_ (0),
+    errors_ (0)
+{
+}
+
+void
+Batch_Consumer::supplier (
+  CosNotifyChannelAdmin::StructuredProxyPushConsumer_ptr proxy)
+{
+  this->supplier_ =
+    CosNotifyChannelAdmin::StructuredProxyPushConsumer::_duplicate (proxy);
+}
+
+void
+Batch_Consumer::send (void)
+{
+  CosNotification::StructuredEvent event;
+
+  event.header.fixed_header.event_type.domain_name =
+    CORBA::string_dup ("Test");
+  event.header.fixed_header.event_type.type_name =
+    CORBA::string_dup ("Batch");
+  event.header.fixed_header.event_name = CORBA::string_dup ("");
+
+  event.filterable_data.length (1);
+  event.filterable_data[0].name = CORBA::string_dup ("sequence");
+  event.filterable_data[0].value <<= this->sent_;
+
+  ++this->sent_;
+  this->supplier_->push_structured_event (event);
+}
+
+void
+Batch_Consumer::forward (CORBA::ULong fanout, CORBA::ULong limit)
+{
+  this->fanout_ = fanout;
+  this->limit_ = limit;
+}
+
+CORBA::ULong
+Batch_Consumer::sent (void) const
+{
+  return this->sent_;
+}
+
+CORBA::ULong
+Batch_Consumer::received (void) const
+{
+  return this->received_;
+}
+
+const ACE_Vector<CORBA::ULong> &
+Batch_Consumer::batches (void) const
+{
+  return this->batches_;
+}
+
+int
+Batch_Consumer::errors (void) const
+{
+  return this->errors_;
+}
+
+void
+Batch_Consumer::offer_change (const CosNotification::EventTypeSeq &,
+                              const CosNotification::EventTypeSeq &)
+{
+}
+
+void
+Batch_Consumer::push_structured_event (
+  const CosNotification::StructuredEvent &)
+{
+  ACE_ERROR ((LM_ERROR,
+              "ERROR: event %u pushed alone instead of in a batch\n",
+              this->received_));
+  ++this->errors_;
+  ++this->received_;
+}
+
+void
+Batch_Consumer::disconnect_structured_push_consumer (void)
+{
+}
+
+void
+Batch_Consumer::push_structured_events (
+  const CosNotification::EventBatch & notifications)
+{
+  if (++this->depth_ > 1)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  "ERROR: batch pushed while the consumer still "
+                  "receives the previous one\n"));
+      ++this->errors_;
+    }
+
+  this->batches_.push_back (notifications.length ());
+
+  for (CORBA::ULong i = 0; i != notifications.length (); ++i)
+    {
+      CORBA::ULong sequence = 0;
+
+      if (notifications[i].filterable_data.length () != 1
+          || !(notifications[i].filterable_data[0].value >>= sequence)
+          || sequence != this->received_)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      "ERROR: event %u of batch %B is not event %u\n",
+                      i,
+                      this->batches_.size (),
+                      this->received_));
+          ++this->errors_;
+        }
+
+      ++this->received_;
+
+      try
+        {
+          for (CORBA::ULong n = 0;
+               n != this->fanout_ && this->sent_ < this->limit_;
+               ++n)
+            this->send ();
+        }
+      catch (const CORBA::Exception& ex)
+        {
+          ex._tao_print_exception ("ERROR: send from the consumer:");
+          ++this->errors_;
+        }
+    }
+
+  --this->depth_;
+}
+
+void
+Batch_Consumer::disconnect_sequence_push_consumer (void)
+{
+}
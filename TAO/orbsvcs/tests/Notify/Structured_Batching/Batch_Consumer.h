@@ -0,0 +1,86 @@
+/* -*- C++ -*- */
+//=============================================================================
+/**
+ *  @file   Batch_Consumer.h
+ *
+ * A structured push consumer that also receives the events in batches.
+ */
+//=============================================================================
+
+#ifndef TAO_NOTIFY_TESTS_BATCH_CONSUMER_H
+#define TAO_NOTIFY_TESTS_BATCH_CONSUMER_H
+
+#include "TestS.h"
+#include "orbsvcs/CosNotifyChannelAdminC.h"
+#include "ace/Vector_T.h"
+
+/**
+ * @class Batch_Consumer
+ *
+ * @brief Checks the events it receives, and pushes more of them.
+ *
+ * The events carry a sequence number in their filterable data, which
+ * must be the next one the consumer expects.  The consumer records
+ * the size of every batch, and counts the events pushed to it one by
+ * one and the times it is called while it already is in
+ * push_structured_events().
+ */
+class Batch_Consumer : public virtual POA_Test::Batch_Consumer
+{
+public:
+  /// Constructor.
+  Batch_Consumer (void);
+
+  /// Push the events sent with send() to @a proxy.
+  void supplier (CosNotifyChannelAdmin::StructuredProxyPushConsumer_ptr proxy);
+
+  /// Push the event with the next sequence number.
+  void send (void);
+
+  /// From push_structured_events(), send @a fanout events for every
+  /// event received, until @a limit events are sent.
+  void forward (CORBA::ULong fanout, CORBA::ULong limit);
+
+  /// Number of events sent.
+  CORBA::ULong sent (void) const;
+
+  /// Number of events received.
+  CORBA::ULong received (void) const;
+
+  /// The sizes of the batches received, in order.
+  const ACE_Vector<CORBA::ULong> &batches (void) const;
+
+  /// Number of errors seen.
+  int errors (void) const;
+
+  // = CosNotifyComm::StructuredPushConsumer and SequencePushConsumer
+  virtual void offer_change (const CosNotification::EventTypeSeq & added,
+                             const CosNotification::EventTypeSeq & removed);
+
+  virtual void push_structured_event (
+    const CosNotification::StructuredEvent & notification);
+
+  virtual void disconnect_structured_push_consumer (void);
+
+  virtual void push_structured_events (
+    const CosNotification::EventBatch & notifications);
+
+  virtual void disconnect_sequence_push_consumer (void);
+
+private:
+  CosNotifyChannelAdmin::StructuredProxyPushConsumer_var supplier_;
+
+  CORBA::ULong sent_;
+  CORBA::ULong received_;
+  CORBA::ULong fanout_;
+  CORBA::ULong limit_;
+
+  /// Number of push_structured_events() calls in progress.
+  int depth_;
+
+  int errors_;
+
+  ACE_Vector<CORBA::ULong> batches_;
+};
+
+#endif /* TAO_NOTIFY_TESTS_BATCH_CONSUMER_H */
@@ -0,0 +1,337 @@
+#include "Batch_Consumer.h"
+
+#include "orbsvcs/Notify/CosNotify_Service.h"
+#include "orbsvcs/CosNotifyChannelAdminC.h"
+
+#include "tao/PortableServer/PortableServer.h"
+
+#include "ace/ARGV.h"
+#include "ace/Get_Opt.h"
+#include "ace/OS_NS_sys_time.h"
+
+/// Test -AdaptiveBatching instead of fixed size batches.
+bool adaptive = false;
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("a"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'a':
+        adaptive = true;
+        break;
+
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage:  %s "
+                           "-a "
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+  // Indicates successful parsing of the command line
+  return 0;
+}
+
+/// Set the MaximumBatchSize and PacingInterval of @a proxy.
+void
+set_batching (CosNotifyChannelAdmin::StructuredProxyPushSupplier_ptr proxy,
+              CORBA::Long batch_size,
+              int pacing_secs)
+{
+  CosNotification::QoSProperties qos (2);
+  qos.length (2);
+  qos[0].name = CORBA::string_dup (CosNotification::MaximumBatchSize);
+  qos[0].value <<= batch_size;
+  qos[1].name = CORBA::string_dup (CosNotification::PacingInterval);
+  qos[1].value <<= static_cast<TimeBase::TimeT> (pacing_secs) * 10000000;
+
+  proxy->set_qos (qos);
+}
+
+/// Check that the batches have MaximumBatchSize events, and that the
+/// events left go out when the PacingInterval expires.
+int
+test_fixed (CORBA::ORB_ptr orb, Batch_Consumer &consumer)
+{
+  CORBA::ULong const batch_size = 5;
+  CORBA::ULong const nevents = 4 * batch_size + 3;
+  int errors = 0;
+
+  for (CORBA::ULong i = 0; i != nevents; ++i)
+    {
+      consumer.send ();
+
+      if (consumer.received () != (i + 1) / batch_size * batch_size)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      "ERROR: %u events received after %u were sent\n",
+                      consumer.received (),
+                      i + 1));
+          ++errors;
+        }
+    }
+
+  // The last events wait for the PacingInterval of one second.
+  ACE_Time_Value const deadline =
+    ACE_OS::gettimeofday () + ACE_Time_Value (10);
+
+  while (consumer.received () != nevents
+         && ACE_OS::gettimeofday () < deadline)
+    {
+      ACE_Time_Value tv (0, 100000);
+      orb->perform_work (tv);
+    }
+
+  const ACE_Vector<CORBA::ULong> &batches = consumer.batches ();
+
+  if (consumer.received () != nevents || batches.size () != 5)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  "ERROR: %u events received in %B batches instead of "
+                  "%u in 5\n",
+                  consumer.received (),
+                  batches.size (),
+                  nevents));
+      return errors + 1;
+    }
+
+  for (size_t i = 0; i != batches.size (); ++i)
+    {
+      CORBA::ULong const expected =
+        i + 1 == batches.size () ? nevents % batch_size : batch_size;
+
+      if (batches[i] != expected)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      "ERROR: batch %B has %u events instead of %u\n",
+                      i,
+                      batches[i],
+                      expected));
+          ++errors;
+        }
+    }
+
+  return errors;
+}
+
+/// Check that the events go out one by one while the consumer keeps
+/// up, that the events pushed while the consumer receives a batch go
+/// out in the next batches, which grow up to MaximumBatchSize, and
+/// that the batches shrink again once the consumer caught up.
+int
+test_adaptive (Batch_Consumer &consumer)
+{
+  CORBA::ULong const batch_size = 8;
+  CORBA::ULong const nevents = 200;
+  int errors = 0;
+
+  // No backlog, no waiting for the PacingInterval of ten seconds.
+  for (CORBA::ULong i = 0; i != 3; ++i)
+    {
+      consumer.send ();
+
+      if (consumer.received () != consumer.sent ())
+        {
+          ACE_ERROR ((LM_ERROR,
+                      "ERROR: event %u held without a backlog\n",
+                      i));
+          ++errors;
+        }
+    }
+
+  // Each event received makes the consumer push three more, while the
+  // channel is in push_structured_events().
+  size_t const first_burst_batch = consumer.batches ().size ();
+
+  consumer.forward (3, nevents);
+  consumer.send ();
+  consumer.forward (0, 0);
+
+  if (consumer.received () != nevents)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  "ERROR: %u of %u events received after the burst\n",
+                  consumer.received (),
+                  nevents));
+      ++errors;
+    }
+
+  const ACE_Vector<CORBA::ULong> &batches = consumer.batches ();
+  CORBA::ULong largest = 0;
+
+  for (size_t i = first_burst_batch; i != batches.size (); ++i)
+    {
+      if (batches[i] > batch_size)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      "ERROR: batch %B has %u events, more than %u\n",
+                      i,
+                      batches[i],
+                      batch_size));
+          ++errors;
+        }
+
+      if (batches[i] > largest)
+        largest = batches[i];
+    }
+
+  if (largest != batch_size)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  "ERROR: the largest batch of the burst has %u events "
+                  "instead of %u\n",
+                  largest,
+                  batch_size));
+      ++errors;
+    }
+
+  // The batches grew, so the next event waits for more.
+  consumer.send ();
+
+  if (consumer.received () == consumer.sent ())
+    {
+      ACE_ERROR ((LM_ERROR,
+                  "ERROR: event sent alone right after the burst\n"));
+      ++errors;
+    }
+
+  // Without a backlog, the batches shrink back to single events.
+  bool single = false;
+
+  for (CORBA::ULong i = 0; !single && i != 4 * batch_size; ++i)
+    {
+      consumer.send ();
+
+      single = consumer.received () == consumer.sent ()
+        && batches[batches.size () - 1] == 1;
+    }
+
+  if (!single)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  "ERROR: the batches did not shrink back to single "
+                  "events, %u of %u events received\n",
+                  consumer.received (),
+                  consumer.sent ()));
+      ++errors;
+    }
+
+  ACE_DEBUG ((LM_DEBUG,
+              "%u events in %B batches\n",
+              consumer.received (),
+              batches.size ()));
+
+  return errors;
+}
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  int errors = 0;
+
+  try
+    {
+      CORBA::ORB_var orb = CORBA::ORB_init (argc, argv);
+
+      if (parse_args (argc, argv) != 0)
+        return 1;
+
+      CORBA::Object_var object =
+        orb->resolve_initial_references ("RootPOA");
+      PortableServer::POA_var poa =
+        PortableServer::POA::_narrow (object.in ());
+      PortableServer::POAManager_var poa_manager = poa->the_POAManager ();
+      poa_manager->activate ();
+
+      // Run a reactive Notification Service in this process, so that
+      // the events are pushed to the consumer from the thread that
+      // pushes them to the channel.
+      ACE_ARGV service_args;
+      service_args.add (ACE_TEXT ("-StructuredBatching"));
+      if (adaptive)
+        service_args.add (ACE_TEXT ("-AdaptiveBatching"));
+
+      TAO_CosNotify_Service notify_service;
+      notify_service.init (service_args.argc (), service_args.argv ());
+      notify_service.init_service (orb.in ());
+
+      CosNotifyChannelAdmin::EventChannelFactory_var factory =
+        notify_service.create (poa.in ());
+
+      CosNotifyChannelAdmin::ChannelID channel_id;
+      CosNotification::QoSProperties initial_qos;
+      CosNotification::AdminProperties initial_admin;
+      CosNotifyChannelAdmin::EventChannel_var channel =
+        factory->create_channel (initial_qos, initial_admin, channel_id);
+
+      CosNotifyChannelAdmin::ConsumerAdmin_var consumer_admin =
+        channel->default_consumer_admin ();
+      CosNotifyChannelAdmin::ProxyID proxy_id;
+      CosNotifyChannelAdmin::ProxySupplier_var proxy_supplier =
+        consumer_admin->obtain_notification_push_supplier (
+          CosNotifyChannelAdmin::STRUCTURED_EVENT, proxy_id);
+      CosNotifyChannelAdmin::StructuredProxyPushSupplier_var
+        structured_supplier =
+          CosNotifyChannelAdmin::StructuredProxyPushSupplier::_narrow (
+            proxy_supplier.in ());
+
+      if (adaptive)
+        set_batching (structured_supplier.in (), 8, 10);
+      else
+        set_batching (structured_supplier.in (), 5, 1);
+
+      CosNotifyChannelAdmin::SupplierAdmin_var supplier_admin =
+        channel->default_supplier_admin ();
+      CosNotifyChannelAdmin::ProxyConsumer_var proxy_consumer =
+        supplier_admin->obtain_notification_push_consumer (
+          CosNotifyChannelAdmin::STRUCTURED_EVENT, proxy_id);
+      CosNotifyChannelAdmin::StructuredProxyPushConsumer_var
+        structured_consumer =
+          CosNotifyChannelAdmin::StructuredProxyPushConsumer::_narrow (
+            proxy_consumer.in ());
+      structured_consumer->connect_structured_push_supplier (
+        CosNotifyComm::StructuredPushSupplier::_nil ());
+
+      Batch_Consumer *consumer_servant = 0;
+      ACE_NEW_RETURN (consumer_servant, Batch_Consumer, 1);
+      PortableServer::ServantBase_var owner_transfer (consumer_servant);
+
+      PortableServer::ObjectId_var id =
+        poa->activate_object (consumer_servant);
+      object = poa->id_to_reference (id.in ());
+      Test::Batch_Consumer_var consumer =
+        Test::Batch_Consumer::_narrow (object.in ());
+
+      consumer_servant->supplier (structured_consumer.in ());
+      structured_supplier->connect_structured_push_consumer (consumer.in ());
+
+      if (adaptive)
+        errors += test_adaptive (*consumer_servant);
+      else
+        errors += test_fixed (orb.in (), *consumer_servant);
+
+      errors += consumer_servant->errors ();
+
+      structured_supplier->disconnect_structured_push_supplier ();
+      structured_consumer->disconnect_structured_push_consumer ();
+
+      notify_service.finalize_service (factory.in ());
+
+      poa->deactivate_object (id.in ());
+
+      orb->destroy ();
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Exception caught:");
+      return 1;
+    }
+
+  return errors == 0 ? 0 : 1;
+}
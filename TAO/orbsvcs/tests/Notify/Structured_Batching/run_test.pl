@@ -0,0 +1,36 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+     & eval 'exec perl -S $0 $argv:q'
+     if 0;
+
+# -*- perl -*-
+
+use lib "$ENV{ACE_ROOT}/bin";
+use PerlACE::TestTarget;
+
+$status = 0;
+
+my $test = PerlACE::TestTarget::create_target (1) || die "Create target 1 failed\n";
+
+$SB = $test->CreateProcess ("Structured_Batching");
+
+print STDERR "================ Structured batching with fixed size batches\n";
+
+$SB->Arguments ("");
+$test_status = $SB->SpawnWaitKill ($test->ProcessStartWaitInterval() + 15);
+
+if ($test_status != 0) {
+    print STDERR "ERROR: Structured_Batching returned $test_status\n";
+    $status = 1;
+}
+
+print STDERR "================ Structured batching with adaptive batches\n";
+
+$SB->Arguments ("-a");
+$test_status = $SB->SpawnWaitKill ($test->ProcessStartWaitInterval() + 15);
+
+if ($test_status != 0) {
+    print STDERR "ERROR: Structured_Batching -a returned $test_status\n";
+    $status = 1;
+}
+
+exit $status;
@@ -0,0 +1,299 @@
+#include "ace/Get_Opt.h"
+#include "ace/OS_NS_stdlib.h"
+
+#include "orbsvcs/Notify/ETCL_FilterFactory.h"
+#include "orbsvcs/Notify/Subscription_Index.h"
+
+#include "tao/PortableServer/PortableServer.h"
+
+int nevents = 2000;
+
+/// The constraints of the filters, separated by '|' when a filter has
+/// more than one.  They compare the same event values with literals
+/// of every type, with ranges, "!=" and "~", and some of them cannot
+/// be indexed at all.
+const char *filters[] =
+  {
+    "$priority == 3",
+    "$priority == 3.0",
+    "$priority == '3'",
+    "$priority == TRUE",
+    "$priority != 2",
+    "$priority != 2.5",
+    "$priority > 2 and $priority <= 4.5",
+    "$priority < -1",
+    "$priority >= 1.5",
+    "3 < $priority",
+    "-2 >= $priority",
+    "not ($priority == 3)",
+    "$priority + 1 == 4",
+    "$priority > 3|$priority < 1",
+    "'IB' ~ $symbol",
+    "$symbol ~ 'IBM'",
+    "$symbol == 'IBM'",
+    "$symbol != 'HP'",
+    "$symbol == 5",
+    "$symbol == 'IBM' or $priority > 10",
+    "$domain_name == 'Finance' and $symbol != 'HP'",
+    "$domain_name == 'Finance'|$symbol == 'HP'",
+    "$type_name == 'Quote'",
+    "$.header.fixed_header.event_type.type_name == 'Trade'",
+    "$.header.variable_header(Urgency) >= 2",
+    "$.filterable_data(price) == 100",
+    "$price != 100.5",
+    "$price > 99.5 and $price < '101'",
+    "$price == 100 and $priority != 3",
+    "exist $price and $price == TRUE",
+    "$missing == 1",
+    "$missing != 1|$priority == 0"
+  };
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("n:"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'n':
+        nevents = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage:  %s "
+                           "-n <number of events> "
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+
+  if (nevents < 1)
+    ACE_ERROR_RETURN ((LM_ERROR, "Invalid event count\n"), -1);
+
+  // Indicates successful parsing of the command line
+  return 0;
+}
+
+/// Add the constraints of @a filter, separated by '|', to @a exps.
+void
+make_constraints (const char *filter,
+                  CosNotifyFilter::ConstraintExpSeq &exps)
+{
+  ACE_CString constraints (filter);
+  ACE_CString::size_type start = 0;
+
+  while (start <= constraints.length ())
+    {
+      ACE_CString::size_type end = constraints.find ('|', start);
+      if (end == ACE_CString::npos)
+        end = constraints.length ();
+
+      CORBA::ULong const n = exps.length ();
+      exps.length (n + 1);
+      exps[n].constraint_expr =
+        CORBA::string_dup (constraints.substring (start, end - start).c_str ());
+
+      start = end + 1;
+    }
+}
+
+/// Set @a value to one of the values of the same field the events
+/// have: numbers and strings that compare equal or close to the
+/// literals of the filters, in every type.
+void
+make_value (CORBA::Any &value, CORBA::ULong n)
+{
+  CORBA::Double const zero = 0.0;
+
+  switch (n % 14)
+    {
+    case 0: value <<= static_cast<CORBA::Short> (n % 7 - 3); break;
+    case 1: value <<= static_cast<CORBA::Long> (n % 9 - 4); break;
+    case 2: value <<= static_cast<CORBA::ULong> (n % 6); break;
+    case 3: value <<= static_cast<CORBA::Double> (n % 11) / 2.0 - 2.0; break;
+    case 4: value <<= CORBA::Any::from_boolean (n % 2 == 0); break;
+    case 5: value <<= (n % 3 == 0 ? "3" : "2"); break;
+    case 6: value <<= zero / zero; break;
+    case 7: value <<= static_cast<CORBA::Double> (3.0); break;
+    case 8: value <<= static_cast<CORBA::ULong> (100); break;
+    case 9: value <<= static_cast<CORBA::Double> (100.0); break;
+    case 10: value <<= static_cast<CORBA::Double> (100.5); break;
+    case 11: value <<= "100"; break;
+    case 12: value <<= static_cast<CORBA::Long> (-2); break;
+    default: value <<= static_cast<CORBA::Short> (1); break;
+    }
+}
+
+/// Make the events the filters are checked on.  The fields of an
+/// event are picked from its number, and some of them are missing.
+void
+make_event (CosNotification::StructuredEvent &event, CORBA::ULong n)
+{
+  static const char *domains[] = { "Finance", "Sports", "" };
+  static const char *types[] = { "Quote", "Trade" };
+  static const char *symbols[] = { "IBM", "HP", "IBMX", "XIB", "" };
+
+  event.header.fixed_header.event_type.domain_name =
+    CORBA::string_dup (domains[n % 3]);
+  event.header.fixed_header.event_type.type_name =
+    CORBA::string_dup (types[n / 3 % 2]);
+  event.header.fixed_header.event_name = CORBA::string_dup ("");
+
+  if (n % 4 != 0)
+    {
+      event.header.variable_header.length (1);
+      event.header.variable_header[0].name = CORBA::string_dup ("Urgency");
+      make_value (event.header.variable_header[0].value, n / 4);
+    }
+
+  CORBA::ULong fields = 0;
+  event.filterable_data.length (3);
+
+  if (n % 5 != 0)
+    {
+      event.filterable_data[fields].name = CORBA::string_dup ("priority");
+      make_value (event.filterable_data[fields].value, n / 5);
+      ++fields;
+    }
+
+  if (n % 7 != 0)
+    {
+      event.filterable_data[fields].name = CORBA::string_dup ("symbol");
+      if (n % 7 == 6)
+        event.filterable_data[fields].value <<= static_cast<CORBA::ULong> (5);
+      else
+        event.filterable_data[fields].value <<= symbols[n / 7 % 5];
+      ++fields;
+    }
+
+  if (n % 3 != 0)
+    {
+      event.filterable_data[fields].name = CORBA::string_dup ("price");
+      make_value (event.filterable_data[fields].value, n / 3 + 8);
+      ++fields;
+    }
+
+  event.filterable_data.length (fields);
+}
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  int errors = 0;
+
+  try
+    {
+      CORBA::ORB_var orb = CORBA::ORB_init (argc, argv);
+
+      if (parse_args (argc, argv) != 0)
+        return 1;
+
+      CORBA::Object_var object =
+        orb->resolve_initial_references ("RootPOA");
+      PortableServer::POA_var poa =
+        PortableServer::POA::_narrow (object.in ());
+      PortableServer::POAManager_var poa_manager = poa->the_POAManager ();
+      poa_manager->activate ();
+
+      TAO_Notify_ETCL_FilterFactory *factory = 0;
+      ACE_NEW_RETURN (factory, TAO_Notify_ETCL_FilterFactory, 1);
+      PortableServer::ServantBase_var owner_transfer (factory);
+
+      CosNotifyFilter::FilterFactory_var filter_factory =
+        factory->create (poa.in ());
+
+      TAO_Notify_Subscription_Index &index = *factory->subscription_index ();
+
+      size_t const nfilters = sizeof (filters) / sizeof (filters[0]);
+      CosNotifyFilter::Filter_var filter[nfilters];
+      CORBA::ULong slot[nfilters];
+
+      for (size_t i = 0; i != nfilters; ++i)
+        {
+          filter[i] = filter_factory->create_filter ("EXTENDED_TCL");
+
+          CosNotifyFilter::ConstraintExpSeq exps;
+          make_constraints (filters[i], exps);
+
+          CosNotifyFilter::ConstraintInfoSeq_var info =
+            filter[i]->add_constraints (exps);
+
+          if (index.find (factory->get_filter_id (filter[i].in ()),
+                          slot[i]) != 0)
+            ACE_ERROR_RETURN ((LM_ERROR,
+                               "ERROR: no slot for <%C>\n",
+                               filters[i]),
+                              1);
+        }
+
+      // The index may find a filter that does not match the event, but
+      // must find every filter that does.
+      unsigned long matches = 0;
+      unsigned long candidates = 0;
+
+      for (CORBA::ULong n = 0; n != static_cast<CORBA::ULong> (nevents); ++n)
+        {
+          CosNotification::StructuredEvent event;
+          make_event (event, n);
+
+          TAO_Notify_Subscription_Index::Candidates found;
+          index.candidates (event, found);
+
+          for (size_t i = 0; i != nfilters; ++i)
+            {
+              bool const candidate = found.contains (slot[i]);
+              bool const match = filter[i]->match_structured (event);
+
+              if (candidate)
+                ++candidates;
+
+              if (match)
+                ++matches;
+
+              if (match && !candidate)
+                {
+                  ACE_ERROR ((LM_ERROR,
+                              "ERROR: the index skipped <%C>, which "
+                              "matches event %u\n",
+                              filters[i],
+                              n));
+                  ++errors;
+                }
+            }
+        }
+
+      ACE_DEBUG ((LM_DEBUG,
+                  "%B filters, %d events: %u matches, %u candidates\n",
+                  nfilters,
+                  nevents,
+                  static_cast<unsigned int> (matches),
+                  static_cast<unsigned int> (candidates)));
+
+      // Otherwise the index was not used at all.
+      if (candidates == nfilters * nevents)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      "ERROR: every filter was a candidate for every "
+                      "event\n"));
+          ++errors;
+        }
+
+      for (size_t i = 0; i != nfilters; ++i)
+        filter[i]->destroy ();
+
+      factory->destroy ();
+
+      orb->destroy ();
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Exception caught:");
+      return 1;
+    }
+
+  return errors == 0 ? 0 : 1;
+}
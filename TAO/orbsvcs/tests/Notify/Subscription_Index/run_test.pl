@@ -0,0 +1,25 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+     & eval 'exec perl -S $0 $argv:q'
+     if 0;
+
+# -*- perl -*-
+
+use lib "$ENV{ACE_ROOT}/bin";
+use PerlACE::TestTarget;
+
+$status = 0;
+
+my $test = PerlACE::TestTarget::create_target (1) || die "Create target 1 failed\n";
+
+print STDERR "================ Notify subscription index test\n";
+
+$SI = $test->CreateProcess ("Subscription_Index", "-n 2000");
+
+$test_status = $SI->SpawnWaitKill ($test->ProcessStartWaitInterval() + 45);
+
+if ($test_status != 0) {
+    print STDERR "ERROR: Subscription_Index returned $test_status\n";
+    $status = 1;
+}
+
+exit $status;
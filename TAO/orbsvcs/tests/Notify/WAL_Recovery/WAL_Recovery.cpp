@@ -0,0 +1,329 @@
+#include "orbsvcs/Notify/WAL_Event_Persistence.h"
+#include "orbsvcs/Notify/Persistent_File_Allocator.h"
+
+#include "ace/Get_Opt.h"
+#include "ace/OS_NS_fcntl.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_sys_stat.h"
+#include "ace/OS_NS_sys_time.h"
+#include "ace/OS_NS_unistd.h"
+
+using namespace TAO_Notify;
+
+const ACE_TCHAR *filename = ACE_TEXT ("WAL_Recovery.log");
+
+const int nevents = 64;
+
+/// The routing slip each event must have after a reload, or an empty
+/// string for an event that must not be reloaded.
+ACE_CString expected[nevents + 8];
+int next_event = 0;
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("f:"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'f':
+        filename = get_opts.opt_arg ();
+        break;
+
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage:  %s "
+                           "-f <log file> "
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+  // Indicates successful parsing of the command line
+  return 0;
+}
+
+/// Counts the records of a routing slip that are on disk.
+class Callback : public Persistent_Callback
+{
+public:
+  Callback (void)
+    : completed_ (0),
+      done_ (lock_)
+  {
+  }
+
+  virtual void persist_complete (void)
+  {
+    ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, this->lock_);
+    ++this->completed_;
+    this->done_.broadcast ();
+  }
+
+  /// Wait until @a n records are on disk.
+  bool wait (int n)
+  {
+    ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, this->lock_, false);
+    ACE_Time_Value const deadline =
+      ACE_OS::gettimeofday () + ACE_Time_Value (10);
+    while (this->completed_ < n)
+      if (this->done_.wait (&deadline) == -1)
+        return false;
+    return true;
+  }
+
+private:
+  int completed_;
+  TAO_SYNCH_MUTEX lock_;
+  TAO_SYNCH_CONDITION done_;
+};
+
+void
+make_block (ACE_Message_Block &mb, const char *prefix, int n, int version)
+{
+  char buf[64];
+  int const len =
+    ACE_OS::snprintf (buf, sizeof buf, "%s %d.%d", prefix, n, version);
+  mb.copy (buf, len);
+}
+
+/// Store an event, update its routing slip @a updates times, and
+/// remove it if @a remove.  Returns the number of errors.
+int
+write_event (WAL_Event_Persistence_Factory &factory,
+             int updates,
+             bool remove)
+{
+  int const n = next_event++;
+  Callback callback;
+  Routing_Slip_Persistence_Manager *rspm =
+    factory.create_routing_slip_persistence_manager (&callback);
+
+  ACE_Message_Block event (64);
+  ACE_Message_Block routing_slip (64);
+  make_block (event, "event", n, 0);
+  make_block (routing_slip, "slip", n, 0);
+
+  int records = 1;
+  bool ok = rspm->store (event, routing_slip);
+
+  for (int i = 1; ok && i <= updates; ++i)
+    {
+      routing_slip.reset ();
+      make_block (routing_slip, "slip", n, i);
+      ok = rspm->update (routing_slip);
+      ++records;
+    }
+
+  if (ok && remove)
+    {
+      ok = rspm->remove ();
+      ++records;
+    }
+
+  ok = ok && callback.wait (records);
+  delete rspm;
+
+  if (!ok)
+    {
+      ACE_ERROR ((LM_ERROR, "ERROR: event %d was not written\n", n));
+      return 1;
+    }
+
+  if (!remove)
+    expected[n] = ACE_CString (routing_slip.rd_ptr (), routing_slip.length ());
+  return 0;
+}
+
+/// Open the log, and check that it reloads the expected events.
+int
+reload (WAL_Event_Persistence_Factory &factory,
+        const char *when,
+        ACE_UINT64 checkpoint_size = 1024 * 1024)
+{
+  if (!factory.open (filename, checkpoint_size, ACE_Time_Value::zero))
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       "ERROR: cannot open the log %s\n",
+                       when),
+                      1);
+
+  int errors = 0;
+  bool reloaded[sizeof expected / sizeof expected[0]] = { false };
+
+  Routing_Slip_Persistence_Manager *rspm = factory.first_reload_manager ();
+  while (rspm != 0)
+    {
+      ACE_Message_Block *event = 0;
+      ACE_Message_Block *routing_slip = 0;
+
+      if (rspm->reload (event, routing_slip))
+        {
+          ACE_CString const text (event->rd_ptr (), event->length ());
+          int const n = text.length () > 6
+            ? ACE_OS::atoi (text.c_str () + 6)
+            : -1;
+
+          ACE_Message_Block stored (64);
+          if (n >= 0)
+            make_block (stored, "event", n, 0);
+
+          if (n < 0 || n >= next_event || reloaded[n]
+              || text != ACE_CString (stored.rd_ptr (), stored.length ())
+              || expected[n] != ACE_CString (routing_slip->rd_ptr (),
+                                             routing_slip->length ()))
+            {
+              ACE_ERROR ((LM_ERROR,
+                          "ERROR: unexpected event <%C> reloaded %C\n",
+                          text.c_str (),
+                          when));
+              ++errors;
+            }
+          else
+            reloaded[n] = true;
+        }
+      else
+        {
+          ACE_ERROR ((LM_ERROR, "ERROR: reload failed %C\n", when));
+          ++errors;
+        }
+
+      delete event;
+      delete routing_slip;
+
+      Routing_Slip_Persistence_Manager *next = rspm->load_next ();
+      delete rspm;
+      rspm = next;
+    }
+
+  for (int n = 0; n != next_event; ++n)
+    if (expected[n].length () != 0 && !reloaded[n])
+      {
+        ACE_ERROR ((LM_ERROR,
+                    "ERROR: event %d not reloaded %C\n",
+                    n,
+                    when));
+        ++errors;
+      }
+
+  return errors;
+}
+
+/// Write one more event, close the log, and damage the end of its
+/// last record with @a damage.  The event must then be lost, and the
+/// log must be cut back to its size before the event.
+int
+test_damaged_tail (const char *when,
+                   void (*damage) (ACE_HANDLE, ACE_OFF_T, ACE_OFF_T))
+{
+  int errors = 0;
+  ACE_OFF_T const good_size = ACE_OS::filesize (filename);
+
+  {
+    WAL_Event_Persistence_Factory factory;
+    errors += reload (factory, when);
+    int const n = next_event;
+    errors += write_event (factory, 0, false);
+    expected[n].clear ();
+  }
+
+  ACE_OFF_T const size = ACE_OS::filesize (filename);
+  ACE_HANDLE handle = ACE_OS::open (filename, O_RDWR | O_BINARY);
+  damage (handle, good_size, size);
+  ACE_OS::close (handle);
+
+  {
+    WAL_Event_Persistence_Factory factory;
+    errors += reload (factory, when);
+  }
+
+  if (ACE_OS::filesize (filename) != good_size)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  "ERROR: the log has %q bytes instead of %q %C\n",
+                  static_cast<ACE_INT64> (ACE_OS::filesize (filename)),
+                  static_cast<ACE_INT64> (good_size),
+                  when));
+      ++errors;
+    }
+
+  return errors;
+}
+
+/// A crash in the middle of the write of the last record.
+void
+truncate_record (ACE_HANDLE handle, ACE_OFF_T good_size, ACE_OFF_T size)
+{
+  ACE_OS::ftruncate (handle, good_size + (size - good_size) / 2);
+}
+
+/// The last record was not written completely before the crash, but
+/// the file system kept its size.
+void
+corrupt_record (ACE_HANDLE handle, ACE_OFF_T, ACE_OFF_T size)
+{
+  char byte = 0;
+  ACE_OS::pread (handle, &byte, 1, size - 1);
+  byte = static_cast<char> (byte ^ 0x5a);
+  ACE_OS::pwrite (handle, &byte, 1, size - 1);
+}
+
+/// A record that stores the first event again with an empty payload,
+/// but with a wrong CRC, instead of the last record.
+void
+append_garbage (ACE_HANDLE handle, ACE_OFF_T good_size, ACE_OFF_T)
+{
+  static const char garbage[] =
+    { 1, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 'j', 'u', 'n', 'k' };
+  ACE_OS::ftruncate (handle, good_size);
+  ACE_OS::pwrite (handle, garbage, sizeof garbage, good_size);
+}
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  if (parse_args (argc, argv) != 0)
+    return 1;
+
+  ACE_OS::unlink (filename);
+
+  int errors = 0;
+
+  // Enough records to go through a few checkpoints of the 4K log.
+  {
+    WAL_Event_Persistence_Factory factory;
+    errors += reload (factory, "when it is created", 4096);
+    for (int n = 0; n != nevents; ++n)
+      errors += write_event (factory, n % 4, n % 3 == 0);
+  }
+
+  {
+    WAL_Event_Persistence_Factory factory;
+    errors += reload (factory, "after a shutdown");
+  }
+
+  errors += test_damaged_tail ("after a torn record", truncate_record);
+  errors += test_damaged_tail ("after a corrupt record", corrupt_record);
+  errors += test_damaged_tail ("after garbage", append_garbage);
+
+  // The recovered log takes new records.
+  {
+    WAL_Event_Persistence_Factory factory;
+    errors += reload (factory, "after the recovery");
+    errors += write_event (factory, 1, false);
+  }
+
+  {
+    WAL_Event_Persistence_Factory factory;
+    errors += reload (factory, "after a write to the recovered log");
+  }
+
+  ACE_OS::unlink (filename);
+
+  ACE_DEBUG ((LM_DEBUG, "%d events written, %d errors\n", next_event, errors));
+
+  return errors == 0 ? 0 : 1;
+}
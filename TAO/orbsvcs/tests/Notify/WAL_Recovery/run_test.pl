@@ -0,0 +1,31 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+     & eval 'exec perl -S $0 $argv:q'
+     if 0;
+
+# -*- perl -*-
+
+use lib "$ENV{ACE_ROOT}/bin";
+use PerlACE::TestTarget;
+
+$status = 0;
+
+my $test = PerlACE::TestTarget::create_target (1) || die "Create target 1 failed\n";
+
+my $logfile = "WAL_Recovery.log";
+my $test_logfile = $test->LocalFile ($logfile);
+$test->DeleteFile ($logfile);
+
+print STDERR "================ Notify write-ahead log recovery test\n";
+
+$WR = $test->CreateProcess ("WAL_Recovery", "-f $test_logfile");
+
+$test_status = $WR->SpawnWaitKill ($test->ProcessStartWaitInterval() + 45);
+
+if ($test_status != 0) {
+    print STDERR "ERROR: WAL_Recovery returned $test_status\n";
+    $status = 1;
+}
+
+$test->DeleteFile ($logfile);
+
+exit $status;
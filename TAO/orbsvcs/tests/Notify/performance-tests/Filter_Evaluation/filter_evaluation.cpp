@@ -0,0 +1,346 @@
+#include "ace/Get_Opt.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/OS_NS_stdlib.h"
+
+#include "tao/AnyTypeCode/ULongSeqA.h"
+#include "tao/AnyTypeCode/DoubleSeqA.h"
+
+#include "orbsvcs/Notify/Notify_Constraint_Interpreter.h"
+#include "orbsvcs/Notify/Notify_Constraint_Visitors.h"
+#include "orbsvcs/Notify/Subscription_Index.h"
+
+int nfilters = 10;
+int niterations = 20000;
+
+/// The constraints of the filters.  The last ones have parts that are
+/// evaluated by TAO_Notify_Constraint_Visitor.
+const char *constraints[] =
+  {
+    "$domain_name == 'Finance' and $type_name == 'Quote'",
+    "$.header.fixed_header.event_name == 'IBM'",
+    "$price > 150.0 or $volume < 100",
+    "$.filterable_data(price) * $volume > 1000000",
+    "exist $.filterable_data(exchange) and 'NYSE' ~ $exchange",
+    "$.header.variable_header(Priority) >= 3 and not ($volume == 0)",
+    "($price - $open) / $open > 0.05",
+    "$symbol == 'HP' or $symbol == 'DELL' or $symbol == 'SUN'",
+    "$volume in $.header.variable_header(Limits)",
+    "$.filterable_data(history)._length > 2"
+  };
+
+/// Constraints with the results they must have on the first event,
+/// whose symbol is "IBM", exchange "NYSE", price 100.0 and volume 0.
+/// A "~" operand that is not a string is a substring of nothing.
+struct Expected_Result
+{
+  const char *constraint_;
+  bool result_;
+};
+
+const Expected_Result twiddles[] =
+  {
+    { "'IB' ~ $symbol", true },
+    { "'NYSE' ~ $exchange and $symbol ~ 'IBM'", true },
+    { "$volume ~ $symbol", false },
+    { "'100' ~ $price", false },
+    { "$price ~ $price", false },
+    { "$.header.variable_header(Priority) ~ 'NYSE'", false },
+    { "not ($volume ~ $exchange)", true },
+    { "$volume ~ $exchange or $symbol == 'IBM'", true }
+  };
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("f:n:"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'f':
+        nfilters = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'n':
+        niterations = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage:  %s "
+                           "-f <number of filters> "
+                           "-n <iterations> "
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+
+  if (nfilters < 1 || niterations < 1)
+    ACE_ERROR_RETURN ((LM_ERROR, "Invalid filter or iteration count\n"), -1);
+
+  // Indicates successful parsing of the command line
+  return 0;
+}
+
+/// Make the events the filters are evaluated on; they only differ in
+/// the values of some of their fields.
+void
+make_event (CosNotification::StructuredEvent &event, CORBA::ULong n)
+{
+  static const char *symbols[] = { "IBM", "HP", "DELL", "SUN" };
+
+  event.header.fixed_header.event_type.domain_name =
+    CORBA::string_dup (n % 3 == 0 ? "Finance" : "Sports");
+  event.header.fixed_header.event_type.type_name =
+    CORBA::string_dup ("Quote");
+  event.header.fixed_header.event_name =
+    CORBA::string_dup (symbols[n % 4]);
+
+  event.header.variable_header.length (2);
+  event.header.variable_header[0].name = CORBA::string_dup ("Priority");
+  event.header.variable_header[0].value <<= static_cast<CORBA::Short> (n % 5);
+  CORBA::ULongSeq limits (2);
+  limits.length (2);
+  limits[0] = 100;
+  limits[1] = 5000;
+  event.header.variable_header[1].name = CORBA::string_dup ("Limits");
+  event.header.variable_header[1].value <<= limits;
+
+  event.filterable_data.length (6);
+  event.filterable_data[0].name = CORBA::string_dup ("symbol");
+  event.filterable_data[0].value <<= symbols[n % 4];
+  event.filterable_data[1].name = CORBA::string_dup ("price");
+  event.filterable_data[1].value <<= 100.0 + (n % 100);
+  event.filterable_data[2].name = CORBA::string_dup ("open");
+  event.filterable_data[2].value <<= 100.0;
+  event.filterable_data[3].name = CORBA::string_dup ("volume");
+  event.filterable_data[3].value <<= static_cast<CORBA::ULong> (n * 50 % 20000);
+  event.filterable_data[4].name = CORBA::string_dup ("history");
+  CORBA::DoubleSeq history (n % 5);
+  history.length (n % 5);
+  for (CORBA::ULong i = 0; i < history.length (); ++i)
+    history[i] = 100.0 + i;
+  event.filterable_data[4].value <<= history;
+  event.filterable_data[5].name = CORBA::string_dup ("exchange");
+  event.filterable_data[5].value <<= (n % 2 == 0 ? "NYSE" : "NASDAQ");
+}
+
+/// Check the results of the constraints in <twiddles> on <event>,
+/// with the expression trees and with the compiled programs.
+int
+test_twiddles (const CosNotification::StructuredEvent &event)
+{
+  int errors = 0;
+  size_t const ntwiddles = sizeof (twiddles) / sizeof (twiddles[0]);
+
+  for (size_t i = 0; i != ntwiddles; ++i)
+    {
+      TAO_Notify_Constraint_Interpreter filter;
+      CosNotifyFilter::ConstraintExp exp;
+      exp.constraint_expr = CORBA::string_dup (twiddles[i].constraint_);
+      filter.build_tree (exp);
+
+      TAO_Notify_Constraint_Visitor visitor;
+      TAO_Notify_Constraint_Context context (event);
+
+      bool const tree_result =
+        visitor.bind_structured_event (event) == 0
+        && filter.evaluate (visitor);
+      bool const program_result = filter.evaluate (context);
+
+      if (tree_result != twiddles[i].result_
+          || program_result != twiddles[i].result_)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      "ERROR: <%C> is %C with the tree and %C with the "
+                      "program instead of %C\n",
+                      twiddles[i].constraint_,
+                      tree_result ? "true" : "false",
+                      program_result ? "true" : "false",
+                      twiddles[i].result_ ? "true" : "false"));
+          ++errors;
+        }
+    }
+
+  return errors;
+}
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  try
+    {
+      CORBA::ORB_var orb =
+        CORBA::ORB_init (argc, argv);
+
+      if (parse_args (argc, argv) != 0)
+        return 1;
+
+      size_t const nconstraints = sizeof (constraints) / sizeof (constraints[0]);
+
+      TAO_Notify_Constraint_Interpreter *filters = 0;
+      ACE_NEW_RETURN (filters,
+                      TAO_Notify_Constraint_Interpreter[nfilters],
+                      1);
+
+      for (int i = 0; i != nfilters; ++i)
+        {
+          CosNotifyFilter::ConstraintExp exp;
+          exp.constraint_expr =
+            CORBA::string_dup (constraints[i % nconstraints]);
+          filters[i].build_tree (exp);
+        }
+
+      CORBA::ULong const nevents = 64;
+      CosNotification::StructuredEvent events[nevents];
+
+      for (CORBA::ULong i = 0; i != nevents; ++i)
+        make_event (events[i], i);
+
+      // Evaluate all the filters on every event, the way
+      // TAO_Notify_ETCL_Filter::match_structured() did with the
+      // expression trees, and then with the compiled programs.  Both
+      // must give the same results.
+      unsigned long tree_matches = 0;
+      unsigned long program_matches = 0;
+      int errors = test_twiddles (events[0]);
+
+      ACE_hrtime_t tree_start = ACE_OS::gethrtime ();
+      for (int n = 0; n != niterations; ++n)
+        {
+          const CosNotification::StructuredEvent &event = events[n % nevents];
+          TAO_Notify_Constraint_Visitor visitor;
+
+          if (visitor.bind_structured_event (event) != 0)
+            continue;
+
+          for (int i = 0; i != nfilters; ++i)
+            if (filters[i].evaluate (visitor))
+              ++tree_matches;
+        }
+      ACE_hrtime_t tree_end = ACE_OS::gethrtime ();
+
+      ACE_hrtime_t program_start = ACE_OS::gethrtime ();
+      for (int n = 0; n != niterations; ++n)
+        {
+          TAO_Notify_Constraint_Context context (events[n % nevents]);
+
+          for (int i = 0; i != nfilters; ++i)
+            if (filters[i].evaluate (context))
+              ++program_matches;
+        }
+      ACE_hrtime_t program_end = ACE_OS::gethrtime ();
+
+      for (CORBA::ULong e = 0; e != nevents; ++e)
+        {
+          TAO_Notify_Constraint_Visitor visitor;
+          TAO_Notify_Constraint_Context context (events[e]);
+
+          if (visitor.bind_structured_event (events[e]) != 0)
+            continue;
+
+          for (int i = 0; i != nfilters; ++i)
+            if (filters[i].evaluate (visitor) != filters[i].evaluate (context))
+              {
+                ACE_ERROR ((LM_ERROR,
+                            "ERROR: different results for <%C> on event %u\n",
+                            constraints[i % nconstraints],
+                            e));
+                ++errors;
+              }
+        }
+
+      // Look every event up in a subscription index of the filters,
+      // and only evaluate the candidates.  The matches must be the same.
+      TAO_Notify_Subscription_Index index;
+      CORBA::ULong *slots = 0;
+      ACE_NEW_RETURN (slots, CORBA::ULong[nfilters], 1);
+
+      for (int i = 0; i != nfilters; ++i)
+        {
+          slots[i] = index.add (i);
+
+          TAO_Notify_Constraint_Program::Predicates predicates;
+          if (filters[i].predicates (predicates))
+            index.guard (slots[i], predicates);
+        }
+
+      unsigned long index_matches = 0;
+      unsigned long candidates = 0;
+
+      ACE_hrtime_t index_start = ACE_OS::gethrtime ();
+      for (int n = 0; n != niterations; ++n)
+        {
+          const CosNotification::StructuredEvent &event = events[n % nevents];
+          TAO_Notify_Subscription_Index::Candidates found;
+          index.candidates (event, found);
+
+          TAO_Notify_Constraint_Context context (event);
+
+          for (int i = 0; i != nfilters; ++i)
+            if (found.contains (slots[i]))
+              {
+                ++candidates;
+                if (filters[i].evaluate (context))
+                  ++index_matches;
+              }
+        }
+      ACE_hrtime_t index_end = ACE_OS::gethrtime ();
+
+      delete [] slots;
+      delete [] filters;
+
+      ACE_High_Res_Timer::global_scale_factor_type gsf =
+        ACE_High_Res_Timer::global_scale_factor ();
+
+      double const tree_usecs =
+        static_cast<double> (tree_end - tree_start) / gsf;
+      double const program_usecs =
+        static_cast<double> (program_end - program_start) / gsf;
+      double const index_usecs =
+        static_cast<double> (index_end - index_start) / gsf;
+      double const evaluations =
+        static_cast<double> (nfilters) * niterations;
+
+      ACE_DEBUG ((LM_DEBUG,
+                  "%d filters, %d events\n"
+                  "expression trees:  %.3f usecs per evaluation, "
+                  "%u matches\n"
+                  "compiled programs: %.3f usecs per evaluation, "
+                  "%u matches\n"
+                  "subscription index: %.3f usecs per evaluation, "
+                  "%u matches, %u candidates\n",
+                  nfilters,
+                  niterations,
+                  tree_usecs / evaluations,
+                  static_cast<unsigned int> (tree_matches),
+                  program_usecs / evaluations,
+                  static_cast<unsigned int> (program_matches),
+                  index_usecs / evaluations,
+                  static_cast<unsigned int> (index_matches),
+                  static_cast<unsigned int> (candidates)));
+
+      orb->destroy ();
+
+      if (errors != 0 || tree_matches != program_matches)
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "ERROR: the compiled programs do not match "
+                           "the expression trees\n"),
+                          1);
+
+      if (index_matches != program_matches)
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "ERROR: the subscription index missed "
+                           "matching filters\n"),
+                          1);
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Exception caught:");
+      return 1;
+    }
+
+  return 0;
+}
@@ -0,0 +1,48 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+     & eval 'exec perl -S $0 $argv:q'
+     if 0;
+
+# -*- perl -*-
+
+use lib "$ENV{ACE_ROOT}/bin";
+use PerlACE::TestTarget;
+
+$status = 0;
+
+my $filters = 10;
+my $events = 20000;
+
+for ($iter = 0; $iter <= $#ARGV; $iter++) {
+    if ($ARGV[$iter] eq "-h" || $ARGV[$iter] eq "-?") {
+        print "Run_Test Perl script for the Notify filter evaluation test\n\n";
+        print "run_test [-f filters] [-n events] [-h]\n";
+        print "\n";
+        print "-f filters          -- number of filters\n";
+        print "-n events           -- number of events\n";
+        print "-h                  -- prints this information\n";
+        exit 0;
+    }
+    elsif ($ARGV[$iter] eq "-f") {
+        $filters = $ARGV[$iter + 1];
+        $iter++;
+    }
+    elsif ($ARGV[$iter] eq "-n") {
+        $events = $ARGV[$iter + 1];
+        $iter++;
+    }
+}
+
+my $test = PerlACE::TestTarget::create_target (1) || die "Create target 1 failed\n";
+
+print STDERR "================ Notify filter evaluation test\n";
+
+$FE = $test->CreateProcess ("filter_evaluation", "-f $filters -n $events");
+
+$test_status = $FE->SpawnWaitKill ($test->ProcessStartWaitInterval() + 285);
+
+if ($test_status != 0) {
+    print STDERR "ERROR: filter_evaluation returned $test_status\n";
+    $status = 1;
+}
+
+exit $status;
@@ -0,0 +1,208 @@
+#include "TestC.h"
+#include "tao/debug.h"
+#include "ace/Get_Opt.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/Sched_Params.h"
+#include "ace/Stats.h"
+#include "ace/Throughput_Stats.h"
+#include "ace/OS_NS_errno.h"
+#include "ace/OS_NS_time.h"
+
+const ACE_TCHAR *ior = ACE_TEXT("file://test.ior");
+
+int niterations = 1000;
+
+#if (TAO_HAS_AMI_COROUTINES == 1)
+
+/// The replies not received yet
+int pending_replies = 0;
+
+/// Collect the latency results
+ACE_Basic_Stats latency_stats;
+
+/// A coroutine that runs until its first co_await, and on from there
+/// in the thread that dispatches the reply.
+struct Roundtrip_Task
+{
+  struct promise_type
+  {
+    Roundtrip_Task get_return_object (void)
+    {
+      return Roundtrip_Task ();
+    }
+
+    std::suspend_never initial_suspend (void) noexcept
+    {
+      return std::suspend_never ();
+    }
+
+    std::suspend_never final_suspend (void) noexcept
+    {
+      return std::suspend_never ();
+    }
+
+    void return_void (void)
+    {
+    }
+
+    void unhandled_exception (void)
+    {
+    }
+  };
+};
+
+Roundtrip_Task
+test_method (Test::Roundtrip_ptr roundtrip)
+{
+  try
+    {
+      Test::Timestamp send_time =
+        co_await roundtrip->co_test_method (ACE_OS::gethrtime ());
+
+      ACE_hrtime_t now = ACE_OS::gethrtime ();
+      latency_stats.sample (now - send_time);
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("test_method:");
+    }
+
+  --pending_replies;
+}
+
+#endif /* TAO_HAS_AMI_COROUTINES == 1 */
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("k:i:"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'k':
+        ior = get_opts.opt_arg ();
+        break;
+
+      case 'i':
+        niterations = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage:  %s "
+                           "-k <ior> "
+                           "-i <niterations> "
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+  // Indicates successful parsing of the command line
+  return 0;
+}
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  int priority =
+    (ACE_Sched_Params::priority_min (ACE_SCHED_FIFO)
+     + ACE_Sched_Params::priority_max (ACE_SCHED_FIFO)) / 2;
+  // Enable FIFO scheduling, e.g., RT scheduling class on Solaris.
+
+  if (ACE_OS::sched_params (ACE_Sched_Params (ACE_SCHED_FIFO,
+                                              priority,
+                                              ACE_SCOPE_PROCESS)) != 0)
+    {
+      if (ACE_OS::last_error () == EPERM)
+        {
+          ACE_DEBUG ((LM_DEBUG,
+                      "co_client (%P|%t): user is not superuser, "
+                      "test runs in time-shared class\n"));
+        }
+      else
+        ACE_ERROR ((LM_ERROR,
+                    "co_client (%P|%t): sched_params failed\n"));
+    }
+
+  try
+    {
+      CORBA::ORB_var orb =
+        CORBA::ORB_init (argc, argv);
+
+      if (parse_args (argc, argv) != 0)
+        return 1;
+
+      CORBA::Object_var object =
+        orb->string_to_object (ior);
+
+      Test::Roundtrip_var roundtrip =
+        Test::Roundtrip::_narrow (object.in ());
+
+      if (CORBA::is_nil (roundtrip.in ()))
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "Nil Test::Roundtrip reference <%s>\n",
+                           ior),
+                          1);
+
+      for (int j = 0; j < 100; ++j)
+        {
+          ACE_hrtime_t start = 0;
+          (void) roundtrip->test_method (start);
+        }
+
+#if (TAO_HAS_AMI_COROUTINES == 1)
+      // Unlike the callback client there is no reply handler servant,
+      // so no POA to activate.
+      pending_replies = niterations;
+
+      ACE_hrtime_t test_start = ACE_OS::gethrtime ();
+
+      for (int i = 0; i != niterations; ++i)
+        {
+          // Invoke asynchronous operation....
+          test_method (roundtrip.in ());
+
+          if (orb->work_pending ())
+            orb->perform_work ();
+        }
+
+      ACE_Time_Value tv (0, 2000);
+
+      while (pending_replies > 0)
+        {
+          orb->perform_work (tv);
+        }
+
+      ACE_hrtime_t test_end = ACE_OS::gethrtime ();
+
+      ACE_DEBUG ((LM_DEBUG, "High resolution timer calibration...."));
+      ACE_High_Res_Timer::global_scale_factor_type gsf =
+        ACE_High_Res_Timer::global_scale_factor ();
+      ACE_DEBUG ((LM_DEBUG, "done\n"));
+
+      latency_stats.dump_results (ACE_TEXT("AMI Coroutine Latency"), gsf);
+
+      ACE_Throughput_Stats::dump_throughput (ACE_TEXT("Total"), gsf,
+                                             test_end - test_start,
+                                             niterations);
+#else
+      ACE_DEBUG ((LM_DEBUG,
+                  "co_client (%P|%t): built without C++20 coroutines, "
+                  "nothing measured\n"));
+#endif /* TAO_HAS_AMI_COROUTINES == 1 */
+
+      roundtrip->shutdown ();
+
+      orb->destroy ();
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Exception caught: ");
+      return 1;
+    }
+
+  return 0;
+}
+
@@ -10,11 +10,15 @@ use PerlACE::TestTarget;
 $status = 0;
 $debug_level = '0';
 $iterations = '150000';
+$client_exe = 'client';
 
 foreach $i (@ARGV) {
     if ($i eq '-debug') {
         $debug_level = '10';
     }
+    elsif ($i eq '-co') {
+        $client_exe = 'co_client';
+    }
 }
 
 print STDERR "================ AMI Latency test\n";
@@ -32,7 +36,7 @@ $SV = $server->CreateProcess ("server",
                               "-ORBdebuglevel $debug_level " .
                               "-o $server_iorfile");
 
-$CL = $client->CreateProcess ("client",
+$CL = $client->CreateProcess ($client_exe,
                               "-i $iterations " .
                               "-k file://$client_iorfile");
 $server_status = $SV->Spawn ();
@@ -0,0 +1,61 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+     & eval 'exec perl -S $0 $argv:q'
+     if 0;
+
+# -*- perl -*-
+
+use lib "$ENV{ACE_ROOT}/bin";
+use PerlACE::TestTarget;
+
+$status = 0;
+
+my $threads = 16;
+my $keys = 64;
+my $iterations = 2000;
+my @shards = (1, 16);
+
+for ($iter = 0; $iter <= $#ARGV; $iter++) {
+    if ($ARGV[$iter] eq "-h" || $ARGV[$iter] eq "-?") {
+        print "Run_Test Perl script for the ObjectKey table contention test\n\n";
+        print "run_test [-n num] [-t threads] [-k keys] [-h]\n";
+        print "\n";
+        print "-n num              -- iterations of each thread\n";
+        print "-t threads          -- number of threads\n";
+        print "-k keys             -- number of private and of shared keys\n";
+        print "-h                  -- prints this information\n";
+        exit 0;
+    }
+    elsif ($ARGV[$iter] eq "-n") {
+        $iterations = $ARGV[$iter + 1];
+        $iter++;
+    }
+    elsif ($ARGV[$iter] eq "-t") {
+        $threads = $ARGV[$iter + 1];
+        $iter++;
+    }
+    elsif ($ARGV[$iter] eq "-k") {
+        $keys = $ARGV[$iter + 1];
+        $iter++;
+    }
+}
+
+my $test = PerlACE::TestTarget::create_target (1) || die "Create target 1 failed\n";
+
+print STDERR "================ ObjectKey table contention test\n";
+
+foreach my $shard_count (@shards) {
+    $ST = $test->CreateProcess ("stress",
+                                "-ORBSvcConfDirective " .
+                                "\"static Resource_Factory " .
+                                "'-ORBObjectKeyTableShards $shard_count'\" " .
+                                "-t $threads -k $keys -n $iterations");
+
+    $test_status = $ST->SpawnWaitKill ($test->ProcessStartWaitInterval() + 285);
+
+    if ($test_status != 0) {
+        print STDERR "ERROR: stress returned $test_status\n";
+        $status = 1;
+    }
+}
+
+exit $status;
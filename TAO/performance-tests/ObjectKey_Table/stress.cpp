@@ -0,0 +1,174 @@
+#include "ace/Get_Opt.h"
+#include "ace/Task.h"
+#include "ace/Atomic_Op.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_string.h"
+
+#include "tao/ORB.h"
+#include "tao/ORB_Core.h"
+#include "tao/ObjectKey_Table.h"
+#include "tao/Refcounted_ObjectKey.h"
+
+int nthreads = 16;
+int nkeys = 64;
+int niterations = 20000;
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("t:k:n:"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 't':
+        nthreads = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'k':
+        nkeys = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'n':
+        niterations = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage:  %s "
+                           "-t <number of threads> "
+                           "-k <keys per thread> "
+                           "-n <iterations per thread> "
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+
+  if (nthreads < 1 || nkeys < 1 || niterations < 1)
+    ACE_ERROR_RETURN ((LM_ERROR, "Invalid thread, key or iteration count\n"), -1);
+
+  // Indicates successful parsing of the command line
+  return 0;
+}
+
+/// Make an object key that looks like the ones of a persistent POA.
+void
+make_key (TAO::ObjectKey &key, const char *owner, int id)
+{
+  char buf[64];
+  int const len =
+    ACE_OS::snprintf (buf, sizeof buf, "RootPOA/Stress/%s/%d", owner, id);
+
+  key.length (static_cast<CORBA::ULong> (len));
+  ACE_OS::memcpy (key.get_buffer (), buf, len);
+}
+
+/// Bind all the keys, the way profiles are created for a set of object
+/// references, and unbind them again.
+class Stress_Task : public ACE_Task_Base
+{
+public:
+  Stress_Task (TAO::ObjectKey_Table &table)
+    : table_ (table),
+      next_thread_ (0),
+      errors_ (0)
+  {
+  }
+
+  virtual int svc (void)
+  {
+    TAO::ObjectKey *keys = 0;
+    TAO::Refcounted_ObjectKey **bound = 0;
+    ACE_NEW_RETURN (keys, TAO::ObjectKey[2 * nkeys], -1);
+    ACE_NEW_RETURN (bound, TAO::Refcounted_ObjectKey *[2 * nkeys], -1);
+
+    // Half of the keys are private to this thread, half are shared by
+    // all the threads.
+    char owner[32];
+    ACE_OS::snprintf (owner, sizeof owner, "thread%ld",
+                      static_cast<long> (this->next_thread_++));
+
+    for (int i = 0; i != nkeys; ++i)
+      {
+        make_key (keys[i], owner, i);
+        make_key (keys[nkeys + i], "shared", i);
+      }
+
+    for (int n = 0; n != niterations; ++n)
+      {
+        for (int i = 0; i != 2 * nkeys; ++i)
+          if (this->table_.bind (keys[i], bound[i]) == -1 || bound[i] == 0)
+            ++this->errors_;
+
+        for (int i = 0; i != 2 * nkeys; ++i)
+          this->table_.unbind (bound[i]);
+      }
+
+    delete [] bound;
+    delete [] keys;
+    return 0;
+  }
+
+  TAO::ObjectKey_Table &table_;
+  ACE_Atomic_Op<TAO_SYNCH_MUTEX, long> next_thread_;
+  ACE_Atomic_Op<TAO_SYNCH_MUTEX, long> errors_;
+};
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  try
+    {
+      CORBA::ORB_var orb =
+        CORBA::ORB_init (argc, argv);
+
+      if (parse_args (argc, argv) != 0)
+        return 1;
+
+      TAO::ObjectKey_Table &table = orb->orb_core ()->object_key_table ();
+
+      Stress_Task task (table);
+
+      ACE_hrtime_t test_start = ACE_OS::gethrtime ();
+      task.activate (THR_NEW_LWP | THR_JOINABLE, nthreads, 1);
+      task.wait ();
+      ACE_hrtime_t test_end = ACE_OS::gethrtime ();
+
+      ACE_High_Res_Timer::global_scale_factor_type gsf =
+        ACE_High_Res_Timer::global_scale_factor ();
+
+      double const usecs =
+        static_cast<double> (test_end - test_start) / gsf;
+      double const ops =
+        2.0 * 2 * nkeys * static_cast<double> (nthreads) * niterations;
+
+      ACE_DEBUG ((LM_DEBUG,
+                  "ObjectKey table: %B shard(s), "
+                  "%d threads, %d keys per thread\n"
+                  "%.0f binds and unbinds in %.3f seconds: %.0f ops/sec\n",
+                  table.shards (),
+                  nthreads,
+                  2 * nkeys,
+                  ops,
+                  usecs / 1000000.0,
+                  usecs > 0 ? ops * 1000000.0 / usecs : 0.0));
+
+      orb->destroy ();
+
+      if (task.errors_.value () != 0)
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "ERROR: %d binds failed\n",
+                           static_cast<int> (task.errors_.value ())),
+                          1);
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Exception caught:");
+      return 1;
+    }
+
+  return 0;
+}
@@ -1,6 +1,7 @@
 #include "TestC.h"
 #include "ace/High_Res_Timer.h"
 #include "ace/Get_Opt.h"
+#include "ace/Message_Block.h"
 #include "tao/Strategies/advanced_resource.h"
 
 const ACE_TCHAR *ior = ACE_TEXT("file://test.ior");
@@ -8,11 +9,12 @@ int message_size  = 2048;
 int message_count = 10 * 1024;
 int test_runs   = 6;
 int do_shutdown = 0;
+int use_message_block = 0;
 
 int
 parse_args (int argc, ACE_TCHAR *argv[])
 {
-  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("k:b:i:n:x"));
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("k:b:i:n:xm"));
   int c;
 
   while ((c = get_opts ()) != -1)
@@ -38,6 +40,10 @@ parse_args (int argc, ACE_TCHAR *argv[])
         do_shutdown = 1;
         break;
 
+      case 'm':
+        use_message_block = 1;
+        break;
+
       case '?':
       default:
         ACE_ERROR_RETURN ((LM_ERROR,
@@ -46,6 +52,7 @@ parse_args (int argc, ACE_TCHAR *argv[])
                            "-b <message_size> "
                            "-i <message_count> "
                            "-n <test_repetitions> "
+                           "-m "
                            "\n",
                            argv [0]),
                           -1);
@@ -90,7 +97,19 @@ ACE_TMAIN(int argc, ACE_TCHAR *argv[])
                       "Testing with %d bytes per message\n",
                       message_size));
 
-          message.the_payload.length (message_size);
+#if (TAO_NO_COPY_OCTET_SEQUENCES == 1)
+          if (use_message_block)
+            {
+              // Let the payload refer to a message block, the ORB can
+              // then marshal it (and with -ORBZeroCopyOctetSequences
+              // queue it) without copying the data.
+              ACE_Message_Block mb (message_size);
+              mb.wr_ptr (message_size);
+              message.the_payload.replace (message_size, &mb);
+            }
+          else
+#endif /* TAO_NO_COPY_OCTET_SEQUENCES == 1 */
+            message.the_payload.length (message_size);
 
           Test::Receiver_var receiver =
             receiver_factory->create_receiver ();
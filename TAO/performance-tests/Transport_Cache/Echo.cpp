@@ -0,0 +1,18 @@
+#include "Echo.h"
+
+Echo::Echo (CORBA::ORB_ptr orb)
+  : orb_ (CORBA::ORB::_duplicate (orb))
+{
+}
+
+CORBA::Long
+Echo::ping (CORBA::Long value)
+{
+  return value;
+}
+
+void
+Echo::shutdown (void)
+{
+  this->orb_->shutdown (0);
+}
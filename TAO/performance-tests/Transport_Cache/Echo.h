@@ -0,0 +1,26 @@
+#ifndef ECHO_H
+#define ECHO_H
+#include /**/ "ace/pre.h"
+
+#include "TestS.h"
+
+/// Implement the Test::Echo interface
+class Echo
+  : public virtual POA_Test::Echo
+{
+public:
+  /// Constructor
+  Echo (CORBA::ORB_ptr orb);
+
+  // = The skeleton methods
+  virtual CORBA::Long ping (CORBA::Long value);
+
+  virtual void shutdown (void);
+
+private:
+  /// Use an ORB reference to shutdown the application.
+  CORBA::ORB_var orb_;
+};
+
+#include /**/ "ace/post.h"
+#endif /* ECHO_H */
@@ -0,0 +1,172 @@
+#include "TestC.h"
+#include "ace/Get_Opt.h"
+#include "ace/Task.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/OS_NS_stdio.h"
+
+#include "tao/ORB_Core.h"
+#include "tao/Resource_Factory.h"
+#include "tao/Strategies/advanced_resource.h"
+
+const ACE_TCHAR *ior_prefix = ACE_TEXT("file://server");
+int nservers = 8;
+int nthreads = 16;
+int niterations = 20000;
+int do_shutdown = 1;
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("xk:n:t:i:"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'x':
+        do_shutdown = 0;
+        break;
+
+      case 'k':
+        ior_prefix = get_opts.opt_arg ();
+        break;
+
+      case 'n':
+        nservers = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 't':
+        nthreads = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'i':
+        niterations = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage:  %s "
+                           "-k <ior prefix> "
+                           "-n <number of servers> "
+                           "-t <number of threads> "
+                           "-i <iterations per thread> "
+                           "-x (disable shutdown) "
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+
+  if (nservers < 1 || nthreads < 1 || niterations < 1)
+    ACE_ERROR_RETURN ((LM_ERROR, "Invalid server, thread or iteration count\n"), -1);
+
+  // Indicates successful parsing of the command line
+  return 0;
+}
+
+/// Invoke on all the servers in turn; each call looks up a
+/// connection in the transport cache and returns it afterwards.
+class Client_Task : public ACE_Task_Base
+{
+public:
+  Client_Task (Test::Echo_var *echos)
+    : echos_ (echos)
+  {
+  }
+
+  virtual int svc (void)
+  {
+    try
+      {
+        for (int i = 0; i != niterations; ++i)
+          (void) this->echos_[i % nservers]->ping (i);
+      }
+    catch (const CORBA::Exception& ex)
+      {
+        ex._tao_print_exception ("Exception caught in thread:");
+      }
+    return 0;
+  }
+
+private:
+  Test::Echo_var *echos_;
+};
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  try
+    {
+      CORBA::ORB_var orb =
+        CORBA::ORB_init (argc, argv);
+
+      if (parse_args (argc, argv) != 0)
+        return 1;
+
+      Test::Echo_var *echos = 0;
+      ACE_NEW_RETURN (echos, Test::Echo_var[nservers], 1);
+
+      for (int i = 0; i != nservers; ++i)
+        {
+          ACE_TCHAR ior[MAXPATHLEN];
+          ACE_OS::snprintf (ior, MAXPATHLEN,
+                            ACE_TEXT ("%s%d.ior"), ior_prefix, i);
+
+          CORBA::Object_var object = orb->string_to_object (ior);
+
+          echos[i] = Test::Echo::_narrow (object.in ());
+
+          if (CORBA::is_nil (echos[i].in ()))
+            ACE_ERROR_RETURN ((LM_ERROR,
+                               "Nil Test::Echo reference <%s>\n",
+                               ior),
+                              1);
+
+          // Set up the connection before the measurement starts.
+          (void) echos[i]->ping (0);
+        }
+
+      Client_Task task (echos);
+
+      ACE_hrtime_t test_start = ACE_OS::gethrtime ();
+      task.activate (THR_NEW_LWP | THR_JOINABLE, nthreads, 1);
+      task.wait ();
+      ACE_hrtime_t test_end = ACE_OS::gethrtime ();
+
+      ACE_High_Res_Timer::global_scale_factor_type gsf =
+        ACE_High_Res_Timer::global_scale_factor ();
+
+      double const usecs =
+        static_cast<double> (test_end - test_start) / gsf;
+      double const calls =
+        static_cast<double> (nthreads) * niterations;
+
+      ACE_DEBUG ((LM_DEBUG,
+                  "Transport cache: %d shard(s), "
+                  "%d threads, %d servers\n"
+                  "%.0f calls in %.3f seconds: %.0f calls/sec\n",
+                  orb->orb_core ()->resource_factory ()->cache_shards (),
+                  nthreads,
+                  nservers,
+                  calls,
+                  usecs / 1000000.0,
+                  usecs > 0 ? calls * 1000000.0 / usecs : 0.0));
+
+      if (do_shutdown)
+        {
+          for (int i = 0; i != nservers; ++i)
+            echos[i]->shutdown ();
+        }
+
+      delete [] echos;
+
+      orb->destroy ();
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Exception caught:");
+      return 1;
+    }
+
+  return 0;
+}
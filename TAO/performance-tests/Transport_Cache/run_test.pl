@@ -0,0 +1,113 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+     & eval 'exec perl -S $0 $argv:q'
+     if 0;
+
+# -*- perl -*-
+
+use lib "$ENV{ACE_ROOT}/bin";
+use PerlACE::TestTarget;
+
+$status = 0;
+$debug_level = '0';
+
+my $servers = 8;
+my $threads = 16;
+my $iterations = 20000;
+my @shards = (1, 16);
+
+for ($iter = 0; $iter <= $#ARGV; $iter++) {
+    if ($ARGV[$iter] eq "-h" || $ARGV[$iter] eq "-?") {
+        print "Run_Test Perl script for the Transport Cache contention test\n\n";
+        print "run_test [-n num] [-t threads] [-s servers] [-debug] [-h]\n";
+        print "\n";
+        print "-n num              -- iterations of each client thread\n";
+        print "-t threads          -- number of client threads\n";
+        print "-s servers          -- number of servers (endpoints)\n";
+        print "-debug              -- run the server with debug output\n";
+        print "-h                  -- prints this information\n";
+        exit 0;
+    }
+    elsif ($ARGV[$iter] eq "-n") {
+        $iterations = $ARGV[$iter + 1];
+        $iter++;
+    }
+    elsif ($ARGV[$iter] eq "-t") {
+        $threads = $ARGV[$iter + 1];
+        $iter++;
+    }
+    elsif ($ARGV[$iter] eq "-s") {
+        $servers = $ARGV[$iter + 1];
+        $iter++;
+    }
+    elsif ($ARGV[$iter] eq "-debug") {
+        $debug_level = '10';
+    }
+}
+
+my $server = PerlACE::TestTarget::create_target (1) || die "Create target 1 failed\n";
+my $client = PerlACE::TestTarget::create_target (2) || die "Create target 2 failed\n";
+
+my @iorbases = map { "server$_.ior" } (0 .. $servers - 1);
+foreach my $iorbase (@iorbases) {
+    $server->DeleteFile($iorbase);
+    $client->DeleteFile($iorbase);
+}
+
+print STDERR "================ Transport Cache contention test\n";
+
+foreach my $shard_count (@shards) {
+    $SV = $server->CreateProcess ("server",
+                                  "-ORBdebuglevel $debug_level " .
+                                  "-o " . $server->LocalFile ("server") . " " .
+                                  "-n $servers");
+
+    $server_status = $SV->Spawn ();
+
+    if ($server_status != 0) {
+        print STDERR "ERROR: server returned $server_status\n";
+        exit 1;
+    }
+
+    foreach my $iorbase (@iorbases) {
+        if ($server->WaitForFileTimed ($iorbase,
+                                       $server->ProcessStartWaitInterval()) == -1) {
+            print STDERR "ERROR: cannot find file <$iorbase>\n";
+            $SV->Kill (); $SV->TimedWait (1);
+            exit 1;
+        }
+        if ($server->GetFile ($iorbase) == -1
+            || $client->PutFile ($iorbase) == -1) {
+            print STDERR "ERROR: cannot transfer file <$iorbase>\n";
+            $SV->Kill (); $SV->TimedWait (1);
+            exit 1;
+        }
+    }
+
+    $CL = $client->CreateProcess ("client",
+                                  "-ORBSvcConfDirective " .
+                                  "\"static Advanced_Resource_Factory " .
+                                  "'-ORBConnectionCacheShards $shard_count'\" " .
+                                  "-k file://" . $client->LocalFile ("server") . " " .
+                                  "-n $servers -t $threads -i $iterations");
+
+    $client_status = $CL->SpawnWaitKill ($client->ProcessStartWaitInterval() + 285);
+
+    if ($client_status != 0) {
+        print STDERR "ERROR: client returned $client_status\n";
+        $status = 1;
+    }
+
+    $server_status = $SV->WaitKill ($server->ProcessStopWaitInterval());
+
+    if ($server_status != 0) {
+        print STDERR "ERROR: server returned $server_status\n";
+        $status = 1;
+    }
+
+    foreach my $iorbase (@iorbases) {
+        $server->DeleteFile($iorbase);
+        $client->DeleteFile($iorbase);
+    }
+}
+
+exit $status;
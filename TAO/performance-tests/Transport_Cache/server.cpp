@@ -0,0 +1,185 @@
+#include "Echo.h"
+#include "ace/Get_Opt.h"
+#include "ace/Task.h"
+#include "ace/OS_NS_stdio.h"
+
+#include "tao/Strategies/advanced_resource.h"
+
+const ACE_TCHAR *ior_prefix = ACE_TEXT("server");
+int norbs = 8;
+int nthreads = 2;
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("o:n:t:"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'o':
+        ior_prefix = get_opts.opt_arg ();
+        break;
+
+      case 'n':
+        norbs = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 't':
+        nthreads = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage:  %s "
+                           "-o <iorfile prefix> "
+                           "-n <number of ORBs> "
+                           "-t <threads per ORB>"
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+
+  if (norbs < 1 || nthreads < 1)
+    ACE_ERROR_RETURN ((LM_ERROR, "Invalid ORB or thread count\n"), -1);
+
+  // Indicates successful parsing of the command line
+  return 0;
+}
+
+/// Run the event loop of one of the ORBs.
+class Worker : public ACE_Task_Base
+{
+public:
+  Worker (CORBA::ORB_ptr orb)
+    : orb_ (CORBA::ORB::_duplicate (orb))
+  {
+  }
+
+  virtual int svc (void)
+  {
+    try
+      {
+        this->orb_->run ();
+      }
+    catch (const CORBA::Exception&)
+      {
+      }
+    return 0;
+  }
+
+private:
+  CORBA::ORB_var orb_;
+};
+
+/// Activate an Echo object in @a orb and write its IOR to the file
+/// of server number @a index.
+int
+activate_echo (CORBA::ORB_ptr orb, int index)
+{
+  CORBA::Object_var poa_object =
+    orb->resolve_initial_references("RootPOA");
+
+  PortableServer::POA_var root_poa =
+    PortableServer::POA::_narrow (poa_object.in ());
+
+  if (CORBA::is_nil (root_poa.in ()))
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       " (%P|%t) Unable to initialize the POA.\n"),
+                      -1);
+
+  PortableServer::POAManager_var poa_manager =
+    root_poa->the_POAManager ();
+
+  Echo *echo_impl = 0;
+  ACE_NEW_RETURN (echo_impl,
+                  Echo (orb),
+                  -1);
+  PortableServer::ServantBase_var owner_transfer (echo_impl);
+
+  PortableServer::ObjectId_var id =
+    root_poa->activate_object (echo_impl);
+
+  CORBA::Object_var object = root_poa->id_to_reference (id.in ());
+
+  CORBA::String_var ior = orb->object_to_string (object.in ());
+
+  ACE_TCHAR ior_output_file[MAXPATHLEN];
+  ACE_OS::snprintf (ior_output_file, MAXPATHLEN,
+                    ACE_TEXT ("%s%d.ior"), ior_prefix, index);
+
+  FILE *output_file = ACE_OS::fopen (ior_output_file, "w");
+  if (output_file == 0)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       "Cannot open output file for writing IOR: %s\n",
+                       ior_output_file),
+                      -1);
+  ACE_OS::fprintf (output_file, "%s", ior.in ());
+  ACE_OS::fclose (output_file);
+
+  poa_manager->activate ();
+
+  return 0;
+}
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  try
+    {
+      CORBA::ORB_var orb =
+        CORBA::ORB_init (argc, argv);
+
+      if (parse_args (argc, argv) != 0)
+        return 1;
+
+      // Every ORB listens on its own endpoint, so the client needs a
+      // connection, and a connection cache entry, per ORB.
+      CORBA::ORB_var *orbs = 0;
+      ACE_NEW_RETURN (orbs, CORBA::ORB_var[norbs], 1);
+      Worker **workers = 0;
+      ACE_NEW_RETURN (workers, Worker *[norbs], 1);
+
+      for (int i = 0; i != norbs; ++i)
+        {
+          if (i == 0)
+            orbs[i] = CORBA::ORB::_duplicate (orb.in ());
+          else
+            {
+              char orbid[32];
+              ACE_OS::snprintf (orbid, sizeof orbid, "server%d", i);
+              int orb_argc = 0;
+              orbs[i] = CORBA::ORB_init (orb_argc, 0, orbid);
+            }
+
+          if (activate_echo (orbs[i].in (), i) != 0)
+            return 1;
+
+          ACE_NEW_RETURN (workers[i], Worker (orbs[i].in ()), 1);
+          workers[i]->activate (THR_NEW_LWP | THR_JOINABLE, nthreads, 1);
+        }
+
+      for (int i = 0; i != norbs; ++i)
+        workers[i]->wait ();
+
+      ACE_DEBUG ((LM_DEBUG, "(%P|%t) server - event loops finished\n"));
+
+      for (int i = 0; i != norbs; ++i)
+        {
+          orbs[i]->destroy ();
+          delete workers[i];
+        }
+
+      delete [] workers;
+      delete [] orbs;
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Exception caught:");
+      return 1;
+    }
+
+  return 0;
+}
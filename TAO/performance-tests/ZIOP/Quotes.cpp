@@ -0,0 +1,118 @@
+#include "Quotes.h"
+#include "tao/CDR.h"
+#include "tao/Compression/Compression_Dictionary.h"
+#include "tao/Compression/zlib/ZlibCompressor_Factory.h"
+#include "tao/Compression/zstd/ZstdCompressor_Factory.h"
+#include "tao/Compression/lz4/Lz4Compressor_Factory.h"
+#include "ace/OS_NS_stdio.h"
+
+static const char *const symbols[] = {
+  "ACME", "BRAVO", "CORTEX", "DELTA", "ECHO", "FOXTROT", "GAMMA", "HELIX"
+};
+
+static const char *const exchanges[] = {
+  "XNAS", "XNYS", "XLON"
+};
+
+/// Small linear congruential generator, so every run sees the same
+/// quotes.
+static CORBA::ULong
+next_random (CORBA::ULong &seed)
+{
+  seed = seed * 1103515245 + 12345;
+  return seed >> 8;
+}
+
+void
+make_quotes (Test::QuoteSeq &quotes, CORBA::ULong count, CORBA::ULong seed)
+{
+  quotes.length (count);
+
+  CORBA::ULongLong timestamp = ACE_UINT64_LITERAL (1400000000000);
+  for (CORBA::ULong i = 0; i != count; ++i)
+    {
+      CORBA::ULong const r = next_random (seed);
+      Test::Quote &quote = quotes[i];
+      quote.symbol = symbols[r % (sizeof symbols / sizeof symbols[0])];
+      quote.exchange = exchanges[(r >> 4) % (sizeof exchanges / sizeof exchanges[0])];
+      quote.bid = 100.0 + (r % 1000) / 100.0;
+      quote.ask = quote.bid + 0.01 * ((r >> 12) % 4 + 1);
+      quote.volume = static_cast<CORBA::Long> (100 * ((r >> 16) % 50));
+      timestamp += (r >> 8) % 16;
+      quote.timestamp = timestamp;
+    }
+}
+
+int
+make_dictionary (const ACE_TCHAR *filename,
+                 ::Compression::Buffer &dictionary)
+{
+  if (filename != 0)
+    return TAO::load_compression_dictionary (filename, dictionary);
+
+  // Other quotes than those sent, but with the same layout.
+  Test::QuoteSeq samples;
+  make_quotes (samples, 512, 1);
+
+  TAO_OutputCDR cdr;
+  if (!(cdr << samples))
+    ACE_ERROR_RETURN ((LM_ERROR, "Cannot marshal the sample quotes\n"), -1);
+
+  dictionary.length (static_cast<CORBA::ULong> (cdr.total_length ()));
+  CORBA::Octet *buffer = dictionary.get_buffer ();
+  for (const ACE_Message_Block *i = cdr.begin (); i != 0; i = i->cont ())
+    {
+      ACE_OS::memcpy (buffer, i->rd_ptr (), i->length ());
+      buffer += i->length ();
+    }
+
+  return 0;
+}
+
+int
+register_factories (CORBA::ORB_ptr orb,
+                    const ::Compression::Buffer &dictionary,
+                    ::Compression::CompressionManager_out manager)
+{
+  CORBA::Object_var compression_manager =
+    orb->resolve_initial_references("CompressionManager");
+
+  manager = ::Compression::CompressionManager::_narrow (
+    compression_manager.in ());
+
+  if (CORBA::is_nil (manager.ptr ()))
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       " (%P|%t) Panic: nil compression manager\n"),
+                      -1);
+
+  ::Compression::CompressorFactory_ptr compressor_factory;
+  ::Compression::CompressorFactory_var compr_fact;
+
+  ACE_NEW_RETURN (compressor_factory, TAO::Zlib_CompressorFactory (), -1);
+  compr_fact = compressor_factory;
+  manager->register_factory (compr_fact.in ());
+
+  ACE_NEW_RETURN (compressor_factory, TAO::Zstd_CompressorFactory (), -1);
+  compr_fact = compressor_factory;
+  manager->register_factory (compr_fact.in ());
+
+  ACE_NEW_RETURN (compressor_factory, TAO::Lz4_CompressorFactory (), -1);
+  compr_fact = compressor_factory;
+  manager->register_factory (compr_fact.in ());
+
+  ACE_NEW_RETURN (compressor_factory,
+                  TAO::Zstd_CompressorFactory (COMPRESSORID_ZSTD_DICTIONARY,
+                                               dictionary),
+                  -1);
+  compr_fact = compressor_factory;
+  manager->register_factory (compr_fact.in ());
+
+  ACE_NEW_RETURN (compressor_factory,
+                  TAO::Lz4_CompressorFactory (COMPRESSORID_LZ4_DICTIONARY,
+                                              dictionary),
+                  -1);
+  compr_fact = compressor_factory;
+  manager->register_factory (compr_fact.in ());
+
+  return 0;
+}
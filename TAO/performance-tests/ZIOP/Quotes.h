@@ -0,0 +1,32 @@
+#ifndef QUOTES_H
+#define QUOTES_H
+#include /**/ "ace/pre.h"
+
+#include "TestC.h"
+#include "tao/Compression/Compression.h"
+
+/// The ids the dictionary factories are registered with, the same in
+/// the client and the server.
+const ::Compression::CompressorId COMPRESSORID_ZSTD_DICTIONARY = 100;
+const ::Compression::CompressorId COMPRESSORID_LZ4_DICTIONARY = 101;
+
+/// Fill @a quotes with @a count quotes; the same @a seed gives the
+/// same quotes.
+void make_quotes (Test::QuoteSeq &quotes,
+                  CORBA::ULong count,
+                  CORBA::ULong seed);
+
+/// Make the dictionary from the CDR encoding of sample quotes, unless
+/// @a filename names a file to load it from.
+int make_dictionary (const ACE_TCHAR *filename,
+                     ::Compression::Buffer &dictionary);
+
+/// Register the zlib, zstd and lz4 factories with the compression
+/// manager of @a orb, and zstd and lz4 with @a dictionary under the
+/// ids above.
+int register_factories (CORBA::ORB_ptr orb,
+                        const ::Compression::Buffer &dictionary,
+                        ::Compression::CompressionManager_out manager);
+
+#include /**/ "ace/post.h"
+#endif /* QUOTES_H */
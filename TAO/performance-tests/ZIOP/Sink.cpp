@@ -0,0 +1,18 @@
+#include "Sink.h"
+
+Sink::Sink (CORBA::ORB_ptr orb)
+  : orb_ (CORBA::ORB::_duplicate (orb))
+{
+}
+
+CORBA::ULong
+Sink::consume (const Test::QuoteSeq &quotes)
+{
+  return quotes.length ();
+}
+
+void
+Sink::shutdown (void)
+{
+  this->orb_->shutdown (0);
+}
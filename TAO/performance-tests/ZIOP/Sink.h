@@ -0,0 +1,26 @@
+#ifndef SINK_H
+#define SINK_H
+#include /**/ "ace/pre.h"
+
+#include "TestS.h"
+
+/// Implement the Test::Sink interface
+class Sink
+  : public virtual POA_Test::Sink
+{
+public:
+  /// Constructor
+  Sink (CORBA::ORB_ptr orb);
+
+  // = The skeleton methods
+  virtual CORBA::ULong consume (const Test::QuoteSeq &quotes);
+
+  virtual void shutdown (void);
+
+private:
+  /// Use an ORB reference to shutdown the application.
+  CORBA::ORB_var orb_;
+};
+
+#include /**/ "ace/post.h"
+#endif /* SINK_H */
@@ -0,0 +1,249 @@
+#include "Quotes.h"
+#include "ace/Get_Opt.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_stdlib.h"
+#include "tao/CDR.h"
+#include "tao/ZIOP/ZIOP.h"
+
+const ACE_TCHAR *ior = ACE_TEXT("file://server.ior");
+const ACE_TCHAR *dictionary_file = 0;
+const ACE_TCHAR *compressor_name = ACE_TEXT("zstd");
+::Compression::CompressionLevel compression_level = 0;
+CORBA::ULong nquotes = 8;
+int niterations = 20000;
+int do_shutdown = 1;
+
+struct Compressor_Name
+{
+  const ACE_TCHAR *name;
+  ::Compression::CompressorId id;
+};
+
+static const Compressor_Name compressor_names[] = {
+  { ACE_TEXT("none"), ::Compression::COMPRESSORID_NONE },
+  { ACE_TEXT("zlib"), ::Compression::COMPRESSORID_ZLIB },
+  { ACE_TEXT("zstd"), ::Compression::COMPRESSORID_ZSTD },
+  { ACE_TEXT("lz4"), ::Compression::COMPRESSORID_LZ4 },
+  { ACE_TEXT("zstd-dict"), COMPRESSORID_ZSTD_DICTIONARY },
+  { ACE_TEXT("lz4-dict"), COMPRESSORID_LZ4_DICTIONARY }
+};
+
+static const size_t ncompressor_names =
+  sizeof compressor_names / sizeof compressor_names[0];
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("xk:d:c:l:q:i:"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'x':
+        do_shutdown = 0;
+        break;
+
+      case 'k':
+        ior = get_opts.opt_arg ();
+        break;
+
+      case 'd':
+        dictionary_file = get_opts.opt_arg ();
+        break;
+
+      case 'c':
+        compressor_name = get_opts.opt_arg ();
+        break;
+
+      case 'l':
+        compression_level = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'q':
+        nquotes = ACE_OS::strtoul (get_opts.opt_arg (), 0, 10);
+        break;
+
+      case 'i':
+        niterations = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage:  %s "
+                           "-k <ior> "
+                           "-c <none|zlib|zstd|lz4|zstd-dict|lz4-dict> "
+                           "-l <compression level> "
+                           "-q <quotes per request> "
+                           "-i <iterations> "
+                           "-d <dictionary file> "
+                           "-x (disable shutdown) "
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+
+  if (nquotes < 1 || niterations < 1)
+    ACE_ERROR_RETURN ((LM_ERROR, "Invalid quote or iteration count\n"), -1);
+
+  // Indicates successful parsing of the command line
+  return 0;
+}
+
+/// Let the requests on @a object be compressed by @a compressor_id;
+/// all of them, as long as they get any smaller.
+CORBA::Object_ptr
+set_policies (CORBA::ORB_ptr orb,
+              CORBA::Object_ptr object,
+              ::Compression::CompressorId compressor_id)
+{
+  ::Compression::CompressorIdLevelList compressor_id_list;
+  compressor_id_list.length (1);
+  compressor_id_list[0].compressor_id = compressor_id;
+  compressor_id_list[0].compression_level = compression_level;
+
+  CORBA::Any compressor_id_any;
+  compressor_id_any <<= compressor_id_list;
+
+  CORBA::Any low_value_any;
+  low_value_any <<= static_cast<CORBA::ULong> (64);
+
+  CORBA::Any compression_enabling_any;
+  compression_enabling_any <<= CORBA::Any::from_boolean (true);
+
+  CORBA::Any min_ratio_any;
+  min_ratio_any <<= static_cast< ::Compression::CompressionRatio> (1.0);
+
+  CORBA::PolicyList policies (4);
+  policies.length (4);
+
+  policies[0] = orb->create_policy (ZIOP::COMPRESSOR_ID_LEVEL_LIST_POLICY_ID,
+                                    compressor_id_any);
+  policies[1] = orb->create_policy (ZIOP::COMPRESSION_LOW_VALUE_POLICY_ID,
+                                    low_value_any);
+  policies[2] = orb->create_policy (ZIOP::COMPRESSION_ENABLING_POLICY_ID,
+                                    compression_enabling_any);
+  policies[3] = orb->create_policy (ZIOP::COMPRESSION_MIN_RATIO_POLICY_ID,
+                                    min_ratio_any);
+
+  CORBA::Object_var result =
+    object->_set_policy_overrides (policies, CORBA::ADD_OVERRIDE);
+
+  for (CORBA::ULong i = 0; i != policies.length (); ++i)
+    policies[i]->destroy ();
+
+  return result._retn ();
+}
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  try
+    {
+      CORBA::ORB_var orb =
+        CORBA::ORB_init (argc, argv);
+
+      if (parse_args (argc, argv) != 0)
+        return 1;
+
+      const Compressor_Name *compressor = 0;
+      for (size_t i = 0; i != ncompressor_names; ++i)
+        if (ACE_OS::strcmp (compressor_names[i].name, compressor_name) == 0)
+          compressor = &compressor_names[i];
+
+      if (compressor == 0)
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "Unknown compressor <%s>\n",
+                           compressor_name),
+                          1);
+
+      ::Compression::Buffer dictionary;
+      if (make_dictionary (dictionary_file, dictionary) != 0)
+        return 1;
+
+      ::Compression::CompressionManager_var manager;
+      if (register_factories (orb.in (), dictionary, manager.out ()) != 0)
+        return 1;
+
+      CORBA::Object_var object = orb->string_to_object (ior);
+
+      if (compressor->id != ::Compression::COMPRESSORID_NONE)
+        object = set_policies (orb.in (), object.in (), compressor->id);
+
+      Test::Sink_var sink = Test::Sink::_narrow (object.in ());
+
+      if (CORBA::is_nil (sink.in ()))
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "Nil Test::Sink reference <%s>\n",
+                           ior),
+                          1);
+
+      // Every request sends other quotes, made in advance so that
+      // only the invocations are timed.
+      int const nbatches = 64;
+      Test::QuoteSeq batches[nbatches];
+      size_t request_bytes = 0;
+      for (int i = 0; i != nbatches; ++i)
+        {
+          make_quotes (batches[i], nquotes, 1000 + i);
+
+          TAO_OutputCDR cdr;
+          cdr << batches[i];
+          request_bytes += cdr.total_length ();
+        }
+      request_bytes /= nbatches;
+
+      // Set up the connection before the measurement starts.
+      (void) sink->consume (batches[0]);
+
+      ::Compression::Compressor_var used;
+      if (compressor->id != ::Compression::COMPRESSORID_NONE)
+        used = manager->get_compressor (compressor->id, compression_level);
+
+      ACE_hrtime_t test_start = ACE_OS::gethrtime ();
+      for (int i = 0; i != niterations; ++i)
+        {
+          CORBA::ULong const n = sink->consume (batches[i % nbatches]);
+          if (n != nquotes)
+            ACE_ERROR_RETURN ((LM_ERROR,
+                               "Server got %u quotes instead of %u\n",
+                               n,
+                               nquotes),
+                              1);
+        }
+      ACE_hrtime_t test_end = ACE_OS::gethrtime ();
+
+      ACE_High_Res_Timer::global_scale_factor_type gsf =
+        ACE_High_Res_Timer::global_scale_factor ();
+
+      double const usecs =
+        static_cast<double> (test_end - test_start) / gsf;
+      double const bytes =
+        static_cast<double> (request_bytes) * niterations;
+
+      ACE_DEBUG ((LM_DEBUG,
+                  "ZIOP %-9s level %2d, %4u quotes (%6B bytes): "
+                  "%8.0f calls/sec %7.2f MB/sec, ratio %4.2f\n",
+                  compressor->name,
+                  compression_level,
+                  nquotes,
+                  request_bytes,
+                  usecs > 0 ? niterations * 1000000.0 / usecs : 0.0,
+                  usecs > 0 ? bytes / usecs : 0.0,
+                  CORBA::is_nil (used.in ()) ? 1.0 : used->compression_ratio ()));
+
+      if (do_shutdown)
+        sink->shutdown ();
+
+      orb->destroy ();
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Exception caught:");
+      return 1;
+    }
+
+  return 0;
+}
@@ -0,0 +1,107 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+     & eval 'exec perl -S $0 $argv:q'
+     if 0;
+
+# -*- perl -*-
+
+use lib "$ENV{ACE_ROOT}/bin";
+use PerlACE::TestTarget;
+
+$status = 0;
+$debug_level = '0';
+
+my $iterations = 20000;
+my @compressors = ('none 0', 'zlib 1', 'zlib 6', 'lz4 0', 'lz4 9',
+                   'zstd 1', 'zstd 3', 'lz4-dict 0', 'zstd-dict 3');
+my @quotes = (4, 256);
+
+for ($iter = 0; $iter <= $#ARGV; $iter++) {
+    if ($ARGV[$iter] eq "-h" || $ARGV[$iter] eq "-?") {
+        print "Run_Test Perl script for the ZIOP compressor throughput test\n\n";
+        print "run_test [-n num] [-debug] [-h]\n";
+        print "\n";
+        print "-n num              -- iterations of each client\n";
+        print "-debug              -- run the server with debug output\n";
+        print "-h                  -- prints this information\n";
+        exit 0;
+    }
+    elsif ($ARGV[$iter] eq "-n") {
+        $iterations = $ARGV[$iter + 1];
+        $iter++;
+    }
+    elsif ($ARGV[$iter] eq "-debug") {
+        $debug_level = '10';
+    }
+}
+
+my $server = PerlACE::TestTarget::create_target (1) || die "Create target 1 failed\n";
+my $client = PerlACE::TestTarget::create_target (2) || die "Create target 2 failed\n";
+
+my $iorbase = "server.ior";
+my $server_iorfile = $server->LocalFile ($iorbase);
+my $client_iorfile = $client->LocalFile ($iorbase);
+$server->DeleteFile($iorbase);
+$client->DeleteFile($iorbase);
+
+print STDERR "================ ZIOP compressor throughput test\n";
+
+$SV = $server->CreateProcess ("server",
+                              "-ORBdebuglevel $debug_level " .
+                              "-o $server_iorfile");
+
+$server_status = $SV->Spawn ();
+
+if ($server_status != 0) {
+    print STDERR "ERROR: server returned $server_status\n";
+    exit 1;
+}
+
+if ($server->WaitForFileTimed ($iorbase,
+                               $server->ProcessStartWaitInterval()) == -1) {
+    print STDERR "ERROR: cannot find file <$server_iorfile>\n";
+    $SV->Kill (); $SV->TimedWait (1);
+    exit 1;
+}
+
+if ($server->GetFile ($iorbase) == -1
+    || $client->PutFile ($iorbase) == -1) {
+    print STDERR "ERROR: cannot transfer file <$iorbase>\n";
+    $SV->Kill (); $SV->TimedWait (1);
+    exit 1;
+}
+
+# The last client shuts the server down.
+my $runs = scalar (@compressors) * scalar (@quotes);
+my $run = 0;
+
+foreach my $quote_count (@quotes) {
+    foreach my $compressor (@compressors) {
+        my ($name, $level) = split (' ', $compressor);
+        my $shutdown = (++$run == $runs) ? "" : "-x ";
+
+        $CL = $client->CreateProcess ("client",
+                                      "-k file://$client_iorfile " .
+                                      "-c $name -l $level " .
+                                      "-q $quote_count -i $iterations " .
+                                      $shutdown);
+
+        $client_status = $CL->SpawnWaitKill ($client->ProcessStartWaitInterval() + 285);
+
+        if ($client_status != 0) {
+            print STDERR "ERROR: client returned $client_status\n";
+            $status = 1;
+        }
+    }
+}
+
+$server_status = $SV->WaitKill ($server->ProcessStopWaitInterval());
+
+if ($server_status != 0) {
+    print STDERR "ERROR: server returned $server_status\n";
+    $status = 1;
+}
+
+$server->DeleteFile($iorbase);
+$client->DeleteFile($iorbase);
+
+exit $status;
@@ -0,0 +1,162 @@
+#include "Sink.h"
+#include "Quotes.h"
+#include "ace/Get_Opt.h"
+#include "ace/OS_NS_stdio.h"
+#include "tao/ZIOP/ZIOP.h"
+
+const ACE_TCHAR *ior_output_file = ACE_TEXT("server.ior");
+const ACE_TCHAR *dictionary_file = 0;
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("o:d:"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'o':
+        ior_output_file = get_opts.opt_arg ();
+        break;
+
+      case 'd':
+        dictionary_file = get_opts.opt_arg ();
+        break;
+
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage:  %s "
+                           "-o <iorfile> "
+                           "-d <dictionary file>"
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+
+  // Indicates successful parsing of the command line
+  return 0;
+}
+
+/// The server accepts all the compressors, the client picks one.
+void
+create_policies (CORBA::ORB_ptr orb, CORBA::PolicyList &policies)
+{
+  ::Compression::CompressorIdLevelList compressor_id_list;
+  compressor_id_list.length (5);
+  compressor_id_list[0].compressor_id = ::Compression::COMPRESSORID_LZ4;
+  compressor_id_list[1].compressor_id = ::Compression::COMPRESSORID_ZSTD;
+  compressor_id_list[2].compressor_id = ::Compression::COMPRESSORID_ZLIB;
+  compressor_id_list[3].compressor_id = COMPRESSORID_LZ4_DICTIONARY;
+  compressor_id_list[4].compressor_id = COMPRESSORID_ZSTD_DICTIONARY;
+  for (CORBA::ULong i = 0; i != compressor_id_list.length (); ++i)
+    compressor_id_list[i].compression_level = 0;
+
+  CORBA::Any compressor_id_any;
+  compressor_id_any <<= compressor_id_list;
+
+  // The replies are smaller than this and aren't compressed.
+  CORBA::Any low_value_any;
+  low_value_any <<= static_cast<CORBA::ULong> (64);
+
+  CORBA::Any compression_enabling_any;
+  compression_enabling_any <<= CORBA::Any::from_boolean (true);
+
+  CORBA::Any min_ratio_any;
+  min_ratio_any <<= static_cast< ::Compression::CompressionRatio> (1.0);
+
+  policies.length (4);
+
+  policies[0] = orb->create_policy (ZIOP::COMPRESSOR_ID_LEVEL_LIST_POLICY_ID,
+                                    compressor_id_any);
+  policies[1] = orb->create_policy (ZIOP::COMPRESSION_LOW_VALUE_POLICY_ID,
+                                    low_value_any);
+  policies[2] = orb->create_policy (ZIOP::COMPRESSION_ENABLING_POLICY_ID,
+                                    compression_enabling_any);
+  policies[3] = orb->create_policy (ZIOP::COMPRESSION_MIN_RATIO_POLICY_ID,
+                                    min_ratio_any);
+}
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  try
+    {
+      CORBA::ORB_var orb =
+        CORBA::ORB_init (argc, argv);
+
+      if (parse_args (argc, argv) != 0)
+        return 1;
+
+      ::Compression::Buffer dictionary;
+      if (make_dictionary (dictionary_file, dictionary) != 0)
+        return 1;
+
+      ::Compression::CompressionManager_var manager;
+      if (register_factories (orb.in (), dictionary, manager.out ()) != 0)
+        return 1;
+
+      CORBA::Object_var poa_object =
+        orb->resolve_initial_references("RootPOA");
+
+      PortableServer::POA_var root_poa =
+        PortableServer::POA::_narrow (poa_object.in ());
+
+      if (CORBA::is_nil (root_poa.in ()))
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           " (%P|%t) Unable to initialize the POA.\n"),
+                          1);
+
+      PortableServer::POAManager_var poa_manager =
+        root_poa->the_POAManager ();
+
+      CORBA::PolicyList policies;
+      create_policies (orb.in (), policies);
+
+      PortableServer::POA_var compress_poa =
+        root_poa->create_POA ("Compress_POA", poa_manager.in (), policies);
+
+      Sink *sink_impl = 0;
+      ACE_NEW_RETURN (sink_impl,
+                      Sink (orb.in ()),
+                      1);
+      PortableServer::ServantBase_var owner_transfer (sink_impl);
+
+      PortableServer::ObjectId_var id =
+        compress_poa->activate_object (sink_impl);
+
+      CORBA::Object_var object = compress_poa->id_to_reference (id.in ());
+
+      CORBA::String_var ior = orb->object_to_string (object.in ());
+
+      FILE *output_file = ACE_OS::fopen (ior_output_file, "w");
+      if (output_file == 0)
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "Cannot open output file for writing IOR: %s\n",
+                           ior_output_file),
+                          1);
+      ACE_OS::fprintf (output_file, "%s", ior.in ());
+      ACE_OS::fclose (output_file);
+
+      poa_manager->activate ();
+
+      orb->run ();
+
+      ACE_DEBUG ((LM_DEBUG, "(%P|%t) server - event loop finished\n"));
+
+      for (CORBA::ULong i = 0; i != policies.length (); ++i)
+        policies[i]->destroy ();
+
+      root_poa->destroy (1, 1);
+
+      orb->destroy ();
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Exception caught:");
+      return 1;
+    }
+
+  return 0;
+}
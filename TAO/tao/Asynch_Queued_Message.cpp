@@ -4,7 +4,6 @@
 #include "tao/ORB_Core.h"
 
 #include "ace/OS_Memory.h"
-#include "ace/OS_NS_string.h"
 #include "ace/os_include/sys/os_uio.h"
 #include "ace/Log_Msg.h"
 #include "ace/Message_Block.h"
@@ -22,28 +21,20 @@ TAO_Asynch_Queued_Message::TAO_Asynch_Queued_Message (
   : TAO_Queued_Message (oc, alloc, is_heap_allocated)
   , size_ (contents->total_length ())
   , offset_ (0)
+  , contents_ (0)
+  , current_block_ (0)
   , abs_timeout_ (ACE_Time_Value::zero)
 {
   if (timeout != 0)// && *timeout != ACE_Time_Value::zero)
     {
       this->abs_timeout_ = ACE_High_Res_Timer::gettimeofday_hr () + *timeout;
     }
-  // @@ Use a pool for these guys!!
-  ACE_NEW (this->buffer_, char[this->size_]);
 
-  size_t copy_offset = 0;
-  for (const ACE_Message_Block *i = contents;
-       i != 0;
-       i = i->cont ())
-    {
-      ACE_OS::memcpy (this->buffer_ + copy_offset,
-                      i->rd_ptr (),
-                      i->length ());
-      copy_offset += i->length ();
-    }
+  this->contents_ = this->copy_chain (contents);
+  this->current_block_ = this->contents_;
 }
 
-TAO_Asynch_Queued_Message::TAO_Asynch_Queued_Message (char *buf,
+TAO_Asynch_Queued_Message::TAO_Asynch_Queued_Message (ACE_Message_Block *contents,
                                                       TAO_ORB_Core *oc,
                                                       size_t size,
                                                       const ACE_Time_Value &abs_timeout,
@@ -52,15 +43,15 @@ TAO_Asynch_Queued_Message::TAO_Asynch_Queued_Message (char *buf,
   : TAO_Queued_Message (oc, alloc, is_heap_allocated)
   , size_ (size)
   , offset_ (0)
-  , buffer_ (buf)
+  , contents_ (contents)
+  , current_block_ (contents)
   , abs_timeout_ (abs_timeout)
 {
 }
 
 TAO_Asynch_Queued_Message::~TAO_Asynch_Queued_Message (void)
 {
-  // @@ Use a pool for these guys!
-  delete [] this->buffer_;
+  ACE_Message_Block::release (this->contents_);
 }
 
 size_t
@@ -81,11 +72,21 @@ TAO_Asynch_Queued_Message::fill_iov (int iovcnt_max,
                                      iovec iov[]) const
 {
   ACE_ASSERT (iovcnt_max > iovcnt);
-  ACE_UNUSED_ARG (iovcnt_max); // not used if ACE_ASSERT() is empty
 
-  iov[iovcnt].iov_base = this->buffer_ + this->offset_;
-  iov[iovcnt].iov_len  = static_cast<u_long> (this->size_ - this->offset_);
-  ++iovcnt;
+  for (const ACE_Message_Block *message_block = this->current_block_;
+       message_block != 0 && iovcnt < iovcnt_max;
+       message_block = message_block->cont ())
+    {
+      size_t const message_block_length = message_block->length ();
+
+      // Check if this block has any data to be sent.
+      if (message_block_length > 0)
+        {
+          iov[iovcnt].iov_base = message_block->rd_ptr ();
+          iov[iovcnt].iov_len  = static_cast<u_long> (message_block_length);
+          ++iovcnt;
+        }
+    }
 }
 
 void
@@ -97,10 +98,27 @@ TAO_Asynch_Queued_Message::bytes_transferred (size_t &byte_count)
   if (byte_count > remaining_bytes)
     {
       this->offset_ = this->size_;
+      this->current_block_ = 0;
       byte_count -= remaining_bytes;
       return;
     }
   this->offset_ += byte_count;
+
+  // Move past the data that was sent.
+  while (this->current_block_ != 0)
+    {
+      size_t const l = this->current_block_->length ();
+
+      if (byte_count < l)
+        {
+          this->current_block_->rd_ptr (byte_count);
+          break;
+        }
+
+      byte_count -= l;
+      this->current_block_->rd_ptr (l);
+      this->current_block_ = this->current_block_->cont ();
+    }
   byte_count = 0;
 
   if (this->all_data_sent ())
@@ -112,22 +130,14 @@ TAO_Asynch_Queued_Message::bytes_transferred (size_t &byte_count)
 TAO_Queued_Message *
 TAO_Asynch_Queued_Message::clone (ACE_Allocator *alloc)
 {
-  char *buf = 0;
-
-  // @todo: Need to use a memory pool. But certain things need to
-  // change a bit in this class for that. Till then.
-
-  // Just allocate and copy data that needs to be sent, no point
-  // copying the whole buffer.
+  // Just copy the data that needs to be sent, no point copying the
+  // whole message.
   size_t const sz = this->size_ - this->offset_;
 
-  ACE_NEW_RETURN (buf,
-                  char[sz],
-                  0);
+  ACE_Message_Block *mb = this->copy_chain (this->current_block_);
 
-  ACE_OS::memcpy (buf,
-                  this->buffer_ + this->offset_,
-                  sz);
+  if (mb == 0 && sz != 0)
+    return 0;
 
   TAO_Asynch_Queued_Message *qm = 0;
 
@@ -136,7 +146,7 @@ TAO_Asynch_Queued_Message::clone (ACE_Allocator *alloc)
       ACE_NEW_MALLOC_RETURN (qm,
                              static_cast<TAO_Asynch_Queued_Message *> (
                                  alloc->malloc (sizeof (TAO_Asynch_Queued_Message))),
-                             TAO_Asynch_Queued_Message (buf,
+                             TAO_Asynch_Queued_Message (mb,
                                                         this->orb_core_,
                                                         sz,
                                                         this->abs_timeout_,
@@ -156,7 +166,7 @@ TAO_Asynch_Queued_Message::clone (ACE_Allocator *alloc)
         }
 
       ACE_NEW_RETURN (qm,
-                      TAO_Asynch_Queued_Message (buf,
+                      TAO_Asynch_Queued_Message (mb,
                                                  this->orb_core_,
                                                  sz,
                                                  this->abs_timeout_,
@@ -79,21 +79,19 @@ public:
 protected:
   /// Constructor
   /**
-   * @param buf The buffer that needs to be sent on the wire. The
-   *            buffer will be owned by this class. The buffer will be
-   *            deleted when the destructor is called and hence the
-   *            buffer should always come off the heap!
+   * @param contents The message block chain that needs to be sent on
+   *            the wire. The chain will be owned by this class and
+   *            released when the destructor is called.
    *
    * @param oc The ORB Core
    *
-   * @param size The size of the buffer <buf> that is being handed
-   *             over.
+   * @param size The number of bytes in @a contents.
    *
    * @param abs_timeout The time after which this  message should be expired.
    *
    * @param alloc Allocator used for creating <this> object.
    */
-  TAO_Asynch_Queued_Message (char *buf,
+  TAO_Asynch_Queued_Message (ACE_Message_Block *contents,
                              TAO_ORB_Core *oc,
                              size_t size,
                              const ACE_Time_Value &abs_timeout,
@@ -105,18 +103,26 @@ private:
   TAO_Asynch_Queued_Message (const TAO_Asynch_Queued_Message &);
 
 private:
-  /// The number of bytes in the buffer
+  /// The number of bytes in the message
   size_t const size_;
 
-  /// The offset in the buffer
+  /// The number of bytes sent already
   /**
    * Data up to @c offset has been sent already, only the
    * [offset_,size_) range remains to be sent.
    */
   size_t offset_;
 
-  /// The buffer containing the complete message.
-  char *buffer_;
+  /// Our copy of the message
+  /**
+   * The data written by the CDR stream is copied, octet sequence
+   * buffers it chained may be referenced instead, see
+   * TAO_Queued_Message::copy_chain().
+   */
+  ACE_Message_Block *contents_;
+
+  /// The block that contains the next byte to be sent
+  ACE_Message_Block *current_block_;
 
   // Expiration time
   ACE_Time_Value abs_timeout_;
@@ -76,6 +76,10 @@ namespace TAO
       /// servant object.
       bool is_target(PortableServer::Servant servant);
 
+      /// Accessor for the servant state object, or 0 if the servant is
+      /// not serialized.  Does not return a new (ref counted) reference!
+      TP_Servant_State* servant_state() const;
+
 
     protected:
 
@@ -77,6 +77,14 @@ TAO::CSD::TP_Request::is_target(PortableServer::Servant servant)
 }
 
 
+ACE_INLINE
+TAO::CSD::TP_Servant_State*
+TAO::CSD::TP_Request::servant_state() const
+{
+  return this->servant_state_.in();
+}
+
+
 ACE_INLINE
 void
 TAO::CSD::TP_Request::dispatch()
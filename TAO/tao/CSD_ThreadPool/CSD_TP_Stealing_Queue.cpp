@@ -0,0 +1,224 @@
+#include "tao/CSD_ThreadPool/CSD_TP_Stealing_Queue.h"
+#include "tao/CSD_ThreadPool/CSD_TP_Dispatchable_Visitor.h"
+#include "tao/CSD_ThreadPool/CSD_TP_Queue_Visitor.h"
+
+#if !defined (__ACE_INLINE__)
+# include "tao/CSD_ThreadPool/CSD_TP_Stealing_Queue.inl"
+#endif /* ! __ACE_INLINE__ */
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+TAO::CSD::TP_Stealing_Queue::~TP_Stealing_Queue()
+{
+  delete [] this->queues_;
+}
+
+
+void
+TAO::CSD::TP_Stealing_Queue::open(size_t num_queues)
+{
+  if (this->queues_ == 0)
+    {
+      // The worker queues are kept once created: ORB threads may still
+      // be looking at them after the queue is closed.  If the queue is
+      // opened again for a different number of worker threads, they just
+      // share the worker queues differently.
+      if (num_queues == 0)
+        {
+          num_queues = 1;
+        }
+
+      ACE_NEW (this->queues_, Worker_Queue[num_queues]);
+      this->num_queues_ = num_queues;
+    }
+
+  for (size_t i = 0; i < this->num_queues_; ++i)
+    {
+      ACE_GUARD (LockType, guard, this->queues_[i].lock_);
+      this->queues_[i].closed_ = false;
+    }
+}
+
+
+void
+TAO::CSD::TP_Stealing_Queue::close()
+{
+  for (size_t i = 0; i < this->num_queues_; ++i)
+    {
+      ACE_GUARD (LockType, guard, this->queues_[i].lock_);
+      this->queues_[i].closed_ = true;
+    }
+
+  ACE_GUARD (LockType, guard, this->idle_lock_);
+  ++this->generation_;
+  this->work_available_.broadcast();
+}
+
+
+bool
+TAO::CSD::TP_Stealing_Queue::put(TP_Request* request)
+{
+  if (this->num_queues_ == 0)
+    {
+      // Never opened.
+      return false;
+    }
+
+  Worker_Queue& worker_queue = this->queues_[this->index(request)];
+
+  {
+    ACE_GUARD_RETURN (LockType, guard, worker_queue.lock_, false);
+
+    if (worker_queue.closed_)
+      {
+        return false;
+      }
+
+    // Some requests need to "clone" the underlying request data before
+    // they are placed into a queue (see TP_Task::add_request()).
+    request->prepare_for_queue();
+
+    worker_queue.queue_.put(request);
+  }
+
+  // The generation_ has to be incremented before the idle_ count is
+  // read: a worker thread increments the idle_ count before it checks
+  // the generation_ in wait(), so one of the two threads always sees
+  // what the other one did.
+  ++this->generation_;
+
+  if (this->idle_.value() > 0)
+    {
+      ACE_GUARD_RETURN (LockType, guard, this->idle_lock_, true);
+      this->work_available_.signal();
+    }
+
+  return true;
+}
+
+
+bool
+TAO::CSD::TP_Stealing_Queue::get(size_t owner, TP_Request_Handle& request)
+{
+  // Look at the worker queue of this worker thread first, and then at
+  // the other worker queues, without waiting for the lock of a worker
+  // queue that another thread is using.
+  bool skipped = false;
+
+  for (size_t i = 0; i < this->num_queues_; ++i)
+    {
+      Worker_Queue& worker_queue =
+        this->queues_[(owner + i) % this->num_queues_];
+
+      ACE_Guard<LockType> guard (worker_queue.lock_, i == 0);
+
+      if (!guard.locked())
+        {
+          skipped = true;
+        }
+      else if (this->get_i(worker_queue, request))
+        {
+          return true;
+        }
+    }
+
+  if (!skipped)
+    {
+      return false;
+    }
+
+  // Some worker queues were skipped.  Since the caller is about to wait
+  // for a new request, look at them again, this time waiting for the
+  // locks, so that no dispatchable request is left behind.
+  for (size_t i = 1; i < this->num_queues_; ++i)
+    {
+      Worker_Queue& worker_queue =
+        this->queues_[(owner + i) % this->num_queues_];
+
+      ACE_GUARD_RETURN (LockType, guard, worker_queue.lock_, false);
+
+      if (this->get_i(worker_queue, request))
+        {
+          return true;
+        }
+    }
+
+  return false;
+}
+
+
+void
+TAO::CSD::TP_Stealing_Queue::dispatched(TP_Request* request)
+{
+  if (request->servant_state() == 0)
+    {
+      // The servant is not serialized; there is nothing to mark.
+      return;
+    }
+
+  // The busy flag of the servant is protected by the lock of the worker
+  // queue that holds the requests for the servant.
+  Worker_Queue& worker_queue = this->queues_[this->index(request)];
+
+  ACE_GUARD (LockType, guard, worker_queue.lock_);
+  request->mark_as_ready();
+
+  // There is no need to wake up a waiting worker thread for the requests
+  // that the servant has left in the queue: the thread that dispatched
+  // this request will look for another one right away.
+}
+
+
+int
+TAO::CSD::TP_Stealing_Queue::wait(unsigned long generation,
+                                  const ACE_Time_Value* abstime)
+{
+  ACE_GUARD_RETURN (LockType, guard, this->idle_lock_, -1);
+
+  ++this->idle_;
+
+  int result = 0;
+
+  while (result == 0 && this->generation_.value() == generation)
+    {
+      result = this->work_available_.wait(abstime);
+    }
+
+  --this->idle_;
+
+  return result;
+}
+
+
+void
+TAO::CSD::TP_Stealing_Queue::accept_visitor(TP_Queue_Visitor& visitor)
+{
+  for (size_t i = 0; i < this->num_queues_; ++i)
+    {
+      ACE_GUARD (LockType, guard, this->queues_[i].lock_);
+      this->queues_[i].queue_.accept_visitor(visitor);
+    }
+}
+
+
+bool
+TAO::CSD::TP_Stealing_Queue::get_i(Worker_Queue& worker_queue,
+                                   TP_Request_Handle& request)
+{
+  // There is no need to visit the worker queue if it is empty.
+  if (worker_queue.queue_.is_empty())
+    {
+      return false;
+    }
+
+  // The visitor extracts the first request whose servant is not busy,
+  // and marks the servant as busy.
+  TP_Dispatchable_Visitor dispatchable_visitor;
+  worker_queue.queue_.accept_visitor(dispatchable_visitor);
+
+  request = dispatchable_visitor.request();
+
+  return !request.is_nil();
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,169 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    CSD_TP_Stealing_Queue.h
+ */
+//=============================================================================
+
+#ifndef TAO_CSD_TP_STEALING_QUEUE_H
+#define TAO_CSD_TP_STEALING_QUEUE_H
+
+#include /**/ "ace/pre.h"
+
+#include "tao/CSD_ThreadPool/CSD_TP_Export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "tao/CSD_ThreadPool/CSD_TP_Queue.h"
+#include "tao/CSD_ThreadPool/CSD_TP_Request.h"
+#include "tao/Condition.h"
+#include "ace/Atomic_Op.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace TAO
+{
+  namespace CSD
+  {
+
+    class TP_Queue_Visitor;
+
+
+    /**
+     * @class TP_Stealing_Queue
+     *
+     * @brief Queue of servant requests split in one queue per worker thread.
+     *
+     * A single TP_Queue is protected by one lock that every ORB thread
+     * placing a request and every worker thread looking for one has to
+     * take.  With many worker threads, this lock limits the number of
+     * requests that the pool can dispatch.
+     *
+     * This queue is made of several TP_Queue objects, the "worker
+     * queues", each with its own lock.  A request is placed on the worker
+     * queue selected by its servant state object, so all the requests
+     * for a serialized servant are kept in order in the same worker
+     * queue, and the busy flag of the servant is only changed under the
+     * lock of that worker queue.  Requests for servants that are not
+     * serialized are spread over all the worker queues.
+     *
+     * Each worker thread is attached to one worker queue, and looks for
+     * a "dispatchable" request there first.  When there is none, it
+     * steals the first dispatchable request of another worker queue, so
+     * no request waits while a worker thread is idle.  Worker threads
+     * that find nothing wait for the next request; the ORB threads only
+     * take the lock of the condition they wait on when a worker thread
+     * is actually waiting.
+     */
+    class TAO_CSD_TP_Export TP_Stealing_Queue
+    {
+    public:
+
+      /// Default Constructor.
+      TP_Stealing_Queue();
+
+      /// Destructor.
+      ~TP_Stealing_Queue();
+
+      /// Start accepting requests.  The first call creates
+      /// @a num_queues worker queues (at least one), which are kept
+      /// until the queue is destroyed.
+      void open(size_t num_queues);
+
+      /// Stop accepting requests, and wake up all the waiting worker
+      /// threads.  The requests left in the queue must be cancelled.
+      void close();
+
+      /// Returns the worker queue that a new worker thread is attached to.
+      size_t attach();
+
+      /// Prepare the request to be placed into the queue, and place it at
+      /// the end of its worker queue.  Returns false if the queue is
+      /// closed (the request has been "rejected").
+      bool put(TP_Request* request);
+
+      /// Extract the first dispatchable request of the worker queue
+      /// @a owner, or else of another worker queue, and mark its target
+      /// servant as being busy.  Returns false, without blocking, if
+      /// there is no dispatchable request.
+      bool get(size_t owner, TP_Request_Handle& request);
+
+      /// Mark the target servant of a dispatched request as being ready.
+      void dispatched(TP_Request* request);
+
+      /// Count of the requests placed into the queue so far.  A worker
+      /// thread reads it before it calls get(), and passes it to wait()
+      /// if get() found nothing.
+      unsigned long generation() const;
+
+      /// Wait until a request is placed into the queue after
+      /// generation() returned @a generation, until the queue is closed,
+      /// or until the absolute time @a abstime.  Returns -1, with errno
+      /// set to ETIME, on timeout.
+      int wait(unsigned long generation, const ACE_Time_Value* abstime = 0);
+
+      /// Visit the requests of each worker queue in turn, under the lock
+      /// of the worker queue.
+      void accept_visitor(TP_Queue_Visitor& visitor);
+
+    private:
+
+      typedef TAO_SYNCH_MUTEX         LockType;
+      typedef TAO_Condition<LockType> ConditionType;
+
+      /// One of the worker queues.
+      struct Worker_Queue
+      {
+        Worker_Queue();
+
+        LockType lock_;
+        TP_Queue queue_;
+        bool closed_;
+      };
+
+      /// Returns the worker queue of the request.
+      size_t index(TP_Request* request) const;
+
+      /// Extract the first dispatchable request of a worker queue, which
+      /// must be locked by the caller.
+      bool get_i(Worker_Queue& worker_queue, TP_Request_Handle& request);
+
+      /// The worker queues.
+      Worker_Queue* queues_;
+
+      /// The number of worker queues.
+      size_t num_queues_;
+
+      /// The worker queue that the next worker thread is attached to.
+      ACE_Atomic_Op<LockType, unsigned long> next_owner_;
+
+      /// Incremented each time a request is placed into the queue, or the
+      /// queue is closed.
+      ACE_Atomic_Op<LockType, unsigned long> generation_;
+
+      /// The number of worker threads waiting in wait().
+      ACE_Atomic_Op<LockType, unsigned long> idle_;
+
+      /// Lock of the work_available_ condition.
+      LockType idle_lock_;
+
+      /// Condition signal()'ed when a request is placed into the queue
+      /// while a worker thread is waiting.
+      ConditionType work_available_;
+    };
+
+  }
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#if defined (__ACE_INLINE__)
+# include "tao/CSD_ThreadPool/CSD_TP_Stealing_Queue.inl"
+#endif /* __ACE_INLINE__ */
+
+#include /**/ "ace/post.h"
+
+#endif /* TAO_CSD_TP_STEALING_QUEUE_H */
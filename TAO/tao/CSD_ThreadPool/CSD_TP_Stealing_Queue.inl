@@ -0,0 +1,57 @@
+// -*- C++ -*-
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_INLINE
+TAO::CSD::TP_Stealing_Queue::Worker_Queue::Worker_Queue()
+  : closed_(true)
+{
+}
+
+
+ACE_INLINE
+TAO::CSD::TP_Stealing_Queue::TP_Stealing_Queue()
+  : queues_(0),
+    num_queues_(0),
+    next_owner_(0),
+    generation_(0),
+    idle_(0),
+    work_available_(this->idle_lock_)
+{
+}
+
+
+ACE_INLINE
+size_t
+TAO::CSD::TP_Stealing_Queue::attach()
+{
+  return static_cast<size_t>(this->next_owner_++) % this->num_queues_;
+}
+
+
+ACE_INLINE
+unsigned long
+TAO::CSD::TP_Stealing_Queue::generation() const
+{
+  return this->generation_.value();
+}
+
+
+ACE_INLINE
+size_t
+TAO::CSD::TP_Stealing_Queue::index(TP_Request* request) const
+{
+  TP_Servant_State* const servant_state = request->servant_state();
+
+  // Requests for a servant that is not serialized may go to any worker
+  // queue; spread them using the address of the request itself.  Both
+  // kinds of objects are allocated on the heap, so the low order bits of
+  // their addresses are dropped.
+  size_t const key = (servant_state == 0)
+                     ? reinterpret_cast<size_t>(request)
+                     : reinterpret_cast<size_t>(servant_state);
+
+  return (key >> 4) % this->num_queues_;
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
@@ -59,7 +59,8 @@ namespace TAO
 
       /// Constructor.
       TP_Strategy(Thread_Counter  num_threads = 1,
-                  bool     serialize_servants = true);
+                  bool     serialize_servants = true,
+                  bool     work_stealing = false);
 
       /// Virtual Destructor.
       virtual ~TP_Strategy();
@@ -70,6 +71,11 @@ namespace TAO
       /// Turn on/off serialization of servants.
       void set_servant_serialization(bool serialize_servants);
 
+      /// Turn on/off work stealing: with it, the requests are kept in a
+      /// queue per worker thread, and an idle worker thread takes the
+      /// requests queued for the others (see TP_Stealing_Queue).
+      void set_work_stealing(bool work_stealing);
+
       /// Return codes for the custom dispatch_request() methods.
       enum CustomRequestOutcome
       {
@@ -180,6 +186,9 @@ namespace TAO
       /// The "serialize servants" flag.
       bool serialize_servants_;
 
+      /// The "work stealing" flag.
+      bool work_stealing_;
+
       /// The map of servant state objects - only used when the
       /// "serialize servants" flag is set to true.
       TP_Servant_State_Map servant_state_map_;
@@ -64,6 +64,7 @@ TAO::CSD::TP_Strategy_Factory::init (int argc,
           ACE_CString poa_name;
           unsigned long num_threads = 1;
           bool serialize_servants = true;
+          bool work_stealing = false;
 
           curarg++;
           if (curarg >= argc)
@@ -88,8 +89,19 @@ TAO::CSD::TP_Strategy_Factory::init (int argc,
                 }
               if (*sep == ':')
                 {
+                  ACE_TCHAR *serialize = sep + 1;
+                  sep = ACE_OS::strchr (serialize, ':');
+                  if (sep != 0)
+                    {
+                      *sep = 0;
+                      if (ACE_OS::strcasecmp (
+                        sep + 1, ACE_TEXT_CHAR_TO_TCHAR ("STEAL")) == 0)
+                        {
+                          work_stealing = true;
+                        }
+                    }
                   if (ACE_OS::strcasecmp (
-                    sep + 1, ACE_TEXT_CHAR_TO_TCHAR ("OFF")) == 0)
+                    serialize, ACE_TEXT_CHAR_TO_TCHAR ("OFF")) == 0)
                     {
                       serialize_servants = false;
                     }
@@ -99,7 +111,9 @@ TAO::CSD::TP_Strategy_Factory::init (int argc,
           // Create the ThreadPool strategy for each named poa.
           TP_Strategy* strategy = 0;
           ACE_NEW_RETURN (strategy,
-                          TP_Strategy (num_threads, serialize_servants),
+                          TP_Strategy (num_threads,
+                                       serialize_servants,
+                                       work_stealing),
                           -1);
           CSD_Framework::Strategy_var objref = strategy;
           repo->add_strategy (poa_name, strategy);
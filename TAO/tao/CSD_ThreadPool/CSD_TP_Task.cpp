@@ -17,6 +17,20 @@ TAO::CSD::TP_Task::~TP_Task()
 bool
 TAO::CSD::TP_Task::add_request(TP_Request* request)
 {
+  if (this->work_stealing_)
+    {
+      // The stealing_queue_ has its own locks, and rejects the requests
+      // unless the task is open.
+      if (!this->stealing_queue_.put(request))
+        {
+          TAOLIB_DEBUG((LM_DEBUG,"(%P|%t) TP_Task::add_request() - "
+                     "not accepting requests\n"));
+          return false;
+        }
+
+      return true;
+    }
+
   ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, guard, this->lock_, false);
 
   if (!this->accepting_requests_)
@@ -80,9 +94,20 @@ TAO::CSD::TP_Task::open(void* args)
       return 0;
     }
 
+  if (this->work_stealing_)
+    {
+      // The worker threads attach themselves to the worker queues.
+      this->stealing_queue_.open(num);
+    }
+
   // Activate this task object with 'num' worker threads.
   if (this->activate(THR_NEW_LWP | THR_JOINABLE, num) != 0)
     {
+      if (this->work_stealing_)
+        {
+          this->stealing_queue_.close();
+        }
+
       // Assumes that when activate returns non-zero return code that
       // no threads were activated.
       TAOLIB_ERROR_RETURN((LM_ERROR,
@@ -123,6 +148,11 @@ TAO::CSD::TP_Task::svc()
     this->active_workers_.signal();
   }
 
+  if (this->work_stealing_)
+    {
+      return this->work_stealing_svc();
+    }
+
   // This visitor object will be re-used over and over again as part of
   // the "GetWork" logic below.
   TP_Dispatchable_Visitor dispatchable_visitor;
@@ -241,6 +271,13 @@ TAO::CSD::TP_Task::close(u_long flag)
       // Signal all worker threads waiting on the work_available_ condition.
       this->work_available_.broadcast();
 
+      // Or, with work stealing, reject the requests and wake up the worker
+      // threads waiting in the stealing_queue_.
+      if (this->work_stealing_)
+        {
+          this->stealing_queue_.close();
+        }
+
       bool calling_thread_in_tp = false;
 
       ACE_thread_t my_thr_id = ACE_OS::thr_self ();
@@ -268,7 +305,14 @@ TAO::CSD::TP_Task::close(u_long flag)
 
       // Cancel all requests.
       TP_Cancel_Visitor cancel_visitor;
-      this->queue_.accept_visitor(cancel_visitor);
+      if (this->work_stealing_)
+        {
+          this->stealing_queue_.accept_visitor(cancel_visitor);
+        }
+      else
+        {
+          this->queue_.accept_visitor(cancel_visitor);
+        }
 
       this->opened_ = false;
       this->shutdown_initiated_ = false;
@@ -286,7 +330,72 @@ TAO::CSD::TP_Task::cancel_servant (PortableServer::Servant servant)
 
   // Cancel the requests targeted for the provided servant.
   TP_Cancel_Visitor cancel_visitor(servant);
-  this->queue_.accept_visitor(cancel_visitor);
+  if (this->work_stealing_)
+    {
+      this->stealing_queue_.accept_visitor(cancel_visitor);
+    }
+  else
+    {
+      this->queue_.accept_visitor(cancel_visitor);
+    }
+}
+
+
+int
+TAO::CSD::TP_Task::work_stealing_svc()
+{
+  // The worker queue that this worker thread looks at first.
+  size_t const owner = this->stealing_queue_.attach();
+
+  // Start the "GetWork-And-PerformWork" loop for the current worker thread.
+  while (1)
+    {
+      TP_Request_Handle request;
+
+      // Do the "GetWork" step.  The stealing_queue_ has its own locks, so
+      // the lock_ is only held while the shutdown flags are checked.
+      while (request.is_nil())
+        {
+          // Read the generation before the shutdown flags: close() sets
+          // them before it closes the stealing_queue_, which changes the
+          // generation.
+          unsigned long const generation =
+            this->stealing_queue_.generation();
+
+          {
+            ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, guard, this->lock_, 0);
+
+            if (this->shutdown_initiated_)
+              {
+                return 0;
+              }
+
+            if (this->deferred_shutdown_initiated_)
+              {
+                this->deferred_shutdown_initiated_  = false;
+                return 0;
+              }
+          }
+
+          // Look for a dispatchable request in our own worker queue, or
+          // steal one from another worker queue.  The target servant is
+          // marked as busy when one is found.
+          if (!this->stealing_queue_.get(owner, request))
+            {
+              // Wait until a new request has been placed into the queue
+              // since we read the generation.
+              this->stealing_queue_.wait(generation);
+            }
+        }
+
+      // Do the "PerformWork" step.
+      request->dispatch();
+
+      // Mark the target servant as no longer being busy.  This thread
+      // looks for the next request of the servant itself, so there is
+      // no need to signal other worker threads.
+      this->stealing_queue_.dispatched(request.in());
+    }
 }
 
 TAO_END_VERSIONED_NAMESPACE_DECL
@@ -16,6 +16,7 @@
 #include "tao/CSD_ThreadPool/CSD_TP_Export.h"
 
 #include "tao/CSD_ThreadPool/CSD_TP_Queue.h"
+#include "tao/CSD_ThreadPool/CSD_TP_Stealing_Queue.h"
 #include "tao/PortableServer/PortableServer.h"
 #include "tao/Condition.h"
 
@@ -61,6 +62,11 @@ namespace TAO
      * worker thread will invoke this task's close() method (with the
      * flag argument equal to 0).
      *
+     * By default, all the requests are kept in one queue protected by the
+     * lock of the task.  With set_work_stealing(true), they are kept in a
+     * TP_Stealing_Queue instead, with a queue per worker thread, and the
+     * lock of the task is only used to start and stop the worker threads.
+     *
      * @note I just wanted to document an idea...  When the pool consists
      *       of only one worker thread, we could care less about checking
      *       if target servant objects are busy or not.  The simple fact
@@ -102,8 +108,16 @@ namespace TAO
       /// Cancel all requests that are targeted for the provided servant.
       void cancel_servant (PortableServer::Servant servant);
 
+      /// Turn on/off the use of a TP_Stealing_Queue.  This is ignored
+      /// while the task is open.
+      void set_work_stealing(bool work_stealing);
+
     private:
 
+      /// The svc() loop of the worker threads when the requests are kept
+      /// in the stealing_queue_.
+      int work_stealing_svc();
+
       typedef TAO_SYNCH_MUTEX         LockType;
       typedef TAO_Condition<LockType> ConditionType;
 
@@ -143,6 +157,13 @@ namespace TAO
       /// The queue of pending servant requests (a.k.a. the "request queue").
       TP_Queue queue_;
 
+      /// Flag used to keep the requests in the stealing_queue_ rather
+      /// than in the queue_.  Only changed while the task is not open.
+      bool work_stealing_;
+
+      /// The queue of pending servant requests when work stealing is on.
+      TP_Stealing_Queue stealing_queue_;
+
       typedef ACE_Vector <ACE_thread_t> Thread_Ids;
 
       /// The list of ids for the threads launched by this task.
@@ -10,8 +10,22 @@ TAO::CSD::TP_Task::TP_Task()
     deferred_shutdown_initiated_(false),
     opened_(false),
     num_threads_(0),
+    work_stealing_(false),
     activated_threads_ ((size_t)MAX_THREADPOOL_TASK_WORKER_THREADS)
 {
 }
 
+
+ACE_INLINE
+void
+TAO::CSD::TP_Task::set_work_stealing(bool work_stealing)
+{
+  ACE_GUARD (TAO_SYNCH_MUTEX, guard, this->lock_);
+
+  if (!this->opened_)
+    {
+      this->work_stealing_ = work_stealing;
+    }
+}
+
 TAO_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,52 @@
+#include "tao/Compression/Compression_Dictionary.h"
+#include "ace/ACE.h"
+#include "ace/OS_NS_fcntl.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/OS_NS_sys_stat.h"
+#include "tao/debug.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace TAO
+{
+  int
+  load_compression_dictionary (const ACE_TCHAR *filename,
+                               ::Compression::Buffer &dictionary)
+  {
+    ACE_HANDLE const handle = ACE_OS::open (filename, O_RDONLY | O_BINARY);
+    if (handle == ACE_INVALID_HANDLE)
+      TAOLIB_ERROR_RETURN ((LM_ERROR,
+                            ACE_TEXT ("(%P|%t) ERROR: Unable to open ")
+                            ACE_TEXT ("compression dictionary <%s>\n"),
+                            filename),
+                           -1);
+
+    ACE_OFF_T const size = ACE_OS::filesize (handle);
+    int result = -1;
+
+    if (size >= 0)
+      {
+        dictionary.length (static_cast<CORBA::ULong> (size));
+        if (ACE::read_n (handle,
+                         dictionary.get_buffer (),
+                         static_cast<size_t> (size)) == static_cast<ssize_t> (size))
+          result = 0;
+      }
+
+    ACE_OS::close (handle);
+
+    if (result != 0)
+      {
+        dictionary.length (0);
+        TAOLIB_ERROR_RETURN ((LM_ERROR,
+                              ACE_TEXT ("(%P|%t) ERROR: Unable to read ")
+                              ACE_TEXT ("compression dictionary <%s>\n"),
+                              filename),
+                             -1);
+      }
+
+    return 0;
+  }
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,47 @@
+// -*- C++ -*-
+
+// ===================================================================
+/**
+ *  @file   Compression_Dictionary.h
+ *
+ *  Compressors such as zstd and lz4 can be given a dictionary of data
+ *  that resembles the messages, which makes small messages compress
+ *  much better.  Both peers need the same dictionary, so a compressor
+ *  factory using one is registered with its own CompressorId; ZIOP
+ *  sends the id with every compressed message.
+ */
+// ===================================================================
+
+#ifndef TAO_COMPRESSION_DICTIONARY_H
+#define TAO_COMPRESSION_DICTIONARY_H
+
+#include /**/ "ace/pre.h"
+
+#include "tao/Compression/compression_export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "tao/Compression/Compression.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace TAO
+{
+  /**
+   * Read the dictionary in @a filename, for example one trained with
+   * "zstd --train" on captured messages, into @a dictionary.
+   *
+   * @return 0 on success, -1 if the file can't be read.
+   */
+  TAO_Compression_Export int
+  load_compression_dictionary (const ACE_TCHAR *filename,
+                               ::Compression::Buffer &dictionary);
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#include /**/ "ace/post.h"
+
+#endif /* TAO_COMPRESSION_DICTIONARY_H */
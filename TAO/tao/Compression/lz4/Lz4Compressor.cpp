@@ -0,0 +1,238 @@
+#include "Lz4Compressor.h"
+#include "ace/Min_Max.h"
+#include "ace/OS_NS_string.h"
+#include <lz4.h>
+#include <lz4hc.h>
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace TAO
+{
+/// lz4 only looks back this far, so more dictionary isn't used.
+static CORBA::ULong const LZ4_DICTIONARY_SIZE = 64 * 1024;
+
+Lz4Compressor::Lz4Compressor (
+  ::Compression::CompressorFactory_ptr compressor_factory,
+  ::Compression::CompressionLevel compression_level,
+  const ::Compression::Buffer &dictionary) :
+    BaseCompressor (compressor_factory, compression_level),
+    dictionary_stream_ (0)
+{
+  CORBA::ULong const length = dictionary.length ();
+
+  if (length > 0)
+    {
+      CORBA::ULong const used = ace_min (length, LZ4_DICTIONARY_SIZE);
+      this->dictionary_.length (used);
+      ACE_OS::memcpy (this->dictionary_.get_buffer (),
+                      dictionary.get_buffer () + (length - used),
+                      used);
+
+      if (compression_level == 0)
+        {
+          this->dictionary_stream_ = ::LZ4_createStream ();
+          if (this->dictionary_stream_ == 0)
+            {
+              throw ::Compression::CompressionException (
+                0, "unable to create lz4 stream");
+            }
+
+          ::LZ4_loadDict (this->dictionary_stream_,
+                          reinterpret_cast <const char*> (this->dictionary_.get_buffer ()),
+                          static_cast <int> (used));
+        }
+    }
+}
+
+Lz4Compressor::~Lz4Compressor (void)
+{
+  for (size_t i = 0; i < this->streams_.size (); ++i)
+    ::LZ4_freeStream (this->streams_[i]);
+
+  for (size_t i = 0; i < this->hc_streams_.size (); ++i)
+    ::LZ4_freeStreamHC (this->hc_streams_[i]);
+
+  if (this->dictionary_stream_ != 0)
+    ::LZ4_freeStream (this->dictionary_stream_);
+}
+
+void
+Lz4Compressor::compress (
+    const ::Compression::Buffer & source,
+    ::Compression::Buffer & target)
+{
+  if (source.length () > static_cast <CORBA::ULong> (LZ4_MAX_INPUT_SIZE))
+    {
+      throw ::Compression::CompressionException (
+        0, "message too large for lz4");
+    }
+
+  int const source_length = static_cast <int> (source.length ());
+
+  // Ensure maximum is big enough for data that doesn't compress.
+  target.length (static_cast <CORBA::ULong> (
+    ::LZ4_compressBound (source_length)));
+
+  const char *const source_buffer =
+    reinterpret_cast <const char*> (source.get_buffer ());
+  char *const target_buffer =
+    reinterpret_cast <char*> (target.get_buffer ());
+  int const target_length = static_cast <int> (target.maximum ());
+
+  int retval = 0;
+
+  if (this->compression_level () > 0)
+    retval = this->compress_hc (source_buffer, target_buffer,
+                                source_length, target_length);
+  else if (this->dictionary_stream_ != 0)
+    retval = this->compress_fast (source_buffer, target_buffer,
+                                  source_length, target_length);
+  else
+    retval = ::LZ4_compress_default (source_buffer, target_buffer,
+                                     source_length, target_length);
+
+  if (retval <= 0)
+    {
+      throw ::Compression::CompressionException (
+        retval, "lz4 compression failed");
+    }
+  else
+    {
+      target.length (static_cast <CORBA::ULong> (retval));
+    }
+
+  // Update statistics for this compressor
+  this->update_stats (source.length (), target.length ());
+}
+
+void
+Lz4Compressor::decompress (
+  const ::Compression::Buffer & source,
+  ::Compression::Buffer & target)
+{
+  const char *const source_buffer =
+    reinterpret_cast <const char*> (source.get_buffer ());
+  char *const target_buffer =
+    reinterpret_cast <char*> (target.get_buffer ());
+  int const source_length = static_cast <int> (source.length ());
+  int const target_length = static_cast <int> (
+    ace_min (target.maximum (), static_cast <CORBA::ULong> (LZ4_MAX_INPUT_SIZE)));
+
+  int retval = 0;
+
+  if (this->dictionary_.length () > 0)
+    retval = ::LZ4_decompress_safe_usingDict (
+               source_buffer,
+               target_buffer,
+               source_length,
+               target_length,
+               reinterpret_cast <const char*> (this->dictionary_.get_buffer ()),
+               static_cast <int> (this->dictionary_.length ()));
+  else
+    retval = ::LZ4_decompress_safe (source_buffer,
+                                    target_buffer,
+                                    source_length,
+                                    target_length);
+
+  if (retval < 0)
+    {
+      throw ::Compression::CompressionException (
+        retval, "lz4 decompression failed");
+    }
+  else
+    {
+      target.length (static_cast <CORBA::ULong> (retval));
+    }
+}
+
+int
+Lz4Compressor::compress_fast (const char *source, char *target,
+                              int source_length, int target_length)
+{
+  LZ4_stream_t *stream = 0;
+
+  {
+    ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, this->stream_mutex_, 0);
+
+    if (!this->streams_.empty ())
+      {
+        stream = this->streams_.back ();
+        this->streams_.pop_back ();
+      }
+  }
+
+  if (stream == 0)
+    stream = ::LZ4_createStream ();
+
+  if (stream == 0)
+    return 0;
+
+  // Copying the state is much cheaper than loading the dictionary.
+  ACE_OS::memcpy (stream, this->dictionary_stream_, sizeof (LZ4_stream_t));
+
+  int const retval = ::LZ4_compress_fast_continue (stream,
+                                                   source,
+                                                   target,
+                                                   source_length,
+                                                   target_length,
+                                                   1);
+
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, this->stream_mutex_, retval);
+  this->streams_.push_back (stream);
+
+  return retval;
+}
+
+int
+Lz4Compressor::compress_hc (const char *source, char *target,
+                            int source_length, int target_length)
+{
+  LZ4_streamHC_t *stream = 0;
+
+  {
+    ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, this->stream_mutex_, 0);
+
+    if (!this->hc_streams_.empty ())
+      {
+        stream = this->hc_streams_.back ();
+        this->hc_streams_.pop_back ();
+      }
+  }
+
+  if (stream == 0)
+    stream = ::LZ4_createStreamHC ();
+
+  if (stream == 0)
+    return 0;
+
+  int const level = static_cast <int> (this->compression_level ());
+  int retval = 0;
+
+  if (this->dictionary_.length () > 0)
+    {
+      ::LZ4_resetStreamHC_fast (stream, level);
+      ::LZ4_loadDictHC (stream,
+                        reinterpret_cast <const char*> (this->dictionary_.get_buffer ()),
+                        static_cast <int> (this->dictionary_.length ()));
+      retval = ::LZ4_compress_HC_continue (stream,
+                                           source,
+                                           target,
+                                           source_length,
+                                           target_length);
+    }
+  else
+    retval = ::LZ4_compress_HC_extStateHC (stream,
+                                           source,
+                                           target,
+                                           source_length,
+                                           target_length,
+                                           level);
+
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, this->stream_mutex_, retval);
+  this->hc_streams_.push_back (stream);
+
+  return retval;
+}
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,87 @@
+// -*- C++ -*-
+
+// ===================================================================
+/**
+ *  @file   Lz4Compressor.h
+ *
+ *  See http://lz4.github.io/lz4/ for the lz4 interface itself
+ */
+// ===================================================================
+
+#ifndef TAO_LZ4COMPRESSOR_H
+#define TAO_LZ4COMPRESSOR_H
+
+#include /**/ "ace/pre.h"
+
+#include "tao/Compression/lz4/Lz4Compressor_export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "tao/Compression/Compression.h"
+#include "tao/Compression/Base_Compressor.h"
+#include <vector>
+
+union LZ4_stream_u;
+union LZ4_streamHC_u;
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace TAO
+{
+  /**
+   * Compressor using lz4.  Compression level 0 selects the fast lz4
+   * compressor, levels 1 to 12 lz4 HC at that level, which is slower
+   * but compresses better.  Decompression is equally fast for all.
+   *
+   * With a dictionary (of which lz4 uses the last 64 KB) the messages
+   * are compressed and decompressed against it, which the peer needs
+   * to have too.  The stream states are kept for the next call; the
+   * fast compressor copies a state that has the dictionary loaded
+   * already.
+   */
+  class TAO_LZ4COMPRESSOR_Export Lz4Compressor : public BaseCompressor
+  {
+    public:
+      Lz4Compressor (::Compression::CompressorFactory_ptr compressor_factory,
+                     ::Compression::CompressionLevel compression_level,
+                     const ::Compression::Buffer &dictionary);
+
+      virtual ~Lz4Compressor (void);
+
+      virtual void compress (
+          const ::Compression::Buffer & source,
+          ::Compression::Buffer & target);
+
+      virtual void decompress (
+          const ::Compression::Buffer & source,
+          ::Compression::Buffer & target);
+
+    private:
+      /// Compress with the fast compressor and the dictionary.
+      int compress_fast (const char *source, char *target,
+                         int source_length, int target_length);
+
+      /// Compress with lz4 HC.
+      int compress_hc (const char *source, char *target,
+                       int source_length, int target_length);
+
+      /// The end of the dictionary, which must stay where it is for
+      /// the streams that loaded it.
+      ::Compression::Buffer dictionary_;
+
+      /// A fast stream with the dictionary loaded, or 0.
+      LZ4_stream_u *dictionary_stream_;
+
+      TAO_SYNCH_MUTEX stream_mutex_;
+      std::vector<LZ4_stream_u *> streams_;
+      std::vector<LZ4_streamHC_u *> hc_streams_;
+  };
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#include /**/ "ace/post.h"
+
+#endif /* TAO_LZ4COMPRESSOR_H */
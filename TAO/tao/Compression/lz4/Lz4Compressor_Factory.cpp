@@ -0,0 +1,65 @@
+#include "tao/Compression/lz4/Lz4Compressor_Factory.h"
+#include "tao/Compression/lz4/Lz4Compressor.h"
+#include "ace/Min_Max.h"
+#include <lz4hc.h>
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace TAO
+{
+
+Lz4_CompressorFactory::Lz4_CompressorFactory (void) :
+  ::TAO::CompressorFactory (::Compression::COMPRESSORID_LZ4)
+{
+}
+
+Lz4_CompressorFactory::Lz4_CompressorFactory (
+    ::Compression::CompressorId compressor_id,
+    const ::Compression::Buffer &dictionary) :
+  ::TAO::CompressorFactory (compressor_id),
+  dictionary_ (dictionary)
+{
+}
+
+::Compression::Compressor_ptr
+Lz4_CompressorFactory::get_compressor (
+    ::Compression::CompressionLevel compression_level)
+{
+    // Levels above the maximum of lz4 HC get the maximum.
+    compression_level = ace_min (::Compression::CompressionLevel (LZ4HC_CLEVEL_MAX),
+                                 compression_level);
+
+    ::Compression::Compressor_ptr compressor = 0;
+
+    {   // Ensure scoped lock for compressor Map container
+
+        ACE_GUARD_RETURN( TAO_SYNCH_MUTEX, ace_mon, this->mutex_, 0 );
+
+        try {
+            // Try and locate the compressor (we may already have it)
+            Lz4CompressorMap::iterator it = this->compressors_.find(compression_level);
+
+            if (it == this->compressors_.end())
+            {  // Does not yet exist so create it
+                ACE_NEW_RETURN(compressor,
+                               ::TAO::Lz4Compressor(this, compression_level, this->dictionary_),
+                               0);
+                it = this->compressors_.insert(Lz4CompressorMap::value_type(compression_level, compressor)).first;
+            }
+
+            compressor = (*it).second.in();
+
+        } catch (...) {
+            TAOLIB_ERROR_RETURN((LM_ERROR,
+                ACE_TEXT("(%P | %t) ERROR: Lz4Compressor - Unable to create LZ4 Compressor at level [%d].\n"),
+                int(compression_level)),0);
+        }
+
+    }   // End of scoped container locking
+
+    return ::Compression::Compressor::_duplicate(compressor);
+}
+
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,191 @@
+#include "ZstdCompressor.h"
+#include <zstd.h>
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace TAO
+{
+ZstdCompressor::ZstdCompressor (
+  ::Compression::CompressorFactory_ptr compressor_factory,
+  ::Compression::CompressionLevel compression_level,
+  const ::Compression::Buffer &dictionary) :
+    BaseCompressor (compressor_factory, compression_level),
+    compression_dictionary_ (0),
+    decompression_dictionary_ (0)
+{
+  if (dictionary.length () > 0)
+    {
+      // Both copy the dictionary, so it needn't outlive us.
+      this->compression_dictionary_ =
+        ::ZSTD_createCDict (dictionary.get_buffer (),
+                            dictionary.length (),
+                            compression_level);
+      this->decompression_dictionary_ =
+        ::ZSTD_createDDict (dictionary.get_buffer (),
+                            dictionary.length ());
+
+      if (this->compression_dictionary_ == 0
+          || this->decompression_dictionary_ == 0)
+        {
+          ::ZSTD_freeCDict (this->compression_dictionary_);
+          ::ZSTD_freeDDict (this->decompression_dictionary_);
+          throw ::Compression::CompressionException (
+            0, "unable to load zstd dictionary");
+        }
+    }
+}
+
+ZstdCompressor::~ZstdCompressor (void)
+{
+  for (size_t i = 0; i < this->compression_contexts_.size (); ++i)
+    ::ZSTD_freeCCtx (this->compression_contexts_[i]);
+
+  for (size_t i = 0; i < this->decompression_contexts_.size (); ++i)
+    ::ZSTD_freeDCtx (this->decompression_contexts_[i]);
+
+  ::ZSTD_freeCDict (this->compression_dictionary_);
+  ::ZSTD_freeDDict (this->decompression_dictionary_);
+}
+
+void
+ZstdCompressor::compress (
+    const ::Compression::Buffer & source,
+    ::Compression::Buffer & target)
+{
+  // Ensure maximum is big enough for data that doesn't compress.
+  target.length (static_cast <CORBA::ULong> (
+    ::ZSTD_compressBound (source.length ())));
+
+  ZSTD_CCtx *const context = this->acquire_compression_context ();
+
+  if (context == 0)
+    {
+      throw ::Compression::CompressionException (
+        0, "unable to create zstd context");
+    }
+
+  size_t retval = 0;
+
+  if (this->compression_dictionary_ != 0)
+    retval = ::ZSTD_compress_usingCDict (context,
+                                         target.get_buffer (),
+                                         target.maximum (),
+                                         source.get_buffer (),
+                                         source.length (),
+                                         this->compression_dictionary_);
+  else
+    retval = ::ZSTD_compressCCtx (context,
+                                  target.get_buffer (),
+                                  target.maximum (),
+                                  source.get_buffer (),
+                                  source.length (),
+                                  this->compression_level ());
+
+  this->release_compression_context (context);
+
+  if (::ZSTD_isError (retval))
+    {
+      throw ::Compression::CompressionException (
+        static_cast <CORBA::Long> (0 - retval), ::ZSTD_getErrorName (retval));
+    }
+  else
+    {
+      target.length (static_cast <CORBA::ULong> (retval));
+    }
+
+  // Update statistics for this compressor
+  this->update_stats (source.length (), target.length ());
+}
+
+void
+ZstdCompressor::decompress (
+  const ::Compression::Buffer & source,
+  ::Compression::Buffer & target)
+{
+  ZSTD_DCtx *const context = this->acquire_decompression_context ();
+
+  if (context == 0)
+    {
+      throw ::Compression::CompressionException (
+        0, "unable to create zstd context");
+    }
+
+  size_t retval = 0;
+
+  if (this->decompression_dictionary_ != 0)
+    retval = ::ZSTD_decompress_usingDDict (context,
+                                           target.get_buffer (),
+                                           target.maximum (),
+                                           source.get_buffer (),
+                                           source.length (),
+                                           this->decompression_dictionary_);
+  else
+    retval = ::ZSTD_decompressDCtx (context,
+                                    target.get_buffer (),
+                                    target.maximum (),
+                                    source.get_buffer (),
+                                    source.length ());
+
+  this->release_decompression_context (context);
+
+  if (::ZSTD_isError (retval))
+    {
+      throw ::Compression::CompressionException (
+        static_cast <CORBA::Long> (0 - retval), ::ZSTD_getErrorName (retval));
+    }
+  else
+    {
+      target.length (static_cast <CORBA::ULong> (retval));
+    }
+}
+
+ZSTD_CCtx *
+ZstdCompressor::acquire_compression_context (void)
+{
+  {
+    ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, this->context_mutex_, 0);
+
+    if (!this->compression_contexts_.empty ())
+      {
+        ZSTD_CCtx *const context = this->compression_contexts_.back ();
+        this->compression_contexts_.pop_back ();
+        return context;
+      }
+  }
+
+  return ::ZSTD_createCCtx ();
+}
+
+void
+ZstdCompressor::release_compression_context (ZSTD_CCtx *context)
+{
+  ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, this->context_mutex_);
+  this->compression_contexts_.push_back (context);
+}
+
+ZSTD_DCtx *
+ZstdCompressor::acquire_decompression_context (void)
+{
+  {
+    ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, this->context_mutex_, 0);
+
+    if (!this->decompression_contexts_.empty ())
+      {
+        ZSTD_DCtx *const context = this->decompression_contexts_.back ();
+        this->decompression_contexts_.pop_back ();
+        return context;
+      }
+  }
+
+  return ::ZSTD_createDCtx ();
+}
+
+void
+ZstdCompressor::release_decompression_context (ZSTD_DCtx *context)
+{
+  ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, this->context_mutex_);
+  this->decompression_contexts_.push_back (context);
+}
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,80 @@
+// -*- C++ -*-
+
+// ===================================================================
+/**
+ *  @file   ZstdCompressor.h
+ *
+ *  See http://facebook.github.io/zstd/ for the zstd interface itself
+ */
+// ===================================================================
+
+#ifndef TAO_ZSTDCOMPRESSOR_H
+#define TAO_ZSTDCOMPRESSOR_H
+
+#include /**/ "ace/pre.h"
+
+#include "tao/Compression/zstd/ZstdCompressor_export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "tao/Compression/Compression.h"
+#include "tao/Compression/Base_Compressor.h"
+#include <vector>
+
+struct ZSTD_CCtx_s;
+struct ZSTD_DCtx_s;
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace TAO
+{
+  /**
+   * Compressor using zstd.  With a dictionary the messages are
+   * compressed and decompressed against it, which the peer needs to
+   * have too.  The zstd contexts are expensive to create, so they are
+   * kept for the next call; there are as many as calls that ran at
+   * the same time.
+   */
+  class TAO_ZSTDCOMPRESSOR_Export ZstdCompressor : public BaseCompressor
+  {
+    public:
+      ZstdCompressor (::Compression::CompressorFactory_ptr compressor_factory,
+                      ::Compression::CompressionLevel compression_level,
+                      const ::Compression::Buffer &dictionary);
+
+      virtual ~ZstdCompressor (void);
+
+      virtual void compress (
+          const ::Compression::Buffer & source,
+          ::Compression::Buffer & target);
+
+      virtual void decompress (
+          const ::Compression::Buffer & source,
+          ::Compression::Buffer & target);
+
+    private:
+      ZSTD_CCtx_s *acquire_compression_context (void);
+      void release_compression_context (ZSTD_CCtx_s *context);
+
+      ZSTD_DCtx_s *acquire_decompression_context (void);
+      void release_decompression_context (ZSTD_DCtx_s *context);
+
+      /// The dictionary, digested for our compression level, or 0.
+      ZSTD_CDict_s *compression_dictionary_;
+      ZSTD_DDict_s *decompression_dictionary_;
+
+      TAO_SYNCH_MUTEX context_mutex_;
+      std::vector<ZSTD_CCtx_s *> compression_contexts_;
+      std::vector<ZSTD_DCtx_s *> decompression_contexts_;
+  };
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#include /**/ "ace/post.h"
+
+#endif /* TAO_ZSTDCOMPRESSOR_H */
@@ -0,0 +1,65 @@
+#include "tao/Compression/zstd/ZstdCompressor_Factory.h"
+#include "tao/Compression/zstd/ZstdCompressor.h"
+#include "ace/Min_Max.h"
+#include <zstd.h>
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace TAO
+{
+
+Zstd_CompressorFactory::Zstd_CompressorFactory (void) :
+  ::TAO::CompressorFactory (::Compression::COMPRESSORID_ZSTD)
+{
+}
+
+Zstd_CompressorFactory::Zstd_CompressorFactory (
+    ::Compression::CompressorId compressor_id,
+    const ::Compression::Buffer &dictionary) :
+  ::TAO::CompressorFactory (compressor_id),
+  dictionary_ (dictionary)
+{
+}
+
+::Compression::Compressor_ptr
+Zstd_CompressorFactory::get_compressor (
+    ::Compression::CompressionLevel compression_level)
+{
+    // Levels above the maximum of this zstd version get the maximum.
+    compression_level = ace_min (::Compression::CompressionLevel (::ZSTD_maxCLevel ()),
+                                 compression_level);
+
+    ::Compression::Compressor_ptr compressor = 0;
+
+    {   // Ensure scoped lock for compressor Map container
+
+        ACE_GUARD_RETURN( TAO_SYNCH_MUTEX, ace_mon, this->mutex_, 0 );
+
+        try {
+            // Try and locate the compressor (we may already have it)
+            ZstdCompressorMap::iterator it = this->compressors_.find(compression_level);
+
+            if (it == this->compressors_.end())
+            {  // Does not yet exist so create it
+                ACE_NEW_RETURN(compressor,
+                               ::TAO::ZstdCompressor(this, compression_level, this->dictionary_),
+                               0);
+                it = this->compressors_.insert(ZstdCompressorMap::value_type(compression_level, compressor)).first;
+            }
+
+            compressor = (*it).second.in();
+
+        } catch (...) {
+            TAOLIB_ERROR_RETURN((LM_ERROR,
+                ACE_TEXT("(%P | %t) ERROR: ZstdCompressor - Unable to create Zstd Compressor at level [%d].\n"),
+                int(compression_level)),0);
+        }
+
+    }   // End of scoped container locking
+
+    return ::Compression::Compressor::_duplicate(compressor);
+}
+
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,68 @@
+// -*- C++ -*-
+
+// ===================================================================
+/**
+ *  @file   ZstdCompressor_Factory.h
+ */
+// ===================================================================
+
+#ifndef TAO_ZSTDCOMPRESSOR_FACTORY_H
+#define TAO_ZSTDCOMPRESSOR_FACTORY_H
+
+#include /**/ "ace/pre.h"
+
+#include "tao/Compression/zstd/ZstdCompressor_export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "tao/Compression/Compression.h"
+#include "tao/Compression/Compressor_Factory.h"
+#include <map>
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace TAO
+{
+  /**
+   * Factory of zstd compressors.  The compression levels are those of
+   * zstd, where 0 selects its default level.
+   */
+  class TAO_ZSTDCOMPRESSOR_Export Zstd_CompressorFactory :
+    public ::TAO::CompressorFactory
+  {
+    typedef std::map< ::Compression::CompressionLevel,
+        const ::Compression::Compressor_var> ZstdCompressorMap;
+
+  public:
+    /// Plain zstd, registered as COMPRESSORID_ZSTD.
+    Zstd_CompressorFactory (void);
+
+    /**
+     * Zstd with @a dictionary, registered as @a compressor_id.  The
+     * peers have to register the same dictionary under the same id,
+     * see load_compression_dictionary().
+     */
+    Zstd_CompressorFactory (::Compression::CompressorId compressor_id,
+                            const ::Compression::Buffer &dictionary);
+
+    virtual ::Compression::Compressor_ptr get_compressor (
+        ::Compression::CompressionLevel compression_level);
+
+  private:
+    ACE_UNIMPLEMENTED_FUNC (Zstd_CompressorFactory (const Zstd_CompressorFactory &))
+    ACE_UNIMPLEMENTED_FUNC (Zstd_CompressorFactory &operator= (const Zstd_CompressorFactory &))
+
+    // Ensure we can lock with imutability (i.e. const)
+    mutable TAO_SYNCH_MUTEX mutex_;
+    ZstdCompressorMap       compressors_;
+    ::Compression::Buffer   dictionary_;
+  };
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#include /**/ "ace/post.h"
+
+#endif /* TAO_ZSTDCOMPRESSOR_FACTORY_H */
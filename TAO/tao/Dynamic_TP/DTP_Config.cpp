@@ -168,6 +168,17 @@ TAO_DTP_Config::init (int argc, ACE_TCHAR* argv[])
             }
              entry.queue_depth_ = val;
         }
+      else if ((r = this->parse_bool (curarg,
+                                      argc,
+                                      argv,
+                                      ACE_TEXT("-DTPStealing"),
+                                      entry.work_stealing_ )) != 0)
+        {
+          if (r < 0)
+            {
+              return -1;
+            }
+        }
       else
         {
           if (TAO_debug_level > 0)
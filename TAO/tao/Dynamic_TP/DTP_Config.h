@@ -38,6 +38,7 @@ struct TAO_Dynamic_TP_Export TAO_DTP_Definition
   size_t stack_size_;
   ACE_Time_Value timeout_;   // default to 60 seconds
   int queue_depth_;
+  bool work_stealing_; // queue the requests of a DTP POA per worker thread.
 
   // Create explicit constructor to eliminate issues with non-initialized struct values.
   TAO_DTP_Definition() :
@@ -46,7 +47,8 @@ struct TAO_Dynamic_TP_Export TAO_DTP_Definition
     max_threads_(-1),
     stack_size_(ACE_DEFAULT_THREAD_STACKSIZE),
     timeout_(60,0),
-    queue_depth_(0){}
+    queue_depth_(0),
+    work_stealing_(false){}
 
 };
 
@@ -400,6 +400,8 @@ TAO_DTP_POA_Strategy::set_dtp_config (TAO_DTP_Definition &tp_config)
         this->dtp_task_.set_max_request_queue_depth (tp_config.queue_depth_);
       }
 
+    this->dtp_task_.set_work_stealing (tp_config.work_stealing_);
+
 
     if (TAO_debug_level > 4)
     {
@@ -24,6 +24,7 @@ TAO_DTP_Task::TAO_DTP_Task ()
     check_queue_ (false),
     opened_ (false),
     num_queue_requests_ ((size_t)0),
+    work_stealing_ (false),
     init_pool_threads_ ((size_t)0),
     min_pool_threads_ ((size_t)0),
     max_pool_threads_ ((size_t)0),
@@ -39,6 +40,13 @@ TAO_DTP_Task::~TAO_DTP_Task()
 bool
 TAO_DTP_Task::add_request (TAO::CSD::TP_Request* request)
 {
+  if (this->work_stealing_ && this->max_request_queue_depth_ == 0)
+    {
+      // There is nothing to count, and the stealing_queue_ rejects the
+      // requests unless the task is open.
+      return this->stealing_queue_.put (request);
+    }
+
   {
     ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, guard, this->queue_lock_, false);
     ++this->num_queue_requests_;
@@ -66,6 +74,16 @@ TAO_DTP_Task::add_request (TAO::CSD::TP_Request* request)
         return false;
       }
 
+    if (this->work_stealing_)
+      {
+        if (!this->stealing_queue_.put (request))
+          {
+            --this->num_queue_requests_;
+            return false;
+          }
+        return true;
+      }
+
     // We have made the decision that the request is going to be placed upon
     // the queue_.  Inform the request that it is about to be placed into
     // a request queue.  Some requests may not need to do anything in
@@ -113,6 +131,12 @@ TAO_DTP_Task::get_max_request_queue_depth ()
   return this->max_request_queue_depth_;
 }
 
+bool
+TAO_DTP_Task::get_work_stealing ()
+{
+  return this->work_stealing_;
+}
+
 size_t
 TAO_DTP_Task::get_thread_stack_size ()
 {
@@ -176,6 +200,13 @@ TAO_DTP_Task::open (void* /* args */)
 
   this->busy_threads_ = 0;
 
+  // The worker threads attach themselves to the worker queues, one per
+  // initial thread.
+  if (this->work_stealing_)
+    {
+      this->stealing_queue_.open (this->init_pool_threads_);
+    }
+
   // Create the stack size arrays if the stack size is set > 0.
 
   // Activate this task object with 'num' worker threads.
@@ -183,6 +214,10 @@ TAO_DTP_Task::open (void* /* args */)
     {
       if (this->activate (THR_NEW_LWP | THR_DETACHED, num, 1) != 0)
         {
+          if (this->work_stealing_)
+            {
+              this->stealing_queue_.close ();
+            }
           TAOLIB_ERROR_RETURN ((LM_ERROR,
                              ACE_TEXT ("(%P|%t) DTP_Task::open() failed to activate ")
                              ACE_TEXT ("(%d) worker threads.\n"),
@@ -208,6 +243,10 @@ TAO_DTP_Task::open (void* /* args */)
                           0,
                           stack_sz_arr) != 0)
         {
+          if (this->work_stealing_)
+            {
+              this->stealing_queue_.close ();
+            }
           TAOLIB_ERROR_RETURN ((LM_ERROR,
                              ACE_TEXT ("(%P|%t) DTP_Task::open() failed to activate ")
                              ACE_TEXT ("(%d) worker threads.\n"),
@@ -234,9 +273,15 @@ TAO_DTP_Task::open (void* /* args */)
 }
 
 bool
-TAO_DTP_Task::request_ready (TAO::CSD::TP_Dispatchable_Visitor &v,
-                                    TAO::CSD::TP_Request_Handle &r)
+TAO_DTP_Task::request_ready (size_t owner,
+                             TAO::CSD::TP_Dispatchable_Visitor &v,
+                             TAO::CSD::TP_Request_Handle &r)
 {
+  if (this->work_stealing_)
+    {
+      return this->stealing_queue_.get (owner, r);
+    }
+
   ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, guard, this->queue_lock_, false);
   if (!this->queue_.is_empty())
     {
@@ -250,6 +295,19 @@ TAO_DTP_Task::request_ready (TAO::CSD::TP_Dispatchable_Visitor &v,
 void
 TAO_DTP_Task::clear_request (TAO::CSD::TP_Request_Handle &r)
 {
+  if (this->work_stealing_)
+    {
+      if (this->max_request_queue_depth_ > 0)
+        {
+          ACE_GUARD (TAO_SYNCH_MUTEX, guard, this->queue_lock_);
+          --this->num_queue_requests_;
+          this->accepting_requests_ = true;
+        }
+
+      this->stealing_queue_.dispatched (r.in ());
+      return;
+    }
+
   ACE_GUARD (TAO_SYNCH_MUTEX, guard, this->queue_lock_);
   --this->num_queue_requests_;
   if (this->max_request_queue_depth_ > 0)
@@ -330,13 +388,20 @@ TAO_DTP_Task::svc (void)
                   ACE_TEXT ("New thread created.\n")));
     }
   TAO::CSD::TP_Dispatchable_Visitor dispatchable_visitor;
+
+  // With work stealing, the worker queue this thread looks at first.
+  size_t const owner =
+    this->work_stealing_ ? this->stealing_queue_.attach () : 0;
+
   while (!this->shutdown_)
     {
       TAO::CSD::TP_Request_Handle request;
 
       while (!this->shutdown_ && request.is_nil ())
         {
-          if (!this->request_ready (dispatchable_visitor, request))
+          unsigned long const generation = this->stealing_queue_.generation ();
+
+          if (!this->request_ready (owner, dispatchable_visitor, request))
             {
               this->remove_busy ();
 
@@ -351,6 +416,29 @@ TAO_DTP_Task::svc (void)
 
               ACE_Time_Value tmp_sec = this->thread_idle_time_.to_absolute_time();
 
+              if (this->work_stealing_)
+                {
+                  // Wait for a request placed into the stealing_queue_
+                  // since we read the generation.
+                  int const wait_state =
+                    this->stealing_queue_.wait (
+                      generation,
+                      this->thread_idle_time_.sec () == 0 ? 0 : &tmp_sec);
+                  if (this->shutdown_)
+                    return 0;
+                  if (wait_state == -1 &&
+                      (errno != ETIME || this->remove_active (false)))
+                    {
+                      if (TAO_debug_level > 4)
+                        {
+                          TAOLIB_DEBUG ((LM_DEBUG,
+                                      ACE_TEXT ("TAO (%P|%t) - DTP_Task::svc() ")
+                                      ACE_TEXT ("Existing thread expiring.\n")));
+                        }
+                      return 0;
+                    }
+                }
+              else
               {
                 ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, guard, this->work_lock_, false);
                 int wait_state = 0;
@@ -456,6 +544,11 @@ TAO_DTP_Task::close (u_long flag)
     this->work_available_.broadcast();
   }
 
+  if (this->work_stealing_)
+    {
+      this->stealing_queue_.close ();
+    }
+
   size_t in_task = (this->thr_mgr ()->task () == this) ? 1 : 0;
   if (TAO_debug_level > 4)
     {
@@ -471,6 +564,12 @@ TAO_DTP_Task::close (u_long flag)
       this->active_workers_.wait ();
     }
 
+  if (this->work_stealing_)
+    {
+      TAO::CSD::TP_Cancel_Visitor v;
+      this->stealing_queue_.accept_visitor (v);
+    }
+  else
   {
     ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, guard, this->queue_lock_, 0);
     TAO::CSD::TP_Cancel_Visitor v;
@@ -516,6 +615,16 @@ TAO_DTP_Task::set_max_request_queue_depth (size_t queue_depth)
   this->max_request_queue_depth_ = queue_depth;
 }
 
+void
+TAO_DTP_Task::set_work_stealing (bool work_stealing)
+{
+  ACE_GUARD (TAO_SYNCH_MUTEX, guard, this->aw_lock_);
+  if (!this->opened_)
+    {
+      this->work_stealing_ = work_stealing;
+    }
+}
+
 void
 TAO_DTP_Task::cancel_servant (PortableServer::Servant servant)
 {
@@ -531,10 +640,16 @@ TAO_DTP_Task::cancel_servant (PortableServer::Servant servant)
       return;
     }
 
-  ACE_GUARD (TAO_SYNCH_MUTEX, guard, this->queue_lock_);
-
   // Cancel the requests targeted for the provided servant.
   TAO::CSD::TP_Cancel_Visitor cancel_visitor (servant);
+
+  if (this->work_stealing_)
+    {
+      this->stealing_queue_.accept_visitor (cancel_visitor);
+      return;
+    }
+
+  ACE_GUARD (TAO_SYNCH_MUTEX, guard, this->queue_lock_);
   this->queue_.accept_visitor (cancel_visitor);
 }
 
@@ -18,6 +18,7 @@
 #include "tao/Dynamic_TP/dynamic_tp_export.h"
 #include "tao/Dynamic_TP/DTP_Config.h"
 #include "tao/CSD_ThreadPool/CSD_TP_Queue.h"
+#include "tao/CSD_ThreadPool/CSD_TP_Stealing_Queue.h"
 #include "tao/CSD_ThreadPool/CSD_TP_Request.h"
 #include "tao/CSD_ThreadPool/CSD_TP_Dispatchable_Visitor.h"
 #include "tao/PortableServer/PortableServer.h"
@@ -99,6 +100,10 @@ TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
       void set_max_request_queue_depth(size_t queue_depth);
 
+      /// Keep the requests in a TAO::CSD::TP_Stealing_Queue rather than
+      /// in a single queue.  Ignored once the task is open.
+      void set_work_stealing(bool work_stealing);
+
       /// Get the thread and queue config.
 
       size_t get_init_pool_threads();
@@ -109,6 +114,8 @@ TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
       size_t get_max_request_queue_depth();
 
+      bool get_work_stealing();
+
       size_t get_thread_stack_size();
 
       time_t get_thread_idle_time();
@@ -118,7 +125,9 @@ TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
     private:
       /// get the next available request. Return true if one available, nonblocking
-      bool request_ready (TAO::CSD::TP_Dispatchable_Visitor &v,
+      /// With work stealing, @a owner is the worker queue looked at first.
+      bool request_ready (size_t owner,
+                          TAO::CSD::TP_Dispatchable_Visitor &v,
                           TAO::CSD::TP_Request_Handle &r);
 
       /// release the request, reset the accepting flag if necessary
@@ -182,6 +191,16 @@ TAO_BEGIN_VERSIONED_NAMESPACE_DECL
       /// The queue of pending servant requests (a.k.a. the "request queue").
       TAO::CSD::TP_Queue queue_;
 
+      /// Flag used to keep the requests in the stealing_queue_ rather than
+      /// in the queue_.
+      bool work_stealing_;
+
+      /// The queue of pending servant requests when work stealing is on.
+      /// It has its own locks, so the queue_lock_ is only needed to count
+      /// the requests when their number is limited, and the work_lock_ is
+      /// not used.
+      TAO::CSD::TP_Stealing_Queue stealing_queue_;
+
       /// The low water mark for dynamic threads to settle to.
       size_t init_pool_threads_;
 
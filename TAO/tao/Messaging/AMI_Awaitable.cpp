@@ -0,0 +1,185 @@
+// -*- C++ -*-
+#include "tao/Messaging/AMI_Awaitable.h"
+
+#if (TAO_HAS_AMI_CALLBACK == 1)
+
+#include "tao/Messaging/ExceptionHolder_i.h"
+#include "tao/Exception_Data.h"
+#include "tao/SystemException.h"
+#include "tao/CDR.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace TAO
+{
+  AMI_Awaitable_Reply_Base::AMI_Awaitable_Reply_Base (void)
+    : args_ (0),
+      nargs_ (0),
+      exceptions_ (0),
+      exceptions_count_ (0),
+      exception_ (0),
+      completed_ (false),
+      abandoned_ (false),
+      resume_ (0),
+      frame_ (0)
+  {
+  }
+
+  AMI_Awaitable_Reply_Base::~AMI_Awaitable_Reply_Base (void)
+  {
+    delete this->exception_;
+  }
+
+  void
+  AMI_Awaitable_Reply_Base::reply_stub (
+    TAO_InputCDR &cdr,
+    Messaging::ReplyHandler_ptr reply_handler,
+    CORBA::ULong reply_status)
+  {
+    AMI_Awaitable_Reply_Base * const reply =
+      dynamic_cast<AMI_Awaitable_Reply_Base *> (reply_handler);
+
+    if (reply == 0)
+      return;
+
+    void (*resume) (void *) = 0;
+    void *frame = 0;
+
+    {
+      ACE_GUARD (TAO_SYNCH_MUTEX, guard, reply->lock_);
+
+      // The arguments may be gone when nobody waits anymore.
+      if (reply->completed_ || reply->abandoned_)
+        return;
+
+      reply->complete (cdr, reply_status);
+      reply->completed_ = true;
+
+      resume = reply->resume_;
+      frame = reply->frame_;
+    }
+
+    // The coroutine may run on for long, and even await the next
+    // reply, so it is resumed without holding the lock.
+    if (resume != 0)
+      resume (frame);
+  }
+
+  void
+  AMI_Awaitable_Reply_Base::complete (TAO_InputCDR &cdr,
+                                      CORBA::ULong reply_status)
+  {
+    switch (reply_status)
+      {
+      case TAO_AMI_REPLY_OK:
+        for (CORBA::ULong i = 0; i != this->nargs_; ++i)
+          {
+            if (!this->args_[i]->demarshal (cdr))
+              {
+                ACE_NEW (this->exception_,
+                         CORBA::MARSHAL (TAO::VMCID, CORBA::COMPLETED_YES));
+                break;
+              }
+          }
+        break;
+      case TAO_AMI_REPLY_USER_EXCEPTION:
+      case TAO_AMI_REPLY_SYSTEM_EXCEPTION:
+        {
+          const ACE_Message_Block *mb = cdr.start ();
+
+          CORBA::OctetSeq marshaled_exception (
+            static_cast<CORBA::ULong> (mb->length ()),
+            static_cast<CORBA::ULong> (mb->length ()),
+            reinterpret_cast<CORBA::Octet *> (mb->rd_ptr ()),
+            0);
+
+          ::Messaging::ExceptionHolder *holder = 0;
+          ACE_NEW (holder,
+                   ::TAO::ExceptionHolder (
+                     reply_status == TAO_AMI_REPLY_SYSTEM_EXCEPTION,
+                     cdr.byte_order (),
+                     marshaled_exception,
+                     this->exceptions_,
+                     this->exceptions_count_,
+                     cdr.char_translator (),
+                     cdr.wchar_translator ()));
+
+          ::Messaging::ExceptionHolder_var holder_var = holder;
+
+          // Decode it now, while the translators are still around.
+          try
+            {
+              holder->raise_exception ();
+            }
+          catch (const ::CORBA::Exception &ex)
+            {
+              this->exception_ = ex._tao_duplicate ();
+            }
+        }
+        break;
+      default:
+        // The request is forwarded or failed, the reply dispatcher
+        // doesn't reissue it.
+        ACE_NEW (this->exception_,
+                 CORBA::TRANSIENT (TAO::VMCID, CORBA::COMPLETED_MAYBE));
+        break;
+      }
+  }
+
+  void
+  AMI_Awaitable_Reply_Base::exceptions (TAO::Exception_Data *data,
+                                        CORBA::ULong count)
+  {
+    this->exceptions_ = data;
+    this->exceptions_count_ = count;
+  }
+
+  void
+  AMI_Awaitable_Reply_Base::arguments (TAO::Argument * const *args,
+                                       CORBA::ULong nargs)
+  {
+    this->args_ = args;
+    this->nargs_ = nargs;
+  }
+
+  bool
+  AMI_Awaitable_Reply_Base::completed (void)
+  {
+    ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, guard, this->lock_, false);
+    return this->completed_;
+  }
+
+  bool
+  AMI_Awaitable_Reply_Base::suspend (void (*resume) (void *), void *frame)
+  {
+    ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, guard, this->lock_, false);
+
+    if (this->completed_)
+      return false;
+
+    this->resume_ = resume;
+    this->frame_ = frame;
+    return true;
+  }
+
+  void
+  AMI_Awaitable_Reply_Base::raise (void)
+  {
+    ACE_GUARD (TAO_SYNCH_MUTEX, guard, this->lock_);
+
+    if (this->exception_ != 0)
+      this->exception_->_raise ();
+  }
+
+  void
+  AMI_Awaitable_Reply_Base::abandon (void)
+  {
+    ACE_GUARD (TAO_SYNCH_MUTEX, guard, this->lock_);
+    this->abandoned_ = true;
+    this->resume_ = 0;
+  }
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* TAO_HAS_AMI_CALLBACK == 1 */
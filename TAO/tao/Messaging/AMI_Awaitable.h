@@ -0,0 +1,246 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    AMI_Awaitable.h
+ *
+ *  The replies the co_ stubs generated with tao_idl -GCo wait for,
+ *  and what a coroutine awaits to get them.
+ */
+//=============================================================================
+
+#ifndef TAO_AMI_AWAITABLE_H
+#define TAO_AMI_AWAITABLE_H
+#include /**/ "ace/pre.h"
+
+#include "tao/Messaging/messaging_export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "tao/Messaging/Messaging.h"
+
+#if (TAO_HAS_AMI_CALLBACK == 1)
+
+#include "tao/LocalObject.h"
+#include "tao/Arg_Traits_T.h"
+#include "tao/Basic_Arguments.h"
+#include "ace/Synch_Traits.h"
+#include "ace/Thread_Mutex.h"
+
+#if (TAO_HAS_AMI_COROUTINES == 1)
+# include <coroutine>
+# include <tuple>
+# include <type_traits>
+# include <utility>
+#endif /* TAO_HAS_AMI_COROUTINES == 1 */
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace TAO
+{
+  struct Exception_Data;
+
+  /**
+   * @class AMI_Awaitable_Reply_Base
+   *
+   * @brief Takes the reply to a co_ stub's request.
+   *
+   * It is the reply handler of the asynchronous invocation, but a
+   * local object rather than a servant, so nothing is activated in
+   * a POA for it.  The reply is demarshaled straight into the return
+   * value and the inout and out arguments, then whoever waits for it
+   * is resumed, in the thread that dispatched the reply.
+   */
+  class TAO_Messaging_Export AMI_Awaitable_Reply_Base
+    : public virtual Messaging::ReplyHandler,
+      public virtual ::CORBA::LocalObject
+  {
+  public:
+    /// The reply handler stub the co_ stubs invoke with.
+    static void reply_stub (TAO_InputCDR &cdr,
+                            Messaging::ReplyHandler_ptr reply_handler,
+                            CORBA::ULong reply_status);
+
+    /// Set the user exceptions the operation may raise.
+    void exceptions (TAO::Exception_Data *data, CORBA::ULong count);
+
+    /// True once the reply is in, or the request failed.
+    bool completed (void);
+
+    /**
+     * Have @a resume called with @a frame once the reply is in.
+     * Returns false, and doesn't, when it already is.
+     */
+    bool suspend (void (*resume) (void *), void *frame);
+
+    /// Throw the exception the reply brought, if any.
+    void raise (void);
+
+    /// Nobody waits for the reply anymore, drop it when it comes in.
+    void abandon (void);
+
+  protected:
+    AMI_Awaitable_Reply_Base (void);
+
+    virtual ~AMI_Awaitable_Reply_Base (void);
+
+    /// Set the return value, inout and out arguments, in that order,
+    /// which the reply is demarshaled into.
+    void arguments (TAO::Argument * const *args, CORBA::ULong nargs);
+
+  private:
+    /// Demarshal the reply, or what went wrong.
+    void complete (TAO_InputCDR &cdr, CORBA::ULong reply_status);
+
+    TAO_SYNCH_MUTEX lock_;
+
+    TAO::Argument * const *args_;
+    CORBA::ULong nargs_;
+
+    TAO::Exception_Data *exceptions_;
+    CORBA::ULong exceptions_count_;
+
+    /// The exception the reply brought.
+    CORBA::Exception *exception_;
+
+    bool completed_;
+    bool abandoned_;
+
+    /// Called with @c frame_ once the reply is in.
+    void (*resume_) (void *);
+    void *frame_;
+  };
+
+#if (TAO_HAS_AMI_COROUTINES == 1)
+
+  /// The reply to an operation whose stub returns @a RET.
+  template <typename RET>
+  class AMI_Awaitable_Reply : public AMI_Awaitable_Reply_Base
+  {
+  public:
+    /// Hand over the return value.
+    virtual RET retval (void) = 0;
+  };
+
+  /**
+   * @class AMI_Awaitable_Reply_T
+   *
+   * @brief The reply to an operation returning @a RET, with the inout
+   * and out argument helpers @a ARGS, made from the caller's arguments.
+   */
+  template <typename RET, typename... ARGS>
+  class AMI_Awaitable_Reply_T
+    : public AMI_Awaitable_Reply<typename Arg_Traits<RET>::ret_type>
+  {
+  public:
+    typedef typename Arg_Traits<RET>::ret_type ret_type;
+
+    template <typename... PARAMS>
+    explicit AMI_Awaitable_Reply_T (PARAMS &&... params)
+      : args_ (std::forward<PARAMS> (params)...)
+    {
+      this->signature_[0] = &this->retval_;
+      std::apply ([this] (ARGS &... args)
+                  {
+                    CORBA::ULong i = 0;
+                    ((this->signature_[++i] = &args), ...);
+                  },
+                  this->args_);
+      this->arguments (this->signature_, 1 + sizeof... (ARGS));
+    }
+
+    virtual ret_type retval (void)
+    {
+      if constexpr (!std::is_void_v<ret_type>)
+        return this->retval_.retn ();
+    }
+
+    /// The return value at 0, then the inout and out arguments.
+    TAO::Argument *arg (CORBA::ULong i)
+    {
+      return this->signature_[i];
+    }
+
+  private:
+    typename Arg_Traits<RET>::ret_val retval_;
+
+    std::tuple<ARGS...> args_;
+
+    TAO::Argument *signature_[1 + sizeof... (ARGS)];
+  };
+
+  /**
+   * @class AMI_Awaitable
+   *
+   * @brief What a co_ stub returns, for a coroutine to co_await.
+   *
+   * Awaiting it gives what the synchronous stub returns, and sets the
+   * inout and out arguments the co_ stub was called with, or throws
+   * what it would throw.  Those arguments must stay around until
+   * then; when the awaitable goes away unawaited the reply is dropped.
+   */
+  template <typename RET>
+  class AMI_Awaitable
+  {
+  public:
+    /// Takes over the reference to @a reply.
+    explicit AMI_Awaitable (AMI_Awaitable_Reply<RET> *reply)
+      : reply_ (reply)
+    {
+    }
+
+    AMI_Awaitable (AMI_Awaitable &&other)
+      : reply_ (other.reply_)
+    {
+      other.reply_ = 0;
+    }
+
+    ~AMI_Awaitable (void)
+    {
+      if (this->reply_ != 0)
+        {
+          this->reply_->abandon ();
+          this->reply_->_remove_ref ();
+        }
+    }
+
+    bool await_ready (void)
+    {
+      return this->reply_->completed ();
+    }
+
+    bool await_suspend (std::coroutine_handle<> handle)
+    {
+      return this->reply_->suspend (&AMI_Awaitable::resume,
+                                    handle.address ());
+    }
+
+    RET await_resume (void)
+    {
+      this->reply_->raise ();
+      return this->reply_->retval ();
+    }
+
+  private:
+    AMI_Awaitable (const AMI_Awaitable &) = delete;
+    AMI_Awaitable &operator= (const AMI_Awaitable &) = delete;
+
+    static void resume (void *frame)
+    {
+      std::coroutine_handle<>::from_address (frame).resume ();
+    }
+
+    AMI_Awaitable_Reply<RET> *reply_;
+  };
+
+#endif /* TAO_HAS_AMI_COROUTINES == 1 */
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* TAO_HAS_AMI_CALLBACK == 1 */
+
+#include /**/ "ace/post.h"
+#endif /* TAO_AMI_AWAITABLE_H */
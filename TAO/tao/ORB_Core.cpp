@@ -246,6 +246,7 @@ TAO_ORB_Core::TAO_ORB_Core (const char *orbid,
     flush_transport_queueing_strategy_ (0),
 #endif /* TAO_HAS_BUFFERING_CONSTRAINT_POLICY == 1 */
     refcount_ (1),
+    request_batches_ (0),
     policy_factory_registry_ (0),
     orbinitializer_registry_ (0),
 #if (TAO_HAS_INTERCEPTORS == 1)
@@ -734,6 +735,14 @@ TAO_ORB_Core::init (int &argc, char *argv[] )
         {
           cdr_tradeoff = ACE_OS::atoi (current_arg);
 
+          arg_shifter.consume_arg ();
+        }
+      else if (0 != (current_arg = arg_shifter.get_the_parameter
+                (ACE_TEXT("-ORBZeroCopyOctetSequences"))))
+        {
+          int const zero_copy = ACE_OS::atoi (current_arg);
+          this->orb_params ()->zero_copy_octet_sequences (zero_copy != 0);
+
           arg_shifter.consume_arg ();
         }
 
@@ -1203,6 +1212,31 @@ TAO_ORB_Core::init (int &argc, char *argv[] )
           this->orb_params_.allow_ziop_no_server_policies (!!ACE_OS::atoi (current_arg));
           arg_shifter.consume_arg ();
         }
+     else if (0 != (current_arg = arg_shifter.get_the_parameter
+                    (ACE_TEXT("-ORBZIOPAdaptive"))))
+        {
+          this->orb_params_.ziop_adaptive (!!ACE_OS::atoi (current_arg));
+          arg_shifter.consume_arg ();
+        }
+     else if (0 != (current_arg = arg_shifter.get_the_parameter
+                    (ACE_TEXT("-ORBZIOPLinkBandwidth"))))
+        {
+          int const bandwidth = ACE_OS::atoi (current_arg);
+          if (bandwidth <= 0)
+            {
+              TAOLIB_ERROR ((LM_ERROR,
+                          ACE_TEXT ("TAO (%P|%t) - ORB_Core::init, ")
+                          ACE_TEXT ("invalid ZIOP link bandwidth <%s>\n"),
+                          current_arg));
+              throw ::CORBA::BAD_PARAM (
+                CORBA::SystemException::_tao_minor_code (
+                  TAO_ORB_CORE_INIT_LOCATION_CODE,
+                  EINVAL),
+                CORBA::COMPLETED_NO);
+            }
+          this->orb_params_.ziop_link_bandwidth (bandwidth);
+          arg_shifter.consume_arg ();
+        }
      else if (0 != (current_arg = arg_shifter.get_the_parameter
                     (ACE_TEXT("-ORBDynamicThreadPoolName"))))
         {
@@ -1310,6 +1344,19 @@ TAO_ORB_Core::init (int &argc, char *argv[] )
 
   trf->use_local_memory_pool (this->use_local_memory_pool_);
 
+  // Split the ObjectKey table before any profile binds a key in it.
+  if (this->object_key_table_.open (trf->object_key_table_shards ()) == -1)
+    {
+      TAOLIB_ERROR ((LM_ERROR,
+                  ACE_TEXT ("TAO (%P|%t) - %p\n"),
+                  ACE_TEXT ("ORB Core unable to open the ObjectKey table")));
+      throw ::CORBA::NO_MEMORY (
+        CORBA::SystemException::_tao_minor_code (
+          TAO_ORB_CORE_INIT_LOCATION_CODE,
+          0),
+        CORBA::COMPLETED_NO);
+    }
+
   // @@ ????
   // Make sure the reactor is initialized...
   ACE_Reactor *reactor = this->reactor ();
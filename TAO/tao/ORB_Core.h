@@ -550,6 +550,14 @@ public:
   /// Obtain the TSS resource in the given slot.
   void* get_tss_resource (size_t slot_id);
 
+  /// Count the TAO::Request_Batch objects of this orb, so that the
+  /// stubs only look for the batch of their thread while one exists.
+  void request_batch_begin (void);
+  void request_batch_end (void);
+
+  /// True if a thread has a TAO::Request_Batch for this orb.
+  bool has_request_batches (void) const;
+
   /// Set the TSS resource at the given slot.
   /// Returns 0 on success, and -1 on failure.
   int set_tss_resource (size_t slot_id, void *);
@@ -1209,6 +1217,9 @@ protected:
   /// Number of outstanding references to this object.
   ACE_Atomic_Op<TAO_SYNCH_MUTEX, unsigned long> refcount_;
 
+  /// Number of TAO::Request_Batch objects alive for this orb.
+  ACE_Atomic_Op<TAO_SYNCH_MUTEX, unsigned long> request_batches_;
+
   /// Registry containing all registered policy factories.
   TAO::PolicyFactory_Registry_Adapter *policy_factory_registry_;
 
@@ -268,6 +268,24 @@ TAO_ORB_Core::get_tss_resources (void)
   return ACE_TSS_GET (&this->tss_resources_,TAO_ORB_Core_TSS_Resources);
 }
 
+ACE_INLINE void
+TAO_ORB_Core::request_batch_begin (void)
+{
+  ++this->request_batches_;
+}
+
+ACE_INLINE void
+TAO_ORB_Core::request_batch_end (void)
+{
+  --this->request_batches_;
+}
+
+ACE_INLINE bool
+TAO_ORB_Core::has_request_batches (void) const
+{
+  return this->request_batches_.value () != 0;
+}
+
 ACE_INLINE void *
 TAO_ORB_Core::get_tss_resource (size_t slot_id)
 {
@@ -9,6 +9,7 @@ TAO_ORB_Core_TSS_Resources::TAO_ORB_Core_TSS_Resources (void)
   , lane_ (0)
   , ts_objects_ ()
   , upcalls_temporarily_suspended_on_this_thread_ (false)
+  , request_batch_ (0)
   , orb_core_ (0)
 {
 }
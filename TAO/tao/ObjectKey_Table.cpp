@@ -32,35 +32,79 @@ TAO::Less_Than_ObjectKey::operator () (const TAO::ObjectKey &lhs,
 
 /********************************************************/
 TAO::ObjectKey_Table::ObjectKey_Table (void)
-  : table_ ()
+  : shards_ (0)
+  , shard_count_ (0)
 {
-
+  // Until open () is called the table has a single shard.
+  ACE_NEW (this->shards_, Shard[1]);
+  this->shard_count_ = 1;
 }
 
 TAO::ObjectKey_Table::~ObjectKey_Table (void)
 {
-  this->table_.close ();
+  for (size_t i = 0; i < this->shard_count_; ++i)
+    {
+      this->shards_[i].table_.close ();
+    }
+
+  delete [] this->shards_;
 }
 
 int
-TAO::ObjectKey_Table::destroy (void)
+TAO::ObjectKey_Table::open (size_t shards)
 {
-  if (this->table_.current_size ())
+  if (shards == 0)
     {
-      ACE_GUARD_RETURN (TAO_SYNCH_MUTEX,
-                        ace_mon,
-                        this->lock_,
-                        0);
+      shards = 1;
+    }
 
-      TABLE::ITERATOR end_iter = this->table_.end ();
-      TABLE::ITERATOR start;
+  if (shards == this->shard_count_)
+    {
+      return 0;
+    }
 
-      while ((start = this->table_.begin ()) != end_iter)
+  for (size_t i = 0; i < this->shard_count_; ++i)
+    {
+      if (this->shards_[i].table_.current_size ())
         {
-          TABLE::ENTRY &ent = (*start);
+          return -1;
+        }
+    }
+
+  Shard *tmp = 0;
+  ACE_NEW_RETURN (tmp, Shard[shards], -1);
+
+  delete [] this->shards_;
+  this->shards_ = tmp;
+  this->shard_count_ = shards;
+
+  return 0;
+}
 
-          ent.item ()->decr_refcount ();
-          this->table_.unbind (&ent);
+int
+TAO::ObjectKey_Table::destroy (void)
+{
+  for (size_t i = 0; i < this->shard_count_; ++i)
+    {
+      Shard &shard = this->shards_[i];
+
+      if (shard.table_.current_size ())
+        {
+          ACE_GUARD_RETURN (TAO_SYNCH_MUTEX,
+                            ace_mon,
+                            shard.lock_,
+                            0);
+
+          TABLE::ITERATOR end_iter = shard.table_.end ();
+          TABLE::ITERATOR start;
+
+          while ((start = shard.table_.begin ()) != end_iter)
+            {
+              TABLE::ENTRY &ent = (*start);
+
+              ent.item ()->decr_refcount ();
+              shard.table_.unbind (&ent);
+            }
         }
     }
 
@@ -68,14 +112,15 @@ TAO::ObjectKey_Table::destroy (void)
 }
 
 int
-TAO::ObjectKey_Table::bind_i (const TAO::ObjectKey &key,
+TAO::ObjectKey_Table::bind_i (Shard &shard,
+                              const TAO::ObjectKey &key,
                               TAO::Refcounted_ObjectKey *&key_new)
 {
   ACE_NEW_RETURN (key_new,
                   TAO::Refcounted_ObjectKey (key),
                   -1);
 
-  int const retval =  this->table_.bind (key, key_new);
+  int const retval =  shard.table_.bind (key, key_new);
 
   if (retval != -1)
     {
@@ -90,11 +135,12 @@ TAO::ObjectKey_Table::bind_i (const TAO::ObjectKey &key,
 }
 
 int
-TAO::ObjectKey_Table::unbind_i (TAO::Refcounted_ObjectKey *&key_new)
+TAO::ObjectKey_Table::unbind_i (Shard &shard,
+                                TAO::Refcounted_ObjectKey *&key_new)
 {
   TAO::Refcounted_ObjectKey *tmp = 0;
 
-  if (this->table_.unbind (key_new->object_key (), tmp) != -1)
+  if (shard.table_.unbind (key_new->object_key (), tmp) != -1)
     {
       // @@ Cant do much if the unbind fails.
       // Remove our refcount on the ObjectKey
@@ -104,4 +150,17 @@ TAO::ObjectKey_Table::unbind_i (TAO::Refcounted_ObjectKey *&key_new)
   return 0;
 }
 
+int
+TAO::ObjectKey_Table::bind_i (const TAO::ObjectKey &key,
+                              TAO::Refcounted_ObjectKey *&key_new)
+{
+  return this->bind_i (this->shard (key), key, key_new);
+}
+
+int
+TAO::ObjectKey_Table::unbind_i (TAO::Refcounted_ObjectKey *&key_new)
+{
+  return this->unbind_i (this->shard (key_new->object_key ()), key_new);
+}
+
 TAO_END_VERSIONED_NAMESPACE_DECL
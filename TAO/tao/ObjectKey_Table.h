@@ -66,6 +66,13 @@ namespace TAO
    * the reference counts on the object keys provided by the wrapper
    * class.
    *
+   * Every profile created or destroyed by the ORB goes through this
+   * table, so with a single lock the threads of a busy ORB serialize
+   * here.  The table can be split in a number of shards, each with its
+   * own lock and its own RB_Tree; an ObjectKey is always kept in the
+   * shard selected by the hash of its octets.  The number of shards is
+   * set by open(), see -ORBObjectKeyTableShards.
+   *
    * This class does not offer a find () call with a reason. The call
    * to bind () will return a pointer which is expected to be cached
    * by the client/caller and use the pointer in every invocation.
@@ -77,10 +84,8 @@ namespace TAO
    * table.
    *
    * @note The reasons to use RB_Tree are its good dynamic
-   * properties. We should try to strategize the class to use either a
-   * Hash_Map or a RB_Tree based on some runtime option. For that we
-   * need an adapter class in ACE, like an ACE_Lock_Adapter class. We
-   * will do that if our instrumentation shows the need for it.
+   * properties.  The ACE Hash_Map does not grow its bucket array, so
+   * the hash is only used to select the shard.
    *
    */
   class TAO_Export ObjectKey_Table
@@ -91,6 +96,12 @@ namespace TAO
 
     ~ObjectKey_Table (void);
 
+    /// Split the table in @a shards independently locked shards (one
+    /// by default).  Must be called before anything is bound in the
+    /// table; returns -1 otherwise, or if the shards cannot be
+    /// allocated.
+    int open (size_t shards);
+
     /// Iterates and unbinds the contents of the table.
     int destroy (void);
 
@@ -108,11 +119,16 @@ namespace TAO
     /// Unbind an ObjectKey from the table.
     int unbind (TAO::Refcounted_ObjectKey *&key);
 
+    /// Number of shards the table is split in.
+    size_t shards (void) const;
+
   protected:
-    /// Implementation for bind ().
+    /// Implementation for bind (), called with the lock of the shard
+    /// of @a key held.
     int bind_i (const ObjectKey &key, Refcounted_ObjectKey *&key_new);
 
-    /// Implementation for unbind ().
+    /// Implementation for unbind (), called with the lock of the shard
+    /// of @a key held.
     int unbind_i (Refcounted_ObjectKey *&key);
 
   private:
@@ -125,11 +141,34 @@ namespace TAO
                         TAO::Less_Than_ObjectKey,
                         ACE_Null_Mutex> TABLE;
 
-    /// Lock for the table.
-    TAO_SYNCH_MUTEX lock_;
+    /// One shard of the table.
+    struct Shard
+    {
+      /// Lock for the shard.
+      TAO_SYNCH_MUTEX lock_;
+
+      /// Table that contains the data of the shard.
+      TABLE table_;
+    };
+
+    /// Returns the shard that holds @a key.
+    Shard &shard (const ObjectKey &key) const;
+
+    /// Implementation for bind (), called with the lock of @a shard
+    /// held.
+    int bind_i (Shard &shard,
+                const ObjectKey &key,
+                Refcounted_ObjectKey *&key_new);
+
+    /// Implementation for unbind (), called with the lock of @a shard
+    /// held.
+    int unbind_i (Shard &shard, Refcounted_ObjectKey *&key);
+
+    /// The shards.
+    Shard *shards_;
 
-    /// Table that contains the data
-    TABLE table_;
+    /// Number of elements in shards_.
+    size_t shard_count_;
   };
 }
 
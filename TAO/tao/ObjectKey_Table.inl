@@ -1,7 +1,27 @@
 #include "tao/Refcounted_ObjectKey.h"
+#include "ace/ACE.h"
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
+ACE_INLINE size_t
+TAO::ObjectKey_Table::shards (void) const
+{
+  return this->shard_count_;
+}
+
+ACE_INLINE TAO::ObjectKey_Table::Shard &
+TAO::ObjectKey_Table::shard (const TAO::ObjectKey &key) const
+{
+  if (this->shard_count_ == 1)
+    {
+      return this->shards_[0];
+    }
+
+  return this->shards_[ACE::hash_pjw (
+                         reinterpret_cast<const char *> (key.get_buffer ()),
+                         key.length ()) % this->shard_count_];
+}
+
 ACE_INLINE
 int
 TAO::ObjectKey_Table::bind (const TAO::ObjectKey &key,
@@ -12,10 +32,12 @@ TAO::ObjectKey_Table::bind (const TAO::ObjectKey &key,
 
   int retval = 0;
 
+  Shard &shard = this->shard (key);
+
   {
     ACE_GUARD_RETURN (TAO_SYNCH_MUTEX,
                       ace_mon,
-                      this->lock_,
+                      shard.lock_,
                       0);
 
     // This is a tradeoff.. We could avoid this two stage process of
@@ -23,11 +45,11 @@ TAO::ObjectKey_Table::bind (const TAO::ObjectKey &key,
     // efficient. BUT we may have to do allocation upfront and delete if
     // bind () returns with an entry. We take one of the routes that
     // avoids allocation.
-    retval = this->table_.find (key, key_new);
+    retval = shard.table_.find (key, key_new);
 
     if (retval == -1)
       {
-        return this->bind_i (key, key_new);
+        return this->bind_i (shard, key, key_new);
       }
 
     (void) key_new->incr_refcount ();
@@ -41,16 +63,23 @@ int
 TAO::ObjectKey_Table::unbind (TAO::Refcounted_ObjectKey *&key_new)
 
 {
+  if (key_new == 0)
+    {
+      return 0;
+    }
+
+  Shard &shard = this->shard (key_new->object_key ());
+
   ACE_GUARD_RETURN (TAO_SYNCH_MUTEX,
                     ace_mon,
-                    this->lock_,
+                    shard.lock_,
                     0);
 
   // If the refcount has dropped to 1, just go ahead and unbind it
   // from the table.
-  if (key_new && key_new->decr_refcount () == 1)
+  if (key_new->decr_refcount () == 1)
     {
-      return this->unbind_i (key_new);
+      return this->unbind_i (shard, key_new);
     }
 
   return 0;
@@ -51,7 +51,8 @@ TAO_PortableServer_ORBInitializer::register_policy_factories (
 #endif /* TAO_HAS_MINIMUM_POA == 0 */
     PortableServer::LIFESPAN_POLICY_ID,
     PortableServer::ID_UNIQUENESS_POLICY_ID,
-    PortableServer::ID_ASSIGNMENT_POLICY_ID
+    PortableServer::ID_ASSIGNMENT_POLICY_ID,
+    ::TAO::ACTIVE_OBJECT_MAP_POLICY_TYPE
   };
 
   CORBA::PolicyType const * end =
@@ -7,6 +7,7 @@
 #include "tao/PortableServer/ImplicitActivationPolicy.h"
 #include "tao/PortableServer/RequestProcessingPolicy.h"
 #include "tao/PortableServer/ServantRetentionPolicy.h"
+#include "tao/PortableServer/ActiveObjectMapPolicy.h"
 #include "tao/PortableServer/PortableServer.h"
 #include "tao/PI_Server/Policy_Creator_T.h"
 
@@ -61,6 +62,16 @@ TAO_PortableServer_PolicyFactory::create_policy (
       return id_assignment_policy;
     }
 
+  if (type == ::TAO::ACTIVE_OBJECT_MAP_POLICY_TYPE)
+    {
+      TAO::Portable_Server::ActiveObjectMapPolicy *active_object_map_policy = 0;
+      ::TAO::ActiveObjectMapPolicyValue active_object_map_value;
+
+      TAO::Portable_Server::create_policy (active_object_map_policy, active_object_map_value, value);
+
+      return active_object_map_policy;
+    }
+
 #if (TAO_HAS_MINIMUM_POA == 0) && !defined (CORBA_E_COMPACT)
 
   if (type == PortableServer::IMPLICIT_ACTIVATION_POLICY_ID)
@@ -0,0 +1,65 @@
+// -*- C++ -*-
+#include "tao/PortableServer/ActiveObjectMapPolicy.h"
+#include "tao/PortableServer/PortableServer.h"
+
+#include "ace/CORBA_macros.h"
+
+#if !defined (CORBA_E_MICRO)
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace TAO
+{
+  namespace Portable_Server
+  {
+    ActiveObjectMapPolicy::ActiveObjectMapPolicy (
+      ::TAO::ActiveObjectMapPolicyValue value)
+      : value_ (value)
+    {
+    }
+
+    CORBA::Policy_ptr
+    ActiveObjectMapPolicy::copy (void)
+    {
+      ActiveObjectMapPolicy *copy = 0;
+      ACE_NEW_THROW_EX (copy,
+                        ActiveObjectMapPolicy (this->value_),
+                        CORBA::NO_MEMORY ());
+
+      return copy;
+    }
+
+    void
+    ActiveObjectMapPolicy::destroy (void)
+    {
+    }
+
+    ::TAO::ActiveObjectMapPolicyValue
+    ActiveObjectMapPolicy::value (void)
+    {
+      return value_;
+    }
+
+    CORBA::PolicyType
+    ActiveObjectMapPolicy::policy_type (void)
+    {
+      return ::TAO::ACTIVE_OBJECT_MAP_POLICY_TYPE;
+    }
+
+    TAO_Cached_Policy_Type
+    ActiveObjectMapPolicy::_tao_cached_type (void) const
+    {
+      return TAO_CACHED_POLICY_UNCACHED;
+    }
+
+    TAO_Policy_Scope
+    ActiveObjectMapPolicy::_tao_scope (void) const
+    {
+      return TAO_POLICY_POA_SCOPE;
+    }
+  }
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#endif
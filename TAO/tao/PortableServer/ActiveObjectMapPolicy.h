@@ -0,0 +1,83 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file ActiveObjectMapPolicy.h
+ *
+ *  The TAO specific policy that selects the Active Object Map of a POA.
+ */
+//=============================================================================
+
+#ifndef TAO_POA_ACTIVEOBJECTMAPPOLICY_H
+#define TAO_POA_ACTIVEOBJECTMAPPOLICY_H
+#include /**/ "ace/pre.h"
+
+#include "tao/PortableServer/portableserver_export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "tao/PortableServer/ActiveObjectMapPolicyC.h"
+#include "tao/LocalObject.h"
+
+// This is to remove "inherits via dominance" warnings from MSVC.
+// MSVC is being a little too paranoid.
+#if defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable:4250)
+#endif /* _MSC_VER */
+
+#if !defined (CORBA_E_MICRO)
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace TAO
+{
+  namespace Portable_Server
+  {
+    /**
+     * With the SHARDED_ACTIVE_OBJECT_MAP value, the active objects of
+     * the POA are kept in a TAO_Sharded_User_Id_Map.  A POA that also
+     * has the RETAIN and USE_ACTIVE_OBJECT_MAP_ONLY policies then finds
+     * the servant of a request without the lock of the object adapter,
+     * so that the threads that dispatch requests to different objects
+     * of the POA do not wait for each other.
+     */
+    class TAO_PortableServer_Export ActiveObjectMapPolicy
+      : public virtual ::TAO::ActiveObjectMapPolicy,
+        public virtual ::CORBA::LocalObject
+    {
+    public:
+      ActiveObjectMapPolicy (::TAO::ActiveObjectMapPolicyValue value);
+
+      CORBA::Policy_ptr copy (void);
+
+      void destroy (void);
+
+      ::TAO::ActiveObjectMapPolicyValue value (void);
+
+      CORBA::PolicyType policy_type (void);
+
+      /// Return the cached policy type for this policy.
+      virtual TAO_Cached_Policy_Type _tao_cached_type (void) const;
+
+      /// Returns the scope at which this policy can be applied. See orbconf.h.
+      virtual TAO_Policy_Scope _tao_scope (void) const;
+
+    private:
+      ::TAO::ActiveObjectMapPolicyValue value_;
+    };
+  }
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#endif
+
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif /* _MSC_VER */
+
+#include /**/ "ace/post.h"
+#endif /* TAO_POA_ACTIVEOBJECTMAPPOLICY_H */
@@ -1,5 +1,6 @@
 #include "tao/PortableServer/Active_Object_Map.h"
 #include "tao/PortableServer/Active_Object_Map_Entry.h"
+#include "tao/PortableServer/Sharded_User_Id_Map.h"
 
 #if !defined (__ACE_INLINE__)
 # include "tao/PortableServer/Active_Object_Map.inl"
@@ -89,9 +90,11 @@ TAO_Active_Object_Map::TAO_Active_Object_Map (
     int user_id_policy,
     int unique_id_policy,
     int persistent_id_policy,
+    int sharded_map_policy,
     const TAO_Server_Strategy_Factory::Active_Object_Map_Creation_Parameters &
       creation_parameters)
   : user_id_map_ (0)
+  , sharded_user_id_map_ (0)
   , servant_map_ (0)
   , id_uniqueness_strategy_ (0)
   , lifespan_strategy_ (0)
@@ -186,7 +189,8 @@ TAO_Active_Object_Map::TAO_Active_Object_Map (
     new_id_assignment_strategy (id_assignment_strategy);
 
   TAO_Id_Hint_Strategy *id_hint_strategy = 0;
-  if ((user_id_policy
+  if (!sharded_map_policy
+      && (user_id_policy
        || creation_parameters.allow_reactivation_of_system_ids_)
       && creation_parameters.use_active_hint_in_ids_)
     {
@@ -242,8 +246,20 @@ TAO_Active_Object_Map::TAO_Active_Object_Map (
   auto_ptr<servant_map> new_servant_map (sm);
 
   user_id_map *uim = 0;
-  if (user_id_policy
-      || creation_parameters.allow_reactivation_of_system_ids_)
+  if (sharded_map_policy)
+    {
+      // The ids are looked up without hints, so the system ids are
+      // the keys of the map.
+      ACE_NEW_THROW_EX (this->sharded_user_id_map_,
+                        TAO_Sharded_User_Id_Map (
+                          creation_parameters.active_object_map_shards_,
+                          creation_parameters.active_object_map_size_,
+                          TAO_Active_Object_Map::system_id_size ()),
+                        CORBA::NO_MEMORY ());
+      uim = this->sharded_user_id_map_;
+    }
+  else if (user_id_policy
+           || creation_parameters.allow_reactivation_of_system_ids_)
     {
       switch (creation_parameters.object_lookup_strategy_for_user_id_policy_)
         {
@@ -383,6 +399,95 @@ TAO_Active_Object_Map::is_user_id_in_map (
   return result;
 }
 
+int
+TAO_Active_Object_Map::find_servant_and_add_reference (
+  const PortableServer::ObjectId &system_id,
+  const PortableServer::ObjectId &user_id,
+  PortableServer::Servant &servant,
+  TAO_Active_Object_Map_Entry *&entry)
+{
+  if (this->sharded_user_id_map_ != 0)
+    {
+      // Without hints the user id is the key of the entry.
+      return
+        this->sharded_user_id_map_->find_servant_and_add_reference (user_id,
+                                                                    servant,
+                                                                    entry);
+    }
+
+  int const result =
+    this->lifespan_strategy_->find_servant_using_system_id_and_user_id (
+      system_id,
+      user_id,
+      servant,
+      entry);
+
+  if (result == 0)
+    {
+      ++entry->reference_count_;
+    }
+
+  return result;
+}
+
+/* static */
+void
+TAO_Active_Object_Map::add_reference (TAO_Active_Object_Map_Entry *entry)
+{
+  if (entry->lock_ != 0)
+    {
+      ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, *entry->lock_);
+      ++entry->reference_count_;
+    }
+  else
+    {
+      ++entry->reference_count_;
+    }
+}
+
+/* static */
+CORBA::UShort
+TAO_Active_Object_Map::remove_reference (TAO_Active_Object_Map_Entry *entry,
+                                         bool deactivate)
+{
+  if (entry->lock_ != 0)
+    {
+      ACE_Guard<TAO_SYNCH_MUTEX> ace_mon (*entry->lock_);
+      return TAO_Active_Object_Map::remove_reference_i (entry, deactivate);
+    }
+
+  return TAO_Active_Object_Map::remove_reference_i (entry, deactivate);
+}
+
+/* static */
+CORBA::UShort
+TAO_Active_Object_Map::remove_reference_i (TAO_Active_Object_Map_Entry *entry,
+                                           bool deactivate)
+{
+  if (deactivate)
+    {
+      entry->deactivated_ = 1;
+    }
+
+  return --entry->reference_count_;
+}
+
+/* static */
+void
+TAO_Active_Object_Map::set_servant (TAO_Active_Object_Map_Entry *entry,
+                                    PortableServer::Servant servant)
+{
+  if (entry->lock_ != 0)
+    {
+      ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, *entry->lock_);
+      entry->servant_ = servant;
+    }
+  else
+    {
+      entry->servant_ = servant;
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 TAO_Id_Uniqueness_Strategy::~TAO_Id_Uniqueness_Strategy (void)
@@ -434,7 +539,7 @@ TAO_Unique_Id_Strategy::bind_using_user_id (
     {
       if (servant != 0)
         {
-          entry->servant_ = servant;
+          TAO_Active_Object_Map::set_servant (entry, servant);
 
           result =
             this->active_object_map_->servant_map_->bind (entry->servant_,
@@ -462,23 +567,29 @@ TAO_Unique_Id_Strategy::bind_using_user_id (
 
       if (result == 0)
         {
-          result =
-            this->active_object_map_->user_id_map_->bind (entry->user_id_,
-                                                          entry);
-          if (result == 0)
+          // The entry is complete before it is bound in the id map,
+          // where a sharded map lets the upcalls find it without the
+          // lock of the object adapter.
+          if (servant != 0)
             {
-              if (servant != 0)
-                {
-                  result =
-                    this->active_object_map_->servant_map_->bind (
-                      entry->servant_,
-                      entry);
-                }
+              result =
+                this->active_object_map_->servant_map_->bind (
+                  entry->servant_,
+                  entry);
+            }
 
+          if (result == 0)
+            {
+              result =
+                this->active_object_map_->user_id_map_->bind (entry->user_id_,
+                                                              entry);
               if (result != 0)
                 {
-                  this->active_object_map_->user_id_map_->unbind (
-                    entry->user_id_);
+                  if (servant != 0)
+                    {
+                      this->active_object_map_->servant_map_->unbind (
+                        entry->servant_);
+                    }
                   this->active_object_map_->id_hint_strategy_->unbind (
                     *entry);
                   delete entry;
@@ -661,7 +772,7 @@ TAO_Multiple_Id_Strategy::bind_using_user_id (
     {
       if (servant != 0)
         {
-          entry->servant_ = servant;
+          TAO_Active_Object_Map::set_servant (entry, servant);
         }
     }
   else
@@ -955,14 +1066,15 @@ TAO_System_Id_With_Unique_Id_Strategy::bind_using_system_id (
                   TAO_Active_Object_Map_Entry,
                   -1);
 
+  // The entry is complete before it is bound in the id map.
+  entry->servant_ = servant;
+  entry->priority_ = priority;
+
   int result =
     this->active_object_map_->user_id_map_->bind_create_key (entry,
                                                              entry->user_id_);
   if (result == 0)
     {
-      entry->servant_ = servant;
-      entry->priority_ = priority;
-
       result = this->active_object_map_->id_hint_strategy_->bind (*entry);
 
       if (result == 0)
@@ -1031,14 +1143,16 @@ TAO_System_Id_With_Multiple_Id_Strategy::bind_using_system_id (
   ACE_NEW_RETURN (entry,
                   TAO_Active_Object_Map_Entry,
                   -1);
+
+  // The entry is complete before it is bound in the id map.
+  entry->servant_ = servant;
+  entry->priority_ = priority;
+
   int result =
     this->active_object_map_->user_id_map_->bind_create_key (entry,
                                                              entry->user_id_);
   if (result == 0)
     {
-      entry->servant_ = servant;
-      entry->priority_ = priority;
-
       result = this->active_object_map_->id_hint_strategy_->bind (*entry);
 
       if (result != 0)
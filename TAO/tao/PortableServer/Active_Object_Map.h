@@ -36,6 +36,7 @@ class TAO_Id_Uniqueness_Strategy;
 class TAO_Lifespan_Strategy;
 class TAO_Id_Assignment_Strategy;
 class TAO_Id_Hint_Strategy;
+class TAO_Sharded_User_Id_Map;
 struct TAO_Active_Object_Map_Entry;
 
 /**
@@ -49,11 +50,14 @@ class TAO_Active_Object_Map
 {
 public:
 
-  /// Constructor.
+  /// Constructor.  With @a sharded_map_policy, the ids are kept in a
+  /// TAO_Sharded_User_Id_Map, whatever the demultiplexing strategies
+  /// of the @a creation_parameters.
   TAO_Active_Object_Map (
     int user_id_policy,
     int unique_id_policy,
     int persistent_id_policy,
+    int sharded_map_policy,
     const TAO_Server_Strategy_Factory::Active_Object_Map_Creation_Parameters &creation_parameters);
 
   /// Destructor.
@@ -141,6 +145,35 @@ public:
     PortableServer::Servant &servant,
     TAO_Active_Object_Map_Entry *&entry);
 
+  /// Same as find_servant_using_system_id_and_user_id (), and adds a
+  /// reference to the entry found for the upcall that uses its
+  /// servant.  With a sharded map, the entry is found and the reference
+  /// added with the lock of its shard held, so that the object adapter
+  /// lock does not need to be held.
+  int
+  find_servant_and_add_reference (
+    const PortableServer::ObjectId &system_id,
+    const PortableServer::ObjectId &user_id,
+    PortableServer::Servant &servant,
+    TAO_Active_Object_Map_Entry *&entry);
+
+  /// Add a reference to @a entry.
+  static void
+  add_reference (TAO_Active_Object_Map_Entry *entry);
+
+  /// Remove a reference from @a entry and return the references left.
+  /// With @a deactivate, the entry is also marked as deactivated, so
+  /// that no upcall finds it again.
+  static CORBA::UShort
+  remove_reference (TAO_Active_Object_Map_Entry *entry,
+                    bool deactivate = false);
+
+  /// Set the servant of @a entry, with the lock of its shard held if
+  /// the map is sharded.
+  static void
+  set_servant (TAO_Active_Object_Map_Entry *entry,
+               PortableServer::Servant servant);
+
   /// Can be used with any policy.  With the SYSTEM_ID policy,
   /// @a user_id is identical to @a system_id.
   int
@@ -236,9 +269,17 @@ public:
     ACE_Noop_Key_Generator<PortableServer::Servant> > servant_linear_map;
 #endif /* TAO_HAS_MINIMUM_POA_MAPS == 0 */
 
+  /// Remove a reference from @a entry, with the lock of its shard held.
+  static CORBA::UShort
+  remove_reference_i (TAO_Active_Object_Map_Entry *entry,
+                      bool deactivate);
+
   /// Id map.
   auto_ptr<user_id_map> user_id_map_;
 
+  /// The id map when it is sharded, or 0.  Owned by user_id_map_.
+  TAO_Sharded_User_Id_Map *sharded_user_id_map_;
+
   /// Servant map.
   auto_ptr<servant_map> servant_map_;
 
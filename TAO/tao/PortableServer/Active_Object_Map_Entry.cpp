@@ -8,7 +8,8 @@ TAO_Active_Object_Map_Entry::TAO_Active_Object_Map_Entry (void)
     servant_ (0),
     reference_count_ (1),
     deactivated_ (false),
-    priority_ (-1)
+    priority_ (-1),
+    lock_ (0)
 {
 }
 
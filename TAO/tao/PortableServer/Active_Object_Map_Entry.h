@@ -15,6 +15,7 @@
 #include /**/ "ace/pre.h"
 
 #include "tao/PortableServer/PS_ForwardC.h"
+#include "tao/orbconf.h"
 
 #if !defined (ACE_LACKS_PRAGMA_ONCE)
 # pragma once
@@ -54,6 +55,11 @@ struct TAO_Active_Object_Map_Entry
 
   /// Priority of this servant.
   CORBA::Short priority_;
+
+  /// Lock of the shard of a TAO_Sharded_User_Id_Map that holds the
+  /// entry, or 0.  When set, the reference count and the deactivated
+  /// flag are only changed with the lock held.
+  TAO_SYNCH_MUTEX *lock_;
 };
 
 TAO_END_VERSIONED_NAMESPACE_DECL
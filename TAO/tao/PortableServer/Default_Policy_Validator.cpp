@@ -99,6 +99,7 @@ TAO_POA_Default_Policy_Validator::legal_policy_impl (CORBA::PolicyType type)
       type == PortableServer::LIFESPAN_POLICY_ID ||
       type == PortableServer::ID_UNIQUENESS_POLICY_ID ||
       type == PortableServer::ID_ASSIGNMENT_POLICY_ID ||
+      type == ::TAO::ACTIVE_OBJECT_MAP_POLICY_TYPE ||
 #   endif
 #   if ! defined (CORBA_E_COMPACT) && ! defined (CORBA_E_MICRO)
       type == PortableServer::IMPLICIT_ACTIVATION_POLICY_ID ||
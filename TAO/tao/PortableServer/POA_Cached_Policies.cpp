@@ -7,6 +7,7 @@
 #include "tao/PortableServer/RequestProcessingPolicyC.h"
 #include "tao/PortableServer/ServantRetentionPolicyC.h"
 #include "tao/PortableServer/ThreadPolicyC.h"
+#include "tao/PortableServer/ActiveObjectMapPolicyC.h"
 
 #if !defined (__ACE_INLINE__)
 # include "tao/PortableServer/POA_Cached_Policies.inl"
@@ -26,6 +27,7 @@ namespace TAO
         implicit_activation_ (::PortableServer::NO_IMPLICIT_ACTIVATION),
         servant_retention_ (::PortableServer::RETAIN),
         request_processing_ (::PortableServer::USE_ACTIVE_OBJECT_MAP_ONLY),
+        active_object_map_ (::TAO::DEFAULT_ACTIVE_OBJECT_MAP),
         priority_model_ (Cached_Policies::NOT_SPECIFIED),
         server_priority_ (TAO_INVALID_PRIORITY),
         network_priority_model_ (Cached_Policies::NO_NETWORK_PRIORITY),
@@ -146,6 +148,18 @@ namespace TAO
 
     #endif /* TAO_HAS_MINIMUM_POA == 0 */
 
+    #if !defined (CORBA_E_MICRO)
+      ::TAO::ActiveObjectMapPolicy_var active_object_map
+        = ::TAO::ActiveObjectMapPolicy::_narrow (policy);
+
+      if (!CORBA::is_nil (active_object_map.in ()))
+        {
+          this->active_object_map_ = active_object_map->value ();
+
+          return;
+        }
+    #endif
+
     #if defined (CORBA_E_MICRO)
       ACE_UNUSED_ARG (policy);
     #endif
@@ -27,6 +27,7 @@
 #include "tao/PortableServer/ImplicitActivationPolicyC.h"
 #include "tao/PortableServer/ServantRetentionPolicyC.h"
 #include "tao/PortableServer/RequestProcessingPolicyC.h"
+#include "tao/PortableServer/ActiveObjectMapPolicyC.h"
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -74,6 +75,7 @@ namespace TAO
       ::PortableServer::ImplicitActivationPolicyValue implicit_activation (void) const;
       ::PortableServer::ServantRetentionPolicyValue servant_retention (void) const;
       ::PortableServer::RequestProcessingPolicyValue request_processing (void) const;
+      ::TAO::ActiveObjectMapPolicyValue active_object_map (void) const;
       PriorityModel priority_model (void) const;
       CORBA::Short server_priority (void) const;
 
@@ -133,6 +135,8 @@ namespace TAO
 
       ::PortableServer::RequestProcessingPolicyValue request_processing_;
 
+      ::TAO::ActiveObjectMapPolicyValue active_object_map_;
+
       PriorityModel priority_model_;
 
       CORBA::Short server_priority_;
@@ -47,6 +47,12 @@ namespace TAO
       return this->request_processing_;
     }
 
+    ACE_INLINE ::TAO::ActiveObjectMapPolicyValue
+    Cached_Policies::active_object_map (void) const
+    {
+      return this->active_object_map_;
+    }
+
     ACE_INLINE Cached_Policies::PriorityModel
     Cached_Policies::priority_model (void) const
     {
@@ -348,6 +348,12 @@ public:
 
   CORBA::Boolean system_id (void);
 
+  /// Can the servants of the requests be found without the lock of
+  /// the object adapter?  Only for a POA with the RETAIN and
+  /// USE_ACTIVE_OBJECT_MAP_ONLY policies and a sharded active object
+  /// map.
+  bool unlocked_servant_lookup (void) const;
+
   CORBA::ULong waiting_servant_deactivation (void) const;
 
   /// Return the POA Manager related to this POA
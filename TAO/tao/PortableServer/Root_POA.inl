@@ -74,6 +74,15 @@ TAO_Root_POA::system_id (void)
   return (this->cached_policies_.id_assignment () == PortableServer::SYSTEM_ID);
 }
 
+ACE_INLINE bool
+TAO_Root_POA::unlocked_servant_lookup (void) const
+{
+  return
+    this->cached_policies_.active_object_map () == ::TAO::SHARDED_ACTIVE_OBJECT_MAP
+    && this->cached_policies_.servant_retention () == PortableServer::RETAIN
+    && this->cached_policies_.request_processing () == PortableServer::USE_ACTIVE_OBJECT_MAP_ONLY;
+}
+
 ACE_INLINE CORBA::Boolean
 TAO_Root_POA::persistent (void)
 {
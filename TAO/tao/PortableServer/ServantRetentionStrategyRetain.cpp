@@ -44,6 +44,7 @@ namespace TAO
                         TAO_Active_Object_Map (!poa->system_id (),
                                                !poa->allow_multiple_activations (),
                                                poa->is_persistent (),
+                                               poa->cached_policies ().active_object_map () == ::TAO::SHARDED_ACTIVE_OBJECT_MAP,
                                                poa->orb_core().server_factory ()->active_object_map_creation_parameters ()
                                               ), CORBA::NO_MEMORY ());
 
@@ -87,39 +88,38 @@ namespace TAO
     ServantRetentionStrategyRetain::deactivate_map_entry (
       TAO_Active_Object_Map_Entry *active_object_map_entry)
     {
-      // Decrement the reference count.
-      CORBA::UShort const new_count = --active_object_map_entry->reference_count_;
+      bool const deactivated = active_object_map_entry->deactivated_;
+
+      // Decrement the reference count, and mark the entry as closed so
+      // that no new request finds it.
+      CORBA::UShort const new_count =
+        TAO_Active_Object_Map::remove_reference (active_object_map_entry,
+                                                 true);
 
       // Inform the custom servant dispatching (CSD) strategy that the
       // servant is deactivated. This would be called just once when the
       // servant is deactivated the first time.
-      if (active_object_map_entry->deactivated_ == 0)
+      if (!deactivated)
         {
           this->poa_->servant_deactivated_hook (
             active_object_map_entry->servant_,
             active_object_map_entry->user_id_);
         }
 
+      // It should be noted that there may be a period of time between
+      // an object's deactivation and the etherealization (during
+      // which outstanding requests are being processed) in which
+      // arriving requests on that object should not be passed to its
+      // servant. During this period, requests targeted for such an
+      // object act as if the POA were in holding state until
+      // etherealize completes. If etherealize is called as a
+      // consequence of a deactivate call with a etherealize_objects
+      // parameter of TRUE, incoming requests are rejected.
       if (new_count == 0)
         {
           this->poa_->cleanup_servant (active_object_map_entry->servant_,
                                        active_object_map_entry->user_id_);
         }
-      else
-        {
-          // It should be noted that there may be a period of time between
-          // an object's deactivation and the etherealization (during
-          // which outstanding requests are being processed) in which
-          // arriving requests on that object should not be passed to its
-          // servant. During this period, requests targeted for such an
-          // object act as if the POA were in holding state until
-          // etherealize completes. If etherealize is called as a
-          // consequence of a deactivate call with a etherealize_objects
-          // parameter of TRUE, incoming requests are rejected.
-
-          // Else mark entry as closed...
-          active_object_map_entry->deactivated_ = 1;
-        }
     }
 
     int
@@ -290,18 +290,15 @@ namespace TAO
       PortableServer::Servant servant = 0;
       TAO_Active_Object_Map_Entry *active_object_map_entry = 0;
       int const result = this->active_object_map_->
-        find_servant_using_system_id_and_user_id (system_id,
-                                                  user_id,
-                                                  servant,
-                                                  active_object_map_entry);
-
+        find_servant_and_add_reference (system_id,
+                                        user_id,
+                                        servant,
+                                        active_object_map_entry);
 
       if (result == 0)
         {
+          // The reference count of the entry is already incremented.
           servant_upcall.active_object_map_entry (active_object_map_entry);
-
-          // Increment the reference count.
-          servant_upcall.increment_servant_refcount ();
         }
 
       return servant;
@@ -3,6 +3,7 @@
 #include "tao/PortableServer/Root_POA.h"
 #include "tao/PortableServer/Default_Servant_Dispatcher.h"
 #include "tao/PortableServer/Collocated_Object_Proxy_Broker.h"
+#include "tao/PortableServer/Active_Object_Map.h"
 #include "tao/PortableServer/Active_Object_Map_Entry.h"
 #include "tao/PortableServer/ForwardRequestC.h"
 
@@ -114,6 +115,14 @@ namespace TAO
       // We have setup the POA Current.  Record this for later use.
       this->state_ = POA_CURRENT_SETUP;
 
+      // A sharded active object map is searched with the locks of its
+      // shards, so the object adapter lock can be released already.
+      if (this->poa_->unlocked_servant_lookup ())
+        {
+          this->object_adapter_->lock ().release ();
+          this->state_ = OBJECT_ADAPTER_LOCK_RELEASED;
+        }
+
 #if (TAO_HAS_MINIMUM_CORBA == 0) && !defined (CORBA_E_COMPACT) && !defined (CORBA_E_MICRO)
       try
         {
@@ -332,7 +341,7 @@ namespace TAO
     {
       // Cleanup servant related stuff.
       if (this->active_object_map_entry_ != 0)
-        ++this->active_object_map_entry_->reference_count_;
+        TAO_Active_Object_Map::add_reference (this->active_object_map_entry_);
     }
 
     void
@@ -343,7 +352,8 @@ namespace TAO
         {
           // Decrement the reference count.
           CORBA::UShort const new_count =
-            --this->active_object_map_entry_->reference_count_;
+            TAO_Active_Object_Map::remove_reference (
+              this->active_object_map_entry_);
 
           if (new_count == 0)
             {
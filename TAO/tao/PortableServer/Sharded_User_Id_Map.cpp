@@ -0,0 +1,571 @@
+#include "tao/PortableServer/Sharded_User_Id_Map.h"
+#include "tao/PortableServer/Active_Object_Map_Entry.h"
+#include "tao/SystemException.h"
+
+#include "ace/CORBA_macros.h"
+#include "ace/Guard_T.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+TAO_Sharded_User_Id_Map::TAO_Sharded_User_Id_Map (size_t shards,
+                                                  size_t size,
+                                                  size_t key_size)
+  : shards_ (0)
+  , shard_count_ (shards == 0 ? 1 : shards)
+  , key_size_ (key_size)
+  , next_key_ (0)
+{
+  ACE_NEW_THROW_EX (this->shards_,
+                    Shard[this->shard_count_],
+                    CORBA::NO_MEMORY ());
+
+  // The hash maps do not grow: give each shard the buckets a single
+  // map would have had.
+  if (this->open (size) != 0)
+    {
+      delete [] this->shards_;
+      throw ::CORBA::NO_MEMORY ();
+    }
+}
+
+TAO_Sharded_User_Id_Map::~TAO_Sharded_User_Id_Map (void)
+{
+  delete [] this->shards_;
+}
+
+TAO_Sharded_User_Id_Map::Shard &
+TAO_Sharded_User_Id_Map::shard_of (const PortableServer::ObjectId &key)
+{
+  // The hash map of the shard uses the low bits of the same hash, so
+  // the shard is chosen with the high bits of the mixed hash.
+  ACE_UINT32 const hash =
+    static_cast<ACE_UINT32> (TAO_ObjectId_Hash () (key)) * 2654435761U;
+
+  return this->shards_[(hash >> 16) % this->shard_count_];
+}
+
+int
+TAO_Sharded_User_Id_Map::find_servant_and_add_reference (
+  const PortableServer::ObjectId &key,
+  PortableServer::Servant &servant,
+  TAO_Active_Object_Map_Entry *&entry)
+{
+  Shard &shard = this->shard_of (key);
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, shard.lock_, -1);
+
+  if (shard.map_.find (key, entry) != 0)
+    {
+      entry = 0;
+      return -1;
+    }
+
+  // An entry whose count dropped to 0 is being cleaned up, with the
+  // lock of the object adapter released for the etherealization.
+  if (entry->deactivated_
+      || entry->servant_ == 0
+      || entry->reference_count_ == 0)
+    {
+      entry = 0;
+      return -1;
+    }
+
+  ++entry->reference_count_;
+  servant = entry->servant_;
+
+  return 0;
+}
+
+size_t
+TAO_Sharded_User_Id_Map::shard_count (void) const
+{
+  return this->shard_count_;
+}
+
+TAO_Sharded_User_Id_Map::Shard &
+TAO_Sharded_User_Id_Map::shard (size_t index)
+{
+  return this->shards_[index];
+}
+
+int
+TAO_Sharded_User_Id_Map::open (size_t length, ACE_Allocator *alloc)
+{
+  for (size_t i = 0; i < this->shard_count_; ++i)
+    {
+      if (this->shards_[i].map_.open (length, alloc) != 0)
+        return -1;
+    }
+
+  return 0;
+}
+
+int
+TAO_Sharded_User_Id_Map::close (void)
+{
+  int result = 0;
+
+  for (size_t i = 0; i < this->shard_count_; ++i)
+    {
+      if (this->shards_[i].map_.close () != 0)
+        result = -1;
+    }
+
+  return result;
+}
+
+int
+TAO_Sharded_User_Id_Map::bind_i (const PortableServer::ObjectId &key,
+                                 TAO_Active_Object_Map_Entry *value)
+{
+  Shard &shard = this->shard_of (key);
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, shard.lock_, -1);
+
+  int const result = shard.map_.bind (key, value);
+
+  if (result == 0)
+    value->lock_ = &shard.lock_;
+
+  return result;
+}
+
+int
+TAO_Sharded_User_Id_Map::bind (const PortableServer::ObjectId &key,
+                               TAO_Active_Object_Map_Entry * const &value)
+{
+  return this->bind_i (key, value);
+}
+
+int
+TAO_Sharded_User_Id_Map::bind_modify_key (
+  TAO_Active_Object_Map_Entry * const &value,
+  PortableServer::ObjectId &key)
+{
+  return this->bind_i (key, value);
+}
+
+int
+TAO_Sharded_User_Id_Map::create_key (PortableServer::ObjectId &key)
+{
+  ACE_UINT64 counter = 0;
+  {
+    ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, this->key_lock_, -1);
+    counter = this->next_key_++;
+  }
+
+  // The ids have the size the POA expects in the object keys of the
+  // SYSTEM_ID POAs; the bytes of the counter that do not fit wrap.
+  key.length (static_cast<CORBA::ULong> (this->key_size_));
+  CORBA::Octet *buffer = key.get_buffer ();
+
+  for (size_t i = 0; i < this->key_size_; ++i)
+    {
+      buffer[i] = static_cast<CORBA::Octet> (counter & 0xff);
+      counter >>= 8;
+    }
+
+  return 0;
+}
+
+int
+TAO_Sharded_User_Id_Map::bind_create_key (
+  TAO_Active_Object_Map_Entry * const &value,
+  PortableServer::ObjectId &key)
+{
+  if (this->create_key (key) != 0)
+    return -1;
+
+  return this->bind_i (key, value);
+}
+
+int
+TAO_Sharded_User_Id_Map::bind_create_key (
+  TAO_Active_Object_Map_Entry * const &value)
+{
+  PortableServer::ObjectId key;
+  return this->bind_create_key (value, key);
+}
+
+int
+TAO_Sharded_User_Id_Map::recover_key (
+  const PortableServer::ObjectId &modified_key,
+  PortableServer::ObjectId &original_key)
+{
+  original_key = modified_key;
+  return 0;
+}
+
+int
+TAO_Sharded_User_Id_Map::rebind (const PortableServer::ObjectId &key,
+                                 TAO_Active_Object_Map_Entry * const &value)
+{
+  Shard &shard = this->shard_of (key);
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, shard.lock_, -1);
+
+  int const result = shard.map_.rebind (key, value);
+
+  if (result != -1)
+    value->lock_ = &shard.lock_;
+
+  return result;
+}
+
+int
+TAO_Sharded_User_Id_Map::rebind (const PortableServer::ObjectId &key,
+                                 TAO_Active_Object_Map_Entry * const &value,
+                                 TAO_Active_Object_Map_Entry *&old_value)
+{
+  Shard &shard = this->shard_of (key);
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, shard.lock_, -1);
+
+  int const result = shard.map_.rebind (key, value, old_value);
+
+  if (result != -1)
+    value->lock_ = &shard.lock_;
+
+  return result;
+}
+
+int
+TAO_Sharded_User_Id_Map::rebind (const PortableServer::ObjectId &key,
+                                 TAO_Active_Object_Map_Entry * const &value,
+                                 PortableServer::ObjectId &old_key,
+                                 TAO_Active_Object_Map_Entry *&old_value)
+{
+  Shard &shard = this->shard_of (key);
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, shard.lock_, -1);
+
+  int const result = shard.map_.rebind (key, value, old_key, old_value);
+
+  if (result != -1)
+    value->lock_ = &shard.lock_;
+
+  return result;
+}
+
+int
+TAO_Sharded_User_Id_Map::trybind (const PortableServer::ObjectId &key,
+                                  TAO_Active_Object_Map_Entry *&value)
+{
+  Shard &shard = this->shard_of (key);
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, shard.lock_, -1);
+
+  int const result = shard.map_.trybind (key, value);
+
+  if (result == 0)
+    value->lock_ = &shard.lock_;
+
+  return result;
+}
+
+int
+TAO_Sharded_User_Id_Map::find (const PortableServer::ObjectId &key,
+                               TAO_Active_Object_Map_Entry *&value)
+{
+  Shard &shard = this->shard_of (key);
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, shard.lock_, -1);
+
+  return shard.map_.find (key, value);
+}
+
+int
+TAO_Sharded_User_Id_Map::find (const PortableServer::ObjectId &key)
+{
+  Shard &shard = this->shard_of (key);
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, shard.lock_, -1);
+
+  return shard.map_.find (key);
+}
+
+int
+TAO_Sharded_User_Id_Map::unbind (const PortableServer::ObjectId &key)
+{
+  TAO_Active_Object_Map_Entry *value = 0;
+  return this->unbind (key, value);
+}
+
+int
+TAO_Sharded_User_Id_Map::unbind (const PortableServer::ObjectId &key,
+                                 TAO_Active_Object_Map_Entry *&value)
+{
+  Shard &shard = this->shard_of (key);
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, shard.lock_, -1);
+
+  int const result = shard.map_.unbind (key, value);
+
+  if (result == 0)
+    value->lock_ = 0;
+
+  return result;
+}
+
+size_t
+TAO_Sharded_User_Id_Map::current_size (void) const
+{
+  size_t size = 0;
+
+  for (size_t i = 0; i < this->shard_count_; ++i)
+    {
+      ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, this->shards_[i].lock_, 0);
+      size += this->shards_[i].map_.current_size ();
+    }
+
+  return size;
+}
+
+size_t
+TAO_Sharded_User_Id_Map::total_size (void) const
+{
+  size_t size = 0;
+
+  for (size_t i = 0; i < this->shard_count_; ++i)
+    {
+      ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, this->shards_[i].lock_, 0);
+      size += this->shards_[i].map_.total_size ();
+    }
+
+  return size;
+}
+
+void
+TAO_Sharded_User_Id_Map::dump (void) const
+{
+#if defined (ACE_HAS_DUMP)
+  for (size_t i = 0; i < this->shard_count_; ++i)
+    this->shards_[i].map_.dump ();
+#endif /* ACE_HAS_DUMP */
+}
+
+ACE_Iterator_Impl<TAO_Sharded_User_Id_Map::value_type> *
+TAO_Sharded_User_Id_Map::begin_impl (void)
+{
+  ACE_Iterator_Impl<value_type> *temp = 0;
+  ACE_NEW_RETURN (temp,
+                  TAO_Sharded_User_Id_Map_Iterator (*this, 0),
+                  0);
+  return temp;
+}
+
+ACE_Iterator_Impl<TAO_Sharded_User_Id_Map::value_type> *
+TAO_Sharded_User_Id_Map::end_impl (void)
+{
+  ACE_Iterator_Impl<value_type> *temp = 0;
+  ACE_NEW_RETURN (temp,
+                  TAO_Sharded_User_Id_Map_Iterator (*this,
+                                                    this->shard_count_),
+                  0);
+  return temp;
+}
+
+ACE_Reverse_Iterator_Impl<TAO_Sharded_User_Id_Map::value_type> *
+TAO_Sharded_User_Id_Map::rbegin_impl (void)
+{
+  ACE_Reverse_Iterator_Impl<value_type> *temp = 0;
+  ACE_NEW_RETURN (temp,
+                  TAO_Sharded_User_Id_Map_Reverse_Iterator (
+                    *this,
+                    this->shard_count_),
+                  0);
+  return temp;
+}
+
+ACE_Reverse_Iterator_Impl<TAO_Sharded_User_Id_Map::value_type> *
+TAO_Sharded_User_Id_Map::rend_impl (void)
+{
+  ACE_Reverse_Iterator_Impl<value_type> *temp = 0;
+  ACE_NEW_RETURN (temp,
+                  TAO_Sharded_User_Id_Map_Reverse_Iterator (*this, 0),
+                  0);
+  return temp;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TAO_Sharded_User_Id_Map_Iterator::TAO_Sharded_User_Id_Map_Iterator (
+  TAO_Sharded_User_Id_Map &map,
+  size_t index)
+  : map_ (&map)
+  , index_ (index)
+  , iterator_ (map.shard (index < map.shard_count ()
+                            ? index
+                            : map.shard_count () - 1).map_.begin ())
+{
+  this->skip_empty_shards ();
+}
+
+void
+TAO_Sharded_User_Id_Map_Iterator::skip_empty_shards (void)
+{
+  while (this->index_ < this->map_->shard_count ()
+         && this->iterator_ == this->map_->shard (this->index_).map_.end ())
+    {
+      ++this->index_;
+
+      if (this->index_ < this->map_->shard_count ())
+        this->iterator_ = this->map_->shard (this->index_).map_.begin ();
+    }
+}
+
+ACE_Iterator_Impl<TAO_Sharded_User_Id_Map_Iterator::value_type> *
+TAO_Sharded_User_Id_Map_Iterator::clone (void) const
+{
+  ACE_Iterator_Impl<value_type> *temp = 0;
+  ACE_NEW_RETURN (temp,
+                  TAO_Sharded_User_Id_Map_Iterator (*this),
+                  0);
+  return temp;
+}
+
+int
+TAO_Sharded_User_Id_Map_Iterator::compare (
+  const ACE_Iterator_Impl<value_type> &rhs) const
+{
+  const TAO_Sharded_User_Id_Map_Iterator &rhs_local =
+    dynamic_cast<const TAO_Sharded_User_Id_Map_Iterator &> (rhs);
+
+  return this->map_ == rhs_local.map_
+    && this->index_ == rhs_local.index_
+    && (this->index_ == this->map_->shard_count ()
+        || this->iterator_ == rhs_local.iterator_);
+}
+
+TAO_Sharded_User_Id_Map_Iterator::value_type
+TAO_Sharded_User_Id_Map_Iterator::dereference (void) const
+{
+  return value_type ((*iterator_).ext_id_, (*iterator_).int_id_);
+}
+
+void
+TAO_Sharded_User_Id_Map_Iterator::plus_plus (void)
+{
+  ++this->iterator_;
+  this->skip_empty_shards ();
+}
+
+void
+TAO_Sharded_User_Id_Map_Iterator::minus_minus (void)
+{
+  if (this->index_ < this->map_->shard_count ()
+      && this->iterator_ != this->map_->shard (this->index_).map_.begin ())
+    {
+      --this->iterator_;
+      return;
+    }
+
+  // Move to the last entry of the preceding shard that is not empty.
+  // The hash map iterators cannot step back from the end of their map,
+  // the last entry is found from the start of the shard.
+  while (this->index_ > 0)
+    {
+      --this->index_;
+
+      TAO_Sharded_User_Id_Map::shard_map &map =
+        this->map_->shard (this->index_).map_;
+
+      if (map.current_size () != 0)
+        {
+          TAO_Sharded_User_Id_Map::shard_map::iterator i = map.begin ();
+          this->iterator_ = i;
+
+          for (++i; i != map.end (); ++i)
+            this->iterator_ = i;
+
+          return;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TAO_Sharded_User_Id_Map_Reverse_Iterator::TAO_Sharded_User_Id_Map_Reverse_Iterator (
+  TAO_Sharded_User_Id_Map &map,
+  size_t index)
+  : map_ (&map)
+  , index_ (index)
+  , iterator_ (map.shard (index > 0 ? index - 1 : 0).map_.rbegin ())
+{
+  this->skip_empty_shards ();
+}
+
+void
+TAO_Sharded_User_Id_Map_Reverse_Iterator::skip_empty_shards (void)
+{
+  while (this->index_ > 0
+         && this->iterator_ == this->map_->shard (this->index_ - 1).map_.rend ())
+    {
+      --this->index_;
+
+      if (this->index_ > 0)
+        this->iterator_ = this->map_->shard (this->index_ - 1).map_.rbegin ();
+    }
+}
+
+ACE_Reverse_Iterator_Impl<TAO_Sharded_User_Id_Map_Reverse_Iterator::value_type> *
+TAO_Sharded_User_Id_Map_Reverse_Iterator::clone (void) const
+{
+  ACE_Reverse_Iterator_Impl<value_type> *temp = 0;
+  ACE_NEW_RETURN (temp,
+                  TAO_Sharded_User_Id_Map_Reverse_Iterator (*this),
+                  0);
+  return temp;
+}
+
+int
+TAO_Sharded_User_Id_Map_Reverse_Iterator::compare (
+  const ACE_Reverse_Iterator_Impl<value_type> &rhs) const
+{
+  const TAO_Sharded_User_Id_Map_Reverse_Iterator &rhs_local =
+    dynamic_cast<const TAO_Sharded_User_Id_Map_Reverse_Iterator &> (rhs);
+
+  return this->map_ == rhs_local.map_
+    && this->index_ == rhs_local.index_
+    && (this->index_ == 0 || this->iterator_ == rhs_local.iterator_);
+}
+
+TAO_Sharded_User_Id_Map_Reverse_Iterator::value_type
+TAO_Sharded_User_Id_Map_Reverse_Iterator::dereference (void) const
+{
+  return value_type ((*iterator_).ext_id_, (*iterator_).int_id_);
+}
+
+void
+TAO_Sharded_User_Id_Map_Reverse_Iterator::plus_plus (void)
+{
+  ++this->iterator_;
+  this->skip_empty_shards ();
+}
+
+void
+TAO_Sharded_User_Id_Map_Reverse_Iterator::minus_minus (void)
+{
+  if (this->index_ > 0
+      && this->iterator_ != this->map_->shard (this->index_ - 1).map_.rbegin ())
+    {
+      --this->iterator_;
+      return;
+    }
+
+  // Move to the first entry of the following shard that is not empty,
+  // found from the end of the shard as in
+  // TAO_Sharded_User_Id_Map_Iterator::minus_minus ().
+  while (this->index_ < this->map_->shard_count ())
+    {
+      ++this->index_;
+
+      TAO_Sharded_User_Id_Map::shard_map &map =
+        this->map_->shard (this->index_ - 1).map_;
+
+      if (map.current_size () != 0)
+        {
+          TAO_Sharded_User_Id_Map::shard_map::reverse_iterator i =
+            map.rbegin ();
+          this->iterator_ = i;
+
+          for (++i; i != map.rend (); ++i)
+            this->iterator_ = i;
+
+          return;
+        }
+    }
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
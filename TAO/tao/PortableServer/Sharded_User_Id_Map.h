@@ -0,0 +1,272 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    Sharded_User_Id_Map.h
+ *
+ *  The id map of the Active Object Map of a POA with the
+ *  SHARDED_ACTIVE_OBJECT_MAP policy.
+ */
+//=============================================================================
+
+#ifndef TAO_SHARDED_USER_ID_MAP_H
+#define TAO_SHARDED_USER_ID_MAP_H
+
+#include /**/ "ace/pre.h"
+
+#include "tao/PortableServer/Key_Adapters.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "tao/PortableServer/Servant_Base.h"
+#include "tao/orbconf.h"
+#include "ace/Map_T.h"
+#include "ace/Hash_Map_Manager_T.h"
+#include "ace/Null_Mutex.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+struct TAO_Active_Object_Map_Entry;
+
+/**
+ * @class TAO_Sharded_User_Id_Map
+ *
+ * @brief Map of object ids to active object map entries, split into
+ * shards that each have their own lock.
+ *
+ * The shard of an id is chosen from its hash, and each shard is a hash
+ * map protected by its lock.  Unlike the other id maps, the map can
+ * thus be searched without the lock of the object adapter, and
+ * find_servant_and_add_reference () lets an upcall find a servant and
+ * keep it active in one step.  The changes of the map are still only
+ * made with the lock of the object adapter held, and so is the
+ * iteration over the map, which does not take the locks of the shards.
+ *
+ * The reference count and the deactivated flag of an entry are changed
+ * with the lock of its shard held, see TAO_Active_Object_Map_Entry::lock_.
+ */
+class TAO_Sharded_User_Id_Map
+  : public ACE_Map<PortableServer::ObjectId, TAO_Active_Object_Map_Entry *>
+{
+public:
+
+  typedef ACE_Hash_Map_Manager_Ex<
+  PortableServer::ObjectId,
+    TAO_Active_Object_Map_Entry *,
+    TAO_ObjectId_Hash,
+    ACE_Equal_To<PortableServer::ObjectId>,
+    ACE_Null_Mutex> shard_map;
+
+  /// A shard of the map.
+  struct Shard
+  {
+    TAO_SYNCH_MUTEX lock_;
+    shard_map map_;
+  };
+
+  /**
+   * @param shards Number of shards.
+   * @param size Initial size of the hash map of each shard.
+   * @param key_size Size of the ids produced by create_key ().
+   */
+  TAO_Sharded_User_Id_Map (size_t shards, size_t size, size_t key_size);
+
+  virtual ~TAO_Sharded_User_Id_Map (void);
+
+  /**
+   * Find the entry of @a key, and add a reference to it if it has a
+   * servant and is not deactivated, with the lock of the shard of the
+   * entry held.  The reference keeps the servant active until it is
+   * removed with TAO_Active_Object_Map::remove_reference ().
+   */
+  int find_servant_and_add_reference (const PortableServer::ObjectId &key,
+                                      PortableServer::Servant &servant,
+                                      TAO_Active_Object_Map_Entry *&entry);
+
+  /// Number of shards.
+  size_t shard_count (void) const;
+
+  /// The shard at @a index.
+  Shard &shard (size_t index);
+
+  // = The ACE_Map interface.
+
+  virtual int open (size_t length = ACE_DEFAULT_MAP_SIZE,
+                    ACE_Allocator *alloc = 0);
+
+  virtual int close (void);
+
+  virtual int bind (const PortableServer::ObjectId &key,
+                    TAO_Active_Object_Map_Entry * const &value);
+
+  virtual int bind_modify_key (TAO_Active_Object_Map_Entry * const &value,
+                               PortableServer::ObjectId &key);
+
+  /// Produce a new id of the size given to the constructor.
+  virtual int create_key (PortableServer::ObjectId &key);
+
+  virtual int bind_create_key (TAO_Active_Object_Map_Entry * const &value,
+                               PortableServer::ObjectId &key);
+
+  virtual int bind_create_key (TAO_Active_Object_Map_Entry * const &value);
+
+  virtual int recover_key (const PortableServer::ObjectId &modified_key,
+                           PortableServer::ObjectId &original_key);
+
+  virtual int rebind (const PortableServer::ObjectId &key,
+                      TAO_Active_Object_Map_Entry * const &value);
+
+  virtual int rebind (const PortableServer::ObjectId &key,
+                      TAO_Active_Object_Map_Entry * const &value,
+                      TAO_Active_Object_Map_Entry *&old_value);
+
+  virtual int rebind (const PortableServer::ObjectId &key,
+                      TAO_Active_Object_Map_Entry * const &value,
+                      PortableServer::ObjectId &old_key,
+                      TAO_Active_Object_Map_Entry *&old_value);
+
+  virtual int trybind (const PortableServer::ObjectId &key,
+                       TAO_Active_Object_Map_Entry *&value);
+
+  virtual int find (const PortableServer::ObjectId &key,
+                    TAO_Active_Object_Map_Entry *&value);
+
+  virtual int find (const PortableServer::ObjectId &key);
+
+  virtual int unbind (const PortableServer::ObjectId &key);
+
+  virtual int unbind (const PortableServer::ObjectId &key,
+                      TAO_Active_Object_Map_Entry *&value);
+
+  virtual size_t current_size (void) const;
+
+  virtual size_t total_size (void) const;
+
+  virtual void dump (void) const;
+
+protected:
+
+  typedef ACE_Reference_Pair<const PortableServer::ObjectId,
+                             TAO_Active_Object_Map_Entry *> value_type;
+
+  virtual ACE_Iterator_Impl<value_type> *begin_impl (void);
+  virtual ACE_Iterator_Impl<value_type> *end_impl (void);
+
+  virtual ACE_Reverse_Iterator_Impl<value_type> *rbegin_impl (void);
+  virtual ACE_Reverse_Iterator_Impl<value_type> *rend_impl (void);
+
+private:
+
+  /// The shard of @a key.
+  Shard &shard_of (const PortableServer::ObjectId &key);
+
+  /// Bind @a key to @a value in its shard; sets the lock of the entry.
+  int bind_i (const PortableServer::ObjectId &key,
+              TAO_Active_Object_Map_Entry *value);
+
+  Shard *shards_;
+  size_t shard_count_;
+
+  /// Size of the ids produced by create_key ().
+  size_t key_size_;
+
+  /// The ids produced by create_key () are made of this counter.
+  TAO_SYNCH_MUTEX key_lock_;
+  ACE_UINT64 next_key_;
+
+  // = Disallow these operations.
+  ACE_UNIMPLEMENTED_FUNC (void operator= (const TAO_Sharded_User_Id_Map &))
+  ACE_UNIMPLEMENTED_FUNC (TAO_Sharded_User_Id_Map (const TAO_Sharded_User_Id_Map &))
+};
+
+/**
+ * @class TAO_Sharded_User_Id_Map_Iterator
+ *
+ * @brief Iterator over the shards of a TAO_Sharded_User_Id_Map, one
+ * after the other.
+ */
+class TAO_Sharded_User_Id_Map_Iterator
+  : public ACE_Iterator_Impl<ACE_Reference_Pair<const PortableServer::ObjectId,
+                                                TAO_Active_Object_Map_Entry *> >
+{
+public:
+
+  typedef ACE_Reference_Pair<const PortableServer::ObjectId,
+                             TAO_Active_Object_Map_Entry *> value_type;
+
+  /// Iterator on the first entry of shard @a index, or the following
+  /// shards if it is empty.  @a index is the number of shards for the
+  /// end of the map.
+  TAO_Sharded_User_Id_Map_Iterator (TAO_Sharded_User_Id_Map &map,
+                                    size_t index);
+
+  virtual ACE_Iterator_Impl<value_type> *clone (void) const;
+
+  virtual int compare (const ACE_Iterator_Impl<value_type> &rhs) const;
+
+  virtual value_type dereference (void) const;
+
+  virtual void plus_plus (void);
+
+  virtual void minus_minus (void);
+
+private:
+
+  /// Move to the first entry of the next shard that is not empty, if
+  /// the end of the current shard is reached.
+  void skip_empty_shards (void);
+
+  TAO_Sharded_User_Id_Map *map_;
+  size_t index_;
+  TAO_Sharded_User_Id_Map::shard_map::iterator iterator_;
+};
+
+/**
+ * @class TAO_Sharded_User_Id_Map_Reverse_Iterator
+ *
+ * @brief Reverse iterator over the shards of a TAO_Sharded_User_Id_Map.
+ */
+class TAO_Sharded_User_Id_Map_Reverse_Iterator
+  : public ACE_Reverse_Iterator_Impl<ACE_Reference_Pair<const PortableServer::ObjectId,
+                                                        TAO_Active_Object_Map_Entry *> >
+{
+public:
+
+  typedef ACE_Reference_Pair<const PortableServer::ObjectId,
+                             TAO_Active_Object_Map_Entry *> value_type;
+
+  /// Iterator on the last entry of shard @a index - 1, or the
+  /// preceding shards if it is empty.  @a index is 0 for the end of
+  /// the map.
+  TAO_Sharded_User_Id_Map_Reverse_Iterator (TAO_Sharded_User_Id_Map &map,
+                                            size_t index);
+
+  virtual ACE_Reverse_Iterator_Impl<value_type> *clone (void) const;
+
+  virtual int compare (const ACE_Reverse_Iterator_Impl<value_type> &rhs) const;
+
+  virtual value_type dereference (void) const;
+
+  virtual void plus_plus (void);
+
+  virtual void minus_minus (void);
+
+private:
+
+  /// Move to the last entry of the preceding shard that is not empty,
+  /// if the end of the current shard is reached.
+  void skip_empty_shards (void);
+
+  TAO_Sharded_User_Id_Map *map_;
+  /// One more than the index of the current shard.
+  size_t index_;
+  TAO_Sharded_User_Id_Map::shard_map::reverse_iterator iterator_;
+};
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#include /**/ "ace/post.h"
+
+#endif /* TAO_SHARDED_USER_ID_MAP_H */
@@ -1,4 +1,7 @@
 #include "tao/Queued_Message.h"
+#include "tao/ORB_Core.h"
+
+#include "ace/Message_Block.h"
 
 #if !defined (__ACE_INLINE__)
 # include "tao/Queued_Message.inl"
@@ -93,4 +96,92 @@ TAO_Queued_Message::is_expired (const ACE_Time_Value &) const
   return false;
 }
 
+namespace
+{
+  /// Can the data of @a mb be referenced instead of copied?
+  bool
+  is_shared (const ACE_Message_Block *mb)
+  {
+    // Data blocks owned by the CDR stream are referenced only by the
+    // stream and get reused or released once the message was sent.
+    // A buffer that the stream chained from an octet sequence is
+    // still referenced by the sequence as well.
+    ACE_Data_Block const * const db = mb->data_block ();
+    return ACE_BIT_DISABLED (db->flags (), ACE_Message_Block::DONT_DELETE)
+      && db->reference_count () > 1;
+  }
+}
+
+ACE_Message_Block *
+TAO_Queued_Message::copy_chain (const ACE_Message_Block *chain) const
+{
+  bool const zero_copy =
+    this->orb_core_ != 0
+    && this->orb_core_->orb_params ()->zero_copy_octet_sequences ();
+
+  ACE_Message_Block *head = 0;
+  ACE_Message_Block *tail = 0;
+
+  const ACE_Message_Block *i = chain;
+  while (i != 0)
+    {
+      ACE_Message_Block *mb = 0;
+
+      if (zero_copy && is_shared (i))
+        {
+          ACE_NEW_NORETURN (mb,
+                            ACE_Message_Block (i->data_block ()->duplicate ()));
+          if (mb != 0)
+            {
+              mb->rd_ptr (i->rd_ptr ());
+              mb->wr_ptr (i->wr_ptr ());
+            }
+          i = i->cont ();
+        }
+      else
+        {
+          // Find the run of blocks that have to be copied.
+          size_t length = 0;
+          const ACE_Message_Block *end = i;
+          for (;
+               end != 0 && !(zero_copy && is_shared (end));
+               end = end->cont ())
+            {
+              length += end->length ();
+            }
+
+          ACE_NEW_NORETURN (mb, ACE_Message_Block (length));
+          if (mb != 0 && mb->size () < length)
+            {
+              // The data block could not be allocated.
+              mb->release ();
+              mb = 0;
+            }
+
+          for (; mb != 0 && i != end; i = i->cont ())
+            {
+              mb->copy (i->rd_ptr (), i->length ());
+            }
+        }
+
+      if (mb == 0)
+        {
+          ACE_Message_Block::release (head);
+          return 0;
+        }
+
+      if (tail == 0)
+        {
+          head = mb;
+        }
+      else
+        {
+          tail->cont (mb);
+        }
+      tail = mb;
+    }
+
+  return head;
+}
+
 TAO_END_VERSIONED_NAMESPACE_DECL
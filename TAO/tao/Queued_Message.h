@@ -212,6 +212,20 @@ public:
   //@}
 
 protected:
+  /// Make a copy of @a chain that the transport can keep.
+  /**
+   * When the ORB runs with -ORBZeroCopyOctetSequences the blocks
+   * whose data is shared with something else, i.e. octet sequence
+   * buffers that the CDR stream chained instead of copying them, are
+   * referenced.  The data of the other blocks, which belong to the
+   * CDR stream, is always copied; consecutive blocks are gathered in
+   * a single new block.
+   *
+   * @return The new chain, owned by the caller, or 0 if there was no
+   *         memory or @a chain is 0.
+   */
+  ACE_Message_Block *copy_chain (const ACE_Message_Block *chain) const;
+
   /*
    * Allocator that was used to create @c this object on the heap. If the
    * allocator is null then @a this is on stack.
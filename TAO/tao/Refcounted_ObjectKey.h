@@ -32,7 +32,7 @@ namespace TAO
    * ObjectKey.
    *
    * The refcount in this class is manipulated within the context of
-   * the lock in the TAO::ObjectKey_Table. Manipulating the refcount
+   * the lock of its shard in the TAO::ObjectKey_Table. Manipulating the refcount
    * from anywhere else is strictly forbidden.
    */
   class TAO_Export Refcounted_ObjectKey
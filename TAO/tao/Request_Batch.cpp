@@ -0,0 +1,118 @@
+// -*- C++ -*-
+#include "tao/Request_Batch.h"
+#include "tao/ORB_Core.h"
+#include "tao/ORB_Core_TSS_Resources.h"
+#include "tao/Transport.h"
+#include "tao/debug.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace TAO
+{
+  Request_Batch::Request_Batch (CORBA::ORB_ptr orb)
+    : orb_core_ (orb->orb_core ())
+    , tss_ (orb_core_->get_tss_resources ())
+    , previous_ (0)
+    , transports_ ()
+    , transport_count_ (0)
+    , queued_ (0)
+  {
+    this->orb_core_->request_batch_begin ();
+    this->previous_ = this->tss_->request_batch_;
+    this->tss_->request_batch_ = this;
+  }
+
+  Request_Batch::~Request_Batch (void)
+  {
+    // Stop holding back first, so that nothing is queued while the
+    // transports are flushed.
+    this->tss_->request_batch_ = this->previous_;
+    this->orb_core_->request_batch_end ();
+
+    (void) this->flush ();
+  }
+
+  int
+  Request_Batch::flush (ACE_Time_Value *max_wait_time)
+  {
+    int result = 0;
+
+    for (size_t i = 0; i != this->transport_count_; ++i)
+      {
+        TAO_Transport * const transport = this->transports_[i];
+
+        if (transport->flush_queue (max_wait_time) == -1)
+          {
+            if (TAO_debug_level > 0)
+              {
+                TAOLIB_ERROR ((LM_ERROR,
+                   ACE_TEXT ("TAO (%P|%t) - Request_Batch::flush, ")
+                   ACE_TEXT ("transport[%d] could not be flushed - %m\n"),
+                   transport->id ()));
+              }
+            result = -1;
+          }
+
+        transport->remove_reference ();
+      }
+
+    this->transport_count_ = 0;
+    this->queued_ = 0;
+
+    return result;
+  }
+
+  size_t
+  Request_Batch::queued (void) const
+  {
+    return this->queued_;
+  }
+
+  bool
+  Request_Batch::must_queue (bool) const
+  {
+    return true;
+  }
+
+  bool
+  Request_Batch::buffering_constraints_reached (
+    TAO_Stub *,
+    size_t ,
+    size_t ,
+    bool &must_flush,
+    const ACE_Time_Value &,
+    bool &set_timer,
+    ACE_Time_Value &) const
+  {
+    set_timer = false;
+    must_flush = false;
+    return false;
+  }
+
+  void
+  Request_Batch::message_queued (TAO_Transport *transport)
+  {
+    ++this->queued_;
+
+    for (size_t i = 0; i != this->transport_count_; ++i)
+      {
+        if (this->transports_[i] == transport)
+          {
+            return;
+          }
+      }
+
+    // Without room for the transport its queue is sent with the next
+    // message that isn't held back.
+    if (this->transport_count_ == this->transports_.size ()
+        && this->transports_.size (this->transport_count_ * 2 + 4) == -1)
+      {
+        return;
+      }
+
+    transport->add_reference ();
+    this->transports_[this->transport_count_++] = transport;
+  }
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,126 @@
+// -*- C++ -*-
+
+// ===================================================================
+/**
+ *  @file   Request_Batch.h
+ *
+ *  Holds back the requests a thread makes, to send them together.
+ */
+// ===================================================================
+
+#ifndef TAO_REQUEST_BATCH_H
+#define TAO_REQUEST_BATCH_H
+
+#include /**/ "ace/pre.h"
+
+#include "tao/TAO_Export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "tao/Transport_Queueing_Strategies.h"
+#include "tao/ORB.h"
+#include "ace/Array_Base.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+class TAO_ORB_Core;
+class TAO_ORB_Core_TSS_Resources;
+
+namespace TAO
+{
+  /**
+   * @class Request_Batch
+   *
+   * @brief Sends the requests a thread makes while it exists together.
+   *
+   * While a Request_Batch is on the stack, the requests the thread
+   * sends without waiting for the reply, AMI requests and oneways, are
+   * queued in their transport instead of being written one at a time.
+   * flush(), and the destructor, write the queue of each transport
+   * with as few writev() calls as the socket allows.  The replies
+   * are dispatched to the reply handlers as usual.
+   *
+   * A synchronous twoway request made in the batch is sent after the
+   * requests queued for the same transport, in the same writev(), and
+   * then waits for its reply as usual, so
+   *
+   * @code
+   *   {
+   *     TAO::Request_Batch batch (orb.in ());
+   *     for (i = 0; i != n; ++i)
+   *       server->sendc_get (handler.in (), i);
+   *   }
+   * @endcode
+   *
+   * costs the client one system call instead of @c n.
+   *
+   * The batch belongs to the ORB and thread it was made for.  Batches
+   * may be nested, the requests are then sent when the inner one ends.
+   */
+  class TAO_Export Request_Batch : public Transport_Queueing_Strategy
+  {
+  public:
+    /// Start holding back the requests this thread makes through
+    /// @a orb.
+    explicit Request_Batch (CORBA::ORB_ptr orb);
+
+    /// Send the requests held back and stop holding them back.
+    ~Request_Batch (void);
+
+    /// Send the requests held back so far.
+    /**
+     * @param max_wait_time Maximum time to wait for the requests to
+     *        be written, 0 to wait as long as it takes.
+     * @return 0 on success, -1 if the requests couldn't be written to
+     *         some transport.
+     */
+    int flush (ACE_Time_Value *max_wait_time = 0);
+
+    /// The number of requests held back since the last flush.
+    size_t queued (void) const;
+
+    /// Requests are always queued.
+    virtual bool must_queue (bool queue_empty) const;
+
+    /// The queue is only sent by flush().
+    virtual bool buffering_constraints_reached (
+      TAO_Stub *stub,
+      size_t msg_count,
+      size_t total_bytes,
+      bool &must_flush,
+      const ACE_Time_Value &current_deadline,
+      bool &set_timer,
+      ACE_Time_Value &interval) const;
+
+    /// Remember that @a transport has to be flushed.
+    virtual void message_queued (TAO_Transport *transport);
+
+  private:
+    Request_Batch (const Request_Batch &);
+    void operator= (const Request_Batch &);
+
+    /// The ORB the batch is for.
+    TAO_ORB_Core *orb_core_;
+
+    /// The TSS resources of the thread and ORB the batch is for.
+    TAO_ORB_Core_TSS_Resources *tss_;
+
+    /// The batch this one is nested in, if any.
+    Transport_Queueing_Strategy *previous_;
+
+    /// The transports holding requests back, each one referenced
+    /// until it is flushed.
+    ACE_Array_Base<TAO_Transport *> transports_;
+    size_t transport_count_;
+
+    size_t queued_;
+  };
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#include /**/ "ace/post.h"
+
+#endif /* TAO_REQUEST_BATCH_H */
@@ -169,6 +169,18 @@ TAO_Resource_Factory::purge_percentage (void) const
   return 0;
 }
 
+int
+TAO_Resource_Factory::cache_shards (void) const
+{
+  return TAO_CONNECTION_CACHE_SHARDS;
+}
+
+int
+TAO_Resource_Factory::object_key_table_shards (void) const
+{
+  return TAO_OBJECT_KEY_TABLE_SHARDS;
+}
+
 int
 TAO_Resource_Factory::max_muxed_connections (void) const
 {
@@ -208,6 +208,14 @@ public:
   /// cache.
   virtual int purge_percentage (void) const;
 
+  /// This denotes the number of independently locked shards the
+  /// connection cache is split in.
+  virtual int cache_shards (void) const;
+
+  /// This denotes the number of independently locked shards the
+  /// ObjectKey table of the ORB is split in.
+  virtual int object_key_table_shards (void) const;
+
   /// Return the number of muxed connections that are allowed for a
   /// remote endpoint
   virtual int max_muxed_connections (void) const;
@@ -20,6 +20,7 @@ TAO_Server_Strategy_Factory::active_object_map_creation_parameters (void) const
 
 TAO_Server_Strategy_Factory::Active_Object_Map_Creation_Parameters::Active_Object_Map_Creation_Parameters (void)
   : active_object_map_size_ (TAO_DEFAULT_SERVER_ACTIVE_OBJECT_MAP_SIZE),
+    active_object_map_shards_ (TAO_DEFAULT_SERVER_ACTIVE_OBJECT_MAP_SHARDS),
     object_lookup_strategy_for_user_id_policy_ (TAO_DYNAMIC_HASH),
     object_lookup_strategy_for_system_id_policy_ (TAO_ACTIVE_DEMUX),
     reverse_object_lookup_strategy_for_unique_id_policy_ (TAO_DYNAMIC_HASH),
@@ -54,6 +54,10 @@ public:
     /// Default size of object lookup table.
     CORBA::ULong active_object_map_size_;
 
+    /// Number of shards of the object lookup table of the POAs with
+    /// the TAO::SHARDED_ACTIVE_OBJECT_MAP policy.
+    CORBA::ULong active_object_map_shards_;
+
     /// The type of lookup/demultiplexing strategy being used for user
     /// id policy
     TAO_Demux_Strategy object_lookup_strategy_for_user_id_policy_;
@@ -20,4 +20,10 @@ TAO::Storable_Factory::~Storable_Factory (void)
 {
 }
 
+bool
+TAO::Storable_Factory::append_supported (void) const
+{
+  return false;
+}
+
 TAO_END_VERSIONED_NAMESPACE_DECL
@@ -40,6 +40,10 @@ namespace TAO
                                          const char * mode,
                                          bool use_backup =
                                          Storable_Base::use_backup_default) = 0;
+
+    /// Can the streams be opened with a mode that contains 'a', where
+    /// what is written is appended to the stream?  False by default.
+    virtual bool append_supported (void) const;
   };
 
 }
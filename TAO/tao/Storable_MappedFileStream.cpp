@@ -0,0 +1,1278 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ * @file  Storable_MappedFileStream.cpp
+ *
+ * A Storable_Factory whose streams are kept in a log-structured store
+ * mapped in memory, with a hash index of the streams.
+ */
+//=============================================================================
+
+#include "tao/Storable_MappedFileStream.h"
+
+#include "ace/ACE.h"
+#include "ace/Array_Base.h"
+#include "ace/Guard_T.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/OS_NS_fcntl.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_sys_time.h"
+#include "ace/Truncate.h"
+#include "tao/debug.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace
+{
+  const char log_magic[8] = { 'T', 'A', 'O', 'S', 'L', 'O', 'G', '1' };
+  const char index_magic[8] = { 'T', 'A', 'O', 'S', 'I', 'D', 'X', '1' };
+  const ACE_UINT32 record_magic = 0x53524543; // "SREC"
+
+  /// Offset 0 of a slot is a free slot, offset 1 a removed stream.
+  const ACE_UINT64 free_slot = 0;
+  const ACE_UINT64 removed_slot = 1;
+
+  /// Size of a new log.
+  const size_t initial_log_size = 64 * 1024;
+  /// Number of slots of a new index.
+  const ACE_UINT64 initial_capacity = 64;
+  /// The log is not compacted while it is smaller.
+  const ACE_UINT64 compaction_threshold = 4 * 1024 * 1024;
+
+  ACE_UINT64 new_generation ()
+  {
+    ACE_Time_Value const now = ACE_OS::gettimeofday ();
+    return (static_cast<ACE_UINT64> (now.sec ()) << 20) ^ now.usec () ^ 1;
+  }
+}
+
+TAO::Storable_MappedFileStore::Storable_MappedFileStore (const ACE_CString & directory)
+  : directory_ (directory)
+  , open_ (false)
+  , log_end_ (0)
+  , live_size_ (0)
+  , used_slots_ (0)
+  , stream_count_ (0)
+{
+  lock_.handle_ = ACE_INVALID_HANDLE;
+  lock_.lockname_ = 0;
+}
+
+TAO::Storable_MappedFileStore::~Storable_MappedFileStore ()
+{
+  this->close ();
+}
+
+ACE_CString
+TAO::Storable_MappedFileStore::file_name (const char * suffix) const
+{
+  return this->directory_ + "/Storable." + suffix;
+}
+
+int
+TAO::Storable_MappedFileStore::open ()
+{
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, guard, this->mutex_, -1);
+  if (this->open_)
+    return 0;
+  return this->open_i ();
+}
+
+int
+TAO::Storable_MappedFileStore::open_i ()
+{
+  ACE_CString const lock_name = this->file_name ("lock");
+  if (ACE_OS::flock_init (&this->lock_, O_RDWR | O_CREAT,
+                          ACE_TEXT_CHAR_TO_TCHAR (lock_name.c_str ()), 0666) != 0)
+    TAOLIB_ERROR_RETURN ((LM_ERROR,
+                          ACE_TEXT ("(%P|%t) Storable_MappedFileStore::open ")
+                          ACE_TEXT ("Cannot open file %C: %p\n"),
+                          lock_name.c_str (), ACE_TEXT ("ACE_OS::flock_init")),
+                         -1);
+  if (ACE_OS::flock_trywrlock (&this->lock_, 0, 0, 0) != 0)
+    {
+      ACE_OS::flock_destroy (&this->lock_, 0);
+      TAOLIB_ERROR_RETURN ((LM_ERROR,
+                            ACE_TEXT ("(%P|%t) Storable_MappedFileStore::open ")
+                            ACE_TEXT ("The store in %C is used by another ")
+                            ACE_TEXT ("process\n"),
+                            this->directory_.c_str ()),
+                           -1);
+    }
+
+  ACE_CString const log_name = this->file_name ("log");
+  ACE_CString const index_name = this->file_name ("idx");
+  int result = -1;
+  if (this->log_.open (ACE_TEXT_CHAR_TO_TCHAR (log_name.c_str ())) == 0
+      && this->index_.open (ACE_TEXT_CHAR_TO_TCHAR (index_name.c_str ())) == 0)
+    {
+      ACE_OFF_T const log_size = ACE_OS::filesize (this->log_.handle ());
+      if (log_size == 0)
+        {
+          // A new store.
+          if (this->map (this->log_, initial_log_size) == 0)
+            {
+              File_Header * header = this->log_header ();
+              ACE_OS::memcpy (header->magic, log_magic, sizeof log_magic);
+              header->generation = new_generation ();
+              result = 0;
+            }
+        }
+      else if (log_size >= static_cast<ACE_OFF_T> (sizeof (File_Header))
+               && this->map (this->log_,
+                             ACE_Utils::truncate_cast<size_t> (log_size)) == 0
+               && ACE_OS::memcmp (this->log_header ()->magic, log_magic,
+                                  sizeof log_magic) == 0)
+        {
+          result = 0;
+        }
+      else
+        {
+          TAOLIB_ERROR ((LM_ERROR,
+                         ACE_TEXT ("(%P|%t) Storable_MappedFileStore::open ")
+                         ACE_TEXT ("%C is not a log\n"),
+                         log_name.c_str ()));
+        }
+    }
+  else
+    {
+      TAOLIB_ERROR ((LM_ERROR,
+                     ACE_TEXT ("(%P|%t) Storable_MappedFileStore::open ")
+                     ACE_TEXT ("Cannot open the files in %C: %p\n"),
+                     this->directory_.c_str (), ACE_TEXT ("ACE_Mem_Map::open")));
+    }
+
+  // Use the index if it belongs to the log and points into it, and add
+  // the records that follow the part of the log it covers.
+  bool valid = false;
+  if (result == 0)
+    {
+      ACE_OFF_T const index_size = ACE_OS::filesize (this->index_.handle ());
+      if (index_size > static_cast<ACE_OFF_T> (sizeof (File_Header))
+          && this->map (this->index_,
+                        ACE_Utils::truncate_cast<size_t> (index_size)) == 0)
+        {
+          File_Header const * header = this->index_header ();
+          valid = ACE_OS::memcmp (header->magic, index_magic,
+                                  sizeof index_magic) == 0
+            && header->generation == this->log_header ()->generation
+            && header->capacity >= initial_capacity
+            && (header->capacity & (header->capacity - 1)) == 0
+            && sizeof (File_Header) + header->capacity * sizeof (Slot)
+               == static_cast<ACE_UINT64> (index_size)
+            && header->log_end >= sizeof (File_Header)
+            && header->log_end <= this->log_.size ();
+        }
+
+      this->live_size_ = 0;
+      this->used_slots_ = 0;
+      this->stream_count_ = 0;
+      ACE_UINT64 const capacity = valid ? this->index_header ()->capacity : 0;
+      Slot const * slots = valid ? this->slots () : 0;
+      for (ACE_UINT64 i = 0; valid && i < capacity; ++i)
+        {
+          if (slots[i].offset == free_slot)
+            continue;
+          ++this->used_slots_;
+          if (slots[i].offset == removed_slot)
+            continue;
+          Record_Header const * record = this->record (slots[i].offset);
+          valid = slots[i].offset % 8 == 0
+            && slots[i].offset + sizeof (Record_Header) <= this->log_.size ()
+            && record->magic == record_magic
+            && record->type != RT_Remove;
+          if (valid)
+            {
+              ++this->stream_count_;
+              this->live_size_ += record->chain_size;
+            }
+        }
+
+      if (valid)
+        {
+          result = this->replay (this->index_header ()->log_end);
+          for (ACE_UINT64 i = 0; result == 0 && valid && i < capacity; ++i)
+            valid = slots[i].offset < this->log_end_;
+        }
+      if (result == 0 && !valid)
+        {
+          if (TAO_debug_level > 0)
+            {
+              TAOLIB_DEBUG ((LM_DEBUG,
+                             ACE_TEXT ("TAO (%P|%t) Storable_MappedFileStore::open ")
+                             ACE_TEXT ("rebuilding the index of %C\n"),
+                             log_name.c_str ()));
+            }
+          result = this->rebuild_index ();
+        }
+    }
+
+  if (result != 0)
+    {
+      this->log_.close ();
+      this->index_.close ();
+      ACE_OS::flock_destroy (&this->lock_, 0);
+      return -1;
+    }
+  this->open_ = true;
+  return 0;
+}
+
+void
+TAO::Storable_MappedFileStore::close ()
+{
+  ACE_GUARD (TAO_SYNCH_MUTEX, guard, this->mutex_);
+  if (!this->open_)
+    return;
+  this->sync_i ();
+  this->log_.close ();
+  this->index_.close ();
+  ACE_OS::flock_destroy (&this->lock_, 0);
+  this->open_ = false;
+}
+
+int
+TAO::Storable_MappedFileStore::map (ACE_Mem_Map & map, size_t length)
+{
+  map.unmap ();
+  if (map.map (length, PROT_RDWR, ACE_MAP_SHARED) != 0)
+    TAOLIB_ERROR_RETURN ((LM_ERROR,
+                          ACE_TEXT ("(%P|%t) Storable_MappedFileStore::map ")
+                          ACE_TEXT ("Cannot map %B bytes of %s: %p\n"),
+                          length, map.filename (), ACE_TEXT ("ACE_Mem_Map::map")),
+                         -1);
+  return 0;
+}
+
+TAO::Storable_MappedFileStore::File_Header *
+TAO::Storable_MappedFileStore::log_header () const
+{
+  return static_cast<File_Header *> (this->log_.addr ());
+}
+
+TAO::Storable_MappedFileStore::File_Header *
+TAO::Storable_MappedFileStore::index_header () const
+{
+  return static_cast<File_Header *> (this->index_.addr ());
+}
+
+TAO::Storable_MappedFileStore::Slot *
+TAO::Storable_MappedFileStore::slots () const
+{
+  return reinterpret_cast<Slot *> (this->index_header () + 1);
+}
+
+TAO::Storable_MappedFileStore::Record_Header *
+TAO::Storable_MappedFileStore::record (ACE_UINT64 offset) const
+{
+  return reinterpret_cast<Record_Header *> (
+    static_cast<char *> (this->log_.addr ()) + offset);
+}
+
+const char *
+TAO::Storable_MappedFileStore::record_name (const Record_Header * header) const
+{
+  return reinterpret_cast<const char *> (header + 1);
+}
+
+size_t
+TAO::Storable_MappedFileStore::record_size (size_t name_length,
+                                            size_t data_length)
+{
+  return (sizeof (Record_Header) + name_length + data_length + 7) & ~size_t (7);
+}
+
+ACE_UINT32
+TAO::Storable_MappedFileStore::record_crc (const Record_Header * header)
+{
+  Record_Header copy = *header;
+  copy.crc = 0;
+  ACE_UINT32 const crc = ACE::crc32 (&copy, sizeof copy);
+  return ACE::crc32 (header + 1, header->name_length + header->data_length, crc);
+}
+
+size_t
+TAO::Storable_MappedFileStore::valid_record (ACE_UINT64 offset) const
+{
+  if (offset < sizeof (File_Header)
+      || offset % 8 != 0
+      || offset + sizeof (Record_Header) > this->log_.size ())
+    return 0;
+
+  Record_Header const * header = this->record (offset);
+  if (header->magic != record_magic
+      || header->type < RT_Data
+      || header->type > RT_Remove
+      || header->previous >= offset)
+    return 0;
+
+  size_t const size = record_size (header->name_length, header->data_length);
+  if (offset + size > this->log_.size ()
+      || record_crc (header) != header->crc)
+    return 0;
+  return size;
+}
+
+int
+TAO::Storable_MappedFileStore::create_index (ACE_UINT64 capacity,
+                                             ACE_UINT64 log_end)
+{
+  size_t const size =
+    ACE_Utils::truncate_cast<size_t> (sizeof (File_Header) + capacity * sizeof (Slot));
+  this->index_.unmap ();
+  if (ACE_OS::ftruncate (this->index_.handle (), 0) != 0
+      || this->map (this->index_, size) != 0)
+    return -1;
+
+  // The magic is set once the slots are filled.
+  ACE_OS::memset (this->index_.addr (), 0, size);
+  File_Header * header = this->index_header ();
+  header->generation = this->log_header ()->generation;
+  header->capacity = capacity;
+  header->log_end = log_end;
+  return 0;
+}
+
+int
+TAO::Storable_MappedFileStore::rebuild_index ()
+{
+  this->live_size_ = 0;
+  this->used_slots_ = 0;
+  this->stream_count_ = 0;
+  if (this->create_index (initial_capacity, sizeof (File_Header)) != 0
+      || this->replay (sizeof (File_Header)) != 0)
+    return -1;
+  ACE_OS::memcpy (this->index_header ()->magic, index_magic, sizeof index_magic);
+  return 0;
+}
+
+int
+TAO::Storable_MappedFileStore::replay (ACE_UINT64 offset)
+{
+  for (size_t size = this->valid_record (offset);
+       size != 0;
+       size = this->valid_record (offset))
+    {
+      if (this->apply (offset) != 0)
+        return -1;
+      offset += size;
+    }
+  this->log_end_ = offset;
+
+  // A record that was not completely written ends the log.  Clear what
+  // is left of it, so that it can not be mistaken for a valid record
+  // once others are appended.
+  size_t const header_end =
+    ace_min (this->log_.size (),
+             ACE_Utils::truncate_cast<size_t> (offset + sizeof (Record_Header)));
+  char const * tail = static_cast<char *> (this->log_.addr ()) + offset;
+  for (size_t i = 0; i + offset < header_end; ++i)
+    {
+      if (tail[i] != 0)
+        {
+          if (TAO_debug_level > 0)
+            {
+              TAOLIB_DEBUG ((LM_DEBUG,
+                             ACE_TEXT ("TAO (%P|%t) Storable_MappedFileStore::replay ")
+                             ACE_TEXT ("discarding an incomplete record at ")
+                             ACE_TEXT ("offset %Q\n"),
+                             offset));
+            }
+          ACE_OS::memset (static_cast<char *> (this->log_.addr ()) + offset, 0,
+                          this->log_.size () - ACE_Utils::truncate_cast<size_t> (offset));
+          break;
+        }
+    }
+  return 0;
+}
+
+int
+TAO::Storable_MappedFileStore::apply (ACE_UINT64 offset)
+{
+  Record_Header const * header = this->record (offset);
+  if (header->type != RT_Remove)
+    return this->set_head (this->record_name (header), header->name_length, offset);
+
+  ACE_UINT64 const hash = ACE::hash_pjw (this->record_name (header),
+                                         header->name_length);
+  size_t free = 0;
+  ssize_t const slot =
+    this->find (this->record_name (header), header->name_length, hash, free);
+  if (slot >= 0)
+    {
+      Slot & s = this->slots ()[slot];
+      this->live_size_ -= this->record (s.offset)->chain_size;
+      s.offset = removed_slot;
+      --this->stream_count_;
+    }
+  return 0;
+}
+
+ssize_t
+TAO::Storable_MappedFileStore::find (const char * name,
+                                     size_t length,
+                                     ACE_UINT64 hash,
+                                     size_t & free) const
+{
+  ACE_UINT64 const capacity = this->index_header ()->capacity;
+  ACE_UINT64 const mask = capacity - 1;
+  Slot const * slots = this->slots ();
+  bool found_free = false;
+  for (ACE_UINT64 n = 0, i = hash & mask; n < capacity; ++n, i = (i + 1) & mask)
+    {
+      if (slots[i].offset == free_slot || slots[i].offset == removed_slot)
+        {
+          if (!found_free)
+            {
+              free = static_cast<size_t> (i);
+              found_free = true;
+            }
+          if (slots[i].offset == free_slot)
+            return -1;
+          continue;
+        }
+      if (slots[i].hash == hash)
+        {
+          Record_Header const * header = this->record (slots[i].offset);
+          if (header->name_length == length
+              && ACE_OS::memcmp (this->record_name (header), name, length) == 0)
+            return static_cast<ssize_t> (i);
+        }
+    }
+  return -1;
+}
+
+ACE_UINT64
+TAO::Storable_MappedFileStore::head (const ACE_CString & name) const
+{
+  size_t free = 0;
+  ssize_t const slot = this->find (name.c_str (), name.length (),
+                                   ACE::hash_pjw (name.c_str (), name.length ()),
+                                   free);
+  return slot < 0 ? 0 : this->slots ()[slot].offset;
+}
+
+int
+TAO::Storable_MappedFileStore::set_head (const char * name,
+                                         size_t length,
+                                         ACE_UINT64 offset)
+{
+  ACE_UINT64 const hash = ACE::hash_pjw (name, length);
+  size_t free = 0;
+  ssize_t const slot = this->find (name, length, hash, free);
+  if (slot >= 0)
+    {
+      Slot & s = this->slots ()[slot];
+      this->live_size_ -= this->record (s.offset)->chain_size;
+      s.offset = offset;
+    }
+  else
+    {
+      // Keep the index at most 70% full, counting the removed streams.
+      if ((this->used_slots_ + 1) * 10 > this->index_header ()->capacity * 7)
+        {
+          if (this->rehash_index () != 0)
+            return -1;
+          this->find (name, length, hash, free);
+        }
+      Slot & s = this->slots ()[free];
+      if (s.offset == free_slot)
+        ++this->used_slots_;
+      ++this->stream_count_;
+      s.hash = hash;
+      s.offset = offset;
+    }
+  this->live_size_ += this->record (offset)->chain_size;
+  return 0;
+}
+
+int
+TAO::Storable_MappedFileStore::rehash_index ()
+{
+  File_Header const * header = this->index_header ();
+  ACE_UINT64 const capacity = header->capacity;
+  ACE_UINT64 const log_end = header->log_end;
+
+  ACE_Array_Base<Slot> streams (ACE_Utils::truncate_cast<size_t> (this->stream_count_));
+  size_t count = 0;
+  for (ACE_UINT64 i = 0; i < capacity; ++i)
+    {
+      Slot const & s = this->slots ()[i];
+      if (s.offset != free_slot && s.offset != removed_slot && count < streams.size ())
+        streams[count++] = s;
+    }
+
+  // Half full once rehashed.
+  ACE_UINT64 new_capacity = initial_capacity;
+  while ((count + 1) * 2 > new_capacity)
+    new_capacity *= 2;
+
+  if (this->create_index (new_capacity, log_end) != 0)
+    return -1;
+
+  Slot * slots = this->slots ();
+  ACE_UINT64 const mask = new_capacity - 1;
+  for (size_t j = 0; j < count; ++j)
+    {
+      ACE_UINT64 i = streams[j].hash & mask;
+      while (slots[i].offset != free_slot)
+        i = (i + 1) & mask;
+      slots[i] = streams[j];
+    }
+  this->used_slots_ = count;
+  ACE_OS::memcpy (this->index_header ()->magic, index_magic, sizeof index_magic);
+  return 0;
+}
+
+size_t
+TAO::Storable_MappedFileStore::fill_record (char * buffer,
+                                            Record_Type type,
+                                            const char * name,
+                                            size_t name_length,
+                                            const char * data,
+                                            size_t length,
+                                            ACE_UINT64 previous,
+                                            ACE_UINT64 chain_size,
+                                            ACE_UINT64 time)
+{
+  size_t const size = record_size (name_length, length);
+  Record_Header * header = reinterpret_cast<Record_Header *> (buffer);
+  header->magic = record_magic;
+  header->type = static_cast<ACE_UINT16> (type);
+  header->name_length = static_cast<ACE_UINT16> (name_length);
+  header->data_length = static_cast<ACE_UINT32> (length);
+  header->crc = 0;
+  header->previous = previous;
+  header->time = time;
+  header->chain_size = chain_size + size;
+
+  char * payload = buffer + sizeof (Record_Header);
+  ACE_OS::memcpy (payload, name, name_length);
+  if (length > 0)
+    ACE_OS::memcpy (payload + name_length, data, length);
+  ACE_OS::memset (payload + name_length + length, 0,
+                  size - sizeof (Record_Header) - name_length - length);
+  header->crc = record_crc (header);
+  return size;
+}
+
+ACE_UINT64
+TAO::Storable_MappedFileStore::log_append (Record_Type type,
+                                           const ACE_CString & name,
+                                           const char * data,
+                                           size_t length,
+                                           ACE_UINT64 previous,
+                                           ACE_UINT64 chain_size)
+{
+  if (name.length () > 0xffff || length > 0xffffffff)
+    return 0;
+
+  size_t const size = record_size (name.length (), length);
+  if (this->log_end_ + size > this->log_.size ())
+    {
+      size_t new_size = this->log_.size () * 2;
+      while (this->log_end_ + size > new_size)
+        new_size *= 2;
+      if (this->map (this->log_, new_size) != 0)
+        return 0;
+    }
+
+  ACE_UINT64 const offset = this->log_end_;
+  fill_record (reinterpret_cast<char *> (this->record (offset)),
+               type, name.c_str (), name.length (), data, length,
+               previous, chain_size, ACE_OS::gettimeofday ().sec ());
+  this->log_end_ += size;
+  return offset;
+}
+
+int
+TAO::Storable_MappedFileStore::write_i (Record_Type type,
+                                        const ACE_CString & name,
+                                        const char * data,
+                                        size_t length)
+{
+  ACE_UINT64 const previous = this->head (name);
+  ACE_UINT64 chain_size = 0;
+  if (type == RT_Append)
+    {
+      if (previous == 0)
+        type = RT_Data;
+      else
+        chain_size = this->record (previous)->chain_size;
+    }
+
+  ACE_UINT64 const offset =
+    this->log_append (type, name, data, length, previous, chain_size);
+  if (offset == 0 || this->set_head (name.c_str (), name.length (), offset) != 0)
+    return -1;
+
+  this->check_compaction ();
+  return 0;
+}
+
+void
+TAO::Storable_MappedFileStore::content (ACE_UINT64 offset, ACE_CString & data) const
+{
+  // Walk back to the record with the whole data, then append the data
+  // of the records in the order they were written.
+  size_t count = 1;
+  size_t length = this->record (offset)->data_length;
+  for (ACE_UINT64 o = offset; this->record (o)->type == RT_Append; ++count)
+    {
+      o = this->record (o)->previous;
+      length += this->record (o)->data_length;
+    }
+
+  ACE_Array_Base<ACE_UINT64> chain (count);
+  for (size_t i = count; i > 0; --i)
+    {
+      chain[i - 1] = offset;
+      offset = this->record (offset)->previous;
+    }
+
+  data.fast_resize (length);
+  for (size_t i = 0; i < count; ++i)
+    {
+      Record_Header const * header = this->record (chain[i]);
+      data.append (this->record_name (header) + header->name_length,
+                   header->data_length);
+    }
+}
+
+int
+TAO::Storable_MappedFileStore::check_compaction ()
+{
+  if (this->log_end_ < compaction_threshold
+      || this->live_size_ * 2 >= this->log_end_)
+    return 0;
+
+  if (TAO_debug_level > 0)
+    {
+      TAOLIB_DEBUG ((LM_DEBUG,
+                     ACE_TEXT ("TAO (%P|%t) Storable_MappedFileStore::check_compaction ")
+                     ACE_TEXT ("compacting %Q bytes of log into %Q\n"),
+                     this->log_end_, this->live_size_));
+    }
+
+  // Write the content of each stream as a single record in a new log,
+  // which then replaces the log.
+  ACE_CString const new_name = this->file_name ("log.new");
+  ACE_HANDLE const handle =
+    ACE_OS::open (ACE_TEXT_CHAR_TO_TCHAR (new_name.c_str ()),
+                  O_RDWR | O_CREAT | O_TRUNC, 0666);
+  if (handle == ACE_INVALID_HANDLE)
+    TAOLIB_ERROR_RETURN ((LM_ERROR,
+                          ACE_TEXT ("(%P|%t) Storable_MappedFileStore::check_compaction ")
+                          ACE_TEXT ("Cannot open file %C: %p\n"),
+                          new_name.c_str (), ACE_TEXT ("ACE_OS::open")),
+                         -1);
+
+  File_Header header;
+  ACE_OS::memset (&header, 0, sizeof header);
+  ACE_OS::memcpy (header.magic, log_magic, sizeof log_magic);
+  header.generation = this->log_header ()->generation + 1;
+  bool ok = ACE::write_n (handle, &header, sizeof header) == sizeof header;
+
+  ACE_UINT64 const capacity = this->index_header ()->capacity;
+  ACE_Array_Base<char> buffer;
+  ACE_CString data;
+  for (ACE_UINT64 i = 0; ok && i < capacity; ++i)
+    {
+      ACE_UINT64 const offset = this->slots ()[i].offset;
+      if (offset == free_slot || offset == removed_slot)
+        continue;
+      Record_Header const * last = this->record (offset);
+      this->content (offset, data);
+      size_t const size = record_size (last->name_length, data.length ());
+      if (buffer.size () < size)
+        buffer.size (size);
+      fill_record (&buffer[0], RT_Data,
+                   this->record_name (last), last->name_length,
+                   data.fast_rep (), data.length (), 0, 0, last->time);
+      ok = ACE::write_n (handle, &buffer[0], size) == static_cast<ssize_t> (size);
+    }
+  ok = ok && ACE_OS::fsync (handle) == 0;
+  ACE_OS::close (handle);
+
+  ACE_CString const log_name = this->file_name ("log");
+  if (!ok
+      || ACE_OS::rename (ACE_TEXT_CHAR_TO_TCHAR (new_name.c_str ()),
+                         ACE_TEXT_CHAR_TO_TCHAR (log_name.c_str ())) != 0)
+    {
+      ACE_OS::unlink (ACE_TEXT_CHAR_TO_TCHAR (new_name.c_str ()));
+      TAOLIB_ERROR_RETURN ((LM_ERROR,
+                            ACE_TEXT ("(%P|%t) Storable_MappedFileStore::check_compaction ")
+                            ACE_TEXT ("Cannot write file %C: %p\n"),
+                            new_name.c_str (), ACE_TEXT ("write")),
+                           -1);
+    }
+
+  // The index is rebuilt from the new log; it would also be if this
+  // process stopped before, as the generations of the log and of the
+  // index no longer match.
+  this->log_.close ();
+  if (this->log_.open (ACE_TEXT_CHAR_TO_TCHAR (log_name.c_str ())) != 0
+      || this->map (this->log_,
+                    ACE_Utils::truncate_cast<size_t> (
+                      ACE_OS::filesize (this->log_.handle ()))) != 0
+      || this->rebuild_index () != 0)
+    {
+      this->open_ = false;
+      TAOLIB_ERROR_RETURN ((LM_ERROR,
+                            ACE_TEXT ("(%P|%t) Storable_MappedFileStore::check_compaction ")
+                            ACE_TEXT ("Cannot reopen file %C\n"),
+                            log_name.c_str ()),
+                           -1);
+    }
+  return 0;
+}
+
+bool
+TAO::Storable_MappedFileStore::exists (const ACE_CString & name)
+{
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, guard, this->mutex_, false);
+  if (!this->open_ && this->open_i () != 0)
+    return false;
+  return this->head (name) != 0;
+}
+
+int
+TAO::Storable_MappedFileStore::read (const ACE_CString & name,
+                                     ACE_CString & data,
+                                     time_t & changed)
+{
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, guard, this->mutex_, -1);
+  if (!this->open_ && this->open_i () != 0)
+    return -1;
+  ACE_UINT64 const offset = this->head (name);
+  if (offset == 0)
+    return -1;
+  this->content (offset, data);
+  changed = static_cast<time_t> (this->record (offset)->time);
+  return 0;
+}
+
+int
+TAO::Storable_MappedFileStore::last_changed (const ACE_CString & name,
+                                             time_t & changed)
+{
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, guard, this->mutex_, -1);
+  if (!this->open_ && this->open_i () != 0)
+    return -1;
+  ACE_UINT64 const offset = this->head (name);
+  if (offset == 0)
+    return -1;
+  changed = static_cast<time_t> (this->record (offset)->time);
+  return 0;
+}
+
+int
+TAO::Storable_MappedFileStore::write (const ACE_CString & name,
+                                      const char * data,
+                                      size_t length)
+{
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, guard, this->mutex_, -1);
+  if (!this->open_ && this->open_i () != 0)
+    return -1;
+  return this->write_i (RT_Data, name, data, length);
+}
+
+int
+TAO::Storable_MappedFileStore::append (const ACE_CString & name,
+                                       const char * data,
+                                       size_t length)
+{
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, guard, this->mutex_, -1);
+  if (!this->open_ && this->open_i () != 0)
+    return -1;
+  return this->write_i (RT_Append, name, data, length);
+}
+
+int
+TAO::Storable_MappedFileStore::remove (const ACE_CString & name)
+{
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, guard, this->mutex_, -1);
+  if (!this->open_ && this->open_i () != 0)
+    return -1;
+  ACE_UINT64 const previous = this->head (name);
+  if (previous == 0)
+    return 0;
+  ACE_UINT64 const offset =
+    this->log_append (RT_Remove, name, 0, 0, previous, 0);
+  if (offset == 0 || this->apply (offset) != 0)
+    return -1;
+  this->check_compaction ();
+  return 0;
+}
+
+int
+TAO::Storable_MappedFileStore::restore (const ACE_CString & name)
+{
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, guard, this->mutex_, -1);
+  if (!this->open_ && this->open_i () != 0)
+    return -1;
+  ACE_UINT64 offset = this->head (name);
+  if (offset == 0)
+    return -1;
+  while (this->record (offset)->type == RT_Append)
+    offset = this->record (offset)->previous;
+
+  // The previous content is gone once the log is compacted.
+  ACE_UINT64 const previous = this->record (offset)->previous;
+  if (previous == 0)
+    return -1;
+  ACE_CString data;
+  this->content (previous, data);
+  return this->write_i (RT_Data, name, data.fast_rep (), data.length ());
+}
+
+int
+TAO::Storable_MappedFileStore::sync ()
+{
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, guard, this->mutex_, -1);
+  if (!this->open_)
+    return 0;
+  return this->sync_i ();
+}
+
+int
+TAO::Storable_MappedFileStore::sync_i ()
+{
+  // The log first, then the index that refers to it, and only then the
+  // end of the log that the index covers.
+  if (this->log_.sync (ACE_Utils::truncate_cast<size_t> (this->log_end_)) != 0
+      || this->index_.sync () != 0)
+    return -1;
+  this->index_header ()->log_end = this->log_end_;
+  return this->index_.sync (sizeof (File_Header));
+}
+
+//------------------------------------------------
+
+TAO::Storable_MappedFileStream::Storable_MappedFileStream (Storable_MappedFileStore & store,
+                                                           const ACE_CString & file,
+                                                           const char * mode,
+                                                           bool use_backup)
+  : Storable_Base (use_backup, false)
+  , store_ (store)
+  , file_ (file)
+  , mode_ (mode)
+  , writable_ (ACE_OS::strchr (mode, 'w') != 0)
+  , append_ (ACE_OS::strchr (mode, 'a') != 0)
+  , loaded_ (false)
+  , truncate_ (false)
+  , dirty_ (false)
+  , pos_ (0)
+{
+}
+
+TAO::Storable_MappedFileStream::~Storable_MappedFileStream ()
+{
+  this->commit ();
+}
+
+void
+TAO::Storable_MappedFileStream::do_remove ()
+{
+  this->store_.remove (this->file_);
+}
+
+int
+TAO::Storable_MappedFileStream::exists ()
+{
+  return this->store_.exists (this->file_);
+}
+
+int
+TAO::Storable_MappedFileStream::open ()
+{
+  if (this->store_.open () != 0)
+    return -1;
+
+  // As for a file, the stream must exist unless it is to be created.
+  bool const exists = this->store_.exists (this->file_);
+  bool const create = ACE_OS::strchr (this->mode_.c_str (), 'c') != 0;
+  if (!exists && !create)
+    {
+      if (TAO_debug_level > 0)
+        {
+          TAOLIB_ERROR ((LM_ERROR,
+                         ACE_TEXT ("(%P|%t) Storable_MappedFileStream::open ")
+                         ACE_TEXT ("%C does not exist\n"),
+                         this->file_.c_str ()));
+        }
+      return -1;
+    }
+
+  this->data_.clear ();
+  this->tail_.clear ();
+  this->pos_ = 0;
+  this->loaded_ = false;
+  this->truncate_ = this->writable_ && !this->append_;
+  this->dirty_ = !exists;
+  return 0;
+}
+
+int
+TAO::Storable_MappedFileStream::close ()
+{
+  return this->commit ();
+}
+
+int
+TAO::Storable_MappedFileStream::flock (int, int, int)
+{
+  return 0;
+}
+
+int
+TAO::Storable_MappedFileStream::funlock (int, int, int)
+{
+  return 0;
+}
+
+time_t
+TAO::Storable_MappedFileStream::last_changed (void)
+{
+  time_t changed = 0;
+  if (this->store_.last_changed (this->file_, changed) != 0)
+    {
+      TAOLIB_ERROR ((LM_ERROR,
+                     ACE_TEXT ("TAO (%P|%t) - ")
+                     ACE_TEXT ("Storable_MappedFileStream::last_changed, ")
+                     ACE_TEXT ("Error getting information for %C\n"),
+                     this->file_.c_str ()));
+      throw Storable_Exception (this->file_);
+    }
+  return changed;
+}
+
+void
+TAO::Storable_MappedFileStream::rewind (void)
+{
+  this->pos_ = 0;
+}
+
+bool
+TAO::Storable_MappedFileStream::flush (void)
+{
+  return this->commit () != 0;
+}
+
+int
+TAO::Storable_MappedFileStream::sync (void)
+{
+  if (this->commit () != 0 || this->store_.sync () != 0)
+    return EOF;
+  return 0;
+}
+
+void
+TAO::Storable_MappedFileStream::load ()
+{
+  if (this->loaded_)
+    return;
+  time_t changed = 0;
+  if (this->store_.read (this->file_, this->data_, changed) != 0)
+    this->data_.clear ();
+  this->loaded_ = true;
+}
+
+int
+TAO::Storable_MappedFileStream::commit ()
+{
+  if (!this->dirty_)
+    return 0;
+  this->dirty_ = false;
+
+  int result = 0;
+  if (this->append_)
+    {
+      result = this->store_.append (this->file_,
+                                    this->tail_.fast_rep (),
+                                    this->tail_.length ());
+      this->tail_.clear ();
+      this->loaded_ = false;
+    }
+  else
+    {
+      result = this->store_.write (this->file_,
+                                   this->data_.fast_rep (),
+                                   this->data_.length ());
+    }
+
+  if (result != 0)
+    {
+      TAOLIB_ERROR ((LM_ERROR,
+                     ACE_TEXT ("TAO (%P|%t) - ")
+                     ACE_TEXT ("Storable_MappedFileStream::commit, ")
+                     ACE_TEXT ("Cannot write %C\n"),
+                     this->file_.c_str ()));
+    }
+  return result;
+}
+
+void
+TAO::Storable_MappedFileStream::put (const char * bytes, size_t size)
+{
+  if (!this->writable_)
+    this->throw_on_write_error (badbit);
+
+  this->dirty_ = true;
+  if (this->append_)
+    {
+      this->tail_.append (bytes, size);
+      return;
+    }
+
+  if (this->truncate_)
+    {
+      this->data_.clear ();
+      this->pos_ = 0;
+      this->loaded_ = true;
+      this->truncate_ = false;
+    }
+
+  // Overwrite what follows the position, and extend the content with
+  // the rest.
+  size_t const length = this->data_.length ();
+  size_t const overlap =
+    this->pos_ < length ? ace_min (size, length - this->pos_) : 0;
+  for (size_t i = 0; i < overlap; ++i)
+    this->data_[this->pos_ + i] = bytes[i];
+  this->data_.append (bytes + overlap, size - overlap);
+  this->pos_ += size;
+}
+
+bool
+TAO::Storable_MappedFileStream::get (char * bytes, size_t size)
+{
+  this->load ();
+  if (this->pos_ + size > this->data_.length ())
+    return false;
+  ACE_OS::memcpy (bytes, this->data_.fast_rep () + this->pos_, size);
+  this->pos_ += size;
+  return true;
+}
+
+template <typename T> void
+TAO::Storable_MappedFileStream::put_integer (T i)
+{
+  ACE_UINT64 value = static_cast<ACE_UINT64> (i);
+  char bytes[sizeof (T)];
+  for (size_t n = sizeof (T); n > 0; --n)
+    {
+      bytes[n - 1] = static_cast<char> (value & 0xff);
+      value >>= 8;
+    }
+  this->put (bytes, sizeof bytes);
+}
+
+template <typename T> void
+TAO::Storable_MappedFileStream::get_integer (T & i)
+{
+  unsigned char bytes[sizeof (T)];
+  if (!this->get (reinterpret_cast<char *> (bytes), sizeof bytes))
+    this->throw_on_read_error (eofbit);
+  ACE_UINT64 value = 0;
+  for (size_t n = 0; n < sizeof (T); ++n)
+    value = (value << 8) | bytes[n];
+  i = static_cast<T> (value);
+}
+
+TAO::Storable_Base &
+TAO::Storable_MappedFileStream::operator << (const ACE_CString& str)
+{
+  this->put_integer (static_cast<ACE_UINT32> (str.length ()));
+  this->put (str.c_str (), str.length ());
+  return *this;
+}
+
+TAO::Storable_Base &
+TAO::Storable_MappedFileStream::operator >> (ACE_CString& str)
+{
+  ACE_UINT32 length = 0;
+  this->get_integer (length);
+  this->load ();
+  if (length > this->data_.length () - this->pos_)
+    this->throw_on_read_error (badbit);
+  str.set (this->data_.fast_rep () + this->pos_, length, true);
+  this->pos_ += length;
+  return *this;
+}
+
+TAO::Storable_Base &
+TAO::Storable_MappedFileStream::operator << (ACE_UINT32 i)
+{
+  this->put_integer (i);
+  return *this;
+}
+
+TAO::Storable_Base &
+TAO::Storable_MappedFileStream::operator >> (ACE_UINT32 &i)
+{
+  this->get_integer (i);
+  return *this;
+}
+
+TAO::Storable_Base &
+TAO::Storable_MappedFileStream::operator << (ACE_UINT64 i)
+{
+  this->put_integer (i);
+  return *this;
+}
+
+TAO::Storable_Base &
+TAO::Storable_MappedFileStream::operator >> (ACE_UINT64 &i)
+{
+  this->get_integer (i);
+  return *this;
+}
+
+TAO::Storable_Base &
+TAO::Storable_MappedFileStream::operator << (ACE_INT32 i)
+{
+  this->put_integer (i);
+  return *this;
+}
+
+TAO::Storable_Base &
+TAO::Storable_MappedFileStream::operator >> (ACE_INT32 &i)
+{
+  this->get_integer (i);
+  return *this;
+}
+
+TAO::Storable_Base &
+TAO::Storable_MappedFileStream::operator << (ACE_INT64 i)
+{
+  this->put_integer (i);
+  return *this;
+}
+
+TAO::Storable_Base &
+TAO::Storable_MappedFileStream::operator >> (ACE_INT64 &i)
+{
+  this->get_integer (i);
+  return *this;
+}
+
+TAO::Storable_Base &
+TAO::Storable_MappedFileStream::operator << (const TAO_OutputCDR & cdr)
+{
+  unsigned int const length =
+    ACE_Utils::truncate_cast<unsigned int> (cdr.total_length ());
+  *this << length;
+  for (const ACE_Message_Block *i = cdr.begin (); i != 0; i = i->cont ())
+    {
+      this->write (i->length (), i->rd_ptr ());
+    }
+  return *this;
+}
+
+size_t
+TAO::Storable_MappedFileStream::write (size_t size, const char * bytes)
+{
+  this->put (bytes, size);
+  return 1;
+}
+
+size_t
+TAO::Storable_MappedFileStream::read (size_t size, char * bytes)
+{
+  return this->get (bytes, size) ? 1 : 0;
+}
+
+int
+TAO::Storable_MappedFileStream::create_backup ()
+{
+  return 0;
+}
+
+void
+TAO::Storable_MappedFileStream::remove_backup ()
+{
+}
+
+int
+TAO::Storable_MappedFileStream::restore_backup ()
+{
+  if (this->store_.restore (this->file_) != 0)
+    return -1;
+
+  this->data_.clear ();
+  this->tail_.clear ();
+  this->pos_ = 0;
+  this->loaded_ = false;
+  this->truncate_ = false;
+  this->dirty_ = false;
+  this->clear ();
+  return 0;
+}
+
+void
+TAO::Storable_MappedFileStream::throw_on_read_error (Storable_State state)
+{
+  this->setstate (state);
+
+  if (!this->good ())
+    {
+      throw Storable_Read_Exception (this->rdstate (), this->file_);
+    }
+}
+
+void
+TAO::Storable_MappedFileStream::throw_on_write_error (Storable_State state)
+{
+  this->setstate (state);
+
+  if (!this->good ())
+    {
+      throw Storable_Write_Exception (this->rdstate (), this->file_);
+    }
+}
+
+//------------------------------------------------
+
+TAO::Storable_MappedFileFactory::Storable_MappedFileFactory (const ACE_CString & directory,
+                                                             bool use_backup)
+  : Storable_Factory ()
+  , directory_ (directory)
+  , use_backup_ (use_backup)
+  , store_ (directory)
+{
+}
+
+TAO::Storable_MappedFileFactory::~Storable_MappedFileFactory ()
+{
+}
+
+const ACE_CString &
+TAO::Storable_MappedFileFactory::get_directory () const
+{
+  return directory_;
+}
+
+TAO::Storable_Base *
+TAO::Storable_MappedFileFactory::create_stream (const ACE_CString & file,
+                                                const char * mode,
+                                                bool )
+{
+  TAO::Storable_Base *stream = 0;
+  ACE_NEW_RETURN (stream,
+                  TAO::Storable_MappedFileStream (this->store_,
+                                                  file,
+                                                  mode,
+                                                  this->use_backup_),
+                  0);
+  return stream;
+}
+
+bool
+TAO::Storable_MappedFileFactory::append_supported (void) const
+{
+  return true;
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
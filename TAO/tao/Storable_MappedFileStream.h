@@ -0,0 +1,393 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ * @file  Storable_MappedFileStream.h
+ *
+ * A Storable_Factory whose streams are kept in a log-structured store
+ * mapped in memory, with a hash index of the streams.
+ */
+//=============================================================================
+
+#ifndef STORABLE_MAPPEDFILESTREAM_H
+#define STORABLE_MAPPEDFILESTREAM_H
+
+#include /**/ "ace/pre.h"
+#include "ace/config-lite.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+#pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "tao/Storable_Base.h"
+#include "tao/Storable_Factory.h"
+#include "ace/Mem_Map.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/Thread_Mutex.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace TAO
+{
+
+  /**
+   * @brief The store of the streams of a Storable_MappedFileFactory.
+   *
+   * The store is a log of records, mapped in memory, and a hash index
+   * of the last record of each stream, also mapped in memory.  A stream
+   * is a record with its whole content, followed by the records that
+   * appended to that content, each linked to the previous one by its
+   * offset in the log.  Writing a stream appends one record to the log
+   * and updates one slot of the index; finding a stream is a lookup in
+   * the index.
+   *
+   * sync () flushes the log, and then the index, to the disk.  The index
+   * records how much of the log it covers: when the store is opened,
+   * the records that follow are replayed into the index, and the index
+   * is rebuilt from the whole log if it does not match the log.  A
+   * truncated or corrupt record ends the log.  Once most of the log is
+   * made of records that were replaced, the live records are copied
+   * into a new log (compaction).
+   *
+   * The store belongs to one process at a time; it is locked when it is
+   * opened.
+   */
+  class TAO_Export Storable_MappedFileStore
+  {
+  public:
+
+    /// @param directory Directory that contains the files of the store.
+    /// The directory is assumed to already exist.
+    Storable_MappedFileStore (const ACE_CString & directory);
+
+    ~Storable_MappedFileStore ();
+
+    /// Lock and map the files of the store, creating them if needed.
+    /// Does nothing if the store is already open.
+    int open ();
+
+    /// Flush and unmap the files of the store.
+    void close ();
+
+    /// Does stream @a name exist?
+    bool exists (const ACE_CString & name);
+
+    /// Get the content of stream @a name and the time it was written.
+    /// Returns -1 if the stream does not exist.
+    int read (const ACE_CString & name, ACE_CString & data, time_t & changed);
+
+    /// Get the time stream @a name was written.  Returns -1 if the
+    /// stream does not exist.
+    int last_changed (const ACE_CString & name, time_t & changed);
+
+    /// Replace the content of stream @a name, creating it if needed.
+    int write (const ACE_CString & name, const char * data, size_t length);
+
+    /// Append to the content of stream @a name, creating it if needed.
+    int append (const ACE_CString & name, const char * data, size_t length);
+
+    /// Remove stream @a name.
+    int remove (const ACE_CString & name);
+
+    /// Make the content that stream @a name had before its last write
+    /// its content again.  Returns -1 if there is no such content.
+    int restore (const ACE_CString & name);
+
+    /// Flush the log and the index to the disk.
+    int sync ();
+
+  private:
+
+    enum Record_Type
+    {
+      RT_Data = 1,
+      RT_Append = 2,
+      RT_Remove = 3
+    };
+
+    /// The header of a record of the log, followed by the name of the
+    /// stream and the data, padded to a multiple of 8 bytes.
+    struct Record_Header
+    {
+      ACE_UINT32 magic;
+      ACE_UINT16 type;
+      ACE_UINT16 name_length;
+      ACE_UINT32 data_length;
+      /// CRC of the header (with a zero crc) and of the name and data.
+      ACE_UINT32 crc;
+      /// Offset of the previous record of the stream: the record that
+      /// this one appends to, or the last record of the previous
+      /// content for RT_Data.  0 if there is none.
+      ACE_UINT64 previous;
+      ACE_UINT64 time;
+      /// Size of the records that make up the content of the stream,
+      /// up to and including this one.
+      ACE_UINT64 chain_size;
+    };
+
+    struct File_Header
+    {
+      char magic[8];
+      /// Changed each time the log is created or compacted, so that an
+      /// index is never used with a log it was not built from.
+      ACE_UINT64 generation;
+      /// Index only: number of slots, a power of 2.
+      ACE_UINT64 capacity;
+      /// Index only: offset in the log up to which the index is known
+      /// to be on the disk.
+      ACE_UINT64 log_end;
+      ACE_UINT64 reserved[4];
+    };
+
+    /// A slot of the index.  An offset of 0 is a free slot and an
+    /// offset of 1 a slot whose stream was removed.
+    struct Slot
+    {
+      ACE_UINT64 hash;
+      ACE_UINT64 offset;
+    };
+
+    int open_i ();
+    int sync_i ();
+
+    /// Map @a map with @a length bytes of its file.
+    int map (ACE_Mem_Map & map, size_t length);
+
+    File_Header * log_header () const;
+    File_Header * index_header () const;
+    Slot * slots () const;
+    Record_Header * record (ACE_UINT64 offset) const;
+    const char * record_name (const Record_Header * header) const;
+
+    static size_t record_size (size_t name_length, size_t data_length);
+    static ACE_UINT32 record_crc (const Record_Header * header);
+
+    /// Write a record into @a buffer; returns its size.
+    static size_t fill_record (char * buffer,
+                               Record_Type type,
+                               const char * name,
+                               size_t name_length,
+                               const char * data,
+                               size_t length,
+                               ACE_UINT64 previous,
+                               ACE_UINT64 chain_size,
+                               ACE_UINT64 time);
+
+    /// Size of a valid record at @a offset, or 0.
+    size_t valid_record (ACE_UINT64 offset) const;
+
+    /// Create an empty index of @a capacity slots that covers the log up
+    /// to @a log_end.  Its magic is set by the caller, once it is filled.
+    int create_index (ACE_UINT64 capacity, ACE_UINT64 log_end);
+
+    /// Make the index the index of all the records of the log.
+    int rebuild_index ();
+
+    /// Add the records at and after @a offset to the index, and set
+    /// log_end_ after the last valid one.
+    int replay (ACE_UINT64 offset);
+
+    /// Update the index with the record at @a offset.
+    int apply (ACE_UINT64 offset);
+
+    /// The slot of stream @a name, or -1.  @a free is set to the slot
+    /// where it would be inserted.
+    ssize_t find (const char * name, size_t length, ACE_UINT64 hash,
+                  size_t & free) const;
+
+    /// The offset of the last record of stream @a name, or 0.
+    ACE_UINT64 head (const ACE_CString & name) const;
+
+    /// Make @a offset the last record of stream @a name.
+    int set_head (const char * name, size_t length, ACE_UINT64 offset);
+
+    /// Rebuild the index with enough slots for twice its streams.
+    int rehash_index ();
+
+    /// Append a record to the log; returns its offset, or 0.
+    /// @a chain_size is the size of the records it follows.
+    ACE_UINT64 log_append (Record_Type type,
+                           const ACE_CString & name,
+                           const char * data,
+                           size_t length,
+                           ACE_UINT64 previous,
+                           ACE_UINT64 chain_size);
+
+    /// Append @a data and @a length as a new record of stream @a name.
+    int write_i (Record_Type type, const ACE_CString & name,
+                 const char * data, size_t length);
+
+    /// Get the content of the stream whose last record is at @a offset.
+    void content (ACE_UINT64 offset, ACE_CString & data) const;
+
+    /// Compact the log if most of it is no longer used.
+    int check_compaction ();
+
+    ACE_CString file_name (const char * suffix) const;
+
+    ACE_CString directory_;
+    bool open_;
+    ACE_OS::ace_flock_t lock_;
+    ACE_Mem_Map log_;
+    ACE_Mem_Map index_;
+
+    /// Offset after the last record of the log.
+    ACE_UINT64 log_end_;
+    /// Total size of the records that make up the streams.
+    ACE_UINT64 live_size_;
+    /// Number of slots that are not free, and of streams.
+    ACE_UINT64 used_slots_;
+    ACE_UINT64 stream_count_;
+
+    TAO_SYNCH_MUTEX mutex_;
+  };
+
+  /**
+   * @brief A Storable_Base whose content is kept in a
+   * Storable_MappedFileStore.
+   *
+   * The stream works on a copy of its content, read from the store the
+   * first time it is needed, and writes it back to the store when it is
+   * flushed, synchronized or closed.  Opened with a mode that contains
+   * 'a', what is written is appended to the content of the stream
+   * without reading it.  Otherwise, the first write discards the
+   * content as "w" does for a file.
+   */
+  class TAO_Export Storable_MappedFileStream : public Storable_Base
+  {
+  public:
+
+    Storable_MappedFileStream (Storable_MappedFileStore & store,
+                               const ACE_CString & file,
+                               const char * mode,
+                               bool use_backup = Storable_Base::use_backup_default);
+
+    virtual ~Storable_MappedFileStream ();
+
+    /// Check if the stream exists in the store
+    virtual int exists ();
+
+    virtual int open ();
+
+    virtual int close ();
+
+    /// The store is locked by the process, the stream does not need to
+    /// be.
+    virtual int flock (int whence, int start, int len);
+
+    virtual int funlock (int whence, int start, int len);
+
+    /// Returns the last time the stream was written to the store
+    virtual time_t last_changed (void);
+
+    virtual void rewind (void);
+
+    virtual bool flush (void);
+
+    /// Force write of storable data to storage.
+    /// Returns 0 on success, otherwise EOF
+    virtual int sync (void);
+
+    virtual Storable_Base& operator << (const ACE_CString&);
+    virtual Storable_Base& operator >> (ACE_CString&);
+    virtual Storable_Base& operator << (ACE_UINT32 );
+    virtual Storable_Base& operator >> (ACE_UINT32 &);
+    virtual Storable_Base& operator << (ACE_UINT64 );
+    virtual Storable_Base& operator >> (ACE_UINT64 &);
+    virtual Storable_Base& operator << (ACE_INT32 );
+    virtual Storable_Base& operator >> (ACE_INT32 &);
+    virtual Storable_Base& operator << (ACE_INT64 );
+    virtual Storable_Base& operator >> (ACE_INT64 &);
+
+    virtual Storable_Base& operator << (const TAO_OutputCDR & cdr);
+
+    virtual size_t write (size_t size, const char * bytes);
+
+    virtual size_t read (size_t size, char * bytes);
+
+    /// The store keeps the previous content of the stream until the
+    /// log is compacted: restore it.
+    virtual int restore_backup ();
+
+  protected:
+
+    virtual void do_remove ();
+
+    virtual void remove_backup ();
+
+    virtual int create_backup ();
+
+  private:
+
+    /// Throw a Storable_Read_Exception if the state
+    /// is not good due to a read error.
+    void throw_on_read_error (Storable_State state);
+
+    /// Throw a Storable_Write_Exception if the state
+    /// is not good due to a write error.
+    void throw_on_write_error (Storable_State state);
+
+    /// Read the content of the stream from the store, if not done yet.
+    void load ();
+
+    /// Write what changed to the store.
+    int commit ();
+
+    void put (const char * bytes, size_t size);
+    bool get (char * bytes, size_t size);
+
+    template <typename T> void put_integer (T i);
+    template <typename T> void get_integer (T & i);
+
+    Storable_MappedFileStore & store_;
+    ACE_CString file_;
+    ACE_CString mode_;
+    bool writable_;
+    bool append_;
+
+    bool loaded_;
+    bool truncate_;
+    bool dirty_;
+
+    /// The content of the stream.
+    ACE_CString data_;
+    size_t pos_;
+    /// What is appended to the content, in the 'a' mode.
+    ACE_CString tail_;
+  };
+
+  class TAO_Export Storable_MappedFileFactory : public Storable_Factory
+  {
+  public:
+
+    /// @param directory Directory to contain the files of the store.
+    /// The directory is assumed to already exist.
+    Storable_MappedFileFactory (const ACE_CString & directory,
+                                bool use_backup = Storable_Base::use_backup_default);
+
+    ~Storable_MappedFileFactory ();
+
+    const ACE_CString & get_directory () const;
+
+    // Factory Methods
+
+    /// Create a stream of the store
+    virtual Storable_Base *create_stream (const ACE_CString & file,
+                                          const char * mode,
+                                          bool = false);
+
+    /// The streams can be opened with the 'a' mode.
+    virtual bool append_supported (void) const;
+
+  private:
+    ACE_CString directory_;
+    bool use_backup_;
+    Storable_MappedFileStore store_;
+  };
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#include /**/ "ace/post.h"
+
+#endif /* STORABLE_MAPPEDFILESTREAM_H */
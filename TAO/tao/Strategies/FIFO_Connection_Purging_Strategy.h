@@ -14,6 +14,8 @@
 
 #include "tao/Strategies/strategies_export.h"
 #include "tao/Connection_Purging_Strategy.h"
+#include "tao/orbconf.h"
+#include "ace/Atomic_Op.h"
 
 #if !defined (ACE_LACKS_PRAGMA_ONCE)
 # pragma once
@@ -45,8 +47,10 @@ public:
   virtual void update_item (TAO_Transport& transport);
 
 private:
-  /// The ordering information for each transport in the cache
-  unsigned long order_;
+  /// The ordering information for each transport in the cache.
+  /// Updated with just the lock of one shard of a sharded cache
+  /// held, so it must be atomic.
+  ACE_Atomic_Op<TAO_SYNCH_MUTEX, unsigned long> order_;
 };
 
 TAO_END_VERSIONED_NAMESPACE_DECL
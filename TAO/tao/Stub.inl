@@ -369,6 +369,18 @@ TAO_Stub::optimize_collocation_objects (void) const
 ACE_INLINE TAO::Transport_Queueing_Strategy *
 TAO_Stub::transport_queueing_strategy (void)
 {
+  // A TAO::Request_Batch in this thread holds the requests back,
+  // whatever the policies say.  The TSS resources are only looked up
+  // while the ORB has batches.
+  if (this->orb_core_->has_request_batches ())
+    {
+      TAO::Transport_Queueing_Strategy * const batch =
+        this->orb_core_->get_tss_resources ()->request_batch_;
+
+      if (batch != 0)
+        return batch;
+    }
+
 #if (TAO_HAS_BUFFERING_CONSTRAINT_POLICY == 1)
 
   bool has_synchronization;
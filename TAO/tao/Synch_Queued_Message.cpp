@@ -114,12 +114,12 @@ TAO_Synch_Queued_Message::clone (ACE_Allocator *alloc)
 {
   TAO_Synch_Queued_Message *qm = 0;
 
-  // Clone the message block.
-  // NOTE: We wantedly do the cloning from <current_block_> instead of
-  // starting from <contents_> since we dont want to clone blocks that
+  // Copy the message block.
+  // NOTE: We wantedly do the copying from <current_block_> instead of
+  // starting from <contents_> since we dont want to copy blocks that
   // have already been sent on the wire. Waste of memory and
   // associated copying.
-  ACE_Message_Block *mb = this->current_block_->clone ();
+  ACE_Message_Block *mb = this->copy_chain (this->current_block_);
 
   if (alloc)
     {
@@ -182,12 +182,12 @@ TAO_Synch_Queued_Message::copy_if_necessary (const ACE_Message_Block* chain)
           if (mb == this->current_block_)
             {
               // Once we have found the message block, we need to
-              // clone the current block so that if another thread comes
+              // copy the current block so that if another thread comes
               // in and calls reset() on the output stream (via another
               // invocation on the transport), it doesn't cause the rest
               // of our message to be released.
               this->own_contents_ = true;
-              this->contents_ = this->current_block_->clone ();
+              this->contents_ = this->copy_chain (this->current_block_);
               this->current_block_ = this->contents_;
               break;
             }
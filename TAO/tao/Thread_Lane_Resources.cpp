@@ -40,7 +40,8 @@ TAO_Thread_Lane_Resources::TAO_Thread_Lane_Resources (
             orb_core.resource_factory ()->create_purging_strategy (),
             orb_core.resource_factory ()->cache_maximum (),
             orb_core.resource_factory ()->locked_transport_cache (),
-            orb_core.orbid ()));
+            orb_core.orbid (),
+            orb_core.resource_factory ()->cache_shards ()));
 }
 
 TAO_Thread_Lane_Resources::~TAO_Thread_Lane_Resources (void)
@@ -126,6 +126,7 @@ TAO_Transport::TAO_Transport (CORBA::ULong tag,
   : tag_ (tag)
   , orb_core_ (orb_core)
   , cache_map_entry_ (0)
+  , cache_map_shard_ (0)
   , tms_ (0)
   , ws_ (0)
   , bidirectional_flag_ (-1)
@@ -564,7 +565,7 @@ TAO_Transport::purge_entry (void)
                   this->id (), this->cache_map_entry_));
     }
 
-  return this->transport_cache_manager ().purge_entry (this->cache_map_entry_);
+  return this->transport_cache_manager ().purge_entry (this);
 }
 
 bool
@@ -583,13 +584,13 @@ TAO_Transport::make_idle (void)
                   this->id ()));
     }
 
-  return this->transport_cache_manager ().make_idle (this->cache_map_entry_);
+  return this->transport_cache_manager ().make_idle (this);
 }
 
 int
 TAO_Transport::update_transport (void)
 {
-  return this->transport_cache_manager ().update_entry (this->cache_map_entry_);
+  return this->transport_cache_manager ().update_entry (this);
 }
 
 /**
@@ -993,6 +994,66 @@ TAO_Transport::handle_timeout (const ACE_Time_Value & /* current_time */,
   return 0;
 }
 
+int
+TAO_Transport::flush_queue (ACE_Time_Value *max_wait_time)
+{
+  TAO_Flushing_Strategy *flushing_strategy =
+    this->orb_core ()->flushing_strategy ();
+
+  {
+    ACE_GUARD_RETURN (ACE_Lock, ace_mon, *this->handler_lock_, -1);
+
+    if (this->queue_is_empty_i ())
+      {
+        return 0;
+      }
+
+    // Until the connection is complete the queue is sent when it
+    // completes.
+    if (this->is_connected_)
+      {
+        TAO::Transport::Drain_Constraints dc (
+          max_wait_time, this->using_blocking_io_for_asynch_messages ());
+
+        Drain_Result const n = this->drain_queue_i (dc);
+
+        if (n == DR_ERROR)
+          {
+            if (TAO_debug_level > 0)
+              {
+                TAOLIB_ERROR ((LM_ERROR,
+                   ACE_TEXT ("TAO (%P|%t) - Transport[%d]::flush_queue, ")
+                   ACE_TEXT ("error while sending queued messages - %m\n"),
+                   this->id ()));
+              }
+            return -1;
+          }
+
+        if (this->queue_is_empty_i ())
+          {
+            return 0;
+          }
+      }
+
+    if (TAO_debug_level > 6)
+      {
+        TAOLIB_DEBUG ((LM_DEBUG,
+           ACE_TEXT ("TAO (%P|%t) - Transport[%d]::flush_queue, ")
+           ACE_TEXT ("waiting for the rest of the queue to be sent\n"),
+           this->id ()));
+      }
+
+    // The blocking strategy sends the queue in flush_transport() below,
+    // so there is no need to check for MUST_FLUSH.
+    if (flushing_strategy->schedule_output (this) == -1)
+      {
+        return -1;
+      }
+  }
+
+  return flushing_strategy->flush_transport (this, max_wait_time);
+}
+
 TAO_Transport::Drain_Result
 TAO_Transport::drain_queue (TAO::Transport::Drain_Constraints const & dc)
 {
@@ -1585,6 +1646,11 @@ TAO_Transport::send_asynchronous_message_i (TAO_Stub *stub,
       return -1;
     }
 
+  if (queue_strategy)
+    {
+      queue_strategy->message_queued (this);
+    }
+
   if (TAO_debug_level > 6)
     {
       TAOLIB_DEBUG ((LM_DEBUG,
@@ -1965,7 +2031,10 @@ TAO_Transport::handle_input_missing_data (TAO_Resume_Handle &rh,
   // invocation context to get meaningful information.
   this->recv_buffer_size_ = recv_size;
 
-  // Read the message into the existing message block on heap
+  // Read the message into the existing message block on heap.  All
+  // the missing data is asked for, so when less arrives the socket is
+  // drained, and the rest is read on the next input event instead of
+  // holding this thread on this connection.
   ssize_t const n = this->recv (q_data->msg_block ()->wr_ptr(),
                                 recv_size,
                                 max_wait_time);
@@ -1986,18 +2055,20 @@ TAO_Transport::handle_input_missing_data (TAO_Resume_Handle &rh,
   q_data->msg_block ()->wr_ptr(n);
   q_data->missing_data (q_data->missing_data () - n);
 
-  if (q_data->missing_data () == 0)
+  if (q_data->missing_data () > 0)
     {
-      // paranoid check
-      if (this->incoming_message_stack_.pop (q_data) == -1)
-        {
-          return -1;
-        }
+      return 0;
+    }
 
-      if (this->consolidate_process_message (q_data, rh) == -1)
-        {
-          return -1;
-        }
+  // paranoid check
+  if (this->incoming_message_stack_.pop (q_data) == -1)
+    {
+      return -1;
+    }
+
+  if (this->consolidate_process_message (q_data, rh) == -1)
+    {
+      return -1;
     }
 
   return 0;
@@ -2185,6 +2256,10 @@ TAO_Transport::handle_input_parse_data  (TAO_Resume_Handle &rh,
   // invocation context to get meaningful information.
   this->recv_buffer_size_ = recv_size;
 
+  // The rest of a large message may be read right after this, both
+  // reads together must not wait longer than the caller allows.
+  TAO::ORB_Countdown_Time countdown (max_wait_time);
+
   // Read the message into the message block that we have created on
   // the stack.
   ssize_t const n = this->recv (message_block.wr_ptr (),
@@ -2205,6 +2280,9 @@ TAO_Transport::handle_input_parse_data  (TAO_Resume_Handle &rh,
       return ACE_Utils::truncate_cast<int> (n);
     }
 
+  // Less data than asked for means the socket is drained.
+  bool const drained = static_cast<size_t> (n) < recv_size;
+
   if (this->partial_message_ != 0 && this->partial_message_->length () > 0)
     {
       this->partial_message_->reset ();
@@ -2372,6 +2450,21 @@ TAO_Transport::handle_input_parse_data  (TAO_Resume_Handle &rh,
               message_block.rd_ptr (message_block.length());
 
               this->incoming_message_stack_.push (nqd);
+
+              if (drained)
+                {
+                  return 0;
+                }
+
+              // The header told the size of the message and the block
+              // holds it all now, so read the rest of it straight into
+              // the block rather than waiting for the next input event,
+              // for the time still left.
+              countdown.update ();
+
+              return this->handle_input_missing_data (rh,
+                                                      max_wait_time,
+                                                      nqd);
             }
         }
       else
@@ -2782,8 +2875,7 @@ TAO_Transport::pre_close (void)
   // of the is_connected_ flag, so that during cache lookups the cache
   // manager doesn't need to be burdened by the lock in is_connected().
   this->is_connected_ = false;
-  this->transport_cache_manager ().mark_connected (this->cache_map_entry_,
-                                                   false);
+  this->transport_cache_manager ().mark_connected (this, false);
   this->purge_entry ();
   {
     ACE_MT (ACE_GUARD (ACE_Lock, guard, *this->handler_lock_));
@@ -2857,12 +2949,11 @@ TAO_Transport::post_open (size_t id)
                             ACE_TEXT (", cache_map_entry_ is 0\n"), this->id_));
     }
 
-  this->transport_cache_manager ().mark_connected (this->cache_map_entry_,
-                                                   true);
+  this->transport_cache_manager ().mark_connected (this, true);
 
   // update transport cache to make this entry available
   this->transport_cache_manager ().set_entry_state (
-    this->cache_map_entry_,
+    this,
     TAO::ENTRY_IDLE_AND_PURGABLE);
 
   return true;
@@ -405,6 +405,16 @@ public:
   /// Get the Cache Map entry
   TAO::Transport_Cache_Manager::HASH_MAP_ENTRY *cache_map_entry (void);
 
+  /// Forget the Cache Map entry.  Called by the cache, with the shard
+  /// of the entry locked, when it purges the entry.
+  void clear_cache_map_entry (void);
+
+  /// Set the index of the cache shard that has our entry
+  void cache_map_shard (unsigned long shard);
+
+  /// Get the index of the cache shard that has our entry
+  unsigned long cache_map_shard (void) const;
+
   /// Set and Get the identifier for this transport instance.
   /**
    * If not set, this will return an integer representation of
@@ -432,6 +442,19 @@ public:
    */
   bool queue_is_empty (void);
 
+  /// Send the messages queued in the transport
+  /**
+   * Writes as many of the queued messages as the socket takes in a
+   * single writev(), and waits for the flushing strategy to send the
+   * rest.  Used by TAO::Request_Batch to send the requests it held
+   * back.
+   *
+   * @param max_wait_time Maximum time to wait for the queue to drain,
+   *        0 to wait as long as it takes.
+   * @return 0 on success, -1 on error.
+   */
+  int flush_queue (ACE_Time_Value *max_wait_time = 0);
+
   /// Register with the reactor via the wait strategy
   bool register_if_necessary (void);
 
@@ -1098,6 +1121,10 @@ protected:
   /// convenience. We cannot just change things around.
   TAO::Transport_Cache_Manager::HASH_MAP_ENTRY *cache_map_entry_;
 
+  /// The shard of the cache our entry is in.  Read without the lock
+  /// of the shard, to find out which one to lock.
+  ACE_Atomic_Op<TAO_SYNCH_MUTEX, unsigned long> cache_map_shard_;
+
   /// Strategy to decide whether multiple requests can be sent over the
   /// same connection or the connection is exclusive for a request.
   TAO_Transport_Mux_Strategy *tms_;
@@ -71,6 +71,24 @@ TAO_Transport::cache_map_entry (
   this->cache_map_entry_ = entry;
 }
 
+ACE_INLINE void
+TAO_Transport::clear_cache_map_entry (void)
+{
+  this->cache_map_entry_ = 0;
+}
+
+ACE_INLINE void
+TAO_Transport::cache_map_shard (unsigned long shard)
+{
+  this->cache_map_shard_ = shard;
+}
+
+ACE_INLINE unsigned long
+TAO_Transport::cache_map_shard (void) const
+{
+  return this->cache_map_shard_.value ();
+}
+
 ACE_INLINE unsigned long
 TAO_Transport::purging_order (void) const
 {
@@ -29,26 +29,37 @@ namespace TAO
     purging_strategy* purging_strategy,
     size_t cache_maximum,
     bool locked,
-    const char *orbid)
+    const char *orbid,
+    size_t shards)
     : percent_ (percent)
     , purging_strategy_ (purging_strategy)
-    , cache_map_ (cache_maximum)
-    , cache_lock_ (0)
+    , shards_ (0)
+    , shard_count_ (shards == 0 ? 1 : shards)
+    , current_size_ (0)
     , cache_maximum_ (cache_maximum)
 #if defined (TAO_HAS_MONITOR_POINTS) && (TAO_HAS_MONITOR_POINTS == 1)
     , purge_monitor_ (0)
     , size_monitor_ (0)
 #endif /* TAO_HAS_MONITOR_POINTS==1 */
   {
-    if (locked)
-      {
-        ACE_NEW (this->cache_lock_,
-                 ACE_Lock_Adapter <TAO_SYNCH_MUTEX> (this->cache_map_mutex_));
-      }
-    else
+    ACE_NEW (this->shards_, Cache_Shard[this->shard_count_]);
+
+    for (size_t i = 0; i < this->shard_count_; ++i)
       {
-        ACE_NEW (this->cache_lock_,
-                 ACE_Lock_Adapter<ACE_SYNCH_NULL_MUTEX>);
+        Cache_Shard &shard = this->shards_[i];
+
+        shard.cache_map_.open (cache_maximum / this->shard_count_ + 1);
+
+        if (locked)
+          {
+            ACE_NEW (shard.cache_lock_,
+                     ACE_Lock_Adapter <TAO_SYNCH_MUTEX> (shard.cache_map_mutex_));
+          }
+        else
+          {
+            ACE_NEW (shard.cache_lock_,
+                     ACE_Lock_Adapter<ACE_SYNCH_NULL_MUTEX>);
+          }
       }
 
 #if defined (TAO_HAS_MONITOR_POINTS) && (TAO_HAS_MONITOR_POINTS == 1)
@@ -76,8 +87,14 @@ namespace TAO
   template <typename TT, typename TRDT, typename PSTRAT>
   Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::~Transport_Cache_Manager_T (void)
   {
-    delete this->cache_lock_;
-    this->cache_lock_ = 0;
+    if (this->shards_ != 0)
+      {
+        for (size_t i = 0; i < this->shard_count_; ++i)
+          delete this->shards_[i].cache_lock_;
+
+        delete [] this->shards_;
+        this->shards_ = 0;
+      }
 
     delete this->purging_strategy_;
     this->purging_strategy_ = 0;
@@ -92,10 +109,11 @@ namespace TAO
 
   template <typename TT, typename TRDT, typename PSTRAT>
   void
-  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::set_entry_state (HASH_MAP_ENTRY *&entry,
+  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::set_entry_state (transport_type *transport,
                                             TAO::Cache_Entries_State state)
   {
-    ACE_MT (ACE_GUARD (ACE_Lock, guard, *this->cache_lock_));
+    Shard_Guard guard (*this, transport);
+    HASH_MAP_ENTRY *entry = transport->cache_map_entry ();
     if (entry != 0)
       {
         entry->item ().recycle_state (state);
@@ -109,6 +127,7 @@ namespace TAO
   template <typename TT, typename TRDT, typename PSTRAT>
   int
   Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::bind_i (
+    Cache_Shard &shard,
     Cache_ExtId &ext_id,
     Cache_IntId &int_id)
   {
@@ -130,75 +149,84 @@ namespace TAO
     this->purging_strategy_->update_item (*(int_id.transport ()));
     int retval = 0;
     bool more_to_do = true;
+
+    // Reserve room for the new entry.  The size is shared by all the
+    // shards, so it can't be checked with just our shard locked.
+    bool added = false;
+    if (++this->current_size_ > cache_maximum_)
+      {
+        retval = -1;
+        if (TAO_debug_level > 0)
+          {
+            TAOLIB_ERROR ((LM_ERROR,
+              ACE_TEXT("TAO (%P|%t) - Transport_Cache_Manager_T::bind_i, ")
+              ACE_TEXT("ERROR: unable to bind transport, cache is full\n")));
+          }
+        more_to_do = false;
+      }
+
     while (more_to_do)
       {
-        if (this->cache_map_.current_size () >= cache_maximum_)
+        retval = shard.cache_map_.bind (ext_id, int_id, entry);
+        if (retval == 0)
           {
-            retval = -1;
-            if (TAO_debug_level > 0)
-              {
-                TAOLIB_ERROR ((LM_ERROR,
-                  ACE_TEXT("TAO (%P|%t) - Transport_Cache_Manager_T::bind_i, ")
-                  ACE_TEXT("ERROR: unable to bind transport, cache is full\n")));
-              }
+            // The entry has been added to cache successfully
+            // Add the shard and the cache_map_entry to the transport
+            int_id.transport ()->cache_map_shard (
+              static_cast<unsigned long> (&shard - this->shards_));
+            int_id.transport ()->cache_map_entry (entry);
+            added = true;
             more_to_do = false;
           }
-        else
+        else if (retval == 1)
           {
-            retval = this->cache_map_.bind (ext_id, int_id, entry);
-            if (retval == 0)
+            if (entry->item ().transport () == int_id.transport ())
               {
-                // The entry has been added to cache successfully
-                // Add the cache_map_entry to the transport
-                int_id.transport ()->cache_map_entry (entry);
+                // update the cache status
+                // we are already holding the lock, do not call set_entry_state
+                entry->item ().recycle_state (int_id.recycle_state ());
+                if (TAO_debug_level > 9 &&
+                    entry->item ().is_connected () != int_id.is_connected ())
+                  TAOLIB_DEBUG ((LM_DEBUG,
+                              ACE_TEXT ("TAO (%P|%t) - Transport_Cache_")
+                              ACE_TEXT ("Manager::bind_i, Updating existing ")
+                              ACE_TEXT ("entry sets is_connected to %C\n"),
+                              (int_id.is_connected () ? "true" : "false")));
+
+                entry->item ().is_connected (int_id.is_connected ());
+                retval = 0;
                 more_to_do = false;
               }
-            else if (retval == 1)
-              {
-                if (entry->item ().transport () == int_id.transport ())
-                  {
-                    // update the cache status
-                    // we are already holding the lock, do not call set_entry_state
-                    entry->item ().recycle_state (int_id.recycle_state ());
-                    if (TAO_debug_level > 9 &&
-                        entry->item ().is_connected () != int_id.is_connected ())
-                      TAOLIB_DEBUG ((LM_DEBUG,
-                                  ACE_TEXT ("TAO (%P|%t) - Transport_Cache_")
-                                  ACE_TEXT ("Manager::bind_i, Updating existing ")
-                                  ACE_TEXT ("entry sets is_connected to %C\n"),
-                                  (int_id.is_connected () ? "true" : "false")));
-
-                    entry->item ().is_connected (int_id.is_connected ());
-                    retval = 0;
-                    more_to_do = false;
-                  }
-                else
+            else
+            {
+              ext_id.index (ext_id.index () + 1);
+              if (TAO_debug_level > 8)
                 {
-                  ext_id.index (ext_id.index () + 1);
-                  if (TAO_debug_level > 8)
-                    {
-                      TAOLIB_DEBUG ((LM_DEBUG,
-                        ACE_TEXT ("TAO (%P|%t) - Transport_Cache_Manager_T::bind_i, ")
-                        ACE_TEXT ("Unable to bind Transport[%d] @ hash:index{%d:%d}. ")
-                        ACE_TEXT ("Trying with a new index\n"),
-                        int_id.transport ()->id (),
-                        ext_id.hash (),
-                        ext_id.index ()));
-                    }
+                  TAOLIB_DEBUG ((LM_DEBUG,
+                    ACE_TEXT ("TAO (%P|%t) - Transport_Cache_Manager_T::bind_i, ")
+                    ACE_TEXT ("Unable to bind Transport[%d] @ hash:index{%d:%d}. ")
+                    ACE_TEXT ("Trying with a new index\n"),
+                    int_id.transport ()->id (),
+                    ext_id.hash (),
+                    ext_id.index ()));
                 }
-              }
-            else
+            }
+          }
+        else
+          {
+            if (TAO_debug_level > 0)
               {
-                if (TAO_debug_level > 0)
-                  {
-                    TAOLIB_ERROR ((LM_ERROR,
-                      ACE_TEXT("TAO (%P|%t) - Transport_Cache_Manager_T::bind_i, ")
-                      ACE_TEXT("ERROR: unable to bind transport\n")));
-                  }
-                more_to_do = false;
+                TAOLIB_ERROR ((LM_ERROR,
+                  ACE_TEXT("TAO (%P|%t) - Transport_Cache_Manager_T::bind_i, ")
+                  ACE_TEXT("ERROR: unable to bind transport\n")));
               }
+            more_to_do = false;
           }
       }
+
+    if (!added)
+      --this->current_size_;
+
     if (retval == 0)
       {
         if (TAO_debug_level > 4)
@@ -273,6 +301,7 @@ namespace TAO
   template <typename TT, typename TRDT, typename PSTRAT>
   typename Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::Find_Result
   Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::find_i (
+    Cache_Shard &shard,
     transport_descriptor_type *prop,
     transport_type *&transport,
     size_t &busy_count)
@@ -292,7 +321,7 @@ namespace TAO
     while (found != CACHE_FOUND_AVAILABLE && cache_status == 0)
       {
         entry = 0;
-        cache_status = this->cache_map_.find (key, entry);
+        cache_status = shard.cache_map_.find (key, entry);
         if (cache_status == 0 && entry)
           {
             if (this->is_entry_available_i (*entry))
@@ -382,12 +411,10 @@ namespace TAO
 
   template <typename TT, typename TRDT, typename PSTRAT>
   int
-  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::update_entry (HASH_MAP_ENTRY *&entry)
+  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::update_entry (transport_type *transport)
   {
-    ACE_MT (ACE_GUARD_RETURN (ACE_Lock,
-                              guard,
-                              *this->cache_lock_, -1));
-
+    Shard_Guard guard (*this, transport);
+    HASH_MAP_ENTRY *entry = transport->cache_map_entry ();
     if (entry == 0)
       return -1;
 
@@ -401,24 +428,29 @@ namespace TAO
   int
   Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::close_i (Connection_Handler_Set &handlers)
   {
-    HASH_MAP_ITER end_iter = this->cache_map_.end ();
-
-    for (HASH_MAP_ITER iter = this->cache_map_.begin ();
-         iter != end_iter;
-         ++iter)
+    for (size_t i = 0; i < this->shard_count_; ++i)
       {
-        // Get the transport to fill its associated connection's handler.
-        (*iter).int_id_.transport ()->provide_handler (handlers);
-
-        // Inform the transport that has a reference to the entry in the
-        // map that we are *gone* now. So, the transport should not use
-        // the reference to the entry that he has, to access us *at any
-        // time*.
-        (*iter).int_id_.transport ()->cache_map_entry (0);
-      }
+        HASH_MAP &cache_map = this->shards_[i].cache_map_;
+        HASH_MAP_ITER end_iter = cache_map.end ();
 
-    // Unbind all the entries in the map
-    this->cache_map_.unbind_all ();
+        for (HASH_MAP_ITER iter = cache_map.begin ();
+             iter != end_iter;
+             ++iter)
+          {
+            // Get the transport to fill its associated connection's handler.
+            (*iter).int_id_.transport ()->provide_handler (handlers);
+
+            // Inform the transport that has a reference to the entry in the
+            // map that we are *gone* now. So, the transport should not use
+            // the reference to the entry that he has, to access us *at any
+            // time*.
+            (*iter).int_id_.transport ()->cache_map_entry (0);
+          }
+
+        // Unbind all the entries in the map
+        this->current_size_ -= static_cast<unsigned long> (cache_map.current_size ());
+        cache_map.unbind_all ();
+      }
 
     return 0;
   }
@@ -428,21 +460,25 @@ namespace TAO
   Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::blockable_client_transports_i (
     Connection_Handler_Set &h)
   {
-    HASH_MAP_ITER end_iter = this->cache_map_.end ();
-
-    for (HASH_MAP_ITER iter = this->cache_map_.begin ();
-         iter != end_iter;
-         ++iter)
+    for (size_t i = 0; i < this->shard_count_; ++i)
       {
-        // Get the transport to fill its associated connection's
-        // handler.
-        bool const retval =
-          (*iter).int_id_.transport ()->provide_blockable_handler (h);
-
-        // Do not mark the entry as closed if we don't have a
-        // blockable handler added
-        if (retval)
-          (*iter).int_id_.recycle_state (ENTRY_CLOSED);
+        HASH_MAP &cache_map = this->shards_[i].cache_map_;
+        HASH_MAP_ITER end_iter = cache_map.end ();
+
+        for (HASH_MAP_ITER iter = cache_map.begin ();
+             iter != end_iter;
+             ++iter)
+          {
+            // Get the transport to fill its associated connection's
+            // handler.
+            bool const retval =
+              (*iter).int_id_.transport ()->provide_blockable_handler (h);
+
+            // Do not mark the entry as closed if we don't have a
+            // blockable handler added
+            if (retval)
+              (*iter).int_id_.recycle_state (ENTRY_CLOSED);
+          }
       }
 
     return true;
@@ -450,10 +486,14 @@ namespace TAO
 
   template <typename TT, typename TRDT, typename PSTRAT>
   int
-  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::purge_entry_i (HASH_MAP_ENTRY *entry)
+  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::purge_entry_i (
+    Cache_Shard &shard,
+    HASH_MAP_ENTRY *entry)
   {
     // Remove the entry from the Map
-    int retval = this->cache_map_.unbind (entry);
+    int retval = shard.cache_map_.unbind (entry);
+    if (retval == 0)
+      --this->current_size_;
 
 #if defined (TAO_HAS_MONITOR_POINTS) && (TAO_HAS_MONITOR_POINTS == 1)
     this->size_monitor_->receive (this->current_size ());
@@ -462,6 +502,22 @@ namespace TAO
     return retval;
   }
 
+  template <typename TT, typename TRDT, typename PSTRAT>
+  void
+  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::acquire_all (void)
+  {
+    for (size_t i = 0; i < this->shard_count_; ++i)
+      this->shards_[i].cache_lock_->acquire ();
+  }
+
+  template <typename TT, typename TRDT, typename PSTRAT>
+  void
+  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::release_all (void)
+  {
+    for (size_t i = this->shard_count_; i > 0; --i)
+      this->shards_[i - 1].cache_lock_->release ();
+  }
+
   template <typename TT, typename TRDT, typename PSTRAT>
   bool
   Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::is_entry_available_i (const HASH_MAP_ENTRY &entry)
@@ -568,7 +624,9 @@ namespace TAO
     transport_set_type transports_to_be_closed;
 
     {
-      ACE_MT (ACE_GUARD_RETURN (ACE_Lock, ace_mon, *this->cache_lock_, 0));
+      // The purging order of all the connections is compared, so
+      // none of the shards may change meanwhile.
+      All_Shards_Guard guard (*this);
 
       DESCRIPTOR_SET sorted_set = 0;
       int const sorted_size = this->fill_set_i (sorted_set);
@@ -734,14 +792,21 @@ namespace TAO
           {
             ACE_NEW_RETURN (sorted_set, HASH_MAP_ENTRY*[current_size], 0);
 
-            HASH_MAP_ITER iter = this->cache_map_.begin ();
-
-            for (int i = 0; i < current_size; ++i)
+            int i = 0;
+            for (size_t s = 0; s < this->shard_count_; ++s)
               {
-                sorted_set[i] = &(*iter);
-                ++iter;
+                HASH_MAP &cache_map = this->shards_[s].cache_map_;
+                HASH_MAP_ITER end_iter = cache_map.end ();
+
+                for (HASH_MAP_ITER iter = cache_map.begin ();
+                     iter != end_iter && i < current_size;
+                     ++iter)
+                  {
+                    sorted_set[i++] = &(*iter);
+                  }
               }
 
+            current_size = i;
             this->sort_set (sorted_set, current_size);
           }
       }
@@ -14,6 +14,7 @@
 #include /**/ "ace/pre.h"
 #include "ace/Null_Mutex.h"
 #include "ace/Thread_Mutex.h"
+#include "ace/Atomic_Op.h"
 
 #if !defined (ACE_LACKS_PRAGMA_ONCE)
 #define  ACE_LACKS_PRAGMA_ONCE
@@ -55,6 +56,17 @@ namespace TAO
    * to have the lock in this class and not in the Hash_Map is that, we
    * do quite a bit of work in this class for which we need a lock.
    *
+   * The cache can be split in a number of shards, each with its own
+   * map and lock.  All the connections to an endpoint are kept in the
+   * same shard, so looking up a connection and returning it to the
+   * cache only lock that shard, and threads invoking on different
+   * servers don't contend for the cache.  Purging and closing the
+   * cache lock all the shards.
+   *
+   * The transports keep the index of the shard they are cached in,
+   * see cache_map_shard(), so the operations on the entry of a
+   * transport lock that shard without looking at the entry, which
+   * another thread may be purging.
    */
   template <typename TT, typename TRDT, typename PSTRAT>
   class Transport_Cache_Manager_T
@@ -94,12 +106,17 @@ namespace TAO
 
     // == Public methods
     /// Constructor
+    /**
+     * @param shards The number of shards to split the cache in, see
+     *        -ORBConnectionCacheShards.
+     */
     Transport_Cache_Manager_T (
       int percent,
       purging_strategy* purging_strategy,
       size_t cache_maximum,
       bool locked,
-      const char *orbid);
+      const char *orbid,
+      size_t shards = 1);
 
     /// Destructor
     ~Transport_Cache_Manager_T (void);
@@ -125,22 +142,22 @@ namespace TAO
     /// Remove entries from the cache depending upon the strategy.
     int purge (void);
 
-    /// Purge the entry from the Cache Map
-    int purge_entry (HASH_MAP_ENTRY *& entry);
+    /// Purge the entry of @a transport from the Cache Map
+    int purge_entry (transport_type *transport);
 
-    /// Mark the entry as connected.
-    void mark_connected (HASH_MAP_ENTRY *& entry, bool state);
+    /// Mark the entry of @a transport as connected.
+    void mark_connected (transport_type *transport, bool state);
 
-    /// Make the entry idle and ready for use.
-    int make_idle (HASH_MAP_ENTRY *&entry);
+    /// Make the entry of @a transport idle and ready for use.
+    int make_idle (transport_type *transport);
 
-    /// Modify the state setting on the provided entry.
-    void set_entry_state (HASH_MAP_ENTRY *&entry,
+    /// Modify the state setting on the entry of @a transport.
+    void set_entry_state (transport_type *transport,
                           TAO::Cache_Entries_State state);
 
-    /// Mark the entry as touched. This call updates the purging
-    /// strategy policy information.
-    int update_entry (HASH_MAP_ENTRY *&entry);
+    /// Mark the entry of @a transport as touched. This call updates
+    /// the purging strategy policy information.
+    int update_entry (transport_type *transport);
 
     /// Close the underlying hash map manager and return any handlers
     /// still registered
@@ -164,10 +181,62 @@ namespace TAO
     /// Return the total size of the cache.
     size_t total_size (void) const;
 
+    /// Return the number of shards of the cache.
+    size_t shard_count (void) const;
+
     /// Return the underlying cache map
+    /**
+     * @note This is the map of the first shard, which only holds all
+     *       the connections if the cache isn't sharded.
+     */
     HASH_MAP &map (void);
 
   private:
+    /// A part of the cache, with its own map and lock.
+    struct Cache_Shard
+    {
+      /// The hash map that has the connections
+      HASH_MAP cache_map_;
+
+      TAO_SYNCH_MUTEX cache_map_mutex_;
+
+      /// The lock that is used by the cache map
+      ACE_Lock *cache_lock_;
+    };
+
+    /// Locks the shard a transport is cached in while it lives.
+    class Shard_Guard
+    {
+    public:
+      Shard_Guard (Transport_Cache_Manager_T &cache,
+                   transport_type *transport);
+      ~Shard_Guard (void);
+
+      /// The locked shard
+      Cache_Shard &shard (void) const;
+
+    private:
+      Cache_Shard *shard_;
+    };
+
+    /// Locks all the shards, in order, while it lives.
+    class All_Shards_Guard
+    {
+    public:
+      explicit All_Shards_Guard (Transport_Cache_Manager_T &cache);
+      ~All_Shards_Guard (void);
+
+    private:
+      Transport_Cache_Manager_T &cache_;
+    };
+
+    /// Return the shard that holds the connections to @a prop.
+    Cache_Shard &shard_for (transport_descriptor_type *prop);
+
+    /// Lock and unlock all the shards, in order.
+    void acquire_all (void);
+    void release_all (void);
+
     /// Lookup entry<key,value> in the cache. Grabs the lock and calls the
     /// implementation function find_i.
     Find_Result find (
@@ -181,7 +250,7 @@ namespace TAO
      * bind succeeds, it adds the Hash_Map_Entry in to the
      * Transport for its reference.
      */
-    int bind_i (Cache_ExtId &ext_id, Cache_IntId &int_id);
+    int bind_i (Cache_Shard &shard, Cache_ExtId &ext_id, Cache_IntId &int_id);
 
     /**
      * Non-locking version and actual implementation of find ()
@@ -190,6 +259,7 @@ namespace TAO
      * get_idle_transport ().
      */
     Find_Result find_i (
+      Cache_Shard &shard,
       transport_descriptor_type *prop,
       transport_type *&transport,
       size_t & busy_count);
@@ -201,7 +271,7 @@ namespace TAO
     int close_i (Connection_Handler_Set &handlers);
 
     /// Purge the entry from the Cache Map
-    int purge_entry_i (HASH_MAP_ENTRY *entry);
+    int purge_entry_i (Cache_Shard &shard, HASH_MAP_ENTRY *entry);
 
   private:
     /**
@@ -243,13 +313,14 @@ namespace TAO
     /// The underlying connection purging strategy
     purging_strategy *purging_strategy_;
 
-    /// The hash map that has the connections
-    HASH_MAP cache_map_;
+    /// The shards that have the connections
+    Cache_Shard *shards_;
 
-    TAO_SYNCH_MUTEX cache_map_mutex_;
+    /// The number of entries in <shards_>
+    size_t const shard_count_;
 
-    /// The lock that is used by the cache map
-    ACE_Lock *cache_lock_;
+    /// Number of connections in all the shards
+    ACE_Atomic_Op<TAO_SYNCH_MUTEX, unsigned long> current_size_;
 
     /// Maximum size of the cache
     size_t cache_maximum_;
@@ -13,11 +13,12 @@ namespace TAO
   {
     // Compose the ExternId & Intid
     Cache_ExtId ext_id (prop);
+    Cache_Shard &shard = this->shard_for (prop);
     int retval = 0;
     {
       ACE_MT (ACE_GUARD_RETURN (ACE_Lock,
                                 guard,
-                                *this->cache_lock_,
+                                *shard.cache_lock_,
                                 -1));
       Cache_IntId int_id (transport);
 
@@ -27,7 +28,7 @@ namespace TAO
       else
         int_id.recycle_state (state);
 
-      retval = this->bind_i (ext_id, int_id);
+      retval = this->bind_i (shard, ext_id, int_id);
     }
 
     return retval;
@@ -35,26 +36,22 @@ namespace TAO
 
   template <typename TT, typename TRDT, typename PSTRAT>
   ACE_INLINE int
-  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::purge_entry (HASH_MAP_ENTRY *&entry)
+  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::purge_entry (transport_type *transport)
   {
     int retval = 0;
 
-    if (entry != 0)
+    Shard_Guard guard (*this, transport);
+    HASH_MAP_ENTRY *entry = transport->cache_map_entry ();
+    if (entry != 0) // in case someone beat us to it
     {
-      HASH_MAP_ENTRY* cached_entry = 0;
-      ACE_MT (ACE_GUARD_RETURN (ACE_Lock, guard, *this->cache_lock_, -1));
-      if (entry != 0) // in case someone beat us to it (entry is reference to transport member)
-      {
-        // Store the entry in a temporary and zero out the reference.
-        // If there is only one reference count for the transport, we will end up causing
-        // it's destruction.  And the transport can not be holding a cache map entry if
-        // that happens.
-        cached_entry = entry;
-        entry = 0;
-
-        // now it's save to really purge the entry
-        retval = this->purge_entry_i (cached_entry);
-      }
+      // Zero out the entry of the transport first.  If there is only one
+      // reference count for the transport, we will end up causing it's
+      // destruction.  And the transport can not be holding a cache map
+      // entry if that happens.
+      transport->clear_cache_map_entry ();
+
+      // now it's save to really purge the entry
+      retval = this->purge_entry_i (guard.shard (), entry);
     }
 
     return retval;
@@ -62,9 +59,10 @@ namespace TAO
 
   template <typename TT, typename TRDT, typename PSTRAT>
   ACE_INLINE void
-  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::mark_connected (HASH_MAP_ENTRY *&entry, bool state)
+  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::mark_connected (transport_type *transport, bool state)
   {
-    ACE_MT (ACE_GUARD (ACE_Lock, guard, *this->cache_lock_));
+    Shard_Guard guard (*this, transport);
+    HASH_MAP_ENTRY *entry = transport->cache_map_entry ();
     if (entry == 0)
       return;
 
@@ -79,10 +77,11 @@ namespace TAO
 
   template <typename TT, typename TRDT, typename PSTRAT>
   ACE_INLINE int
-  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::make_idle (HASH_MAP_ENTRY *&entry)
+  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::make_idle (transport_type *transport)
   {
-    ACE_MT (ACE_GUARD_RETURN (ACE_Lock, guard, *this->cache_lock_, -1));
-    if (entry == 0) // in case someone beat us to it (entry is reference to transport member)
+    Shard_Guard guard (*this, transport);
+    HASH_MAP_ENTRY *entry = transport->cache_map_entry ();
+    if (entry == 0) // in case someone beat us to it
       return -1;
 
     return this->make_idle_i (entry);
@@ -94,12 +93,13 @@ namespace TAO
                                  transport_type *&transport,
                                  size_t &busy_count)
   {
+    Cache_Shard &shard = this->shard_for (prop);
     ACE_MT (ACE_GUARD_RETURN  (ACE_Lock,
                                guard,
-                               *this->cache_lock_,
+                               *shard.cache_lock_,
                                CACHE_FOUND_NONE));
 
-    return this->find_i (prop, transport, busy_count);
+    return this->find_i (shard, prop, transport, busy_count);
   }
 
   template <typename TT, typename TRDT, typename PSTRAT>
@@ -107,18 +107,14 @@ namespace TAO
   Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::
     close (Connection_Handler_Set &handlers)
   {
-    // The cache lock pointer should only be zero if
-    // Transport_Cache_Manager_T::open() was never called.  Note that
-    // only one thread opens the Transport_Cache_Manager_T at any given
-    // time, so it is safe to check for a non-zero lock pointer.
-    if (this->cache_lock_ == 0)
+    // The shards pointer should only be zero if the shards could not
+    // be allocated.  Note that only one thread opens the
+    // Transport_Cache_Manager_T at any given time, so it is safe to
+    // check for a non-zero pointer.
+    if (this->shards_ == 0)
       return -1;
 
-    ACE_MT (ACE_GUARD_RETURN (ACE_Lock,
-                              guard,
-                              *this->cache_lock_,
-                              -1));
-
+    All_Shards_Guard guard (*this);
     return this->close_i (handlers);
   }
 
@@ -127,11 +123,7 @@ namespace TAO
   Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::blockable_client_transports (
     Connection_Handler_Set &handlers)
   {
-    ACE_MT (ACE_GUARD_RETURN (ACE_Lock,
-                              guard,
-                              *this->cache_lock_,
-                              false));
-
+    All_Shards_Guard guard (*this);
     return this->blockable_client_transports_i (handlers);
   }
 
@@ -139,21 +131,94 @@ namespace TAO
   ACE_INLINE size_t
   Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::current_size (void) const
   {
-    return this->cache_map_.current_size ();
+    return this->current_size_.value ();
   }
 
   template <typename TT, typename TRDT, typename PSTRAT>
   ACE_INLINE size_t
   Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::total_size (void) const
   {
-    return this->cache_map_.total_size ();
+    size_t total = 0;
+    for (size_t i = 0; i < this->shard_count_; ++i)
+      total += this->shards_[i].cache_map_.total_size ();
+    return total;
+  }
+
+  template <typename TT, typename TRDT, typename PSTRAT>
+  ACE_INLINE size_t
+  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::shard_count (void) const
+  {
+    return this->shard_count_;
   }
 
   template <typename TT, typename TRDT, typename PSTRAT>
   ACE_INLINE typename Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::HASH_MAP &
   Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::map (void)
   {
-    return this->cache_map_;
+    return this->shards_[0].cache_map_;
+  }
+
+  template <typename TT, typename TRDT, typename PSTRAT>
+  ACE_INLINE typename Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::Cache_Shard &
+  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::shard_for (
+    transport_descriptor_type *prop)
+  {
+    if (this->shard_count_ == 1)
+      return this->shards_[0];
+
+    return this->shards_[prop->hash () % this->shard_count_];
+  }
+
+  template <typename TT, typename TRDT, typename PSTRAT>
+  ACE_INLINE
+  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::Shard_Guard::Shard_Guard (
+    Transport_Cache_Manager_T &cache,
+    transport_type *transport)
+    : shard_ (0)
+  {
+    for (;;)
+      {
+        unsigned long const index = transport->cache_map_shard ();
+        this->shard_ = &cache.shards_[index];
+        this->shard_->cache_lock_->acquire ();
+
+        // The transport moves to another shard when it is cached again
+        // for another endpoint.
+        if (transport->cache_map_shard () == index)
+          break;
+
+        this->shard_->cache_lock_->release ();
+      }
+  }
+
+  template <typename TT, typename TRDT, typename PSTRAT>
+  ACE_INLINE
+  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::Shard_Guard::~Shard_Guard (void)
+  {
+    this->shard_->cache_lock_->release ();
+  }
+
+  template <typename TT, typename TRDT, typename PSTRAT>
+  ACE_INLINE typename Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::Cache_Shard &
+  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::Shard_Guard::shard (void) const
+  {
+    return *this->shard_;
+  }
+
+  template <typename TT, typename TRDT, typename PSTRAT>
+  ACE_INLINE
+  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::All_Shards_Guard::All_Shards_Guard (
+    Transport_Cache_Manager_T &cache)
+    : cache_ (cache)
+  {
+    this->cache_.acquire_all ();
+  }
+
+  template <typename TT, typename TRDT, typename PSTRAT>
+  ACE_INLINE
+  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::All_Shards_Guard::~All_Shards_Guard (void)
+  {
+    this->cache_.release_all ();
   }
 }
 
@@ -14,6 +14,11 @@ namespace TAO
   {
   }
 
+  void
+  Transport_Queueing_Strategy::message_queued (TAO_Transport *)
+  {
+  }
+
 // ****************************************************************
 
   bool
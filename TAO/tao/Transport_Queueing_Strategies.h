@@ -32,6 +32,7 @@ ACE_END_VERSIONED_NAMESPACE_DECL
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
 class TAO_Stub;
+class TAO_Transport;
 
 namespace TAO
 {
@@ -74,6 +75,13 @@ namespace TAO
       const ACE_Time_Value &current_deadline,
       bool &set_timer,
       ACE_Time_Value &interval) const = 0;
+
+    /// A message was queued in @a transport
+    /**
+     * Called after a message this strategy was used for has been
+     * queued instead of sent.  The default does nothing.
+     */
+    virtual void message_queued (TAO_Transport *transport);
   };
 
   /**
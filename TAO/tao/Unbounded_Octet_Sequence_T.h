@@ -44,7 +44,7 @@ public:
   typedef details::generic_sequence<value_type, allocation_traits, element_traits> implementation_type;
   typedef details::range_checking<value_type,true> range;
 
-  inline unbounded_value_sequence<CORBA::Octet>()
+  inline unbounded_value_sequence ()
     : maximum_ (allocation_traits::default_maximum())
     , length_ (0)
     , buffer_ (allocation_traits::default_buffer_allocation())
@@ -58,7 +58,7 @@ public:
     , release_(true)
     , mb_ (0)
   {}
-  inline unbounded_value_sequence<CORBA::Octet>(
+  inline unbounded_value_sequence (
       CORBA::ULong maximum,
       CORBA::ULong length,
       value_type * data,
@@ -69,7 +69,7 @@ public:
       release_ (release),
       mb_ (0)
   {}
-  inline ~unbounded_value_sequence<CORBA::Octet>() {
+  inline ~unbounded_value_sequence () {
     if (mb_)
       ACE_Message_Block::release (mb_);
     if (release_)
@@ -77,8 +77,8 @@ public:
   }
   /// Create a sequence of octets from a single message block (i.e. it
   /// ignores any chaining in the message block).
-  inline unbounded_value_sequence<CORBA::Octet> (CORBA::ULong length,
-                                                 const ACE_Message_Block* mb)
+  inline unbounded_value_sequence (CORBA::ULong length,
+                                   const ACE_Message_Block* mb)
     : maximum_ (length)
     , length_ (length)
     , buffer_ (reinterpret_cast <CORBA::Octet *>(mb->rd_ptr ()))
@@ -250,7 +250,7 @@ public:
     swap (s);
   }
 
-  unbounded_value_sequence<CORBA::Octet> (
+  unbounded_value_sequence (
     const unbounded_value_sequence<CORBA::Octet> &rhs)
     : maximum_ (0)
     , length_ (0)
@@ -1,22 +1,86 @@
 #include "tao/ZIOP/ZIOP_ORBInitializer.h"
 #include "tao/ZIOP/ZIOP_Policy_Validator.h"
 #include "tao/ZIOP/ZIOP.h"
+#include "tao/ZIOP/ZIOP_Stub.h"
+#include "tao/ZIOP/ZIOP_Adaptive_Compression.h"
 #include "tao/ORB_Core.h"
 #include "tao/debug.h"
 #include "tao/ORBInitializer_Registry.h"
 #include "tao/operation_details.h"
 #include "tao/Stub.h"
 #include "tao/Transport.h"
+#include "ace/High_Res_Timer.h"
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
 TAO_ZIOP_Loader::TAO_ZIOP_Loader (void)
   : initialized_ (false)
+#if defined (TAO_HAS_MONITOR_POINTS) && (TAO_HAS_MONITOR_POINTS == 1)
+  , compressed_monitor_ (0)
+  , uncompressed_monitor_ (0)
+  , ratio_monitor_ (0)
+  , time_monitor_ (0)
+#endif /* TAO_HAS_MONITOR_POINTS==1 */
 {
 }
 
 TAO_ZIOP_Loader::~TAO_ZIOP_Loader (void)
 {
+#if defined (TAO_HAS_MONITOR_POINTS) && (TAO_HAS_MONITOR_POINTS == 1)
+  if (this->compressed_monitor_ != 0)
+    {
+      this->compressed_monitor_->remove_from_registry ();
+      this->uncompressed_monitor_->remove_from_registry ();
+      this->ratio_monitor_->remove_from_registry ();
+      this->time_monitor_->remove_from_registry ();
+      this->compressed_monitor_->remove_ref ();
+      this->uncompressed_monitor_->remove_ref ();
+      this->ratio_monitor_->remove_ref ();
+      this->time_monitor_->remove_ref ();
+    }
+#endif /* TAO_HAS_MONITOR_POINTS==1 */
+}
+
+void
+TAO_ZIOP_Loader::add_monitors (void)
+{
+#if defined (TAO_HAS_MONITOR_POINTS) && (TAO_HAS_MONITOR_POINTS == 1)
+  // The loader is shared by all ORBs, and so are the monitors.
+  if (this->compressed_monitor_ != 0)
+    return;
+
+  ACE_NEW (this->compressed_monitor_,
+           ACE::Monitor_Control::Monitor_Base (
+             "ZIOP_Compressed_Messages",
+             ACE::Monitor_Control::Monitor_Control_Types::MC_COUNTER));
+  ACE_NEW (this->uncompressed_monitor_,
+           ACE::Monitor_Control::Monitor_Base (
+             "ZIOP_Uncompressed_Messages",
+             ACE::Monitor_Control::Monitor_Control_Types::MC_COUNTER));
+  ACE_NEW (this->ratio_monitor_,
+           ACE::Monitor_Control::Size_Monitor ("ZIOP_Compression_Ratio"));
+  ACE_NEW (this->time_monitor_,
+           ACE::Monitor_Control::Size_Monitor ("ZIOP_Compression_Time"));
+
+  this->compressed_monitor_->add_to_registry ();
+  this->uncompressed_monitor_->add_to_registry ();
+  this->ratio_monitor_->add_to_registry ();
+  this->time_monitor_->add_to_registry ();
+#endif /* TAO_HAS_MONITOR_POINTS==1 */
+}
+
+void
+TAO_ZIOP_Loader::count_message (bool compressed)
+{
+#if defined (TAO_HAS_MONITOR_POINTS) && (TAO_HAS_MONITOR_POINTS == 1)
+  ACE::Monitor_Control::Monitor_Base *monitor =
+    compressed ? this->compressed_monitor_ : this->uncompressed_monitor_;
+
+  if (monitor != 0)
+    monitor->receive (static_cast<size_t> (1));
+#else
+  ACE_UNUSED_ARG (compressed);
+#endif /* TAO_HAS_MONITOR_POINTS==1 */
 }
 
 int
@@ -114,6 +178,8 @@ TAO_ZIOP_Loader::ziop_compressorid_name (::Compression::CompressorId st)
       case ::Compression::COMPRESSORID_7X: return "7X";
       case ::Compression::COMPRESSORID_XAR: return "XAR";
       case ::Compression::COMPRESSORID_RLE: return "RLE";
+      case ::Compression::COMPRESSORID_ZSTD: return "ZSTD";
+      case ::Compression::COMPRESSORID_LZ4: return "LZ4";
     }
 
   return "Unknown";
@@ -503,7 +569,9 @@ TAO_ZIOP_Loader::complete_compression (Compression::Compressor_ptr compressor,
                                        CORBA::ULong low_value,
                                        Compression::CompressionRatio min_ratio,
                                        CORBA::ULong original_data_length,
-                                       Compression::CompressorId compressor_id)
+                                       Compression::CompressorId compressor_id,
+                                       Compression::CompressionLevel compression_level,
+                                       TAO_ZIOP_Adaptive_Compression *adaptive)
 {
    static const CORBA::ULong
       Compression_Overhead = sizeof (compressor_id)
@@ -520,8 +588,35 @@ TAO_ZIOP_Loader::complete_compression (Compression::Compressor_ptr compressor,
       CORBA::OctetSeq input (original_data_length, &mb);
       output.length (original_data_length);
 
-      if (!this->compress (compressor, input, output))
+      ACE_High_Res_Timer timer;
+      timer.start ();
+      bool const compressed = this->compress (compressor, input, output);
+      timer.stop ();
+
+      if (compressed)
+        {
+          ACE_hrtime_t nsecs = 0;
+          timer.elapsed_time (nsecs);
+
+          if (adaptive != 0)
+            {
+              adaptive->sample (compressor_id,
+                                compression_level,
+                                original_data_length,
+                                output.length () + Compression_Overhead,
+                                nsecs);
+            }
+
+#if defined (TAO_HAS_MONITOR_POINTS) && (TAO_HAS_MONITOR_POINTS == 1)
+          if (this->time_monitor_ != 0)
+            this->time_monitor_->receive (static_cast<size_t> (nsecs));
+#endif /* TAO_HAS_MONITOR_POINTS==1 */
+        }
+
+      if (!compressed)
         {
+          this->count_message (false);
+
           if (TAO_debug_level > 0)
             {
               TAOLIB_DEBUG ((LM_ERROR,
@@ -544,6 +639,7 @@ TAO_ZIOP_Loader::complete_compression (Compression::Compressor_ptr compressor,
                           static_cast <unsigned int> (original_data_length)
                         ));
             }
+          this->count_message (false);
           return false;
         }
       else if (this->check_min_ratio (
@@ -564,6 +660,13 @@ TAO_ZIOP_Loader::complete_compression (Compression::Compressor_ptr compressor,
           mb.data_block ()->base ()[TAO_GIOP_MESSAGE_SIZE_OFFSET + begin] =
             static_cast<char> (cdr.length() - TAO_GIOP_MESSAGE_HEADER_LEN);
 
+          this->count_message (true);
+#if defined (TAO_HAS_MONITOR_POINTS) && (TAO_HAS_MONITOR_POINTS == 1)
+          if (this->ratio_monitor_ != 0)
+            this->ratio_monitor_->receive (
+              static_cast<size_t> (100.0 * output.length () / input.length ()));
+#endif /* TAO_HAS_MONITOR_POINTS==1 */
+
           if (TAO_debug_level > 9)
             {
                this->dump_msg ("after compression", reinterpret_cast <u_char *>(mb.rd_ptr ()),
@@ -572,7 +675,10 @@ TAO_ZIOP_Loader::complete_compression (Compression::Compressor_ptr compressor,
             }
         }
       else
-        return false;
+        {
+          this->count_message (false);
+          return false;
+        }
     }
     else if (TAO_debug_level > 8)
       {
@@ -595,7 +701,8 @@ TAO_ZIOP_Loader::compress_data (TAO_OutputCDR &cdr,
                CORBA::ULong low_value,
                ::Compression::CompressionRatio min_ratio,
                ::Compression::CompressorId compressor_id,
-               ::Compression::CompressionLevel compression_level)
+               ::Compression::CompressionLevel compression_level,
+               TAO_ZIOP_Adaptive_Compression *adaptive)
 {
   bool compressed = true;
 
@@ -617,14 +724,24 @@ TAO_ZIOP_Loader::compress_data (TAO_OutputCDR &cdr,
       Compression::CompressionManager_var manager =
         Compression::CompressionManager::_narrow (compression_manager);
 
-      if (!CORBA::is_nil(manager.in ()))
+      // Messages below the low value don't count for the adaptive
+      // compression, they aren't compressed anyway.
+      if (adaptive != 0
+          && low_value <= original_data_length
+          && !adaptive->select (compressor_id, compression_level))
+        {
+          this->count_message (false);
+          compressed = false;
+        }
+      else if (!CORBA::is_nil(manager.in ()))
         {
           Compression::Compressor_var compressor =
             manager->get_compressor (compressor_id, compression_level);
 
           compressed = complete_compression (compressor.in (), cdr, *current,
                 initial_rd_ptr, low_value, min_ratio,
-                original_data_length, compressor_id);
+                original_data_length, compressor_id,
+                compression_level, adaptive);
         }
     }
   // set back read pointer in case no compression was done...
@@ -663,9 +780,25 @@ TAO_ZIOP_Loader::marshal_data (TAO_OutputCDR &cdr, TAO_Stub &stub)
       Compression::CompressionRatio min_ratio =
         this->compression_minratio_value (policy_min_ratio.in ());
 
+      TAO_ZIOP_Adaptive_Compression *adaptive = 0;
+#if defined (TAO_HAS_CORBA_MESSAGING) && TAO_HAS_CORBA_MESSAGING != 0
+      TAO_ORB_Parameters const *params = stub.orb_core ()->orb_params ();
+      TAO_ZIOP_Stub *ziop_stub = dynamic_cast<TAO_ZIOP_Stub *> (&stub);
+      ::Compression::CompressorIdLevelList list;
+
+      if (params->ziop_adaptive ()
+          && ziop_stub != 0
+          && ziop_stub->common_compressors (list))
+        {
+          adaptive = &ziop_stub->adaptive_compression ();
+          adaptive->compressors (list, params->ziop_link_bandwidth ());
+        }
+#endif /* TAO_HAS_CORBA_MESSAGING */
+
       return this->compress_data (cdr, compression_manager.in (),
                                   low_value, min_ratio,
-                                  compressor_id, compression_level);
+                                  compressor_id, compression_level,
+                                  adaptive);
     }
 #else /* TAO_HAS_ZIOP */
   ACE_UNUSED_ARG (cdr);
@@ -26,9 +26,15 @@
 #include "tao/Policy_Validator.h"
 #include "ace/Service_Config.h"
 
+#if defined (TAO_HAS_MONITOR_POINTS) && (TAO_HAS_MONITOR_POINTS == 1)
+#include "ace/Monitor_Base.h"
+#include "ace/Monitor_Size.h"
+#endif /* TAO_HAS_MONITOR_POINTS==1 */
+
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
 class TAO_ServerRequest;
+class TAO_ZIOP_Adaptive_Compression;
 
 /**
  * @class TAO_ZIOP_Loader
@@ -63,11 +69,30 @@ public:
   /// Converts compressor ID to a compressor name.
   static const char * ziop_compressorid_name (::Compression::CompressorId st);
 
+  /// Add the compression monitors to the registry, the first time an
+  /// ORB is initialized with ZIOP.
+  void add_monitors (void);
+
 private:
 
   /// Set to true after init is called.
   bool initialized_;
 
+#if defined (TAO_HAS_MONITOR_POINTS) && (TAO_HAS_MONITOR_POINTS == 1)
+  /// Messages sent compressed and uncompressed by ZIOP.
+  ACE::Monitor_Control::Monitor_Base *compressed_monitor_;
+  ACE::Monitor_Control::Monitor_Base *uncompressed_monitor_;
+
+  /// Size of the compressed messages, in percent of the original.
+  ACE::Monitor_Control::Size_Monitor *ratio_monitor_;
+
+  /// Nanoseconds compressing a message took.
+  ACE::Monitor_Control::Size_Monitor *time_monitor_;
+#endif /* TAO_HAS_MONITOR_POINTS==1 */
+
+  /// Count a message sent compressed or not.
+  void count_message (bool compressed);
+
   /// dump a ZIOP datablock after (de)compression
   void dump_msg (const char *type,  const u_char *ptr,
                 size_t len, size_t original_data_length,
@@ -98,14 +123,17 @@ private:
                              CORBA::ULong low_value,
                              Compression::CompressionRatio min_ratio,
                              CORBA::ULong original_data_length,
-                             Compression::CompressorId compressor_id);
+                             Compression::CompressorId compressor_id,
+                             Compression::CompressionLevel compression_level,
+                             TAO_ZIOP_Adaptive_Compression *adaptive = 0);
 
   bool compress_data (TAO_OutputCDR &cdr,
                       CORBA::Object_ptr compression_manager,
                       CORBA::ULong low_value,
                       ::Compression::CompressionRatio min_ratio,
                       ::Compression::CompressorId compressor_id,
-                      ::Compression::CompressionLevel compression_level);
+                      ::Compression::CompressionLevel compression_level,
+                      TAO_ZIOP_Adaptive_Compression *adaptive = 0);
 
   bool compress (Compression::Compressor_ptr compressor,
                  const ::Compression::Buffer &source,
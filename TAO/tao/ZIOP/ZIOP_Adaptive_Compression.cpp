@@ -0,0 +1,195 @@
+#include "tao/ZIOP/ZIOP_Adaptive_Compression.h"
+#include "tao/debug.h"
+#include "ace/Guard_T.h"
+#include "ace/Min_Max.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+// The weight of a new sample in the averages.
+static const double TAO_ZIOP_SAMPLE_WEIGHT = 0.25;
+
+TAO_ZIOP_Adaptive_Compression::TAO_ZIOP_Adaptive_Compression (void)
+  : link_nsecs_per_byte_ (0.0),
+    messages_ (0),
+    probe_ (0),
+    skipped_ (0),
+    backoff_ (0)
+{
+}
+
+void
+TAO_ZIOP_Adaptive_Compression::compressors (
+  const ::Compression::CompressorIdLevelList &list,
+  CORBA::ULong link_bandwidth)
+{
+  ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, this->lock_);
+
+  this->link_nsecs_per_byte_ =
+    link_bandwidth == 0 ? 0.0 : 1.0e9 / (1024.0 * link_bandwidth);
+
+  bool same = this->candidates_.size () == list.length ();
+  for (CORBA::ULong i = 0; same && i != list.length (); ++i)
+    same = this->candidates_[i].compressor_id == list[i].compressor_id
+      && this->candidates_[i].compression_level == list[i].compression_level;
+
+  if (same)
+    return;
+
+  this->candidates_.resize (list.length ());
+  for (CORBA::ULong i = 0; i != list.length (); ++i)
+    {
+      Candidate &candidate = this->candidates_[i];
+      candidate.compressor_id = list[i].compressor_id;
+      candidate.compression_level = list[i].compression_level;
+      candidate.samples = 0;
+      candidate.ratio = 1.0;
+      candidate.nsecs_per_byte = 0.0;
+    }
+
+  this->probe_ = 0;
+  this->skipped_ = 0;
+  this->backoff_ = 0;
+}
+
+size_t
+TAO_ZIOP_Adaptive_Compression::best (double &cost) const
+{
+  size_t best = 0;
+  cost = 0.0;
+
+  for (size_t i = 0; i != this->candidates_.size (); ++i)
+    {
+      const Candidate &candidate = this->candidates_[i];
+      double const candidate_cost = candidate.nsecs_per_byte
+        + candidate.ratio * this->link_nsecs_per_byte_;
+
+      if (i == 0 || candidate_cost < cost)
+        {
+          best = i;
+          cost = candidate_cost;
+        }
+    }
+
+  return best;
+}
+
+bool
+TAO_ZIOP_Adaptive_Compression::select (
+  ::Compression::CompressorId &compressor_id,
+  ::Compression::CompressionLevel &compression_level)
+{
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, this->lock_, true);
+
+  if (this->candidates_.empty ())
+    return true;
+
+  ++this->messages_;
+
+  size_t chosen = this->candidates_.size ();
+
+  // Every compressor is tried a few times first.
+  for (size_t i = 0; i != this->candidates_.size (); ++i)
+    if (this->candidates_[i].samples < static_cast<CORBA::ULong> (MIN_SAMPLES))
+      {
+        chosen = i;
+        break;
+      }
+
+  if (chosen == this->candidates_.size ())
+    {
+      double cost = 0.0;
+      chosen = this->best (cost);
+
+      if (cost < this->link_nsecs_per_byte_)
+        {
+          this->skipped_ = 0;
+          this->backoff_ = 0;
+
+          // Now and then try another one, the data may have changed.
+          if (this->candidates_.size () > 1
+              && this->messages_ % PROBE_INTERVAL == 0)
+            {
+              this->probe_ = (this->probe_ + 1) % this->candidates_.size ();
+              if (this->probe_ == chosen)
+                this->probe_ = (this->probe_ + 1) % this->candidates_.size ();
+              chosen = this->probe_;
+            }
+        }
+      else if (this->skipped_ < this->backoff_)
+        {
+          // Compressing costs more than it saves.
+          ++this->skipped_;
+
+          if (TAO_debug_level > 8)
+            {
+              TAOLIB_DEBUG ((LM_DEBUG,
+                          ACE_TEXT ("ZIOP (%P|%t) ")
+                          ACE_TEXT ("TAO_ZIOP_Adaptive_Compression::select, ")
+                          ACE_TEXT ("compressing doesn't pay, %u of %u ")
+                          ACE_TEXT ("messages not compressed\n"),
+                          this->skipped_,
+                          this->backoff_));
+            }
+          return false;
+        }
+      else
+        {
+          // Compress this one to see if it pays again.
+          this->skipped_ = 0;
+          this->backoff_ =
+            ace_min (ace_max (2 * this->backoff_,
+                              static_cast<CORBA::ULong> (MIN_BACKOFF)),
+                     static_cast<CORBA::ULong> (MAX_BACKOFF));
+        }
+    }
+
+  compressor_id = this->candidates_[chosen].compressor_id;
+  compression_level = this->candidates_[chosen].compression_level;
+
+  return true;
+}
+
+void
+TAO_ZIOP_Adaptive_Compression::sample (
+  ::Compression::CompressorId compressor_id,
+  ::Compression::CompressionLevel compression_level,
+  CORBA::ULong original_length,
+  CORBA::ULong compressed_length,
+  ACE_hrtime_t nsecs)
+{
+  if (original_length == 0)
+    return;
+
+  double const ratio =
+    static_cast<double> (compressed_length) / original_length;
+  double const nsecs_per_byte =
+    static_cast<double> (nsecs) / original_length;
+
+  ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, this->lock_);
+
+  for (size_t i = 0; i != this->candidates_.size (); ++i)
+    {
+      Candidate &candidate = this->candidates_[i];
+      if (candidate.compressor_id != compressor_id
+          || candidate.compression_level != compression_level)
+        continue;
+
+      if (candidate.samples == 0)
+        {
+          candidate.ratio = ratio;
+          candidate.nsecs_per_byte = nsecs_per_byte;
+        }
+      else
+        {
+          candidate.ratio +=
+            TAO_ZIOP_SAMPLE_WEIGHT * (ratio - candidate.ratio);
+          candidate.nsecs_per_byte +=
+            TAO_ZIOP_SAMPLE_WEIGHT * (nsecs_per_byte - candidate.nsecs_per_byte);
+        }
+
+      ++candidate.samples;
+      break;
+    }
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
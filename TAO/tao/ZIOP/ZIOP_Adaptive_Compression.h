@@ -0,0 +1,130 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    ZIOP_Adaptive_Compression.h
+ *
+ *  Decides per target whether, and with which compressor, ZIOP
+ *  compresses the requests, from what compressing them cost and
+ *  gained so far.
+ */
+//=============================================================================
+
+#ifndef TAO_ZIOP_ADAPTIVE_COMPRESSION_H
+#define TAO_ZIOP_ADAPTIVE_COMPRESSION_H
+
+#include /**/ "ace/pre.h"
+
+#include "tao/ZIOP/ziop_export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "tao/Compression/Compression.h"
+#include "tao/orbconf.h"
+#include "ace/Synch_Traits.h"
+#include "ace/Thread_Mutex.h"
+#include "ace/OS_NS_time.h"
+#include <vector>
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class TAO_ZIOP_Adaptive_Compression
+ *
+ * @brief Chooses how the requests to a target are compressed.
+ *
+ * For each compressor (and level) both sides have, it keeps the
+ * average ratio and the time compressing took per byte.  A message
+ * then costs the compression time plus the time the compressed bytes
+ * take on the link, and it is compressed with the compressor for which
+ * that is the least, or not at all when sending it as it is costs
+ * less.  The time the peer needs to decompress is not counted.
+ *
+ * Every compressor is tried a few times first, and now and then
+ * another than the best one is, as the data may change.  While not
+ * compressing pays, only every so many messages are compressed, at
+ * ever longer intervals, to see whether it pays again.
+ */
+class TAO_ZIOP_Export TAO_ZIOP_Adaptive_Compression
+{
+public:
+  TAO_ZIOP_Adaptive_Compression (void);
+
+  /// Take the compressors to choose from, in order of preference,
+  /// and the bandwidth of the link in kilobytes per second.  The
+  /// samples are only kept when the compressors stay the same.
+  void compressors (const ::Compression::CompressorIdLevelList &list,
+                    CORBA::ULong link_bandwidth);
+
+  /// Choose the compressor for the next message.  Returns false if
+  /// it is better sent uncompressed.
+  bool select (::Compression::CompressorId &compressor_id,
+               ::Compression::CompressionLevel &compression_level);
+
+  /// Take the outcome of compressing a message with a compressor
+  /// select() returned, which took @a nsecs nanoseconds.
+  void sample (::Compression::CompressorId compressor_id,
+               ::Compression::CompressionLevel compression_level,
+               CORBA::ULong original_length,
+               CORBA::ULong compressed_length,
+               ACE_hrtime_t nsecs);
+
+  enum
+  {
+    /// Each compressor is tried this often before the averages count.
+    MIN_SAMPLES = 4,
+
+    /// One in this many messages tries another than the best
+    /// compressor.
+    PROBE_INTERVAL = 64,
+
+    /// While not compressing pays, one in this many messages is
+    /// compressed at first, and one in twice as many every time that
+    /// still didn't pay, up to one in MAX_BACKOFF.
+    MIN_BACKOFF = 8,
+    MAX_BACKOFF = 1024
+  };
+
+private:
+  struct Candidate
+  {
+    ::Compression::CompressorId compressor_id;
+    ::Compression::CompressionLevel compression_level;
+    CORBA::ULong samples;
+
+    /// Compressed size divided by the original size.
+    double ratio;
+
+    /// Time compressing took per original byte.
+    double nsecs_per_byte;
+  };
+
+  /// The index of the candidate with the least cost per byte.
+  size_t best (double &cost) const;
+
+  TAO_SYNCH_MUTEX lock_;
+
+  std::vector<Candidate> candidates_;
+
+  /// Time a byte takes on the link.
+  double link_nsecs_per_byte_;
+
+  /// Messages select() was called for.
+  CORBA::ULong messages_;
+
+  /// The candidate that was tried last instead of the best one.
+  size_t probe_;
+
+  /// Messages left uncompressed since compressing stopped paying,
+  /// and how many to leave before compressing one again.
+  CORBA::ULong skipped_;
+  CORBA::ULong backoff_;
+};
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#include /**/ "ace/post.h"
+
+#endif /* TAO_ZIOP_ADAPTIVE_COMPRESSION_H */
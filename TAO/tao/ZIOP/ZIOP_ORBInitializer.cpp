@@ -35,6 +35,7 @@ TAO_ZIOP_ORBInitializer::pre_init (PortableInterceptor::ORBInitInfo_ptr info)
     }
 
   tao_info->orb_core ()->ziop_adapter (this->loader_);
+  this->loader_->add_monitors ();
   // Set the name of the stub factory to be ZIOP_Stub_Factory.
   tao_info->orb_core ()->orb_params ()->stub_factory_name ("ZIOP_Stub_Factory");
   ACE_Service_Config::process_directive (ace_svc_desc_TAO_ZIOP_Stub_Factory);
@@ -324,5 +324,60 @@ TAO_ZIOP_Stub::effective_compression_id_list_policy (void)
   return 0;
 }
 
+bool
+TAO_ZIOP_Stub::common_compressors (::Compression::CompressorIdLevelList &list)
+{
+  list.length (0);
+
+  CORBA::Policy_var policy (
+    this->TAO_Stub::get_cached_policy (TAO_CACHED_COMPRESSION_ID_LEVEL_LIST_POLICY));
+  ZIOP::CompressorIdLevelListPolicy_var clientCompressors (
+    ZIOP::CompressorIdLevelListPolicy::_narrow (policy.in ()));
+  if (CORBA::is_nil (clientCompressors.in ()))
+    return false;
+
+  ::Compression::CompressorIdLevelList &clientList =
+    *clientCompressors->compressor_ids ();
+
+  policy = this->exposed_compression_id_list_policy ();
+  ZIOP::CompressorIdLevelListPolicy_var serverCompressors (
+    ZIOP::CompressorIdLevelListPolicy::_narrow (policy.in ()));
+  if (CORBA::is_nil (serverCompressors.in ()))
+    {
+      // See effective_compression_id_list_policy().
+      if (this->orb_core()->orb_params()->allow_ziop_no_server_policies ())
+        list = clientList;
+      return list.length () > 0u;
+    }
+
+  ::Compression::CompressorIdLevelList &serverList =
+    *serverCompressors->compressor_ids ();
+
+  for (CORBA::ULong client = 0u; client < clientList.length (); ++client)
+    {
+      for (CORBA::ULong server = 0u; server < serverList.length (); ++server)
+        {
+          if (clientList[client].compressor_id == serverList[server].compressor_id)
+            {
+              CORBA::ULong const last = list.length ();
+              list.length (last + 1u);
+              list[last].compressor_id = clientList[client].compressor_id;
+              list[last].compression_level =
+                ACE_MIN (clientList[client].compression_level,
+                         serverList[server].compression_level);
+              break;
+            }
+        }
+    }
+
+  return list.length () > 0u;
+}
+
+TAO_ZIOP_Adaptive_Compression &
+TAO_ZIOP_Stub::adaptive_compression (void)
+{
+  return this->adaptive_compression_;
+}
+
 TAO_END_VERSIONED_NAMESPACE_DECL
 #endif
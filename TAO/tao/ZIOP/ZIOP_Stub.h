@@ -20,6 +20,7 @@
 #include "tao/ZIOP/ziop_export.h"
 
 #include "tao/Stub.h"
+#include "tao/ZIOP/ZIOP_Adaptive_Compression.h"
 
 #if !defined (ACE_LACKS_PRAGMA_ONCE)
 # pragma once
@@ -61,6 +62,16 @@ public:
 
   CORBA::Policy_ptr get_cached_policy (TAO_Cached_Policy_Type type);
 
+  /**
+   * Fill @a list with the compressors of the client's list the server
+   * has too, in the client's order and at the lower of both levels.
+   * Returns false if there are none.
+   */
+  bool common_compressors (::Compression::CompressorIdLevelList &list);
+
+  /// The choice of compressor for the requests to this target.
+  TAO_ZIOP_Adaptive_Compression &adaptive_compression (void);
+
 private:
 
   /// Helper method used to parse the policies.
@@ -88,6 +99,8 @@ private:
 
   CORBA::Boolean are_policies_parsed_;
 
+  TAO_ZIOP_Adaptive_Compression adaptive_compression_;
+
 private:
   // = Disallow copying and assignment.
   TAO_ZIOP_Stub (const TAO_ZIOP_Stub &);
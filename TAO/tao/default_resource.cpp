@@ -24,6 +24,7 @@
 #include "ace/Reactor.h"
 #include "ace/Malloc_T.h"
 #include "ace/Local_Memory_Pool.h"
+#include "ace/Thread_Cached_Allocator.h"
 #include "ace/OS_NS_string.h"
 #include "ace/OS_NS_strings.h"
 
@@ -107,6 +108,8 @@ TAO_Default_Resource_Factory::TAO_Default_Resource_Factory (void)
   , connection_purging_type_ (TAO_CONNECTION_PURGING_STRATEGY)
   , cache_maximum_ (TAO_CONNECTION_CACHE_MAXIMUM)
   , purge_percentage_ (TAO_PURGE_PERCENT)
+  , cache_shards_ (TAO_CONNECTION_CACHE_SHARDS)
+  , object_key_table_shards_ (TAO_OBJECT_KEY_TABLE_SHARDS)
   , max_muxed_connections_ (0)
   , reactor_mask_signals_ (1)
   , dynamically_allocated_reactor_ (false)
@@ -121,6 +124,11 @@ TAO_Default_Resource_Factory::TAO_Default_Resource_Factory (void)
   , use_local_memory_pool_ (true)
 #else
   , use_local_memory_pool_ (false)
+#endif
+#if TAO_USE_THREAD_CACHED_ALLOCATOR == 1
+  , use_thread_cached_allocator_ (true)
+#else
+  , use_thread_cached_allocator_ (false)
 #endif
   , cached_connection_lock_type_ (TAO_THREAD_LOCK)
 #if defined (TAO_USE_BLOCKING_FLUSHING)
@@ -331,6 +339,26 @@ TAO_Default_Resource_Factory::init (int argc, ACE_TCHAR *argv[])
           this->report_option_value_error (ACE_TEXT("-ORBConnectionCachePurgePercentage"),
                                            argv[curarg]);
       }
+    else if (ACE_OS::strcasecmp (argv[curarg],
+                                 ACE_TEXT("-ORBConnectionCacheShards")) == 0)
+      {
+        ++curarg;
+        if (curarg < argc && ACE_OS::atoi (argv[curarg]) > 0)
+            this->cache_shards_ = ACE_OS::atoi (argv[curarg]);
+        else
+          this->report_option_value_error (ACE_TEXT("-ORBConnectionCacheShards"),
+                                           argv[curarg]);
+      }
+    else if (ACE_OS::strcasecmp (argv[curarg],
+                                 ACE_TEXT("-ORBObjectKeyTableShards")) == 0)
+      {
+        ++curarg;
+        if (curarg < argc && ACE_OS::atoi (argv[curarg]) > 0)
+            this->object_key_table_shards_ = ACE_OS::atoi (argv[curarg]);
+        else
+          this->report_option_value_error (ACE_TEXT("-ORBObjectKeyTableShards"),
+                                           argv[curarg]);
+      }
     else if (ACE_OS::strcasecmp (argv[curarg],
                                  ACE_TEXT("-ORBIORParser")) == 0)
       {
@@ -477,6 +505,16 @@ TAO_Default_Resource_Factory::init (int argc, ACE_TCHAR *argv[])
               }
           }
       }
+    else if (0 == ACE_OS::strcasecmp (argv[curarg],
+                                      ACE_TEXT("-ORBThreadCachedAllocator")))
+      {
+        ++curarg;
+        if (curarg < argc)
+          this->use_thread_cached_allocator_ = ACE_OS::atoi (argv[curarg]) != 0;
+        else
+          this->report_option_value_error (
+            ACE_TEXT("-ORBThreadCachedAllocator"), argv[curarg]);
+      }
     else if (0 == ACE_OS::strcasecmp (argv[curarg],
                                       ACE_TEXT("-ORBZeroCopyWrite")))
       {
@@ -820,6 +858,7 @@ TAO_Default_Resource_Factory::reclaim_reactor (ACE_Reactor *reactor)
 typedef ACE_Malloc<ACE_LOCAL_MEMORY_POOL,TAO_SYNCH_MUTEX> LOCKED_MALLOC;
 typedef ACE_Allocator_Adapter<LOCKED_MALLOC> LOCKED_ALLOCATOR_POOL;
 typedef ACE_New_Allocator LOCKED_ALLOCATOR_NO_POOL;
+typedef ACE_Thread_Cached_Allocator THREAD_CACHED_ALLOCATOR;
 
 void
 TAO_Default_Resource_Factory::use_local_memory_pool (bool flag)
@@ -834,7 +873,13 @@ ACE_Allocator *
 TAO_Default_Resource_Factory::input_cdr_dblock_allocator (void)
 {
   ACE_Allocator *allocator = 0;
-  if (use_local_memory_pool_)
+  if (this->use_thread_cached_allocator_)
+  {
+    ACE_NEW_RETURN (allocator,
+                    THREAD_CACHED_ALLOCATOR,
+                    0);
+  }
+  else if (use_local_memory_pool_)
   {
     ACE_NEW_RETURN (allocator,
                     LOCKED_ALLOCATOR_POOL,
@@ -854,7 +899,13 @@ ACE_Allocator *
 TAO_Default_Resource_Factory::input_cdr_buffer_allocator (void)
 {
   ACE_Allocator *allocator = 0;
-  if (use_local_memory_pool_)
+  if (this->use_thread_cached_allocator_)
+  {
+    ACE_NEW_RETURN (allocator,
+                    THREAD_CACHED_ALLOCATOR,
+                    0);
+  }
+  else if (use_local_memory_pool_)
   {
     ACE_NEW_RETURN (allocator,
                     LOCKED_ALLOCATOR_POOL,
@@ -874,7 +925,13 @@ ACE_Allocator *
 TAO_Default_Resource_Factory::input_cdr_msgblock_allocator (void)
 {
   ACE_Allocator *allocator = 0;
-  if (use_local_memory_pool_)
+  if (this->use_thread_cached_allocator_)
+  {
+    ACE_NEW_RETURN (allocator,
+                    THREAD_CACHED_ALLOCATOR,
+                    0);
+  }
+  else if (use_local_memory_pool_)
   {
     ACE_NEW_RETURN (allocator,
                     LOCKED_ALLOCATOR_POOL,
@@ -900,7 +957,13 @@ ACE_Allocator*
 TAO_Default_Resource_Factory::output_cdr_dblock_allocator (void)
 {
   ACE_Allocator *allocator = 0;
-  if (use_local_memory_pool_)
+  if (this->use_thread_cached_allocator_)
+  {
+    ACE_NEW_RETURN (allocator,
+                    THREAD_CACHED_ALLOCATOR,
+                    0);
+  }
+  else if (use_local_memory_pool_)
   {
     ACE_NEW_RETURN (allocator,
                     LOCKED_ALLOCATOR_POOL,
@@ -924,9 +987,14 @@ TAO_Default_Resource_Factory::output_cdr_buffer_allocator (void)
   switch (this->output_cdr_allocator_type_)
     {
     case LOCAL_MEMORY_POOL:
-      ACE_NEW_RETURN (allocator,
-                      LOCKED_ALLOCATOR_POOL,
-                      0);
+      if (this->use_thread_cached_allocator_)
+        ACE_NEW_RETURN (allocator,
+                        THREAD_CACHED_ALLOCATOR,
+                        0);
+      else
+        ACE_NEW_RETURN (allocator,
+                        LOCKED_ALLOCATOR_POOL,
+                        0);
 
       break;
 
@@ -941,9 +1009,14 @@ TAO_Default_Resource_Factory::output_cdr_buffer_allocator (void)
 
     case DEFAULT:
     default:
-      ACE_NEW_RETURN (allocator,
-                      LOCKED_ALLOCATOR_NO_POOL,
-                      0);
+      if (this->use_thread_cached_allocator_)
+        ACE_NEW_RETURN (allocator,
+                        THREAD_CACHED_ALLOCATOR,
+                        0);
+      else
+        ACE_NEW_RETURN (allocator,
+                        LOCKED_ALLOCATOR_NO_POOL,
+                        0);
 
       break;
     }
@@ -955,7 +1028,13 @@ ACE_Allocator*
 TAO_Default_Resource_Factory::output_cdr_msgblock_allocator (void)
 {
   ACE_Allocator *allocator = 0;
-  if (use_local_memory_pool_)
+  if (this->use_thread_cached_allocator_)
+  {
+    ACE_NEW_RETURN (allocator,
+                    THREAD_CACHED_ALLOCATOR,
+                    0);
+  }
+  else if (use_local_memory_pool_)
   {
     ACE_NEW_RETURN (allocator,
                     LOCKED_ALLOCATOR_POOL,
@@ -1023,6 +1102,18 @@ TAO_Default_Resource_Factory::purge_percentage (void) const
   return this->purge_percentage_;
 }
 
+int
+TAO_Default_Resource_Factory::cache_shards (void) const
+{
+  return this->cache_shards_;
+}
+
+int
+TAO_Default_Resource_Factory::object_key_table_shards (void) const
+{
+  return this->object_key_table_shards_;
+}
+
 int
 TAO_Default_Resource_Factory::max_muxed_connections (void) const
 {
@@ -174,6 +174,8 @@ public:
 
   virtual int cache_maximum (void) const;
   virtual int purge_percentage (void) const;
+  virtual int cache_shards (void) const;
+  virtual int object_key_table_shards (void) const;
   virtual int max_muxed_connections (void) const;
   virtual ACE_Lock *create_cached_connection_lock (void);
   virtual int locked_transport_cache (void);
@@ -238,6 +240,12 @@ protected:
   /// demand.
   int purge_percentage_;
 
+  /// Specifies the number of shards of the connection cache.
+  int cache_shards_;
+
+  /// Specifies the number of shards of the ObjectKey table.
+  int object_key_table_shards_;
+
   /// Specifies the limit on the number of muxed connections
   /// allowed per-property for the ORB. A value of 0 indicates no
   /// limit
@@ -287,6 +295,11 @@ protected:
   /// should use the local memory pool or not.
   bool use_local_memory_pool_;
 
+  /// This flag is used to determine whether the CDR and message block
+  /// allocators should cache free blocks per thread, see
+  /// ACE_Thread_Cached_Allocator.
+  bool use_thread_cached_allocator_;
+
 private:
   enum Lock_Type
   {
@@ -148,6 +148,16 @@ TAO_Default_Server_Strategy_Factory::parse_args (int argc, ACE_TCHAR* argv[])
                              0,
                              10);
       }
+    else if (ACE_OS::strcasecmp (argv[curarg],
+                                 ACE_TEXT("-ORBActiveObjectMapShards")) == 0)
+      {
+        ++curarg;
+        if (curarg < argc)
+          this->active_object_map_creation_parameters_.active_object_map_shards_ =
+            ACE_OS::strtoul (argv[curarg],
+                             0,
+                             10);
+      }
     else if (ACE_OS::strcasecmp (argv[curarg],
                                  ACE_TEXT("-ORBPOAMapSize")) == 0)
       {
@@ -146,6 +146,12 @@ const size_t TAO_DEFAULT_VALUE_FACTORY_TABLE_SIZE = 128;
 # define TAO_DEFAULT_SERVER_ACTIVE_OBJECT_MAP_SIZE 64
 #endif /* ! TAO_DEFAULT_SERVER_ACTIVE_OBJECT_MAP_SIZE */
 
+// The default number of shards of the active object maps of the POAs
+// with the TAO::SHARDED_ACTIVE_OBJECT_MAP policy.
+#if !defined (TAO_DEFAULT_SERVER_ACTIVE_OBJECT_MAP_SHARDS)
+# define TAO_DEFAULT_SERVER_ACTIVE_OBJECT_MAP_SHARDS 16
+#endif /* ! TAO_DEFAULT_SERVER_ACTIVE_OBJECT_MAP_SHARDS */
+
 // The default size of TAO's server poa map.
 #if !defined (TAO_DEFAULT_SERVER_POA_MAP_SIZE)
 #  define TAO_DEFAULT_SERVER_POA_MAP_SIZE 24
@@ -179,6 +185,18 @@ const size_t TAO_DEFAULT_VALUE_FACTORY_TABLE_SIZE = 128;
 # define TAO_PURGE_PERCENT 20
 #endif /* TAO_PURGE_PERCENT */
 
+/// Number of shards the connection cache is split in.  Each shard
+/// has its own lock, see -ORBConnectionCacheShards.
+#if !defined (TAO_CONNECTION_CACHE_SHARDS)
+# define TAO_CONNECTION_CACHE_SHARDS 1
+#endif /* TAO_CONNECTION_CACHE_SHARDS */
+
+/// Number of shards the ObjectKey table is split in.  Each shard has
+/// its own lock, see -ORBObjectKeyTableShards.
+#if !defined (TAO_OBJECT_KEY_TABLE_SHARDS)
+# define TAO_OBJECT_KEY_TABLE_SHARDS 1
+#endif /* TAO_OBJECT_KEY_TABLE_SHARDS */
+
 #if !defined (TAO_CONNECTION_CACHE_MAXIMUM)
 // If for some reason you configure the maximum number of handles in
 // your OS to some astronomical value, then you should override this
@@ -685,6 +703,21 @@ const size_t TAO_DEFAULT_VALUE_FACTORY_TABLE_SIZE = 128;
             TAO_HAS_CORBA_MESSAGING == 0 */
 #endif  /* !TAO_HAS_AMI_CALLBACK */
 
+// The co_ stubs tao_idl generates with -GCo return an awaitable, and
+// need AMI_CALLBACK support and a C++20 compiler with coroutines.
+// To explicitly disable them uncomment the following
+// #define TAO_HAS_AMI_COROUTINES 0
+
+/// Default AMI_COROUTINES settings
+#if !defined (TAO_HAS_AMI_COROUTINES)
+#  if (TAO_HAS_AMI_CALLBACK == 1) && defined (ACE_HAS_CPP20) && \
+      defined (__cpp_impl_coroutine)
+#    define TAO_HAS_AMI_COROUTINES 1
+#  else
+#    define TAO_HAS_AMI_COROUTINES 0
+#  endif  /* TAO_HAS_AMI_CALLBACK == 1 && ACE_HAS_CPP20 */
+#endif  /* !TAO_HAS_AMI_COROUTINES */
+
 /// Interceptors is supported by default if we are not building for
 /// MinimumCORBA.
 #if !defined (TAO_HAS_INTERCEPTORS)
@@ -855,6 +888,12 @@ enum TAO_Policy_Scope
 #  define TAO_USE_LOCAL_MEMORY_POOL 1
 #endif /* TAO_USE_LOCAL_MEMORY_POOL */
 
+/// Use ACE_Thread_Cached_Allocator for the CDR and message block
+/// allocators, see -ORBThreadCachedAllocator.
+#if !defined (TAO_USE_THREAD_CACHED_ALLOCATOR)
+#  define TAO_USE_THREAD_CACHED_ALLOCATOR 0
+#endif /* TAO_USE_THREAD_CACHED_ALLOCATOR */
+
 #if !defined (TAO_USE_OUTPUT_CDR_MMAP_MEMORY_POOL)
 #  define TAO_USE_OUTPUT_CDR_MMAP_MEMORY_POOL 0
 #endif /* TAO_USE_LOCAL_MEMORY_POOL */
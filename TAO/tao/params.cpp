@@ -14,6 +14,11 @@
 # define TAO_ALLOW_ZIOP_NO_SERVER_POLICIES_DEFAULT false
 #endif /* !TAO_ALLOW_ZIOP_NO_SERVER_POLICIES_DEFAULT */
 
+#if !defined (TAO_ZIOP_LINK_BANDWIDTH_DEFAULT)
+// Kilobytes per second, about 100 Mbit/s.
+# define TAO_ZIOP_LINK_BANDWIDTH_DEFAULT 12500
+#endif /* !TAO_ZIOP_LINK_BANDWIDTH_DEFAULT */
+
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
 TAO_ORB_Parameters::TAO_ORB_Parameters (void)
@@ -30,6 +35,7 @@ TAO_ORB_Parameters::TAO_ORB_Parameters (void)
   , iiop_client_port_base_ (0)
   , iiop_client_port_span_ (0)
   , cdr_memcpy_tradeoff_ (ACE_DEFAULT_CDR_MEMCPY_TRADEOFF)
+  , zero_copy_octet_sequences_ (false)
   , max_message_size_ (0) // Disable outgoing GIOP fragments by default
   , use_dotted_decimal_addresses_ (0)
   , cache_incoming_by_dotted_decimal_address_ (0)
@@ -69,6 +75,8 @@ TAO_ORB_Parameters::TAO_ORB_Parameters (void)
   , forward_once_exception_ (0)
   , collocation_resolver_name_ ("Default_Collocation_Resolver")
   , allow_ziop_no_server_policies_ (!!TAO_ALLOW_ZIOP_NO_SERVER_POLICIES_DEFAULT)
+  , ziop_adaptive_ (false)
+  , ziop_link_bandwidth_ (TAO_ZIOP_LINK_BANDWIDTH_DEFAULT)
 {
   for (int i = 0; i != TAO_NO_OF_MCAST_SERVICES; ++i)
     {
@@ -118,6 +118,16 @@ public:
   int cdr_memcpy_tradeoff (void) const;
   void cdr_memcpy_tradeoff (int);
 
+  /**
+   * Octet sequence buffers appended to the CDR stream are normally
+   * copied when a message has to be queued by the transport.  When
+   * this is enabled they are referenced instead, so they are written
+   * straight from the application's buffer.  The application must not
+   * modify such a buffer until the message has been sent.
+   */
+  bool zero_copy_octet_sequences (void) const;
+  void zero_copy_octet_sequences (bool);
+
   /**
    * Maximum size of a GIOP message before outgoing fragmentation
    * kicks in.
@@ -281,6 +291,16 @@ public:
   void allow_ziop_no_server_policies (bool opt);
   bool allow_ziop_no_server_policies (void) const;
 
+  /// Let ZIOP choose per target whether and with which compressor
+  /// the requests are compressed, from the ratio and time measured.
+  void ziop_adaptive (bool opt);
+  bool ziop_adaptive (void) const;
+
+  /// The bandwidth of the link in kilobytes per second, which the
+  /// adaptive ZIOP compression weighs the compression time against.
+  void ziop_link_bandwidth (ACE_CDR::ULong bandwidth);
+  ACE_CDR::ULong ziop_link_bandwidth (void) const;
+
 private:
   /// Each "endpoint" is of the form:
   ///
@@ -344,6 +364,10 @@ private:
   /// CDR streams.
   int cdr_memcpy_tradeoff_;
 
+  /// Reference instead of copy octet sequence buffers when queueing
+  /// outgoing messages.
+  bool zero_copy_octet_sequences_;
+
   /// Maximum GIOP message size to be sent over a given transport.
   /**
    * Setting a maximum message size will cause outgoing GIOP
@@ -535,6 +559,12 @@ private:
   // reject the request as they simply cannot decode or handle it (comms will
   // simply timeout or lock-up at the client for any such incorrect two-way requests).
   bool allow_ziop_no_server_policies_;
+
+  /// Choose the ZIOP compression per target.
+  bool ziop_adaptive_;
+
+  /// Kilobytes per second of the link, for the adaptive ZIOP compression.
+  ACE_CDR::ULong ziop_link_bandwidth_;
 };
 
 TAO_END_VERSIONED_NAMESPACE_DECL
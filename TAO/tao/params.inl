@@ -37,6 +37,18 @@ TAO_ORB_Parameters::cdr_memcpy_tradeoff (int x)
   this->cdr_memcpy_tradeoff_ = x;
 }
 
+ACE_INLINE bool
+TAO_ORB_Parameters::zero_copy_octet_sequences (void) const
+{
+  return this->zero_copy_octet_sequences_;
+}
+
+ACE_INLINE void
+TAO_ORB_Parameters::zero_copy_octet_sequences (bool x)
+{
+  this->zero_copy_octet_sequences_ = x;
+}
+
 ACE_INLINE ACE_CDR::ULong
 TAO_ORB_Parameters::max_message_size (void) const
 {
@@ -410,4 +422,28 @@ TAO_ORB_Parameters::allow_ziop_no_server_policies (bool x)
   this->allow_ziop_no_server_policies_ = x;
 }
 
+ACE_INLINE bool
+TAO_ORB_Parameters::ziop_adaptive (void) const
+{
+  return this->ziop_adaptive_;
+}
+
+ACE_INLINE void
+TAO_ORB_Parameters::ziop_adaptive (bool x)
+{
+  this->ziop_adaptive_ = x;
+}
+
+ACE_INLINE ACE_CDR::ULong
+TAO_ORB_Parameters::ziop_link_bandwidth (void) const
+{
+  return this->ziop_link_bandwidth_;
+}
+
+ACE_INLINE void
+TAO_ORB_Parameters::ziop_link_bandwidth (ACE_CDR::ULong x)
+{
+  this->ziop_link_bandwidth_ = x;
+}
+
 TAO_END_VERSIONED_NAMESPACE_DECL
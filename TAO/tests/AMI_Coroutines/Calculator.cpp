@@ -0,0 +1,41 @@
+#include "Calculator.h"
+#include "ace/SString.h"
+
+Calculator::Calculator (CORBA::ORB_ptr orb)
+  : orb_ (CORBA::ORB::_duplicate (orb))
+{
+}
+
+CORBA::Long
+Calculator::divide (CORBA::Long dividend,
+                    CORBA::Long divisor,
+                    CORBA::Long_out remainder)
+{
+  if (divisor == 0)
+    throw Test::Refused ("division by zero", dividend);
+
+  remainder = dividend % divisor;
+  return dividend / divisor;
+}
+
+void
+Calculator::append (char *& text, const char *suffix)
+{
+  ACE_CString result (text);
+  result += suffix;
+
+  CORBA::string_free (text);
+  text = CORBA::string_dup (result.c_str ());
+}
+
+void
+Calculator::forbidden (void)
+{
+  throw CORBA::NO_PERMISSION (42, CORBA::COMPLETED_NO);
+}
+
+void
+Calculator::shutdown (void)
+{
+  this->orb_->shutdown (0);
+}
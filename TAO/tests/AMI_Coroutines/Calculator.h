@@ -0,0 +1,32 @@
+#ifndef CALCULATOR_H
+#define CALCULATOR_H
+#include /**/ "ace/pre.h"
+
+#include "TestS.h"
+
+/// Implement the Test::Calculator interface
+class Calculator
+  : public virtual POA_Test::Calculator
+{
+public:
+  /// Constructor
+  Calculator (CORBA::ORB_ptr orb);
+
+  // = The skeleton methods
+  virtual CORBA::Long divide (CORBA::Long dividend,
+                              CORBA::Long divisor,
+                              CORBA::Long_out remainder);
+
+  virtual void append (char *& text, const char *suffix);
+
+  virtual void forbidden (void);
+
+  virtual void shutdown (void);
+
+private:
+  /// Use an ORB reference to shutdown the application.
+  CORBA::ORB_var orb_;
+};
+
+#include /**/ "ace/post.h"
+#endif /* CALCULATOR_H */
@@ -0,0 +1,251 @@
+#include "TestC.h"
+#include "ace/Get_Opt.h"
+#include "ace/OS_NS_string.h"
+
+const ACE_TCHAR *ior = ACE_TEXT ("file://test.ior");
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("k:"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'k':
+        ior = get_opts.opt_arg ();
+        break;
+
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage:  %s "
+                           "-k <ior> "
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+  // Indicates successful parsing of the command line
+  return 0;
+}
+
+#if (TAO_HAS_AMI_COROUTINES == 1)
+
+/// The errors the coroutine found
+int errors = 0;
+
+/// Set when the coroutine ran to its end
+bool finished = false;
+
+/// A coroutine that runs until its first co_await, and on from there
+/// in the thread that dispatches the reply.
+struct Calculator_Task
+{
+  struct promise_type
+  {
+    Calculator_Task get_return_object (void)
+    {
+      return Calculator_Task ();
+    }
+
+    std::suspend_never initial_suspend (void) noexcept
+    {
+      return std::suspend_never ();
+    }
+
+    std::suspend_never final_suspend (void) noexcept
+    {
+      return std::suspend_never ();
+    }
+
+    void return_void (void)
+    {
+    }
+
+    void unhandled_exception (void)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  "(%P|%t) ERROR: exception escaped the coroutine\n"));
+      ++errors;
+      finished = true;
+    }
+  };
+};
+
+/// Check the quotient and remainder a divide() reply brought.
+void
+check_division (CORBA::Long dividend,
+                CORBA::Long divisor,
+                CORBA::Long quotient,
+                CORBA::Long remainder)
+{
+  if (quotient != dividend / divisor || remainder != dividend % divisor)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  "(%P|%t) ERROR: %d / %d gave %d remainder %d\n",
+                  dividend, divisor, quotient, remainder));
+      ++errors;
+    }
+}
+
+/// co_await a normal reply, a user exception and a system exception.
+Calculator_Task
+run_test (CORBA::ORB_ptr orb, Test::Calculator_ptr calculator)
+{
+  try
+    {
+      // The reply is in before the coroutine awaits it, so it doesn't
+      // suspend.
+      CORBA::Long remainder = 0;
+      auto ready = calculator->co_divide (17, 5, remainder);
+
+      ACE_Time_Value tv (0, 10000);
+      while (!ready.await_ready ())
+        orb->perform_work (tv);
+
+      CORBA::Long quotient = co_await ready;
+      check_division (17, 5, quotient, remainder);
+
+      // From here on the coroutine is resumed by the ORB.
+      quotient = co_await calculator->co_divide (-7, 2, remainder);
+      check_division (-7, 2, quotient, remainder);
+
+      CORBA::String_var text = CORBA::string_dup ("co_");
+      co_await calculator->co_append (text.inout (), "await");
+
+      if (ACE_OS::strcmp (text.in (), "co_await") != 0)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      "(%P|%t) ERROR: append gave <%C>\n",
+                      text.in ()));
+          ++errors;
+        }
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("ERROR: normal reply:");
+      ++errors;
+    }
+
+  try
+    {
+      CORBA::Long remainder = 0;
+      (void) co_await calculator->co_divide (9, 0, remainder);
+
+      ACE_ERROR ((LM_ERROR,
+                  "(%P|%t) ERROR: division by zero didn't raise\n"));
+      ++errors;
+    }
+  catch (const Test::Refused& ex)
+    {
+      if (ACE_OS::strcmp (ex.reason.in (), "division by zero") != 0
+          || ex.code != 9)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      "(%P|%t) ERROR: Refused with <%C> and %d\n",
+                      ex.reason.in (), ex.code));
+          ++errors;
+        }
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("ERROR: user exception:");
+      ++errors;
+    }
+
+  try
+    {
+      co_await calculator->co_forbidden ();
+
+      ACE_ERROR ((LM_ERROR,
+                  "(%P|%t) ERROR: forbidden() didn't raise\n"));
+      ++errors;
+    }
+  catch (const CORBA::NO_PERMISSION& ex)
+    {
+      if (ex.minor () != 42 || ex.completed () != CORBA::COMPLETED_NO)
+        {
+          ex._tao_print_exception ("ERROR: system exception:");
+          ++errors;
+        }
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("ERROR: system exception:");
+      ++errors;
+    }
+
+  // The exceptions left nothing behind for the next request.
+  try
+    {
+      CORBA::Long remainder = 0;
+      CORBA::Long const quotient =
+        co_await calculator->co_divide (100, 7, remainder);
+      check_division (100, 7, quotient, remainder);
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("ERROR: reply after the exceptions:");
+      ++errors;
+    }
+
+  finished = true;
+}
+
+#endif /* TAO_HAS_AMI_COROUTINES == 1 */
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  int status = 0;
+
+  try
+    {
+      CORBA::ORB_var orb =
+        CORBA::ORB_init (argc, argv);
+
+      if (parse_args (argc, argv) != 0)
+        return 1;
+
+      CORBA::Object_var object =
+        orb->string_to_object (ior);
+
+      Test::Calculator_var calculator =
+        Test::Calculator::_narrow (object.in ());
+
+      if (CORBA::is_nil (calculator.in ()))
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "(%P|%t) Nil Test::Calculator reference <%s>\n",
+                           ior),
+                          1);
+
+#if (TAO_HAS_AMI_COROUTINES == 1)
+      // Unlike the callback clients there is no reply handler servant,
+      // so no POA to activate.
+      run_test (orb.in (), calculator.in ());
+
+      ACE_Time_Value tv (0, 10000);
+      while (!finished)
+        orb->perform_work (tv);
+
+      if (errors != 0)
+        status = 1;
+#else
+      ACE_ERROR ((LM_ERROR,
+                  "(%P|%t) ERROR: built without C++20 coroutines\n"));
+      status = 1;
+#endif /* TAO_HAS_AMI_COROUTINES == 1 */
+
+      calculator->shutdown ();
+
+      orb->destroy ();
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Exception caught:");
+      return 1;
+    }
+
+  return status;
+}
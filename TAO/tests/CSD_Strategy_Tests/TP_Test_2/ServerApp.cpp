@@ -17,7 +17,8 @@ ServerApp::ServerApp()
     num_orb_threads_(1),
     num_remote_clients_(1),
     num_collocated_clients_(0),
-    collocated_client_kind_(0)
+    collocated_client_kind_(0),
+    work_stealing_(0)
 {
 }
 
@@ -91,7 +92,9 @@ ServerApp::poa_setup(void)
 void
 ServerApp::csd_setup(void)
 {
-  this->tp_strategy_ = new TAO::CSD::TP_Strategy(this->num_csd_threads_);
+  this->tp_strategy_ = new TAO::CSD::TP_Strategy(this->num_csd_threads_,
+                                                 true,
+                                                 this->work_stealing_ != 0);
 
   if (!this->tp_strategy_->apply_to(this->poa_.in()))
     {
@@ -171,7 +174,7 @@ ServerApp::parse_args(int argc, ACE_TCHAR* argv[])
 {
   this->exe_name_ = argv[0];
 
-  ACE_Get_Opt get_opts(argc, argv, ACE_TEXT("p:s:n:t:r:c:k:"));
+  ACE_Get_Opt get_opts(argc, argv, ACE_TEXT("p:s:n:t:r:c:k:w:"));
 
   int c;
 
@@ -229,6 +232,13 @@ ServerApp::parse_args(int argc, ACE_TCHAR* argv[])
                   "collocated_client_kind");
           break;
 
+        case 'w':
+          result = this->set_arg(this->work_stealing_,
+                  get_opts.opt_arg(),
+                  c,
+                  "work_stealing");
+          break;
+
         case '?':
           this->usage_statement();
           return 1;
@@ -260,6 +270,7 @@ ServerApp::usage_statement()
              "\t[-r <num_remote_clients>]\n"
              "\t[-c <num_collocated_clients>]\n"
              "\t[-k <collocated_client_kind>]\n"
+             "\t[-w <work_stealing>]\n"
              "\t[-?]\n\n",
              this->exe_name_.c_str()));
 }
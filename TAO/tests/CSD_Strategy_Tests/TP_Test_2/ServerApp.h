@@ -72,6 +72,7 @@ class ServerApp : public TestAppBase
     unsigned num_remote_clients_;
     unsigned num_collocated_clients_;
     unsigned collocated_client_kind_;
+    unsigned work_stealing_;
 };
 
 #endif
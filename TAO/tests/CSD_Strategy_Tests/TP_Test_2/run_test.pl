@@ -29,6 +29,7 @@ my $num_csd_threads        = 1;
 my $num_collocated_clients = 0;
 my $collocated_client_kind = 0;
 my $client_kind            = 0;
+my $work_stealing          = 0;
 
 my $i;
 my $j;
@@ -78,6 +79,21 @@ if ($ARGC > 0) {
         $num_remote_clients = 40;
         $num_collocated_clients = 40;
     }
+    elsif ($subtest eq 'remote_steal') {
+        $num_csd_threads = 5;
+        $num_servants = 10;
+        $num_orb_threads = 4;
+        $num_remote_clients = 40;
+        $work_stealing = 1;
+    }
+    elsif ($subtest eq 'big_steal') {
+        $num_csd_threads = 5;
+        $num_servants = 10;
+        $num_orb_threads = 4;
+        $num_remote_clients = 40;
+        $num_collocated_clients = 40;
+        $work_stealing = 1;
+    }
     elsif ($subtest eq 'usage') {
         print STDOUT "Usage: $0 [<subtest>]\n" .
                     "\n" .
@@ -89,6 +105,8 @@ if ($ARGC > 0) {
                     "\tremote_servants\n" .
                     "\tremote_csdthreads\n" .
                     "\tremote_big\n" .
+                    "\tremote_steal\n" .
+                    "\tbig_steal\n" .
                     "\tusage\n" .
                     "\n";
         exit 0;
@@ -118,7 +136,8 @@ $SV = $server->CreateProcess ("server_main",
                         "-t $num_orb_threads "        .
                         "-r $num_remote_clients "     .
                         "-c $num_collocated_clients " .
-                        "-k $collocated_client_kind");
+                        "-k $collocated_client_kind " .
+                        "-w $work_stealing");
 $SV->Spawn();
 
 
@@ -0,0 +1,275 @@
+#include "ace/Get_Opt.h"
+#include "ace/OS_NS_stdio.h"
+#include "tao/ORB.h"
+#include "tao/Compression/Compression.h"
+#include "tao/Compression/zstd/ZstdCompressor_Factory.h"
+
+bool
+test_invalid_compression_factory (Compression::CompressionManager_ptr cm)
+{
+  bool succeed = false;
+  try
+    {
+      // Get an invalid compression factory
+      Compression::CompressorFactory_var factory =
+        cm->get_factory (100);
+    }
+  catch (const Compression::UnknownCompressorId& ex)
+    {
+      ACE_UNUSED_ARG (ex);
+      succeed = true;
+    }
+  catch (const CORBA::Exception&)
+    {
+    }
+
+  if (!succeed)
+  {
+    ACE_ERROR ((LM_ERROR,
+                "(%t) ERROR, get invalid compression factory failed\n"));
+  }
+
+  return succeed;
+}
+
+
+bool
+test_duplicate_compression_factory (
+  Compression::CompressionManager_ptr cm,
+  Compression::CompressorFactory_ptr cf)
+{
+  bool succeed = false;
+  try
+    {
+      // Register duplicate
+      cm->register_factory (cf);
+    }
+  catch (const Compression::FactoryAlreadyRegistered&)
+    {
+      succeed = true;
+    }
+  catch (const CORBA::Exception&)
+    {
+    }
+
+  if (!succeed)
+  {
+    ACE_ERROR ((LM_ERROR,
+                "(%t) ERROR, register duplicate factory failed\n"));
+  }
+
+  return succeed;
+}
+
+bool
+test_register_nil_compression_factory (
+  Compression::CompressionManager_ptr cm)
+{
+  bool succeed = false;
+  try
+    {
+      // Register nil factory
+      cm->register_factory (Compression::CompressorFactory::_nil());
+    }
+  catch (const CORBA::BAD_PARAM& ex)
+    {
+      if ((ex.minor() & 0xFFFU) == 44)
+        {
+          succeed = true;
+        }
+    }
+  catch (const CORBA::Exception&)
+    {
+    }
+
+  if (!succeed)
+  {
+    ACE_ERROR ((LM_ERROR,
+                "(%t) ERROR, register nill factory failed\n"));
+  }
+
+  return succeed;
+}
+
+// Id of the factory that uses the dictionary, next to the plain one.
+static const Compression::CompressorId DICTIONARY_ID = 200;
+
+// Text like that of the messages, which the dictionary is made of.
+static void
+fill_records (CORBA::OctetSeq &seq, CORBA::ULong nelements, CORBA::ULong seed)
+{
+  seq.length (nelements);
+  char record[64];
+  CORBA::ULong j = 0;
+  while (j != nelements)
+    {
+      int const n = ACE_OS::sprintf (record,
+                                     "<quote symbol=\"X%u\" price=\"%u\"/>",
+                                     seed % 97, seed % 1000);
+      for (int i = 0; i != n && j != nelements; ++i, ++j)
+        seq[j] = record[i];
+      seed = seed * 1103515245 + 12345;
+    }
+}
+
+bool
+test_compression (CORBA::ULong nelements,
+                  Compression::CompressionManager_ptr cm,
+                  Compression::CompressorId compressor_id,
+                  Compression::CompressionLevel level)
+{
+  bool succeed = false;
+
+  CORBA::OctetSeq mytest;
+  fill_records (mytest, nelements, 7);
+
+  Compression::Compressor_var compressor =
+    cm->get_compressor (compressor_id, level);
+
+  CORBA::OctetSeq myout;
+  myout.length ((CORBA::ULong)(mytest.length() * 1.1));
+
+  compressor->compress (mytest, myout);
+
+  CORBA::OctetSeq decompress;
+  decompress.length (nelements);
+
+  compressor->decompress (myout, decompress);
+
+  if (decompress != mytest)
+    {
+      ACE_ERROR ((LM_ERROR, "Error, decompress not working\n"));
+    }
+  else
+    {
+      succeed = true;
+      ACE_DEBUG ((LM_DEBUG, "Compression worked with zstd %u level %d, "
+                            "original size %d, compressed size %d\n",
+                            compressor_id, level,
+                            mytest.length(), myout.length ()));
+    }
+  return succeed;
+}
+
+bool
+test_dictionary (Compression::CompressionManager_ptr cm)
+{
+  bool succeed = true;
+
+  CORBA::OctetSeq mytest;
+  fill_records (mytest, 200, 11);
+
+  Compression::Compressor_var plain =
+    cm->get_compressor (::Compression::COMPRESSORID_ZSTD, 3);
+  Compression::Compressor_var with_dictionary =
+    cm->get_compressor (DICTIONARY_ID, 3);
+
+  CORBA::OctetSeq plain_out;
+  plain->compress (mytest, plain_out);
+
+  CORBA::OctetSeq dictionary_out;
+  with_dictionary->compress (mytest, dictionary_out);
+
+  // A small message compresses much better against the dictionary.
+  if (dictionary_out.length () >= plain_out.length ())
+    {
+      ACE_ERROR ((LM_ERROR,
+                  "Error, dictionary compressed to %d, without to %d\n",
+                  dictionary_out.length (), plain_out.length ()));
+      succeed = false;
+    }
+
+  // Without the dictionary the message can't be decompressed.
+  try
+    {
+      CORBA::OctetSeq decompress;
+      decompress.length (mytest.length ());
+      plain->decompress (dictionary_out, decompress);
+      ACE_ERROR ((LM_ERROR,
+                  "Error, decompressed without the dictionary\n"));
+      succeed = false;
+    }
+  catch (const Compression::CompressionException&)
+    {
+    }
+
+  return succeed;
+}
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  int retval = 0;
+  try
+    {
+      CORBA::ORB_var orb =
+        CORBA::ORB_init (argc, argv);
+
+      CORBA::Object_var compression_manager =
+        orb->resolve_initial_references("CompressionManager");
+
+      Compression::CompressionManager_var manager =
+        Compression::CompressionManager::_narrow (compression_manager.in ());
+
+      if (CORBA::is_nil(manager.in ()))
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           " (%P|%t) Panic: nil compression manager\n"),
+                          1);
+
+      Compression::CompressorFactory_ptr compressor_factory;
+
+      ACE_NEW_RETURN (compressor_factory, TAO::Zstd_CompressorFactory (), 1);
+
+      Compression::CompressorFactory_var compr_fact = compressor_factory;
+      manager->register_factory(compr_fact.in ());
+
+      CORBA::OctetSeq dictionary;
+      fill_records (dictionary, 8192, 1);
+
+      ACE_NEW_RETURN (compressor_factory,
+                      TAO::Zstd_CompressorFactory (DICTIONARY_ID, dictionary),
+                      1);
+
+      Compression::CompressorFactory_var dictionary_fact = compressor_factory;
+      manager->register_factory(dictionary_fact.in ());
+
+      if (!test_duplicate_compression_factory (manager.in (), compr_fact.in ()))
+        retval = 1;
+
+      if (!test_register_nil_compression_factory (manager.in ()))
+        retval = 1;
+
+      // Levels above the zstd maximum are taken as the maximum.
+      Compression::CompressionLevel const levels[] = { 0, 1, 3, 19, 100 };
+
+      for (size_t i = 0; i != sizeof levels / sizeof levels[0]; ++i)
+        {
+          if (!test_compression (1024, manager.in (),
+                                 ::Compression::COMPRESSORID_ZSTD, levels[i]))
+            retval = 1;
+
+          if (!test_compression (1024, manager.in (),
+                                 DICTIONARY_ID, levels[i]))
+            retval = 1;
+        }
+
+      if (!test_compression (5, manager.in (),
+                             ::Compression::COMPRESSORID_ZSTD, 3))
+        retval = 1;
+
+      if (!test_dictionary (manager.in ()))
+        retval = 1;
+
+      if (!test_invalid_compression_factory (manager.in ()))
+        retval = 1;
+
+      orb->destroy ();
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Exception caught:");
+      retval = 1;
+    }
+
+  return retval;
+}
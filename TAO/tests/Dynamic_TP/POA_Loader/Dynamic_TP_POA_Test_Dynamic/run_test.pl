@@ -72,6 +72,13 @@ sub run_test
         $valid_num_exceptions = 5;
         $client_ext_args = "-e 0 -n $num_clients";
     }
+    elsif ($test_num == 5) {
+        $test_name = "work_stealing";
+        $find_this = "DTP_Task::svc() New thread created";
+        $expected_cnt = 5;
+        $num_clients = 10;
+        $client_ext_args = "-e 1 -n $num_clients";
+    }
     else {
         print STDERR "ERROR: invalid test num $test_num\n";
         exit 1;
@@ -186,7 +193,7 @@ sub run_test
 # thread_timeout (in seconds)
 # max_queue_request_depth
 
-for ($i = 0; $i < 4; $i++) {
+for ($i = 0; $i < 5; $i++) {
     $status += run_test ($i + 1);
 }
 exit $status;
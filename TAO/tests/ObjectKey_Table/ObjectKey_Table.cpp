@@ -0,0 +1,303 @@
+// -*- C++ -*-
+#include "tao/ORB.h"
+#include "tao/ORB_Core.h"
+#include "tao/Object.h"
+#include "tao/ObjectKey_Table.h"
+#include "tao/Refcounted_ObjectKey.h"
+
+#include "ace/Get_Opt.h"
+#include "ace/Task.h"
+#include "ace/Atomic_Op.h"
+#include "ace/Log_Msg.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_string.h"
+
+// Number of shards the table is expected to have, 0 to not check.
+size_t expected_shards = 0;
+
+const int nkeys = 256;
+const int nthreads = 8;
+const int niterations = 200;
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("s:"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 's':
+        expected_shards = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage:  %s "
+                           "-s <expected number of shards> "
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+  // Indicates successful parsing of the command line
+  return 0;
+}
+
+void
+make_key (TAO::ObjectKey &key, const char *owner, int id)
+{
+  char buf[64];
+  int const len =
+    ACE_OS::snprintf (buf, sizeof buf, "RootPOA/Table/%s/%d", owner, id);
+
+  key.length (static_cast<CORBA::ULong> (len));
+  ACE_OS::memcpy (key.get_buffer (), buf, len);
+}
+
+bool
+same_key (const TAO::ObjectKey &lhs, const TAO::ObjectKey &rhs)
+{
+  return lhs.length () == rhs.length ()
+    && ACE_OS::memcmp (lhs.get_buffer (),
+                       rhs.get_buffer (),
+                       lhs.length ()) == 0;
+}
+
+/// Bind and unbind keys one thread at a time, checking that the
+/// table hands out one Refcounted_ObjectKey per key for as long as it
+/// is bound.
+int
+test_refcount (TAO::ObjectKey_Table &table)
+{
+  int errors = 0;
+
+  TAO::ObjectKey keys[nkeys];
+  TAO::Refcounted_ObjectKey *first[nkeys];
+  TAO::Refcounted_ObjectKey *second[nkeys];
+
+  for (int i = 0; i != nkeys; ++i)
+    {
+      make_key (keys[i], "single", i);
+
+      if (table.bind (keys[i], first[i]) == -1 || first[i] == 0)
+        {
+          ACE_ERROR ((LM_ERROR, "ERROR: bind of key %d failed\n", i));
+          return 1;
+        }
+
+      if (!same_key (first[i]->object_key (), keys[i]))
+        {
+          ACE_ERROR ((LM_ERROR, "ERROR: key %d bound to another key\n", i));
+          ++errors;
+        }
+    }
+
+  // Binding the keys again gives the same entries.
+  for (int i = 0; i != nkeys; ++i)
+    {
+      if (table.bind (keys[i], second[i]) == -1 || second[i] != first[i])
+        {
+          ACE_ERROR ((LM_ERROR,
+                      "ERROR: second bind of key %d gave another entry\n",
+                      i));
+          ++errors;
+        }
+
+      for (int j = 0; j != i; ++j)
+        if (first[j] == first[i])
+          {
+            ACE_ERROR ((LM_ERROR,
+                        "ERROR: keys %d and %d share an entry\n",
+                        j, i));
+            ++errors;
+          }
+    }
+
+  // The entries stay while one reference is left.
+  for (int i = 0; i != nkeys; ++i)
+    table.unbind (second[i]);
+
+  for (int i = 0; i != nkeys; ++i)
+    {
+      if (table.bind (keys[i], second[i]) == -1 || second[i] != first[i])
+        {
+          ACE_ERROR ((LM_ERROR,
+                      "ERROR: key %d lost its entry while still bound\n",
+                      i));
+          ++errors;
+        }
+    }
+
+  for (int i = 0; i != nkeys; ++i)
+    {
+      table.unbind (second[i]);
+      table.unbind (first[i]);
+    }
+
+  // The keys can be bound again once they are gone.
+  for (int i = 0; i != nkeys; ++i)
+    {
+      if (table.bind (keys[i], first[i]) == -1
+          || first[i] == 0
+          || !same_key (first[i]->object_key (), keys[i]))
+        {
+          ACE_ERROR ((LM_ERROR, "ERROR: rebind of key %d failed\n", i));
+          ++errors;
+          continue;
+        }
+      table.unbind (first[i]);
+    }
+
+  return errors;
+}
+
+/// Bind and unbind private and shared keys from several threads.
+class Table_Task : public ACE_Task_Base
+{
+public:
+  Table_Task (TAO::ObjectKey_Table &table)
+    : table_ (table),
+      next_thread_ (0),
+      errors_ (0)
+  {
+  }
+
+  virtual int svc (void)
+  {
+    TAO::ObjectKey keys[2 * nkeys];
+    TAO::Refcounted_ObjectKey *bound[2 * nkeys];
+    TAO::Refcounted_ObjectKey *again = 0;
+
+    char owner[32];
+    ACE_OS::snprintf (owner, sizeof owner, "thread%ld",
+                      static_cast<long> (this->next_thread_++));
+
+    for (int i = 0; i != nkeys; ++i)
+      {
+        make_key (keys[i], owner, i);
+        make_key (keys[nkeys + i], "shared", i);
+      }
+
+    for (int n = 0; n != niterations; ++n)
+      {
+        for (int i = 0; i != 2 * nkeys; ++i)
+          if (this->table_.bind (keys[i], bound[i]) == -1
+              || bound[i] == 0
+              || !same_key (bound[i]->object_key (), keys[i]))
+            {
+              ++this->errors_;
+              bound[i] = 0;
+            }
+
+        // While this thread holds a key, the other threads bind the
+        // same entry.
+        for (int i = 0; i != 2 * nkeys; ++i)
+          if (bound[i] != 0)
+            {
+              if (this->table_.bind (keys[i], again) == -1
+                  || again != bound[i])
+                ++this->errors_;
+              this->table_.unbind (again);
+            }
+
+        for (int i = 0; i != 2 * nkeys; ++i)
+          this->table_.unbind (bound[i]);
+      }
+
+    return 0;
+  }
+
+  TAO::ObjectKey_Table &table_;
+  ACE_Atomic_Op<TAO_SYNCH_MUTEX, long> next_thread_;
+  ACE_Atomic_Op<TAO_SYNCH_MUTEX, long> errors_;
+};
+
+/// Create and release object references, which bind the keys of
+/// their profiles in the table of the ORB.
+int
+test_references (CORBA::ORB_ptr orb)
+{
+  CORBA::Object_var objects[nkeys];
+
+  for (int i = 0; i != nkeys; ++i)
+    {
+      char corbaloc[64];
+      ACE_OS::snprintf (corbaloc, sizeof corbaloc,
+                        "corbaloc:iiop:localhost:2809/Table%d", i % 16);
+      objects[i] = orb->string_to_object (corbaloc);
+
+      if (CORBA::is_nil (objects[i].in ()))
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "ERROR: nil reference for <%C>\n",
+                           corbaloc),
+                          1);
+    }
+
+  int errors = 0;
+  for (int i = 16; i != nkeys; ++i)
+    if (!objects[i]->_is_equivalent (objects[i % 16].in ()))
+      {
+        ACE_ERROR ((LM_ERROR,
+                    "ERROR: references %d and %d are not equivalent\n",
+                    i, i % 16));
+        ++errors;
+      }
+
+  return errors;
+}
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  int errors = 0;
+
+  try
+    {
+      CORBA::ORB_var orb = CORBA::ORB_init (argc, argv);
+
+      if (parse_args (argc, argv) != 0)
+        return 1;
+
+      TAO::ObjectKey_Table &table = orb->orb_core ()->object_key_table ();
+
+      ACE_DEBUG ((LM_DEBUG,
+                  "ObjectKey table with %B shard(s)\n",
+                  table.shards ()));
+
+      if (expected_shards != 0 && table.shards () != expected_shards)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      "ERROR: table has %B shards instead of %B\n",
+                      table.shards (),
+                      expected_shards));
+          ++errors;
+        }
+
+      errors += test_refcount (table);
+
+      Table_Task task (table);
+      task.activate (THR_NEW_LWP | THR_JOINABLE, nthreads, 1);
+      task.wait ();
+
+      if (task.errors_.value () != 0)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      "ERROR: %d binds failed in the threads\n",
+                      static_cast<int> (task.errors_.value ())));
+          ++errors;
+        }
+
+      errors += test_references (orb.in ());
+
+      orb->destroy ();
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Exception caught:");
+      return 1;
+    }
+
+  return errors == 0 ? 0 : 1;
+}
@@ -0,0 +1,29 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+    & eval 'exec perl -S $0 $argv:q'
+    if 0;
+
+# -*- perl -*-
+
+use lib "$ENV{ACE_ROOT}/bin";
+use PerlACE::TestTarget;
+
+my $status = 0;
+
+my $server = PerlACE::TestTarget::create_target (1) || die "Create target 1 failed\n";
+
+foreach my $shards (1, 8) {
+    $SV = $server->CreateProcess ("ObjectKey_Table",
+                                  "-ORBSvcConfDirective " .
+                                  "\"static Resource_Factory " .
+                                  "'-ORBObjectKeyTableShards $shards'\" " .
+                                  "-s $shards");
+
+    $test = $SV->SpawnWaitKill ($server->ProcessStartWaitInterval() + 45);
+
+    if ($test != 0) {
+        print STDERR "ERROR: test with $shards shard(s) returned $test\n";
+        $status = 1;
+    }
+}
+
+exit $status;
@@ -0,0 +1,272 @@
+//=============================================================================
+/**
+ *  @file     server.cpp
+ *
+ *   Activates many objects in POAs with the
+ *   TAO::SHARDED_ACTIVE_OBJECT_MAP policy, with user and system ids,
+ *   and checks that the requests find their servants, from several
+ *   threads, while objects are deactivated and reactivated.
+ */
+//=============================================================================
+
+#include "testS.h"
+#include "tao/PortableServer/ActiveObjectMapPolicy.h"
+#include "ace/Task.h"
+#include "ace/Atomic_Op.h"
+#include "ace/OS_NS_stdio.h"
+
+namespace
+{
+  const CORBA::ULong object_count = 1000;
+  const int thread_count = 8;
+  const int iterations = 20;
+
+  int errors = 0;
+}
+
+class test_i : public POA_test
+{
+public:
+  test_i (CORBA::Long id)
+    : id_ (id)
+  {
+  }
+
+  CORBA::Long id (void)
+  {
+    return this->id_;
+  }
+
+  void deactivate_self (void)
+  {
+    PortableServer::ObjectId_var oid = this->poa_->servant_to_id (this);
+    this->poa_->deactivate_object (oid.in ());
+
+    // The servant stays usable until the end of the upcall.
+    if (this->id () != this->id_)
+      ++errors;
+  }
+
+  PortableServer::POA_ptr _default_POA (void)
+  {
+    return PortableServer::POA::_duplicate (this->poa_.in ());
+  }
+
+  PortableServer::POA_var poa_;
+
+private:
+  CORBA::Long id_;
+};
+
+class Worker : public ACE_Task_Base
+{
+public:
+  Worker (test_var *objects)
+    : objects_ (objects)
+  {
+  }
+
+  int svc (void)
+  {
+    for (int i = 0; i < iterations; ++i)
+      {
+        for (CORBA::ULong k = 0; k < object_count; ++k)
+          {
+            try
+              {
+                if (this->objects_[k]->id () != static_cast<CORBA::Long> (k))
+                  {
+                    ACE_ERROR ((LM_ERROR,
+                                "(%t) ERROR: wrong servant for object %u\n",
+                                k));
+                    ++this->errors_;
+                  }
+              }
+            catch (const CORBA::Exception& ex)
+              {
+                ex._tao_print_exception ("Worker::svc");
+                ++this->errors_;
+              }
+          }
+      }
+
+    return 0;
+  }
+
+  ACE_Atomic_Op<TAO_SYNCH_MUTEX, long> errors_;
+
+private:
+  test_var *objects_;
+};
+
+int
+check_poa (PortableServer::POA_ptr poa, bool user_id)
+{
+  test_i **servants = 0;
+  ACE_NEW_RETURN (servants, test_i *[object_count], 1);
+  test_var *objects = 0;
+  ACE_NEW_RETURN (objects, test_var[object_count], 1);
+  PortableServer::ObjectId_var *ids = 0;
+  ACE_NEW_RETURN (ids, PortableServer::ObjectId_var[object_count], 1);
+
+  for (CORBA::ULong k = 0; k < object_count; ++k)
+    {
+      ACE_NEW_RETURN (servants[k],
+                      test_i (static_cast<CORBA::Long> (k)),
+                      1);
+      servants[k]->poa_ = PortableServer::POA::_duplicate (poa);
+
+      if (user_id)
+        {
+          char name[32];
+          ACE_OS::sprintf (name, "object %u", k);
+          ids[k] = PortableServer::string_to_ObjectId (name);
+          poa->activate_object_with_id (ids[k].in (), servants[k]);
+        }
+      else
+        {
+          ids[k] = poa->activate_object (servants[k]);
+        }
+
+      CORBA::Object_var obj = poa->id_to_reference (ids[k].in ());
+      objects[k] = test::_narrow (obj.in ());
+    }
+
+  int status = 0;
+
+  // Every request finds its own servant.
+  for (CORBA::ULong k = 0; k < object_count; ++k)
+    {
+      PortableServer::ObjectId_var id = poa->servant_to_id (servants[k]);
+      if (id.in () != ids[k].in ()
+          || objects[k]->id () != static_cast<CORBA::Long> (k))
+        {
+          ACE_ERROR ((LM_ERROR, "ERROR: object %u is not found\n", k));
+          status = 1;
+        }
+    }
+
+  // The deactivated objects are not found, until reactivated.
+  for (CORBA::ULong k = 0; k < object_count; k += 2)
+    {
+      objects[k]->deactivate_self ();
+
+      try
+        {
+          objects[k]->id ();
+          ACE_ERROR ((LM_ERROR, "ERROR: object %u is still active\n", k));
+          status = 1;
+        }
+      catch (const CORBA::OBJECT_NOT_EXIST&)
+        {
+        }
+
+      if (user_id)
+        {
+          poa->activate_object_with_id (ids[k].in (), servants[k]);
+        }
+      else
+        {
+          ids[k] = poa->activate_object (servants[k]);
+          CORBA::Object_var obj = poa->id_to_reference (ids[k].in ());
+          objects[k] = test::_narrow (obj.in ());
+        }
+    }
+
+  // The requests of several threads.
+  Worker worker (objects);
+  if (worker.activate (THR_NEW_LWP | THR_JOINABLE, thread_count) != 0)
+    {
+      ACE_ERROR ((LM_ERROR, "ERROR: cannot activate the workers\n"));
+      status = 1;
+    }
+  worker.wait ();
+  if (worker.errors_.value () != 0)
+    status = 1;
+
+  for (CORBA::ULong k = 0; k < object_count; ++k)
+    {
+      poa->deactivate_object (ids[k].in ());
+      servants[k]->_remove_ref ();
+    }
+
+  delete [] ids;
+  delete [] objects;
+  delete [] servants;
+
+  return status;
+}
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  int status = 0;
+
+  try
+    {
+      CORBA::ORB_var orb = CORBA::ORB_init (argc, argv);
+
+      CORBA::Object_var obj =
+        orb->resolve_initial_references ("RootPOA");
+
+      PortableServer::POA_var root_poa =
+        PortableServer::POA::_narrow (obj.in ());
+
+      PortableServer::POAManager_var poa_manager =
+        root_poa->the_POAManager ();
+
+      CORBA::PolicyList policies (2);
+      policies.length (2);
+      policies[0] =
+        new TAO::Portable_Server::ActiveObjectMapPolicy (
+          TAO::SHARDED_ACTIVE_OBJECT_MAP);
+      policies[1] =
+        root_poa->create_id_assignment_policy (PortableServer::USER_ID);
+
+      PortableServer::POA_var user_id_poa =
+        root_poa->create_POA ("user_id",
+                              poa_manager.in (),
+                              policies);
+
+      policies.length (1);
+      PortableServer::POA_var system_id_poa =
+        root_poa->create_POA ("system_id",
+                              poa_manager.in (),
+                              policies);
+
+      policies[0]->destroy ();
+
+      poa_manager->activate ();
+
+      if (check_poa (user_id_poa.in (), true) != 0)
+        {
+          ACE_ERROR ((LM_ERROR, "ERROR: the USER_ID POA failed\n"));
+          status = 1;
+        }
+
+      if (check_poa (system_id_poa.in (), false) != 0)
+        {
+          ACE_ERROR ((LM_ERROR, "ERROR: the SYSTEM_ID POA failed\n"));
+          status = 1;
+        }
+
+      if (errors != 0)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      "ERROR: %d servants were released during upcalls\n",
+                      errors));
+          status = 1;
+        }
+
+      root_poa->destroy (1, 1);
+
+      orb->destroy ();
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Exception caught");
+      return 1;
+    }
+
+  return status;
+}
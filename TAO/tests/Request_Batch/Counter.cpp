@@ -0,0 +1,39 @@
+#include "Counter.h"
+
+Counter::Counter (CORBA::ORB_ptr orb)
+  : orb_ (CORBA::ORB::_duplicate (orb))
+  , count_ (0)
+  , errors_ (0)
+{
+}
+
+CORBA::Long
+Counter::errors (void) const
+{
+  return this->errors_;
+}
+
+void
+Counter::tick (CORBA::Long n)
+{
+  if (n != this->count_)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  "(%P|%t) ERROR: tick %d arrived as number %d\n",
+                  n, this->count_));
+      ++this->errors_;
+    }
+  ++this->count_;
+}
+
+CORBA::Long
+Counter::count (void)
+{
+  return this->count_;
+}
+
+void
+Counter::shutdown (void)
+{
+  this->orb_->shutdown (0);
+}
@@ -0,0 +1,37 @@
+#ifndef COUNTER_H
+#define COUNTER_H
+#include /**/ "ace/pre.h"
+
+#include "TestS.h"
+
+/// Implement the Test::Counter interface
+class Counter
+  : public virtual POA_Test::Counter
+{
+public:
+  /// Constructor
+  Counter (CORBA::ORB_ptr orb);
+
+  /// Return the number of ticks that arrived out of order
+  CORBA::Long errors (void) const;
+
+  // = The skeleton methods
+  virtual void tick (CORBA::Long n);
+
+  virtual CORBA::Long count (void);
+
+  virtual void shutdown (void);
+
+private:
+  /// Use an ORB reference to shutdown the application.
+  CORBA::ORB_var orb_;
+
+  /// The ticks received so far
+  CORBA::Long count_;
+
+  /// The ticks that arrived out of order
+  CORBA::Long errors_;
+};
+
+#include /**/ "ace/post.h"
+#endif /* COUNTER_H */
@@ -0,0 +1,219 @@
+#include "TestS.h"
+#include "tao/Request_Batch.h"
+#include "ace/Get_Opt.h"
+#include "ace/OS_NS_stdlib.h"
+
+const ACE_TCHAR *ior = ACE_TEXT ("file://test.ior");
+CORBA::Long nrequests = 100;
+int result = 0;
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("k:n:"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'k':
+        ior = get_opts.opt_arg ();
+        break;
+
+      case 'n':
+        nrequests = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage:  %s "
+                           "-k <ior> "
+                           "-n <nrequests> "
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+  // Indicates successful parsing of the command line
+  return 0;
+}
+
+/// Receives the replies to the batched sendc_count() requests.
+class Handler : public POA_Test::AMI_CounterHandler
+{
+public:
+  Handler (void)
+    : replies_ (0)
+    , last_ (0)
+  {
+  }
+
+  CORBA::Long replies (void) const
+  {
+    return this->replies_;
+  }
+
+  CORBA::Long last (void) const
+  {
+    return this->last_;
+  }
+
+  void count (CORBA::Long ami_return_val)
+  {
+    ++this->replies_;
+    this->last_ = ami_return_val;
+  }
+
+  void count_excep (::Messaging::ExceptionHolder *excep_holder)
+  {
+    try
+      {
+        excep_holder->raise_exception ();
+      }
+    catch (const CORBA::Exception& ex)
+      {
+        ex._tao_print_exception ("ERROR: count_excep");
+      }
+    result = 1;
+    ++this->replies_;
+  }
+
+private:
+  CORBA::Long replies_;
+  CORBA::Long last_;
+};
+
+void
+check (const char *what, CORBA::Long value, CORBA::Long expected)
+{
+  if (value != expected)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  "(%P|%t) ERROR: %C is %d instead of %d\n",
+                  what, value, expected));
+      result = 1;
+    }
+}
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  try
+    {
+      CORBA::ORB_var orb = CORBA::ORB_init (argc, argv);
+
+      CORBA::Object_var poa_object =
+        orb->resolve_initial_references("RootPOA");
+
+      PortableServer::POA_var root_poa =
+        PortableServer::POA::_narrow (poa_object.in ());
+
+      if (CORBA::is_nil (root_poa.in ()))
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           " (%P|%t) Panic: nil RootPOA\n"),
+                          1);
+
+      PortableServer::POAManager_var poa_manager = root_poa->the_POAManager ();
+
+      if (parse_args (argc, argv) != 0)
+        return 1;
+
+      CORBA::Object_var tmp = orb->string_to_object(ior);
+
+      Test::Counter_var counter = Test::Counter::_narrow(tmp.in ());
+
+      if (CORBA::is_nil (counter.in ()))
+        {
+          ACE_ERROR_RETURN ((LM_DEBUG,
+                             "Nil Test::Counter reference <%s>\n",
+                             ior),
+                            1);
+        }
+
+      Handler *handler = 0;
+      ACE_NEW_RETURN (handler,
+                      Handler,
+                      1);
+      PortableServer::ServantBase_var owner_transfer(handler);
+
+      PortableServer::ObjectId_var id =
+        root_poa->activate_object (handler);
+
+      CORBA::Object_var object = root_poa->id_to_reference (id.in ());
+
+      Test::AMI_CounterHandler_var handler_ref =
+        Test::AMI_CounterHandler::_narrow (object.in ());
+
+      poa_manager->activate ();
+
+      CORBA::Long n = 0;
+
+      // The oneways are held back until the batch ends ...
+      {
+        TAO::Request_Batch batch (orb.in ());
+
+        for (CORBA::Long i = 0; i != nrequests; ++i)
+          counter->tick (n++);
+
+        check ("oneways held back", static_cast<CORBA::Long> (batch.queued ()),
+               nrequests);
+      }
+
+      check ("count after the oneway batch", counter->count (), n);
+
+      // ... or until a twoway request takes them along.
+      {
+        TAO::Request_Batch batch (orb.in ());
+
+        for (CORBA::Long i = 0; i != nrequests; ++i)
+          counter->tick (n++);
+
+        check ("count in the oneway batch", counter->count (), n);
+      }
+
+      // The replies to a batch of AMI requests are dispatched as
+      // usual.
+      {
+        TAO::Request_Batch batch (orb.in ());
+
+        for (CORBA::Long i = 0; i != nrequests; ++i)
+          {
+            counter->tick (n++);
+            counter->sendc_count (handler_ref.in ());
+          }
+
+        check ("AMI requests held back",
+               static_cast<CORBA::Long> (batch.queued ()), 2 * nrequests);
+
+        if (batch.flush () == -1)
+          {
+            ACE_ERROR ((LM_ERROR, "(%P|%t) ERROR: flush failed\n"));
+            result = 1;
+          }
+
+        check ("requests held back after flush",
+               static_cast<CORBA::Long> (batch.queued ()), 0);
+      }
+
+      while (handler->replies () != nrequests)
+        {
+          ACE_Time_Value tv (1, 0);
+          orb->perform_work (tv);
+        }
+
+      check ("count in the last AMI reply", handler->last (), n);
+
+      counter->shutdown ();
+
+      root_poa->destroy (1, 1);
+
+      orb->destroy ();
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Exception caught:");
+      return 1;
+    }
+
+  return result;
+}
@@ -1,7 +1,7 @@
 class mock_transport
 {
 public:
-  mock_transport () : id_(0), is_connected_(false), entry_(0), purging_order_ (0), purged_count_ (0) {}
+  mock_transport () : id_(0), is_connected_(false), entry_(0), shard_(0), purging_order_ (0), purged_count_ (0) {}
   size_t id (void) const {return id_;}
   void id (size_t id) { this->id_ = id;}
   unsigned long purging_order (void) const {return purging_order_;}
@@ -12,6 +12,9 @@ public:
   ACE_Event_Handler::Reference_Count remove_reference (void) {return 0;}
   void cache_map_entry (TCM::HASH_MAP_ENTRY *entry) {this->entry_ = entry;}
   TCM::HASH_MAP_ENTRY *cache_map_entry (void) {return this->entry_;}
+  void clear_cache_map_entry (void) {this->entry_ = 0;}
+  void cache_map_shard (unsigned long shard) {this->shard_ = shard;}
+  unsigned long cache_map_shard (void) const {return this->shard_;}
   void close_connection (void) { purged_count_ = ++global_purged_count;};
   int purged_count (void) { return this->purged_count_;}
   bool can_be_purged (void) { return true;}
@@ -19,6 +22,7 @@ private:
   size_t id_;
   bool is_connected_;
   TCM::HASH_MAP_ENTRY *entry_;
+  unsigned long shard_;
   unsigned long purging_order_;
   /// When did we got purged
   int purged_count_;
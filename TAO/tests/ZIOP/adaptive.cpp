@@ -0,0 +1,130 @@
+// Checks the choices of TAO_ZIOP_Adaptive_Compression.  The outcome
+// of compressing a message is made up, so that the test doesn't depend
+// on the compressors that are built or on the speed of the machine.
+
+#include "tao/ZIOP/ZIOP_Adaptive_Compression.h"
+#include "tao/ORB.h"
+
+static const CORBA::ULong MESSAGES = 10000;
+static const CORBA::ULong MESSAGE_SIZE = 1000;
+
+// Sizes are in percent of the original, times in nanoseconds per byte.
+struct Outcome
+{
+  ::Compression::CompressorId compressor_id;
+  CORBA::ULong size;
+  CORBA::ULong nsecs_per_byte;
+};
+
+// A fast compressor that halves the data, and a slow one that makes it
+// a third of the size.
+static const Outcome fast = { ::Compression::COMPRESSORID_LZ4, 50, 5 };
+static const Outcome strong = { ::Compression::COMPRESSORID_ZLIB, 30, 50 };
+
+// Sends MESSAGES messages over a link of @a bandwidth kilobytes per
+// second, and counts how often each compressor, or none, was chosen.
+static void
+run (CORBA::ULong bandwidth,
+     const Outcome &first,
+     const Outcome &second,
+     CORBA::ULong &none,
+     CORBA::ULong &first_count,
+     CORBA::ULong &second_count)
+{
+  TAO_ZIOP_Adaptive_Compression adaptive;
+
+  ::Compression::CompressorIdLevelList list (2);
+  list.length (2);
+  list[0].compressor_id = first.compressor_id;
+  list[0].compression_level = 6;
+  list[1].compressor_id = second.compressor_id;
+  list[1].compression_level = 6;
+
+  none = first_count = second_count = 0;
+
+  for (CORBA::ULong i = 0; i != MESSAGES; ++i)
+    {
+      // Like for every message sent.
+      adaptive.compressors (list, bandwidth);
+
+      ::Compression::CompressorId id = ::Compression::COMPRESSORID_NONE;
+      ::Compression::CompressionLevel level = 0;
+      if (!adaptive.select (id, level))
+        {
+          ++none;
+          continue;
+        }
+
+      const Outcome &outcome = id == first.compressor_id ? first : second;
+      if (id == first.compressor_id)
+        ++first_count;
+      else
+        ++second_count;
+
+      adaptive.sample (id, level,
+                       MESSAGE_SIZE,
+                       MESSAGE_SIZE * outcome.size / 100,
+                       MESSAGE_SIZE * outcome.nsecs_per_byte);
+    }
+
+  ACE_DEBUG ((LM_DEBUG,
+              "%u KB/s: %u uncompressed, %u with %u, %u with %u\n",
+              bandwidth, none,
+              first_count, first.compressor_id,
+              second_count, second.compressor_id));
+}
+
+int
+ACE_TMAIN (int, ACE_TCHAR *[])
+{
+  int status = 0;
+  CORBA::ULong none = 0;
+  CORBA::ULong fast_count = 0;
+  CORBA::ULong strong_count = 0;
+
+  // 100 KB/s, a byte takes about 10 microseconds on the link, the
+  // better ratio pays for the slower compressor.
+  run (100, fast, strong, none, fast_count, strong_count);
+  if (none != 0 || strong_count < MESSAGES * 9 / 10)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  "ERROR: slow link didn't use the strong compressor\n"));
+      status = 1;
+    }
+
+  // 12500 KB/s, a byte takes 78 nanoseconds, only the fast compressor
+  // saves time.
+  run (12500, fast, strong, none, fast_count, strong_count);
+  if (none != 0 || fast_count < MESSAGES * 9 / 10)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  "ERROR: medium link didn't use the fast compressor\n"));
+      status = 1;
+    }
+
+  // 1 GB/s, sending the data as it is is the fastest.
+  run (1000000, fast, strong, none, fast_count, strong_count);
+  if (none < MESSAGES * 9 / 10)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  "ERROR: fast link still compressed %u messages\n",
+                  fast_count + strong_count));
+      status = 1;
+    }
+
+  // Data that doesn't compress is soon left uncompressed, even when
+  // the link is slow.
+  Outcome const incompressible_fast = { fast.compressor_id, 101, 5 };
+  Outcome const incompressible_strong = { strong.compressor_id, 100, 50 };
+  run (100, incompressible_fast, incompressible_strong,
+       none, fast_count, strong_count);
+  if (none < MESSAGES * 9 / 10)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  "ERROR: incompressible data still compressed %u messages\n",
+                  fast_count + strong_count));
+      status = 1;
+    }
+
+  return status;
+}
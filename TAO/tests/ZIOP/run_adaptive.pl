@@ -0,0 +1,21 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+    & eval 'exec perl -S $0 $argv:q'
+    if 0;
+
+# -*- perl -*-
+
+use lib "$ENV{ACE_ROOT}/bin";
+use PerlACE::TestTarget;
+
+my $target = PerlACE::TestTarget::create_target (1) || die "Create target 1 failed\n";
+
+$AD = $target->CreateProcess ("adaptive");
+
+$test = $AD->SpawnWaitKill ($target->ProcessStartWaitInterval ());
+
+if ($test != 0) {
+    print STDERR "ERROR: adaptive returned $test\n";
+    exit 1;
+}
+
+exit 0;